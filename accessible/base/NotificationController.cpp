@@ -20,6 +20,12 @@ using namespace mozilla;
 using namespace mozilla::a11y;
 using namespace mozilla::dom;
 
+// Defines the number of mutation events that may be queued for one refresh
+// tick before the whole batch is packed into a single reorder event on the
+// document. Clients are better served by re-pulling the tree after such a
+// burst than by thousands of individual notifications.
+const unsigned int kMutationEventCountToPack = 300;
+
 ////////////////////////////////////////////////////////////////////////////////
 // NotificationCollector
 ////////////////////////////////////////////////////////////////////////////////
@@ -143,8 +149,12 @@ bool NotificationController::QueueMutationEvent(AccTreeMutationEvent* aEvent) {
 
   // Because we could be hiding the target of a show event we need to get rid
   // of any such events.  It may be possible to do less than coallesce all
-  // events, however that is easiest.
-  if (aEvent->GetEventType() == nsIAccessibleEvent::EVENT_HIDE) {
+  // events, however that is easiest.  Once the queue has grown large this
+  // pass, run for every queued hide event, makes mutation bursts quadratic;
+  // the single pass before the events are processed produces the same result,
+  // so past that point we rely on that one alone.
+  if (aEvent->GetEventType() == nsIAccessibleEvent::EVENT_HIDE &&
+      mEventGeneration <= kMutationEventCountToPack) {
     CoalesceMutationEvents();
 
     // mLastMutationEvent will point to something other than aEvent if and only
@@ -196,6 +206,12 @@ bool NotificationController::QueueMutationEvent(AccTreeMutationEvent* aEvent) {
     return true;
   }
 
+  // There is no point in composing text change events for a batch that will
+  // be packed into a single document reorder event anyway.
+  if (ShouldPackMutationEvents()) {
+    return true;
+  }
+
   MOZ_ASSERT(mutEvent);
 
   nsString text;
@@ -457,7 +473,38 @@ bool NotificationController::WaitingForParent() {
          parent->mNotifications.Length() != 0;
 }
 
+bool NotificationController::ShouldPackMutationEvents() const {
+  // The parent process mirrors remote accessible trees from the individual
+  // show and hide events, so batches that feed IPC cannot be packed away;
+  // for them we only skip the repeated coalescing runs while queueing.
+  return mEventGeneration > kMutationEventCountToPack &&
+         !IPCAccessibilityActive();
+}
+
 void NotificationController::ProcessMutationEvents() {
+  // If this tick produced an exceptionally large batch of mutation events,
+  // pack the whole batch into a single reorder event on the document and let
+  // clients re-pull the subtrees they care about. The subtrees of hidden
+  // targets still have to be shut down, which is otherwise done when the
+  // individual hide events are fired.
+  if (ShouldPackMutationEvents()) {
+    for (AccTreeMutationEvent* event = mFirstMutationEvent; event;
+         event = event->NextEvent()) {
+      if (event->GetEventType() != nsIAccessibleEvent::EVENT_HIDE) {
+        continue;
+      }
+
+      AccHideEvent* hideEvent = downcast_accEvent(event);
+      if (hideEvent->NeedsShutdown()) {
+        mDocument->ShutdownChildrenInSubtree(event->mAccessible);
+      }
+    }
+
+    RefPtr<AccReorderEvent> reorder = new AccReorderEvent(mDocument);
+    nsEventShell::FireEvent(reorder);
+    return;
+  }
+
   // there is no reason to fire a hide event for a child of a show event
   // target.  That can happen if something is inserted into the tree and
   // removed before the next refresh driver tick, but it should not be
@@ -832,7 +879,11 @@ void NotificationController::WillRefresh(mozilla::TimeStamp aTime) {
   // events causes script to run.
   mObservingState = eRefreshProcessing;
 
-  CoalesceMutationEvents();
+  // When the batch gets packed into a document reorder event the coalescing
+  // pass would be wasted work; every queued event is dropped regardless.
+  if (!ShouldPackMutationEvents()) {
+    CoalesceMutationEvents();
+  }
   ProcessMutationEvents();
   mEventGeneration = 0;
 
@@ -322,6 +322,13 @@ class NotificationController final : public EventQueue,
    */
   void ProcessMutationEvents();
 
+  /**
+   * Returns true if so many mutation events have been queued for the current
+   * refresh tick that the whole batch should be packed into a single reorder
+   * event on the document instead of being coalesced and fired individually.
+   */
+  bool ShouldPackMutationEvents() const;
+
   /**
    * Indicates whether we're waiting on an event queue processing from our
    * notification controller to flush events.
@@ -248,7 +248,10 @@ uint32_t gBlocklistInitFlags = eDllBlocklistInitFlagDefault;
 int main(int argc, char* argv[], char* envp[]) {
 #if defined(MOZ_ENABLE_FORKSERVER)
   if (strcmp(argv[argc - 1], "forkserver") == 0) {
-    nsresult rv = InitXPCOMGlue(LibLoadingStrategy::NoReadAhead);
+    // Unlike for ordinary content processes, read ahead here: the fork
+    // server is the template every content process is forked from, so
+    // one read-ahead pass over libxul is inherited by all of them.
+    nsresult rv = InitXPCOMGlue(LibLoadingStrategy::ReadAhead);
     if (NS_FAILED(rv)) {
       return 255;
     }
@@ -34,6 +34,7 @@
 #include "mozilla/ScrollTypes.h"
 #include "mozilla/Services.h"
 #include "mozilla/StaticPrefs_browser.h"
+#include "mozilla/StaticPrefs_docshell.h"
 #include "mozilla/StaticPrefs_dom.h"
 #include "mozilla/StaticPrefs_extensions.h"
 #include "mozilla/StaticPrefs_privacy.h"
@@ -161,6 +162,10 @@
 #include "IHistory.h"
 #include "IUrlClassifierUITelemetry.h"
 
+#include "gfxContext.h"
+#include "gfxPlatform.h"
+#include "gfxUtils.h"
+
 #include "nsArray.h"
 #include "nsArrayUtils.h"
 #include "nsCExternalHandlerService.h"
@@ -981,6 +986,12 @@ void nsDocShell::FirePageHideNotificationInternal(
     nsCOMPtr<nsIContentViewer> contentViewer(mContentViewer);
     mFiredUnloadEvent = true;
 
+    // Capture the viewport before the page gets a chance to mutate itself in
+    // its pagehide handler.  Subframes are skipped; the snapshot covers them.
+    if (!aSkipCheckingDynEntries) {
+      MaybeCaptureViewportSnapshot();
+    }
+
     if (mTiming) {
       mTiming->NotifyUnloadEventStart();
     }
@@ -5824,7 +5835,7 @@ nsDocShell::OnStateChange(nsIWebProgress* aProgress, nsIRequest* aRequest,
 
     if (this == aProgress) {
       mozilla::Unused << MaybeInitTiming();
-      mTiming->NotifyFetchStart(uri,
+      mTiming->NotifyFetchStart(channel, uri,
                                 ConvertLoadTypeToNavigationType(mLoadType));
       // If we are starting a DocumentChannel, we need to pass the timing
       // statistics so that should a process switch occur, the starting type can
@@ -6886,6 +6897,61 @@ nsresult nsDocShell::CaptureState() {
   return NS_OK;
 }
 
+void nsDocShell::MaybeCaptureViewportSnapshot() {
+  if (!StaticPrefs::docshell_shistory_viewport_snapshots_enabled()) {
+    return;
+  }
+
+  if (!mOSHE || mOSHE == mLSHE || mIsBeingDestroyed) {
+    // No entry to save into, we're replacing the existing entry, or we're
+    // going away entirely and nobody can navigate back to us.
+    return;
+  }
+
+  PresShell* presShell = GetPresShell();
+  nsPresContext* presContext = GetPresContext();
+  if (!presShell || !presContext) {
+    return;
+  }
+
+  nsRect visibleArea = presContext->GetVisibleArea();
+  gfx::IntSize size(
+      nsPresContext::AppUnitsToIntCSSPixels(visibleArea.Width()),
+      nsPresContext::AppUnitsToIntCSSPixels(visibleArea.Height()));
+  if (size.IsEmpty()) {
+    return;
+  }
+
+  RefPtr<gfx::DrawTarget> dt =
+      gfxPlatform::GetPlatform()->CreateOffscreenContentDrawTarget(
+          size, gfx::SurfaceFormat::B8G8R8A8);
+  if (!dt || !dt->IsValid()) {
+    return;
+  }
+
+  RefPtr<gfxContext> ctx = gfxContext::CreateOrNull(dt);
+  if (NS_FAILED(presShell->RenderDocument(visibleArea,
+                                          RenderDocumentFlags::None,
+                                          NS_RGB(255, 255, 255), ctx))) {
+    return;
+  }
+
+  RefPtr<gfx::SourceSurface> surface = dt->Snapshot();
+  if (!surface) {
+    return;
+  }
+
+  nsCString snapshot;
+  if (NS_FAILED(gfxUtils::EncodeSourceSurface(surface, ImageType::PNG,
+                                              EmptyString(),
+                                              gfxUtils::eBinaryEncode, nullptr,
+                                              &snapshot))) {
+    return;
+  }
+
+  mOSHE->SetViewportSnapshot(snapshot);
+}
+
 NS_IMETHODIMP
 nsDocShell::RestorePresentationEvent::Run() {
   if (mDocShell && NS_FAILED(mDocShell->RestoreFromHistory())) {
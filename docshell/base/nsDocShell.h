@@ -917,6 +917,12 @@ class nsDocShell final : public nsDocLoader,
   // state) and stores them on |mOSHE|.
   nsresult CaptureState();
 
+  // Captures a PNG snapshot of the viewport and stores it on |mOSHE| so that
+  // the front end can paint it immediately when the user navigates back to
+  // that entry.  Does nothing unless
+  // docshell.shistory.viewport_snapshots.enabled is set.
+  void MaybeCaptureViewportSnapshot();
+
   // Begin the toplevel restore process for |aSHEntry|.
   // This simulates a channel open, and defers the real work until
   // RestoreFromHistory is called from a PLEvent.
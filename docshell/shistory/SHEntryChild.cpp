@@ -788,6 +788,22 @@ SHEntryChild::SetBaseURI(nsIURI* aBaseURI) {
   return SendSetBaseURI(aBaseURI) ? NS_OK : NS_ERROR_FAILURE;
 }
 
+NS_IMETHODIMP
+SHEntryChild::GetViewportSnapshot(nsACString& aSnapshot) {
+  nsCString snapshot;
+  if (!SendGetViewportSnapshot(&snapshot)) {
+    return NS_ERROR_FAILURE;
+  }
+  aSnapshot = snapshot;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+SHEntryChild::SetViewportSnapshot(const nsACString& aSnapshot) {
+  return SendSetViewportSnapshot(nsCString(aSnapshot)) ? NS_OK
+                                                       : NS_ERROR_FAILURE;
+}
+
 NS_IMETHODIMP
 SHEntryChild::GetScrollRestorationIsManual(bool* aIsManual) {
   return SendGetScrollRestorationIsManual(aIsManual) ? NS_OK : NS_ERROR_FAILURE;
@@ -374,6 +374,18 @@ bool SHEntryParent::RecvSetBaseURI(nsIURI* aBaseURI) {
   return true;
 }
 
+bool SHEntryParent::RecvGetViewportSnapshot(nsCString* aSnapshot) {
+  DebugOnly<nsresult> rv = mEntry->GetViewportSnapshot(*aSnapshot);
+  MOZ_ASSERT(NS_SUCCEEDED(rv), "Didn't expect this to fail.");
+  return true;
+}
+
+bool SHEntryParent::RecvSetViewportSnapshot(const nsCString& aSnapshot) {
+  DebugOnly<nsresult> rv = mEntry->SetViewportSnapshot(aSnapshot);
+  MOZ_ASSERT(NS_SUCCEEDED(rv), "Didn't expect this to fail.");
+  return true;
+}
+
 bool SHEntryParent::RecvGetScrollRestorationIsManual(
     bool* aScrollRestorationIsManual) {
   DebugOnly<nsresult> rv =
@@ -160,6 +160,8 @@ class SHEntryParent final : public PSHEntryParent {
   bool RecvSetSrcdocData(const nsString& aSrcdocData);
   bool RecvGetBaseURI(RefPtr<nsIURI>* aBaseURI);
   bool RecvSetBaseURI(nsIURI* aBaseURI);
+  bool RecvGetViewportSnapshot(nsCString* aSnapshot);
+  bool RecvSetViewportSnapshot(const nsCString& aSnapshot);
   bool RecvGetScrollRestorationIsManual(bool* aScrollRestorationIsManual);
   bool RecvSetScrollRestorationIsManual(const bool& aScrollRestorationIsManual);
   bool RecvGetLoadedInThisProcess(bool* aLoadedInThisProcess);
@@ -570,6 +570,18 @@ nsSHEntry::SetBaseURI(nsIURI* aBaseURI) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+nsSHEntry::GetViewportSnapshot(nsACString& aSnapshot) {
+  aSnapshot = mViewportSnapshot;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsSHEntry::SetViewportSnapshot(const nsACString& aSnapshot) {
+  mViewportSnapshot = aSnapshot;
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsSHEntry::GetScrollRestorationIsManual(bool* aIsManual) {
   *aIsManual = mScrollRestorationIsManual;
@@ -79,6 +79,7 @@ class nsSHEntry : public nsISHEntry {
   nsCOMPtr<nsIStructuredCloneContainer> mStateData;
   nsString mSrcdocData;
   nsCOMPtr<nsIURI> mBaseURI;
+  nsCString mViewportSnapshot;
   bool mLoadReplace;
   bool mURIWasModified;
   bool mIsSrcdocEntry;
@@ -912,6 +912,11 @@ nsSHistory::PurgeHistory(int32_t aNumEntries) {
   // Remove the first `aNumEntries` entries.
   mEntries.RemoveElementsAt(0, aNumEntries);
 
+  // Long-lived tabs can accumulate hundreds of entries before being purged;
+  // don't keep the peak capacity alive for the rest of the session history's
+  // lifetime.
+  mEntries.Compact();
+
   // Adjust the indices, but don't let them go below -1.
   mIndex -= aNumEntries;
   mIndex = std::max(mIndex, -1);
@@ -1375,6 +1380,14 @@ void nsSHistory::GloballyEvictAllContentViewers() {
   sHistoryMaxTotalViewers = 0;
   GloballyEvictContentViewers();
   sHistoryMaxTotalViewers = maxViewers;
+
+  // Viewport snapshots are only kept as a back/forward nicety, so drop them
+  // along with the content viewers.
+  for (auto shist : gSHistoryList) {
+    for (nsCOMPtr<nsISHEntry>& entry : shist->mEntries) {
+      entry->SetViewportSnapshot(EmptyCString());
+    }
+  }
 }
 
 void GetDynamicChildren(nsISHEntry* aEntry, nsTArray<nsID>& aDocshellIDs) {
@@ -1529,6 +1542,10 @@ void nsSHistory::RemoveEntries(nsTArray<nsID>& aIDs, int32_t aStartIndex,
     }
     --index;
   }
+
+  if (*aDidRemove) {
+    mEntries.Compact();
+  }
 }
 
 void nsSHistory::RemoveFrameEntries(nsISHEntry* aEntry) {
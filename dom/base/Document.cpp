@@ -1339,6 +1339,7 @@ Document::Document(const char* aContentType)
       mPreloadPictureDepth(0),
       mEventsSuppressed(0),
       mIgnoreDestructiveWritesCounter(0),
+      mDNSPrefetchRequests(0),
       mFrameRequestCallbackCounter(0),
       mStaticCloneCount(0),
       mWindow(nullptr),
@@ -7110,14 +7111,23 @@ bool Document::RemoveObserver(nsIDocumentObserver* aObserver) {
 void Document::BeginUpdate() {
   ++mUpdateNestLevel;
   nsContentUtils::AddScriptBlocker();
-  NS_DOCUMENT_NOTIFY_OBSERVERS(BeginUpdate, (this));
+  // Only notify observers for the outermost update.  Bulk mutations (say,
+  // inserting the children of a document fragment) open a nested update per
+  // node, and walking the observer list for each of them makes the update
+  // bookkeeping scale with the number of mutated nodes.  Observers needing
+  // per-mutation work get it from nsIMutationObserver notifications.
+  if (mUpdateNestLevel == 1) {
+    NS_DOCUMENT_NOTIFY_OBSERVERS(BeginUpdate, (this));
+  }
 }
 
 void Document::EndUpdate() {
   const bool reset = !mPendingMaybeEditingStateChanged;
   mPendingMaybeEditingStateChanged = true;
 
-  NS_DOCUMENT_NOTIFY_OBSERVERS(EndUpdate, (this));
+  if (mUpdateNestLevel == 1) {
+    NS_DOCUMENT_NOTIFY_OBSERVERS(EndUpdate, (this));
+  }
 
   --mUpdateNestLevel;
 
@@ -11215,6 +11225,15 @@ void Document::SetReadyStateInternal(ReadyState aReadyState,
     }
   }
 
+  if (READYSTATE_INTERACTIVE == aReadyState) {
+    // Parsing is done; if the render-blocking stylesheets are too, there is
+    // no reason to keep the first paint waiting on the paint suppression
+    // timer.
+    if (RefPtr<PresShell> presShell = GetPresShell()) {
+      presShell->TryUnsuppressPainting();
+    }
+  }
+
   if (aUpdateTimingInformation) {
     RecordNavigationTiming(aReadyState);
   }
@@ -1618,32 +1618,45 @@ class Document : public nsINode,
    public:
     using SelectorList = UniquePtr<RawServoSelectorList>;
 
+    struct Entry {
+      SelectorCacheKey* mKey;  // Owned by the expiration tracker.
+      SelectorList mList;
+    };
+
     explicit SelectorCache(nsIEventTarget* aEventTarget);
 
     void CacheList(const nsAString& aSelector, SelectorList aSelectorList) {
       MOZ_ASSERT(NS_IsMainThread());
       SelectorCacheKey* key = new SelectorCacheKey(aSelector);
-      mTable.Put(key->mKey, std::move(aSelectorList));
+      mTable.Put(key->mKey, Entry{key, std::move(aSelectorList)});
       AddObject(key);
     }
 
     void NotifyExpired(SelectorCacheKey* aSelector) final;
 
-    // We do not call MarkUsed because it would just slow down lookups and
-    // because we're OK expiring things after a few seconds even if they're
-    // being used.  Returns whether we actually had an entry for aSelector.
+    // Returns null if we had no entry for aSelector. On a hit the entry is
+    // marked as used, so selectors that scripts query over and over stay
+    // cached instead of being re-parsed every few seconds; MarkUsed is just
+    // a generation compare when the entry is already in the newest
+    // generation, so the hit path stays cheap.
     //
     // If we have an entry and the selector list returned has a null
     // RawServoSelectorList*, that indicates that aSelector has already been
     // parsed and is not a syntactically valid selector.
     SelectorList* GetList(const nsAString& aSelector) {
-      return mTable.GetValue(aSelector);
+      MOZ_ASSERT(NS_IsMainThread());
+      Entry* entry = mTable.GetValue(aSelector);
+      if (!entry) {
+        return nullptr;
+      }
+      MarkUsed(entry->mKey);
+      return &entry->mList;
     }
 
     ~SelectorCache();
 
    private:
-    nsDataHashtable<nsStringHashKey, SelectorList> mTable;
+    nsDataHashtable<nsStringHashKey, Entry> mTable;
   };
 
   SelectorCache& GetSelectorCache() {
@@ -2773,6 +2786,20 @@ class Document : public nsINode,
 
   bool IsDNSPrefetchAllowed() const { return mAllowDNSPrefetch; }
 
+  /**
+   * Grants one unit of the per-document speculative DNS prefetch quota, up
+   * to aLimit lookups over the lifetime of the document. Returns false once
+   * the quota is exhausted. Used by nsHTMLDNSPrefetch to keep link-dense
+   * pages from flooding the resolver with lookups it will never use.
+   */
+  bool ConsumeDNSPrefetchQuota(uint32_t aLimit) {
+    if (mDNSPrefetchRequests >= aLimit) {
+      return false;
+    }
+    ++mDNSPrefetchRequests;
+    return true;
+  }
+
   /**
    * Returns true if this document is allowed to contain XUL element and
    * use non-builtin XBL bindings.
@@ -4753,6 +4780,12 @@ class Document : public nsINode,
    */
   uint32_t mIgnoreDestructiveWritesCounter;
 
+  /**
+   * Number of speculative DNS prefetch lookups charged against this
+   * document's quota, see ConsumeDNSPrefetchQuota().
+   */
+  uint32_t mDNSPrefetchRequests;
+
   /**
    * The current frame request callback handle
    */
@@ -226,6 +226,23 @@ nsIFrame* nsIContent::GetPrimaryFrame(mozilla::FlushType aType) {
 
   // Cause a flush, so we get up-to-date frame information.
   if (aType != mozilla::FlushType::None) {
+    // Scripts which interleave geometry reads with writes to unrelated
+    // subtrees (as rAF- and ResizeObserver-driven widgets tend to do) would
+    // otherwise pay for a full reflow per read. If the caller only needs
+    // layout to be up to date for our own frame, flush pending content
+    // notifications first, so that all pending frame dirtying has happened,
+    // and then skip the reflow if the dirty frames are provably disjoint
+    // from our frame.
+    if (aType == mozilla::FlushType::Layout &&
+        !doc->StyleOrLayoutObservablyDependsOnParentDocumentLayout()) {
+      doc->FlushPendingNotifications(mozilla::FlushType::ContentAndNotify);
+      nsIFrame* frame = GetPrimaryFrame();
+      mozilla::PresShell* presShell = doc->GetPresShell();
+      if (frame && presShell &&
+          !presShell->PendingReflowCouldAffectFrame(frame)) {
+        return frame;
+      }
+    }
     doc->FlushPendingNotifications(aType);
   }
 
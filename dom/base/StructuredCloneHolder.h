@@ -96,6 +96,17 @@ class StructuredCloneHolderBase {
 
   // Execute the serialization of aValue using the Structured Clone Algorithm.
   // The data can read back using Read().
+  //
+  // Serialization always runs synchronously on the calling thread: the
+  // writer walks GC-managed objects, and those may only be touched on the
+  // thread owning them, so there is no way to move this work to a helper
+  // thread.  If the cost of cloning large payloads is a problem for you,
+  // transfer the large pieces (ArrayBuffers, ImageBitmaps, streams) instead
+  // of cloning them, or share them via SharedArrayBuffer where the clone
+  // policy permits.  Note that once written, the serialized buffer itself
+  // is never copied again on the common paths: it is moved to the target
+  // thread, refcount-shared (see SharedJSAllocatedData), or borrowed for
+  // IPC sends.
   bool Write(JSContext* aCx, JS::Handle<JS::Value> aValue);
 
   // Like Write() but it supports the transferring of objects and handling
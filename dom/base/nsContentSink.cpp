@@ -204,6 +204,15 @@ nsContentSink::StyleSheetLoaded(StyleSheet* aSheet, bool aWasDeferred,
       ScrollToRef();
     }
 
+    if (mPendingSheetCount == 0) {
+      // If this was the last render-blocking stylesheet and the parser has
+      // already finished, the first paint may now be waiting on nothing but
+      // the paint suppression timer.
+      if (RefPtr<PresShell> presShell = mDocument->GetPresShell()) {
+        presShell->TryUnsuppressPainting();
+      }
+    }
+
     mScriptLoader->RemoveParserBlockingScriptExecutionBlocker();
   }
 
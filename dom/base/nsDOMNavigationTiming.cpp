@@ -7,6 +7,7 @@
 #include "nsDOMNavigationTiming.h"
 
 #include "GeckoProfiler.h"
+#include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/dom/PerformanceNavigation.h"
@@ -15,6 +16,7 @@
 #include "nsContentUtils.h"
 #include "nsDocShell.h"
 #include "nsHttp.h"
+#include "nsIChannel.h"
 #include "nsIScriptSecurityManager.h"
 #include "nsIURI.h"
 #include "nsPrintfCString.h"
@@ -33,6 +35,10 @@ LazyLogModule gPageLoadLog("PageLoad");
 
 }  // namespace mozilla
 
+// Combined with the process id by GenerateProcessSpecificId() below, so
+// navigation ids remain unique when a load switches processes.
+static uint64_t gNextNavigationId = 0;
+
 nsDOMNavigationTiming::nsDOMNavigationTiming(nsDocShell* aDocShell) {
   Clear();
 
@@ -43,6 +49,7 @@ nsDOMNavigationTiming::~nsDOMNavigationTiming() = default;
 
 void nsDOMNavigationTiming::Clear() {
   mNavigationType = TYPE_RESERVED;
+  mNavigationId = 0;
   mNavigationStartHighRes = 0;
 
   mBeforeUnloadStart = TimeStamp();
@@ -82,17 +89,36 @@ void nsDOMNavigationTiming::NotifyNavigationStart(
     DocShellState aDocShellState) {
   mNavigationStartHighRes = (double)PR_Now() / PR_USEC_PER_MSEC;
   mNavigationStart = TimeStamp::Now();
+  mNavigationId = nsContentUtils::GenerateProcessSpecificId(++gNextNavigationId);
   mDocShellHasBeenActiveSinceNavigationStart =
       (aDocShellState == DocShellState::eActive);
+  PAGELOAD_LOG(("Navigation start, navId=%" PRIu64, mNavigationId));
   PROFILER_ADD_MARKER("Navigation::Start", DOM);
 }
 
-void nsDOMNavigationTiming::NotifyFetchStart(nsIURI* aURI,
+void nsDOMNavigationTiming::NotifyFetchStart(nsIChannel* aChannel, nsIURI* aURI,
                                              Type aNavigationType) {
   mNavigationType = aNavigationType;
   // At the unload event time we don't really know the loading uri.
   // Need it for later check for unload timing access.
   mLoadedURI = aURI;
+
+  if (PAGELOAD_LOG_ENABLED()) {
+    // The channel id is shared with the parent process and shows up in HTTP
+    // logs there, so logging it next to the navigation id is what lets a
+    // navigation's docshell spans be stitched to its network spans.
+    uint64_t channelId = 0;
+    if (nsCOMPtr<nsIIdentChannel> identChannel = do_QueryInterface(aChannel)) {
+      channelId = identChannel->ChannelId();
+    }
+    nsAutoCString spec;
+    if (aURI) {
+      aURI->GetSpec(spec);
+    }
+    PAGELOAD_LOG(("Fetch start for URL %s, navId=%" PRIu64 ", channelId=%" PRIu64
+                  ", type=%d",
+                  spec.get(), mNavigationId, channelId, int(aNavigationType)));
+  }
 }
 
 void nsDOMNavigationTiming::NotifyRestoreStart() {
@@ -169,8 +195,10 @@ void nsDOMNavigationTiming::NotifyLoadEventEnd() {
         mLoadedURI->GetSpec(spec);
       }
       nsPrintfCString marker(
-          "Document %s loaded after %dms, load event duration %dms", spec.get(),
-          int(elapsed.ToMilliseconds()), int(duration.ToMilliseconds()));
+          "Document %s loaded after %dms, load event duration %dms, "
+          "navId=%" PRIu64,
+          spec.get(), int(elapsed.ToMilliseconds()),
+          int(duration.ToMilliseconds()), mNavigationId);
       PAGELOAD_LOG(("%s", marker.get()));
       PROFILER_ADD_MARKER_WITH_PAYLOAD(
           "DocumentLoad", DOM, TextMarkerPayload,
@@ -199,6 +227,9 @@ void nsDOMNavigationTiming::NotifyDOMLoading(nsIURI* aURI) {
   mLoadedURI = aURI;
   mDOMLoading = TimeStamp::Now();
 
+  PAGELOAD_LOG(("DOMLoading at %dms, navId=%" PRIu64,
+                int((mDOMLoading - mNavigationStart).ToMilliseconds()),
+                mNavigationId));
   PROFILER_ADD_MARKER("Navigation::DOMLoading", DOM);
 }
 
@@ -209,6 +240,9 @@ void nsDOMNavigationTiming::NotifyDOMInteractive(nsIURI* aURI) {
   mLoadedURI = aURI;
   mDOMInteractive = TimeStamp::Now();
 
+  PAGELOAD_LOG(("DOMInteractive at %dms, navId=%" PRIu64,
+                int((mDOMInteractive - mNavigationStart).ToMilliseconds()),
+                mNavigationId));
   PROFILER_ADD_MARKER("Navigation::DOMInteractive", DOM);
 }
 
@@ -219,6 +253,9 @@ void nsDOMNavigationTiming::NotifyDOMComplete(nsIURI* aURI) {
   mLoadedURI = aURI;
   mDOMComplete = TimeStamp::Now();
 
+  PAGELOAD_LOG(("DOMComplete at %dms, navId=%" PRIu64,
+                int((mDOMComplete - mNavigationStart).ToMilliseconds()),
+                mNavigationId));
   PROFILER_ADD_MARKER("Navigation::DOMComplete", DOM);
 }
 
@@ -362,9 +399,10 @@ void nsDOMNavigationTiming::TTITimeout(nsITimer* aTimer) {
     if (mLoadedURI) {
       mLoadedURI->GetSpec(spec);
     }
-    nsPrintfCString marker("TTFI after %dms (LongTask was at %dms) for URL %s",
-                           int(elapsed.ToMilliseconds()),
-                           int(elapsedLongTask.ToMilliseconds()), spec.get());
+    nsPrintfCString marker(
+        "TTFI after %dms (LongTask was at %dms) for URL %s, navId=%" PRIu64,
+        int(elapsed.ToMilliseconds()), int(elapsedLongTask.ToMilliseconds()),
+        spec.get(), mNavigationId);
 
     PROFILER_ADD_MARKER_WITH_PAYLOAD(
         "TimeToFirstInteractive (TTFI)", DOM, TextMarkerPayload,
@@ -392,12 +430,13 @@ void nsDOMNavigationTiming::NotifyNonBlankPaintForRootContentDocument() {
       mLoadedURI->GetSpec(spec);
     }
     nsPrintfCString marker(
-        "Non-blank paint after %dms for URL %s, %s",
+        "Non-blank paint after %dms for URL %s, %s, navId=%" PRIu64,
         int(elapsed.ToMilliseconds()), spec.get(),
         mDocShellHasBeenActiveSinceNavigationStart
             ? "foreground tab"
             : "this tab was inactive some of the time between navigation start "
-              "and first non-blank paint");
+              "and first non-blank paint",
+        mNavigationId);
     PAGELOAD_LOG(("%s", marker.get()));
     PROFILER_ADD_MARKER_WITH_PAYLOAD(
         "FirstNonBlankPaint", DOM, TextMarkerPayload,
@@ -441,12 +480,13 @@ void nsDOMNavigationTiming::NotifyContentfulPaintForRootContentDocument(
       mLoadedURI->GetSpec(spec);
     }
     nsPrintfCString marker(
-        "Contentful paint after %dms for URL %s, %s",
+        "Contentful paint after %dms for URL %s, %s, navId=%" PRIu64,
         int(elapsed.ToMilliseconds()), spec.get(),
         mDocShellHasBeenActiveSinceNavigationStart
             ? "foreground tab"
             : "this tab was inactive some of the time between navigation start "
-              "and first non-blank paint");
+              "and first non-blank paint",
+        mNavigationId);
     PAGELOAD_LOG(("%s", marker.get()));
     PROFILER_ADD_MARKER_WITH_PAYLOAD(
         "FirstContentfulPaint", DOM, TextMarkerPayload,
@@ -490,12 +530,13 @@ void nsDOMNavigationTiming::NotifyDOMContentFlushedForRootContentDocument() {
       mLoadedURI->GetSpec(spec);
     }
     nsPrintfCString marker(
-        "DOMContentFlushed after %dms for URL %s, %s",
+        "DOMContentFlushed after %dms for URL %s, %s, navId=%" PRIu64,
         int(elapsed.ToMilliseconds()), spec.get(),
         mDocShellHasBeenActiveSinceNavigationStart
             ? "foreground tab"
             : "this tab was inactive some of the time between navigation start "
-              "and DOMContentFlushed");
+              "and DOMContentFlushed",
+        mNavigationId);
     PAGELOAD_LOG(("%s", marker.get()));
     PROFILER_ADD_MARKER_WITH_PAYLOAD(
         "DOMContentFlushed", DOM, TextMarkerPayload,
@@ -549,6 +590,7 @@ nsDOMNavigationTiming::nsDOMNavigationTiming(nsDocShell* aDocShell,
       mUnloadedURI(aOther->mUnloadedURI),
       mLoadedURI(aOther->mLoadedURI),
       mNavigationType(aOther->mNavigationType),
+      mNavigationId(aOther->mNavigationId),
       mNavigationStartHighRes(aOther->mNavigationStartHighRes),
       mNavigationStart(aOther->mNavigationStart),
       mNonBlankPaint(aOther->mNonBlankPaint),
@@ -576,6 +618,7 @@ void mozilla::ipc::IPDLParamTraits<nsDOMNavigationTiming*>::Write(
   WriteIPDLParam(aMsg, aActor, unloadedURI ? Some(unloadedURI) : Nothing());
   WriteIPDLParam(aMsg, aActor, loadedURI ? Some(loadedURI) : Nothing());
   WriteIPDLParam(aMsg, aActor, uint32_t(aParam->mNavigationType));
+  WriteIPDLParam(aMsg, aActor, aParam->mNavigationId);
   WriteIPDLParam(aMsg, aActor, aParam->mNavigationStartHighRes);
   WriteIPDLParam(aMsg, aActor, aParam->mNavigationStart);
   WriteIPDLParam(aMsg, aActor, aParam->mNonBlankPaint);
@@ -607,6 +650,7 @@ bool mozilla::ipc::IPDLParamTraits<nsDOMNavigationTiming*>::Read(
   if (!ReadIPDLParam(aMsg, aIter, aActor, &unloadedURI) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &loadedURI) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &type) ||
+      !ReadIPDLParam(aMsg, aIter, aActor, &timing->mNavigationId) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &timing->mNavigationStartHighRes) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &timing->mNavigationStart) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &timing->mNonBlankPaint) ||
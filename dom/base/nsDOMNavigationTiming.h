@@ -15,6 +15,7 @@
 #include "nsITimer.h"
 
 class nsDocShell;
+class nsIChannel;
 class nsIURI;
 
 typedef unsigned long long DOMTimeMilliSec;
@@ -47,6 +48,16 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
 
   Type GetType() const { return mNavigationType; }
 
+  /**
+   * Process-unique id for the navigation this object describes, assigned at
+   * navigation start and preserved across process switches. Every PageLoad
+   * log line and profiler marker emitted from this class includes it, and
+   * NotifyFetchStart logs it next to the channel id of the document load, so
+   * the docshell, networking and layout spans of one navigation can be
+   * stitched together from logs of different processes.
+   */
+  uint64_t NavigationId() const { return mNavigationId; }
+
   inline DOMHighResTimeStamp GetNavigationStartHighRes() const {
     return mNavigationStartHighRes;
   }
@@ -133,7 +144,8 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
   enum class DocShellState : uint8_t { eActive, eInactive };
 
   void NotifyNavigationStart(DocShellState aDocShellState);
-  void NotifyFetchStart(nsIURI* aURI, Type aNavigationType);
+  void NotifyFetchStart(nsIChannel* aChannel, nsIURI* aURI,
+                        Type aNavigationType);
   // A restoration occurs when the document is loaded from the
   // bfcache. This method sets the appropriate parameters of the
   // navigation timing object in this case.
@@ -200,6 +212,7 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
   nsCOMPtr<nsITimer> mTTITimer;
 
   Type mNavigationType;
+  uint64_t mNavigationId;
   DOMHighResTimeStamp mNavigationStartHighRes;
   mozilla::TimeStamp mNavigationStart;
   mozilla::TimeStamp mNonBlankPaint;
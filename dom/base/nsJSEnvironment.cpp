@@ -11,6 +11,7 @@
 #include "nsPIDOMWindow.h"
 #include "nsDOMCID.h"
 #include "nsIXPConnect.h"
+#include "nsAlgorithm.h"
 #include "nsCOMPtr.h"
 #include "nsISupportsPrimitives.h"
 #include "nsReadableUtils.h"
@@ -177,6 +178,17 @@ static bool sIncrementalCC = false;
 static TimeDuration sActiveIntersliceGCBudget =
     TimeDuration::FromMilliseconds(5);
 
+// Feedback from the refresh driver used to size interslice GC slices:
+// a smoothed estimate of how much of the frame budget recent ticks left
+// unused, and when the last unthrottled tick happened.  Both are only
+// touched on the main thread.
+static TimeDuration sFrameHeadroomEstimate;
+static TimeStamp sLastFrameTickTime;
+
+// A refresh driver tick younger than this means we are animating and GC
+// slices have to fit into the measured frame headroom.
+static const TimeDuration kRecentFrameTick = TimeDuration::FromMilliseconds(200);
+
 static TimeStamp sFirstCollectionTime;
 
 static bool sIsInitialized;
@@ -1727,6 +1739,20 @@ bool InterSliceGCRunnerFired(TimeStamp aDeadline, void* aData) {
   // and better to GC in several longer slices than in a very long one.
   TimeDuration budget = aDeadline.IsNull() ? sActiveIntersliceGCBudget * 2
                                            : aDeadline - TimeStamp::Now();
+  if (aDeadline.IsNull() && !sLastFrameTickTime.IsNull()) {
+    // No idle deadline to obey, so fall back on what the refresh driver has
+    // been reporting.  While frames are being produced, make the slice fit
+    // into half the headroom recent ticks left in the frame budget so that
+    // rasterization and input still have room; once the refresh driver has
+    // gone quiet, we can afford to stretch the slices instead and retire
+    // the GC in fewer interruptions.
+    if (TimeStamp::Now() - sLastFrameTickTime < kRecentFrameTick) {
+      budget = clamped(sFrameHeadroomEstimate.MultDouble(0.5),
+                       TimeDuration::FromMilliseconds(1), budget);
+    } else {
+      budget = sActiveIntersliceGCBudget * 4;
+    }
+  }
   if (sCCLockedOut && sCCLockedOutTime) {
     TimeDuration lockedTime = TimeStamp::Now() - sCCLockedOutTime;
     TimeDuration maxSliceGCBudget = sActiveIntersliceGCBudget * 10;
@@ -2374,11 +2400,31 @@ void nsJSContext::LikelyShortLivingObjectCreated() {
   ++sLikelyShortLivingObjectsNeedingGC;
 }
 
+// static
+void nsJSContext::NotifyRefreshDriverTick(TimeDuration aTickDuration,
+                                          TimeDuration aFrameBudget) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  TimeDuration headroom;
+  if (aTickDuration < aFrameBudget) {
+    headroom = aFrameBudget - aTickDuration;
+  }
+
+  // Exponential smoothing so that a single cheap (or expensive) frame does
+  // not swing the slice budgets; an eighth per tick converges within a
+  // couple of frames.
+  sFrameHeadroomEstimate =
+      sFrameHeadroomEstimate.MultDouble(0.875) + headroom.MultDouble(0.125);
+  sLastFrameTickTime = TimeStamp::Now();
+}
+
 void mozilla::dom::StartupJSEnvironment() {
   // initialize all our statics, so that we can restart XPCOM
   sGCTimer = sShrinkingGCTimer = sFullGCTimer = nullptr;
   sCCLockedOut = false;
   sCCLockedOutTime = TimeStamp();
+  sFrameHeadroomEstimate = TimeDuration();
+  sLastFrameTickTime = TimeStamp();
   sLastCCEndTime = TimeStamp();
   sLastForgetSkippableCycleEndTime = TimeStamp();
   sHasRunGC = false;
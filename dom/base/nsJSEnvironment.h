@@ -113,6 +113,14 @@ class nsJSContext : public nsIScriptContext {
   // Calling LikelyShortLivingObjectCreated() makes a GC more likely.
   static void LikelyShortLivingObjectCreated();
 
+  // Called by the (unthrottled) refresh driver after every tick with how
+  // long the tick took and the frame budget it had. The interslice GC
+  // slice scheduler uses the reported headroom to size its slices: short
+  // slices while frames are being produced with little time to spare,
+  // longer ones when the refresh driver is quiet.
+  static void NotifyRefreshDriverTick(mozilla::TimeDuration aTickDuration,
+                                      mozilla::TimeDuration aFrameBudget);
+
   static uint32_t CleanupsSinceLastGC();
 
   nsIScriptGlobalObject* GetCachedGlobalObject() {
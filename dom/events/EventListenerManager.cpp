@@ -40,6 +40,7 @@
 #include "nsDOMCID.h"
 #include "nsError.h"
 #include "nsGkAtoms.h"
+#include "nsHashKeys.h"
 #include "nsIContent.h"
 #include "nsIContentSecurityPolicy.h"
 #include "mozilla/dom/Document.h"
@@ -49,6 +50,7 @@
 #include "nsNameSpaceManager.h"
 #include "nsPIDOMWindow.h"
 #include "nsSandboxFlags.h"
+#include "nsTHashtable.h"
 #include "xpcpublic.h"
 #include "nsIFrame.h"
 #include "nsDisplayList.h"
@@ -95,6 +97,25 @@ static uint32_t MutationBitForEventType(EventMessage aEventType) {
 
 uint32_t EventListenerManager::sMainThreadCreatedCount = 0;
 
+/**
+ * The listener types present in mListeners, used to short-circuit dispatch
+ * of events which no listener of this manager can handle.  Built lazily by
+ * HasInterestedListenerForEvent once a manager has kTypeIndexThreshold
+ * listeners and dropped wholesale whenever the listener list changes, so it
+ * may only ever overestimate the set of interesting types.
+ */
+struct EventListenerManager::ListenerTypeIndex {
+  // The event messages listeners other than eUnidentifiedEvent ones are
+  // registered for.
+  nsTHashtable<nsUint32HashKey> mMessages;
+  // The type atoms of all listeners; eUnidentifiedEvent events match
+  // listeners by atom rather than by message.
+  nsTHashtable<nsPtrHashKey<nsAtom>> mAtoms;
+  // Whether an all-events listener is present, in which case every event
+  // has an interested listener.
+  bool mHasAllEventsListener = false;
+};
+
 EventListenerManagerBase::EventListenerManagerBase()
     : mNoListenerForEvent(eVoidEvent),
       mMayHavePaintEventListener(false),
@@ -144,6 +165,7 @@ void EventListenerManager::RemoveAllListenersSilently() {
   }
   mClearingListeners = true;
   mListeners.Clear();
+  mTypeIndex = nullptr;
   mClearingListeners = false;
 }
 
@@ -230,6 +252,7 @@ void EventListenerManager::AddEventListenerInternal(
 
   mNoListenerForEvent = eVoidEvent;
   mNoListenerForEventAtom = nullptr;
+  mTypeIndex = nullptr;
 
   listener =
       aAllEvents ? mListeners.InsertElementAt(0) : mListeners.AppendElement();
@@ -564,6 +587,7 @@ void EventListenerManager::NotifyEventListenerRemoved(nsAtom* aUserType) {
   // and NotifyAboutMainThreadListenerChange should be changed too.
   mNoListenerForEvent = eVoidEvent;
   mNoListenerForEventAtom = nullptr;
+  mTypeIndex = nullptr;
   if (mTarget) {
     mTarget->EventListenerRemoved(aUserType);
   }
@@ -650,6 +674,45 @@ bool EventListenerManager::ListenerCanHandle(const Listener* aListener,
   return aListener->mEventMessage == aEventMessage;
 }
 
+bool EventListenerManager::HasInterestedListenerForEvent(
+    const WidgetEvent* aEvent) {
+  if (!mTypeIndex) {
+    mTypeIndex = MakeUnique<ListenerTypeIndex>();
+    uint32_t count = mListeners.Length();
+    for (uint32_t i = 0; i < count; ++i) {
+      const Listener* listener = &mListeners.ElementAt(i);
+      if (listener->mAllEvents) {
+        mTypeIndex->mHasAllEventsListener = true;
+        continue;
+      }
+      if (listener->mEventMessage != eUnidentifiedEvent) {
+        mTypeIndex->mMessages.PutEntry(listener->mEventMessage);
+      }
+      if (listener->mTypeAtom) {
+        mTypeIndex->mAtoms.PutEntry(listener->mTypeAtom);
+      }
+    }
+  }
+
+  if (mTypeIndex->mHasAllEventsListener) {
+    return true;
+  }
+  if (aEvent->mMessage == eUnidentifiedEvent) {
+    // Like ListenerCanHandle, match unidentified events against the atoms
+    // of all listeners, not just the eUnidentifiedEvent ones.
+    return mTypeIndex->mAtoms.Contains(aEvent->mSpecifiedEventType);
+  }
+  if (mTypeIndex->mMessages.Contains(aEvent->mMessage)) {
+    return true;
+  }
+  // HandleEventInternal rechecks the listeners using the legacy version of
+  // the event message if there is one, so we cannot bail out if a listener
+  // for the legacy version is registered.
+  EventMessage legacyEventMessage = GetLegacyEventMessage(aEvent->mMessage);
+  return legacyEventMessage != aEvent->mMessage &&
+         mTypeIndex->mMessages.Contains(legacyEventMessage);
+}
+
 static bool IsDefaultPassiveWhenOnRoot(EventMessage aMessage) {
   if (aMessage == eTouchStart || aMessage == eTouchMove) {
     return StaticPrefs::dom_event_default_to_passive_touch_listeners();
@@ -1633,6 +1696,11 @@ size_t EventListenerManager::SizeOfIncludingThis(
       n += jsEventHandler->SizeOfIncludingThis(aMallocSizeOf);
     }
   }
+  if (mTypeIndex) {
+    n += aMallocSizeOf(mTypeIndex.get());
+    n += mTypeIndex->mMessages.ShallowSizeOfExcludingThis(aMallocSizeOf);
+    n += mTypeIndex->mAtoms.ShallowSizeOfExcludingThis(aMallocSizeOf);
+  }
   return n;
 }
 
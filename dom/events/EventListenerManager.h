@@ -11,6 +11,7 @@
 #include "mozilla/dom/EventListenerBinding.h"
 #include "mozilla/JSEventHandler.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/UniquePtr.h"
 #include "nsCOMPtr.h"
 #include "nsCycleCollectionParticipant.h"
 #include "nsGkAtoms.h"
@@ -351,6 +352,14 @@ class EventListenerManager final : public EventListenerManagerBase {
          mNoListenerForEventAtom == aEvent->mSpecifiedEventType)) {
       return;
     }
+
+    // Managers with many listeners (e.g. event delegation roots) keep a
+    // type-indexed table of them so that events no one here is listening
+    // for don't have to walk the whole listener list.
+    if (mListeners.Length() >= kTypeIndexThreshold &&
+        !HasInterestedListenerForEvent(aEvent)) {
+      return;
+    }
     HandleEventInternal(aPresContext, aEvent, aDOMEvent, aCurrentTarget,
                         aEventStatus, aItemInShadowTree);
   }
@@ -606,6 +615,19 @@ class EventListenerManager final : public EventListenerManagerBase {
   bool ListenerCanHandle(const Listener* aListener, const WidgetEvent* aEvent,
                          EventMessage aEventMessage) const;
 
+  /**
+   * Returns false if the type-indexed listener table tells us that no
+   * listener of this manager can handle aEvent, so that dispatch doesn't
+   * need to walk the listener list at all.  Builds the table lazily if it
+   * doesn't exist yet; any listener addition or removal drops it.  Only
+   * worth consulting once a manager has kTypeIndexThreshold listeners.
+   */
+  bool HasInterestedListenerForEvent(const WidgetEvent* aEvent);
+
+  struct ListenerTypeIndex;
+
+  static const uint32_t kTypeIndexThreshold = 8;
+
   // BE AWARE, a lot of instances of EventListenerManager will be created.
   // Therefor, we need to keep this class compact.  When you add integer
   // members, please add them to EventListemerManagerBase and check the size
@@ -619,6 +641,7 @@ class EventListenerManager final : public EventListenerManagerBase {
   nsAutoTObserverArray<Listener, 2> mListeners;
   dom::EventTarget* MOZ_NON_OWNING_REF mTarget;
   RefPtr<nsAtom> mNoListenerForEventAtom;
+  UniquePtr<ListenerTypeIndex> mTypeIndex;
 
   friend class ELMCreationDetector;
   static uint32_t sMainThreadCreatedCount;
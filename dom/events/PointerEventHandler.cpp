@@ -570,6 +570,10 @@ void PointerEventHandler::DispatchPointerFromMouseOrTouch(
 
       InitPointerEventFromTouch(&event, touchEvent, touch, i == 0);
       event.convertToPointer = touch->convertToPointer = false;
+      // The touch carries the coalesced samples recorded while the touchmove
+      // was held back in the content process, so that getCoalescedEvents()
+      // works on the synthesized pointermove as well.
+      event.mCoalescedWidgetEvents = touch->mCoalescedWidgetEvents;
       if (aEvent->mMessage == eTouchStart) {
         // We already did hit test for touchstart in PresShell. We should
         // dispatch pointerdown to the same target as touchstart.
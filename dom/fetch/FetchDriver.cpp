@@ -51,6 +51,13 @@ namespace dom {
 
 namespace {
 
+// Segment size for the pipes carrying response bodies to the consumer.  Fetch
+// is routinely used for multi-megabyte payloads (media, wasm), for which the
+// pipe's default 4 KiB segments mean thousands of small allocations and
+// partial writes; 64 KiB matches the typical size of the data chunks the
+// channel delivers.
+const uint32_t kFetchBodyPipeSegmentSize = 64 * 1024;
+
 void GetBlobURISpecFromChannel(nsIRequest* aRequest, nsCString& aBlobURISpec) {
   MOZ_ASSERT(aRequest);
 
@@ -221,7 +228,7 @@ AlternativeDataStreamListener::OnStartRequest(nsIRequest* aRequest) {
     nsresult rv =
         NS_NewPipe(getter_AddRefs(mPipeAlternativeInputStream),
                    getter_AddRefs(mPipeAlternativeOutputStream),
-                   0 /* default segment size */, UINT32_MAX /* infinite pipe */,
+                   kFetchBodyPipeSegmentSize, UINT32_MAX /* infinite pipe */,
                    true /* non-blocking input, otherwise you deadlock */,
                    false /* blocking output, since the pipe is 'in'finite */);
 
@@ -705,12 +712,13 @@ nsresult FetchDriver::HttpFetch(
     }
   } else {
     // Integrity check cannot be done on alt-data yet.
-    if (mRequest->GetIntegrity().IsEmpty()) {
+    if (mRequest->GetIntegrity().IsEmpty() &&
+        !FetchUtil::WasmAltDataType.IsEmpty()) {
       nsCOMPtr<nsICacheInfoChannel> cic = do_QueryInterface(chan);
       if (cic) {
-        cic->PreferAlternativeDataType(
-            NS_LITERAL_CSTRING(WASM_ALT_DATA_TYPE_V1),
-            NS_LITERAL_CSTRING(WASM_CONTENT_TYPE), false);
+        cic->PreferAlternativeDataType(FetchUtil::WasmAltDataType,
+                                       NS_LITERAL_CSTRING(WASM_CONTENT_TYPE),
+                                       false);
       }
     }
 
@@ -950,8 +958,8 @@ FetchDriver::OnStartRequest(nsIRequest* aRequest) {
       }
     } else if (!cic->PreferredAlternativeDataTypes().IsEmpty()) {
       MOZ_ASSERT(cic->PreferredAlternativeDataTypes().Length() == 1);
-      MOZ_ASSERT(cic->PreferredAlternativeDataTypes()[0].type().EqualsLiteral(
-          WASM_ALT_DATA_TYPE_V1));
+      MOZ_ASSERT(cic->PreferredAlternativeDataTypes()[0].type().Equals(
+          FetchUtil::WasmAltDataType));
       MOZ_ASSERT(
           cic->PreferredAlternativeDataTypes()[0].contentType().EqualsLiteral(
               WASM_CONTENT_TYPE));
@@ -980,8 +988,7 @@ FetchDriver::OnStartRequest(nsIRequest* aRequest) {
   nsCOMPtr<nsIInputStream> pipeInputStream;
   rv = NS_NewPipe(getter_AddRefs(pipeInputStream),
                   getter_AddRefs(mPipeOutputStream),
-                  0, /* default segment size */
-                  UINT32_MAX /* infinite pipe */,
+                  kFetchBodyPipeSegmentSize, UINT32_MAX /* infinite pipe */,
                   true /* non-blocking input, otherwise you deadlock */,
                   false /* blocking output, since the pipe is 'in'finite */);
   if (NS_WARN_IF(NS_FAILED(rv))) {
@@ -6,16 +6,43 @@
 
 #include "FetchUtil.h"
 
+#include "js/BuildId.h"  // JS::BuildIdCharVector, JS::GetOptimizedEncodingBuildId
+#include "mozilla/Vector.h"
 #include "nsError.h"
+#include "nsIAsyncOutputStream.h"
+#include "nsICacheInfoChannel.h"
+#include "nsProxyRelease.h"
 #include "nsString.h"
 #include "mozilla/dom/Document.h"
 
 #include "mozilla/dom/InternalRequest.h"
+#include "mozilla/dom/InternalResponse.h"
 #include "mozilla/dom/WorkerRef.h"
 
 namespace mozilla {
 namespace dom {
 
+// static
+nsCString FetchUtil::WasmAltDataType;
+
+// static
+void FetchUtil::InitWasmAltDataType() {
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(WasmAltDataType.IsEmpty());
+
+  // Builds with a different build id (or different CPU features, which the
+  // build id covers) cannot consume each other's machine code, so bake the
+  // build id into the alternate data type. If no build id is available,
+  // leaving the type empty disables wasm caching.
+  JS::BuildIdCharVector buildId;
+  if (!JS::GetOptimizedEncodingBuildId(&buildId)) {
+    return;
+  }
+
+  WasmAltDataType.Append(WASM_ALT_DATA_TYPE_V1);
+  WasmAltDataType.Append(buildId.begin(), buildId.length());
+}
+
 // static
 nsresult FetchUtil::GetValidRequestMethod(const nsACString& aMethod,
                                           nsCString& outMethod) {
@@ -238,6 +265,17 @@ class WindowStreamOwner final : public nsIObserver,
     mGlobal = nullptr;
     return NS_OK;
   }
+
+  // Close the owned stream and own the given one instead, so that it is also
+  // closed if the window is destroyed.
+  void ReplaceStream(nsIAsyncInputStream* aStream) {
+    MOZ_ASSERT(NS_IsMainThread());
+
+    if (mStream) {
+      mStream->Close();
+    }
+    mStream = aStream;
+  }
 };
 
 NS_IMPL_ISUPPORTS(WindowStreamOwner, nsIObserver, nsISupportsWeakReference)
@@ -295,19 +333,37 @@ class WorkerStreamOwner final {
   RefPtr<WeakWorkerRef> mWorkerRef;
 };
 
-class JSStreamConsumer final : public nsIInputStreamCallback {
+class JSStreamConsumer final : public nsIInputStreamCallback,
+                               public nsIInputStreamReceiver,
+                               public JS::OptimizedEncodingListener {
   nsCOMPtr<nsIEventTarget> mOwningEventTarget;
   RefPtr<WindowStreamOwner> mWindowStreamOwner;
   RefPtr<WorkerStreamOwner> mWorkerStreamOwner;
   JS::StreamConsumer* mConsumer;
   bool mConsumerAborted;
 
-  JSStreamConsumer(already_AddRefed<WindowStreamOwner> aWindowStreamOwner,
-                   nsIGlobalObject* aGlobal, JS::StreamConsumer* aConsumer)
+  // The cache entry of a wasm response may hold an optimized encoding (viz.,
+  // compiled machine code) of the response bytes as alternate data. When it
+  // does, the bytes are read instead of the body and accumulated here so that
+  // they can be handed to the JS engine in one piece; when it does not, the
+  // channel is passed to streamEnd() so the JS engine can store an optimized
+  // encoding for the next load. Wasm caching is limited to window (main
+  // thread) responses since the channel can only be used on the main thread.
+  nsMainThreadPtrHandle<nsICacheInfoChannel> mCacheInfoChannel;
+  nsCOMPtr<nsIAsyncInputStream> mBodyStream;
+  Vector<uint8_t> mOptimizedEncodingBytes;
+  bool mOptimizedEncoding;
+
+  JSStreamConsumer(
+      already_AddRefed<WindowStreamOwner> aWindowStreamOwner,
+      nsIGlobalObject* aGlobal, JS::StreamConsumer* aConsumer,
+      nsMainThreadPtrHandle<nsICacheInfoChannel>&& aCacheInfoChannel)
       : mOwningEventTarget(aGlobal->EventTargetFor(TaskCategory::Other)),
         mWindowStreamOwner(aWindowStreamOwner),
         mConsumer(aConsumer),
-        mConsumerAborted(false) {
+        mConsumerAborted(false),
+        mCacheInfoChannel(std::move(aCacheInfoChannel)),
+        mOptimizedEncoding(false) {
     MOZ_DIAGNOSTIC_ASSERT(mWindowStreamOwner);
     MOZ_DIAGNOSTIC_ASSERT(mConsumer);
   }
@@ -317,7 +373,8 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
       : mOwningEventTarget(aGlobal->EventTargetFor(TaskCategory::Other)),
         mWorkerStreamOwner(std::move(aWorkerStreamOwner)),
         mConsumer(aConsumer),
-        mConsumerAborted(false) {
+        mConsumerAborted(false),
+        mOptimizedEncoding(false) {
     MOZ_DIAGNOSTIC_ASSERT(mWorkerStreamOwner);
     MOZ_DIAGNOSTIC_ASSERT(mConsumer);
   }
@@ -345,11 +402,20 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
     JSStreamConsumer* self = reinterpret_cast<JSStreamConsumer*>(aClosure);
     MOZ_DIAGNOSTIC_ASSERT(!self->mConsumerAborted);
 
-    // This callback can be called on any thread which is explicitly allowed by
-    // this particular JS API call.
-    if (!self->mConsumer->consumeChunk((const uint8_t*)aFromSegment, aCount)) {
-      self->mConsumerAborted = true;
-      return NS_ERROR_UNEXPECTED;
+    if (self->mOptimizedEncoding) {
+      // An optimized encoding can only be consumed in one piece, so accumulate
+      // the stream until it reaches the end.
+      if (!self->mOptimizedEncodingBytes.append(aFromSegment, aCount)) {
+        return NS_ERROR_OUT_OF_MEMORY;
+      }
+    } else {
+      // This callback can be called on any thread which is explicitly allowed
+      // by this particular JS API call.
+      if (!self->mConsumer->consumeChunk((const uint8_t*)aFromSegment,
+                                         aCount)) {
+        self->mConsumerAborted = true;
+        return NS_ERROR_UNEXPECTED;
+      }
     }
 
     *aWriteCount = aCount;
@@ -361,7 +427,9 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
 
   static bool Start(nsCOMPtr<nsIInputStream>&& aStream,
                     JS::StreamConsumer* aConsumer, nsIGlobalObject* aGlobal,
-                    WorkerPrivate* aMaybeWorker) {
+                    WorkerPrivate* aMaybeWorker,
+                    nsMainThreadPtrHandle<nsICacheInfoChannel>&&
+                        aCacheInfoChannel) {
     nsCOMPtr<nsIAsyncInputStream> asyncStream;
     nsresult rv = NS_MakeAsyncNonBlockingInputStream(
         aStream.forget(), getter_AddRefs(asyncStream));
@@ -371,6 +439,8 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
 
     RefPtr<JSStreamConsumer> consumer;
     if (aMaybeWorker) {
+      MOZ_ASSERT(!aCacheInfoChannel);
+
       RefPtr<WorkerStreamOwner> owner =
           WorkerStreamOwner::Create(asyncStream, aMaybeWorker);
       if (!owner) {
@@ -385,7 +455,28 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
         return false;
       }
 
-      consumer = new JSStreamConsumer(owner.forget(), aGlobal, aConsumer);
+      consumer = new JSStreamConsumer(owner.forget(), aGlobal, aConsumer,
+                                      std::move(aCacheInfoChannel));
+
+      if (consumer->mCacheInfoChannel) {
+        nsAutoCString altDataType;
+        if (NS_SUCCEEDED(consumer->mCacheInfoChannel->GetAlternativeDataType(
+                altDataType)) &&
+            FetchUtil::WasmAltDataType.Equals(altDataType)) {
+          // The cache entry holds an optimized encoding of this response, so
+          // read that instead of the body. The channel delivers the original
+          // data regardless (the alt-data preference was registered with
+          // deliverAltData = false), so the body stream is kept on hand and
+          // streamed as usual if the alternate data cannot be opened. The
+          // receiver callback keeps the consumer alive until then.
+          consumer->mBodyStream = asyncStream;
+          if (NS_SUCCEEDED(consumer->mCacheInfoChannel->GetAltDataInputStream(
+                  altDataType, consumer))) {
+            return true;
+          }
+          consumer->mBodyStream = nullptr;
+        }
+      }
     }
 
     // This AsyncWait() creates a ref-cycle between asyncStream and consumer:
@@ -414,7 +505,14 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
     }
 
     if (rv == NS_BASE_STREAM_CLOSED) {
-      mConsumer->streamEnd();
+      if (mOptimizedEncoding) {
+        mConsumer->consumeOptimizedEncoding(mOptimizedEncodingBytes.begin(),
+                                            mOptimizedEncodingBytes.length());
+      } else {
+        // Pass a listener iff there is a cache entry that an optimized
+        // encoding of the stream can be stored into.
+        mConsumer->streamEnd(mCacheInfoChannel ? this : nullptr);
+      }
       return NS_OK;
     }
 
@@ -443,9 +541,104 @@ class JSStreamConsumer final : public nsIInputStreamCallback {
 
     return NS_OK;
   }
+
+  // nsIInputStreamReceiver:
+
+  NS_IMETHOD
+  OnInputStreamReady(nsIInputStream* aAltDataStream) override {
+    MOZ_ASSERT(NS_IsMainThread());
+    MOZ_ASSERT(!mOptimizedEncoding);
+    MOZ_DIAGNOSTIC_ASSERT(mBodyStream);
+
+    // Called with the alternate data input stream of the cache entry, or with
+    // null if the entry lost its alternate data in the meantime. In the
+    // latter case fall back to streaming the body.
+    nsCOMPtr<nsIAsyncInputStream> altStream;
+    if (aAltDataStream) {
+      nsCOMPtr<nsIInputStream> stream(aAltDataStream);
+      nsresult rv = NS_MakeAsyncNonBlockingInputStream(
+          stream.forget(), getter_AddRefs(altStream));
+      if (NS_WARN_IF(NS_FAILED(rv))) {
+        altStream = nullptr;
+      }
+    }
+
+    if (altStream) {
+      // The body is not needed anymore; closing it lets the channel stop
+      // buffering it. The owner takes over the alternate data stream so that
+      // it is closed if the window is destroyed.
+      mWindowStreamOwner->ReplaceStream(altStream);
+      mBodyStream = nullptr;
+      mOptimizedEncoding = true;
+
+      if (NS_SUCCEEDED(altStream->AsyncWait(this, 0, 0, nullptr))) {
+        return NS_OK;
+      }
+
+      mConsumer->streamError(size_t(NS_ERROR_UNEXPECTED));
+      return NS_OK;
+    }
+
+    nsCOMPtr<nsIAsyncInputStream> bodyStream = mBodyStream.forget();
+    if (NS_WARN_IF(NS_FAILED(bodyStream->AsyncWait(this, 0, 0, nullptr)))) {
+      mConsumer->streamError(size_t(NS_ERROR_UNEXPECTED));
+    }
+    return NS_OK;
+  }
+
+  // JS::OptimizedEncodingListener:
+
+  void storeOptimizedEncoding(JS::UniqueOptimizedEncodingBytes aBytes)
+      override {
+    MOZ_ASSERT(mCacheInfoChannel);
+
+    // Called by the JS engine on a helper thread once tier-2 compilation has
+    // finished. The cache entry can only be written on the main thread.
+    class StoreRunnable final : public Runnable {
+      nsMainThreadPtrHandle<nsICacheInfoChannel> mCacheInfoChannel;
+      JS::UniqueOptimizedEncodingBytes mBytes;
+
+     public:
+      StoreRunnable(
+          const nsMainThreadPtrHandle<nsICacheInfoChannel>& aCacheInfoChannel,
+          JS::UniqueOptimizedEncodingBytes aBytes)
+          : Runnable("JSStreamConsumer::StoreRunnable"),
+            mCacheInfoChannel(aCacheInfoChannel),
+            mBytes(std::move(aBytes)) {}
+
+      NS_IMETHOD
+      Run() override {
+        MOZ_ASSERT(NS_IsMainThread());
+
+        // Failure to store is simply a cache miss on the next load.
+        nsCOMPtr<nsIAsyncOutputStream> stream;
+        nsresult rv = mCacheInfoChannel->OpenAlternativeOutputStream(
+            FetchUtil::WasmAltDataType, mBytes->length(),
+            getter_AddRefs(stream));
+        if (NS_FAILED(rv)) {
+          return NS_OK;
+        }
+
+        uint32_t written;
+        rv = stream->Write(reinterpret_cast<char*>(mBytes->begin()),
+                           mBytes->length(), &written);
+        if (NS_FAILED(rv) || written != mBytes->length()) {
+          stream->CloseWithStatus(NS_ERROR_UNEXPECTED);
+          return NS_OK;
+        }
+
+        stream->Close();
+        return NS_OK;
+      }
+    };
+
+    NS_DispatchToMainThread(
+        new StoreRunnable(mCacheInfoChannel, std::move(aBytes)));
+  }
 };
 
-NS_IMPL_ISUPPORTS(JSStreamConsumer, nsIInputStreamCallback)
+NS_IMPL_ISUPPORTS(JSStreamConsumer, nsIInputStreamCallback,
+                  nsIInputStreamReceiver)
 
 static bool ThrowException(JSContext* aCx, unsigned errorNumber) {
   JS_ReportErrorNumberASCII(aCx, js::GetErrorMessage, nullptr, errorNumber);
@@ -517,6 +710,16 @@ bool FetchUtil::StreamResponseToJS(JSContext* aCx, JS::HandleObject aObj,
     return ThrowException(aCx, JSMSG_OUT_OF_MEMORY);
   }
 
+  // The FetchDriver attaches the channel to wasm responses so that an
+  // optimized encoding (compiled machine code) of the response can be loaded
+  // from and stored into the cache entry's alternate data. The channel can
+  // only be used on the main thread, so wasm caching is limited to window
+  // responses.
+  nsMainThreadPtrHandle<nsICacheInfoChannel> cacheInfoChannel;
+  if (!aMaybeWorker && !FetchUtil::WasmAltDataType.IsEmpty()) {
+    cacheInfoChannel = ir->TakeCacheInfoChannel();
+  }
+
   nsCOMPtr<nsIInputStream> body;
   ir->GetUnfilteredBody(getter_AddRefs(body));
   if (!body) {
@@ -533,7 +736,7 @@ bool FetchUtil::StreamResponseToJS(JSContext* aCx, JS::HandleObject aObj,
   nsIGlobalObject* global = xpc::NativeGlobal(js::UncheckedUnwrap(aObj));
 
   if (!JSStreamConsumer::Start(std::move(body), aConsumer, global,
-                               aMaybeWorker)) {
+                               aMaybeWorker, std::move(cacheInfoChannel))) {
     return ThrowException(aCx, JSMSG_OUT_OF_MEMORY);
   }
 
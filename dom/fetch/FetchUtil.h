@@ -15,7 +15,7 @@
 #include "mozilla/dom/FormData.h"
 
 #define WASM_CONTENT_TYPE "application/wasm"
-#define WASM_ALT_DATA_TYPE_V1 "wasm/machine-code/1"
+#define WASM_ALT_DATA_TYPE_V1 "wasm/machine-code/1/"
 
 class nsIPrincipal;
 class nsIHttpChannel;
@@ -64,6 +64,22 @@ class FetchUtil final {
                                  JS::StreamConsumer* aConsumer,
                                  WorkerPrivate* aMaybeWorker);
 
+  /**
+   * The HTTP cache alternate-data type used to store and load optimized wasm
+   * machine code for a response. The type string includes the build id (which
+   * itself covers the enabled CPU features), so machine code stored by a
+   * different build or on a different machine is simply a cache miss. The
+   * empty string if InitWasmAltDataType() has not run or no build id was
+   * available, in which case wasm caching is disabled.
+   */
+  static nsCString WasmAltDataType;
+
+  /**
+   * Initialize WasmAltDataType. Must be called on the main thread, after the
+   * process build id callback has been installed on the JS engine.
+   */
+  static void InitWasmAltDataType();
+
   /**
    * Called by JS to report (i.e., throw) an error that was passed to the
    * JS::StreamConsumer::streamError() method on a random stream thread.
@@ -30,7 +30,9 @@
 #include "nsIObserverService.h"
 #include "mozilla/dom/Link.h"
 
+#include "mozilla/BasePrincipal.h"
 #include "mozilla/Components.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/Preferences.h"
 
 using namespace mozilla;
@@ -43,6 +45,50 @@ static nsIDNSService* sDNSService = nullptr;
 static nsHTMLDNSPrefetch::nsDeferrals* sPrefetches = nullptr;
 static nsHTMLDNSPrefetch::nsListener* sDNSListener = nullptr;
 bool sEsniEnabled;
+static uint32_t sMaxPrefetchesPerDocument = 512;
+
+// A small ring of recently submitted lookup keys. Pages stuffed with links
+// repeat the same handful of hosts over and over, and every duplicate costs
+// a resolver (or, in a child process, IPC) round trip just to discover the
+// answer is already cached. The ring is only touched on the main thread, so
+// it needs no lock; it stores hashes because a false positive merely skips
+// a speculative lookup and a false negative merely repeats one.
+static const uint32_t sRecentPrefetchSize = 64;  // keep power of 2
+static uint32_t sRecentPrefetch[sRecentPrefetchSize];
+static uint32_t sRecentPrefetchNext = 0;
+
+static uint32_t PrefetchKey(const nsACString& aHostname, bool aIsHttps,
+                            const OriginAttributes& aOriginAttributes) {
+  nsAutoCString suffix;
+  aOriginAttributes.CreateSuffix(suffix);
+  uint32_t key = AddToHash(HashString(aHostname), HashString(suffix),
+                           aIsHttps ? 1 : 0);
+  return key ? key : 1;  // 0 marks an empty slot
+}
+
+static bool RecentlyPrefetched(const nsACString& aHostname, bool aIsHttps,
+                               const OriginAttributes& aOriginAttributes) {
+  MOZ_ASSERT(NS_IsMainThread());
+  uint32_t key = PrefetchKey(aHostname, aIsHttps, aOriginAttributes);
+  for (uint32_t i = 0; i < sRecentPrefetchSize; ++i) {
+    if (sRecentPrefetch[i] == key) {
+      return true;
+    }
+  }
+  sRecentPrefetch[sRecentPrefetchNext++ & (sRecentPrefetchSize - 1)] = key;
+  return false;
+}
+
+static void ForgetRecentPrefetch(const nsACString& aHostname, bool aIsHttps,
+                                 const OriginAttributes& aOriginAttributes) {
+  MOZ_ASSERT(NS_IsMainThread());
+  uint32_t key = PrefetchKey(aHostname, aIsHttps, aOriginAttributes);
+  for (uint32_t i = 0; i < sRecentPrefetchSize; ++i) {
+    if (sRecentPrefetch[i] == key) {
+      sRecentPrefetch[i] = 0;
+    }
+  }
+}
 
 nsresult nsHTMLDNSPrefetch::Initialize() {
   if (sInitialized) {
@@ -62,6 +108,9 @@ nsresult nsHTMLDNSPrefetch::Initialize() {
 
   sEsniEnabled = Preferences::GetBool("network.security.esni.enabled", false);
 
+  Preferences::AddUintVarCache(&sMaxPrefetchesPerDocument,
+                               "network.dns.max-prefetches-per-document", 512);
+
   NS_IF_RELEASE(sDNSService);
   nsresult rv;
   rv = CallGetService(kDNSServiceCID, &sDNSService);
@@ -124,11 +173,13 @@ nsresult nsHTMLDNSPrefetch::PrefetchHigh(Link* aElement) {
 nsresult nsHTMLDNSPrefetch::Prefetch(const nsAString& hostname, bool isHttps,
                                      const OriginAttributes& aOriginAttributes,
                                      uint32_t flags) {
+  NS_ConvertUTF16toUTF8 host(hostname);
+
   if (IsNeckoChild()) {
     // We need to check IsEmpty() because net_IsValidHostName()
     // considers empty strings to be valid hostnames
-    if (!hostname.IsEmpty() &&
-        net_IsValidHostName(NS_ConvertUTF16toUTF8(hostname))) {
+    if (!hostname.IsEmpty() && net_IsValidHostName(host) &&
+        !RecentlyPrefetched(host, isHttps, aOriginAttributes)) {
       // during shutdown gNeckoChild might be null
       if (gNeckoChild) {
         gNeckoChild->SendHTMLDNSPrefetch(nsString(hostname), isHttps,
@@ -141,10 +192,14 @@ nsresult nsHTMLDNSPrefetch::Prefetch(const nsAString& hostname, bool isHttps,
   if (!(sInitialized && sDNSService && sPrefetches && sDNSListener))
     return NS_ERROR_NOT_AVAILABLE;
 
+  if (RecentlyPrefetched(host, isHttps, aOriginAttributes)) {
+    return NS_OK;
+  }
+
   nsCOMPtr<nsICancelable> tmpOutstanding;
   nsresult rv = sDNSService->AsyncResolveNative(
-      NS_ConvertUTF16toUTF8(hostname), flags | nsIDNSService::RESOLVE_SPECULATE,
-      sDNSListener, nullptr, aOriginAttributes, getter_AddRefs(tmpOutstanding));
+      host, flags | nsIDNSService::RESOLVE_SPECULATE, sDNSListener, nullptr,
+      aOriginAttributes, getter_AddRefs(tmpOutstanding));
   if (NS_FAILED(rv)) {
     return rv;
   }
@@ -212,6 +267,10 @@ nsresult nsHTMLDNSPrefetch::CancelPrefetch(
     const nsAString& hostname, bool isHttps,
     const OriginAttributes& aOriginAttributes, uint32_t flags,
     nsresult aReason) {
+  // A cancelled lookup must not suppress a later prefetch of the same host.
+  ForgetRecentPrefetch(NS_ConvertUTF16toUTF8(hostname), isHttps,
+                       aOriginAttributes);
+
   // Forward this request to Necko Parent if we're a child process
   if (IsNeckoChild()) {
     // We need to check IsEmpty() because net_IsValidHostName()
@@ -325,6 +384,14 @@ nsresult nsHTMLDNSPrefetch::nsDeferrals::Add(uint32_t flags, Link* aElement) {
   // The FIFO has no lock, so it can only be accessed on main thread
   NS_ASSERTION(NS_IsMainThread(), "nsDeferrals::Add must be on main thread");
 
+  // Link-dense pages can carry far more anchors than any user will hover,
+  // so stop charging the resolver once the document has used its quota.
+  Element* element = aElement->GetElement();
+  if (element &&
+      !element->OwnerDoc()->ConsumeDNSPrefetchQuota(sMaxPrefetchesPerDocument)) {
+    return NS_OK;
+  }
+
   aElement->OnDNSPrefetchDeferred();
 
   if (((mHead + 1) & sMaxDeferredMask) == mTail)
@@ -372,7 +439,10 @@ void nsHTMLDNSPrefetch::nsDeferrals::SubmitQueue() {
         }
 
         if (!hostName.IsEmpty() && NS_SUCCEEDED(rv) && !isLocalResource &&
-            element) {
+            element &&
+            !RecentlyPrefetched(
+                hostName, isHttps,
+                element->NodePrincipal()->OriginAttributesRef())) {
           if (IsNeckoChild()) {
             // during shutdown gNeckoChild might be null
             if (gNeckoChild) {
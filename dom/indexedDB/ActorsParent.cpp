@@ -7958,6 +7958,16 @@ class CursorBase : public PBackgroundIDBCursorParent {
 
   const int32_t mMaxExtraCount;
 
+  // The number of extra records to preload with the next response.  This
+  // starts small, so that cursors which are only iterated a few times don't
+  // pay for records that are never consumed, and is doubled (up to
+  // mMaxExtraCount) every time the child comes back for more, which proves it
+  // exhausted the previously preloaded window.  This is written on the
+  // PBackground thread before an op is dispatched and read by that op on a
+  // connection thread, which is ordered by the dispatch (there is only ever
+  // one op in flight per cursor, cf. mCurrentlyRunningOp).
+  int32_t mPreloadExtraCount;
+
   const bool mIsSameProcessActor;
 
   struct ConstructFromTransactionBase {};
@@ -15883,6 +15893,7 @@ CursorBase::CursorBase(RefPtr<TransactionBase> aTransaction,
       mObjectStoreId((*mObjectStoreMetadata)->mCommonMetadata.id()),
       mDirection(aDirection),
       mMaxExtraCount(IndexedDatabaseManager::MaxPreloadExtraRecords()),
+      mPreloadExtraCount(std::min(int32_t(4), mMaxExtraCount)),
       mIsSameProcessActor(!BackgroundParent::IsOtherProcessActor(
           mTransaction->GetBackgroundParent())) {
   AssertIsOnBackgroundThread();
@@ -16222,6 +16233,14 @@ mozilla::ipc::IPCResult Cursor<CursorType>::RecvContinue(
     return IPC_FAIL_NO_REASON(this);
   }
 
+  // The child only sends a continue request when it has run out of preloaded
+  // responses, so consumption of the previous window has been demonstrated and
+  // we widen the window for the next response. This stays at zero when
+  // preloading is disabled altogether (mMaxExtraCount == 0).
+  this->mPreloadExtraCount =
+      std::min(std::max(2 * this->mPreloadExtraCount, int32_t(1)),
+               this->mMaxExtraCount);
+
   const RefPtr<ContinueOp> continueOp =
       new ContinueOp(this, aParams, positionOrError.unwrap());
   if (NS_WARN_IF(!continueOp->Init(mTransaction))) {
@@ -25295,16 +25314,25 @@ nsresult ObjectStoreAddOrPutRequestOp::DoDatabaseWork(
       return rv;
     }
   } else {
+    // Compress the bytes before adding into the database.  If the clone data
+    // fits in a single segment we can compress directly from it; otherwise we
+    // have to flatten the segments into a temporary buffer first.  Bulk
+    // operations consist mostly of small records, so the copy is usually
+    // avoided.
     nsCString flatCloneData;
-    flatCloneData.SetLength(cloneDataSize);
     auto iter = cloneData.Start();
-    if (NS_WARN_IF(!cloneData.ReadBytes(iter, flatCloneData.BeginWriting(),
-                                        cloneDataSize))) {
-      return NS_ERROR_OUT_OF_MEMORY;
+    const char* uncompressed;
+    if (cloneDataSize && iter.RemainingInSegment() >= cloneDataSize) {
+      uncompressed = iter.Data();
+    } else {
+      flatCloneData.SetLength(cloneDataSize);
+      if (NS_WARN_IF(!cloneData.ReadBytes(iter, flatCloneData.BeginWriting(),
+                                          cloneDataSize))) {
+        return NS_ERROR_OUT_OF_MEMORY;
+      }
+      uncompressed = flatCloneData.BeginReading();
     }
 
-    // Compress the bytes before adding into the database.
-    const char* uncompressed = flatCloneData.BeginReading();
     size_t uncompressedLength = cloneDataSize;
 
     size_t compressedLength = snappy::MaxCompressedLength(uncompressedLength);
@@ -26625,7 +26653,7 @@ nsresult CursorOpBaseHelperBase<CursorType>::PopulateExtraResponses(
 
   auto accumulatedResponseSize = aInitialResponseSize;
   uint32_t extraCount = 0;
-  do {
+  while (extraCount < aMaxExtraCount) {
     bool hasResult;
     nsresult rv = aStmt->ExecuteStep(&hasResult);
     if (NS_WARN_IF(NS_FAILED(rv))) {
@@ -26673,7 +26701,7 @@ nsresult CursorOpBaseHelperBase<CursorType>::PopulateExtraResponses(
 
     // TODO: Do not count entries skipped for unique cursors.
     ++extraCount;
-  } while (true);
+  }
 
   IDB_LOG_MARK_PARENT_TRANSACTION_REQUEST(
       "PRELOAD: %s: Number of extra results populated: %" PRIu32 "/%" PRIu32,
@@ -26875,9 +26903,9 @@ nsresult CommonOpenOpHelper<CursorType>::ProcessStatementSteps(
   // on the parameters of subsequent ContinueOp operations, see also comment in
   // ContinueOp::DoDatabaseWork.
   //
-  // TODO: We should somehow evaluate the effects of this. Maybe use a smaller
-  // extra count than for ContinueOp?
-  return PopulateExtraResponses(aStmt, GetCursor().mMaxExtraCount,
+  // mPreloadExtraCount starts small exactly because of this: only cursors
+  // whose consumers demonstrably iterate them get the full window.
+  return PopulateExtraResponses(aStmt, GetCursor().mPreloadExtraCount,
                                 res.inspect(), NS_LITERAL_CSTRING("OpenOp"),
                                 optPreviousKey);
 }
@@ -27311,7 +27339,8 @@ nsresult Cursor<CursorType>::ContinueOp::DoDatabaseWork(
   // preload only for an assumed basic operation. Other operations would require
   // more work on the client side for invalidation, and may not make any sense
   // at all.
-  const uint32_t maxExtraCount = hasContinueKey ? 0 : mCursor->mMaxExtraCount;
+  const uint32_t maxExtraCount =
+      hasContinueKey ? 0 : mCursor->mPreloadExtraCount;
 
   DatabaseConnection::CachedStatement stmt;
   nsresult rv = aConnection->GetCachedStatement(
@@ -27323,9 +27352,8 @@ nsresult Cursor<CursorType>::ContinueOp::DoDatabaseWork(
   }
 
   // Bind limit.
-  rv = stmt->BindUTF8StringByName(
-      kStmtParamNameLimit,
-      ToAutoCString(advanceCount + mCursor->mMaxExtraCount));
+  rv = stmt->BindUTF8StringByName(kStmtParamNameLimit,
+                                  ToAutoCString(advanceCount + maxExtraCount));
   if (NS_WARN_IF(NS_FAILED(rv))) {
     return rv;
   }
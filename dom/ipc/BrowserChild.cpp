@@ -406,6 +406,11 @@ BrowserChild::BrowserChild(ContentChild* aManager, const TabId& aTabId,
   if (mCoalesceMouseMoveEvents) {
     mCoalescedMouseEventFlusher = new CoalescedMouseMoveFlusher(this);
   }
+  mCoalesceTouchMoveEvents =
+      Preferences::GetBool("dom.event.coalesce_touch_move");
+  if (mCoalesceTouchMoveEvents) {
+    mCoalescedTouchMoveEventFlusher = new CoalescedTouchMoveFlusher(this);
+  }
 }
 
 const CompositorOptions& BrowserChild::GetCompositorOptions() const {
@@ -952,6 +957,11 @@ void BrowserChild::DestroyWindow() {
     mCoalescedMouseEventFlusher = nullptr;
   }
 
+  if (mCoalescedTouchMoveEventFlusher) {
+    mCoalescedTouchMoveEventFlusher->RemoveObserver();
+    mCoalescedTouchMoveEventFlusher = nullptr;
+  }
+
   if (mSessionStoreListener) {
     mSessionStoreListener->RemoveListeners();
     mSessionStoreListener = nullptr;
@@ -1616,6 +1626,29 @@ void BrowserChild::FlushAllCoalescedMouseData() {
   mCoalescedMouseData.Clear();
 }
 
+void BrowserChild::ProcessPendingCoalescedTouchData() {
+  MOZ_ASSERT(mCoalesceTouchMoveEvents);
+
+  if (mCoalescedTouchData.IsEmpty()) {
+    return;
+  }
+
+  UniquePtr<WidgetTouchEvent> touchMoveEvent =
+      mCoalescedTouchData.TakeCoalescedEvent();
+  Unused << RecvRealTouchEvent(*touchMoveEvent,
+                               mCoalescedTouchData.GetScrollableLayerGuid(),
+                               mCoalescedTouchData.GetInputBlockId(),
+                               mCoalescedTouchData.GetApzResponse());
+
+  // We may reentry the event loop while dispatching the event and coalesce
+  // more touchmove data; keep the observer in that case. Note that
+  // mCoalescedTouchMoveEventFlusher may be destroyed when reentrying the
+  // event loop.
+  if (mCoalescedTouchMoveEventFlusher && mCoalescedTouchData.IsEmpty()) {
+    mCoalescedTouchMoveEventFlusher->RemoveObserver();
+  }
+}
+
 mozilla::ipc::IPCResult BrowserChild::RecvRealMouseMoveEvent(
     const WidgetMouseEvent& aEvent, const ScrollableLayerGuid& aGuid,
     const uint64_t& aInputBlockId) {
@@ -1864,6 +1897,12 @@ mozilla::ipc::IPCResult BrowserChild::RecvRealTouchEvent(
   MOZ_LOG(sApzChildLog, LogLevel::Debug,
           ("Receiving touch event of type %d\n", aEvent.mMessage));
 
+  if (aEvent.mMessage != eTouchMove && mCoalesceTouchMoveEvents) {
+    // A pending coalesced touchmove must be dispatched before any other touch
+    // event so that content observes the touches in the order they happened.
+    ProcessPendingCoalescedTouchData();
+  }
+
   WidgetTouchEvent localEvent(aEvent);
   localEvent.mWidget = mPuppetWidget;
 
@@ -1910,6 +1949,20 @@ mozilla::ipc::IPCResult BrowserChild::RecvNormalPriorityRealTouchEvent(
 mozilla::ipc::IPCResult BrowserChild::RecvRealTouchMoveEvent(
     const WidgetTouchEvent& aEvent, const ScrollableLayerGuid& aGuid,
     const uint64_t& aInputBlockId, const nsEventStatus& aApzResponse) {
+  if (mCoalesceTouchMoveEvents && mCoalescedTouchMoveEventFlusher) {
+    if (!mCoalescedTouchData.CanCoalesce(aEvent, aGuid, aInputBlockId,
+                                         aApzResponse)) {
+      // The pending touchmove is not compatible with the new one, e.g. the
+      // touch count changed. Dispatch it right away to keep the stream in
+      // order.
+      ProcessPendingCoalescedTouchData();
+    }
+    mCoalescedTouchData.Coalesce(aEvent, aGuid, aInputBlockId, aApzResponse);
+    // Dispatch the coalesced touchmove on the next refresh driver tick.
+    mCoalescedTouchMoveEventFlusher->StartObserver();
+    return IPC_OK();
+  }
+
   if (!RecvRealTouchEvent(aEvent, aGuid, aInputBlockId, aApzResponse)) {
     return IPC_FAIL_NO_REASON(this);
   }
@@ -29,6 +29,7 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/dom/TabContext.h"
 #include "mozilla/dom/CoalescedMouseData.h"
+#include "mozilla/dom/CoalescedTouchData.h"
 #include "mozilla/dom/CoalescedWheelData.h"
 #include "mozilla/DOMEventTargetHelper.h"
 #include "mozilla/EventDispatcher.h"
@@ -656,6 +657,11 @@ class BrowserChild final : public nsMessageManagerScriptExecutor,
   void FlushAllCoalescedMouseData();
   void ProcessPendingCoalescedMouseDataAndDispatchEvents();
 
+  // Dispatch the pending coalesced touchmove event, if any. It's called on
+  // refresh driver ticks and before dispatching other touch events so that
+  // the held back touchmove can't be overtaken.
+  void ProcessPendingCoalescedTouchData();
+
   void HandleRealMouseButtonEvent(const WidgetMouseEvent& aEvent,
                                   const ScrollableLayerGuid& aGuid,
                                   const uint64_t& aInputBlockId);
@@ -903,6 +909,9 @@ class BrowserChild final : public nsMessageManagerScriptExecutor,
   CoalescedWheelData mCoalescedWheelData;
   RefPtr<CoalescedMouseMoveFlusher> mCoalescedMouseEventFlusher;
 
+  CoalescedTouchData mCoalescedTouchData;
+  RefPtr<CoalescedTouchMoveFlusher> mCoalescedTouchMoveEventFlusher;
+
   RefPtr<layers::IAPZCTreeManager> mApzcTreeManager;
   RefPtr<TabListener> mSessionStoreListener;
 
@@ -918,6 +927,7 @@ class BrowserChild final : public nsMessageManagerScriptExecutor,
   PDocAccessibleChild* mTopLevelDocAccessibleChild;
 #endif
   bool mCoalesceMouseMoveEvents;
+  bool mCoalesceTouchMoveEvents;
 
   bool mShouldSendWebProgressEventsToParent;
 
@@ -0,0 +1,151 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#include "base/basictypes.h"
+
+#include "CoalescedTouchData.h"
+#include "BrowserChild.h"
+
+#include "mozilla/PresShell.h"
+#include "mozilla/StaticPrefs_dom.h"
+#include "mozilla/dom/PointerEventHandler.h"
+#include "mozilla/dom/Touch.h"
+
+using namespace mozilla;
+using namespace mozilla::dom;
+
+void CoalescedTouchData::CreateCoalescedTouchEvent(
+    const WidgetTouchEvent& aEvent) {
+  MOZ_ASSERT(IsEmpty());
+  mCoalescedInputEvent = MakeUnique<WidgetTouchEvent>(aEvent);
+  if (!StaticPrefs::dom_w3c_pointer_events_enabled()) {
+    return;
+  }
+  for (size_t i = 0; i < mCoalescedInputEvent->mTouches.Length(); i++) {
+    Touch* touch = mCoalescedInputEvent->mTouches[i];
+    touch->mCoalescedWidgetEvents = new WidgetPointerEventHolder();
+    // Add the initial sample so that the pointermove event synthesized from
+    // this touch reports it in PointerEvent::getCoalescedEvents.
+    WidgetPointerEvent* event =
+        touch->mCoalescedWidgetEvents->mEvents.AppendElement(WidgetPointerEvent(
+            aEvent.IsTrusted(), ePointerMove, aEvent.mWidget));
+    PointerEventHandler::InitPointerEventFromTouch(
+        event, mCoalescedInputEvent.get(), touch, i == 0);
+    event->mFlags.mBubbles = false;
+    event->mFlags.mCancelable = false;
+  }
+}
+
+void CoalescedTouchData::Coalesce(const WidgetTouchEvent& aEvent,
+                                  const ScrollableLayerGuid& aGuid,
+                                  const uint64_t& aInputBlockId,
+                                  const nsEventStatus& aApzResponse) {
+  MOZ_ASSERT(aEvent.mMessage == eTouchMove);
+  if (IsEmpty()) {
+    CreateCoalescedTouchEvent(aEvent);
+    mGuid = aGuid;
+    mInputBlockId = aInputBlockId;
+    mApzResponse = aApzResponse;
+    return;
+  }
+
+  MOZ_ASSERT(mGuid == aGuid);
+  MOZ_ASSERT(mInputBlockId == aInputBlockId);
+  MOZ_ASSERT(mCoalescedInputEvent->mModifiers == aEvent.mModifiers);
+  mCoalescedInputEvent->mTimeStamp = aEvent.mTimeStamp;
+  mCoalescedInputEvent->mTime = aEvent.mTime;
+  for (size_t i = 0; i < aEvent.mTouches.Length(); i++) {
+    Touch* newTouch = aEvent.mTouches[i];
+    Touch* touch = GetTouch(newTouch->Identifier());
+    // CanCoalesce() made sure that the touch lists match.
+    MOZ_ASSERT(touch);
+    touch->mRefPoint = newTouch->mRefPoint;
+    touch->mRadius = newTouch->mRadius;
+    touch->mRotationAngle = newTouch->mRotationAngle;
+    touch->mForce = newTouch->mForce;
+    touch->tiltX = newTouch->tiltX;
+    touch->tiltY = newTouch->tiltY;
+    touch->twist = newTouch->twist;
+    if (touch->mCoalescedWidgetEvents) {
+      // Append the new sample in mCoalescedWidgetEvents. We use them to
+      // generate DOM events when content calls
+      // PointerEvent::getCoalescedEvents.
+      WidgetPointerEvent* event =
+          touch->mCoalescedWidgetEvents->mEvents.AppendElement(
+              WidgetPointerEvent(aEvent.IsTrusted(), ePointerMove,
+                                 aEvent.mWidget));
+      PointerEventHandler::InitPointerEventFromTouch(
+          event, mCoalescedInputEvent.get(), touch, i == 0);
+      event->mFlags.mBubbles = false;
+      event->mFlags.mCancelable = false;
+    }
+  }
+}
+
+bool CoalescedTouchData::CanCoalesce(const WidgetTouchEvent& aEvent,
+                                     const ScrollableLayerGuid& aGuid,
+                                     const uint64_t& aInputBlockId,
+                                     const nsEventStatus& aApzResponse) {
+  MOZ_ASSERT(aEvent.mMessage == eTouchMove);
+  if (IsEmpty()) {
+    return true;
+  }
+  if (mGuid != aGuid || mInputBlockId != aInputBlockId ||
+      mApzResponse != aApzResponse ||
+      mCoalescedInputEvent->mModifiers != aEvent.mModifiers ||
+      mCoalescedInputEvent->mTouches.Length() != aEvent.mTouches.Length()) {
+    return false;
+  }
+  for (const RefPtr<Touch>& touch : aEvent.mTouches) {
+    if (!GetTouch(touch->Identifier())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Touch* CoalescedTouchData::GetTouch(int32_t aIdentifier) {
+  for (const RefPtr<Touch>& touch : mCoalescedInputEvent->mTouches) {
+    if (touch->Identifier() == aIdentifier) {
+      return touch;
+    }
+  }
+  return nullptr;
+}
+
+void CoalescedTouchMoveFlusher::WillRefresh(mozilla::TimeStamp aTime) {
+  MOZ_ASSERT(mRefreshDriver);
+  mBrowserChild->ProcessPendingCoalescedTouchData();
+}
+
+void CoalescedTouchMoveFlusher::StartObserver() {
+  nsRefreshDriver* refreshDriver = GetRefreshDriver();
+  if (mRefreshDriver && mRefreshDriver == refreshDriver) {
+    // Nothing to do if we already added an observer and it's same refresh
+    // driver.
+    return;
+  }
+  RemoveObserver();
+  if (refreshDriver) {
+    mRefreshDriver = refreshDriver;
+    mRefreshDriver->AddRefreshObserver(this, FlushType::Event);
+  }
+}
+
+void CoalescedTouchMoveFlusher::RemoveObserver() {
+  if (mRefreshDriver) {
+    mRefreshDriver->RemoveRefreshObserver(this, FlushType::Event);
+    mRefreshDriver = nullptr;
+  }
+}
+
+nsRefreshDriver* CoalescedTouchMoveFlusher::GetRefreshDriver() {
+  PresShell* presShell = mBrowserChild->GetTopLevelPresShell();
+  if (!presShell || !presShell->GetPresContext() ||
+      !presShell->GetPresContext()->RefreshDriver()) {
+    return nullptr;
+  }
+  return presShell->GetPresContext()->RefreshDriver();
+}
@@ -0,0 +1,70 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_dom_CoalescedTouchData_h
+#define mozilla_dom_CoalescedTouchData_h
+
+#include "CoalescedInputData.h"
+#include "mozilla/TouchEvents.h"
+#include "nsRefreshDriver.h"
+
+namespace mozilla {
+namespace dom {
+
+class CoalescedTouchData final : public CoalescedInputData<WidgetTouchEvent> {
+ public:
+  CoalescedTouchData() : mApzResponse(nsEventStatus_eIgnore) {
+    MOZ_COUNT_CTOR(mozilla::dom::CoalescedTouchData);
+  }
+
+  ~CoalescedTouchData() { MOZ_COUNT_DTOR(mozilla::dom::CoalescedTouchData); }
+
+  void Coalesce(const WidgetTouchEvent& aEvent,
+                const ScrollableLayerGuid& aGuid, const uint64_t& aInputBlockId,
+                const nsEventStatus& aApzResponse);
+
+  bool CanCoalesce(const WidgetTouchEvent& aEvent,
+                   const ScrollableLayerGuid& aGuid,
+                   const uint64_t& aInputBlockId,
+                   const nsEventStatus& aApzResponse);
+
+  nsEventStatus GetApzResponse() const { return mApzResponse; }
+
+ private:
+  void CreateCoalescedTouchEvent(const WidgetTouchEvent& aEvent);
+
+  Touch* GetTouch(int32_t aIdentifier);
+
+  nsEventStatus mApzResponse;
+};
+
+class CoalescedTouchMoveFlusher final : public nsARefreshObserver {
+ public:
+  explicit CoalescedTouchMoveFlusher(BrowserChild* aBrowserChild)
+      : mBrowserChild(aBrowserChild) {
+    MOZ_ASSERT(mBrowserChild);
+  }
+
+  virtual void WillRefresh(mozilla::TimeStamp aTime) override;
+
+  NS_INLINE_DECL_REFCOUNTING(CoalescedTouchMoveFlusher, override)
+
+  void StartObserver();
+  void RemoveObserver();
+
+ private:
+  ~CoalescedTouchMoveFlusher() { RemoveObserver(); }
+
+  nsRefreshDriver* GetRefreshDriver();
+
+  BrowserChild* mBrowserChild;
+  RefPtr<nsRefreshDriver> mRefreshDriver;
+};
+
+}  // namespace dom
+}  // namespace mozilla
+
+#endif  // mozilla_dom_CoalescedTouchData_h
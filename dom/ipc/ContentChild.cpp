@@ -2408,8 +2408,11 @@ nsresult ContentChild::AddRemoteAlertObserver(const nsString& aData,
   return NS_OK;
 }
 
-mozilla::ipc::IPCResult ContentChild::RecvPreferenceUpdate(const Pref& aPref) {
-  Preferences::SetPreference(aPref);
+mozilla::ipc::IPCResult ContentChild::RecvPreferenceUpdates(
+    nsTArray<Pref>&& aPrefs) {
+  for (const Pref& pref : aPrefs) {
+    Preferences::SetPreference(pref);
+  }
   return IPC_OK();
 }
 
@@ -324,7 +324,7 @@ class ContentChild final
   nsresult AddRemoteAlertObserver(const nsString& aData,
                                   nsIObserver* aObserver);
 
-  mozilla::ipc::IPCResult RecvPreferenceUpdate(const Pref& aPref);
+  mozilla::ipc::IPCResult RecvPreferenceUpdates(nsTArray<Pref>&& aPrefs);
   mozilla::ipc::IPCResult RecvVarUpdate(const GfxVarUpdate& pref);
 
   mozilla::ipc::IPCResult RecvUpdatePerfStatsCollectionMask(
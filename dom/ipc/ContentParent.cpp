@@ -1391,10 +1391,10 @@ void ContentParent::Init() {
 
   // Flush any pref updates that happened during launch and weren't
   // included in the blobs set up in BeginSubprocessLaunch.
-  for (const Pref& pref : mQueuedPrefs) {
-    Unused << NS_WARN_IF(!SendPreferenceUpdate(pref));
+  if (!mQueuedPrefs.IsEmpty()) {
+    Unused << NS_WARN_IF(!SendPreferenceUpdates(mQueuedPrefs));
+    mQueuedPrefs.Clear();
   }
-  mQueuedPrefs.Clear();
 
   if (obs) {
     nsAutoString cpId;
@@ -3001,8 +3001,14 @@ ContentParent::Observe(nsISupports* aSubject, const char* aTopic,
     Preferences::GetPreference(&pref);
     if (IsAlive()) {
       MOZ_ASSERT(mQueuedPrefs.IsEmpty());
-      if (!SendPreferenceUpdate(pref)) {
-        return NS_ERROR_NOT_AVAILABLE;
+      // Coalesce bursts of pref changes (enterprise policy pushes can
+      // flip hundreds in one event-loop turn) into a single
+      // PreferenceUpdates message instead of one message per pref.
+      mPendingPrefUpdates.AppendElement(std::move(pref));
+      if (mPendingPrefUpdates.Length() == 1) {
+        NS_DispatchToCurrentThread(
+            NewRunnableMethod("ContentParent::FlushPendingPrefUpdates", this,
+                              &ContentParent::FlushPendingPrefUpdates));
       }
     } else {
       MOZ_ASSERT(IsLaunching());
@@ -3139,6 +3145,13 @@ ContentParent::Observe(nsISupports* aSubject, const char* aTopic,
   return NS_OK;
 }
 
+void ContentParent::FlushPendingPrefUpdates() {
+  nsTArray<Pref> prefs = std::move(mPendingPrefUpdates);
+  if (!prefs.IsEmpty() && IsAlive()) {
+    Unused << NS_WARN_IF(!SendPreferenceUpdates(prefs));
+  }
+}
+
 /* static */
 bool ContentParent::ShouldSyncPreference(const char16_t* aData) {
 #define BLACKLIST_ENTRY(s) \
@@ -1306,6 +1306,10 @@ class ContentParent final
   static bool ShouldSyncPreference(const char16_t* aData);
 
  private:
+  // Sends the pref changes accumulated in mPendingPrefUpdates in a
+  // single PreferenceUpdates message.
+  void FlushPendingPrefUpdates();
+
   // Return an existing ContentParent if possible. Otherwise, `nullptr`.
   static already_AddRefed<ContentParent> GetUsedBrowserProcess(
       ContentParent* aOpener, const nsAString& aRemoteType,
@@ -1449,6 +1453,11 @@ class ContentParent final
   // when the process can receive IPC messages.
   nsTArray<Pref> mQueuedPrefs;
 
+  // Pref changes made while the process is alive, waiting to be
+  // flushed as one PreferenceUpdates message at the end of the current
+  // event-loop turn. See Observe() and FlushPendingPrefUpdates().
+  nsTArray<Pref> mPendingPrefUpdates;
+
   RefPtr<mozilla::dom::ProcessMessageManager> mMessageManager;
 
   static uint64_t sNextRemoteTabId;
@@ -35,6 +35,9 @@ AudioCaptureTrack::AudioCaptureTrack(TrackRate aRate)
   MOZ_ASSERT(NS_IsMainThread());
   MOZ_COUNT_CTOR(AudioCaptureTrack);
   mMixer.AddCallback(WrapNotNull(this));
+  // Preallocate the mixing buffers so ProcessInput doesn't allocate on the
+  // graph thread.
+  mMixer.EnsureCapacity(MONO, aRate * AUDIO_TARGET_MS / 1000 + 1);
 }
 
 AudioCaptureTrack::~AudioCaptureTrack() {
@@ -8,6 +8,14 @@
 #include <speex/speex_resampler.h>
 #include <string.h>
 #include <cmath>
+#ifdef USE_NEON
+#  include "mozilla/arm.h"
+#  include "AudioConverterNEON.h"
+#endif
+#ifdef USE_SSE2
+#  include "mozilla/SSE.h"
+#  include "AudioConverterSSE2.h"
+#endif
 
 /*
  *  Parts derived from MythTV AudioConvert Class
@@ -301,6 +309,18 @@ size_t AudioConverter::DownmixAudio(void* aOut, const void* aIn,
   if (mIn.Format() == AudioConfig::FORMAT_FLT) {
     const float* in = static_cast<const float*>(aIn);
     float* out = static_cast<float*>(aOut);
+#ifdef USE_NEON
+    if (mozilla::supports_neon()) {
+      DownmixStereoToMono_NEON(in, out, aFrames);
+      return aFrames;
+    }
+#endif
+#ifdef USE_SSE2
+    if (mozilla::supports_sse2()) {
+      DownmixStereoToMono_SSE(in, out, aFrames);
+      return aFrames;
+    }
+#endif
     for (size_t fIdx = 0; fIdx < aFrames; ++fIdx) {
       float sample = 0.0;
       // The sample of the buffer would be interleaved.
@@ -417,6 +437,18 @@ size_t AudioConverter::UpmixAudio(void* aOut, const void* aIn,
     const float m3db = std::sqrt(0.5);  // -3dB = sqrt(1/2)
     const float* in = static_cast<const float*>(aIn);
     float* out = static_cast<float*>(aOut);
+#ifdef USE_NEON
+    if (mozilla::supports_neon()) {
+      UpmixMonoToStereo_NEON(in, m3db, out, aFrames);
+      return aFrames;
+    }
+#endif
+#ifdef USE_SSE2
+    if (mozilla::supports_sse2()) {
+      UpmixMonoToStereo_SSE(in, m3db, out, aFrames);
+      return aFrames;
+    }
+#endif
     for (size_t fIdx = 0; fIdx < aFrames; ++fIdx) {
       float sample = in[fIdx] * m3db;
       // The samples of the buffer would be interleaved.
@@ -0,0 +1,42 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "AudioConverterNEON.h"
+#include <arm_neon.h>
+
+namespace mozilla {
+
+void DownmixStereoToMono_NEON(const float* aIn, float* aOut, uint32_t aFrames) {
+  uint32_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    // Each iteration consumes 4 frames (8 interleaved samples).
+    float32x4x2_t vin = vld2q_f32(&aIn[i * 2]);
+    float32x4_t vout = vmulq_n_f32(vaddq_f32(vin.val[0], vin.val[1]), 0.5f);
+    vst1q_f32(&aOut[i], vout);
+  }
+  for (; i < aFrames; i++) {
+    aOut[i] = (aIn[i * 2] + aIn[i * 2 + 1]) * 0.5f;
+  }
+}
+
+void UpmixMonoToStereo_NEON(const float* aIn, float aGain, float* aOut,
+                            uint32_t aFrames) {
+  uint32_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    float32x4_t vscaled = vmulq_n_f32(vld1q_f32(&aIn[i]), aGain);
+    float32x4x2_t vout;
+    vout.val[0] = vscaled;
+    vout.val[1] = vscaled;
+    vst2q_f32(&aOut[i * 2], vout);
+  }
+  for (; i < aFrames; i++) {
+    float sample = aIn[i] * aGain;
+    aOut[i * 2] = sample;
+    aOut[i * 2 + 1] = sample;
+  }
+}
+
+}  // namespace mozilla
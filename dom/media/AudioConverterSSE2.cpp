@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "AudioConverterSSE2.h"
+#include <emmintrin.h>
+
+namespace mozilla {
+
+void DownmixStereoToMono_SSE(const float* aIn, float* aOut, uint32_t aFrames) {
+  __m128 vhalf = _mm_set1_ps(0.5f);
+
+  uint32_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    // Each iteration consumes 4 frames (8 interleaved samples).
+    __m128 vin0 = _mm_loadu_ps(&aIn[i * 2]);      // L0 R0 L1 R1
+    __m128 vin1 = _mm_loadu_ps(&aIn[i * 2 + 4]);  // L2 R2 L3 R3
+    __m128 vleft = _mm_shuffle_ps(vin0, vin1, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 vright = _mm_shuffle_ps(vin0, vin1, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 vout = _mm_mul_ps(_mm_add_ps(vleft, vright), vhalf);
+    _mm_storeu_ps(&aOut[i], vout);
+  }
+  for (; i < aFrames; i++) {
+    aOut[i] = (aIn[i * 2] + aIn[i * 2 + 1]) * 0.5f;
+  }
+}
+
+void UpmixMonoToStereo_SSE(const float* aIn, float aGain, float* aOut,
+                           uint32_t aFrames) {
+  __m128 vgain = _mm_set1_ps(aGain);
+
+  uint32_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    __m128 vscaled = _mm_mul_ps(_mm_loadu_ps(&aIn[i]), vgain);
+    __m128 vlo = _mm_unpacklo_ps(vscaled, vscaled);  // S0 S0 S1 S1
+    __m128 vhi = _mm_unpackhi_ps(vscaled, vscaled);  // S2 S2 S3 S3
+    _mm_storeu_ps(&aOut[i * 2], vlo);
+    _mm_storeu_ps(&aOut[i * 2 + 4], vhi);
+  }
+  for (; i < aFrames; i++) {
+    float sample = aIn[i] * aGain;
+    aOut[i * 2] = sample;
+    aOut[i * 2 + 1] = sample;
+  }
+}
+
+}  // namespace mozilla
@@ -0,0 +1,25 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef MOZILLA_AUDIOCONVERTERSSE2_H_
+#define MOZILLA_AUDIOCONVERTERSSE2_H_
+
+#include <stdint.h>
+
+namespace mozilla {
+
+// Downmix aFrames frames of interleaved stereo to mono, averaging the two
+// channels. Can work in place (aOut == aIn). No alignment requirements.
+void DownmixStereoToMono_SSE(const float* aIn, float* aOut, uint32_t aFrames);
+
+// Upmix aFrames frames of mono to interleaved stereo, applying aGain to
+// both channels. Cannot work in place. No alignment requirements.
+void UpmixMonoToStereo_SSE(const float* aIn, float aGain, float* aOut,
+                           uint32_t aFrames);
+
+}  // namespace mozilla
+
+#endif /* MOZILLA_AUDIOCONVERTERSSE2_H_ */
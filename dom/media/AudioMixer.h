@@ -8,6 +8,7 @@
 
 #include "AudioSampleFormat.h"
 #include "AudioStream.h"
+#include "nsDebug.h"
 #include "nsTArray.h"
 #include "mozilla/LinkedList.h"
 #include "mozilla/NotNull.h"
@@ -36,7 +37,7 @@ struct MixerCallbackReceiver {
  */
 class AudioMixer {
  public:
-  AudioMixer() : mFrames(0), mChannels(0), mSampleRate(0) {}
+  AudioMixer() : mFrames(0), mChannels(0), mSampleRate(0), mSilentBlock(true) {}
 
   ~AudioMixer() {
     MixerCallback* cb;
@@ -52,6 +53,10 @@ class AudioMixer {
   void FinishMixing() {
     MOZ_ASSERT(mChannels && mFrames && mSampleRate,
                "Mix not called for this cycle?");
+    if (mSilentBlock) {
+      // Nothing was mixed into the buffer this cycle, output silence.
+      PodZero(mMixedAudio.Elements(), mMixedAudio.Length());
+    }
     for (MixerCallback* cb = mCallbacks.getFirst(); cb != nullptr;
          cb = cb->getNext()) {
       MixerCallbackReceiver* receiver = cb->mReceiver;
@@ -60,7 +65,7 @@ class AudioMixer {
                               AudioSampleTypeToFormat<AudioDataValue>::Format,
                               mChannels, mFrames, mSampleRate);
     }
-    PodZero(mMixedAudio.Elements(), mMixedAudio.Length());
+    mSilentBlock = true;
     mSampleRate = mChannels = mFrames = 0;
   }
 
@@ -72,7 +77,7 @@ class AudioMixer {
       mFrames = aFrames;
       mChannels = aChannels;
       mSampleRate = aSampleRate;
-      EnsureCapacityAndSilence();
+      EnsureLength();
     }
 
     MOZ_ASSERT(aFrames == mFrames);
@@ -83,11 +88,34 @@ class AudioMixer {
       return;
     }
 
+    if (mSilentBlock) {
+      // First contribution of the cycle: write straight into the output
+      // buffer instead of zeroing it upfront and accumulating.
+      PodCopy(mMixedAudio.Elements(), aSamples, aFrames * aChannels);
+      mSilentBlock = false;
+      return;
+    }
+
     for (uint32_t i = 0; i < aFrames * aChannels; i++) {
       mMixedAudio[i] += aSamples[i];
     }
   }
 
+  /* Preallocate the mixing buffer and the interleaving scratch buffer for
+   * blocks of aFrames frames of aChannels channels. To be called when the
+   * graph is configured, so that mixing cycles do not have to allocate on
+   * the real-time audio thread. */
+  void EnsureCapacity(uint32_t aChannels, uint32_t aFrames) {
+    mMixedAudio.SetCapacity(aChannels * aFrames);
+    mScratchBuffer.SetCapacity(aChannels * aFrames);
+  }
+
+  /* Scratch buffer for callers to interleave or remix audio into before
+   * passing it to Mix(). It is owned by the mixer so its storage is reused
+   * across cycles instead of being allocated per callback. The content is
+   * only valid until the next call to ScratchBuffer(). */
+  nsTArray<AudioDataValue>& ScratchBuffer() { return mScratchBuffer; }
+
   void AddCallback(NotNull<MixerCallbackReceiver*> aReceiver) {
     mCallbacks.insertBack(new MixerCallback(aReceiver));
   }
@@ -115,11 +143,17 @@ class AudioMixer {
   }
 
  private:
-  void EnsureCapacityAndSilence() {
+  void EnsureLength() {
+    NS_WARNING_ASSERTION(
+        mFrames * mChannels <= mMixedAudio.Capacity(),
+        "Allocating mixing buffers on the real-time audio thread. The owner "
+        "of this mixer should call EnsureCapacity() when configured.");
     if (mFrames * mChannels > mMixedAudio.Length()) {
       mMixedAudio.SetLength(mFrames * mChannels);
     }
-    PodZero(mMixedAudio.Elements(), mMixedAudio.Length());
+    // The buffer is not zeroed here; the first Mix() of the cycle overwrites
+    // it and FinishMixing() silences it if nothing was mixed.
+    mSilentBlock = true;
   }
 
   class MixerCallback : public LinkedListElement<MixerCallback> {
@@ -139,6 +173,10 @@ class AudioMixer {
   uint32_t mSampleRate;
   /* Buffer containing the mixed audio data. */
   nsTArray<AudioDataValue> mMixedAudio;
+  /* Scratch buffer handed out by ScratchBuffer(). */
+  nsTArray<AudioDataValue> mScratchBuffer;
+  /* True as long as no samples have been mixed into the current block. */
+  bool mSilentBlock;
 };
 
 }  // namespace mozilla
@@ -78,9 +78,9 @@ static AudioDataValue* PointerForOffsetInChannel(AudioDataValue* aData,
 
 void AudioSegment::Mix(AudioMixer& aMixer, uint32_t aOutputChannels,
                        uint32_t aSampleRate) {
-  AutoTArray<AudioDataValue,
-             SilentChannel::AUDIO_PROCESSING_FRAMES * GUESS_AUDIO_CHANNELS>
-      buf;
+  // Use the mixer's scratch buffer so its storage is reused across
+  // iterations instead of being allocated on the real-time audio thread.
+  nsTArray<AudioDataValue>& buf = aMixer.ScratchBuffer();
   AutoTArray<const AudioDataValue*, GUESS_AUDIO_CHANNELS> channelData;
   uint32_t offsetSamples = 0;
   uint32_t duration = GetDuration();
@@ -162,9 +162,9 @@ void AudioSegment::Mix(AudioMixer& aMixer, uint32_t aOutputChannels,
 
 void AudioSegment::WriteTo(AudioMixer& aMixer, uint32_t aOutputChannels,
                            uint32_t aSampleRate) {
-  AutoTArray<AudioDataValue,
-             SilentChannel::AUDIO_PROCESSING_FRAMES * GUESS_AUDIO_CHANNELS>
-      buf;
+  // Use the mixer's scratch buffer so its storage is reused across
+  // iterations instead of being allocated on the real-time audio thread.
+  nsTArray<AudioDataValue>& buf = aMixer.ScratchBuffer();
   // Offset in the buffer that will be written to the mixer, in samples.
   uint32_t offset = 0;
 
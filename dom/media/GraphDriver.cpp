@@ -526,6 +526,11 @@ AudioCallbackDriver::AudioCallbackDriver(
   }
 
   mMixer.AddCallback(WrapNotNull(this));
+  // Preallocate the mixing buffers so iterations don't allocate on the
+  // real-time audio thread. The graph never renders more at once than
+  // AUDIO_TARGET_MS worth of audio.
+  mMixer.EnsureCapacity(mOutputChannels,
+                        mSampleRate * AUDIO_TARGET_MS / 1000 + 1);
 }
 
 AudioCallbackDriver::~AudioCallbackDriver() {
@@ -0,0 +1,37 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "MediaBufferArena.h"
+
+#include "mozilla/Atomics.h"
+#include "mozilla/Likely.h"
+
+namespace mozilla {
+
+static Atomic<arena_id_t> gMediaBufferArenaId(0);
+
+arena_id_t MediaBufferArena() {
+  arena_id_t id = gMediaBufferArenaId;
+  if (MOZ_UNLIKELY(!id)) {
+    // In builds without jemalloc, moz_create_arena() returns 0 and the
+    // moz_arena_* functions fall back to the plain malloc family, so it's
+    // fine for the exchange below to keep 0.
+    id = moz_create_arena();
+    if (!gMediaBufferArenaId.compareExchange(0, id)) {
+      // Another thread beat us to it.  The arena we just created is still
+      // empty, so it can be disposed of right away.
+      moz_dispose_arena(id);
+      id = gMediaBufferArenaId;
+    }
+  }
+  return id;
+}
+
+void MediaBufferArenaStats(jemalloc_arena_stats_t* aStats) {
+  moz_arena_stats(MediaBufferArena(), aStats);
+}
+
+}  // namespace mozilla
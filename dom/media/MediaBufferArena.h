@@ -0,0 +1,28 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#if !defined(MediaBufferArena_h)
+#  define MediaBufferArena_h
+
+#  include "mozmemory.h"
+
+namespace mozilla {
+
+// Media sample buffers (AlignedBuffer and SharedBuffer contents) are
+// allocated from their own arena, so that the churn of large, short-lived
+// buffers doesn't fragment the arenas the rest of Gecko allocates from, and
+// so that about:memory can report the footprint of the buffers separately
+// (see MediaBufferArenaStats).
+// Returns the id of that arena, creating it on first use.  Safe to call
+// from any thread.
+arena_id_t MediaBufferArena();
+
+// Fills the given stats structure with statistics about the media buffer
+// arena.
+void MediaBufferArenaStats(jemalloc_arena_stats_t* aStats);
+
+}  // namespace mozilla
+
+#endif  // MediaBufferArena_h
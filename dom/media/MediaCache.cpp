@@ -1076,7 +1076,7 @@ void MediaCache::SwapBlocks(AutoLock& aLock, int32_t aBlockIndex1,
   for (int32_t i = 0; i < 2; ++i) {
     for (uint32_t j = 0; j < blocks[i]->mOwners.Length(); ++j) {
       const BlockOwner* b = &blocks[i]->mOwners[j];
-      b->mStream->mBlocks[b->mStreamBlock] = blockIndices[i];
+      b->mStream->SetCacheBlockIndex(b->mStreamBlock, blockIndices[i]);
     }
   }
 
@@ -1108,7 +1108,7 @@ void MediaCache::RemoveBlockOwner(AutoLock& aLock, int32_t aBlockIndex,
     BlockOwner* bo = &block->mOwners[i];
     if (bo->mStream == aStream) {
       GetListForBlock(aLock, bo)->RemoveBlock(aBlockIndex);
-      bo->mStream->mBlocks[bo->mStreamBlock] = -1;
+      bo->mStream->SetCacheBlockIndex(bo->mStreamBlock, -1);
       block->mOwners.RemoveElementAt(i);
       if (block->mOwners.IsEmpty()) {
         mFreeBlocks.AddFirstBlock(aBlockIndex);
@@ -1130,7 +1130,7 @@ void MediaCache::AddBlockOwnerAsReadahead(AutoLock& aLock, int32_t aBlockIndex,
       std::max(mBlockOwnersWatermark, uint32_t(block->mOwners.Length()));
   bo->mStream = aStream;
   bo->mStreamBlock = aStreamBlockIndex;
-  aStream->mBlocks[aStreamBlockIndex] = aBlockIndex;
+  aStream->SetCacheBlockIndex(aStreamBlockIndex, aBlockIndex);
   bo->mClass = READAHEAD_BLOCK;
   InsertReadaheadBlock(aLock, bo, aBlockIndex);
 }
@@ -1147,7 +1147,7 @@ void MediaCache::FreeBlock(AutoLock& aLock, int32_t aBlock) {
   for (uint32_t i = 0; i < block->mOwners.Length(); ++i) {
     BlockOwner* bo = &block->mOwners[i];
     GetListForBlock(aLock, bo)->RemoveBlock(aBlock);
-    bo->mStream->mBlocks[bo->mStreamBlock] = -1;
+    bo->mStream->SetCacheBlockIndex(bo->mStreamBlock, -1);
   }
   block->mOwners.Clear();
   mFreeBlocks.AddFirstBlock(aBlock);
@@ -1734,7 +1734,7 @@ void MediaCache::AllocateAndWriteBlock(AutoLock& aLock,
     for (auto& bo : block->mOwners) {
       bo.mStreamBlock = aStreamBlockIndex;
       bo.mLastUseTime = now;
-      bo.mStream->mBlocks[aStreamBlockIndex] = blockIndex;
+      bo.mStream->SetCacheBlockIndex(aStreamBlockIndex, blockIndex);
       if (aStreamBlockIndex * BLOCK_SIZE < bo.mStream->mStreamOffset) {
         bo.mClass = aMode == MediaCacheStream::MODE_PLAYBACK ? PLAYED_BLOCK
                                                              : METADATA_BLOCK;
@@ -2331,14 +2331,61 @@ bool MediaCacheStream::IsDataCachedToEndOfStream(int64_t aOffset) {
   return GetCachedDataEndInternal(lock, aOffset) >= mStreamLength;
 }
 
+void MediaCacheStream::SetCacheBlockIndex(int32_t aStreamBlockIndex,
+                                          int32_t aCacheBlockIndex) {
+  mBlocks[aStreamBlockIndex] = aCacheBlockIndex;
+  media::Interval<int32_t> block(aStreamBlockIndex, aStreamBlockIndex + 1);
+  if (aCacheBlockIndex >= 0) {
+    mCachedBlockRanges += block;
+  } else {
+    mCachedBlockRanges -= block;
+  }
+}
+
+int32_t MediaCacheStream::CachedBlockRunEnd(int32_t aBlockIndex) const {
+  // Binary search for the run of cached blocks containing aBlockIndex. The
+  // runs in mCachedBlockRanges are sorted and non-overlapping.
+  uint32_t lo = 0;
+  uint32_t hi = mCachedBlockRanges.Length();
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    const media::Interval<int32_t>& run = mCachedBlockRanges[mid];
+    if (run.mEnd <= aBlockIndex) {
+      lo = mid + 1;
+    } else if (run.mStart > aBlockIndex) {
+      hi = mid;
+    } else {
+      return run.mEnd;
+    }
+  }
+  return aBlockIndex;
+}
+
+int32_t MediaCacheStream::NextCachedBlock(int32_t aBlockIndex) const {
+  // Binary search for the first run of cached blocks ending after
+  // aBlockIndex.
+  uint32_t lo = 0;
+  uint32_t hi = mCachedBlockRanges.Length();
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (mCachedBlockRanges[mid].mEnd <= aBlockIndex) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == mCachedBlockRanges.Length()) {
+    return -1;
+  }
+  return std::max(aBlockIndex, mCachedBlockRanges[lo].mStart);
+}
+
 int64_t MediaCacheStream::GetCachedDataEndInternal(AutoLock&, int64_t aOffset) {
   int32_t blockIndex = OffsetToBlockIndex(aOffset);
   if (blockIndex < 0) {
     return aOffset;
   }
-  while (size_t(blockIndex) < mBlocks.Length() && mBlocks[blockIndex] != -1) {
-    ++blockIndex;
-  }
+  blockIndex = CachedBlockRunEnd(blockIndex);
   int64_t result = blockIndex * BLOCK_SIZE;
   if (blockIndex == OffsetToBlockIndexUnchecked(mChannelOffset)) {
     // The block containing mChannelOffset may be partially read but not
@@ -2375,24 +2422,25 @@ int64_t MediaCacheStream::GetNextCachedDataInternal(AutoLock&,
   // Is the current block cached?
   if (mBlocks[startBlockIndex] != -1) return aOffset;
 
-  // Count the number of uncached blocks
-  bool hasPartialBlock = OffsetInBlock(mChannelOffset) != 0;
-  int32_t blockIndex = startBlockIndex + 1;
-  while (true) {
-    if ((hasPartialBlock && blockIndex == channelBlockIndex) ||
-        (size_t(blockIndex) < mBlocks.Length() && mBlocks[blockIndex] != -1)) {
-      // We at the incoming channel block, which has has data in it,
-      // or are we at a cached block. Return index of block start.
-      return blockIndex * BLOCK_SIZE;
-    }
+  // Find the next cached block, if any.
+  int32_t blockIndex = NextCachedBlock(startBlockIndex + 1);
 
-    // No more cached blocks?
-    if (size_t(blockIndex) >= mBlocks.Length()) return -1;
+  // The incoming channel block has data in it which is not yet committed
+  // to the main cache. It is effectively cached if it starts before the
+  // next committed block (or there is no such block).
+  bool hasPartialBlock = OffsetInBlock(mChannelOffset) != 0;
+  if (hasPartialBlock && channelBlockIndex > startBlockIndex &&
+      size_t(channelBlockIndex) <= mBlocks.Length() &&
+      (blockIndex < 0 || channelBlockIndex < blockIndex)) {
+    return channelBlockIndex * BLOCK_SIZE;
+  }
 
-    ++blockIndex;
+  if (blockIndex >= 0) {
+    // Return index of block start.
+    return blockIndex * BLOCK_SIZE;
   }
 
-  MOZ_ASSERT_UNREACHABLE("Should return in loop");
+  // No more cached blocks.
   return -1;
 }
 
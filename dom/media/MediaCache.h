@@ -441,6 +441,20 @@ class MediaCacheStream : public DecoderDoctorLifeLogger<MediaCacheStream> {
   // Non-main thread only.
   nsresult Seek(AutoLock&, int64_t aOffset);
 
+  // Updates the entry of mBlocks for the given stream block and keeps
+  // mCachedBlockRanges in sync with it. All changes to the cache block
+  // backing a stream block must go through here. aCacheBlockIndex is the
+  // cache block now backing the stream block, or -1 if the stream block is
+  // no longer cached.
+  void SetCacheBlockIndex(int32_t aStreamBlockIndex, int32_t aCacheBlockIndex);
+  // If the stream block aBlockIndex is cached, returns the index of the
+  // first block past the contiguous run of cached blocks containing it;
+  // otherwise returns aBlockIndex. O(log(number of runs)).
+  int32_t CachedBlockRunEnd(int32_t aBlockIndex) const;
+  // Returns the index of the first cached stream block at or after
+  // aBlockIndex, or -1 if there is none. O(log(number of runs)).
+  int32_t NextCachedBlock(int32_t aBlockIndex) const;
+
   // Returns the end of the bytes starting at the given offset
   // which are in cache.
   // This method assumes that the cache monitor is held and can be called on
@@ -505,6 +519,12 @@ class MediaCacheStream : public DecoderDoctorLifeLogger<MediaCacheStream> {
   // For each block in the stream data, maps to the cache entry for the
   // block, or -1 if the block is not cached.
   nsTArray<int32_t> mBlocks;
+  // The runs of contiguous cached blocks in mBlocks, as a sorted set of
+  // half-open intervals of stream block indices. Kept in sync with mBlocks
+  // by SetCacheBlockIndex() so the cached-range queries can binary-search
+  // runs instead of scanning mBlocks block by block, which matters for
+  // long mostly-cached streams.
+  media::IntervalSet<int32_t> mCachedBlockRanges;
   // The list of read-ahead blocks, ordered by stream offset; the first
   // block is the earliest in the stream (so the last block will be the
   // least valuable).
@@ -9,6 +9,7 @@
 #  include "AudioConfig.h"
 #  include "AudioSampleFormat.h"
 #  include "ImageTypes.h"
+#  include "MediaBufferArena.h"
 #  include "SharedBuffer.h"
 #  include "TimeUnits.h"
 #  include "mozilla/CheckedInt.h"
@@ -210,7 +211,10 @@ class AlignedBuffer {
     if (mData && mCapacity >= sizeNeeded.value()) {
       return true;
     }
-    auto newBuffer = MakeUniqueFallible<uint8_t[]>(sizeNeeded.value());
+    // Zeroed allocation, as SetLength() promises that any new buffer area
+    // is filled with 0 and decoders may over-read into the padding.
+    UniqueFreePtr<uint8_t[]> newBuffer(static_cast<uint8_t*>(
+        moz_arena_calloc(MediaBufferArena(), 1, sizeNeeded.value())));
     if (!newBuffer) {
       return false;
     }
@@ -237,7 +241,7 @@ class AlignedBuffer {
   }
   Type* mData;
   size_t mLength;
-  UniquePtr<uint8_t[]> mBuffer;
+  UniqueFreePtr<uint8_t[]> mBuffer;
   size_t mCapacity;
 };
 
@@ -11,6 +11,7 @@
 #include "DecoderBenchmark.h"
 #include "ImageContainer.h"
 #include "Layers.h"
+#include "MediaBufferArena.h"
 #include "MediaDecoderStateMachine.h"
 #include "MediaFormatReader.h"
 #include "MediaResource.h"
@@ -1358,6 +1359,30 @@ MediaMemoryTracker::CollectReports(nsIHandleReportCallback* aHandleReport,
   MOZ_COLLECT_REPORT("explicit/media/decoded/audio", KIND_HEAP, UNITS_BYTES,
                      audio, "Memory used by decoded audio chunks.");
 
+  jemalloc_arena_stats_t arenaStats;
+  MediaBufferArenaStats(&arenaStats);
+
+  // These are KIND_OTHER rather than KIND_HEAP because the buffers in the
+  // arena are already covered by the explicit/media/ reports above; this
+  // view exists to make the overall footprint of media buffers and the
+  // fragmentation of their arena visible.
+  MOZ_COLLECT_REPORT("media-buffer-arena/allocated", KIND_OTHER, UNITS_BYTES,
+                     arenaStats.allocated,
+                     "Bytes in use by media sample buffers. These are "
+                     "allocated from their own arena; this amount overlaps "
+                     "with the explicit/media/ reports.");
+
+  MOZ_COLLECT_REPORT("media-buffer-arena/committed", KIND_OTHER, UNITS_BYTES,
+                     arenaStats.committed,
+                     "Committed bytes held by the arena media sample buffers "
+                     "are allocated from. The difference with 'allocated' "
+                     "that isn't 'page-cache' is fragmentation.");
+
+  MOZ_COLLECT_REPORT("media-buffer-arena/page-cache", KIND_OTHER, UNITS_BYTES,
+                     arenaStats.page_cache,
+                     "Committed, unused pages the media buffer arena keeps "
+                     "around as a cache for future allocations.");
+
   return NS_OK;
 }
 
@@ -6,9 +6,11 @@
 #ifndef MOZILLA_SHAREDBUFFER_H_
 #define MOZILLA_SHAREDBUFFER_H_
 
+#include "MediaBufferArena.h"
 #include "mozilla/CheckedInt.h"
 #include "mozilla/mozalloc.h"
 #include "mozilla/MemoryReporting.h"
+#include "nsDebug.h"
 #include "nsISupportsImpl.h"
 
 namespace mozilla {
@@ -68,7 +70,7 @@ class SharedBuffer : public ThreadSharedObject {
     if (!allocSize.isValid()) {
       return nullptr;
     }
-    void* m = operator new(allocSize.value(), fallible);
+    void* m = moz_arena_malloc(MediaBufferArena(), allocSize.value());
     if (!m) {
       return nullptr;
     }
@@ -77,7 +79,11 @@ class SharedBuffer : public ThreadSharedObject {
   }
 
   static already_AddRefed<SharedBuffer> Create(CheckedInt<size_t>& aSize) {
-    void* m = operator new(AllocSize(aSize));
+    size_t allocSize = AllocSize(aSize);
+    void* m = moz_arena_malloc(MediaBufferArena(), allocSize);
+    if (!m) {
+      NS_ABORT_OOM(allocSize);
+    }
     RefPtr<SharedBuffer> p = new (m) SharedBuffer();
     return p.forget();
   }
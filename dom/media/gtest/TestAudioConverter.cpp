@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <cmath>
+#include "AudioConverter.h"
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
+
+using namespace mozilla;
+
+// An odd number of frames so the SIMD kernels' scalar tails are exercised.
+static const size_t FRAMES = 1027;
+
+static AlignedFloatBuffer MakeInterleavedBuffer(uint32_t aChannels,
+                                                size_t aFrames) {
+  AlignedFloatBuffer buffer(aFrames * aChannels);
+  for (size_t i = 0; i < aFrames * aChannels; i++) {
+    // Arbitrary values in [-1, 1).
+    buffer.Data()[i] = float(i % 256) / 128.0f - 1.0f;
+  }
+  return buffer;
+}
+
+TEST(AudioConverter, DownmixStereoToMonoFloat)
+{
+  AudioConverter converter(AudioConfig(2, 44100, AudioConfig::FORMAT_FLT),
+                           AudioConfig(1, 44100, AudioConfig::FORMAT_FLT));
+  AlignedFloatBuffer in = MakeInterleavedBuffer(2, FRAMES);
+  AlignedFloatBuffer out;
+  size_t frames = converter.Process(out, in.Data(), FRAMES);
+  EXPECT_EQ(frames, FRAMES);
+  for (size_t i = 0; i < FRAMES; i++) {
+    EXPECT_FLOAT_EQ(out.Data()[i],
+                    (in.Data()[i * 2] + in.Data()[i * 2 + 1]) * 0.5f);
+  }
+}
+
+TEST(AudioConverter, UpmixMonoToStereoFloat)
+{
+  AudioConverter converter(AudioConfig(1, 44100, AudioConfig::FORMAT_FLT),
+                           AudioConfig(2, 44100, AudioConfig::FORMAT_FLT));
+  AlignedFloatBuffer in = MakeInterleavedBuffer(1, FRAMES);
+  AlignedFloatBuffer out;
+  size_t frames = converter.Process(out, in.Data(), FRAMES);
+  EXPECT_EQ(frames, FRAMES);
+  const float m3db = std::sqrt(0.5);
+  for (size_t i = 0; i < FRAMES; i++) {
+    EXPECT_FLOAT_EQ(out.Data()[i * 2], in.Data()[i] * m3db);
+    EXPECT_FLOAT_EQ(out.Data()[i * 2 + 1], in.Data()[i] * m3db);
+  }
+}
+
+// Benchmarks for the hot graph-thread mixing paths, so regressions in the
+// SIMD kernels or their dispatch show up in perfherder.
+MOZ_GTEST_BENCH(AudioConverterBench, DownmixStereoToMonoFloat, []() {
+  const size_t frames = 48000;
+  AudioConverter converter(AudioConfig(2, 48000, AudioConfig::FORMAT_FLT),
+                           AudioConfig(1, 48000, AudioConfig::FORMAT_FLT));
+  AlignedFloatBuffer in = MakeInterleavedBuffer(2, frames);
+  AlignedFloatBuffer out;
+  for (size_t i = 0; i < 100; i++) {
+    converter.Process(out, in.Data(), frames);
+  }
+});
+
+MOZ_GTEST_BENCH(AudioConverterBench, UpmixMonoToStereoFloat, []() {
+  const size_t frames = 48000;
+  AudioConverter converter(AudioConfig(1, 48000, AudioConfig::FORMAT_FLT),
+                           AudioConfig(2, 48000, AudioConfig::FORMAT_FLT));
+  AlignedFloatBuffer in = MakeInterleavedBuffer(1, frames);
+  AlignedFloatBuffer out;
+  for (size_t i = 0; i < 100; i++) {
+    converter.Process(out, in.Data(), frames);
+  }
+});
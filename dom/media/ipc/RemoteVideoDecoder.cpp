@@ -24,6 +24,7 @@
 #include "mozilla/Telemetry.h"
 #include "mozilla/layers/ImageClient.h"
 #include "mozilla/layers/TextureClient.h"
+#include "mozilla/layers/TextureClientRecycleAllocator.h"
 #include "mozilla/layers/VideoBridgeChild.h"
 
 namespace mozilla {
@@ -338,8 +339,13 @@ MediaResult RemoteVideoDecoderParent::ProcessDecodedData(
           video->mImage->GetTextureClient(mKnowsCompositor);
 
       if (!texture) {
-        texture = ImageClient::CreateTextureClientForImage(video->mImage,
-                                                           mKnowsCompositor);
+        static const uint32_t MAX_POOLED_VIDEO_COUNT = 5;
+        if (!mTextureAllocator) {
+          mTextureAllocator = new TextureClientRecycleAllocator(mKnowsCompositor);
+          mTextureAllocator->SetMaxPoolSize(MAX_POOLED_VIDEO_COUNT);
+        }
+        texture = ImageClient::CreateTextureClientForImage(
+            video->mImage, mKnowsCompositor, mTextureAllocator);
       }
 
       if (texture) {
@@ -390,4 +396,12 @@ MediaResult RemoteVideoDecoderParent::ProcessDecodedData(
   return NS_OK;
 }
 
+void RemoteVideoDecoderParent::ActorDestroy(ActorDestroyReason aWhy) {
+  if (mTextureAllocator) {
+    mTextureAllocator->Destroy();
+    mTextureAllocator = nullptr;
+  }
+  RemoteDecoderParent::ActorDestroy(aWhy);
+}
+
 }  // namespace mozilla
@@ -11,6 +11,7 @@
 namespace mozilla {
 namespace layers {
 class BufferRecycleBin;
+class TextureClientRecycleAllocator;
 }  // namespace layers
 }  // namespace mozilla
 
@@ -60,6 +61,8 @@ class RemoteVideoDecoderParent final : public RemoteDecoderParent {
   MediaResult ProcessDecodedData(const MediaDataDecoder::DecodedData& aData,
                                  DecodedOutputIPDL& aDecodedData) override;
 
+  void ActorDestroy(ActorDestroyReason aWhy) override;
+
  private:
   // Can only be accessed from the manager thread
   // Note: we can't keep a reference to the original VideoInfo here
@@ -69,6 +72,10 @@ class RemoteVideoDecoderParent final : public RemoteDecoderParent {
   const VideoInfo mVideoInfo;
 
   RefPtr<KnowsCompositorVideo> mKnowsCompositor;
+  // Lazily created pool of textures sent over the video bridge, so that
+  // steady-state playback recycles frames instead of allocating a texture
+  // per decoded frame. Can only be accessed from the manager thread.
+  RefPtr<layers::TextureClientRecycleAllocator> mTextureAllocator;
 };
 
 }  // namespace mozilla
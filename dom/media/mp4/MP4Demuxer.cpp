@@ -35,11 +35,29 @@ namespace mozilla {
 
 DDLoggedTypeDeclNameAndBase(MP4TrackDemuxer, MediaTrackDemuxer);
 
+// Refcounted wrapper sharing the parsed MP4 metadata between the demuxer and
+// its track demuxers, so that each track's sample index can be built lazily
+// after Init() has resolved. The rust parser inside owns the indice tables,
+// so it must stay alive until every track demuxer has built its index.
+class MP4MetadataHolder {
+ public:
+  NS_INLINE_DECL_THREADSAFE_REFCOUNTING(MP4MetadataHolder)
+
+  explicit MP4MetadataHolder(ByteStream* aSource) : mMetadata(aSource) {}
+
+  MP4Metadata& Metadata() { return mMetadata; }
+
+ private:
+  ~MP4MetadataHolder() = default;
+
+  MP4Metadata mMetadata;
+};
+
 class MP4TrackDemuxer : public MediaTrackDemuxer,
                         public DecoderDoctorLifeLogger<MP4TrackDemuxer> {
  public:
   MP4TrackDemuxer(MediaResource* aResource, UniquePtr<TrackInfo>&& aInfo,
-                  const IndiceWrapper& aIndices);
+                  RefPtr<MP4MetadataHolder> aMetadata);
 
   UniquePtr<TrackInfo> GetInfo() const override;
 
@@ -61,11 +79,14 @@ class MP4TrackDemuxer : public MediaTrackDemuxer,
 
  private:
   already_AddRefed<MediaRawData> GetNextSample();
+  bool EnsureIndex();
   void EnsureUpToDateIndex();
   void SetNextKeyFrameTime();
   RefPtr<MediaResource> mResource;
   RefPtr<ResourceStream> mStream;
   UniquePtr<TrackInfo> mInfo;
+  // Source of the sample index; released once the index has been built.
+  RefPtr<MP4MetadataHolder> mMetadata;
   RefPtr<Index> mIndex;
   UniquePtr<SampleIterator> mIterator;
   Maybe<media::TimeUnit> mNextKeyframeTime;
@@ -103,7 +124,9 @@ RefPtr<MP4Demuxer::InitPromise> MP4Demuxer::Init() {
 
   RefPtr<BufferStream> bufferstream = new BufferStream(initData.Ref());
 
-  MP4Metadata metadata{bufferstream};
+  RefPtr<MP4MetadataHolder> metadataHolder =
+      new MP4MetadataHolder(bufferstream);
+  MP4Metadata& metadata = metadataHolder->Metadata();
   DDLINKCHILD("metadata", &metadata);
   nsresult rv = metadata.Parse();
   if (NS_FAILED(rv)) {
@@ -176,16 +199,8 @@ RefPtr<MP4Demuxer::InitPromise> MP4Demuxer::Init() {
       } else if (NS_FAILED(info.Result()) && result == NS_OK) {
         result = std::move(info.Result());
       }
-      MP4Metadata::ResultAndIndice indices =
-          metadata.GetTrackIndice(info.Ref()->mTrackId);
-      if (!indices.Ref()) {
-        if (NS_FAILED(info.Result()) && result == NS_OK) {
-          result = std::move(indices.Result());
-        }
-        continue;
-      }
       RefPtr<MP4TrackDemuxer> demuxer = new MP4TrackDemuxer(
-          mResource, std::move(info.Ref()), *indices.Ref().get());
+          mResource, std::move(info.Ref()), metadataHolder);
       DDLINKCHILD("audio demuxer", demuxer.get());
       mAudioDemuxers.AppendElement(std::move(demuxer));
     }
@@ -213,16 +228,8 @@ RefPtr<MP4Demuxer::InitPromise> MP4Demuxer::Init() {
       } else if (NS_FAILED(info.Result()) && result == NS_OK) {
         result = std::move(info.Result());
       }
-      MP4Metadata::ResultAndIndice indices =
-          metadata.GetTrackIndice(info.Ref()->mTrackId);
-      if (!indices.Ref()) {
-        if (NS_FAILED(info.Result()) && result == NS_OK) {
-          result = std::move(indices.Result());
-        }
-        continue;
-      }
       RefPtr<MP4TrackDemuxer> demuxer = new MP4TrackDemuxer(
-          mResource, std::move(info.Ref()), *indices.Ref().get());
+          mResource, std::move(info.Ref()), metadataHolder);
       DDLINKCHILD("video demuxer", demuxer.get());
       mVideoDemuxers.AppendElement(std::move(demuxer));
     }
@@ -305,15 +312,12 @@ UniquePtr<EncryptionInfo> MP4Demuxer::GetCrypto() {
 
 MP4TrackDemuxer::MP4TrackDemuxer(MediaResource* aResource,
                                  UniquePtr<TrackInfo>&& aInfo,
-                                 const IndiceWrapper& aIndices)
+                                 RefPtr<MP4MetadataHolder> aMetadata)
     : mResource(aResource),
       mStream(new ResourceStream(aResource)),
       mInfo(std::move(aInfo)),
-      mIndex(new Index(aIndices, mStream, mInfo->mTrackId, mInfo->IsAudio())),
-      mIterator(MakeUnique<SampleIterator>(mIndex)),
+      mMetadata(std::move(aMetadata)),
       mNeedReIndex(true) {
-  EnsureUpToDateIndex();  // Force update of index
-
   VideoInfo* videoInfo = mInfo->GetAsVideoInfo();
   if (videoInfo && MP4Decoder::IsH264(mInfo->mMimeType)) {
     mType = kH264;
@@ -336,8 +340,40 @@ MP4TrackDemuxer::MP4TrackDemuxer(MediaResource* aResource,
 
 UniquePtr<TrackInfo> MP4TrackDemuxer::GetInfo() const { return mInfo->Clone(); }
 
+bool MP4TrackDemuxer::EnsureIndex() {
+  if (mIndex) {
+    return true;
+  }
+  if (!mMetadata) {
+    // Building the index failed earlier.
+    return false;
+  }
+  // Building the index walks the whole sample table and dominates Init()
+  // time for long recordings, so it is deferred to the first seek or sample
+  // request; Init() resolves (and 'loadedmetadata' fires) once the headers
+  // have been parsed.
+  {
+    MP4Metadata::ResultAndIndice indices =
+        mMetadata->Metadata().GetTrackIndice(mInfo->mTrackId);
+    if (!indices.Ref()) {
+      mMetadata = nullptr;
+      return false;
+    }
+    mIndex = new Index(*indices.Ref().get(), mStream, mInfo->mTrackId,
+                       mInfo->IsAudio());
+    mIterator = MakeUnique<SampleIterator>(mIndex);
+  }
+  // The metadata, and with it the rust parser owning the indice tables, is
+  // only needed until the index has been built. Drop our reference so the
+  // memory is released once every track demuxer has an index.
+  mMetadata = nullptr;
+  mNeedReIndex = true;
+  EnsureUpToDateIndex();
+  return true;
+}
+
 void MP4TrackDemuxer::EnsureUpToDateIndex() {
-  if (!mNeedReIndex) {
+  if (!mNeedReIndex || !mIndex) {
     return;
   }
   AutoPinned<MediaResource> resource(mResource);
@@ -352,6 +388,10 @@ void MP4TrackDemuxer::EnsureUpToDateIndex() {
 
 RefPtr<MP4TrackDemuxer::SeekPromise> MP4TrackDemuxer::Seek(
     const media::TimeUnit& aTime) {
+  if (!EnsureIndex()) {
+    return SeekPromise::CreateAndReject(NS_ERROR_DOM_MEDIA_END_OF_STREAM,
+                                        __func__);
+  }
   auto seekTime = aTime;
   mQueuedSample = nullptr;
 
@@ -442,6 +482,10 @@ already_AddRefed<MediaRawData> MP4TrackDemuxer::GetNextSample() {
 
 RefPtr<MP4TrackDemuxer::SamplesPromise> MP4TrackDemuxer::GetSamples(
     int32_t aNumSamples) {
+  if (!EnsureIndex()) {
+    return SamplesPromise::CreateAndReject(NS_ERROR_DOM_MEDIA_END_OF_STREAM,
+                                           __func__);
+  }
   EnsureUpToDateIndex();
   RefPtr<SamplesHolder> samples = new SamplesHolder;
   if (!aNumSamples) {
@@ -487,6 +531,10 @@ void MP4TrackDemuxer::SetNextKeyFrameTime() {
 
 void MP4TrackDemuxer::Reset() {
   mQueuedSample = nullptr;
+  if (!mIterator) {
+    // No index yet; the first sample request starts from the beginning.
+    return;
+  }
   // TODO, Seek to first frame available, which isn't always 0.
   mIterator->Seek(0);
   SetNextKeyFrameTime();
@@ -505,6 +553,11 @@ nsresult MP4TrackDemuxer::GetNextRandomAccessPoint(media::TimeUnit* aTime) {
 RefPtr<MP4TrackDemuxer::SkipAccessPointPromise>
 MP4TrackDemuxer::SkipToNextRandomAccessPoint(
     const media::TimeUnit& aTimeThreshold) {
+  if (!EnsureIndex()) {
+    SkipFailureHolder failure(NS_ERROR_DOM_MEDIA_END_OF_STREAM, 0);
+    return SkipAccessPointPromise::CreateAndReject(std::move(failure),
+                                                   __func__);
+  }
   mQueuedSample = nullptr;
   // Loop until we reach the next keyframe after the threshold.
   uint32_t parsed = 0;
@@ -527,6 +580,9 @@ MP4TrackDemuxer::SkipToNextRandomAccessPoint(
 }
 
 media::TimeIntervals MP4TrackDemuxer::GetBuffered() {
+  if (!EnsureIndex()) {
+    return media::TimeIntervals();
+  }
   EnsureUpToDateIndex();
   AutoPinned<MediaResource> resource(mResource);
   MediaByteRangeSet byteRanges;
@@ -542,6 +598,9 @@ media::TimeIntervals MP4TrackDemuxer::GetBuffered() {
 void MP4TrackDemuxer::NotifyDataArrived() { mNeedReIndex = true; }
 
 void MP4TrackDemuxer::NotifyDataRemoved() {
+  if (!mIndex) {
+    return;
+  }
   AutoPinned<MediaResource> resource(mResource);
   MediaByteRangeSet byteRanges;
   nsresult rv = resource->GetCachedRanges(byteRanges);
@@ -6,6 +6,8 @@
 
 #include "mozilla/ShmemPool.h"
 
+#include <inttypes.h>
+
 #include <utility>
 
 #include "mozilla/Assertions.h"
@@ -22,7 +24,10 @@ ShmemPool::ShmemPool(size_t aPoolSize, PoolType aPoolType)
     : mPoolType(aPoolType),
       mMutex("mozilla::ShmemPool"),
       mPoolFree(aPoolSize),
-      mErrorLogged(false)
+      mErrorLogged(false),
+      mReuseCount(0),
+      mAllocCount(0),
+      mResizeCount(0)
 #ifdef DEBUG
       ,
       mMaxPoolUse(0)
@@ -49,6 +54,8 @@ mozilla::ShmemBuffer ShmemPool::GetIfAvailable(size_t aSize) {
     return ShmemBuffer();
   }
 
+  SelectBestFit(aSize);
+
   ShmemBuffer& res = mShmemPool[mPoolFree - 1];
 
   if (!res.mInitialized) {
@@ -63,6 +70,9 @@ mozilla::ShmemBuffer ShmemPool::GetIfAvailable(size_t aSize) {
     return ShmemBuffer();
   }
 
+  mReuseCount++;
+  MaybeLogStats();
+
   mPoolFree--;
 #ifdef DEBUG
   size_t poolUse = mShmemPool.Length() - mPoolFree;
@@ -75,6 +85,53 @@ mozilla::ShmemBuffer ShmemPool::GetIfAvailable(size_t aSize) {
   return std::move(res);
 }
 
+void ShmemPool::SelectBestFit(size_t aSize) {
+  mMutex.AssertCurrentThreadOwns();
+  MOZ_ASSERT(mPoolFree > 0);
+
+  const size_t top = mPoolFree - 1;
+  size_t bestFit = mPoolFree;   // smallest free buffer large enough for aSize
+  size_t smallest = mPoolFree;  // smallest free buffer overall
+  size_t empty = mPoolFree;     // a slot with no buffer allocated yet
+
+  for (size_t i = 0; i < mPoolFree; i++) {
+    ShmemBuffer& candidate = mShmemPool[i];
+    if (!candidate.mInitialized) {
+      empty = i;
+      continue;
+    }
+    size_t size = candidate.mShmem.Size<uint8_t>();
+    if (size >= aSize && (bestFit == mPoolFree ||
+                          size < mShmemPool[bestFit].mShmem.Size<uint8_t>())) {
+      bestFit = i;
+    }
+    if (smallest == mPoolFree ||
+        size < mShmemPool[smallest].mShmem.Size<uint8_t>()) {
+      smallest = i;
+    }
+  }
+
+  size_t chosen = bestFit != mPoolFree ? bestFit
+                  : empty != mPoolFree ? empty
+                                       : smallest;
+  MOZ_ASSERT(chosen < mPoolFree);
+  if (chosen != top) {
+    std::swap(mShmemPool[chosen], mShmemPool[top]);
+  }
+}
+
+void ShmemPool::MaybeLogStats() {
+  mMutex.AssertCurrentThreadOwns();
+
+  uint64_t total = mReuseCount + mAllocCount + mResizeCount;
+  if (total && (total & 0xFF) == 0) {
+    SHMEMPOOL_LOG(("ShmemPool %p served %" PRIu64 " of %" PRIu64
+                   " requests from the pool (%" PRIu64 " fresh, %" PRIu64
+                   " reallocated)",
+                   this, mReuseCount, total, mAllocCount, mResizeCount));
+  }
+}
+
 void ShmemPool::Put(ShmemBuffer&& aShmem) {
   MutexAutoLock lock(mMutex);
   MOZ_ASSERT(mPoolFree < mShmemPool.Length());
@@ -112,6 +112,13 @@ class ShmemPool final {
       mPoolFree++;
     }
 
+    // Move the free buffer best suited for this request to the top of the
+    // free stack. With buffers of several sizes cycling through the pool
+    // (say, interleaved large and small frames), blindly taking the top one
+    // keeps hitting the reallocation path below, and every reallocation is a
+    // kernel round trip.
+    SelectBestFit(aSize);
+
     ShmemBuffer& res = mShmemPool[mPoolFree - 1];
 
     if (!res.mInitialized) {
@@ -121,14 +128,10 @@ class ShmemPool final {
         return ShmemBuffer();
       }
       res.mInitialized = true;
-    }
-
-    MOZ_DIAGNOSTIC_ASSERT(res.mShmem.IsWritable(),
-                          "Shmem in Pool is not writable?");
-
-    // Prepare buffer, increase size if needed (we never shrink as we don't
-    // maintain seperate sized pools and we don't want to keep reallocating)
-    if (res.mShmem.Size<char>() < aSize) {
+      mAllocCount++;
+    } else if (res.mShmem.Size<char>() < aSize) {
+      // No free buffer is large enough, so the best candidate has to be
+      // reallocated (we never shrink as we don't want to keep reallocating).
       SHMEMPOOL_LOG(("Size change/increase in Shmem Pool"));
       aInstance->DeallocShmem(res.mShmem);
       res.mInitialized = false;
@@ -136,13 +139,17 @@ class ShmemPool final {
       if (!AllocateShmem(aInstance, aSize, res, aPolicy)) {
         SHMEMPOOL_LOG(("Failure allocating resized Shmem buffer"));
         return ShmemBuffer();
-      } else {
-        res.mInitialized = true;
       }
+      res.mInitialized = true;
+      mResizeCount++;
+    } else {
+      mReuseCount++;
     }
 
-    MOZ_ASSERT(res.mShmem.IsWritable(),
-               "Shmem in Pool is not writable post resize?");
+    MOZ_DIAGNOSTIC_ASSERT(res.mShmem.IsWritable(),
+                          "Shmem in Pool is not writable?");
+
+    MaybeLogStats();
 
     mPoolFree--;
 #ifdef DEBUG
@@ -167,10 +174,22 @@ class ShmemPool final {
             aInstance->AllocUnsafeShmem(aSize, ipc::SharedMemory::TYPE_BASIC,
                                         &aRes.mShmem));
   }
+  // Called with mMutex held. Moves the free buffer best suited for a request
+  // of aSize to the top of the free stack: the tightest fit if one is large
+  // enough, otherwise an empty slot, otherwise the smallest buffer as the
+  // cheapest one to sacrifice for reallocation.
+  void SelectBestFit(size_t aSize);
+  // Called with mMutex held. Periodically logs how often requests were
+  // served from the pool vs. needing a fresh or reallocated Shmem.
+  void MaybeLogStats();
+
   const PoolType mPoolType;
   Mutex mMutex;
   size_t mPoolFree;
   bool mErrorLogged;
+  uint64_t mReuseCount;
+  uint64_t mAllocCount;
+  uint64_t mResizeCount;
 #ifdef DEBUG
   size_t mMaxPoolUse;
 #endif
@@ -84,6 +84,7 @@ ScriptLoadRequest::ScriptLoadRequest(ScriptKind aKind, nsIURI* aURI,
       mIsXSLT(false),
       mIsCanceled(false),
       mWasCompiledOMT(false),
+      mIsDecodeAhead(false),
       mIsTracking(false),
       mFetchOptions(aFetchOptions),
       mOffThreadToken(nullptr),
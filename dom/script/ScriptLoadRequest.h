@@ -297,6 +297,9 @@ class ScriptLoadRequest
   bool mIsCanceled;                // True if we have been explicitly canceled.
   bool mWasCompiledOMT;  // True if the script has been compiled off main
                          // thread.
+  bool mIsDecodeAhead;   // True if the off-thread decode of the cached
+                         // bytecode was started as soon as the alternate data
+                         // arrived, before the script's turn to execute.
   bool mIsTracking;      // True if the script comes from a source on our
                          // tracking protection list.
 
@@ -618,7 +618,7 @@ static nsresult HandleResolveFailure(JSContext* aCx, ModuleScript* aScript,
 }
 
 static already_AddRefed<nsIURI> ResolveModuleSpecifier(
-    ScriptLoader* aLoader, LoadedScript* aScript, const nsAString& aSpecifier) {
+    nsIURI* aBaseURL, const nsAString& aSpecifier) {
   // The following module specifiers are allowed by the spec:
   //  - a valid absolute URL
   //  - a valid relative URL that starts with "/", "./" or "../"
@@ -642,7 +642,17 @@ static already_AddRefed<nsIURI> ResolveModuleSpecifier(
     return nullptr;
   }
 
-  // Get the document's base URL if we don't have a referencing script here.
+  rv = NS_NewURI(getter_AddRefs(uri), aSpecifier, nullptr, aBaseURL);
+  if (NS_SUCCEEDED(rv)) {
+    return uri.forget();
+  }
+
+  return nullptr;
+}
+
+static already_AddRefed<nsIURI> ResolveModuleSpecifier(
+    ScriptLoader* aLoader, LoadedScript* aScript, const nsAString& aSpecifier) {
+  // Use the document's base URL if we don't have a referencing script here.
   nsCOMPtr<nsIURI> baseURL;
   if (aScript) {
     baseURL = aScript->BaseURL();
@@ -650,12 +660,7 @@ static already_AddRefed<nsIURI> ResolveModuleSpecifier(
     baseURL = aLoader->GetDocument()->GetDocBaseURI();
   }
 
-  rv = NS_NewURI(getter_AddRefs(uri), aSpecifier, nullptr, baseURL);
-  if (NS_SUCCEEDED(rv)) {
-    return uri.forget();
-  }
-
-  return nullptr;
+  return ResolveModuleSpecifier(baseURL, aSpecifier);
 }
 
 static nsresult ResolveRequestedModules(ModuleLoadRequest* aRequest,
@@ -807,6 +812,317 @@ RefPtr<GenericPromise> ScriptLoader::StartFetchingModuleAndDependencies(
   return ready;
 }
 
+// Helpers for ModuleImportScanner: view a code unit as a char16_t for the
+// purposes of ASCII token matching, and append a scanned specifier to the
+// output array in its original encoding.
+static inline char16_t ScannedChar(char16_t aUnit) { return aUnit; }
+static inline char16_t ScannedChar(Utf8Unit aUnit) { return aUnit.toUint8(); }
+
+static void AppendScannedSpecifier(const char16_t* aStart, size_t aLength,
+                                   nsTArray<nsString>& aSpecifiers) {
+  aSpecifiers.AppendElement(nsString(aStart, aLength));
+}
+
+static void AppendScannedSpecifier(const Utf8Unit* aStart, size_t aLength,
+                                   nsTArray<nsString>& aSpecifiers) {
+  CopyUTF8toUTF16(
+      MakeSpan(reinterpret_cast<const char*>(aStart), aLength),
+      *aSpecifiers.AppendElement());
+}
+
+// A conservative scan of the start of a module's source for static import and
+// re-export specifiers, used to start fetching dependencies before the module
+// itself has been compiled.
+//
+// This is not a parser: it only understands the module preamble (whitespace,
+// comments, semicolons and import/export declarations) and gives up at the
+// first construct it doesn't recognize. That is fine for its purpose:
+// anything it misses is fetched as normal once compilation reveals the real
+// dependency list, and anything it wrongly extracts just results in a preload
+// that is never used.
+template <typename Unit>
+class MOZ_STACK_CLASS ModuleImportScanner {
+ public:
+  ModuleImportScanner(const Unit* aText, size_t aLength)
+      : mCursor(aText), mEnd(aText + aLength) {}
+
+  // Appends the specifier of each import or re-export declaration found in
+  // the module preamble to aSpecifiers.
+  void Scan(nsTArray<nsString>& aSpecifiers) {
+    while (SkipSpaceAndComments()) {
+      if (Peek() == ';') {
+        Advance();
+        continue;
+      }
+
+      nsAutoString word;
+      if (!ReadWord(word)) {
+        return;
+      }
+
+      if (word.EqualsLiteral("import")) {
+        if (!ScanImport(aSpecifiers)) {
+          return;
+        }
+      } else if (word.EqualsLiteral("export")) {
+        if (!ScanExport(aSpecifiers)) {
+          return;
+        }
+      } else {
+        return;
+      }
+    }
+  }
+
+ private:
+  bool AtEnd() const { return mCursor == mEnd; }
+  char16_t Peek() const { return ScannedChar(*mCursor); }
+  void Advance() { ++mCursor; }
+
+  static bool IsWordStart(char16_t aChar) {
+    return (aChar >= 'a' && aChar <= 'z') || (aChar >= 'A' && aChar <= 'Z') ||
+           aChar == '_' || aChar == '$';
+  }
+
+  static bool IsWordChar(char16_t aChar) {
+    return IsWordStart(aChar) || (aChar >= '0' && aChar <= '9');
+  }
+
+  // Skips whitespace and comments. Returns false at end of input or on an
+  // unterminated comment.
+  bool SkipSpaceAndComments() {
+    while (!AtEnd()) {
+      char16_t c = Peek();
+      if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' ||
+          c == '\v') {
+        Advance();
+        continue;
+      }
+
+      if (c != '/') {
+        return true;
+      }
+
+      const Unit* start = mCursor;
+      Advance();
+      if (!AtEnd() && Peek() == '/') {
+        while (!AtEnd() && Peek() != '\r' && Peek() != '\n') {
+          Advance();
+        }
+        continue;
+      }
+      if (!AtEnd() && Peek() == '*') {
+        Advance();
+        while (!AtEnd()) {
+          c = Peek();
+          Advance();
+          if (c == '*' && !AtEnd() && Peek() == '/') {
+            Advance();
+            start = nullptr;
+            break;
+          }
+        }
+        if (!start) {
+          continue;
+        }
+        return false;
+      }
+
+      // A lone slash can't start an import or export declaration.
+      mCursor = start;
+      return true;
+    }
+    return false;
+  }
+
+  bool ReadWord(nsAString& aWord) {
+    if (AtEnd() || !IsWordStart(Peek())) {
+      return false;
+    }
+    while (!AtEnd() && IsWordChar(Peek())) {
+      aWord.Append(Peek());
+      Advance();
+    }
+    return true;
+  }
+
+  // Reads a string literal, appending its contents to aSpecifiers. Returns
+  // false if the literal is unterminated or contains escapes, which real
+  // world module specifiers don't.
+  bool ReadSpecifierString(nsTArray<nsString>& aSpecifiers) {
+    char16_t quote = Peek();
+    MOZ_ASSERT(quote == '"' || quote == '\'');
+    Advance();
+
+    const Unit* start = mCursor;
+    while (!AtEnd()) {
+      char16_t c = Peek();
+      if (c == quote) {
+        AppendScannedSpecifier(start, mCursor - start, aSpecifiers);
+        Advance();
+        return true;
+      }
+      if (c == '\\' || c == '\r' || c == '\n') {
+        return false;
+      }
+      Advance();
+    }
+    return false;
+  }
+
+  enum class FromClause { eFound, eAbsent, eError };
+
+  // Scans forward over an import or export clause looking for
+  // `from "specifier"`. A top-level semicolon before any `from` indicates an
+  // export of local bindings, which has no specifier.
+  FromClause ScanFromClause(nsTArray<nsString>& aSpecifiers) {
+    size_t depth = 0;
+    while (SkipSpaceAndComments()) {
+      char16_t c = Peek();
+      if (c == '{') {
+        depth++;
+        Advance();
+        continue;
+      }
+      if (c == '}') {
+        if (depth == 0) {
+          return FromClause::eError;
+        }
+        depth--;
+        Advance();
+        continue;
+      }
+      if (c == ',' || c == '*') {
+        Advance();
+        continue;
+      }
+      if (c == ';' && depth == 0) {
+        // Leave the semicolon for the caller.
+        return FromClause::eAbsent;
+      }
+      if (!IsWordStart(c)) {
+        return FromClause::eError;
+      }
+
+      nsAutoString word;
+      ReadWord(word);
+      if (depth != 0 || !word.EqualsLiteral("from")) {
+        continue;
+      }
+
+      if (!SkipSpaceAndComments()) {
+        return FromClause::eError;
+      }
+      c = Peek();
+      if (c != '"' && c != '\'') {
+        return FromClause::eError;
+      }
+      return ReadSpecifierString(aSpecifiers) ? FromClause::eFound
+                                              : FromClause::eError;
+    }
+    return FromClause::eError;
+  }
+
+  // Scans the part of an import declaration following the `import` keyword.
+  bool ScanImport(nsTArray<nsString>& aSpecifiers) {
+    if (!SkipSpaceAndComments()) {
+      return false;
+    }
+    char16_t c = Peek();
+    if (c == '(' || c == '.') {
+      // import() or import.meta: we're past the preamble.
+      return false;
+    }
+    if (c == '"' || c == '\'') {
+      // import "module";
+      return ReadSpecifierString(aSpecifiers);
+    }
+    return ScanFromClause(aSpecifiers) == FromClause::eFound;
+  }
+
+  // Scans the part of an export declaration following the `export` keyword.
+  bool ScanExport(nsTArray<nsString>& aSpecifiers) {
+    if (!SkipSpaceAndComments()) {
+      return false;
+    }
+    char16_t c = Peek();
+    if (c != '*' && c != '{') {
+      // An export of a local declaration: treat it as the end of the
+      // preamble rather than trying to scan over arbitrary code.
+      return false;
+    }
+    return ScanFromClause(aSpecifiers) != FromClause::eError;
+  }
+
+  const Unit* mCursor;
+  const Unit* mEnd;
+};
+
+void ScriptLoader::PreloadModuleDependencies(ModuleLoadRequest* aRequest) {
+  // A module's dependencies are normally discovered by compiling it, which
+  // means each level of the module graph costs a network round trip before
+  // the next level's fetches can even start. To collapse that waterfall,
+  // speculatively scan the source for static import specifiers as soon as it
+  // arrives and start preload-style fetches for them while the module
+  // compiles. The preloads enter the module map, where the real dependency
+  // fetches started by StartFetchingModuleDependencies find and reuse them;
+  // fetched dependencies are scanned in turn, so a deep graph is discovered
+  // without waiting for any compilation at all.
+  //
+  // The scan is conservative. Any dependency it misses is fetched as normal
+  // once the module has compiled, and a mistaken fetch is just a preload
+  // that's never used; in particular the speculative requests are not linked
+  // into the import graph, so a bogus one can never fail a real load.
+  if (!StaticPrefs::dom_script_loader_speculative_module_preload_enabled()) {
+    return;
+  }
+
+  if (!mDocument || !aRequest->IsTextSource()) {
+    return;
+  }
+
+  nsTArray<nsString> specifiers;
+  if (aRequest->IsUTF16Text()) {
+    const auto& text = aRequest->ScriptText<char16_t>();
+    ModuleImportScanner<char16_t>(text.begin(), text.length())
+        .Scan(specifiers);
+  } else {
+    MOZ_ASSERT(aRequest->IsUTF8Text());
+    const auto& text = aRequest->ScriptText<Utf8Unit>();
+    ModuleImportScanner<Utf8Unit>(text.begin(), text.length())
+        .Scan(specifiers);
+  }
+
+  for (const nsString& specifier : specifiers) {
+    nsCOMPtr<nsIURI> uri = ResolveModuleSpecifier(aRequest->mBaseURL,
+                                                  specifier);
+    if (!uri || ModuleMapContainsURL(uri)) {
+      continue;
+    }
+
+    RefPtr<ScriptLoadRequest> request = CreateLoadRequest(
+        ScriptKind::eModule, uri, nullptr, aRequest->TriggeringPrincipal(),
+        aRequest->CORSMode(), SRIMetadata(), aRequest->ReferrerPolicy());
+    request->mIsInline = false;
+    request->SetScriptMode(false, /* aAsyncAttr = */ true, false);
+    request->SetIsPreloadRequest();
+
+    if (LOG_ENABLED()) {
+      nsAutoCString url;
+      uri->GetAsciiSpec(url);
+      LOG(("ScriptLoadRequest (%p): Speculative dependency preload for %s",
+           aRequest, url.get()));
+    }
+
+    if (NS_FAILED(StartLoad(request))) {
+      continue;
+    }
+
+    PreloadInfo* pi = mPreloads.AppendElement();
+    pi->mRequest = request;
+  }
+}
+
 static ScriptLoader* GetCurrentScriptLoader(JSContext* aCx) {
   auto reportError = mozilla::MakeScopeExit([aCx]() {
     JS_ReportErrorASCII(aCx, "No ScriptLoader found for the current context");
@@ -1989,6 +2305,19 @@ nsresult ScriptLoader::ProcessOffThreadRequest(ScriptLoadRequest* aRequest) {
   MOZ_ASSERT(aRequest->mProgress == ScriptLoadRequest::Progress::eCompiling);
   MOZ_ASSERT(!aRequest->mWasCompiledOMT);
 
+  if (aRequest->mIsDecodeAhead) {
+    // The cached bytecode was decoded ahead of the script's turn to execute.
+    // Keep the decode token so that evaluation joins the decoded result, and
+    // let the request wait for its turn as if it had just finished loading.
+    // mWasCompiledOMT is deliberately left false: the onload blocker taken by
+    // AttemptAsyncScriptCompile is released here, not at execution time.
+    aRequest->SetReady();
+    MaybeMoveToLoadedList(aRequest);
+    mDocument->UnblockOnload(false);
+    ProcessPendingRequests();
+    return NS_OK;
+  }
+
   aRequest->mWasCompiledOMT = true;
 
   if (aRequest->IsModuleRequest()) {
@@ -2174,8 +2503,14 @@ nsresult ScriptLoader::CompileOffThreadOrProcessRequest(
     ScriptLoadRequest* aRequest) {
   NS_ASSERTION(nsContentUtils::IsSafeToRunScript(),
                "Processing requests when running scripts is unsafe.");
-  NS_ASSERTION(!aRequest->mOffThreadToken,
-               "Candidate for off-thread compile is already parsed off-thread");
+
+  if (aRequest->mOffThreadToken) {
+    // The cached bytecode for this request was decoded ahead of time;
+    // evaluation joins the already-decoded result.
+    MOZ_ASSERT(aRequest->mIsDecodeAhead);
+    return ProcessRequest(aRequest);
+  }
+
   NS_ASSERTION(
       !aRequest->InCompilingStage(),
       "Candidate for off-thread compile is already in compiling stage.");
@@ -3649,6 +3984,10 @@ nsresult ScriptLoader::PrepareLoadedRequest(ScriptLoadRequest* aRequest,
       return NS_ERROR_FAILURE;
     }
 
+    // Start fetching this module's static imports before we compile it; see
+    // PreloadModuleDependencies.
+    PreloadModuleDependencies(request);
+
     // Attempt to compile off main thread.
     bool couldCompile = false;
     rv = AttemptAsyncScriptCompile(request, &couldCompile);
@@ -3680,6 +4019,22 @@ nsresult ScriptLoader::PrepareLoadedRequest(ScriptLoadRequest* aRequest,
     // If off-thread compile was rejected, continue with regular processing.
   }
 
+  // If the cache served bytecode, start decoding it off the main thread right
+  // away rather than when the script's turn to execute comes, so that the
+  // decode overlaps with the remainder of the page load.  The request is
+  // marked ready again once the decode has finished, and evaluation then
+  // joins the already-decoded result; see ProcessOffThreadRequest.
+  if (aRequest->IsBytecode() && aRequest != mParserBlockingRequest &&
+      NumberOfProcessors() > 1) {
+    bool couldDecode = false;
+    rv = AttemptAsyncScriptCompile(aRequest, &couldDecode);
+    NS_ENSURE_SUCCESS(rv, rv);
+    if (couldDecode) {
+      aRequest->mIsDecodeAhead = true;
+      return NS_OK;
+    }
+  }
+
   MaybeMoveToLoadedList(aRequest);
 
   return NS_OK;
@@ -581,6 +581,11 @@ class ScriptLoader final : public nsISupports {
   RefPtr<mozilla::GenericPromise> StartFetchingModuleAndDependencies(
       ModuleLoadRequest* aParent, nsIURI* aURI);
 
+  // Speculatively start preload-style fetches for the static import
+  // specifiers found at the start of a module's source, before the module is
+  // compiled.
+  void PreloadModuleDependencies(ModuleLoadRequest* aRequest);
+
   nsresult InitDebuggerDataForModuleTree(JSContext* aCx,
                                          ModuleLoadRequest* aRequest);
 
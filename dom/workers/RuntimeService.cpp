@@ -1431,6 +1431,27 @@ bool RuntimeService::ScheduleWorker(WorkerPrivate* aWorkerPrivate) {
     return false;
   }
 
+  // If this left the idle thread pool empty, create a spare thread right away
+  // while the new worker is busy initializing its runtime.  Pages commonly
+  // spawn several workers back to back, and the spare lets the next
+  // ScheduleWorker call skip thread creation.  If no worker claims it, the
+  // regular idle timeout reclaims it.  NoteIdleThread must be called on the
+  // main thread, so workers spawned from other workers don't prepare a spare.
+  if (NS_IsMainThread() && !mShuttingDown) {
+    bool makeSpare;
+    {
+      MutexAutoLock lock(mMutex);
+      makeSpare = mIdleThreadArray.IsEmpty();
+    }
+
+    if (makeSpare) {
+      RefPtr<WorkerThread> spareThread = WorkerThread::Create(friendKey);
+      if (spareThread) {
+        NoteIdleThread(spareThread);
+      }
+    }
+  }
+
   return true;
 }
 
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "CompositionTransaction.h"
+#include "InsertTextTransaction.h"
 #include "mozilla/EditorBase.h"
 #include "mozilla/dom/Selection.h"
 #include "nsGkAtoms.h"
@@ -129,9 +130,24 @@ PlaceholderTransaction::Merge(nsITransaction* aTransaction, bool* aDidMerge) {
         }
       }
     } else if (!absorbingTransaction) {
-      // See bug 171243: just drop incoming placeholders on the floor.
-      // Their children will be swallowed by this preexisting one.
-      AppendChild(editTransactionBase);
+      // If the incoming transaction continues a run of sequential text
+      // inserts, coalesce it into our last child rather than accumulating
+      // one transaction record per keystroke; InsertTextTransaction::Merge()
+      // only absorbs an insert which starts exactly where the previous one
+      // ended, so undo/redo behavior is unchanged.
+      bool didMergeChild = false;
+      if (!mChildren.IsEmpty()) {
+        RefPtr<InsertTextTransaction> insertTransaction =
+            do_QueryObject(editTransactionBase);
+        if (insertTransaction) {
+          mChildren.LastElement()->Merge(aTransaction, &didMergeChild);
+        }
+      }
+      if (!didMergeChild) {
+        // See bug 171243: just drop incoming placeholders on the floor.
+        // Their children will be swallowed by this preexisting one.
+        AppendChild(editTransactionBase);
+      }
     }
     *aDidMerge = true;
     //  RememberEndingSelection();
@@ -52,6 +52,7 @@
 #include "nsRange.h"
 #include "nsIPrefBranch.h"
 #include "nsIRunnable.h"
+#include "nsITimer.h"
 #include "nsString.h"
 #include "nsThreadUtils.h"
 #include "nsUnicharUtils.h"
@@ -60,7 +61,6 @@
 #include "nsRange.h"
 #include "nsContentUtils.h"
 #include "nsIObserverService.h"
-#include "prtime.h"
 
 using namespace mozilla;
 using namespace mozilla::dom;
@@ -70,11 +70,12 @@ using namespace mozilla::ipc;
 //#define DEBUG_INLINESPELL
 
 // the number of milliseconds that we will take at once to do spellchecking
+// when we don't know how long the current idle period lasts
 #define INLINESPELL_CHECK_TIMEOUT 1
 
 // The number of words to check before we look at the time to see if
-// INLINESPELL_CHECK_TIMEOUT ms have elapsed. This prevents us from getting
-// stuck and not moving forward because the INLINESPELL_CHECK_TIMEOUT might
+// the deadline of the check has passed. This prevents us from getting
+// stuck and not moving forward because the time budget might
 // be too short to a low-end machine.
 #define INLINESPELL_MINIMUM_WORDS_BEFORE_TIMEOUT 5
 
@@ -88,8 +89,6 @@ using namespace mozilla::ipc;
 
 static const char kMaxSpellCheckSelectionSize[] =
     "extensions.spellcheck.inline.max-misspellings";
-static const PRTime kMaxSpellCheckTimeInUsec =
-    INLINESPELL_CHECK_TIMEOUT * PR_USEC_PER_MSEC;
 
 mozInlineSpellStatus::mozInlineSpellStatus(mozInlineSpellChecker* aSpellChecker)
     : mSpellChecker(aSpellChecker) {}
@@ -432,11 +431,11 @@ already_AddRefed<nsRange> mozInlineSpellStatus::PositionToCollapsedRange(
 
 // mozInlineSpellResume
 
-class mozInlineSpellResume : public Runnable {
+class mozInlineSpellResume : public IdleRunnable {
  public:
   mozInlineSpellResume(UniquePtr<mozInlineSpellStatus>&& aStatus,
                        uint32_t aDisabledAsyncToken)
-      : Runnable("mozInlineSpellResume"),
+      : IdleRunnable("mozInlineSpellResume"),
         mDisabledAsyncToken(aDisabledAsyncToken),
         mStatus(std::move(aStatus)) {}
 
@@ -446,18 +445,56 @@ class mozInlineSpellResume : public Runnable {
                                            EventQueuePriority::Idle);
   }
 
+  // Called by the idle queue with the end of the current idle period, so
+  // that DoSpellCheck can size its slice to the available idle time.
+  void SetDeadline(TimeStamp aDeadline) override { mDeadline = aDeadline; }
+
+  // Called by the dispatch with timeout so that the resumption isn't
+  // starved if no idle period comes along; in that case we run without a
+  // deadline and fall back to the fixed time budget.
+  void SetTimer(uint32_t aDelay, nsIEventTarget* aTarget) override {
+    MOZ_ASSERT(aTarget);
+    MOZ_ASSERT(!mTimer);
+    NS_NewTimerWithFuncCallback(getter_AddRefs(mTimer), TimedOut, this, aDelay,
+                                nsITimer::TYPE_ONE_SHOT,
+                                "mozInlineSpellResume::SetTimer", aTarget);
+  }
+
   NS_IMETHOD Run() override {
+    // If the timeout fired first, the idle queue still holds us and calls
+    // Run a second time; the first run consumed mStatus.
+    if (!mStatus) {
+      return NS_OK;
+    }
+    CancelTimer();
     // Discard the resumption if the spell checker was disabled after the
     // resumption was scheduled.
     if (mDisabledAsyncToken == mStatus->mSpellChecker->mDisabledAsyncToken) {
-      mStatus->mSpellChecker->ResumeCheck(std::move(mStatus));
+      mStatus->mSpellChecker->ResumeCheck(std::move(mStatus), mDeadline);
     }
     return NS_OK;
   }
 
  private:
+  ~mozInlineSpellResume() { CancelTimer(); }
+
+  static void TimedOut(nsITimer* aTimer, void* aClosure) {
+    RefPtr<mozInlineSpellResume> self =
+        static_cast<mozInlineSpellResume*>(aClosure);
+    self->Run();
+  }
+
+  void CancelTimer() {
+    if (mTimer) {
+      mTimer->Cancel();
+      mTimer = nullptr;
+    }
+  }
+
   uint32_t mDisabledAsyncToken;
   UniquePtr<mozInlineSpellStatus> mStatus;
+  TimeStamp mDeadline;
+  nsCOMPtr<nsITimer> mTimer;
 };
 
 // Used as the nsIEditorSpellCheck::InitSpellChecker callback.
@@ -1193,7 +1230,8 @@ nsresult mozInlineSpellChecker::DoSpellCheckSelection(
     // were cleared above. We also need to clear the word count so that we
     // check all words instead of stopping early.
     status->mRange = ranges[idx];
-    rv = DoSpellCheck(aWordUtil, aSpellCheckSelection, status, &doneChecking);
+    rv = DoSpellCheck(aWordUtil, aSpellCheckSelection, status, TimeStamp(),
+                      &doneChecking);
     NS_ENSURE_SUCCESS(rv, rv);
     MOZ_ASSERT(
         doneChecking,
@@ -1236,7 +1274,8 @@ nsresult mozInlineSpellChecker::DoSpellCheckSelection(
 
 nsresult mozInlineSpellChecker::DoSpellCheck(
     mozInlineSpellWordUtil& aWordUtil, Selection* aSpellCheckSelection,
-    const UniquePtr<mozInlineSpellStatus>& aStatus, bool* aDoneChecking) {
+    const UniquePtr<mozInlineSpellStatus>& aStatus,
+    const TimeStamp& aDeadline, bool* aDoneChecking) {
   *aDoneChecking = true;
 
   if (NS_WARN_IF(!mSpellCheck)) {
@@ -1294,7 +1333,14 @@ nsresult mozInlineSpellChecker::DoSpellCheck(
   }
 
   int32_t wordsChecked = 0;
-  PRTime beginTime = PR_Now();
+  // Size this slice to the idle period we're running in when the idle queue
+  // told us its deadline; otherwise (a timed-out resumption, or a
+  // synchronous check) fall back to the fixed time budget.
+  TimeStamp sliceEnd = TimeStamp::Now() + TimeDuration::FromMilliseconds(
+                                              INLINESPELL_CHECK_TIMEOUT);
+  if (!aDeadline.IsNull() && aDeadline > sliceEnd) {
+    sliceEnd = aDeadline;
+  }
 
   nsTArray<nsString> words;
   nsTArray<NodeOffsetRange> checkRanges;
@@ -1315,7 +1361,7 @@ nsresult mozInlineSpellChecker::DoSpellCheck(
 
     // see if we've done enough words in this round and run out of time.
     if (wordsChecked >= INLINESPELL_MINIMUM_WORDS_BEFORE_TIMEOUT &&
-        PR_Now() > PRTime(beginTime + kMaxSpellCheckTimeInUsec)) {
+        TimeStamp::Now() > sliceEnd) {
 // stop checking, our time limit has been exceeded.
 #ifdef DEBUG_INLINESPELL
       printf("We have run out of the time, schedule next round.\n");
@@ -1481,7 +1527,7 @@ void mozInlineSpellChecker::CheckCurrentWordsNoSuggest(
 //    the last resume left off.
 
 nsresult mozInlineSpellChecker::ResumeCheck(
-    UniquePtr<mozInlineSpellStatus>&& aStatus) {
+    UniquePtr<mozInlineSpellStatus>&& aStatus, const TimeStamp& aDeadline) {
   // Observers should be notified that spell check has ended only after spell
   // check is done below, but since there are many early returns in this method
   // and the number of pending spell checks must be decremented regardless of
@@ -1536,7 +1582,8 @@ nsresult mozInlineSpellChecker::ResumeCheck(
   if (aStatus->mOp == mozInlineSpellStatus::eOpSelection)
     rv = DoSpellCheckSelection(wordUtil, spellCheckSelection);
   else
-    rv = DoSpellCheck(wordUtil, spellCheckSelection, aStatus, &doneChecking);
+    rv = DoSpellCheck(wordUtil, spellCheckSelection, aStatus, aDeadline,
+                      &doneChecking);
   NS_ENSURE_SUCCESS(rv, rv);
 
   if (!doneChecking) rv = ScheduleSpellCheck(std::move(aStatus));
@@ -6,6 +6,7 @@
 #ifndef mozilla_mozInlineSpellChecker_h
 #define mozilla_mozInlineSpellChecker_h
 
+#include "mozilla/TimeStamp.h"
 #include "nsCycleCollectionParticipant.h"
 #include "nsIDOMEventListener.h"
 #include "nsIEditorSpellCheck.h"
@@ -206,9 +207,13 @@ class mozInlineSpellChecker final : public nsIInlineSpellChecker,
 
   nsresult DoSpellCheckSelection(mozInlineSpellWordUtil& aWordUtil,
                                  mozilla::dom::Selection* aSpellCheckSelection);
+  // aDeadline is the end of the idle period this check runs in, or a null
+  // TimeStamp when no idle deadline is known; in that case a fixed time
+  // budget is used instead.
   nsresult DoSpellCheck(mozInlineSpellWordUtil& aWordUtil,
                         mozilla::dom::Selection* aSpellCheckSelection,
                         const mozilla::UniquePtr<mozInlineSpellStatus>& aStatus,
+                        const mozilla::TimeStamp& aDeadline,
                         bool* aDoneChecking);
 
   // helper routine to determine if a point is inside of the passed in
@@ -245,7 +250,8 @@ class mozInlineSpellChecker final : public nsIInlineSpellChecker,
   already_AddRefed<mozilla::dom::Selection> GetSpellCheckSelection();
   nsresult SaveCurrentSelectionPosition();
 
-  nsresult ResumeCheck(mozilla::UniquePtr<mozInlineSpellStatus>&& aStatus);
+  nsresult ResumeCheck(mozilla::UniquePtr<mozInlineSpellStatus>&& aStatus,
+                       const mozilla::TimeStamp& aDeadline);
 
   // Those methods are called when mTextEditor splits a node or joins the
   // given nodes.
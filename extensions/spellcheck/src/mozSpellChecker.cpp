@@ -23,6 +23,10 @@ using mozilla::dom::ContentChild;
 
 #define DEFAULT_SPELL_CHECKER "@mozilla.org/spellchecker/engine;1"
 
+// Limit the number of entries kept in the checked-word cache so that
+// pathological documents can't make it grow without bound.
+static const uint32_t kMaxCheckedWordCacheCount = 4096;
+
 NS_IMPL_CYCLE_COLLECTION(mozSpellChecker, mTextServicesDocument,
                          mPersonalDictionary)
 
@@ -116,7 +120,53 @@ nsresult mozSpellChecker::NextMisspelledWord(nsAString& aWord,
 RefPtr<CheckWordPromise> mozSpellChecker::CheckWords(
     const nsTArray<nsString>& aWords) {
   if (XRE_IsContentProcess()) {
-    return mEngine->CheckWords(aWords);
+    // Only round-trip the words we haven't seen with the current dictionary
+    // setup to the parent process.  Prose repeats most of its words, so the
+    // cache typically answers the bulk of a request.
+    nsTArray<nsString> uncheckedWords;
+    for (auto& word : aWords) {
+      if (!mCheckedWordCache.Contains(word)) {
+        uncheckedWords.AppendElement(word);
+      }
+    }
+
+    if (uncheckedWords.IsEmpty()) {
+      nsTArray<bool> misspells;
+      misspells.SetCapacity(aWords.Length());
+      for (auto& word : aWords) {
+        misspells.AppendElement(mCheckedWordCache.Get(word));
+      }
+      return CheckWordPromise::CreateAndResolve(std::move(misspells), __func__);
+    }
+
+    RefPtr<mozSpellChecker> self = this;
+    nsTArray<nsString> words(aWords);
+    return mEngine->CheckWords(uncheckedWords)
+        ->Then(
+            mozilla::GetMainThreadSerialEventTarget(), __func__,
+            [self, words = std::move(words),
+             uncheckedWords =
+                 std::move(uncheckedWords)](const nsTArray<bool>& aMisspells) {
+              for (size_t i = 0;
+                   i < uncheckedWords.Length() && i < aMisspells.Length();
+                   i++) {
+                self->RememberCheckedWord(uncheckedWords[i], aMisspells[i]);
+              }
+              // If the cache was invalidated while the request was in flight,
+              // any entry dropped in the meantime reports as well spelled
+              // here; the dictionary change that cleared the cache triggers a
+              // recheck anyway.
+              nsTArray<bool> misspells;
+              misspells.SetCapacity(words.Length());
+              for (auto& word : words) {
+                misspells.AppendElement(self->mCheckedWordCache.Get(word));
+              }
+              return CheckWordPromise::CreateAndResolve(std::move(misspells),
+                                                        __func__);
+            },
+            [](nsresult aRv) {
+              return CheckWordPromise::CreateAndReject(aRv, __func__);
+            });
   }
 
   nsTArray<bool> misspells;
@@ -132,6 +182,14 @@ RefPtr<CheckWordPromise> mozSpellChecker::CheckWords(
   return CheckWordPromise::CreateAndResolve(std::move(misspells), __func__);
 }
 
+void mozSpellChecker::RememberCheckedWord(const nsAString& aWord,
+                                          bool aIsMisspelled) {
+  if (mCheckedWordCache.Count() >= kMaxCheckedWordCacheCount) {
+    mCheckedWordCache.Clear();
+  }
+  mCheckedWordCache.Put(aWord, aIsMisspelled);
+}
+
 nsresult mozSpellChecker::CheckWord(const nsAString& aWord, bool* aIsMisspelled,
                                     nsTArray<nsString>* aSuggestions) {
   nsresult result;
@@ -261,6 +319,7 @@ nsresult mozSpellChecker::Replace(const nsAString& aOldWord,
 }
 
 nsresult mozSpellChecker::IgnoreAll(const nsAString& aWord) {
+  mCheckedWordCache.Clear();
   if (mPersonalDictionary) {
     mPersonalDictionary->IgnoreWord(aWord);
   }
@@ -269,6 +328,7 @@ nsresult mozSpellChecker::IgnoreAll(const nsAString& aWord) {
 
 nsresult mozSpellChecker::AddWordToPersonalDictionary(const nsAString& aWord) {
   nsresult res;
+  mCheckedWordCache.Clear();
   if (NS_WARN_IF(!mPersonalDictionary)) {
     return NS_ERROR_NOT_INITIALIZED;
   }
@@ -279,6 +339,7 @@ nsresult mozSpellChecker::AddWordToPersonalDictionary(const nsAString& aWord) {
 nsresult mozSpellChecker::RemoveWordFromPersonalDictionary(
     const nsAString& aWord) {
   nsresult res;
+  mCheckedWordCache.Clear();
   if (NS_WARN_IF(!mPersonalDictionary)) {
     return NS_ERROR_NOT_INITIALIZED;
   }
@@ -352,6 +413,8 @@ nsresult mozSpellChecker::GetCurrentDictionary(nsAString& aDictionary) {
 }
 
 nsresult mozSpellChecker::SetCurrentDictionary(const nsAString& aDictionary) {
+  mCheckedWordCache.Clear();
+
   if (XRE_IsContentProcess()) {
     nsString wrappedDict = nsString(aDictionary);
     bool isSuccess;
@@ -411,6 +474,7 @@ RefPtr<GenericPromise> mozSpellChecker::SetCurrentDictionaryFromList(
 
   if (XRE_IsContentProcess()) {
     // mCurrentDictionary will be set by RemoteSpellCheckEngineChild
+    mCheckedWordCache.Clear();
     return mEngine->SetCurrentDictionaryFromList(aList);
   }
 
@@ -13,6 +13,7 @@
 #include "mozIPersonalDictionary.h"
 #include "mozISpellCheckingEngine.h"
 #include "nsClassHashtable.h"
+#include "nsDataHashtable.h"
 #include "nsTArray.h"
 #include "nsCycleCollectionParticipant.h"
 
@@ -164,6 +165,14 @@ class mozSpellChecker final {
 
   nsString mCurrentDictionary;
 
+  // Caches the result of words checked with the current dictionary setup so
+  // that repeated words don't have to be checked again, which in a content
+  // process means a round trip to the parent process.  The cache is dropped
+  // whenever the current dictionary or the personal dictionary changes.
+  nsDataHashtable<nsStringHashKey, bool> mCheckedWordCache;
+
+  void RememberCheckedWord(const nsAString& aWord, bool aIsMisspelled);
+
   MOZ_CAN_RUN_SCRIPT
   nsresult SetupDoc(int32_t* outBlockOffset);
 
@@ -167,7 +167,61 @@ void DrawTargetCaptureImpl::DrawFilter(FilterNode* aNode,
   AppendCommand(DrawFilterCommand)(aNode, aSourceRect, aDestPoint, aOptions);
 }
 
+bool DrawTargetCaptureImpl::CoversEntireSurface(const Rect& aRect) const {
+  if (!mPushedLayers.empty() || mCurrentClipBounds.size() > 1) {
+    return false;
+  }
+  if (!mTransform.IsRectilinear()) {
+    return false;
+  }
+  return mTransform.TransformBounds(aRect).Contains(
+      Rect(0, 0, Float(mSize.width), Float(mSize.height)));
+}
+
+bool DrawTargetCaptureImpl::IsCompleteOverwrite(
+    const Rect& aRect, const Pattern& aPattern,
+    const DrawOptions& aOptions) const {
+  if (aOptions.mAlpha != 1.0f) {
+    return false;
+  }
+  if (aOptions.mCompositionOp == CompositionOp::OP_OVER) {
+    // OP_OVER only overwrites the destination if the source is opaque.
+    if (aPattern.GetType() != PatternType::COLOR ||
+        static_cast<const ColorPattern&>(aPattern).mColor.a != 1.0f) {
+      return false;
+    }
+  } else if (aOptions.mCompositionOp != CompositionOp::OP_SOURCE) {
+    return false;
+  }
+  return CoversEntireSurface(aRect);
+}
+
+void DrawTargetCaptureImpl::PruneCapturedCommands() {
+  if (mCommands.IsEmpty()) {
+    return;
+  }
+
+  // Give any outstanding snapshot its chance to resolve the dropped commands
+  // first.
+  MarkChanged();
+  mCommands.Clear();
+
+  // Replaying starts over from the target's initial state, so re-record the
+  // state the dropped commands would have left behind.
+  AppendCommand(SetPermitSubpixelAACommand)(GetPermitSubpixelAA());
+  if (!mTransform.IsIdentity()) {
+    AppendCommand(SetTransformCommand)(mTransform);
+  }
+}
+
 void DrawTargetCaptureImpl::ClearRect(const Rect& aRect) {
+  // Canvas-style users clear or overdraw the whole surface at the start of
+  // every frame; anything captured before that can never be observed, so
+  // drop it rather than replaying it.
+  if (CoversEntireSurface(aRect)) {
+    PruneCapturedCommands();
+  }
+
   AppendCommand(ClearRectCommand)(aRect);
 }
 
@@ -192,6 +246,12 @@ void DrawTargetCaptureImpl::CopyRect(const IntRect& aSourceRect,
 
 void DrawTargetCaptureImpl::FillRect(const Rect& aRect, const Pattern& aPattern,
                                      const DrawOptions& aOptions) {
+  // See the note in ClearRect: a fill that overwrites every pixel makes all
+  // previously captured commands unobservable.
+  if (IsCompleteOverwrite(aRect, aPattern, aOptions)) {
+    PruneCapturedCommands();
+  }
+
   AppendCommand(FillRectCommand)(aRect, aPattern, aOptions);
 }
 
@@ -144,6 +144,19 @@ class DrawTargetCaptureImpl final : public DrawTargetCapture {
 
   void MarkChanged();
 
+  // Returns true if aRect, in user space, covers every pixel of the surface
+  // with no clips or layers in effect.
+  bool CoversEntireSurface(const Rect& aRect) const;
+
+  // Returns true if filling aRect with aPattern overwrites every pixel of
+  // the surface, making all previously captured commands unobservable.
+  bool IsCompleteOverwrite(const Rect& aRect, const Pattern& aPattern,
+                           const DrawOptions& aOptions) const;
+
+  // Drop all captured commands and re-record the current state. Only valid
+  // when the next captured command obscures the entire surface.
+  void PruneCapturedCommands();
+
  private:
   void FlushCommandBuffer() {
     ReplayToDrawTarget(mRefDT, Matrix());
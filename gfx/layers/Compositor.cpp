@@ -25,8 +25,9 @@ namespace layers {
 class CompositorRecordedFrame final : public RecordedFrame {
  public:
   CompositorRecordedFrame(const TimeStamp& aTimeStamp,
-                          RefPtr<AsyncReadbackBuffer>&& aBuffer)
-      : RecordedFrame(aTimeStamp), mBuffer(aBuffer) {}
+                          RefPtr<AsyncReadbackBuffer>&& aBuffer,
+                          Compositor* aCompositor)
+      : RecordedFrame(aTimeStamp), mCompositor(aCompositor), mBuffer(aBuffer) {}
 
   virtual already_AddRefed<gfx::DataSourceSurface> GetSourceSurface() override {
     if (mSurface) {
@@ -44,10 +45,16 @@ class CompositorRecordedFrame final : public RecordedFrame {
       return nullptr;
     }
 
+    // The surface now owns a copy of the pixels, so the readback buffer can
+    // be recycled for a later frame.
+    mCompositor->ReturnReadbackBuffer(mBuffer);
+    mBuffer = nullptr;
+
     return do_AddRef(mSurface);
   }
 
  private:
+  RefPtr<Compositor> mCompositor;
   RefPtr<AsyncReadbackBuffer> mBuffer;
   RefPtr<gfx::DataSourceSurface> mSurface;
 };
@@ -592,13 +599,45 @@ already_AddRefed<RecordedFrame> Compositor::RecordFrame(
   }
 
   RefPtr<AsyncReadbackBuffer> buffer =
-      CreateAsyncReadbackBuffer(renderTarget->GetSize());
+      TakeReadbackBuffer(renderTarget->GetSize());
+  if (!buffer) {
+    return nullptr;
+  }
 
   if (!ReadbackRenderTarget(renderTarget, buffer)) {
     return nullptr;
   }
 
-  return MakeAndAddRef<CompositorRecordedFrame>(aTimeStamp, std::move(buffer));
+  return MakeAndAddRef<CompositorRecordedFrame>(aTimeStamp, std::move(buffer),
+                                                this);
+}
+
+// RecordFrame runs on every composite while recording is active, and
+// window-sized readback buffers are expensive to create, so a small pool of
+// them is kept for reuse once their frames have been consumed.
+static const size_t kMaxPooledReadbackBuffers = 2;
+
+already_AddRefed<AsyncReadbackBuffer> Compositor::TakeReadbackBuffer(
+    const gfx::IntSize& aSize) {
+  for (size_t i = 0; i < mAvailableReadbackBuffers.Length(); i++) {
+    if (mAvailableReadbackBuffers[i]->GetSize() == aSize) {
+      RefPtr<AsyncReadbackBuffer> buffer = mAvailableReadbackBuffers[i];
+      mAvailableReadbackBuffers.RemoveElementAt(i);
+      return buffer.forget();
+    }
+  }
+  // Any pooled buffers of a stale size (e.g. after a window resize) are of no
+  // further use; don't let them pin their memory.
+  mAvailableReadbackBuffers.Clear();
+  return CreateAsyncReadbackBuffer(aSize);
+}
+
+void Compositor::ReturnReadbackBuffer(AsyncReadbackBuffer* aBuffer) {
+  if (IsDestroyed() ||
+      mAvailableReadbackBuffers.Length() >= kMaxPooledReadbackBuffers) {
+    return;
+  }
+  mAvailableReadbackBuffers.AppendElement(aBuffer);
 }
 
 bool Compositor::ShouldRecordFrames() const {
@@ -611,6 +611,14 @@ class Compositor : public TextureSourceProvider {
    */
   already_AddRefed<RecordedFrame> RecordFrame(const TimeStamp& aTimeStamp);
 
+  /**
+   * Return a readback buffer handed out by |RecordFrame| to the pool, so
+   * that a later recorded frame can reuse it. Called by the recorded frame
+   * once its contents have been copied out. Must be used on the compositor
+   * thread.
+   */
+  void ReturnReadbackBuffer(AsyncReadbackBuffer* aBuffer);
+
  protected:
   void DrawDiagnosticsInternal(DiagnosticFlags aFlags,
                                const gfx::Rect& aVisibleRect,
@@ -694,6 +702,17 @@ class Compositor : public TextureSourceProvider {
   bool mRecordFrames = false;
 
  private:
+  /**
+   * Take a readback buffer of the given size from the pool, or create one if
+   * the pool has none of that size. Used by |RecordFrame|.
+   */
+  already_AddRefed<AsyncReadbackBuffer> TakeReadbackBuffer(
+      const gfx::IntSize& aSize);
+
+  // Readback buffers that |RecordFrame| may reuse, returned to us by
+  // consumed recorded frames.
+  nsTArray<RefPtr<AsyncReadbackBuffer>> mAvailableReadbackBuffers;
+
   static LayersBackend sBackend;
 };
 
@@ -1045,6 +1045,35 @@ static nsTArray<LayerPolygon> SortLayersWithBSPTree(nsTArray<Layer*>& aArray) {
   return orderedLayers;
 }
 
+nsTArray<LayerPolygon> ContainerLayer::SortLeavesBy3DZOrder(
+    nsTArray<Layer*>& aLeaves) {
+  nsTArray<Leaf3DGeometry> currentLeaves(aLeaves.Length());
+
+  for (Layer* layer : aLeaves) {
+    currentLeaves.AppendElement(Leaf3DGeometry{
+        layer, layer->GetEffectiveTransform(),
+        layer->GetLocalVisibleRegion().GetBounds().ToUnknownRect()});
+  }
+
+  // If the leaves and their screen space geometry have not changed since the
+  // previous sort, the cached draw order is still valid and the BSP tree does
+  // not have to be rebuilt.
+  if (!mCached3DContextDrawOrder.IsEmpty() &&
+      mCached3DContextLeaves == currentLeaves) {
+    nsTArray<LayerPolygon> drawOrder(mCached3DContextDrawOrder.Length());
+    drawOrder.AppendElements(mCached3DContextDrawOrder);
+    return drawOrder;
+  }
+
+  nsTArray<LayerPolygon> drawOrder = SortLayersWithBSPTree(aLeaves);
+
+  mCached3DContextLeaves = std::move(currentLeaves);
+  mCached3DContextDrawOrder.ClearAndRetainStorage();
+  mCached3DContextDrawOrder.AppendElements(drawOrder);
+
+  return drawOrder;
+}
+
 static nsTArray<LayerPolygon> StripLayerGeometry(
     const nsTArray<LayerPolygon>& aLayers) {
   nsTArray<LayerPolygon> layers;
@@ -1077,7 +1106,7 @@ nsTArray<LayerPolygon> ContainerLayer::SortChildrenBy3DZOrder(
 
       // Sort the 3D layers.
       if (toSort.Length() > 0) {
-        nsTArray<LayerPolygon> sorted = SortLayersWithBSPTree(toSort);
+        nsTArray<LayerPolygon> sorted = container->SortLeavesBy3DZOrder(toSort);
         drawOrder.AppendElements(std::move(sorted));
 
         toSort.ClearAndRetainStorage();
@@ -2276,6 +2276,14 @@ class ContainerLayer : public Layer {
 
   nsTArray<LayerPolygon> SortChildrenBy3DZOrder(SortMode aSortMode);
 
+  /**
+   * Sorts the given 3D context leaves into back-to-front draw order with a
+   * BSP tree. The result of the previous sort is reused if the leaves and
+   * their screen space geometry have not changed since then, since building
+   * the tree is the expensive part of sorting complex 3D scenes.
+   */
+  nsTArray<LayerPolygon> SortLeavesBy3DZOrder(nsTArray<Layer*>& aLeaves);
+
   ContainerLayer* AsContainerLayer() override { return this; }
   const ContainerLayer* AsContainerLayer() const override { return this; }
 
@@ -2415,6 +2423,28 @@ class ContainerLayer : public Layer {
    */
   bool Creates3DContextWithExtendingChildren();
 
+  /**
+   * Screen space geometry of a 3D context leaf at the time of the previous
+   * BSP sort, used by SortLeavesBy3DZOrder to decide whether the cached
+   * draw order is still valid.
+   */
+  struct Leaf3DGeometry {
+    Layer* mLayer;
+    gfx::Matrix4x4 mTransform;
+    gfx::IntRect mBounds;
+
+    bool operator==(const Leaf3DGeometry& aOther) const {
+      return mLayer == aOther.mLayer && mTransform == aOther.mTransform &&
+             mBounds == aOther.mBounds;
+    }
+  };
+
+  // The draw order of 3D context leaves depends only on their screen space
+  // polygons, so the previous BSP sort result can be replayed while the
+  // leaves and their geometry stay the same.
+  nsTArray<Leaf3DGeometry> mCached3DContextLeaves;
+  nsTArray<LayerPolygon> mCached3DContextDrawOrder;
+
   Layer* mFirstChild;
   Layer* mLastChild;
   float mPreXScale;
@@ -193,6 +193,10 @@ void PaintThread::QueuePaintTask(UniquePtr<PaintTask>&& aTask) {
   RefPtr<CompositorBridgeChild> cbc(CompositorBridgeChild::Get());
   cbc->NotifyBeginAsyncPaint(aTask.get());
 
+  if (mPaintWorkers && QueueSubdividedPaintTask(cbc, aTask)) {
+    return;
+  }
+
   RefPtr<PaintThread> self = this;
   RefPtr<Runnable> task =
       NS_NewRunnableFunction("PaintThread::AsyncPaintTask",
@@ -211,6 +215,114 @@ void PaintThread::QueuePaintTask(UniquePtr<PaintTask>&& aTask) {
 #endif
 }
 
+bool PaintThread::QueueSubdividedPaintTask(CompositorBridgeChild* aBridge,
+                                           UniquePtr<PaintTask>& aTask) {
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(mPaintWorkers);
+
+  if (!StaticPrefs::layers_omtp_subdivide_replay()) {
+    return false;
+  }
+
+  // Strips shorter than this rasterize too quickly for the dispatch
+  // overhead to pay off.
+  static const int32_t kMinStripHeight = 256;
+
+  gfx::DrawTarget* target = aTask->mTarget;
+  if (!target->IsValid()) {
+    return false;
+  }
+
+  int32_t stripCount = std::min(
+      PaintThread::CalculatePaintWorkerCount(),
+      std::max(target->GetSize().height / kMinStripHeight, 1));
+  if (stripCount < 2) {
+    return false;
+  }
+
+  // Only data draw targets can be split into strips, as each strip aliases
+  // a range of rows of the backing pixel data.
+  uint8_t* data = nullptr;
+  IntSize size;
+  int32_t stride = 0;
+  SurfaceFormat format = SurfaceFormat::UNKNOWN;
+  IntPoint origin;
+  if (!target->LockBits(&data, &size, &stride, &format, &origin)) {
+    return false;
+  }
+  if (origin != IntPoint()) {
+    target->ReleaseBits(data);
+    return false;
+  }
+
+  int32_t stripHeight = (size.height + stripCount - 1) / stripCount;
+  RefPtr<PaintTaskSubdivision> subdivision = new PaintTaskSubdivision(
+      std::move(aTask), data, size, stride, format, stripHeight);
+
+  RefPtr<PaintThread> self = this;
+  RefPtr<CompositorBridgeChild> cbc = aBridge;
+
+  for (int32_t i = 0; i < subdivision->StripCount(); i++) {
+    RefPtr<Runnable> task = NS_NewRunnableFunction(
+        "PaintThread::AsyncPaintStrip", [self, cbc, subdivision, i]() -> void {
+          self->AsyncPaintStrip(cbc, subdivision.get(), i);
+        });
+
+#ifndef OMTP_FORCE_SYNC
+    mPaintWorkers->Dispatch(task.forget());
+#else
+    SyncRunnable::DispatchToThread(mPaintWorkers, task);
+#endif
+  }
+
+  return true;
+}
+
+void PaintThread::AsyncPaintStrip(CompositorBridgeChild* aBridge,
+                                  PaintTaskSubdivision* aSubdivision,
+                                  int32_t aIndex) {
+  AUTO_PROFILER_LABEL("PaintThread::AsyncPaintStrip", GRAPHICS);
+
+  MOZ_ASSERT(IsOnPaintWorkerThread());
+  MOZ_ASSERT(aSubdivision);
+
+  PaintTask* task = aSubdivision->mTask.get();
+  const IntRect rect = aSubdivision->StripRect(aIndex);
+
+  RefPtr<gfx::DrawTarget> strip = Factory::CreateDrawTargetForData(
+      BackendType::SKIA,
+      aSubdivision->mData + rect.Y() * aSubdivision->mStride, rect.Size(),
+      aSubdivision->mStride, aSubdivision->mFormat, true);
+  if (strip) {
+    // Replay the full command list offset into the strip. Commands outside
+    // the strip's rows are clipped away by the strip's bounds.
+    strip->DrawCapturedDT(task->mCapture, Matrix::Translation(0, -rect.Y()));
+    strip->Flush();
+  }
+
+  if (--aSubdivision->mRemainingStrips > 0) {
+    return;
+  }
+
+  // This was the last strip of the task to finish.
+  gfx::DrawTarget* target = task->mTarget;
+  target->ReleaseBits(aSubdivision->mData);
+  target->Flush();
+
+  if (StaticPrefs::layers_omtp_release_capture_on_main_thread()) {
+    // This should ensure the capture drawtarget, which may hold on to
+    // UnscaledFont objects, gets destroyed on the main thread (See bug
+    // 1404742). This assumes (unflushed) target DrawTargets do not themselves
+    // hold on to UnscaledFonts.
+    NS_ReleaseOnMainThreadSystemGroup("PaintTask::DrawTargetCapture",
+                                      task->mCapture.forget());
+  }
+
+  if (aBridge->NotifyFinishedAsyncWorkerPaint(task)) {
+    AsyncEndLayerTransaction(aBridge);
+  }
+}
+
 void PaintThread::AsyncPaintTask(CompositorBridgeChild* aBridge,
                                  PaintTask* aTask) {
   AUTO_PROFILER_LABEL("PaintThread::AsyncPaintTask", GRAPHICS);
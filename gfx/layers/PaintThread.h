@@ -7,7 +7,10 @@
 #ifndef MOZILLA_LAYERS_PAINTTHREAD_H
 #define MOZILLA_LAYERS_PAINTTHREAD_H
 
+#include <algorithm>
+
 #include "base/platform_thread.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/RefPtr.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/UniquePtr.h"
@@ -45,6 +48,48 @@ class PaintTask {
   AutoTArray<RefPtr<TextureClient>, 4> mClients;
 };
 
+// Tracks the strip replays of a paint task whose capture is rasterized in
+// parallel on the paint worker pool. Each strip replays the capture into a
+// disjoint range of rows of the destination's backing data, so the strips
+// can be painted concurrently. The last strip to finish completes the task.
+class PaintTaskSubdivision {
+  NS_INLINE_DECL_THREADSAFE_REFCOUNTING(PaintTaskSubdivision)
+
+ public:
+  PaintTaskSubdivision(UniquePtr<PaintTask>&& aTask, uint8_t* aData,
+                       const gfx::IntSize& aSize, int32_t aStride,
+                       gfx::SurfaceFormat aFormat, int32_t aStripHeight)
+      : mTask(std::move(aTask)),
+        mData(aData),
+        mSize(aSize),
+        mStride(aStride),
+        mFormat(aFormat),
+        mStripHeight(aStripHeight),
+        mRemainingStrips(StripCount()) {}
+
+  int32_t StripCount() const {
+    return (mSize.height + mStripHeight - 1) / mStripHeight;
+  }
+
+  // Returns the destination rows covered by strip aIndex.
+  gfx::IntRect StripRect(int32_t aIndex) const {
+    int32_t y = aIndex * mStripHeight;
+    return gfx::IntRect(0, y, mSize.width,
+                        std::min(mStripHeight, mSize.height - y));
+  }
+
+  UniquePtr<PaintTask> mTask;
+  uint8_t* mData;
+  gfx::IntSize mSize;
+  int32_t mStride;
+  gfx::SurfaceFormat mFormat;
+  int32_t mStripHeight;
+  Atomic<int32_t> mRemainingStrips;
+
+ private:
+  ~PaintTaskSubdivision() = default;
+};
+
 class CompositorBridgeChild;
 
 class PaintThread final {
@@ -96,7 +141,16 @@ class PaintThread final {
   void InitOnPaintThread();
   void InitPaintWorkers();
 
+  // Must be called on the main thread. If the task's destination exposes
+  // its backing data and is tall enough to benefit, queues one strip replay
+  // per paint worker and returns true. Returns false when the task cannot
+  // be subdivided, in which case the caller queues a single replay.
+  bool QueueSubdividedPaintTask(CompositorBridgeChild* aBridge,
+                                UniquePtr<PaintTask>& aTask);
+
   void AsyncPaintTask(CompositorBridgeChild* aBridge, PaintTask* aTask);
+  void AsyncPaintStrip(CompositorBridgeChild* aBridge,
+                       PaintTaskSubdivision* aSubdivision, int32_t aIndex);
   void AsyncEndLayerTransaction(CompositorBridgeChild* aBridge);
 
   static StaticAutoPtr<PaintThread> sSingleton;
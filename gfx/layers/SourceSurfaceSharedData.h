@@ -8,6 +8,7 @@
 #define MOZILLA_GFX_SOURCESURFACESHAREDDATA_H_
 
 #include "mozilla/gfx/2D.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/Mutex.h"
 #include "mozilla/ipc/SharedMemoryBasic.h"
 
@@ -41,6 +42,7 @@ class SourceSurfaceSharedDataWrapper final : public DataSourceSurface {
   SourceSurfaceSharedDataWrapper()
       : mStride(0),
         mConsumers(0),
+        mContentHash(0),
         mFormat(SurfaceFormat::UNKNOWN),
         mCreatorPid(0),
         mCreatorRef(true) {}
@@ -82,6 +84,20 @@ class SourceSurfaceSharedDataWrapper final : public DataSourceSurface {
     return mConsumers;
   }
 
+  /**
+   * Returns a hash of the surface contents, computed lazily and cached. This
+   * is used by memory reporting to estimate how many identical surfaces the
+   * compositor has mapped from different processes. Note that the hash is a
+   * snapshot; the creator may still be writing to the buffer if decoding has
+   * not finished, so this must only be used for diagnostics.
+   */
+  uint32_t GetContentHash() {
+    if (mContentHash == 0) {
+      mContentHash = HashBytes(GetData(), GetDataLength());
+    }
+    return mContentHash;
+  }
+
   bool HasCreatorRef() const { return mCreatorRef; }
 
  private:
@@ -95,6 +111,7 @@ class SourceSurfaceSharedDataWrapper final : public DataSourceSurface {
 
   int32_t mStride;
   uint32_t mConsumers;
+  uint32_t mContentHash;
   IntSize mSize;
   RefPtr<SharedMemoryBasic> mBuf;
   SurfaceFormat mFormat;
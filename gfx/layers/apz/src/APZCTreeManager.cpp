@@ -40,6 +40,7 @@
 #include "mozilla/StaticPrefs_accessibility.h"
 #include "mozilla/StaticPrefs_apz.h"
 #include "mozilla/StaticPrefs_layout.h"
+#include "mozilla/Telemetry.h"  // for Telemetry::Accumulate
 #include "mozilla/TouchEvents.h"
 #include "mozilla/EventStateManager.h"  // for WheelPrefs
 #include "mozilla/webrender/WebRenderAPI.h"
@@ -608,6 +609,11 @@ APZCTreeManager::UpdateHitTestingTreeImpl(const ScrollNode& aRoot,
   // We do not support tree structures where the root node has siblings.
   MOZ_ASSERT(!(mRootNode && mRootNode->GetPrevSibling()));
 
+  // The tree structure is final at this point (the nodes remaining in
+  // state.mNodesToDestroy are not part of the new tree), so take a new
+  // flattened snapshot for hit testing.
+  RebuildFlatHitTestTree();
+
   {  // scope lock and update our mApzcMap before we destroy all the unused
     // APZC instances
     MutexAutoLock lock(mMapLock);
@@ -2473,6 +2479,7 @@ void APZCTreeManager::ClearTree() {
     nodesToDestroy[i]->Destroy();
   }
   mRootNode = nullptr;
+  RebuildFlatHitTestTree();
 
   RefPtr<APZCTreeManager> self(this);
   NS_DispatchToMainThread(
@@ -2721,10 +2728,14 @@ APZCTreeManager::HitTestResult APZCTreeManager::GetTargetAPZC(
     const ScreenPoint& aPoint) {
   RecursiveMutexAutoLock lock(mTreeLock);
 
-  if (gfx::gfxVars::UseWebRender()) {
-    return GetAPZCAtPointWR(aPoint, lock);
-  }
-  return GetAPZCAtPoint(aPoint, lock);
+  TimeStamp start = TimeStamp::Now();
+  HitTestResult hit = gfx::gfxVars::UseWebRender()
+                          ? GetAPZCAtPointWR(aPoint, lock)
+                          : GetAPZCAtPoint(aPoint, lock);
+  Telemetry::Accumulate(
+      Telemetry::APZ_HIT_TEST_TIME_US,
+      uint32_t((TimeStamp::Now() - start).ToMicroseconds()));
+  return hit;
 }
 
 APZCTreeManager::HitTestResult APZCTreeManager::GetAPZCAtPointWR(
@@ -2910,60 +2921,105 @@ AsyncPanZoomController* APZCTreeManager::GetTargetApzcForNode(
   return nullptr;
 }
 
+/* static */
+void APZCTreeManager::AppendToFlatHitTestTree(
+    HitTestingTreeNode* aNode, nsTArray<FlatHitTestEntry>& aTree) {
+  size_t index = aTree.Length();
+  aTree.AppendElement(FlatHitTestEntry{aNode, 0});
+  for (HitTestingTreeNode* child = aNode->GetLastChild(); child;
+       child = child->GetPrevSibling()) {
+    AppendToFlatHitTestTree(child, aTree);
+  }
+  aTree[index].mSubtreeEnd = aTree.Length();
+}
+
+void APZCTreeManager::RebuildFlatHitTestTree() {
+  mTreeLock.AssertCurrentThreadIn();
+
+  mFlatHitTestTree.ClearAndRetainStorage();
+  if (mRootNode) {
+    AppendToFlatHitTestTree(mRootNode.get(), mFlatHitTestTree);
+  }
+}
+
 APZCTreeManager::HitTestResult APZCTreeManager::GetAPZCAtPoint(
     const ScreenPoint& aHitTestPoint,
     const RecursiveMutexAutoLock& aProofOfTreeLock) {
   HitTestResult hit;
-  // This walks the tree in depth-first, reverse order, so that it encounters
-  // APZCs front-to-back on the screen.
-  HitTestingTreeNode* resultNode;
-  HitTestingTreeNode* root = mRootNode;
+  // This walks mFlatHitTestTree, which stores the tree in depth-first,
+  // reverse pre-order, so that it encounters APZCs front-to-back on the
+  // screen. A node is hit-tested once all of the entries of its subtree have
+  // been visited, because deeper nodes are more "in front". The nodes are
+  // still consulted for their clips, transforms and event regions, but the
+  // traversal itself only touches the flat array.
+  HitTestingTreeNode* resultNode = nullptr;
   HitTestingTreeNode* scrollbarNode = nullptr;
-  std::stack<LayerPoint> hitTestPoints;
   ParentLayerPoint point = ViewAs<ParentLayerPixel>(
       aHitTestPoint, PixelCastJustification::ScreenIsParentLayerForRoot);
-  hitTestPoints.push(
-      ViewAs<LayerPixel>(point, PixelCastJustification::MovingDownToChildren));
-
-  ForEachNode<ReverseIterator>(
-      root,
-      [&hitTestPoints, this](HitTestingTreeNode* aNode) {
-        ParentLayerPoint hitTestPointForParent = ViewAs<ParentLayerPixel>(
-            hitTestPoints.top(), PixelCastJustification::MovingDownToChildren);
-        if (aNode->IsOutsideClip(hitTestPointForParent)) {
-          // If the point being tested is outside the clip region for this node
-          // then we don't need to test against this node or any of its
-          // children. Just skip it and move on.
-          APZCTM_LOG("Point %f %f outside clip for node %p\n",
-                     hitTestPoints.top().x, hitTestPoints.top().y, aNode);
-          return TraversalFlag::Skip;
-        }
-        // First check the subtree rooted at this node, because deeper nodes
-        // are more "in front".
-        Maybe<LayerPoint> hitTestPoint = aNode->Untransform(
-            hitTestPointForParent, ComputeTransformForNode(aNode));
-        APZCTM_LOG(
-            "Transformed ParentLayer point %s to layer %s\n",
-            Stringify(hitTestPointForParent).c_str(),
-            hitTestPoint ? Stringify(hitTestPoint.ref()).c_str() : "nil");
-        if (!hitTestPoint) {
-          return TraversalFlag::Skip;
-        }
-        hitTestPoints.push(hitTestPoint.ref());
-        return TraversalFlag::Continue;
-      },
-      [&resultNode, &hitTestPoints, &hit](HitTestingTreeNode* aNode) {
-        CompositorHitTestInfo hitResult = aNode->HitTest(hitTestPoints.top());
-        hitTestPoints.pop();
-        APZCTM_LOG("Testing Layer point %s against node %p\n",
-                   Stringify(hitTestPoints.top()).c_str(), aNode);
-        if (hitResult != CompositorHitTestInvisibleToHit) {
-          resultNode = aNode;
-          hit.mHitResult = hitResult;
-          return TraversalFlag::Abort;
-        }
-        return TraversalFlag::Continue;
-      });
+
+  // The ancestor chain of the entry at the current index, with the hit test
+  // point untransformed into each ancestor's layer space.
+  struct AncestorEntry {
+    HitTestingTreeNode* mNode;
+    size_t mSubtreeEnd;
+    LayerPoint mHitTestPoint;
+  };
+  AutoTArray<AncestorEntry, 16> ancestors;
+
+  const size_t length = mFlatHitTestTree.Length();
+  size_t i = 0;
+  bool foundHit = false;
+
+  while (!foundHit) {
+    // Hit test any nodes whose subtrees have been fully visited.
+    while (!ancestors.IsEmpty() && i == ancestors.LastElement().mSubtreeEnd) {
+      const AncestorEntry& deepest = ancestors.LastElement();
+      CompositorHitTestInfo hitResult =
+          deepest.mNode->HitTest(deepest.mHitTestPoint);
+      APZCTM_LOG("Testing Layer point %s against node %p\n",
+                 Stringify(deepest.mHitTestPoint).c_str(), deepest.mNode);
+      if (hitResult != CompositorHitTestInvisibleToHit) {
+        resultNode = deepest.mNode;
+        hit.mHitResult = hitResult;
+        foundHit = true;
+        break;
+      }
+      ancestors.RemoveLastElement();
+    }
+    if (foundHit || i >= length) {
+      break;
+    }
+
+    const FlatHitTestEntry& entry = mFlatHitTestTree[i];
+    HitTestingTreeNode* node = entry.mNode;
+    ParentLayerPoint hitTestPointForParent =
+        ancestors.IsEmpty()
+            ? point
+            : ViewAs<ParentLayerPixel>(
+                  ancestors.LastElement().mHitTestPoint,
+                  PixelCastJustification::MovingDownToChildren);
+    if (node->IsOutsideClip(hitTestPointForParent)) {
+      // If the point being tested is outside the clip region for this node
+      // then we don't need to test against this node or any of its
+      // children. Just skip the whole subtree and move on.
+      APZCTM_LOG("Point %f %f outside clip for node %p\n",
+                 hitTestPointForParent.x, hitTestPointForParent.y, node);
+      i = entry.mSubtreeEnd;
+      continue;
+    }
+    Maybe<LayerPoint> hitTestPoint =
+        node->Untransform(hitTestPointForParent, ComputeTransformForNode(node));
+    APZCTM_LOG("Transformed ParentLayer point %s to layer %s\n",
+               Stringify(hitTestPointForParent).c_str(),
+               hitTestPoint ? Stringify(hitTestPoint.ref()).c_str() : "nil");
+    if (!hitTestPoint) {
+      i = entry.mSubtreeEnd;
+      continue;
+    }
+    ancestors.AppendElement(
+        AncestorEntry{node, entry.mSubtreeEnd, hitTestPoint.ref()});
+    i++;
+  }
 
   if (hit.mHitResult != CompositorHitTestInvisibleToHit) {
     MOZ_ASSERT(resultNode);
@@ -640,6 +640,10 @@ class APZCTreeManager : public IAPZCTreeManager, public APZInputBridge {
                                      const ScrollableLayerGuid& aGuid,
                                      GuidComparator aComparator);
   AsyncPanZoomController* GetTargetApzcForNode(HitTestingTreeNode* aNode);
+  // Requires the caller to hold mTreeLock. Rebuilds mFlatHitTestTree from
+  // the tree rooted at mRootNode; must be called whenever the tree
+  // structure changes.
+  void RebuildFlatHitTestTree();
   HitTestResult GetAPZCAtPoint(const ScreenPoint& aHitTestPoint,
                                const RecursiveMutexAutoLock& aProofOfTreeLock);
   HitTestResult GetAPZCAtPointWR(
@@ -777,6 +781,23 @@ class APZCTreeManager : public IAPZCTreeManager, public APZInputBridge {
   mutable mozilla::RecursiveMutex mTreeLock;
   RefPtr<HitTestingTreeNode> mRootNode;
 
+  /* A flattened snapshot of the tree rooted at mRootNode, stored in the
+   * depth-first, reverse pre-order that hit testing visits nodes (so that
+   * front-most subtrees come first). Each entry records the index just past
+   * its subtree, which lets GetAPZCAtPoint() walk or skip whole subtrees
+   * with index arithmetic over a contiguous array instead of chasing node
+   * pointers on every input event. Rebuilt by RebuildFlatHitTestTree()
+   * whenever the tree structure changes, and protected by mTreeLock. The
+   * raw node pointers are kept alive by the tree itself. */
+  struct FlatHitTestEntry {
+    HitTestingTreeNode* mNode;
+    size_t mSubtreeEnd;
+  };
+  nsTArray<FlatHitTestEntry> mFlatHitTestTree;
+
+  static void AppendToFlatHitTestTree(HitTestingTreeNode* aNode,
+                                      nsTArray<FlatHitTestEntry>& aTree);
+
   /*
    * A set of LayersIds for which APZCTM should only send empty
    * MatrixMessages via NotifyLayerTransform().
@@ -28,6 +28,7 @@
 #include "mozilla/layers/ShadowLayers.h"      // for ShadowLayerForwarder
 #include "mozilla/layers/TextureClient.h"     // for TextureClient, etc
 #include "mozilla/layers/TextureClientOGL.h"  // for SurfaceTextureClient
+#include "mozilla/layers/TextureClientRecycleAllocator.h"
 #include "mozilla/mozalloc.h"                 // for operator delete, etc
 #include "nsCOMPtr.h"                         // for already_AddRefed
 #include "nsDebug.h"                          // for NS_WARNING, NS_ASSERTION
@@ -91,7 +92,8 @@ void ImageClientSingle::FlushAllImages() {
 
 /* static */
 already_AddRefed<TextureClient> ImageClient::CreateTextureClientForImage(
-    Image* aImage, KnowsCompositor* aKnowsCompositor) {
+    Image* aImage, KnowsCompositor* aKnowsCompositor,
+    TextureClientRecycleAllocator* aRecycleAllocator) {
   RefPtr<TextureClient> texture;
   if (aImage->GetFormat() == ImageFormat::PLANAR_YCBCR) {
     PlanarYCbCrImage* ycbcr = static_cast<PlanarYCbCrImage*>(aImage);
@@ -99,10 +101,15 @@ already_AddRefed<TextureClient> ImageClient::CreateTextureClientForImage(
     if (!data) {
       return nullptr;
     }
-    texture = TextureClient::CreateForYCbCr(
-        aKnowsCompositor, data->mYSize, data->mYStride, data->mCbCrSize,
-        data->mCbCrStride, data->mStereoMode, data->mColorDepth,
-        data->mYUVColorSpace, data->mColorRange, TextureFlags::DEFAULT);
+    if (aRecycleAllocator) {
+      YCbCrTextureClientAllocationHelper helper(*data, TextureFlags::DEFAULT);
+      texture = aRecycleAllocator->CreateOrRecycle(helper);
+    } else {
+      texture = TextureClient::CreateForYCbCr(
+          aKnowsCompositor, data->mYSize, data->mYStride, data->mCbCrSize,
+          data->mCbCrStride, data->mStereoMode, data->mColorDepth,
+          data->mYUVColorSpace, data->mColorRange, TextureFlags::DEFAULT);
+    }
     if (!texture) {
       return nullptr;
     }
@@ -129,9 +136,15 @@ already_AddRefed<TextureClient> ImageClient::CreateTextureClientForImage(
   } else {
     RefPtr<gfx::SourceSurface> surface = aImage->GetAsSourceSurface();
     MOZ_ASSERT(surface);
-    texture = TextureClient::CreateForDrawing(
-        aKnowsCompositor, surface->GetFormat(), aImage->GetSize(),
-        BackendSelector::Content, TextureFlags::DEFAULT);
+    if (aRecycleAllocator) {
+      texture = aRecycleAllocator->CreateOrRecycle(
+          surface->GetFormat(), aImage->GetSize(), BackendSelector::Content,
+          TextureFlags::DEFAULT);
+    } else {
+      texture = TextureClient::CreateForDrawing(
+          aKnowsCompositor, surface->GetFormat(), aImage->GetSize(),
+          BackendSelector::Content, TextureFlags::DEFAULT);
+    }
     if (!texture) {
       return nullptr;
     }
@@ -219,8 +232,16 @@ bool ImageClientSingle::UpdateImage(ImageContainer* aContainer,
     if (!texture) {
       // Slow path, we should not be hitting it very often and if we do it means
       // we are using an Image class that is not backed by textureClient and we
-      // should fix it.
-      texture = CreateTextureClientForImage(image, GetForwarder());
+      // should fix it. Allocate through the compositable's texture recycler so
+      // that video playback going through this path reuses a small pool of
+      // textures rather than allocating a new one per frame.
+      static const uint32_t MAX_POOLED_VIDEO_COUNT = 5;
+      if (!HasTextureClientRecycler()) {
+        // Initialize TextureClientRecycler
+        GetTextureClientRecycler()->SetMaxPoolSize(MAX_POOLED_VIDEO_COUNT);
+      }
+      texture = CreateTextureClientForImage(image, GetForwarder(),
+                                            GetTextureClientRecycler());
     }
 
     if (!texture) {
@@ -29,6 +29,7 @@ class Image;
 class ImageContainer;
 class ShadowableLayer;
 class ImageClientSingle;
+class TextureClientRecycleAllocator;
 
 /**
  * Image clients are used by basic image layers on the content thread, they
@@ -70,8 +71,15 @@ class ImageClient : public CompositableClient {
 
   virtual ImageClientSingle* AsImageClientSingle() { return nullptr; }
 
+  /**
+   * Create a TextureClient containing a copy of aImage's data. If
+   * aRecycleAllocator is non-null, the texture is allocated through it so
+   * that steady-state video playback reuses a small pool of buffers
+   * instead of allocating a fresh texture per frame.
+   */
   static already_AddRefed<TextureClient> CreateTextureClientForImage(
-      Image* aImage, KnowsCompositor* aForwarder);
+      Image* aImage, KnowsCompositor* aForwarder,
+      TextureClientRecycleAllocator* aRecycleAllocator = nullptr);
 
   uint32_t GetLastUpdateGenerationCounter() {
     return mLastUpdateGenerationCounter;
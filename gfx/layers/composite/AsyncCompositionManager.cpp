@@ -515,6 +515,15 @@ void AsyncCompositionManager::AdjustFixedOrStickyLayer(
     unconsumedTranslation = translation - originalTranslation;
   }
 
+  // If the layer consumed no translation and there is none left to propagate,
+  // there is nothing to adjust. This is common for sticky layers that are
+  // currently inside their sticky scroll range, and skipping the adjustment
+  // avoids redundant shadow-transform and clip-rect updates on every
+  // composite.
+  if (translation == LayerPoint() && unconsumedTranslation == LayerPoint()) {
+    return;
+  }
+
   // Finally, apply the translation to the layer transform. Note that in cases
   // where the async transform on |aTransformedSubtreeRoot| affects this layer's
   // clip rect, we need to apply the same translation to said clip rect, so
@@ -1380,7 +1380,16 @@ bool DataTextureSourceD3D11::Update(DataSourceSurface* aSurface,
     mDevice->GetImmediateContext(getter_AddRefs(context));
 
     if (regionToUpdate) {
-      for (auto iter = regionToUpdate->RectIter(); !iter.Done(); iter.Next()) {
+      // Each UpdateSubresource call is a driver round trip, and finely
+      // invalidated surfaces (e.g. video-wall pages with many small dirty
+      // areas) can produce dozens of dirty rects per transaction. Cap the
+      // number of upload commands; uploading a few extra pixels is much
+      // cheaper than the extra round trips, and the source surface always
+      // holds valid content outside the dirty region.
+      nsIntRegion simplifiedRegion(*regionToUpdate);
+      simplifiedRegion.SimplifyOutward(8);
+
+      for (auto iter = simplifiedRegion.RectIter(); !iter.Done(); iter.Next()) {
         const IntRect& rect = iter.Get();
         D3D11_BOX box;
         box.front = 0;
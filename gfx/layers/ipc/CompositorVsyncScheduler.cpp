@@ -72,6 +72,11 @@ CompositorVsyncScheduler::CompositorVsyncScheduler(
       mWidget(aWidget),
       mCurrentCompositeTaskMonitor("CurrentCompositeTaskMonitor"),
       mCurrentCompositeTask(nullptr),
+      mCompositeDurationIdx(0),
+      mCompositeDurationCnt(0),
+      mCurrentCompositeDeadlineScheduled(false),
+      mConsecutiveDeadlineMisses(0),
+      mDeadlineSchedulingAbandoned(false),
       mCurrentVRTaskMonitor("CurrentVRTaskMonitor"),
       mCurrentVRTask(nullptr) {
   mVsyncObserver = new Observer(this);
@@ -108,7 +113,8 @@ void CompositorVsyncScheduler::Destroy() {
 }
 
 void CompositorVsyncScheduler::PostCompositeTask(
-    VsyncId aId, TimeStamp aCompositeTimestamp) {
+    VsyncId aId, TimeStamp aCompositeTimestamp,
+    bool aAllowDeadlineScheduling) {
   MonitorAutoLock lock(mCurrentCompositeTaskMonitor);
   if (mCurrentCompositeTask == nullptr && CompositorThreadHolder::Loop()) {
     RefPtr<CancelableRunnable> task =
@@ -116,7 +122,12 @@ void CompositorVsyncScheduler::PostCompositeTask(
             "layers::CompositorVsyncScheduler::Composite", this,
             &CompositorVsyncScheduler::Composite, aId, aCompositeTimestamp);
     mCurrentCompositeTask = task;
-    ScheduleTask(task.forget());
+    TimeDuration delay;
+    if (aAllowDeadlineScheduling) {
+      delay = ComputeDeadlineCompositeDelay(aCompositeTimestamp);
+    }
+    mCurrentCompositeDeadlineScheduled = delay != TimeDuration();
+    ScheduleTask(task.forget(), int(delay.ToMilliseconds()));
   }
 }
 
@@ -181,10 +192,12 @@ bool CompositorVsyncScheduler::NotifyVsync(const VsyncEvent& aVsync) {
 #if defined(MOZ_WIDGET_ANDROID)
   gfx::VRManager* vm = gfx::VRManager::Get();
   if (!vm->IsPresenting()) {
-    PostCompositeTask(aVsync.mId, aVsync.mTime);
+    PostCompositeTask(aVsync.mId, aVsync.mTime,
+                      /* aAllowDeadlineScheduling */ true);
   }
 #else
-  PostCompositeTask(aVsync.mId, aVsync.mTime);
+  PostCompositeTask(aVsync.mId, aVsync.mTime,
+                    /* aAllowDeadlineScheduling */ true);
 #endif  // defined(MOZ_WIDGET_ANDROID)
 
   PostVRTask(aVsync.mTime);
@@ -216,9 +229,12 @@ void CompositorVsyncScheduler::Composite(VsyncId aId,
   MOZ_ASSERT(CompositorThreadHolder::IsInCompositorThread());
   MOZ_ASSERT(mVsyncSchedulerOwner);
 
+  bool wasDeadlineScheduled;
   {  // scope lock
     MonitorAutoLock lock(mCurrentCompositeTaskMonitor);
     mCurrentCompositeTask = nullptr;
+    wasDeadlineScheduled = mCurrentCompositeDeadlineScheduled;
+    mCurrentCompositeDeadlineScheduled = false;
   }
 
   mLastVsync = aVsyncTimestamp;
@@ -246,7 +262,10 @@ void CompositorVsyncScheduler::Composite(VsyncId aId,
     mLastCompose = aVsyncTimestamp;
 
     // Tell the owner to do a composite
+    TimeStamp compositeStart = TimeStamp::Now();
     mVsyncSchedulerOwner->CompositeToTarget(aId, nullptr, nullptr);
+    NoteCompositeDuration(compositeStart, aVsyncTimestamp,
+                          wasDeadlineScheduled);
 
     mVsyncNotificationsSkipped = 0;
 
@@ -260,6 +279,79 @@ void CompositorVsyncScheduler::Composite(VsyncId aId,
   }
 }
 
+TimeDuration CompositorVsyncScheduler::ComputeDeadlineCompositeDelay(
+    TimeStamp aVsyncTimestamp) {
+  mCurrentCompositeTaskMonitor.AssertCurrentThreadOwns();
+
+  if (!StaticPrefs::layers_deadline_scheduling_enabled() ||
+      mDeadlineSchedulingAbandoned || mAsapScheduling) {
+    return TimeDuration();
+  }
+
+  // Don't start gambling with the frame deadline until we have a full
+  // history of composite durations and know the vsync interval.
+  if (mCompositeDurationCnt < kCompositeDurationHistoryLength ||
+      mVsyncInterval == TimeDuration()) {
+    return TimeDuration();
+  }
+
+  // Predict from the worst recent composite rather than the average; the
+  // penalty for starting too late is a whole missed frame while the reward
+  // for starting later is only a little extra latency.
+  TimeDuration predicted;
+  for (uint32_t i = 0; i < mCompositeDurationCnt; ++i) {
+    if (mCompositeDurations[i] > predicted) {
+      predicted = mCompositeDurations[i];
+    }
+  }
+  predicted += TimeDuration::FromMilliseconds(
+      StaticPrefs::layers_deadline_scheduling_margin_ms());
+
+  TimeStamp target = aVsyncTimestamp + mVsyncInterval - predicted;
+  TimeStamp now = TimeStamp::Now();
+  if (target <= now) {
+    return TimeDuration();
+  }
+  return target - now;
+}
+
+void CompositorVsyncScheduler::NoteCompositeDuration(
+    TimeStamp aCompositeStart, TimeStamp aVsyncTimestamp,
+    bool aWasDeadlineScheduled) {
+  MOZ_ASSERT(CompositorThreadHolder::IsInCompositorThread());
+
+  TimeStamp end = TimeStamp::Now();
+
+  MonitorAutoLock lock(mCurrentCompositeTaskMonitor);
+
+  // GetVsyncInterval() must be called on the compositor thread, so cache it
+  // here for ComputeDeadlineCompositeDelay() on the vsync dispatch thread.
+  mVsyncInterval = mVsyncSchedulerOwner->GetVsyncInterval();
+
+  mCompositeDurations[mCompositeDurationIdx] = end - aCompositeStart;
+  mCompositeDurationIdx = (mCompositeDurationIdx + 1) %
+                          kCompositeDurationHistoryLength;
+  if (mCompositeDurationCnt < kCompositeDurationHistoryLength) {
+    ++mCompositeDurationCnt;
+  }
+
+  if (!aWasDeadlineScheduled || aVsyncTimestamp.IsNull() ||
+      mVsyncInterval == TimeDuration()) {
+    return;
+  }
+
+  if (end > aVsyncTimestamp + mVsyncInterval) {
+    if (++mConsecutiveDeadlineMisses >=
+        StaticPrefs::layers_deadline_scheduling_miss_threshold()) {
+      // The predictions aren't holding up on this machine or workload; go
+      // back to scheduling at vsync for the rest of this compositor's life.
+      mDeadlineSchedulingAbandoned = true;
+    }
+  } else {
+    mConsecutiveDeadlineMisses = 0;
+  }
+}
+
 void CompositorVsyncScheduler::ForceComposeToTarget(gfx::DrawTarget* aTarget,
                                                     const IntRect* aRect) {
   MOZ_ASSERT(CompositorThreadHolder::IsInCompositorThread());
@@ -330,9 +422,10 @@ void CompositorVsyncScheduler::DispatchVREvents(TimeStamp aVsyncTimestamp) {
 }
 
 void CompositorVsyncScheduler::ScheduleTask(
-    already_AddRefed<CancelableRunnable> aTask) {
+    already_AddRefed<CancelableRunnable> aTask, int aDelayMs) {
   MOZ_ASSERT(CompositorThreadHolder::Loop());
-  CompositorThreadHolder::Loop()->PostDelayedTask(std::move(aTask), 0);
+  MOZ_ASSERT(aDelayMs >= 0);
+  CompositorThreadHolder::Loop()->PostDelayedTask(std::move(aTask), aDelayMs);
 }
 
 const TimeStamp& CompositorVsyncScheduler::GetLastComposeTime() const {
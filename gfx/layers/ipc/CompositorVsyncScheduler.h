@@ -109,12 +109,17 @@ class CompositorVsyncScheduler {
  private:
   virtual ~CompositorVsyncScheduler();
 
-  // Schedule a task to run on the compositor thread.
-  void ScheduleTask(already_AddRefed<CancelableRunnable>);
+  // Schedule a task to run on the compositor thread after the given delay.
+  void ScheduleTask(already_AddRefed<CancelableRunnable>, int aDelayMs = 0);
 
   // Post a task to run Composite() on the compositor thread, if there isn't
-  // such a task already queued. Can be called from any thread.
-  void PostCompositeTask(VsyncId aId, TimeStamp aCompositeTimestamp);
+  // such a task already queued. Can be called from any thread. When
+  // aAllowDeadlineScheduling is true and deadline scheduling is enabled, the
+  // task may be delayed within the vsync interval so composition starts as
+  // late as it safely can; this must only be passed for vsync-triggered
+  // composites, where aCompositeTimestamp is the vsync time.
+  void PostCompositeTask(VsyncId aId, TimeStamp aCompositeTimestamp,
+                         bool aAllowDeadlineScheduling = false);
 
   // Post a task to run DispatchVREvents() on the VR thread, if there isn't
   // such a task already queued. Can be called from any thread.
@@ -129,6 +134,22 @@ class CompositorVsyncScheduler {
   // update internal state and call the owner to do the composite).
   void Composite(VsyncId aId, TimeStamp aVsyncTimestamp);
 
+  // Returns how long a vsync-triggered composite may be delayed past the
+  // vsync at aVsyncTimestamp and still be expected to finish before the next
+  // vsync, based on the recent composite duration history. Returns zero (no
+  // delay) while deadline scheduling is disabled, has been abandoned because
+  // of repeated deadline misses, or doesn't yet have a full history to
+  // predict from. mCurrentCompositeTaskMonitor must be held.
+  TimeDuration ComputeDeadlineCompositeDelay(TimeStamp aVsyncTimestamp);
+
+  // Record how long the composite triggered at aVsyncTimestamp took, and
+  // track deadline misses of deadline-scheduled composites so we can stop
+  // deadline scheduling when the predictions don't hold up. Runs on the
+  // compositor thread.
+  void NoteCompositeDuration(TimeStamp aCompositeStart,
+                             TimeStamp aVsyncTimestamp,
+                             bool aWasDeadlineScheduled);
+
   void ObserveVsync();
   void UnobserveVsync();
 
@@ -163,6 +184,19 @@ class CompositorVsyncScheduler {
   mozilla::Monitor mCurrentCompositeTaskMonitor;
   RefPtr<CancelableRunnable> mCurrentCompositeTask;
 
+  // Deadline scheduling state. The duration history and the cached vsync
+  // interval are written on the compositor thread after each composite and
+  // read on the vsync dispatch thread, so all of it is protected by
+  // mCurrentCompositeTaskMonitor.
+  static const uint32_t kCompositeDurationHistoryLength = 8;
+  TimeDuration mCompositeDurations[kCompositeDurationHistoryLength];
+  uint32_t mCompositeDurationIdx;
+  uint32_t mCompositeDurationCnt;
+  TimeDuration mVsyncInterval;
+  bool mCurrentCompositeDeadlineScheduled;
+  uint32_t mConsecutiveDeadlineMisses;
+  bool mDeadlineSchedulingAbandoned;
+
   mozilla::Monitor mCurrentVRTaskMonitor;
   RefPtr<CancelableRunnable> mCurrentVRTask;
 };
@@ -23,6 +23,7 @@ class SharedSurfacesMemoryReport final {
     gfx::IntSize mSize;
     int32_t mStride;
     uint32_t mConsumers;
+    uint32_t mContentHash;
     bool mCreatorRef;
   };
 
@@ -215,7 +215,8 @@ void SharedSurfacesParent::AccumulateMemoryReport(
       aReport.mSurfaces.insert(std::make_pair(
           i.Key(), SharedSurfacesMemoryReport::SurfaceEntry{
                        aPid, surface->GetSize(), surface->Stride(),
-                       surface->GetConsumers(), surface->HasCreatorRef()}));
+                       surface->GetConsumers(), surface->GetContentHash(),
+                       surface->HasCreatorRef()}));
     }
   }
 }
@@ -243,7 +244,8 @@ bool SharedSurfacesParent::AccumulateMemoryReport(
         i.Key(),
         SharedSurfacesMemoryReport::SurfaceEntry{
             surface->GetCreatorPid(), surface->GetSize(), surface->Stride(),
-            surface->GetConsumers(), surface->HasCreatorRef()}));
+            surface->GetConsumers(), surface->GetContentHash(),
+            surface->HasCreatorRef()}));
   }
 
   return true;
@@ -5,11 +5,14 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"
 
 #include "BSPTree.h"
 #include "Polygon.h"
 #include "PolygonTestUtils.h"
+#include "mozilla/Unused.h"
 
+#include <cmath>
 #include <deque>
 #include <list>
 
@@ -692,3 +695,31 @@ TEST(BSPTree, TwoPlaneIntersectRotate360degrees)
                  Point4D(-2.00000f, 0.00010f, -2.00000f, 1.0f)}};
   ::RunTest(polygons, expected);
 }
+
+MOZ_GTEST_BENCH(GfxBSPTreePerf, BuildCarousel, []() {
+  // A carousel of quads rotated around the y-axis, similar to the plane sets
+  // produced by CSS 3D transform scenes. Every quad passes through the
+  // origin, which forces the tree to split polygons while it is built.
+  const size_t planeCount = 100;
+  std::deque<MozPolygon> polygons;
+
+  for (size_t i = 0; i < planeCount; ++i) {
+    const float angle = (2.0f * float(M_PI) * float(i)) / float(planeCount);
+    const float x = cosf(angle);
+    const float z = sinf(angle);
+
+    polygons.push_back(MozPolygon{
+        Point4D(-x, -1.0f, -z, 1.0f), Point4D(x, -1.0f, z, 1.0f),
+        Point4D(x, 1.0f, z, 1.0f), Point4D(-x, 1.0f, -z, 1.0f)});
+  }
+
+  for (size_t iteration = 0; iteration < 10; ++iteration) {
+    std::list<LayerPolygon> layers;
+    for (const MozPolygon& polygon : polygons) {
+      layers.push_back(LayerPolygon(nullptr, MozPolygon(polygon)));
+    }
+
+    const BSPTree tree(layers);
+    mozilla::Unused << tree.GetDrawOrder();
+  }
+});
@@ -2705,12 +2705,23 @@ gfxShapedWord* gfxFont::GetShapedWord(
     Script aRunScript, bool aVertical, int32_t aAppUnitsPerDevUnit,
     gfx::ShapedTextFlags aFlags, RoundingFlags aRounding,
     gfxTextPerfMetrics* aTextPerf GFX_MAYBE_UNUSED) {
-  // if the cache is getting too big, flush it and start over
+  // If the cache is getting too big, first discard the entries that have not
+  // been used since the last ageing pass, so that words the current content
+  // keeps re-shaping (grid cells, labels, timestamps, ...) survive. Only if
+  // everything is in active use flush the cache and start over.
   uint32_t wordCacheMaxEntries =
       gfxPlatform::GetPlatform()->WordCacheMaxEntries();
   if (mWordCache->Count() > wordCacheMaxEntries) {
-    NS_WARNING("flushing shaped-word cache");
-    ClearCachedWords();
+    for (auto it = mWordCache->Iter(); !it.Done(); it.Next()) {
+      CacheHashEntry* e = it.Get();
+      if (!e->mShapedWord || e->mShapedWord->GetAge() != 0) {
+        it.Remove();
+      }
+    }
+    if (mWordCache->Count() > wordCacheMaxEntries) {
+      NS_WARNING("flushing shaped-word cache");
+      ClearCachedWords();
+    }
   }
 
   // if there's a cached entry for this word, just return it
@@ -444,6 +444,9 @@ nsresult gfxPlatformFontList::InitFontList() {
   // Forget any font family we previously chose for U+FFFD.
   mReplacementCharFallbackFamily = FontFamily();
 
+  // Forget any cached per-script fallback families.
+  mFallbackFamilyByScript.Clear();
+
   sPlatformFontList = this;
 
   // Try to initialize the cross-process shared font list if enabled by prefs,
@@ -824,8 +827,34 @@ gfxFontEntry* gfxPlatformFontList::SystemFindFontForChar(
   uint32_t cmapCount = 0;
   if (!fontEntry) {
     common = false;
-    fontEntry =
-        GlobalFontFallback(aCh, aRunScript, aStyle, cmapCount, &fallbackFamily);
+
+    // Try the family that most recently satisfied global fallback for this
+    // script before walking every installed face again. This can settle for a
+    // poorer style match than the full search would find, but no more so than
+    // CommonFontFallback already does.
+    if (FontFamily* cached =
+            mFallbackFamilyByScript.GetValue(uint32_t(aRunScript))) {
+      GlobalFontMatch data(aCh, *aStyle);
+      if (cached->mIsShared) {
+        if (cached->mShared) {
+          cached->mShared->SearchAllFontsForChar(SharedFontList(), &data);
+        }
+      } else if (cached->mUnshared) {
+        cached->mUnshared->FindFontForChar(&data);
+      }
+      if (data.mBestMatch) {
+        fontEntry = data.mBestMatch;
+        fallbackFamily = *cached;
+      }
+    }
+
+    if (!fontEntry) {
+      fontEntry = GlobalFontFallback(aCh, aRunScript, aStyle, cmapCount,
+                                     &fallbackFamily);
+      if (fontEntry) {
+        mFallbackFamilyByScript.Put(uint32_t(aRunScript), fallbackFamily);
+      }
+    }
   }
   TimeDuration elapsed = TimeStamp::Now() - start;
 
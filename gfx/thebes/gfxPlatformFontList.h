@@ -780,6 +780,12 @@ class gfxPlatformFontList : public gfxFontInfoLoader {
   // on pages with lots of problems
   FontFamily mReplacementCharFallbackFamily;
 
+  // the family that most recently satisfied global font fallback for each
+  // script, tried first before walking the full font list again; non-owning,
+  // like mReplacementCharFallbackFamily, and cleared when the font list is
+  // rebuilt
+  nsDataHashtable<nsUint32HashKey, FontFamily> mFallbackFamilyByScript;
+
   // Sorted array of lowercased family names; use ContainsSorted to test
   nsTArray<nsCString> mBadUnderlineFamilyNames;
 
@@ -25,7 +25,10 @@ AnimationSurfaceProvider::AnimationSurfaceProvider(
       mImage(aImage.get()),
       mDecodingMutex("AnimationSurfaceProvider::mDecoder"),
       mDecoder(aDecoder.get()),
-      mFramesMutex("AnimationSurfaceProvider::mFrames") {
+      mFramesMutex("AnimationSurfaceProvider::mFrames"),
+      mPriority(bool(aDecoder->GetDecoderFlags() & DecoderFlags::HIGH_PRIORITY)
+                    ? TaskPriority::eMediumHigh
+                    : TaskPriority::eLow) {
   MOZ_ASSERT(!mDecoder->IsMetadataDecode(),
              "Use MetadataDecodingTask for metadata decodes");
   MOZ_ASSERT(!mDecoder->IsFirstFrameDecode(),
@@ -254,6 +257,15 @@ void AnimationSurfaceProvider::Run() {
         DecodePool::Singleton()->IsShuttingDown()) {
       return;
     }
+
+    // A frame boundary is a natural point to yield the thread. If a higher
+    // priority decode is waiting on the pool - e.g. for an image which just
+    // became visible - requeue ourselves behind it rather than making it wait
+    // for the rest of this animation.
+    if (DecodePool::Singleton()->HasPendingHigherPriorityWork(mPriority)) {
+      DecodePool::Singleton()->AsyncRun(this);
+      return;
+    }
   }
 }
 
@@ -75,9 +75,11 @@ class AnimationSurfaceProvider final : public ISurfaceProvider,
   void Run() override;
   bool ShouldPreferSyncRun() const override;
 
-  // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // Full decodes are lower priority than metadata decodes because they don't
+  // block layout or page load, but decodes for images in or near the viewport
+  // are scheduled ahead of decodes for images we don't expect to be visible
+  // soon.
+  TaskPriority Priority() const override { return mPriority; }
 
   //////////////////////////////////////////////////////////////////////////////
   // IDecoderFrameRecycler implementation.
@@ -114,6 +116,10 @@ class AnimationSurfaceProvider final : public ISurfaceProvider,
 
   /// The frames of this animation, in order.
   UniquePtr<AnimationFrameBuffer> mFrames;
+
+  /// The priority the DecodePool should schedule us at; captured from the
+  /// decoder's flags at creation time.
+  const TaskPriority mPriority;
 };
 
 }  // namespace image
@@ -136,16 +136,24 @@ class DecodePoolImpl {
       return;
     }
 
-    if (task->Priority() == TaskPriority::eHigh) {
-      mHighPriorityQueue.AppendElement(std::move(task));
-    } else {
-      mLowPriorityQueue.AppendElement(std::move(task));
+    switch (task->Priority()) {
+      case TaskPriority::eHigh:
+        mHighPriorityQueue.AppendElement(std::move(task));
+        break;
+      case TaskPriority::eMediumHigh:
+        mMediumHighPriorityQueue.AppendElement(std::move(task));
+        break;
+      default:
+        mLowPriorityQueue.AppendElement(std::move(task));
+        break;
     }
 
     // If there are pending tasks, create more workers if and only if we have
     // not exceeded the capacity, and any previously created workers are ready.
     if (mAvailableThreads) {
-      size_t pending = mHighPriorityQueue.Length() + mLowPriorityQueue.Length();
+      size_t pending = mHighPriorityQueue.Length() +
+                       mMediumHighPriorityQueue.Length() +
+                       mLowPriorityQueue.Length();
       if (pending > mIdleThreads) {
         CreateThread();
       }
@@ -170,6 +178,23 @@ class DecodePoolImpl {
     return PopWorkLocked(aShutdownIdle);
   }
 
+  /// @return true if work with a priority above @aPriority is waiting on the
+  /// queues. Long-running tasks can use this to decide to yield the thread.
+  bool HasPendingHigherPriorityWork(TaskPriority aPriority) {
+    MonitorAutoLock lock(mMonitor);
+
+    if (aPriority < TaskPriority::eHigh && !mHighPriorityQueue.IsEmpty()) {
+      return true;
+    }
+
+    if (aPriority < TaskPriority::eMediumHigh &&
+        !mMediumHighPriorityQueue.IsEmpty()) {
+      return true;
+    }
+
+    return false;
+  }
+
  private:
   /// Pops a new work item, blocking if necessary.
   Work PopWorkLocked(bool aShutdownIdle) {
@@ -181,6 +206,10 @@ class DecodePoolImpl {
         return PopWorkFromQueue(mHighPriorityQueue);
       }
 
+      if (!mMediumHighPriorityQueue.IsEmpty()) {
+        return PopWorkFromQueue(mMediumHighPriorityQueue);
+      }
+
       if (!mLowPriorityQueue.IsEmpty()) {
         return PopWorkFromQueue(mLowPriorityQueue);
       }
@@ -246,6 +275,7 @@ class DecodePoolImpl {
   // mMonitor guards everything below.
   mutable Monitor mMonitor;
   nsTArray<RefPtr<IDecodingTask>> mHighPriorityQueue;
+  nsTArray<RefPtr<IDecodingTask>> mMediumHighPriorityQueue;
   nsTArray<RefPtr<IDecodingTask>> mLowPriorityQueue;
   nsTArray<nsCOMPtr<nsIThread>> mThreads;
   TimeDuration mIdleTimeout;
@@ -454,6 +484,10 @@ void DecodePool::AsyncRun(IDecodingTask* aTask) {
   mImpl->PushWork(aTask);
 }
 
+bool DecodePool::HasPendingHigherPriorityWork(TaskPriority aPriority) {
+  return mImpl->HasPendingHigherPriorityWork(aPriority);
+}
+
 bool DecodePool::SyncRunIfPreferred(IDecodingTask* aTask,
                                     const nsCString& aURI) {
   MOZ_ASSERT(NS_IsMainThread());
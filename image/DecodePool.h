@@ -28,6 +28,7 @@ namespace image {
 class Decoder;
 class DecodePoolImpl;
 class IDecodingTask;
+enum class TaskPriority : uint8_t;
 
 /**
  * DecodePool is a singleton class that manages decoding of raster images. It
@@ -61,6 +62,13 @@ class DecodePool final : public nsIObserver {
   /// Ask the DecodePool to run @aTask asynchronously and return immediately.
   void AsyncRun(IDecodingTask* aTask);
 
+  /**
+   * Returns true if work with a priority above @aPriority is waiting to be
+   * scheduled. Long-running low priority tasks can use this to yield their
+   * thread at a convenient point, requeueing themselves with AsyncRun().
+   */
+  bool HasPendingHigherPriorityWork(TaskPriority aPriority);
+
   /**
    * Run @aTask synchronously if the task would prefer it. It's up to the task
    * itself to make this decision; @see IDecodingTask::ShouldPreferSyncRun(). If
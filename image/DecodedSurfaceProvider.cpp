@@ -22,7 +22,10 @@ DecodedSurfaceProvider::DecodedSurfaceProvider(NotNull<RasterImage*> aImage,
                        AvailabilityState::StartAsPlaceholder()),
       mImage(aImage.get()),
       mMutex("mozilla::image::DecodedSurfaceProvider"),
-      mDecoder(aDecoder.get()) {
+      mDecoder(aDecoder.get()),
+      mPriority(bool(aDecoder->GetDecoderFlags() & DecoderFlags::HIGH_PRIORITY)
+                    ? TaskPriority::eMediumHigh
+                    : TaskPriority::eLow) {
   MOZ_ASSERT(!mDecoder->IsMetadataDecode(),
              "Use MetadataDecodingTask for metadata decodes");
   MOZ_ASSERT(mDecoder->IsFirstFrameDecode(),
@@ -51,9 +51,11 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
   void Run() override;
   bool ShouldPreferSyncRun() const override;
 
-  // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // Full decodes are lower priority than metadata decodes because they don't
+  // block layout or page load, but decodes for images in or near the viewport
+  // are scheduled ahead of decodes for images we don't expect to be visible
+  // soon.
+  TaskPriority Priority() const override { return mPriority; }
 
  private:
   virtual ~DecodedSurfaceProvider();
@@ -76,6 +78,10 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
 
   /// A drawable reference to our service; used for locking.
   DrawableFrameRef mLockRef;
+
+  /// The priority the DecodePool should schedule us at; captured from the
+  /// decoder's flags at creation time.
+  const TaskPriority mPriority;
 };
 
 }  // namespace image
@@ -31,6 +31,14 @@ enum class DecoderFlags : uint8_t {
    * set.
    */
   CANNOT_SUBSTITUTE = 1 << 4,
+
+  /**
+   * By default, a full decode is scheduled behind any other full decodes
+   * already waiting on the DecodePool. Set this flag if the decode is for an
+   * image which is in or near the viewport, so that it's scheduled ahead of
+   * decodes for images which aren't expected to be visible soon.
+   */
+  HIGH_PRIORITY = 1 << 5,
 };
 MOZ_MAKE_ENUM_CLASS_BITWISE_OPERATORS(DecoderFlags)
 
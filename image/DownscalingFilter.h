@@ -21,6 +21,8 @@
 #include <stdint.h>
 
 #include "mozilla/Maybe.h"
+#include "mozilla/Telemetry.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/gfx/2D.h"
 
@@ -106,7 +108,16 @@ class DownscalingFilter final : public SurfaceFilter {
         mOutputRow(0),
         mHasAlpha(true) {}
 
-  ~DownscalingFilter() { ReleaseWindow(); }
+  ~DownscalingFilter() {
+    ReleaseWindow();
+
+    // One sample per downscaled surface, so the decode pool's downscaling
+    // cost can be monitored separately from overall decode time.
+    if (!mDownscaleTime.IsZero()) {
+      Telemetry::Accumulate(Telemetry::IMAGE_DOWNSCALE_TIME_US,
+                            uint32_t(mDownscaleTime.ToMicroseconds()));
+    }
+  }
 
   template <typename... Rest>
   nsresult Configure(const DownscalingConfig& aConfig, const Rest&... aRest) {
@@ -221,6 +232,8 @@ class DownscalingFilter final : public SurfaceFilter {
       return nullptr;
     }
 
+    TimeStamp start = TimeStamp::Now();
+
     int32_t filterOffset = 0;
     int32_t filterLength = 0;
     mYFilter.GetFilterOffsetAndLength(mOutputRow, &filterOffset, &filterLength);
@@ -250,6 +263,8 @@ class DownscalingFilter final : public SurfaceFilter {
 
     mInputRow++;
 
+    mDownscaleTime += TimeStamp::Now() - start;
+
     return mInputRow < mInputSize.height ? GetRowPointer() : nullptr;
   }
 
@@ -342,6 +357,8 @@ class DownscalingFilter final : public SurfaceFilter {
   int32_t mOutputRow;     /// The current row we're writing. (0-indexed)
 
   bool mHasAlpha;  /// If true, the image has transparency.
+
+  TimeDuration mDownscaleTime;  /// Total time spent downscaling this surface.
 };
 
 #endif
@@ -24,7 +24,10 @@ class Decoder;
 class RasterImage;
 
 /// A priority hint that DecodePool can use when scheduling an IDecodingTask.
-enum class TaskPriority : uint8_t { eLow, eHigh };
+/// eLow is used for decodes of images which aren't expected to be visible
+/// soon, eMediumHigh for full decodes of images in or near the viewport, and
+/// eHigh for metadata decodes, which block layout and page load.
+enum class TaskPriority : uint8_t { eLow, eMediumHigh, eHigh };
 
 /**
  * An interface for tasks which can execute on the ImageLib DecodePool.
@@ -5,7 +5,11 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "ImageMemoryReporter.h"
+
+#include <unordered_set>
+
 #include "Image.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/layers/SharedSurfacesParent.h"
 #include "mozilla/StaticPrefs_image.h"
 #include "nsIMemoryReporter.h"
@@ -77,6 +81,53 @@ void ImageMemoryReporter::ReportSharedSurfaces(
     ReportSharedSurface(aHandleReport, aData, aIsForCompositor, i->first,
                         i->second);
   }
+
+  if (aIsForCompositor) {
+    ReportDuplicateSharedSurfaces(aHandleReport, aData, aSharedSurfaces);
+  }
+}
+
+/* static */
+void ImageMemoryReporter::ReportDuplicateSharedSurfaces(
+    nsIHandleReportCallback* aHandleReport, nsISupports* aData,
+    const layers::SharedSurfacesMemoryReport& aSharedSurfaces) {
+  // The compositor maps a separate copy of a decoded surface for each process
+  // which decoded it, so e.g. the same hero image on 40 same-site tabs spread
+  // over several content processes is stored once per process. Estimate the
+  // waste by grouping the mapped surfaces on their content hash and geometry;
+  // each group only needs one copy, the rest is duplication. This is an
+  // estimate because the hash is a snapshot of the buffer which may still
+  // have been decoding when it was computed.
+  std::unordered_set<uint64_t> seen;
+  size_t duplicateSize = 0;
+
+  for (auto i = aSharedSurfaces.mSurfaces.begin();
+       i != aSharedSurfaces.mSurfaces.end(); ++i) {
+    const auto& entry = i->second;
+    if (!entry.mContentHash) {
+      continue;
+    }
+
+    uint64_t key =
+        (uint64_t(entry.mContentHash) << 32) |
+        HashGeneric(entry.mSize.width, entry.mSize.height, entry.mStride);
+    if (!seen.insert(key).second) {
+      duplicateSize += mozilla::ipc::SharedMemory::PageAlignedSize(
+          entry.mSize.height * entry.mStride);
+    }
+  }
+
+  if (duplicateSize > 0) {
+    NS_NAMED_LITERAL_CSTRING(
+        desc,
+        "Estimate of shared memory containing the same decoded image data as "
+        "another mapped surface, i.e. the same image decoded independently by "
+        "more than one process.");
+    aHandleReport->Callback(
+        EmptyCString(), NS_LITERAL_CSTRING("gfx-images-duplicated-surfaces"),
+        nsIMemoryReporter::KIND_OTHER, nsIMemoryReporter::UNITS_BYTES,
+        duplicateSize, desc, aData);
+  }
 }
 
 /* static */
@@ -85,6 +85,15 @@ class ImageMemoryReporter final {
       bool aIsForCompositor, uint64_t aExternalId,
       const layers::SharedSurfacesMemoryReport::SurfaceEntry& aEntry);
 
+  /**
+   * Report an estimate of how much of the compositor's mapped surface memory
+   * holds the same decoded image data as another mapped surface, e.g. the
+   * same image decoded independently by several content processes.
+   */
+  static void ReportDuplicateSharedSurfaces(
+      nsIHandleReportCallback* aHandleReport, nsISupports* aData,
+      const layers::SharedSurfacesMemoryReport& aSharedSurfaces);
+
   class WebRenderReporter;
   static WebRenderReporter* sWrReporter;
 };
@@ -1195,6 +1195,9 @@ bool RasterImage::Decode(const IntSize& aSize, uint32_t aFlags,
   if (mHasBeenDecoded) {
     decoderFlags |= DecoderFlags::IS_REDECODE;
   }
+  if (aFlags & FLAG_PRIORITIZE_DECODE) {
+    decoderFlags |= DecoderFlags::HIGH_PRIORITY;
+  }
   if ((aFlags & FLAG_SYNC_DECODE) || !(aFlags & FLAG_HIGH_QUALITY_SCALING)) {
     // Used SurfaceCache::Lookup instead of SurfaceCache::LookupBestMatch. That
     // means the caller can handle a differently sized surface to be returned
@@ -1424,6 +1427,10 @@ RasterImage::Draw(gfxContext* aContext, const IntSize& aSize,
                        ? aFlags
                        : aFlags & ~FLAG_HIGH_QUALITY_SCALING;
 
+  // We're painting this image right now, so any decode the lookup kicks off
+  // should be scheduled ahead of decodes for images which aren't visible.
+  flags |= FLAG_PRIORITIZE_DECODE;
+
   LookupResult result = LookupFrame(aSize, flags, ToPlaybackType(aWhichFrame),
                                     /* aMarkUsed = */ true);
   if (!result) {
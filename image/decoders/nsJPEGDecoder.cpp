@@ -80,6 +80,7 @@ nsJPEGDecoder::nsJPEGDecoder(RasterImage* aImage,
       mProfile(nullptr),
       mProfileLength(0),
       mCMSLine(nullptr),
+      mHighQualityPass(true),
       mDecodeStyle(aDecodeStyle) {
   this->mErr.pub.error_exit = nullptr;
   this->mErr.pub.emit_message = nullptr;
@@ -393,9 +394,8 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
                 " JPEG_START_DECOMPRESS case");
       // Step 4: set parameters for decompression
 
-      // FIXME -- Should reset dct_method and dither mode
-      // for final pass of progressive JPEG
-
+      // For progressive JPEGs, dct_method is adjusted per output pass in
+      // JPEG_DECOMPRESS_PROGRESSIVE below.
       mInfo.dct_method = JDCT_ISLOW;
       mInfo.dither_mode = JDITHER_FS;
       mInfo.do_fancy_upsampling = TRUE;
@@ -465,6 +465,16 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
                 (status != JPEG_REACHED_EOI))
               scan--;
 
+            // Pick the decompression settings for this output pass. The final
+            // pass re-renders every pixel we'll actually keep, so it uses the
+            // high quality (slow) DCT method; intermediate passes are
+            // refined in place by later ones, and a faster method puts them
+            // on screen sooner. libjpeg allows changing dct_method between
+            // output passes in buffered-image mode.
+            mHighQualityPass = (status == JPEG_REACHED_EOI) &&
+                               (scan == mInfo.input_scan_number);
+            mInfo.dct_method = mHighQualityPass ? JDCT_ISLOW : JDCT_IFAST;
+
             if (!jpeg_start_output(&mInfo, scan)) {
               MOZ_LOG(sJPEGDecoderAccountingLog, LogLevel::Debug,
                       ("} (I/O suspension after jpeg_start_output() -"
@@ -503,9 +513,13 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
               }
 
               if (jpeg_input_complete(&mInfo) &&
-                  (mInfo.input_scan_number == mInfo.output_scan_number)) {
+                  (mInfo.input_scan_number == mInfo.output_scan_number) &&
+                  mHighQualityPass) {
                 mState = JPEG_DONE;
               } else {
+                // Either more scans are coming, or the last pass we displayed
+                // was an intermediate quality one because EOI arrived after
+                // it started; do another pass with the final settings.
                 mInfo.output_scanline = 0;
                 mPipe.ResetToFirstRow();
               }
@@ -102,6 +102,12 @@ class nsJPEGDecoder : public Decoder {
 
   bool mReading;
 
+  // Whether the current progressive output pass is using the final (high
+  // quality) decompression settings. Intermediate passes use a faster DCT
+  // method since their output is refined in place by later passes; we don't
+  // finish until the last pass displayed was a high quality one.
+  bool mHighQualityPass;
+
   const Decoder::DecodeStyle mDecodeStyle;
 
   uint32_t mCMSMode;
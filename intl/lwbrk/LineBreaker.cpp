@@ -375,6 +375,13 @@ static inline bool IS_HYPHEN(char16_t u) {
 
 static int8_t GetClass(uint32_t u, LineBreaker::Strictness aLevel,
                        bool aIsChineseOrJapanese) {
+  if (u < 0x80) {
+    // None of the strictness overrides below affect ASCII characters, so the
+    // class comes straight from the table, without paying for the Unicode
+    // line-break class lookup first.
+    return GETCLASSFROMTABLE(gLBClass00, uint16_t(u));
+  }
+
   // Mapping for Unicode LineBreak.txt classes to the (simplified) set of
   // character classes used here.
   // XXX The mappings here were derived by comparing the Unicode LineBreak
@@ -976,10 +983,44 @@ static bool SuppressBreakForKeepAll(uint32_t aPrev, uint32_t aCh) {
          affectedByKeepAll(GetLineBreakClass(aCh));
 }
 
+// The break-before result is a pure function of the word text and the break
+// options, so a word we have broken before can reuse its previous break set.
+// Reflow-heavy pages rebuild textruns containing the same words over and
+// over, which makes even a modest cache very effective.  Long words are not
+// cached: they are rare, and would crowd out the words that repeat.
+static const uint32_t kBreakCacheMaxEntries = 512;
+static const uint32_t kBreakCacheMaxWordLength = 64;
+
+// Encodes the break options as a fixed-length suffix of the cache key, so
+// that no separator from the preceding text is needed.  a16BitText
+// distinguishes the two GetJISx4051Breaks overloads; their results should
+// agree on common code units, but keying them separately is cheap and makes
+// that irrelevant.
+static void AppendBreakCacheKeySuffix(nsAString& aKey,
+                                      LineBreaker::WordBreak aWordBreak,
+                                      LineBreaker::Strictness aLevel,
+                                      bool aIsChineseOrJapanese,
+                                      bool a16BitText) {
+  aKey.Append(char16_t(uint16_t(aWordBreak) | (uint16_t(aLevel) << 4) |
+                       (uint16_t(aIsChineseOrJapanese) << 8) |
+                       (uint16_t(a16BitText) << 9)));
+}
+
 void LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLength,
                                     WordBreak aWordBreak, Strictness aLevel,
                                     bool aIsChineseOrJapanese,
                                     uint8_t* aBreakBefore) {
+  nsAutoString cacheKey;
+  if (aLength <= kBreakCacheMaxWordLength) {
+    cacheKey.Append(aChars, aLength);
+    AppendBreakCacheKeySuffix(cacheKey, aWordBreak, aLevel,
+                              aIsChineseOrJapanese, true);
+    if (const nsTArray<uint8_t>* cached = mBreakCache.GetValue(cacheKey)) {
+      memcpy(aBreakBefore, cached->Elements(), aLength);
+      return;
+    }
+  }
+
   uint32_t cur;
   int8_t lastClass = CLASS_NONE;
   ContextState state(aChars, aLength);
@@ -1095,12 +1136,34 @@ void LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLength,
       state.AdvanceIndex();
     }
   }
+
+  if (!cacheKey.IsEmpty()) {
+    if (mBreakCache.Count() >= kBreakCacheMaxEntries) {
+      mBreakCache.Clear();
+    }
+    nsTArray<uint8_t> breaks;
+    breaks.AppendElements(aBreakBefore, aLength);
+    mBreakCache.Put(cacheKey, std::move(breaks));
+  }
 }
 
 void LineBreaker::GetJISx4051Breaks(const uint8_t* aChars, uint32_t aLength,
                                     WordBreak aWordBreak, Strictness aLevel,
                                     bool aIsChineseOrJapanese,
                                     uint8_t* aBreakBefore) {
+  nsAutoString cacheKey;
+  if (aLength <= kBreakCacheMaxWordLength) {
+    for (uint32_t i = 0; i < aLength; ++i) {
+      cacheKey.Append(char16_t(aChars[i]));
+    }
+    AppendBreakCacheKeySuffix(cacheKey, aWordBreak, aLevel,
+                              aIsChineseOrJapanese, false);
+    if (const nsTArray<uint8_t>* cached = mBreakCache.GetValue(cacheKey)) {
+      memcpy(aBreakBefore, cached->Elements(), aLength);
+      return;
+    }
+  }
+
   uint32_t cur;
   int8_t lastClass = CLASS_NONE;
   ContextState state(aChars, aLength);
@@ -1141,4 +1204,13 @@ void LineBreaker::GetJISx4051Breaks(const uint8_t* aChars, uint32_t aLength,
     if (allowBreak) state.NotifyBreakBefore();
     lastClass = cl;
   }
+
+  if (!cacheKey.IsEmpty()) {
+    if (mBreakCache.Count() >= kBreakCacheMaxEntries) {
+      mBreakCache.Clear();
+    }
+    nsTArray<uint8_t> breaks;
+    breaks.AppendElements(aBreakBefore, aLength);
+    mBreakCache.Put(cacheKey, std::move(breaks));
+  }
 }
@@ -6,7 +6,10 @@
 #define mozilla_intl_LineBreaker_h__
 
 #include "nscore.h"
+#include "nsDataHashtable.h"
 #include "nsISupports.h"
+#include "nsString.h"
+#include "nsTArray.h"
 
 #define NS_LINEBREAKER_NEED_MORE_TEXT -1
 
@@ -55,6 +58,12 @@ class LineBreaker {
 
   int32_t WordMove(const char16_t* aText, uint32_t aLen, uint32_t aPos,
                    int8_t aDirection);
+
+  // Maps a recently-broken word, with the break options encoded as a
+  // fixed-length key suffix, to its computed break-before array.  The break
+  // set is a pure function of the key, so entries never go stale; the cache
+  // is simply cleared when it reaches its size limit.
+  nsDataHashtable<nsStringHashKey, nsTArray<uint8_t>> mBreakCache;
 };
 
 static inline bool NS_IsSpace(char16_t u) {
@@ -671,6 +671,16 @@ void Pickle::InputBytes(const char* data, uint32_t length) {
   MOZ_ALWAYS_TRUE(buffers_.WriteBytes(data, length));
 }
 
+char* Pickle::ReserveBytes(uint32_t max_length, uint32_t* length) {
+  size_t reserved;
+  char* data = buffers_.AllocateBytes(max_length, &reserved);
+  MOZ_RELEASE_ASSERT(data);
+  *length = reserved;
+  return data;
+}
+
+void Pickle::TrimBytes(uint32_t length) { buffers_.TrimBytes(length); }
+
 int32_t* Pickle::GetInt32PtrForTest(uint32_t offset) {
   size_t pos = buffers_.Size() - offset;
   BufferList::IterImpl iter(buffers_);
@@ -189,6 +189,18 @@ class Pickle {
 
   void InputBytes(const char* data, uint32_t length);
 
+  // Reserves free space at the end of the pickle and returns a pointer to it,
+  // so that incoming data can be produced directly into the pickle's buffers
+  // (e.g. read from a pipe) instead of being copied in through InputBytes.
+  // At most max_length contiguous bytes are reserved; the amount actually
+  // reserved is returned in *length. Call repeatedly to reserve more. Any
+  // reserved bytes that end up not being filled must be given back with
+  // TrimBytes before the pickle is used further.
+  char* ReserveBytes(uint32_t max_length, uint32_t* length);
+
+  // Gives back the last `length` bytes obtained from ReserveBytes.
+  void TrimBytes(uint32_t length);
+
   // Payload follows after allocation of Header (header size is customizable).
   struct Header {
     uint32_t payload_size;  // Specifies the size of the payload.
@@ -48,6 +48,12 @@ static const size_t kMaxIOVecSize = 256;
 static const size_t kMaxIOVecSize = 16;
 #endif
 
+// When several messages are queued for sending, they are coalesced into
+// batches of up to this many bytes so that a burst of small messages doesn't
+// cost one system call each. Larger messages are never split; they just cap
+// the batch they're in.
+static const size_t kMaxBatchedWriteSize = 256 * 1024;
+
 #ifdef MOZ_TASK_TRACER
 #  include "GeckoTaskTracerImpl.h"
 using namespace mozilla::tasktracer;
@@ -343,16 +349,55 @@ bool Channel::ChannelImpl::ProcessIncomingMessages() {
 
     if (pipe_ == -1) return false;
 
-    // In some cases the beginning of a message will be stored in input_buf_. We
-    // don't want to overwrite that, so we store the new data after it.
-    iov.iov_base = input_buf_ + input_buf_offset_;
-    iov.iov_len = Channel::kReadBufferSize - input_buf_offset_;
+    // If we're in the middle of receiving a large message, read the rest of
+    // its payload directly into its buffers instead of bouncing it through
+    // input_buf_ one kReadBufferSize chunk at a time.  The iovecs are capped
+    // at the number of bytes the message still needs, so bytes belonging to
+    // any subsequent message cannot land in its buffers.  Descriptors ride
+    // with a message's first chunk (see ProcessOutgoingMessages), which is
+    // always parsed out of input_buf_, so a read here carries no descriptors
+    // destined for another message.
+    struct iovec direct_iov[kMaxIOVecSize];
+    size_t direct_reserved = 0;
+    if (incoming_message_.isSome()) {
+      Message& m = incoming_message_.ref();
+      uint32_t remaining = m.size() - m.CurrentSize();
+      if (remaining >= Channel::kReadBufferSize) {
+        DCHECK(input_buf_offset_ == 0);
+        size_t direct_iov_count = 0;
+        while (direct_reserved < remaining && direct_iov_count < kMaxIOVecSize) {
+          uint32_t size;
+          char* data = m.ReserveBytes(remaining - direct_reserved, &size);
+          direct_iov[direct_iov_count].iov_base = data;
+          direct_iov[direct_iov_count].iov_len = size;
+          direct_iov_count++;
+          direct_reserved += size;
+        }
+        msg.msg_iov = direct_iov;
+        msg.msg_iovlen = direct_iov_count;
+      }
+    }
+
+    if (!direct_reserved) {
+      // In some cases the beginning of a message will be stored in input_buf_.
+      // We don't want to overwrite that, so we store the new data after it.
+      iov.iov_base = input_buf_ + input_buf_offset_;
+      iov.iov_len = Channel::kReadBufferSize - input_buf_offset_;
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+    }
 
     // Read from pipe.
     // recvmsg() returns 0 if the connection has closed or EAGAIN if no data
     // is waiting on the pipe.
     ssize_t bytes_read = HANDLE_EINTR(recvmsg(pipe_, &msg, MSG_DONTWAIT));
 
+    if (direct_reserved) {
+      // Give back whatever part of the reservation the read didn't fill.
+      incoming_message_.ref().TrimBytes(
+          direct_reserved - (bytes_read > 0 ? size_t(bytes_read) : 0));
+    }
+
     if (bytes_read < 0) {
       if (errno == EAGAIN) {
         return true;
@@ -412,9 +457,11 @@ bool Channel::ChannelImpl::ProcessIncomingMessages() {
       }
     }
 
-    // Process messages from input buffer.
+    // Process messages from input buffer.  A direct read put its bytes into
+    // incoming_message_, not input_buf_.
     const char* p = input_buf_;
-    const char* end = input_buf_ + input_buf_offset_ + bytes_read;
+    const char* end =
+        input_buf_ + input_buf_offset_ + (direct_reserved ? 0 : bytes_read);
 
     // A pointer to an array of |num_fds| file descriptors which includes any
     // fds that have spilled over from a previous read.
@@ -455,7 +502,12 @@ bool Channel::ChannelImpl::ProcessIncomingMessages() {
     // stored in incoming_message_ followed by data in input_buf_ (followed by
     // other messages).
 
-    while (p < end) {
+    // A direct read may have completed incoming_message_ without leaving
+    // anything to parse in input_buf_; enter the loop in that case too so the
+    // message gets dispatched.
+    while (p < end || (incoming_message_.isSome() &&
+                       incoming_message_.ref().CurrentSize() ==
+                           incoming_message_.ref().size())) {
       // Try to figure out how big the message is. Size is 0 if we haven't read
       // enough of the header to know the size.
       uint32_t message_length = 0;
@@ -487,8 +539,8 @@ bool Channel::ChannelImpl::ProcessIncomingMessages() {
         Message& m = incoming_message_.ref();
 
         // How much data from this message remains to be added to
-        // incoming_message_?
-        MOZ_ASSERT(message_length > m.CurrentSize());
+        // incoming_message_?  (None, if a direct read just completed it.)
+        MOZ_ASSERT(message_length >= m.CurrentSize());
         uint32_t remaining = message_length - m.CurrentSize();
 
         // How much data from this message is stored in input_buf_?
@@ -654,6 +706,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     struct iovec iov[kMaxIOVecSize];
     size_t iov_count = 0;
     size_t amt_to_write = 0;
+    bool iov_full = false;
 
     // How much of this message have we written so far?
     Pickle::BufferList::IterImpl iter = partial_write_iter_.value();
@@ -676,11 +729,63 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         iov[iov_count].iov_base = data;
         iov[iov_count].iov_len = size;
         iov_count++;
+      } else {
+        iov_full = true;
       }
       amt_to_write += size;
       iter.Advance(msg->Buffers(), size);
     }
 
+    // The bytes of the front message that this write is trying to push out;
+    // needed afterwards to tell how many batched messages completed.
+    const size_t first_msg_remaining = amt_to_write;
+
+    // Coalesce any following messages that carry no file descriptors into the
+    // same write, so a burst of small messages goes out with one system call
+    // instead of one each. Ordering is preserved because the batch is taken
+    // from the front of the queue in order, and message priorities only
+    // affect receiver-side processing, not the wire order. Messages with
+    // descriptors delimit a batch: each sendmsg can carry one SCM_RIGHTS
+    // block, which the receiver associates with the first message whose first
+    // chunk it reads.
+    size_t num_msgs_to_write = 1;
+    for (size_t i = 1; i < output_queue_.size() && !iov_full &&
+                       amt_to_write < kMaxBatchedWriteSize;
+         i++) {
+      Message* next = output_queue_[i];
+      if (!next->file_descriptor_set()->empty()) {
+        break;
+      }
+
+      // Include the message only if all of its segments fit; a partially
+      // represented message would make it impossible to tell a completed
+      // batch from a partial write.
+      const size_t checkpoint_iov_count = iov_count;
+      Pickle::BufferList::IterImpl next_iter(next->Buffers());
+      bool fits = true;
+      while (!next_iter.Done()) {
+        char* data = next_iter.Data();
+        size_t size = next_iter.RemainingInSegment();
+
+        if (iov_count == kMaxIOVecSize) {
+          fits = false;
+          break;
+        }
+        iov[iov_count].iov_base = data;
+        iov[iov_count].iov_len = size;
+        iov_count++;
+        next_iter.Advance(next->Buffers(), size);
+      }
+
+      if (!fits) {
+        iov_count = checkpoint_iov_count;
+        break;
+      }
+
+      amt_to_write += next->Buffers().Size();
+      num_msgs_to_write++;
+    }
+
     msgh.msg_iov = iov;
     msgh.msg_iovlen = iov_count;
 
@@ -733,8 +838,35 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     if (static_cast<size_t>(bytes_written) != amt_to_write) {
       // If write() fails with EAGAIN then bytes_written will be -1.
       if (bytes_written > 0) {
-        partial_write_iter_.ref().AdvanceAcrossSegments(msg->Buffers(),
-                                                        bytes_written);
+        // Pop every batched message the write covered completely, then
+        // remember how far into the first unfinished one we got.
+        size_t left = static_cast<size_t>(bytes_written);
+        size_t msg_remaining = first_msg_remaining;
+        while (left >= msg_remaining) {
+          left -= msg_remaining;
+          Message* m = output_queue_.front();
+          partial_write_iter_.reset();
+#if defined(OS_MACOSX)
+          if (!m->file_descriptor_set()->empty())
+            pending_fds_.push_back(
+                PendingDescriptors(m->fd_cookie(), m->file_descriptor_set()));
+#endif
+          OutputQueuePop();
+          delete m;
+
+          DCHECK(!output_queue_.empty());
+          msg_remaining = output_queue_.front()->Buffers().Size();
+        }
+
+        if (left) {
+          if (partial_write_iter_.isNothing()) {
+            Pickle::BufferList::IterImpl unfinished_iter(
+                output_queue_.front()->Buffers());
+            partial_write_iter_.emplace(unfinished_iter);
+          }
+          partial_write_iter_.ref().AdvanceAcrossSegments(
+              output_queue_.front()->Buffers(), left);
+        }
       }
 
       // Tell libevent to call us back once things are unblocked.
@@ -747,19 +879,23 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     } else {
       partial_write_iter_.reset();
 
+      // Whole batch sent OK!
+      for (size_t i = 0; i < num_msgs_to_write; i++) {
+        Message* m = output_queue_.front();
+
 #if defined(OS_MACOSX)
-      if (!msg->file_descriptor_set()->empty())
-        pending_fds_.push_back(
-            PendingDescriptors(msg->fd_cookie(), msg->file_descriptor_set()));
+        if (!m->file_descriptor_set()->empty())
+          pending_fds_.push_back(
+              PendingDescriptors(m->fd_cookie(), m->file_descriptor_set()));
 #endif
 
-        // Message sent OK!
 #ifdef IPC_MESSAGE_DEBUG_EXTRA
-      DLOG(INFO) << "sent message @" << msg << " on channel @" << this
-                 << " with type " << msg->type();
+        DLOG(INFO) << "sent message @" << m << " on channel @" << this
+                   << " with type " << m->type();
 #endif
-      OutputQueuePop();
-      delete msg;
+        OutputQueuePop();
+        delete m;
+      }
     }
   }
   return true;
@@ -844,12 +980,12 @@ void Channel::ChannelImpl::CloseDescriptors(uint32_t pending_fd_id) {
 #endif
 
 void Channel::ChannelImpl::OutputQueuePush(Message* msg) {
-  output_queue_.push(msg);
+  output_queue_.push_back(msg);
   output_queue_length_++;
 }
 
 void Channel::ChannelImpl::OutputQueuePop() {
-  output_queue_.pop();
+  output_queue_.pop_front();
   output_queue_length_--;
 }
 
@@ -4,9 +4,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include "mozilla/ipc/ForkServer.h"
+#include "BinaryPath.h"
+#include "mozilla/FileUtils.h"
 #include "mozilla/Logging.h"
 #include "chrome/common/chrome_switches.h"
 #include "mozilla/BlockingResourceBase.h"
+#include "nsString.h"
 #include "nsTraceRefcnt.h"
 
 #include <string.h>
@@ -225,6 +228,41 @@ void ForkServer::OnMessageReceived(IPC::Message&& message) {
   SanitizeBuffers(msg, argv, options);
 }
 
+/**
+ * Warm up state that forked children inherit, so that content
+ * processes don't have to pay for it again one by one.
+ *
+ * Everything done here must be fork-safe: no threads, no connections
+ * to daemons, no file descriptors the children shouldn't see.  Full
+ * XPCOM or JS engine initialization doesn't qualify — both create
+ * threads, and prefs arrive per-child over a remapped fd — so children
+ * still run their own startup.  What the template can do is make sure
+ * the bytes that startup reads are already resident: libxul is mapped
+ * (and relocated) in this process, and the omnijars are read ahead
+ * into the page cache here, once, instead of being faulted in by every
+ * child.
+ */
+static void WarmUpForkTemplate() {
+  UniqueFreePtr<char> exePath = BinaryPath::Get();
+  if (!exePath) {
+    return;
+  }
+  nsAutoCString greDir(exePath.get());
+  int32_t lastSlash = greDir.RFindChar('/');
+  if (lastSlash == kNotFound) {
+    return;
+  }
+  greDir.Truncate(lastSlash);
+
+  nsAutoCString greOmni(greDir);
+  greOmni.AppendLiteral("/omni.ja");
+  ReadAheadFile(greOmni.get());
+
+  nsAutoCString appOmni(greDir);
+  appOmni.AppendLiteral("/browser/omni.ja");
+  ReadAheadFile(appOmni.get());
+}
+
 /**
  * Setup and run a fork server at the main thread.
  *
@@ -257,6 +295,8 @@ bool ForkServer::RunForkServer(int* aArgc, char*** aArgv) {
   NS_LogInit();
   mozilla::LogModule::Init(0, nullptr);
   MOZ_LOG(gForkServiceLog, LogLevel::Verbose, ("Start a fork server"));
+
+  WarmUpForkTemplate();
   {
     DebugOnly<base::ProcessHandle> forkserver_pid = base::GetCurrentProcId();
     if (forkserver.HandleMessages()) {
@@ -207,13 +207,15 @@ enum TransferableOwnership {
 class CloneDataPolicy {
   bool allowIntraClusterClonableSharedObjects_;
   bool allowSharedMemoryObjects_;
+  bool copyTransferredArrayBuffers_;
 
  public:
   // The default is to deny all policy-controlled aspects.
 
   CloneDataPolicy()
       : allowIntraClusterClonableSharedObjects_(false),
-        allowSharedMemoryObjects_(false) {}
+        allowSharedMemoryObjects_(false),
+        copyTransferredArrayBuffers_(false) {}
 
   // SharedArrayBuffers and WASM modules can only be cloned intra-process
   // because the shared memory areas are allocated in process-private memory or
@@ -234,6 +236,19 @@ class CloneDataPolicy {
   bool areSharedMemoryObjectsAllowed() const {
     return allowSharedMemoryObjects_;
   }
+
+  // Transferring an ArrayBuffer normally steals its contents and detaches the
+  // source buffer. Embedders whose handoffs are semantically read-only can
+  // instead request that transferred ArrayBuffers be copied once into the
+  // clone data, leaving the source buffer attached; the receiving side still
+  // adopts the contents without a further copy. This halves the number of
+  // copies compared to a plain clone while keeping the source usable.
+
+  void copyTransferredArrayBuffers() { copyTransferredArrayBuffers_ = true; }
+
+  bool areTransferredArrayBuffersCopied() const {
+    return copyTransferredArrayBuffers_;
+  }
 };
 
 } /* namespace JS */
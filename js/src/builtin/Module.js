@@ -107,6 +107,36 @@ function ModuleResolveExport(exportName, resolveSet = [])
     // Step 1
     let module = this;
 
+    // A module's export entries are fixed after parsing, so the result of a
+    // top-level resolution request never changes. Cache resolved bindings per
+    // module: in large graphs the same exports are resolved repeatedly, once
+    // per importing module and again during namespace creation.
+    //
+    // Requests with a non-empty resolveSet are circularity probes made on
+    // behalf of another module's resolution. Their results depend on the set's
+    // contents, so they bypass the cache.
+    if (resolveSet.length !== 0)
+        return ResolveExportImpl(module, exportName, resolveSet);
+
+    let cache = UnsafeGetReservedSlot(module, MODULE_OBJECT_RESOLVED_EXPORTS_SLOT);
+    if (cache === undefined) {
+        cache = std_Object_create(null);
+        UnsafeSetReservedSlot(module, MODULE_OBJECT_RESOLVED_EXPORTS_SLOT, cache);
+    } else {
+        let cached = cache[exportName];
+        if (cached !== undefined)
+            return cached;
+    }
+
+    let resolution = ResolveExportImpl(module, exportName, resolveSet);
+    if (IsResolvedBinding(resolution))
+        _DefineDataProperty(cache, exportName, resolution);
+
+    return resolution;
+}
+
+function ResolveExportImpl(module, exportName, resolveSet)
+{
     // Step 2
     for (let i = 0; i < resolveSet.length; i++) {
         let r = resolveSet[i];
@@ -259,6 +259,7 @@ class ModuleObject : public NativeObject {
     FunctionDeclarationsSlot,
     DFSIndexSlot,
     DFSAncestorIndexSlot,
+    ResolvedExportsSlot,
     SlotCount
   };
 
@@ -272,6 +273,8 @@ class ModuleObject : public NativeObject {
                 "DFSIndexSlot must match self-hosting define");
   static_assert(DFSAncestorIndexSlot == MODULE_OBJECT_DFS_ANCESTOR_INDEX_SLOT,
                 "DFSAncestorIndexSlot must match self-hosting define");
+  static_assert(ResolvedExportsSlot == MODULE_OBJECT_RESOLVED_EXPORTS_SLOT,
+                "ResolvedExportsSlot must match self-hosting define");
 
   static const JSClass class_;
 
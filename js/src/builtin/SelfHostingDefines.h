@@ -109,6 +109,7 @@
 #define MODULE_OBJECT_EVALUATION_ERROR_SLOT 4
 #define MODULE_OBJECT_DFS_INDEX_SLOT 14
 #define MODULE_OBJECT_DFS_ANCESTOR_INDEX_SLOT 15
+#define MODULE_OBJECT_RESOLVED_EXPORTS_SLOT 16
 
 #define MODULE_STATUS_UNINSTANTIATED 0
 #define MODULE_STATUS_INSTANTIATING 1
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+"""Benchmark orchestrator and regression gate for the JS shell.
+
+Runs a suite of shell workloads with a statistical stopping rule, writes the
+results as JSON, and can diff two result files to gate a commit on a maximum
+allowed regression. This replaces hand-driven bisection runs: record a
+baseline once per commit, then gate candidate builds against it.
+
+Recording a baseline:
+
+    ./bench-gate.py --shell path/to/js --output baseline.json
+
+Gating a candidate build against it:
+
+    ./bench-gate.py --shell path/to/js --output candidate.json \\
+        --baseline baseline.json --threshold 3
+
+The exit status is non-zero if any workload regressed by more than the
+threshold (in percent), which makes the gate usable from make-check-style
+wrappers and CI alike.
+
+Workloads come from a JSON manifest (--suite), a list of entries like:
+
+    [{"name": "richards", "path": "richards.js", "args": []}, ...]
+
+with paths relative to the manifest. Without --suite, the octane suite is
+used if a js/src/octane checkout exists next to this script; otherwise a
+manifest is required. Each workload must print a single number (its score or
+runtime in ms) as the last whitespace-separated token of its output.
+
+Measurement notes: each workload is re-run until the median's bootstrap
+confidence interval is tighter than --precision percent, between --min-runs
+and --max-runs. Use --cpu to pin the shell to one core via taskset(1) where
+available; disabling dynamic CPU frequency scaling is left to the operator.
+"""
+
+import argparse
+import json
+import os
+import random
+import statistics
+import subprocess
+import sys
+
+
+def log(msg):
+    print(msg, file=sys.stderr)
+
+
+def default_suite():
+    octane = os.path.join(os.path.dirname(__file__), "..", "octane")
+    run_js = os.path.join(octane, "run.js")
+    if not os.path.exists(run_js):
+        return None
+    return [{"name": "octane", "path": os.path.abspath(run_js), "args": []}]
+
+
+def load_suite(path):
+    with open(path) as f:
+        entries = json.load(f)
+    base = os.path.dirname(os.path.abspath(path))
+    for entry in entries:
+        entry["path"] = os.path.join(base, entry["path"])
+    return entries
+
+
+def run_workload_once(args, entry):
+    cmd = []
+    if args.cpu is not None:
+        cmd += ["taskset", "-c", str(args.cpu)]
+    cmd += [args.shell] + args.shell_args + [entry["path"]] + entry.get(
+        "args", [])
+    output = subprocess.check_output(
+        cmd, cwd=os.path.dirname(entry["path"]), universal_newlines=True)
+    tokens = output.split()
+    if not tokens:
+        raise ValueError("workload %s produced no output" % entry["name"])
+    try:
+        return float(tokens[-1])
+    except ValueError:
+        raise ValueError("workload %s did not end its output with a number: "
+                         "%r" % (entry["name"], tokens[-1]))
+
+
+def median_ci_width_percent(samples, resamples=1000):
+    """Relative width of a bootstrapped 95% confidence interval around the
+    median, in percent of the median."""
+    medians = []
+    for _ in range(resamples):
+        resample = [random.choice(samples) for _ in samples]
+        medians.append(statistics.median(resample))
+    medians.sort()
+    low = medians[int(len(medians) * 0.025)]
+    high = medians[int(len(medians) * 0.975)]
+    mid = statistics.median(samples)
+    if mid == 0:
+        return 0.0
+    return 100.0 * (high - low) / mid
+
+
+def run_workload(args, entry):
+    samples = []
+    while True:
+        samples.append(run_workload_once(args, entry))
+        if len(samples) < args.min_runs:
+            continue
+        ci = median_ci_width_percent(samples)
+        if ci <= args.precision or len(samples) >= args.max_runs:
+            log("  %s: median %.2f over %d runs (ci %.2f%%)" %
+                (entry["name"], statistics.median(samples), len(samples), ci))
+            return {
+                "median": statistics.median(samples),
+                "runs": len(samples),
+                "ci_percent": ci,
+                "samples": samples,
+            }
+
+
+def gate(results, baseline, threshold, higher_is_better):
+    """Compares results against a baseline; returns the names of workloads
+    that regressed by more than the threshold."""
+    regressions = []
+    for name, result in sorted(results.items()):
+        base = baseline.get(name)
+        if base is None:
+            log("  %s: no baseline, skipping" % name)
+            continue
+        delta = 100.0 * (result["median"] - base["median"]) / base["median"]
+        regressed = (delta < -threshold) if higher_is_better \
+            else (delta > threshold)
+        log("  %s: %+.2f%% vs baseline%s" %
+            (name, delta, " (REGRESSION)" if regressed else ""))
+        if regressed:
+            regressions.append(name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--shell", required=True,
+                        help="path to the JS shell to benchmark")
+    parser.add_argument("--shell-args", default=[], type=str.split,
+                        help="extra arguments for the shell, quoted as one "
+                             "string")
+    parser.add_argument("--suite",
+                        help="JSON manifest of workloads; defaults to the "
+                             "octane suite if checked out")
+    parser.add_argument("--output", help="write results JSON here")
+    parser.add_argument("--baseline",
+                        help="results JSON to gate against")
+    parser.add_argument("--threshold", type=float, default=3.0,
+                        help="maximum tolerated regression in percent "
+                             "(default: 3)")
+    parser.add_argument("--lower-is-better", action="store_true",
+                        help="treat the reported number as a runtime rather "
+                             "than a score")
+    parser.add_argument("--min-runs", type=int, default=5)
+    parser.add_argument("--max-runs", type=int, default=30)
+    parser.add_argument("--precision", type=float, default=2.0,
+                        help="keep re-running until the median's confidence "
+                             "interval is within this percent (default: 2)")
+    parser.add_argument("--cpu", type=int,
+                        help="pin the shell to this CPU with taskset")
+    args = parser.parse_args()
+
+    if args.suite:
+        suite = load_suite(args.suite)
+    else:
+        suite = default_suite()
+        if suite is None:
+            parser.error("no js/src/octane checkout found; pass --suite")
+
+    log("Benchmarking %s" % args.shell)
+    results = {}
+    for entry in suite:
+        results[entry["name"]] = run_workload(args, entry)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        log("Results written to %s" % args.output)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        log("Gating against %s (threshold %.1f%%)" %
+            (args.baseline, args.threshold))
+        regressions = gate(results, baseline, args.threshold,
+                           not args.lower_is_better)
+        if regressions:
+            log("FAILED: regressions in: %s" % ", ".join(regressions))
+            return 1
+        log("Gate passed.")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -66,12 +66,14 @@ class DenseBitmap {
 };
 
 class SparseBitmap {
+ public:
   // The number of words of bits to use for each block mainly affects the
   // memory usage of the bitmap. To minimize overhead, bitmaps which are
   // expected to be fairly dense should have a large block size, and bitmaps
   // which are expected to be very sparse should have a small block size.
   static const size_t WordsInBlock = 4096 / sizeof(uintptr_t);
 
+ private:
   using BitBlock = mozilla::Array<uintptr_t, WordsInBlock>;
   using Data =
       HashMap<size_t, BitBlock*, DefaultHasher<size_t>, SystemAllocPolicy>;
@@ -142,6 +142,18 @@ void LifoAlloc::freeAll() {
   MOZ_ASSERT(curSize_ == 0);
 }
 
+void LifoAlloc::freeUnusedOver(size_t maxRetainedSize) {
+  MOZ_ASSERT(isEmpty());
+
+  size_t retainedSize = retainedSizeOfExcludingThis();
+  while (retainedSize > maxRetainedSize && !unused_.empty()) {
+    UniqueBumpChunk bc = unused_.popFirst();
+    size_t size = bc->computedSizeOfIncludingThis();
+    retainedSize -= size;
+    decrementCurSize(size);
+  }
+}
+
 // Round at the same page granularity used by malloc.
 static size_t MallocGoodSize(size_t aSize) {
 #if defined(MOZ_MEMORY)
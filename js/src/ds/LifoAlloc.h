@@ -634,6 +634,11 @@ class LifoAlloc {
   // Frees all held memory.
   void freeAll();
 
+  // Frees unused chunks until at most |maxRetainedSize| bytes are held,
+  // keeping the rest warm for reuse by a later consumer. All in-use memory
+  // must have been released first.
+  void freeUnusedOver(size_t maxRetainedSize);
+
   static const unsigned HUGE_ALLOCATION = 50 * 1024 * 1024;
   void freeAllIfHugeAndUnused() {
     if (markCount == 0 && curSize_ > HUGE_ALLOCATION) {
@@ -871,6 +876,15 @@ class LifoAlloc {
   // bookkeeping space).
   size_t peakSizeOfExcludingThis() const { return peakSize_; }
 
+  // Get the total size of the unused chunks retained for reuse.
+  size_t retainedSizeOfExcludingThis() const {
+    size_t n = 0;
+    for (const detail::BumpChunk& chunk : unused_) {
+      n += chunk.computedSizeOfIncludingThis();
+    }
+    return n;
+  }
+
   // Doesn't perform construction; useful for lazily-initialized POD types.
   template <typename T>
   MOZ_ALWAYS_INLINE T* pod_malloc() {
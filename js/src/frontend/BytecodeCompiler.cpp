@@ -9,6 +9,7 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/Maybe.h"
+#include "mozilla/Unused.h"
 #include "mozilla/Utf8.h"  // mozilla::Utf8Unit
 
 #include "builtin/ModuleObject.h"
@@ -26,10 +27,13 @@
 #include "frontend/ModuleSharedContext.h"
 #include "frontend/Parser.h"
 #include "js/SourceText.h"
+#include "js/Transcoding.h"
 #include "vm/GlobalObject.h"
 #include "vm/JSContext.h"
 #include "vm/JSScript.h"
 #include "vm/ModuleBuilder.h"  // js::ModuleBuilder
+#include "vm/Runtime.h"
+#include "vm/ScriptBytecodeCache.h"
 #include "vm/TraceLogging.h"
 #include "wasm/AsmJS.h"
 
@@ -195,9 +199,39 @@ template <typename Unit>
 static JSScript* CreateGlobalScript(CompilationInfo& compilationInfo,
                                     GlobalSharedContext& globalsc,
                                     JS::SourceText<Unit>& srcBuf) {
-  AutoAssertReportedException assertException(compilationInfo.cx);
+  JSContext* cx = compilationInfo.cx;
 
-  LifoAllocScope allocScope(&compilationInfo.cx->tempLifoAlloc());
+  // If the embedder enabled the bytecode cache, try to decode a previous
+  // compilation of the same source and options instead of parsing. Scripts
+  // compiled for a non-syntactic scope are excluded as XDR does not support
+  // their encoding.
+  ScriptBytecodeCache* cache = nullptr;
+  ScriptBytecodeCache::Key key;
+  if (!cx->isHelperThreadContext() &&
+      cx->runtime()->scriptBytecodeCache.ref() &&
+      !compilationInfo.options.nonSyntacticScope) {
+    cache = cx->runtime()->scriptBytecodeCache.ref().get();
+    key = ScriptBytecodeCache::ComputeKey(
+        srcBuf.units(), sizeof(Unit), srcBuf.length(), compilationInfo.options);
+    JS::TranscodeRange range;
+    if (cache->lookup(key, &range)) {
+      RootedScript script(cx);
+      JS::TranscodeResult res = JS::DecodeScript(cx, range, &script);
+      if (res == JS::TranscodeResult_Ok) {
+        tellDebuggerAboutCompiledScript(cx, script);
+        return script;
+      }
+      if (res == JS::TranscodeResult_Throw) {
+        return nullptr;
+      }
+      // Fall through and compile normally on any other failure, for example
+      // a corrupt or incompatible imported entry.
+    }
+  }
+
+  AutoAssertReportedException assertException(cx);
+
+  LifoAllocScope allocScope(&cx->tempLifoAlloc());
   frontend::ScriptCompiler<Unit> compiler(srcBuf);
 
   if (!compiler.prepareScriptParse(allocScope, compilationInfo)) {
@@ -208,7 +242,18 @@ static JSScript* CreateGlobalScript(CompilationInfo& compilationInfo,
     return nullptr;
   }
 
-  tellDebuggerAboutCompiledScript(compilationInfo.cx, compilationInfo.script);
+  tellDebuggerAboutCompiledScript(cx, compilationInfo.script);
+
+  if (cache) {
+    JS::TranscodeBuffer buffer;
+    RootedScript script(cx, compilationInfo.script);
+    if (JS::EncodeScript(cx, buffer, script) == JS::TranscodeResult_Ok) {
+      // Failure to cache is not fatal to the compilation.
+      mozilla::Unused << cache->put(key, std::move(buffer));
+    } else if (cx->isExceptionPending()) {
+      cx->clearPendingException();
+    }
+  }
 
   assertException.reset();
   return compilationInfo.script;
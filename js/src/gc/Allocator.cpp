@@ -827,6 +827,7 @@ Chunk* Chunk::allocate(GCRuntime* gc) {
     return nullptr;
   }
   gc->stats().count(gcstats::COUNT_NEW_CHUNK);
+  gc->schedulingState.noteFreshChunkAllocated();
   return chunk;
 }
 
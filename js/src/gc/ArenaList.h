@@ -32,6 +32,7 @@ namespace gc {
 class Arena;
 struct FinalizePhase;
 class FreeSpan;
+class StringDeduplicator;
 class TenuredCell;
 
 /*
@@ -145,7 +146,8 @@ class ArenaList {
   Arena** pickArenasToRelocate(size_t& arenaTotalOut, size_t& relocTotalOut);
   Arena* relocateArenas(Arena* toRelocate, Arena* relocated,
                         js::SliceBudget& sliceBudget,
-                        gcstats::Statistics& stats);
+                        gcstats::Statistics& stats,
+                        StringDeduplicator& dedupStrings);
 };
 
 /*
@@ -336,7 +338,8 @@ class ArenaLists {
   void checkEmptyArenaList(AllocKind kind);
 
   bool relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
-                      js::SliceBudget& sliceBudget, gcstats::Statistics& stats);
+                      js::SliceBudget& sliceBudget, gcstats::Statistics& stats,
+                      StringDeduplicator& dedupStrings);
 
   void queueForegroundObjectsForSweep(JSFreeOp* fop);
   void queueForegroundThingsForSweep();
@@ -6,8 +6,10 @@
 
 #include "gc/AtomMarking-inl.h"
 
+#include "gc/ParallelWork.h"
 #include "gc/PublicIterators.h"
 #include "vm/Realm.h"
+#include "vm/Runtime.h"
 
 #include "gc/GC-inl.h"
 #include "gc/Heap-inl.h"
@@ -126,22 +128,115 @@ static void BitwiseOrIntoChunkMarkBits(JSRuntime* runtime, Bitmap& bitmap) {
   }
 }
 
+using ZoneBitmapVector =
+    Vector<const SparseBitmap*, 16, SystemAllocPolicy>;
+
+// A range of words in the atoms bitmap for one parallel worker to union,
+// together with the bitmaps to union and where to accumulate the result.
+// Ranges are disjoint between work items so no synchronization is needed on
+// the target bitmap.
+struct AtomBitmapWordRange {
+  const ZoneBitmapVector* bitmaps;
+  DenseBitmap* target;
+  size_t wordStart;
+  size_t wordCount;
+};
+
+// Produces block-aligned ranges of the atoms bitmap for parallel workers to
+// process.
+class AtomBitmapWordRanges {
+ public:
+  // The number of bitmap words handed to a worker at a time: 16 sparse
+  // bitmap blocks, or 64 KB of bitmap on 64 bit platforms.
+  static const size_t RangeWords = 16 * SparseBitmap::WordsInBlock;
+
+  AtomBitmapWordRanges(const ZoneBitmapVector* bitmaps, DenseBitmap* target,
+                       size_t numWords)
+      : bitmaps(bitmaps), target(target), wordStart(0), numWords(numWords) {}
+
+  bool done() const { return wordStart >= numWords; }
+
+  AtomBitmapWordRange get() const {
+    MOZ_ASSERT(!done());
+    return {bitmaps, target, wordStart,
+            std::min(RangeWords, numWords - wordStart)};
+  }
+
+  void next() {
+    MOZ_ASSERT(!done());
+    wordStart += RangeWords;
+  }
+
+ private:
+  const ZoneBitmapVector* bitmaps;
+  DenseBitmap* target;
+  size_t wordStart;
+  size_t numWords;
+};
+
+static size_t UnionZoneAtomBitmapRange(GCRuntime* gc,
+                                       const AtomBitmapWordRange& range) {
+  // SparseBitmap::bitwiseOrRangeInto only operates within a single bit
+  // block, so process the range block by block. The source bitmaps are only
+  // read and the target words are not shared with any other work item.
+  size_t end = range.wordStart + range.wordCount;
+  for (const SparseBitmap* bitmap : *range.bitmaps) {
+    for (size_t start = range.wordStart; start < end;
+         start += SparseBitmap::WordsInBlock) {
+      size_t numWords = std::min(SparseBitmap::WordsInBlock, end - start);
+      bitmap->bitwiseOrRangeInto(start, numWords, &range.target->word(start));
+    }
+  }
+  return range.wordCount;
+}
+
+static size_t AtomBitmapTaskCount() {
+  // Same heuristic as CellUpdateBackgroundTaskCount in GC.cpp.
+  if (!CanUseExtraThreads()) {
+    return 1;  // GCRuntime::startTask will run the work on the main thread.
+  }
+
+  size_t targetTaskCount = HelperThreadState().cpuCount / 2;
+  return std::min(std::max(targetTaskCount, size_t(1)), MaxParallelWorkers);
+}
+
 void AtomMarkingRuntime::markAtomsUsedByUncollectedZones(JSRuntime* runtime) {
   MOZ_ASSERT(CurrentThreadIsPerformingGC());
   MOZ_ASSERT(!runtime->hasHelperThreadZones());
 
+  // We only need to update the chunk mark bits for zones which were not
+  // collected in the current GC. Atoms which are referenced by collected
+  // zones have already been marked.
+  ZoneBitmapVector bitmaps;
+  bool ok = true;
+  for (ZonesIter zone(runtime, SkipAtoms); !zone.done(); zone.next()) {
+    if (!zone->isCollectingFromAnyThread()) {
+      if (!bitmaps.append(&zone->markedAtoms())) {
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  if (ok && bitmaps.empty()) {
+    return;
+  }
+
   // Try to compute a simple union of the zone atom bitmaps before updating
-  // the chunk mark bitmaps. If this allocation fails then fall back to
-  // updating the chunk mark bitmaps separately for each zone.
+  // the chunk mark bitmaps. This is linear in the number of uncollected
+  // zones times the size of the atoms bitmap, and disjoint word ranges of
+  // the union are independent, so farm the work out to helper threads. If
+  // allocation fails then fall back to updating the chunk mark bitmaps
+  // separately for each zone.
   DenseBitmap markedUnion;
-  if (markedUnion.ensureSpace(allocatedWords)) {
-    for (ZonesIter zone(runtime, SkipAtoms); !zone.done(); zone.next()) {
-      // We only need to update the chunk mark bits for zones which were
-      // not collected in the current GC. Atoms which are referenced by
-      // collected zones have already been marked.
-      if (!zone->isCollectingFromAnyThread()) {
-        zone->markedAtoms().bitwiseOrInto(markedUnion);
-      }
+  if (ok && markedUnion.ensureSpace(allocatedWords)) {
+    GCRuntime* gc = &runtime->gc;
+    AtomBitmapWordRanges work(&bitmaps, &markedUnion, allocatedWords);
+    {
+      AutoLockHelperThreadState lock;
+      AutoRunParallelWork unionRanges(
+          gc, UnionZoneAtomBitmapRange, gcstats::PhaseKind::UPDATE_ATOMS_BITMAP,
+          work, AtomBitmapTaskCount(), SliceBudget::unlimited(), lock);
     }
     BitwiseOrIntoChunkMarkBits(runtime, markedUnion);
   } else {
@@ -717,8 +717,13 @@ ChunkPool GCRuntime::expireEmptyChunkPool(const AutoLockGC& lock) {
   MOZ_ASSERT(tunables.minEmptyChunkCount(lock) <=
              tunables.maxEmptyChunkCount());
 
+  // Retain enough empty chunks to cover the recent demand for fresh chunks,
+  // so that bursty workloads are served from the pool instead of oscillating
+  // between releasing chunks to the OS and faulting them back in.
+  uint32_t target = schedulingState.emptyChunkTargetCount(tunables, lock);
+
   ChunkPool expired;
-  while (emptyChunks(lock).count() > tunables.minEmptyChunkCount(lock)) {
+  while (emptyChunks(lock).count() > target) {
     Chunk* chunk = emptyChunks(lock).pop();
     prepareToFreeChunk(chunk->info);
     expired.push(chunk);
@@ -727,7 +732,6 @@ ChunkPool GCRuntime::expireEmptyChunkPool(const AutoLockGC& lock) {
   MOZ_ASSERT(expired.verify());
   MOZ_ASSERT(emptyChunks(lock).verify());
   MOZ_ASSERT(emptyChunks(lock).count() <= tunables.maxEmptyChunkCount());
-  MOZ_ASSERT(emptyChunks(lock).count() <= tunables.minEmptyChunkCount(lock));
   return expired;
 }
 
@@ -1909,7 +1913,103 @@ static void RelocateCell(Zone* zone, TenuredCell* src, AllocKind thingKind,
   overlay->forwardTo(dst);
 }
 
-static void RelocateArena(Arena* arena, SliceBudget& sliceBudget) {
+/*
+ * Compacting visits every cell that is about to move, which makes it a
+ * convenient point to merge duplicated strings as well: instead of relocating
+ * a string whose contents we have already relocated, forward it to the
+ * existing copy and let the pointer update phase redirect every reference
+ * there. Only inline strings participate: they own no characters whose
+ * ownership would have to be merged, and nothing points into their storage
+ * from outside the cell (dependent strings never retain an inline base).
+ * One instance covers the relocation of a single zone, so strings are never
+ * merged across zone boundaries.
+ */
+namespace js {
+namespace gc {
+
+class StringDeduplicator {
+  struct StringHasher {
+    using Lookup = JSLinearString*;
+    static HashNumber hash(const Lookup& s) { return HashStringChars(s); }
+    static bool match(JSLinearString* entry, const Lookup& lookup) {
+      return EqualStrings(entry, lookup);
+    }
+  };
+
+  // The relocated copy of each distinct string seen so far, keyed by
+  // contents. If adding an entry fails under memory pressure we merely miss
+  // a merge opportunity; compaction itself is unaffected.
+  HashSet<JSLinearString*, StringHasher, SystemAllocPolicy> relocated_;
+
+  static bool isDeduplicatable(JSString* str) {
+    return str->isLinear() && str->isInline();
+  }
+
+  static bool canForwardTo(Zone* zone, TenuredCell* src, JSLinearString* dst) {
+    // The relocated arenas are checked again afterwards to verify that
+    // source and destination mark bits agree, and barriers rely on that
+    // invariant too, so only merge cells in the same mark state.
+    if (src->isMarkedBlack() != dst->asTenured().isMarkedBlack() ||
+        src->isMarkedGray() != dst->asTenured().isMarkedGray()) {
+      return false;
+    }
+
+    // A unique id pins the cell's identity. RelocateCell transfers it, but
+    // merging two cells would require merging their ids as well, so leave
+    // such strings alone.
+    return !zone->hasUniqueId(src);
+  }
+
+  static void forwardToCopy(TenuredCell* src, JSLinearString* dst,
+                            size_t thingSize) {
+    // Poison the source cell contents just like RelocateCell does.
+#ifdef DEBUG
+    AlwaysPoison(reinterpret_cast<uint8_t*>(src) + sizeof(uintptr_t),
+                 JS_MOVED_TENURED_PATTERN, thingSize - sizeof(uintptr_t),
+                 MemCheckKind::MakeNoAccess);
+#endif
+
+    RelocationOverlay::fromCell(src)->forwardTo(&dst->asTenured());
+  }
+
+ public:
+  /*
+   * Relocate the string cell |src|, forwarding it to an already-relocated
+   * string with equal contents when possible instead of copying it again.
+   * Returns true when the cell was merged that way.
+   */
+  bool relocateString(Zone* zone, TenuredCell* src, AllocKind thingKind,
+                      size_t thingSize) {
+    MOZ_ASSERT(thingKind == AllocKind::STRING ||
+               thingKind == AllocKind::FAT_INLINE_STRING);
+
+    JSString* str = static_cast<JSString*>(static_cast<Cell*>(src));
+    if (!isDeduplicatable(str)) {
+      RelocateCell(zone, src, thingKind, thingSize);
+      return false;
+    }
+
+    JSLinearString* linear = &str->asLinear();
+    auto p = relocated_.lookupForAdd(linear);
+    if (p && canForwardTo(zone, src, *p)) {
+      forwardToCopy(src, *p, thingSize);
+      return true;
+    }
+
+    RelocateCell(zone, src, thingKind, thingSize);
+    if (!p) {
+      (void)relocated_.add(p, Forwarded(linear));
+    }
+    return false;
+  }
+};
+
+}  // namespace gc
+}  // namespace js
+
+static void RelocateArena(Arena* arena, SliceBudget& sliceBudget,
+                          gcstats::Statistics& stats,
+                          StringDeduplicator& dedupStrings) {
   MOZ_ASSERT(arena->allocated());
   MOZ_ASSERT(!arena->onDelayedMarkingList());
   MOZ_ASSERT(arena->bufferedCells()->isEmpty());
@@ -1919,8 +2019,18 @@ static void RelocateArena(Arena* arena, SliceBudget& sliceBudget) {
   AllocKind thingKind = arena->getAllocKind();
   size_t thingSize = arena->getThingSize();
 
+  bool isStringKind = thingKind == AllocKind::STRING ||
+                      thingKind == AllocKind::FAT_INLINE_STRING;
+
   for (ArenaCellIterUnderGC i(arena); !i.done(); i.next()) {
-    RelocateCell(zone, i.getCell(), thingKind, thingSize);
+    TenuredCell* src = i.getCell();
+    if (isStringKind) {
+      if (dedupStrings.relocateString(zone, src, thingKind, thingSize)) {
+        stats.count(gcstats::COUNT_STRINGS_DEDUPLICATED);
+      }
+    } else {
+      RelocateCell(zone, src, thingKind, thingSize);
+    }
     sliceBudget.step();
   }
 
@@ -1960,12 +2070,13 @@ static inline bool ShouldProtectRelocatedArenas(JS::GCReason reason) {
  */
 Arena* ArenaList::relocateArenas(Arena* toRelocate, Arena* relocated,
                                  SliceBudget& sliceBudget,
-                                 gcstats::Statistics& stats) {
+                                 gcstats::Statistics& stats,
+                                 StringDeduplicator& dedupStrings) {
   check();
 
   while (Arena* arena = toRelocate) {
     toRelocate = arena->next;
-    RelocateArena(arena, sliceBudget);
+    RelocateArena(arena, sliceBudget, stats, dedupStrings);
     // Prepend to list of relocated arenas
     arena->next = relocated;
     relocated = arena;
@@ -2006,7 +2117,8 @@ static AllocKinds CompactingAllocKinds() {
 
 bool ArenaLists::relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
                                 SliceBudget& sliceBudget,
-                                gcstats::Statistics& stats) {
+                                gcstats::Statistics& stats,
+                                StringDeduplicator& dedupStrings) {
   // This is only called from the main thread while we are doing a GC, so
   // there is no need to lock.
   MOZ_ASSERT(CurrentThreadCanAccessRuntime(runtime()));
@@ -2025,8 +2137,8 @@ bool ArenaLists::relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
       ArenaList& al = arenaLists(kind);
       Arena* allArenas = al.head();
       al.clear();
-      relocatedListOut =
-          al.relocateArenas(allArenas, relocatedListOut, sliceBudget, stats);
+      relocatedListOut = al.relocateArenas(allArenas, relocatedListOut,
+                                           sliceBudget, stats, dedupStrings);
     }
   } else {
     size_t arenaCount = 0;
@@ -2047,8 +2159,8 @@ bool ArenaLists::relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
       if (toRelocate[kind]) {
         ArenaList& al = arenaLists(kind);
         Arena* arenas = al.removeRemainingArenas(toRelocate[kind]);
-        relocatedListOut =
-            al.relocateArenas(arenas, relocatedListOut, sliceBudget, stats);
+        relocatedListOut = al.relocateArenas(arenas, relocatedListOut,
+                                             sliceBudget, stats, dedupStrings);
       }
     }
   }
@@ -2066,8 +2178,9 @@ bool GCRuntime::relocateArenas(Zone* zone, JS::GCReason reason,
 
   js::CancelOffThreadIonCompile(rt, JS::Zone::Compact);
 
+  StringDeduplicator dedupStrings;
   if (!zone->arenas.relocateArenas(relocatedListOut, reason, sliceBudget,
-                                   stats())) {
+                                   stats(), dedupStrings)) {
     return false;
   }
 
@@ -3143,6 +3256,13 @@ void GCRuntime::startDecommit() {
     return;
   }
 
+  // A shrinking GC is an explicit request to give back as much memory as
+  // possible, so drop the allocation rate history and let the empty chunk
+  // pool shrink back to the minimum.
+  if (cleanUpEverything) {
+    schedulingState.resetChunkAllocationRate();
+  }
+
   BackgroundDecommitTask::ChunkVector toDecommit;
   {
     AutoLockGC lock(this);
@@ -3203,6 +3323,10 @@ void js::gc::BackgroundDecommitTask::run() {
   }
   toDecommit.ref().clearAndFree();
 
+  // Fold the number of chunks mapped since the last decommit pass into the
+  // allocation rate history used to size the retained empty chunk pool.
+  gc->schedulingState.updateChunkAllocationRate();
+
   ChunkPool toFree = gc->expireEmptyChunkPool(lock);
   if (toFree.count()) {
     AutoUnlockGC unlock(lock);
@@ -3625,6 +3749,16 @@ void GCRuntime::purgeRuntime() {
   cx->interpreterStack().purge(rt);
   cx->frontendCollectionPool().purge();
 
+  // The megamorphic property cache's counters are about to be reset by the
+  // purge, so report its hit rate first. Skip mostly idle periods so the
+  // telemetry reflects workloads that actually exercised the cache.
+  MegamorphicCache& megamorphicCache = rt->caches().megamorphicCache;
+  if (megamorphicCache.numLookups() >= 1000) {
+    uint32_t hitRate = uint32_t(megamorphicCache.numHits() * 100 /
+                                megamorphicCache.numLookups());
+    rt->addTelemetry(JS_TELEMETRY_MEGAMORPHIC_CACHE_HIT_RATE, hitRate);
+  }
+
   rt->caches().purge();
 
   if (auto cache = rt->maybeThisRuntimeSharedImmutableStrings()) {
@@ -4233,6 +4367,10 @@ void GCRuntime::markWeakReferences(gcstats::PhaseKind phase) {
   gcstats::AutoPhase ap1(stats(), phase);
 
   if (marker.enterWeakMarkingMode()) {
+    // Populate the inverted key -> weakmap entry tables. From here on,
+    // marking a key looks up only the entries it keeps alive, so ephemeron
+    // marking is linear in the number of weak edges.
+    gcstats::AutoPhase ap2(stats(), gcstats::PhaseKind::MARK_WEAKMAPS);
     for (ZoneIterT zone(this); !zone.done(); zone.next()) {
       zone->enterWeakMarkingMode(&marker);
     }
@@ -4249,6 +4387,9 @@ void GCRuntime::markWeakReferences(gcstats::PhaseKind phase) {
   for (;;) {
     bool markedAny = false;
     if (!marker.isWeakMarking()) {
+      // Linear weak marking has been aborted; fall back on repeatedly
+      // scanning every entry of every live weakmap until a fixpoint.
+      gcstats::AutoPhase ap2(stats(), gcstats::PhaseKind::MARK_WEAKMAPS);
       for (ZoneIterT zone(this); !zone.done(); zone.next()) {
         markedAny |= WeakMapBase::markZoneIteratively(zone, &marker);
       }
@@ -4908,6 +5049,11 @@ void GCRuntime::sweepCCWrappers() {
   AutoSetThreadIsSweeping threadIsSweeping;  // This can touch all zones.
   for (SweepGroupZonesIter zone(this); !zone.done(); zone.next()) {
     zone->sweepAllCrossCompartmentWrappers();
+    if (isShrinkingGC()) {
+      // Wrapper tables only ever shed entries during sweeping, so take the
+      // opportunity to return the excess table capacity on shrinking GCs.
+      zone->compactAllCrossCompartmentWrappers();
+    }
   }
 }
 
@@ -83,6 +83,10 @@ JoinParallelTasksPhaseKind = PhaseKind("JOIN_PARALLEL_TASKS", "Join Parallel Tas
 
 UnmarkGrayPhaseKind = PhaseKind("UNMARK_GRAY", "Unmark gray", 56)
 
+# Weakmap marking is done both for black and for gray marking, so this phase
+# also appears in several places in the graph.
+MarkWeakMapsPhaseKind = PhaseKind("MARK_WEAKMAPS", "Mark WeakMaps", 77)
+
 PhaseKindGraphRoots = [
     PhaseKind("MUTATOR", "Mutator Running", 0),
     PhaseKind("GC_BEGIN", "Begin Callback", 1),
@@ -116,6 +120,7 @@ PhaseKindGraphRoots = [
             ]),
             PhaseKind("SWEEP_MARK_WEAK", "Mark Weak", 13, [
                 UnmarkGrayPhaseKind,
+                MarkWeakMapsPhaseKind,
             ]),
             PhaseKind("SWEEP_MARK_INCOMING_GRAY", "Mark Incoming Gray Pointers", 14),
             PhaseKind("SWEEP_MARK_GRAY", "Mark Gray", 15, [
@@ -123,6 +128,7 @@ PhaseKindGraphRoots = [
             ]),
             PhaseKind("SWEEP_MARK_GRAY_WEAK", "Mark Gray and Weak", 16, [
                 UnmarkGrayPhaseKind,
+                MarkWeakMapsPhaseKind,
             ]),
         ]),
         PhaseKind("FINALIZE_START", "Finalize Start Callbacks", 17, [
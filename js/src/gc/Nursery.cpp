@@ -466,6 +466,7 @@ Cell* js::Nursery::allocateString(Zone* zone, size_t size, AllocKind kind) {
     return nullptr;
   }
   header->zone = zone;
+  zone->nurseryAllocatedStrings++;
 
   auto cell = reinterpret_cast<Cell*>(&header->cell);
   gcTracer.traceNurseryAlloc(cell, kind);
@@ -483,6 +484,7 @@ Cell* js::Nursery::allocateBigInt(Zone* zone, size_t size, AllocKind kind) {
     return nullptr;
   }
   header->zone = zone;
+  zone->nurseryAllocatedBigInts++;
 
   auto cell = reinterpret_cast<Cell*>(&header->cell);
   gcTracer.traceNurseryAlloc(cell, kind);
@@ -842,11 +844,19 @@ void js::Nursery::renderProfileJSON(JSONPrinter& json) const {
         "nursery_string_realms_disabled",
         stats().getStat(gcstats::STAT_NURSERY_STRING_REALMS_DISABLED));
   }
+  if (stats().getStat(gcstats::STAT_NURSERY_STRING_REALMS_ENABLED)) {
+    json.property("nursery_string_realms_enabled",
+                  stats().getStat(gcstats::STAT_NURSERY_STRING_REALMS_ENABLED));
+  }
   if (stats().getStat(gcstats::STAT_NURSERY_BIGINT_REALMS_DISABLED)) {
     json.property(
         "nursery_bigint_realms_disabled",
         stats().getStat(gcstats::STAT_NURSERY_BIGINT_REALMS_DISABLED));
   }
+  if (stats().getStat(gcstats::STAT_NURSERY_BIGINT_REALMS_ENABLED)) {
+    json.property("nursery_bigint_realms_enabled",
+                  stats().getStat(gcstats::STAT_NURSERY_BIGINT_REALMS_ENABLED));
+  }
 
   json.beginObjectProperty("phase_times");
 
@@ -1234,14 +1244,42 @@ float js::Nursery::doPretenuring(JSRuntime* rt, JS::GCReason reason,
   mozilla::Maybe<AutoGCSession> session;
   uint32_t numStringsTenured = 0;
   uint32_t numNurseryStringRealmsDisabled = 0;
+  uint32_t numNurseryStringRealmsEnabled = 0;
   uint32_t numBigIntsTenured = 0;
   uint32_t numNurseryBigIntRealmsDisabled = 0;
+  uint32_t numNurseryBigIntRealmsEnabled = 0;
   for (ZonesIter zone(gc, SkipAtoms); !zone.done(); zone.next()) {
-    bool disableNurseryStrings = pretenureStr && zone->allocNurseryStrings &&
-                                 zone->tenuredStrings >= 30 * 1000;
-    bool disableNurseryBigInts = pretenureBigInt && zone->allocNurseryBigInts &&
-                                 zone->tenuredBigInts >= 30 * 1000;
-    if (disableNurseryStrings || disableNurseryBigInts) {
+    // Disable nursery allocation for a cell kind only if tenuring is both
+    // heavy in absolute terms and accounts for most of what the zone
+    // allocated in the nursery. A zone churning through large numbers of
+    // short-lived strings can exceed any absolute threshold while still
+    // benefitting from nursery allocation.
+    bool disableNurseryStrings =
+        pretenureStr && zone->allocNurseryStrings &&
+        zone->tenuredStrings >= 30 * 1000 &&
+        zone->tenuredStrings >= zone->nurseryAllocatedStrings / 2;
+    bool disableNurseryBigInts =
+        pretenureBigInt && zone->allocNurseryBigInts &&
+        zone->tenuredBigInts >= 30 * 1000 &&
+        zone->tenuredBigInts >= zone->nurseryAllocatedBigInts / 2;
+
+    // The tenured counters carry no signal once allocation bypasses the
+    // nursery, so a disabled zone would otherwise stay disabled forever.
+    // Allocation behavior is often phase-dependent: give the nursery
+    // another chance after a cooldown and let the counters decide afresh.
+    bool enableNurseryStrings = false;
+    if (!zone->allocNurseryStrings) {
+      zone->nurseryStringsDisabledCollections++;
+      enableNurseryStrings = zone->nurseryStringsDisabledCollections >= 200;
+    }
+    bool enableNurseryBigInts = false;
+    if (!zone->allocNurseryBigInts) {
+      zone->nurseryBigIntsDisabledCollections++;
+      enableNurseryBigInts = zone->nurseryBigIntsDisabledCollections >= 200;
+    }
+
+    if (disableNurseryStrings || disableNurseryBigInts ||
+        enableNurseryStrings || enableNurseryBigInts) {
       if (!session.isSome()) {
         session.emplace(gc, JS::HeapState::MinorCollecting);
       }
@@ -1256,30 +1294,47 @@ float js::Nursery::doPretenuring(JSRuntime* rt, JS::GCReason reason,
           if (disableNurseryStrings) {
             jitRealm->setStringsCanBeInNursery(false);
             numNurseryStringRealmsDisabled++;
+          } else if (enableNurseryStrings) {
+            jitRealm->setStringsCanBeInNursery(true);
+            numNurseryStringRealmsEnabled++;
           }
           if (disableNurseryBigInts) {
             numNurseryBigIntRealmsDisabled++;
+          } else if (enableNurseryBigInts) {
+            numNurseryBigIntRealmsEnabled++;
           }
         }
       }
       if (disableNurseryStrings) {
         zone->allocNurseryStrings = false;
+      } else if (enableNurseryStrings) {
+        zone->allocNurseryStrings = true;
+        zone->nurseryStringsDisabledCollections = 0;
       }
       if (disableNurseryBigInts) {
         zone->allocNurseryBigInts = false;
+      } else if (enableNurseryBigInts) {
+        zone->allocNurseryBigInts = true;
+        zone->nurseryBigIntsDisabledCollections = 0;
       }
     }
     numStringsTenured += zone->tenuredStrings;
     zone->tenuredStrings = 0;
+    zone->nurseryAllocatedStrings = 0;
     numBigIntsTenured += zone->tenuredBigInts;
     zone->tenuredBigInts = 0;
+    zone->nurseryAllocatedBigInts = 0;
   }
   session.reset();  // End the minor GC session, if running one.
   stats().setStat(gcstats::STAT_NURSERY_STRING_REALMS_DISABLED,
                   numNurseryStringRealmsDisabled);
+  stats().setStat(gcstats::STAT_NURSERY_STRING_REALMS_ENABLED,
+                  numNurseryStringRealmsEnabled);
   stats().setStat(gcstats::STAT_STRINGS_TENURED, numStringsTenured);
   stats().setStat(gcstats::STAT_NURSERY_BIGINT_REALMS_DISABLED,
                   numNurseryBigIntRealmsDisabled);
+  stats().setStat(gcstats::STAT_NURSERY_BIGINT_REALMS_ENABLED,
+                  numNurseryBigIntRealmsEnabled);
   stats().setStat(gcstats::STAT_BIGINTS_TENURED, numBigIntsTenured);
   endProfile(ProfileKey::Pretenure);
 
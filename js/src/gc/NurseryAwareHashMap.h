@@ -174,6 +174,11 @@ class NurseryAwareHashMap {
     map.sweep();
   }
 
+  // Release excess capacity held by the map. Call after sweeping; the
+  // nursery entry list is cleared on minor GC so only the tenured map
+  // needs shrinking.
+  void compact() { map.compact(); }
+
   void clear() {
     map.clear();
     nurseryEntries.clear();
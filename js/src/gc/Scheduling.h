@@ -310,6 +310,7 @@
 
 #include "mozilla/Atomics.h"
 #include "mozilla/DebugOnly.h"
+#include "mozilla/MathAlgorithms.h"
 
 #include "gc/GCEnum.h"
 #include "js/AllocPolicy.h"
@@ -652,6 +653,21 @@ class GCSchedulingState {
    */
   MainThreadOrGCTaskData<bool> inHighFrequencyGCMode_;
 
+  /*
+   * The number of chunks mapped from the OS since the empty chunk pool was
+   * last pruned. Atomic because fresh chunks may be mapped concurrently by
+   * the main thread and the background allocation task.
+   */
+  mozilla::Atomic<uint32_t, mozilla::Relaxed> freshChunkCount_;
+
+  /*
+   * A decaying average of the number of fresh chunks mapped between prunes
+   * of the empty chunk pool. This is used to size the pool of retained
+   * empty chunks, so that allocation bursts are satisfied from the pool
+   * rather than by faulting back in pages just returned to the OS.
+   */
+  MainThreadOrGCTaskData<float> chunkAllocationRate_;
+
  public:
   /*
    * Influences the GC thresholds for the atoms zone to discourage collection of
@@ -659,7 +675,10 @@ class GCSchedulingState {
    */
   MainThreadOrGCTaskData<bool> inPageLoad;
 
-  GCSchedulingState() : inHighFrequencyGCMode_(false) {}
+  GCSchedulingState()
+      : inHighFrequencyGCMode_(false),
+        freshChunkCount_(0),
+        chunkAllocationRate_(0.0f) {}
 
   bool inHighFrequencyGCMode() const { return inHighFrequencyGCMode_; }
 
@@ -670,6 +689,30 @@ class GCSchedulingState {
         tunables.isDynamicHeapGrowthEnabled() && !lastGCTime.IsNull() &&
         lastGCTime + tunables.highFrequencyThreshold() > currentTime;
   }
+
+  void noteFreshChunkAllocated() { freshChunkCount_++; }
+
+  void updateChunkAllocationRate() {
+    chunkAllocationRate_ =
+        (chunkAllocationRate_ + float(freshChunkCount_.exchange(0))) / 2.0f;
+  }
+
+  void resetChunkAllocationRate() {
+    freshChunkCount_ = 0;
+    chunkAllocationRate_ = 0.0f;
+  }
+
+  /*
+   * The number of empty chunks to retain when pruning the empty chunk pool,
+   * based on the recent demand for fresh chunks and clamped to the
+   * JSGC_MIN_EMPTY_CHUNK_COUNT / JSGC_MAX_EMPTY_CHUNK_COUNT tunables.
+   */
+  uint32_t emptyChunkTargetCount(const GCSchedulingTunables& tunables,
+                                 const AutoLockGC& lock) const {
+    uint32_t target = uint32_t(chunkAllocationRate_ + 0.5f);
+    return mozilla::Clamp(target, tunables.minEmptyChunkCount(lock),
+                          tunables.maxEmptyChunkCount());
+  }
 };
 
 enum class TriggerKind { None, Incremental, NonIncremental };
@@ -353,9 +353,10 @@ UniqueChars Statistics::formatCompactSummaryMessage() const {
   MOZ_ASSERT_IF(counts[COUNT_ARENA_RELOCATED], gckind == GC_SHRINK);
   if (gckind == GC_SHRINK) {
     SprintfLiteral(
-        buffer, "Kind: %s; Relocated: %.3f MiB; ",
+        buffer, "Kind: %s; Relocated: %.3f MiB; Strings Deduplicated: %d; ",
         ExplainInvocationKind(gckind),
-        double(ArenaSize * counts[COUNT_ARENA_RELOCATED]) / bytesPerMiB);
+        double(ArenaSize * counts[COUNT_ARENA_RELOCATED]) / bytesPerMiB,
+        counts[COUNT_STRINGS_DEDUPLICATED]);
     if (!fragments.append(DuplicateString(buffer))) {
       return UniqueChars(nullptr);
     }
@@ -445,6 +446,7 @@ UniqueChars Statistics::formatDetailedDescription() const {
   HeapSize: %.3f MiB\n\
   Chunk Delta (magnitude): %+d  (%d)\n\
   Arenas Relocated: %.3f MiB\n\
+  Strings Deduplicated: %d\n\
   Trigger: %s\n\
 ";
 
@@ -469,7 +471,7 @@ UniqueChars Statistics::formatDetailedDescription() const {
       getCount(COUNT_NEW_CHUNK) - getCount(COUNT_DESTROY_CHUNK),
       getCount(COUNT_NEW_CHUNK) + getCount(COUNT_DESTROY_CHUNK),
       double(ArenaSize * getCount(COUNT_ARENA_RELOCATED)) / bytesPerMiB,
-      thresholdBuffer);
+      getCount(COUNT_STRINGS_DEDUPLICATED), thresholdBuffer);
 
   return DuplicateString(buffer);
 }
@@ -1044,6 +1046,8 @@ void Statistics::sendGCTelemetry() {
   if (gc->isCompactingGc()) {
     runtime->addTelemetry(JS_TELEMETRY_GC_COMPACT_MS,
                           t(phaseTimes[Phase::COMPACT]));
+    runtime->addTelemetry(JS_TELEMETRY_GC_STRINGS_DEDUPLICATED,
+                          getCount(COUNT_STRINGS_DEDUPLICATED));
   }
   runtime->addTelemetry(JS_TELEMETRY_GC_MARK_ROOTS_MS, t(markRootsTotal));
   runtime->addTelemetry(JS_TELEMETRY_GC_MARK_GRAY_MS,
@@ -45,6 +45,9 @@ enum Count {
   // Number of arenas relocated by compacting GC.
   COUNT_ARENA_RELOCATED,
 
+  // Number of duplicate strings merged into a single cell by compacting GC.
+  COUNT_STRINGS_DEDUPLICATED,
+
   COUNT_LIMIT
 };
 
@@ -60,6 +63,9 @@ enum Stat {
   // being tenured.
   STAT_NURSERY_STRING_REALMS_DISABLED,
 
+  // Number of realms that had nursery strings re-enabled after a cooldown.
+  STAT_NURSERY_STRING_REALMS_ENABLED,
+
   // Number of BigInts tenured.
   STAT_BIGINTS_TENURED,
 
@@ -67,6 +73,9 @@ enum Stat {
   // being tenured.
   STAT_NURSERY_BIGINT_REALMS_DISABLED,
 
+  // Number of realms that had nursery BigInts re-enabled after a cooldown.
+  STAT_NURSERY_BIGINT_REALMS_ENABLED,
+
   STAT_LIMIT
 };
 
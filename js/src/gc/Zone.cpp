@@ -138,6 +138,10 @@ JS::Zone::Zone(JSRuntime* rt)
       data(this, nullptr),
       tenuredStrings(this, 0),
       tenuredBigInts(this, 0),
+      nurseryAllocatedStrings(this, 0),
+      nurseryAllocatedBigInts(this, 0),
+      nurseryStringsDisabledCollections(this, 0),
+      nurseryBigIntsDisabledCollections(this, 0),
       allocNurseryStrings(this, true),
       allocNurseryBigInts(this, true),
       suppressAllocationMetadataBuilder(this, false),
@@ -329,6 +333,13 @@ void Zone::sweepAllCrossCompartmentWrappers() {
   }
 }
 
+void Zone::compactAllCrossCompartmentWrappers() {
+  crossZoneStringWrappers().compact();
+  for (CompartmentsInZoneIter comp(this); !comp.done(); comp.next()) {
+    comp->compactCrossCompartmentObjectWrappers();
+  }
+}
+
 /* static */
 void Zone::fixupAllCrossCompartmentWrappersAfterMovingGC(JSTracer* trc) {
   MOZ_ASSERT(trc->runtime()->gc.isHeapCompacting());
@@ -198,6 +198,17 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   js::ZoneData<uint32_t> tenuredStrings;
   js::ZoneData<uint32_t> tenuredBigInts;
 
+  // Number of strings and BigInts allocated in the nursery since the last
+  // minor GC. Together with the tenured counts above these give a per-zone
+  // promotion rate for the pretenuring decisions in Nursery::doPretenuring.
+  js::ZoneData<uint32_t> nurseryAllocatedStrings;
+  js::ZoneData<uint32_t> nurseryAllocatedBigInts;
+
+  // Number of minor GCs since nursery string/BigInt allocation was disabled
+  // for this zone, used to re-enable it again after a cooldown.
+  js::ZoneData<uint32_t> nurseryStringsDisabledCollections;
+  js::ZoneData<uint32_t> nurseryBigIntsDisabledCollections;
+
   js::ZoneData<bool> allocNurseryStrings;
   js::ZoneData<bool> allocNurseryBigInts;
 
@@ -533,6 +544,7 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   void dropStringWrappersOnGC();
 
   void sweepAllCrossCompartmentWrappers();
+  void compactAllCrossCompartmentWrappers();
   static void fixupAllCrossCompartmentWrappersAfterMovingGC(JSTracer* trc);
 
   GrayRootVector& gcGrayRoots() { return gcGrayRoots_.ref(); }
@@ -703,7 +703,8 @@ template <typename IRGenerator, typename... Args>
 static void TryAttachStub(const char* name, JSContext* cx, BaselineFrame* frame,
                           ICFallbackStub* stub, BaselineCacheIRStubKind kind,
                           Args&&... args) {
-  if (stub->state().maybeTransition()) {
+  if (stub->state().maybeTransition() ||
+      stub->state().maybeCollapseToMegamorphic(stub->enteredCount())) {
     stub->discardStubs(cx);
   }
 
@@ -1795,7 +1796,8 @@ static bool TryAttachGetPropStub(const char* name, JSContext* cx,
                                  HandleValue idVal, HandleValue receiver) {
   bool attached = false;
 
-  if (stub->state().maybeTransition()) {
+  if (stub->state().maybeTransition() ||
+      stub->state().maybeCollapseToMegamorphic(stub->enteredCount())) {
     stub->discardStubs(cx);
   }
 
@@ -2075,7 +2077,8 @@ bool DoSetElemFallback(JSContext* cx, BaselineFrame* frame,
   DeferType deferType = DeferType::None;
   bool attached = false;
 
-  if (stub->state().maybeTransition()) {
+  if (stub->state().maybeTransition() ||
+      stub->state().maybeCollapseToMegamorphic(stub->enteredCount())) {
     stub->discardStubs(cx);
   }
 
@@ -2663,7 +2666,8 @@ bool DoSetPropFallback(JSContext* cx, BaselineFrame* frame,
 
   DeferType deferType = DeferType::None;
   bool attached = false;
-  if (stub->state().maybeTransition()) {
+  if (stub->state().maybeTransition() ||
+      stub->state().maybeCollapseToMegamorphic(stub->enteredCount())) {
     stub->discardStubs(cx);
   }
 
@@ -2866,7 +2870,8 @@ bool DoCallFallback(JSContext* cx, BaselineFrame* frame, ICCall_Fallback* stub,
   }
 
   // Transition stub state to megamorphic or generic if warranted.
-  if (stub->state().maybeTransition()) {
+  if (stub->state().maybeTransition() ||
+      stub->state().maybeCollapseToMegamorphic(stub->enteredCount())) {
     stub->discardStubs(cx);
   }
 
@@ -2997,7 +3002,8 @@ bool DoSpreadCallFallback(JSContext* cx, BaselineFrame* frame,
   RootedValue newTarget(cx, constructing ? vp[3] : NullValue());
 
   // Transition stub state to megamorphic or generic if warranted.
-  if (stub->state().maybeTransition()) {
+  if (stub->state().maybeTransition() ||
+      stub->state().maybeCollapseToMegamorphic(stub->enteredCount())) {
     stub->discardStubs(cx);
   }
 
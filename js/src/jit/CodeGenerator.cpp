@@ -10819,6 +10819,10 @@ bool CodeGenerator::link(JSContext* cx, CompilerConstraintList* constraints) {
 
   script->jitScript()->setIonScript(script, ionScript);
 
+  // Record on the shared bytecode that some copy of this script warranted an
+  // Ion compile, so byte-identical copies in other realms warm up faster.
+  script->sharedData()->setReachedIonCompile();
+
   Assembler::PatchDataWithValueCheck(
       CodeLocationLabel(code, invalidateEpilogueData_), ImmPtr(ionScript),
       ImmPtr((void*)-1));
@@ -36,6 +36,13 @@ class ICState {
 
   static const size_t MaxOptimizedStubs = 6;
 
+  // Number of times the fallback path may be entered for a Specialized IC
+  // with attached stubs before we collapse the IC to Megamorphic. The
+  // fallback entered count is reset whenever a new stub is attached, so a
+  // high count means the attached stubs keep missing without the chain
+  // making progress.
+  static const uint32_t MaxSpecializedFallbackEntries = 64;
+
   void transition(Mode mode) {
     MOZ_ASSERT(mode > mode_);
     mode_ = mode;
@@ -81,11 +88,30 @@ class ICState {
         numFailures_ < maxFailures()) {
       return false;
     }
-    if (numFailures_ == maxFailures() || mode_ == Mode::Megamorphic) {
+    if (mode_ == Mode::Megamorphic) {
       transition(Mode::Generic);
       return true;
     }
     MOZ_ASSERT(mode_ == Mode::Specialized);
+    // Only skip Megamorphic mode if we never managed to attach a stub:
+    // stubs that handle more cases are then unlikely to fare any better.
+    // If we did attach stubs but kept failing, give megamorphic stubs a
+    // chance before giving up on ICs for this site entirely.
+    if (numFailures_ == maxFailures() && numOptimizedStubs_ == 0) {
+      transition(Mode::Generic);
+      return true;
+    }
+    transition(Mode::Megamorphic);
+    return true;
+  }
+  // If this returns true, the fallback path was taken so often without the
+  // chain making progress that we transitioned to Megamorphic and the
+  // caller should discard all stubs.
+  MOZ_MUST_USE bool maybeCollapseToMegamorphic(uint32_t fallbackEnteredCount) {
+    if (mode_ != Mode::Specialized || numOptimizedStubs_ == 0 ||
+        fallbackEnteredCount < MaxSpecializedFallbackEntries) {
+      return false;
+    }
     transition(Mode::Megamorphic);
     return true;
   }
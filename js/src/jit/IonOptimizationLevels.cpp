@@ -92,6 +92,16 @@ uint32_t OptimizationInfo::compilerWarmUpThreshold(JSScript* script,
 
   uint32_t warmUpThreshold = baseCompilerWarmUpThreshold();
 
+  // If a byte-identical copy of this script in another realm has already
+  // warranted an Ion compile (for example the same bundle loaded by many
+  // same-origin iframes), this copy is very likely to become hot as well, so
+  // compile it sooner instead of rediscovering one copy at a time. The
+  // compiled code itself cannot be shared: Ion specializes on per-realm type
+  // information and object layouts.
+  if (script->sharedData() && script->sharedData()->reachedIonCompile()) {
+    warmUpThreshold /= 10;
+  }
+
   // If the script is too large to compile on the main thread, we can still
   // compile it off thread. In these cases, increase the warm-up counter
   // threshold to improve the compilation's type information and hopefully
@@ -1567,12 +1567,29 @@ static MOZ_ALWAYS_INLINE bool GetNativeDataPropertyPure(JSContext* cx,
 
   MOZ_ASSERT(JSID_IS_ATOM(id) || JSID_IS_SYMBOL(id));
 
+  MegamorphicCache& megamorphicCache =
+      cx->runtime()->caches().megamorphicCache;
+  Shape* receiverShape = obj->lastProperty();
+  uint32_t cachedSlot;
+  if (megamorphicCache.lookup(receiverShape, id, &cachedSlot)) {
+    *vp = obj->getSlot(cachedSlot);
+    return true;
+  }
+
+  NativeObject* receiver = obj;
   while (true) {
     if (Shape* shape = obj->lastProperty()->search(cx, id)) {
       if (!shape->isDataProperty()) {
         return false;
       }
 
+      // Own data properties have their location fully determined by the
+      // receiver's shape, so they can be cached for later megamorphic
+      // lookups. Anything found further along the prototype chain cannot.
+      if (obj == receiver) {
+        megamorphicCache.add(receiverShape, id, shape->slot());
+      }
+
       *vp = obj->getSlot(shape->slot());
       return true;
     }
@@ -15,6 +15,17 @@ typedef js::HashMap<uint32_t, MDefinition*, DefaultHasher<uint32_t>,
                     SystemAllocPolicy>
     LastSeenMap;
 
+// A bounds check recorded per base definition, together with the constant
+// offset that was added to the base by an MWasmAddOffset.
+struct CheckedOffset {
+  MDefinition* check;
+  uint32_t offset;
+};
+
+typedef js::HashMap<uint32_t, CheckedOffset, DefaultHasher<uint32_t>,
+                    SystemAllocPolicy>
+    BaseSeenMap;
+
 // The Wasm Bounds Check Elimination (BCE) pass looks for bounds checks
 // on SSA values that have already been checked. (in the same block or in a
 // dominating block). These bounds checks are redundant and thus eliminated.
@@ -23,14 +34,22 @@ typedef js::HashMap<uint32_t, MDefinition*, DefaultHasher<uint32_t>,
 // can ONLY GROW. If we allow SHRINKING the heap, this pass should be
 // RECONSIDERED.
 //
+// In addition to exact matches, a dominating check of base + K (via
+// MWasmAddOffset, which traps on overflow rather than wrapping) covers any
+// check of base + K' with K' <= K, since base + K' <= base + K < limit. This
+// fold is disabled when Spectre index masking is on: the masked value of the
+// dominating check is base + K, which cannot be substituted for base + K'.
+//
 // TODO (dbounov): Are there a lot of cases where there is no single dominating
 // check, but a set of checks that together dominate a redundant check?
-//
-// TODO (dbounov): Generalize to constant additions relative to one base
 bool jit::EliminateBoundsChecks(MIRGenerator* mir, MIRGraph& graph) {
   // Map for dominating block where a given definition was checked
   LastSeenMap lastSeen;
 
+  // Map for dominating block where a given base was checked with a constant
+  // offset added by an MWasmAddOffset.
+  BaseSeenMap baseSeen;
+
   for (ReversePostorderIterator bIter(graph.rpoBegin());
        bIter != graph.rpoEnd(); bIter++) {
     MBasicBlock* block = *bIter;
@@ -75,6 +94,33 @@ bool jit::EliminateBoundsChecks(MIRGenerator* mir, MIRGraph& graph) {
                 return false;
               }
             }
+
+            if (!bc->isRedundant() && !JitOptions.spectreIndexMasking) {
+              // Look for a dominating check of the same base with an equal
+              // or larger constant offset. An MWasmAddOffset traps on
+              // overflow, so the dominating check proves base + offset is
+              // below the limit without having wrapped.
+              MDefinition* base = addr;
+              uint32_t offset = 0;
+              if (addr->isWasmAddOffset()) {
+                base = addr->toWasmAddOffset()->base();
+                offset = addr->toWasmAddOffset()->offset();
+              }
+              BaseSeenMap::AddPtr basePtr = baseSeen.lookupForAdd(base->id());
+              if (basePtr) {
+                const CheckedOffset& prev = basePtr->value();
+                if (prev.offset >= offset &&
+                    prev.check->block()->dominates(block)) {
+                  bc->setRedundant();
+                  MOZ_ASSERT(!bc->hasUses());
+                }
+              } else {
+                if (!baseSeen.add(basePtr, base->id(),
+                                  CheckedOffset{def, offset})) {
+                  return false;
+                }
+              }
+            }
           }
           break;
         }
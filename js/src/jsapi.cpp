@@ -440,6 +440,12 @@ JS::ContextOptions& JS::ContextOptions::setFuzzing(bool flag) {
 }
 
 JS_PUBLIC_API bool JS::InitSelfHostedCode(JSContext* cx) {
+  return InitSelfHostedCode(cx, TranscodeRange(), nullptr);
+}
+
+JS_PUBLIC_API bool JS::InitSelfHostedCode(JSContext* cx,
+                                          const TranscodeRange& xdrCache,
+                                          TranscodeBuffer* xdrWriter) {
   MOZ_RELEASE_ASSERT(!cx->runtime()->hasInitializedSelfHosting(),
                      "JS::InitSelfHostedCode() called more than once");
 
@@ -457,7 +463,7 @@ JS_PUBLIC_API bool JS::InitSelfHostedCode(JSContext* cx) {
   }
 #endif
 
-  if (!rt->initSelfHosting(cx)) {
+  if (!rt->initSelfHosting(cx, xdrCache, xdrWriter)) {
     return false;
   }
 
@@ -285,6 +285,26 @@ namespace JS {
  */
 JS_PUBLIC_API bool InitSelfHostedCode(JSContext* cx);
 
+/**
+ * Variant of InitSelfHostedCode that can reuse a transcoded snapshot of the
+ * self-hosted script instead of compiling it from its sources, which
+ * dominates the cost of runtime creation.
+ *
+ * `xdrCache` may be empty, or point at bytes produced by a previous call's
+ * `xdrWriter`, in this or another process. The bytes are 8-byte aligned, are
+ * only read, and are not used after this call returns, so a read-only shared
+ * memory mapping can back them. A snapshot from a different build (see
+ * TranscodeResult_Failure_BadBuildId) or otherwise undecodable bytes are not
+ * an error; the sources are compiled as usual.
+ *
+ * If `xdrWriter` is non-null and the sources were compiled rather than
+ * decoded, a snapshot is appended to it for the embedder to persist or share
+ * with other processes. Failure to encode the snapshot is not an error.
+ */
+JS_PUBLIC_API bool InitSelfHostedCode(JSContext* cx,
+                                      const TranscodeRange& xdrCache,
+                                      TranscodeBuffer* xdrWriter);
+
 /**
  * Asserts (in debug and release builds) that `obj` belongs to the current
  * thread's context.
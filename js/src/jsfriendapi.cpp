@@ -10,6 +10,7 @@
 #include "mozilla/Maybe.h"
 #include "mozilla/PodOperations.h"
 #include "mozilla/TimeStamp.h"
+#include "mozilla/UniquePtr.h"
 
 #include <stdint.h>
 
@@ -34,6 +35,7 @@
 #include "vm/Printer.h"
 #include "vm/PromiseObject.h"  // js::PromiseObject
 #include "vm/Realm.h"
+#include "vm/ScriptBytecodeCache.h"
 #include "vm/Time.h"
 #include "vm/WrapperObject.h"
 
@@ -1437,6 +1439,40 @@ JS_FRIEND_API uint64_t js::GetGCHeapUsageForObjectZone(JSObject* obj) {
   return obj->zone()->gcHeapSize.bytes();
 }
 
+JS_FRIEND_API bool js::EnableScriptBytecodeCache(JSContext* cx) {
+  MOZ_ASSERT(!cx->isHelperThreadContext());
+  JSRuntime* rt = cx->runtime();
+  if (rt->scriptBytecodeCache.ref()) {
+    return true;
+  }
+
+  auto cache = mozilla::MakeUnique<ScriptBytecodeCache>();
+  if (!cache) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  rt->scriptBytecodeCache.ref() = std::move(cache);
+  return true;
+}
+
+JS_FRIEND_API bool js::ImportScriptBytecodeCacheData(JSContext* cx,
+                                                     const uint8_t* data,
+                                                     size_t length) {
+  if (!EnableScriptBytecodeCache(cx)) {
+    return false;
+  }
+  return cx->runtime()->scriptBytecodeCache.ref()->importData(data, length);
+}
+
+JS_FRIEND_API bool js::ExportScriptBytecodeCacheData(
+    JSContext* cx, JS::TranscodeBuffer& buffer) {
+  ScriptBytecodeCache* cache = cx->runtime()->scriptBytecodeCache.ref().get();
+  if (!cache) {
+    return false;
+  }
+  return cache->exportData(buffer);
+}
+
 #ifdef DEBUG
 JS_FRIEND_API bool js::RuntimeIsBeingDestroyed() {
   JSRuntime* runtime = TlsContext.get()->runtime();
@@ -21,6 +21,7 @@
 #include "js/Class.h"
 #include "js/ErrorReport.h"
 #include "js/HeapAPI.h"
+#include "js/Transcoding.h"
 #include "js/TypeDecls.h"
 #include "js/Utility.h"
 
@@ -172,8 +173,10 @@ enum {
   JS_TELEMETRY_GC_TIME_BETWEEN_SLICES_MS,
   JS_TELEMETRY_GC_SLICE_COUNT,
   JS_TELEMETRY_GC_EFFECTIVENESS,
+  JS_TELEMETRY_GC_STRINGS_DEDUPLICATED,
   JS_TELEMETRY_PRIVILEGED_PARSER_COMPILE_LAZY_AFTER_MS,
   JS_TELEMETRY_WEB_PARSER_COMPILE_LAZY_AFTER_MS,
+  JS_TELEMETRY_MEGAMORPHIC_CACHE_HIT_RATE,
   JS_TELEMETRY_END
 };
 
@@ -2672,6 +2675,32 @@ extern JS_FRIEND_API void RemapRemoteWindowProxies(
     JSContext* cx, CompartmentTransplantCallback* callback,
     JS::MutableHandleObject newTarget);
 
+/**
+ * Enable the runtime's content-addressed bytecode cache. Once enabled, main
+ * thread global script compilations first look for an XDR encoding of the
+ * same source and compile options and decode it instead of parsing, and
+ * successful compilations are encoded into the cache.
+ */
+extern JS_FRIEND_API bool EnableScriptBytecodeCache(JSContext* cx);
+
+/**
+ * Populate the bytecode cache (enabling it if necessary) from a blob
+ * previously produced by ExportScriptBytecodeCacheData. The data is borrowed,
+ * must be 8-byte aligned, and must stay valid for the lifetime of the
+ * runtime; a read-only memory mapping of the exported blob is sufficient.
+ */
+extern JS_FRIEND_API bool ImportScriptBytecodeCacheData(JSContext* cx,
+                                                        const uint8_t* data,
+                                                        size_t length);
+
+/**
+ * Serialize the bytecode cache contents, including entries imported at
+ * startup, so the embedder can persist them for the next process start.
+ * Returns false if the cache is not enabled or on OOM.
+ */
+extern JS_FRIEND_API bool ExportScriptBytecodeCacheData(
+    JSContext* cx, JS::TranscodeBuffer& buffer);
+
 namespace gc {
 
 // API to let the DOM tell us whether we're currently in pageload, so we can
@@ -223,12 +223,78 @@ class NewObjectCache {
   }
 };
 
+/*
+ * Cache for megamorphic property lookups: maps a receiver object's shape and
+ * a property key to the slot of an own data property. Lookups that fall off
+ * the IC paths (megamorphic sites, the interpreter) consult this before
+ * walking the shape lineage. Only own data properties are cached because
+ * their location is fully determined by the receiver's shape; anything found
+ * on the prototype chain could move independently of that shape.
+ *
+ * Entries hold unbarriered pointers to shapes and atoms, so the cache must be
+ * purged whenever those could die or move (major GC, compaction).
+ */
+class MegamorphicCache {
+ public:
+  struct Entry {
+    Shape* shape = nullptr;
+    jsid id = JSID_VOID;
+    uint32_t slot = 0;
+  };
+
+  static const size_t NumEntries = 1024;
+
+ private:
+  Entry entries_[NumEntries];
+
+  // Lookup counters for hit rate telemetry, reset when the cache is purged.
+  uint64_t numLookups_ = 0;
+  uint64_t numHits_ = 0;
+
+  static size_t entryIndex(Shape* shape, jsid id) {
+    uintptr_t hash = uintptr_t(shape) ^ (uintptr_t(shape) >> 13);
+    hash ^= uintptr_t(JSID_BITS(id));
+    return hash % NumEntries;
+  }
+
+ public:
+  bool lookup(Shape* shape, jsid id, uint32_t* slotOut) {
+    numLookups_++;
+    Entry& entry = entries_[entryIndex(shape, id)];
+    if (entry.shape == shape && entry.id == id) {
+      numHits_++;
+      *slotOut = entry.slot;
+      return true;
+    }
+    return false;
+  }
+
+  void add(Shape* shape, jsid id, uint32_t slot) {
+    Entry& entry = entries_[entryIndex(shape, id)];
+    entry.shape = shape;
+    entry.id = id;
+    entry.slot = slot;
+  }
+
+  uint64_t numLookups() const { return numLookups_; }
+  uint64_t numHits() const { return numHits_; }
+
+  void purge() {
+    for (Entry& entry : entries_) {
+      entry = Entry();
+    }
+    numLookups_ = 0;
+    numHits_ = 0;
+  }
+};
+
 class RuntimeCaches {
  public:
   js::GSNCache gsnCache;
   js::NewObjectCache newObjectCache;
   js::UncompressedSourceCache uncompressedSourceCache;
   js::EvalCache evalCache;
+  js::MegamorphicCache megamorphicCache;
 
   void purgeForMinorGC(JSRuntime* rt) {
     newObjectCache.clearNurseryObjects(rt);
@@ -238,6 +304,7 @@ class RuntimeCaches {
   void purgeForCompaction() {
     newObjectCache.purge();
     evalCache.clear();
+    megamorphicCache.purge();
   }
 
   void purge() {
@@ -490,6 +490,11 @@ void Compartment::sweepCrossCompartmentObjectWrappers() {
   crossCompartmentObjectWrappers.sweep();
 }
 
+// Shrink the wrapper table to fit its remaining entries.
+void Compartment::compactCrossCompartmentObjectWrappers() {
+  crossCompartmentObjectWrappers.compact();
+}
+
 void Compartment::fixupCrossCompartmentObjectWrappersAfterMovingGC(
     JSTracer* trc) {
   MOZ_ASSERT(trc->runtime()->gc.isHeapCompacting());
@@ -245,6 +245,16 @@ class ObjectWrapperMap {
       }
     }
   }
+
+  // Release excess capacity retained by the tables after sweeping. Wrapper
+  // maps can grow very large in many-compartment sessions and sweeping only
+  // removes entries, so shrinking GCs compact them to return the memory.
+  void compact() {
+    for (OuterMap::Enum e(map); !e.empty(); e.popFront()) {
+      e.front().value().compact();
+    }
+    map.compact();
+  }
 };
 
 using StringWrapperMap =
@@ -421,6 +431,7 @@ class JS::Compartment {
   void sweepRealms(JSFreeOp* fop, bool keepAtleastOne, bool destroyingRuntime);
   void sweepAfterMinorGC(JSTracer* trc);
   void sweepCrossCompartmentObjectWrappers();
+  void compactCrossCompartmentObjectWrappers();
 
   void fixupCrossCompartmentObjectWrappersAfterMovingGC(JSTracer* trc);
   void fixupAfterMovingGC(JSTracer* trc);
@@ -534,6 +534,11 @@ size_t ParseTask::sizeOfExcludingThis(
          errors.sizeOfExcludingThis(mallocSizeOf);
 }
 
+// How much LifoAlloc chunk memory a helper thread keeps warm between parse
+// tasks. Chunk allocation and the page faults on first touch show up in parse
+// profiles, so avoid starting every task with a cold arena.
+static const size_t MaxRetainedParseTaskLifoAllocSize = 512 * 1024;
+
 void ParseTask::runTask() {
   AutoSetHelperThreadContext usesContext;
 
@@ -553,8 +558,11 @@ void ParseTask::runTask() {
 
   parse(cx);
 
+  // Retain a bounded amount of warm LifoAlloc chunks for the next parse task
+  // scheduled on this thread; the memory-pressure path in
+  // AutoSetHelperThreadContext still frees everything when requested.
   MOZ_ASSERT(cx->tempLifoAlloc().isEmpty());
-  cx->tempLifoAlloc().freeAll();
+  cx->tempLifoAlloc().freeUnusedOver(MaxRetainedParseTaskLifoAllocSize);
   cx->frontendCollectionPool().purge();
   cx->atomsZoneFreeLists().clear();
 }
@@ -963,17 +971,42 @@ static bool StartOffThreadParseTask(JSContext* cx, UniquePtr<ParseTask> task,
   return true;
 }
 
+// Inner functions of scripts compiled off-thread are normally only
+// syntax-parsed, deferring bytecode generation to their first invocation on
+// the main thread. For moderately sized sources it is worth compiling them
+// eagerly while we are on a helper thread anyway: the extra parse time is
+// hidden from the main thread, and first calls (often interaction-critical
+// event handlers) find bytecode ready instead of stalling to delazify. Large
+// sources keep lazy parsing to bound the memory spent on bytecode for
+// functions that may never run.
+static const size_t MaxEagerInnerFunctionCompileLength = 128 * 1024;
+
+template <typename Unit>
+static bool ShouldEagerlyCompileInnerFunctions(
+    const ReadOnlyCompileOptions& options, const JS::SourceText<Unit>& srcBuf) {
+  return !options.forceFullParse() && !options.sourceIsLazy &&
+         srcBuf.length() <= MaxEagerInnerFunctionCompileLength;
+}
+
 template <typename Unit>
 static bool StartOffThreadParseScriptInternal(
     JSContext* cx, const ReadOnlyCompileOptions& options,
     JS::SourceText<Unit>& srcBuf, JS::OffThreadCompileCallback callback,
     void* callbackData) {
+  bool fullParse = ShouldEagerlyCompileInnerFunctions(options, srcBuf);
+
   auto task = cx->make_unique<ScriptParseTask<Unit>>(cx, srcBuf, callback,
                                                      callbackData);
   if (!task) {
     return false;
   }
 
+  if (fullParse) {
+    CompileOptions fullParseOptions(cx, options);
+    fullParseOptions.setForceFullParse();
+    return StartOffThreadParseTask(cx, std::move(task), fullParseOptions);
+  }
+
   return StartOffThreadParseTask(cx, std::move(task), options);
 }
 
@@ -1472,6 +1505,30 @@ void GlobalHelperThreadState::addSizeOfIncludingThis(
   }
 }
 
+void js::GetHelperThreadBacklog(HelperThreadBacklog* backlog) {
+  *backlog = HelperThreadBacklog();
+
+  if (!gHelperThreadState) {
+    return;
+  }
+
+  AutoLockHelperThreadState lock;
+  GlobalHelperThreadState& state = HelperThreadState();
+
+  backlog->parseTasks = state.parseWorklist(lock).length();
+  backlog->ionCompileTasks = state.ionWorklist(lock).length();
+  backlog->wasmTier1CompileTasks =
+      state.wasmWorklist(lock, wasm::CompileMode::Tier1).length();
+  backlog->wasmTier2CompileTasks =
+      state.wasmWorklist(lock, wasm::CompileMode::Tier2).length();
+  backlog->promiseTasks = state.promiseHelperTasks(lock).length();
+  backlog->compressionTasks = state.compressionWorklist(lock).length();
+  for (GCParallelTask* task : state.gcParallelWorklist(lock)) {
+    mozilla::Unused << task;
+    backlog->gcParallelTasks++;
+  }
+}
+
 size_t GlobalHelperThreadState::maxIonCompilationThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_ION)) {
     return 1;
@@ -1563,7 +1620,12 @@ bool GlobalHelperThreadState::canStartWasmCompile(
   size_t threads;
   if (mode == wasm::CompileMode::Tier2) {
     if (tier2oversubscribed) {
-      threads = maxWasmCompilationThreads();
+      // Even when Tier2 must be favored, never let it claim every helper
+      // thread: the remaining task classes (Ion compiles, delazification)
+      // run short tasks that would otherwise sit behind long-running wasm
+      // compilations until a thread frees up. This matters most on small
+      // core counts, where Tier2 could occupy the whole pool.
+      threads = std::max<size_t>(maxWasmCompilationThreads() - 1, 1);
     } else {
       threads = physCoresAvailable;
     }
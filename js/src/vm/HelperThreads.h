@@ -501,6 +501,23 @@ bool SetFakeCPUCount(size_t count);
 // Get the current helper thread, or null.
 HelperThread* CurrentHelperThread();
 
+// Counts of helper thread tasks that are queued but not yet claimed by a
+// thread, broken down by task class.
+struct HelperThreadBacklog {
+  size_t parseTasks = 0;
+  size_t ionCompileTasks = 0;
+  size_t wasmTier1CompileTasks = 0;
+  size_t wasmTier2CompileTasks = 0;
+  size_t promiseTasks = 0;
+  size_t compressionTasks = 0;
+  size_t gcParallelTasks = 0;
+};
+
+// Snapshot the per-class backlog of queued helper thread tasks, e.g. for
+// deciding whether to submit more speculative work. Takes the helper thread
+// lock, so this is not for hot paths.
+void GetHelperThreadBacklog(HelperThreadBacklog* backlog);
+
 // Enqueues a wasm compilation task.
 bool StartOffThreadWasmCompile(wasm::CompileTask* task, wasm::CompileMode mode);
 
@@ -76,16 +76,15 @@ using js::jit::JitScript;
 
 template <bool Eq>
 static MOZ_ALWAYS_INLINE bool LooseEqualityOp(JSContext* cx,
-                                              InterpreterRegs& regs) {
+                                              InterpreterRegs& regs,
+                                              bool* res) {
   HandleValue rval = regs.stackHandleAt(-1);
   HandleValue lval = regs.stackHandleAt(-2);
   bool cond;
   if (!LooselyEqual(cx, lval, rval, &cond)) {
     return false;
   }
-  cond = (cond == Eq);
-  regs.sp--;
-  regs.sp[-1].setBoolean(cond);
+  *res = (cond == Eq);
   return true;
 }
 
@@ -214,6 +213,19 @@ static inline bool GetPropertyOperation(JSContext* cx, InterpreterFrame* fp,
     return true;
   }
 
+  // Megamorphic sites fall back on this path from the JITs as well; consult
+  // the megamorphic property cache before doing a full lookup. A hit means
+  // the receiver has an own data property at the cached slot.
+  if (lval.isObject() && lval.toObject().isNative()) {
+    NativeObject* nobj = &lval.toObject().as<NativeObject>();
+    uint32_t slot;
+    if (cx->runtime()->caches().megamorphicCache.lookup(
+            nobj->lastProperty(), NameToId(name), &slot)) {
+      vp.set(nobj->getSlot(slot));
+      return true;
+    }
+  }
+
   // Copy lval, because it might alias vp.
   RootedValue v(cx, lval);
   return GetProperty(cx, v, name, vp);
@@ -2336,16 +2348,24 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
     END_CASE(BitAnd)
 
     CASE(Eq) {
-      if (!LooseEqualityOp<true>(cx, REGS)) {
+      bool cond;
+      if (!LooseEqualityOp<true>(cx, REGS, &cond)) {
         goto error;
       }
+      TRY_BRANCH_AFTER_COND(cond, 2);
+      REGS.sp[-2].setBoolean(cond);
+      REGS.sp--;
     }
     END_CASE(Eq)
 
     CASE(Ne) {
-      if (!LooseEqualityOp<false>(cx, REGS)) {
+      bool cond;
+      if (!LooseEqualityOp<false>(cx, REGS, &cond)) {
         goto error;
       }
+      TRY_BRANCH_AFTER_COND(cond, 2);
+      REGS.sp[-2].setBoolean(cond);
+      REGS.sp--;
     }
     END_CASE(Ne)
 
@@ -2358,20 +2378,23 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
       goto error;                                     \
     }                                                 \
     (COND) = equal OP true;                           \
-    REGS.sp--;                                        \
   JS_END_MACRO
 
     CASE(StrictEq) {
       bool cond;
       STRICT_EQUALITY_OP(==, cond);
-      REGS.sp[-1].setBoolean(cond);
+      TRY_BRANCH_AFTER_COND(cond, 2);
+      REGS.sp[-2].setBoolean(cond);
+      REGS.sp--;
     }
     END_CASE(StrictEq)
 
     CASE(StrictNe) {
       bool cond;
       STRICT_EQUALITY_OP(!=, cond);
-      REGS.sp[-1].setBoolean(cond);
+      TRY_BRANCH_AFTER_COND(cond, 2);
+      REGS.sp[-2].setBoolean(cond);
+      REGS.sp--;
     }
     END_CASE(StrictNe)
 
@@ -2730,6 +2753,27 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
     }
     END_CASE(GetProp)
 
+/*
+ * Fuse a get of an unaliased binding with an immediately following
+ * JSOp::GetProp, the most common digram these ops occur in, to save a
+ * dispatch. The value just pushed by the current op (of length OPLEN) is
+ * replaced with the property value, as in the JSOp::GetProp case above.
+ */
+#define TRY_GETPROP_AFTER_PUSH(OPLEN)                                    \
+  JS_BEGIN_MACRO                                                         \
+    if (JSOp(REGS.pc[OPLEN]) == JSOp::GetProp) {                         \
+      REGS.pc += (OPLEN);                                                \
+      MutableHandleValue lval_ = REGS.stackHandleAt(-1);                 \
+      if (!GetPropertyOperation(cx, REGS.fp(), script, REGS.pc, lval_,   \
+                                lval_)) {                                \
+        goto error;                                                      \
+      }                                                                  \
+      JitScript::MonitorBytecodeType(cx, script, REGS.pc, lval_);        \
+      cx->debugOnlyCheck(lval_);                                         \
+      ADVANCE_AND_DISPATCH(JSOpLength_GetProp);                          \
+    }                                                                    \
+  JS_END_MACRO
+
     CASE(GetPropSuper) {
       ReservedRooted<Value> receiver(&rootValue0, REGS.sp[-2]);
       ReservedRooted<JSObject*> obj(&rootObject1, &REGS.sp[-1].toObject());
@@ -3433,6 +3477,7 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
       } else {
         PUSH_COPY(REGS.fp()->unaliasedFormal(i));
       }
+      TRY_GETPROP_AFTER_PUSH(JSOpLength_GetArg);
     }
     END_CASE(GetArg)
 
@@ -3467,6 +3512,8 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
         cx->debugOnlyCheck(REGS.sp[-1]);
       }
 #endif
+
+      TRY_GETPROP_AFTER_PUSH(JSOpLength_GetLocal);
     }
     END_CASE(GetLocal)
 
@@ -2119,6 +2119,8 @@ const Unit* ScriptSource::chunkUnits(
     return nullptr;
   }
 
+  decompressedChunks_++;
+
   const Unit* ret = decompressed.get();
   if (!cx->caches().uncompressedSourceCache.put(
           ssc, ToSourceData(std::move(decompressed)), holder)) {
@@ -2128,6 +2130,58 @@ const Unit* ScriptSource::chunkUnits(
   return ret;
 }
 
+template <typename Unit>
+bool ScriptSource::tryPinUncompressedSource(JSContext* cx) {
+  MOZ_ASSERT(isCompressed<Unit>());
+
+  // Don't replace |data| while pinned units point into it, or while a
+  // delayed conversion to compressed source is waiting on those units; the
+  // conversion will just be attempted again after the next decompression.
+  if (pinnedUnitsStack_ || !pendingCompressed_.empty()) {
+    return false;
+  }
+
+  const CompressedData<Unit>& c = *compressedData<Unit>();
+
+  size_t len = length();
+  EntryUnits<Unit> decompressed(js_pod_malloc<Unit>(len));
+  if (!decompressed) {
+    return false;
+  }
+
+  size_t totalBytes = len * sizeof(Unit);
+  size_t numChunks =
+      (totalBytes + Compressor::CHUNK_SIZE - 1) / Compressor::CHUNK_SIZE;
+  unsigned char* cursor = reinterpret_cast<unsigned char*>(decompressed.get());
+  for (size_t chunk = 0; chunk < numChunks; chunk++) {
+    size_t chunkBytes = Compressor::chunkSize(totalBytes, chunk);
+    if (!DecompressStringChunk(
+            reinterpret_cast<const unsigned char*>(c.raw.chars()), chunk,
+            cursor, chunkBytes)) {
+      return false;
+    }
+    cursor += chunkBytes;
+  }
+
+  bool retrievable = data.is<Compressed<Unit, SourceRetrievable::Yes>>();
+
+  auto& cache = cx->zone()->runtimeFromAnyThread()->sharedImmutableStrings();
+  auto uniqueChars = SourceTypeTraits<Unit>::toCacheable(std::move(decompressed));
+  auto deduped = cache.getOrCreate(std::move(uniqueChars), len);
+  if (!deduped) {
+    return false;
+  }
+
+  if (retrievable) {
+    data = SourceType(
+        Uncompressed<Unit, SourceRetrievable::Yes>(std::move(*deduped)));
+  } else {
+    data = SourceType(
+        Uncompressed<Unit, SourceRetrievable::No>(std::move(*deduped)));
+  }
+  return true;
+}
+
 template <typename Unit>
 void ScriptSource::convertToCompressedSource(SharedImmutableString compressed,
                                              size_t uncompressedLength) {
@@ -2195,6 +2249,14 @@ const Unit* ScriptSource::units(JSContext* cx,
 
   MOZ_ASSERT(isCompressed<Unit>());
 
+  // A source that keeps needing decompression is cheaper to hold in
+  // uncompressed form. If pinning fails we simply stay compressed.
+  if (MOZ_UNLIKELY(decompressedChunks_ >= MaxDecompressedChunks)) {
+    if (tryPinUncompressedSource<Unit>(cx)) {
+      return uncompressedData<Unit>()->units() + begin;
+    }
+  }
+
   // Determine first/last chunks, the offset (in bytes) into the first chunk
   // of the requested units, and the number of bytes in the last chunk.
   //
@@ -629,6 +629,12 @@ class ScriptSource {
                       CompressedData<char16_t>>
       pendingCompressed_;
 
+  // Number of chunks of compressed source that have been decompressed on
+  // behalf of this source, typically to delazify functions within it. Once
+  // this crosses MaxDecompressedChunks the source is converted back to --
+  // and then pinned as -- uncompressed; see ScriptSource::units.
+  uint32_t decompressedChunks_ = 0;
+
   // The filename of this script.
   mozilla::Maybe<SharedImmutableString> filename_;
 
@@ -733,6 +739,15 @@ class ScriptSource {
    */
   static constexpr size_t MinimumCompressibleLength = 256;
 
+  /**
+   * How many chunk decompressions a compressed source tolerates before it is
+   * pinned in uncompressed form. Sources whose functions keep getting
+   * delazified pay the decompression cost over and over -- and the
+   * UncompressedSourceCache is purged on GC -- so past this point keeping
+   * the uncompressed text costs less than repeatedly re-inflating it.
+   */
+  static constexpr uint32_t MaxDecompressedChunks = 32;
+
   mozilla::Maybe<SharedImmutableString> getOrCreateStringZ(JSContext* cx,
                                                            UniqueChars&& str);
   mozilla::Maybe<SharedImmutableTwoByteString> getOrCreateStringZ(
@@ -1020,6 +1035,12 @@ class ScriptSource {
                                                 size_t length,
                                                 SourceRetrievable retrievable);
 
+  // Decompress the entire source and overwrite |data| with it, preserving
+  // retrievability. Returns false -- leaving the source compressed and
+  // reporting nothing -- if memory is not available.
+  template <typename Unit>
+  MOZ_MUST_USE bool tryPinUncompressedSource(JSContext* cx);
+
  public:
   // Initialize a fresh |ScriptSource| with unretrievable, uncompressed source.
   template <typename Unit>
@@ -1841,6 +1862,13 @@ class RuntimeScriptData final {
 
   uint32_t natoms_ = 0;
 
+  // Set when a script using this data first receives an Ion compilation.
+  // Scripts with byte-identical bytecode in other realms share this data via
+  // the shared script data table and use the flag to fast-track their own
+  // warm-up. Not part of the table hash, which only covers the immutable
+  // data and atoms.
+  bool reachedIonCompile_ = false;
+
   js::UniquePtr<ImmutableScriptData> isd_ = nullptr;
 
   // NOTE: The raw bytes of this structure are used for hashing so use explicit
@@ -1879,6 +1907,10 @@ class RuntimeScriptData final {
   }
 
   uint32_t natoms() const { return natoms_; }
+
+  bool reachedIonCompile() const { return reachedIonCompile_; }
+  void setReachedIonCompile() { reachedIonCompile_ = true; }
+
   GCPtrAtom* atoms() {
     uintptr_t base = reinterpret_cast<uintptr_t>(this);
     return reinterpret_cast<GCPtrAtom*>(base + atomOffset());
@@ -1149,9 +1149,20 @@ JSObject* ObjectGroup::newPlainObject(JSContext* cx, IdValuePair* properties,
   }
 
   ObjectGroupRealm::PlainObjectKey::Lookup lookup(properties, nproperties);
-  ObjectGroupRealm::PlainObjectTable::Ptr p = table->lookup(lookup);
 
-  if (!p) {
+  ObjectGroupRealm::PlainObjectEntry* cached =
+      realm.plainObjectEntryCache.lookup(properties, nproperties);
+
+  if (!cached) {
+    ObjectGroupRealm::PlainObjectTable::Ptr p = table->lookup(lookup);
+    if (p) {
+      realm.plainObjectEntryCache.put(p->key().properties,
+                                      p->key().nproperties, &p->value());
+      cached = &p->value();
+    }
+  }
+
+  if (!cached) {
     if (!CanShareObjectGroup(properties, nproperties)) {
       return NewPlainObjectWithProperties(cx, properties, nproperties, newKind);
     }
@@ -1234,13 +1245,16 @@ JSObject* ObjectGroup::newPlainObject(JSContext* cx, IdValuePair* properties,
       return nullptr;
     }
 
+    // Adding can rehash the table and move its entries.
+    realm.plainObjectEntryCache.purge();
+
     mozilla::Unused << ids.release();
     mozilla::Unused << types.release();
 
     return obj;
   }
 
-  RootedObjectGroup group(cx, p->value().group);
+  RootedObjectGroup group(cx, cached->group);
 
   // AutoSweepObjectGroup checks no GC happens in its scope, so we use Maybe
   // and reset() it before GC calls.
@@ -1252,7 +1266,7 @@ JSObject* ObjectGroup::newPlainObject(JSContext* cx, IdValuePair* properties,
   // this table entry.
   if (!group->unknownProperties(*sweep)) {
     for (size_t i = 0; i < nproperties; i++) {
-      TypeSet::Type type = p->value().types[i];
+      TypeSet::Type type = cached->types[i];
       TypeSet::Type ntype = GetValueTypeForTable(properties[i].value);
       if (ntype == type) {
         continue;
@@ -1265,7 +1279,7 @@ JSObject* ObjectGroup::newPlainObject(JSContext* cx, IdValuePair* properties,
             type.isPrimitive(ValueType::Int32)) {
           // Include 'double' in the property types to avoid the update below
           // later.
-          p->value().types[i] = TypeSet::DoubleType();
+          cached->types[i] = TypeSet::DoubleType();
         }
         AddTypePropertyId(cx, group, nullptr, IdToTypeId(properties[i].id),
                           ntype);
@@ -1273,7 +1287,7 @@ JSObject* ObjectGroup::newPlainObject(JSContext* cx, IdValuePair* properties,
     }
   }
 
-  RootedShape shape(cx, p->value().shape);
+  RootedShape shape(cx, cached->shape);
 
   if (group->maybePreliminaryObjects(*sweep)) {
     newKind = TenuredObject;
@@ -1756,6 +1770,7 @@ void ObjectGroupRealm::clearTables() {
     lazyTable->clear();
   }
   defaultNewGroupCache.purge();
+  plainObjectEntryCache.purge();
 }
 
 /* static */
@@ -1782,6 +1797,9 @@ void ObjectGroupRealm::traceWeak(JSTracer* trc) {
   }
   if (plainObjectTable) {
     plainObjectTable->traceWeak(trc);
+
+    // Sweeping may have removed the entry the cache points at.
+    plainObjectEntryCache.purge();
   }
   if (stringSplitStringGroup) {
     JS::GCPolicy<WeakHeapPtrObjectGroup>::traceWeak(trc,
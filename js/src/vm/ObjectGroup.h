@@ -573,6 +573,47 @@ class ObjectGroupRealm {
                                           JSObject* associated);
   } defaultNewGroupCache = {};
 
+  // This cache is purged on GC.
+  //
+  // Cache for the last entry found in plainObjectTable. Large JSON payloads
+  // are dominated by arrays of objects with identical property names, so
+  // remembering the last entry lets ObjectGroup::newPlainObject skip hashing
+  // every element's property ids. The pointers are into the table, so the
+  // cache is also purged whenever the table is mutated or cleared.
+  class PlainObjectEntryCache {
+    const jsid* properties_;
+    uint32_t nproperties_;
+    PlainObjectEntry* entry_;
+
+   public:
+    PlainObjectEntryCache() { purge(); }
+
+    void purge() {
+      properties_ = nullptr;
+      nproperties_ = 0;
+      entry_ = nullptr;
+    }
+    void put(const jsid* properties, uint32_t nproperties,
+             PlainObjectEntry* entry) {
+      properties_ = properties;
+      nproperties_ = nproperties;
+      entry_ = entry;
+    }
+
+    MOZ_ALWAYS_INLINE PlainObjectEntry* lookup(IdValuePair* properties,
+                                               size_t nproperties) {
+      if (!entry_ || nproperties != nproperties_) {
+        return nullptr;
+      }
+      for (size_t i = 0; i < nproperties; i++) {
+        if (properties[i].id != properties_[i]) {
+          return nullptr;
+        }
+      }
+      return entry_;
+    }
+  } plainObjectEntryCache = {};
+
   // Tables for managing groups common to the contents of large script
   // singleton objects and JSON objects. These are vanilla ArrayObjects and
   // PlainObjects, so we distinguish the groups of different ones by looking
@@ -637,7 +678,10 @@ class ObjectGroupRealm {
 
   void traceWeak(JSTracer* trc);
 
-  void purge() { defaultNewGroupCache.purge(); }
+  void purge() {
+    defaultNewGroupCache.purge();
+    plainObjectEntryCache.purge();
+  }
 
 #ifdef JSGC_HASH_TABLE_CHECKS
   void checkTablesAfterMovingGC() {
@@ -920,7 +920,11 @@ bool js::StringHasRegExpMetaChars(JSLinearString* str) {
 /* RegExpShared */
 
 RegExpShared::RegExpShared(JSAtom* source, RegExpFlags flags)
-    : source(source), parenCount(0), flags(flags), canStringMatch(false) {}
+    : source(source),
+      parenCount(0),
+      flags(flags),
+      canStringMatch(false),
+      ticks_(TicksBeforeNativeCompile) {}
 
 void RegExpShared::traceChildren(JSTracer* trc) {
   // Discard code to avoid holding onto ExecutablePools.
@@ -1014,9 +1018,19 @@ bool RegExpShared::compile(JSContext* cx, MutableHandleRegExpShared re,
     compilation.jitCode = code.jitCode;
   } else if (code.byteCode) {
     MOZ_ASSERT(tables.empty(), "RegExpInterpreter does not use data tables");
-    compilation.byteCode = code.byteCode;
-    AddCellMemory(re, compilation.byteCodeLength(),
-                  MemoryUse::RegExpSharedBytecode);
+    if (force == DontForceByteCode) {
+      // The native compiler declined this pattern, so a future tier-up
+      // attempt won't fare any better.
+      compilation.failedNativeCompile = true;
+    }
+    if (compilation.byteCode) {
+      // A tier-up compile fell back to bytecode we already have.
+      js_free(code.byteCode);
+    } else {
+      compilation.byteCode = code.byteCode;
+      AddCellMemory(re, compilation.byteCodeLength(),
+                    MemoryUse::RegExpSharedBytecode);
+    }
   }
 
   return true;
@@ -1046,11 +1060,37 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
 
   CompilationMode mode = matches ? Normal : MatchOnly;
 
-  /* Compile the code at point-of-use. */
-  if (!compileIfNecessary(cx, re, input, mode, DontForceByteCode)) {
+  /*
+   * Compile the code at point-of-use. Most regexps are executed only a
+   * handful of times, so we compile to bytecode first and tier up to
+   * native code only once this regexp has seen enough executions, or when
+   * matching a long input, where a single native run already amortizes
+   * the cost of compilation.
+   */
+  if (input->length() >= MinInputLengthForNativeCompile) {
+    re->markForTierUp();
+  }
+  ForceByteCodeEnum force =
+      re->markedForTierUp() ? DontForceByteCode : ForceByteCode;
+  if (!compileIfNecessary(cx, re, input, mode, force)) {
     return RegExpRunStatus_Error;
   }
 
+  /*
+   * If the regexp became hot after it was compiled to bytecode, tier up
+   * now: compileIfNecessary is satisfied by the existing bytecode.
+   */
+  {
+    RegExpCompilation& compilation =
+        re->compilation(mode, input->hasLatin1Chars());
+    if (re->markedForTierUp() && !re->canStringMatch && !compilation.jitCode &&
+        !compilation.failedNativeCompile) {
+      if (!compile(cx, re, input, mode, DontForceByteCode)) {
+        return RegExpRunStatus_Error;
+      }
+    }
+  }
+
   /*
    * Ensure sufficient memory for output vector.
    * No need to initialize it. The RegExp engine fills them in on a match.
@@ -1158,6 +1198,9 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
   uint8_t* byteCode = re->compilation(mode, input->hasLatin1Chars()).byteCode;
   AutoTraceLog logInterpreter(logger, TraceLogger_IrregexpExecute);
 
+  // Count this interpreted execution towards tiering up to native code.
+  re->tierUpTick();
+
   AutoStableStringChars inputChars(cx);
   if (!inputChars.init(cx, input)) {
     return RegExpRunStatus_Error;
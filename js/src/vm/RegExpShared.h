@@ -86,6 +86,11 @@ class RegExpShared : public gc::TenuredCell {
     WeakHeapPtr<jit::JitCode*> jitCode;
     uint8_t* byteCode = nullptr;
 
+    // Set when a tier-up compile declined to produce native code (for
+    // example because the pattern is too long), so that we don't keep
+    // re-parsing the pattern on every execution.
+    bool failedNativeCompile = false;
+
     bool compiled(ForceByteCodeEnum force = DontForceByteCode) const {
       return byteCode || (force == DontForceByteCode && jitCode);
     }
@@ -106,6 +111,12 @@ class RegExpShared : public gc::TenuredCell {
   JS::RegExpFlags flags;
   bool canStringMatch;
 
+  // Count-down of executions until this regexp is compiled to native code.
+  // Most regexps are executed only a handful of times, so they start in the
+  // bytecode interpreter and only tier up once the counter reaches zero,
+  // where the up-front cost of native compilation pays for itself.
+  uint32_t ticks_;
+
   static int CompilationIndex(CompilationMode mode, bool latin1) {
     switch (mode) {
       case Normal:
@@ -182,6 +193,22 @@ class RegExpShared : public gc::TenuredCell {
            isCompiled(MatchOnly, true) || isCompiled(MatchOnly, false);
   }
 
+  // Number of executions in the bytecode interpreter before a regexp is
+  // tiered up to native code.
+  static const uint32_t TicksBeforeNativeCompile = 10;
+
+  // Inputs at least this long tier up immediately: a single native run on
+  // a long input already amortizes the cost of compilation.
+  static const size_t MinInputLengthForNativeCompile = 1024;
+
+  void tierUpTick() {
+    if (ticks_ > 0) {
+      ticks_--;
+    }
+  }
+  void markForTierUp() { ticks_ = 0; }
+  bool markedForTierUp() const { return ticks_ == 0; }
+
   void traceChildren(JSTracer* trc);
   void discardJitCode();
   void finalize(JSFreeOp* fop);
@@ -44,6 +44,7 @@
 #endif
 #include "js/Stream.h"
 #include "js/Symbol.h"
+#include "js/Transcoding.h"
 #include "js/UniquePtr.h"
 #include "js/Utility.h"
 #include "js/Vector.h"
@@ -68,6 +69,7 @@ namespace js {
 class AutoAssertNoContentJS;
 class AutoKeepAtoms;
 class EnterDebuggeeNoExecute;
+class ScriptBytecodeCache;
 #ifdef JS_TRACE_LOGGING
 class TraceLoggerThread;
 #endif
@@ -620,7 +622,9 @@ struct JSRuntime {
 
   bool hasInitializedSelfHosting() const { return selfHostingGlobal_; }
 
-  bool initSelfHosting(JSContext* cx);
+  bool initSelfHosting(JSContext* cx,
+                       JS::TranscodeRange xdrCache = JS::TranscodeRange(),
+                       JS::TranscodeBuffer* xdrWriter = nullptr);
   void finishSelfHosting();
   void traceSelfHostingGlobal(JSTracer* trc);
   bool isSelfHostingGlobal(JSObject* global) {
@@ -828,6 +832,12 @@ struct JSRuntime {
     return scriptDataTable_.ref();
   }
 
+  // Opt-in content-addressed cache of XDR bytecode consulted by main thread
+  // CompileGlobalScript calls. Null unless the embedder enabled it. See
+  // vm/ScriptBytecodeCache.h.
+  js::MainThreadData<mozilla::UniquePtr<js::ScriptBytecodeCache>>
+      scriptBytecodeCache;
+
  private:
   static mozilla::Atomic<size_t> liveRuntimesCount;
 
@@ -1318,9 +1318,13 @@ bool SavedStacks::copyAsyncStack(JSContext* cx, HandleObject asyncStack,
 void SavedStacks::traceWeak(JSTracer* trc) {
   frames.traceWeak(trc);
   pcLocationMap.traceWeak(trc);
+  sourceAtomMap.traceWeak(trc);
 }
 
-void SavedStacks::trace(JSTracer* trc) { pcLocationMap.trace(trc); }
+void SavedStacks::trace(JSTracer* trc) {
+  pcLocationMap.trace(trc);
+  sourceAtomMap.trace(trc);
+}
 
 uint32_t SavedStacks::count() { return frames.count(); }
 
@@ -1328,7 +1332,8 @@ void SavedStacks::clear() { frames.clear(); }
 
 size_t SavedStacks::sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) {
   return frames.shallowSizeOfExcludingThis(mallocSizeOf) +
-         pcLocationMap.shallowSizeOfExcludingThis(mallocSizeOf);
+         pcLocationMap.shallowSizeOfExcludingThis(mallocSizeOf) +
+         sourceAtomMap.shallowSizeOfExcludingThis(mallocSizeOf);
 }
 
 // Given that we have captured a stack frame with the given principals and
@@ -1763,18 +1768,33 @@ bool SavedStacks::getLocation(JSContext* cx, const FrameIter& iter,
   PCLocationMap::AddPtr p = pcLocationMap.lookupForAdd(key);
 
   if (!p) {
+    // The source atom and id are per-script, not per-pc, so look them up in
+    // the per-script cache first. This avoids re-hashing and re-atomizing the
+    // same source URL for every new pc we see in the script.
     RootedAtom source(cx);
-    if (const char16_t* displayURL = iter.displayURL()) {
-      source = AtomizeChars(cx, displayURL, js_strlen(displayURL));
+    uint32_t sourceId = script->scriptSource()->id();
+    SourceAtomMap::AddPtr sp = sourceAtomMap.lookupForAdd(ScriptKey(script));
+    if (sp) {
+      MOZ_ASSERT(sp->value().sourceId == sourceId);
+      source = sp->value().source;
     } else {
-      const char* filename = script->filename() ? script->filename() : "";
-      source = Atomize(cx, filename, strlen(filename));
-    }
-    if (!source) {
-      return false;
+      if (const char16_t* displayURL = iter.displayURL()) {
+        source = AtomizeChars(cx, displayURL, js_strlen(displayURL));
+      } else {
+        const char* filename = script->filename() ? script->filename() : "";
+        source = Atomize(cx, filename, strlen(filename));
+      }
+      if (!source) {
+        return false;
+      }
+
+      if (!sourceAtomMap.add(sp, ScriptKey(script),
+                             SourceAtomValue(source, sourceId))) {
+        ReportOutOfMemory(cx);
+        return false;
+      }
     }
 
-    uint32_t sourceId = script->scriptSource()->id();
     uint32_t column;
     uint32_t line = PCToLineNumber(script, pc, &column);
 
@@ -295,6 +295,59 @@ class SavedStacks {
       GCHashMap<PCKey, LocationValue, PCLocationHasher, SystemAllocPolicy>;
   PCLocationMap pcLocationMap;
 
+  // Cache for memoizing the source atom and id per script. These are the
+  // same for every pc in a script, so this saves re-atomizing the source URL
+  // for each new pc the map above sees, which adds up when capturing deep
+  // stacks. The same weak-key/strong-value tracing caveats as for the map
+  // above apply.
+
+  struct ScriptKey {
+    explicit ScriptKey(JSScript* script) : script(script) {}
+
+    HeapPtr<JSScript*> script;
+
+    void trace(JSTracer* trc) { /* ScriptKey is weak. */
+    }
+    bool traceWeak(JSTracer* trc) {
+      return TraceWeakEdge(trc, &script, "traceWeak");
+    }
+  };
+
+  struct SourceAtomValue {
+    SourceAtomValue() : source(nullptr), sourceId(0) {}
+    SourceAtomValue(JSAtom* source, uint32_t sourceId)
+        : source(source), sourceId(sourceId) {}
+
+    void trace(JSTracer* trc) {
+      TraceNullableEdge(trc, &source, "SavedStacks::SourceAtomValue::source");
+    }
+
+    bool traceWeak(JSTracer* trc) {
+      MOZ_ASSERT(source);
+      return TraceWeakEdge(trc, &source, "traceWeak");
+    }
+
+    HeapPtr<JSAtom*> source;
+    uint32_t sourceId;
+  };
+
+  struct SourceAtomHasher : public DefaultHasher<ScriptKey> {
+    using ScriptPtrHasher = DefaultHasher<JSScript*>;
+
+    static HashNumber hash(const ScriptKey& key) {
+      return ScriptPtrHasher::hash(key.script);
+    }
+
+    static bool match(const ScriptKey& l, const ScriptKey& k) {
+      return ScriptPtrHasher::match(l.script, k.script);
+    }
+  };
+
+  using SourceAtomMap =
+      GCHashMap<ScriptKey, SourceAtomValue, SourceAtomHasher,
+                SystemAllocPolicy>;
+  SourceAtomMap sourceAtomMap;
+
   MOZ_MUST_USE bool getLocation(JSContext* cx, const FrameIter& iter,
                                 MutableHandle<LocationValue> locationp);
 };
@@ -0,0 +1,171 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "vm/ScriptBytecodeCache.h"
+
+#include <algorithm>
+
+using namespace js;
+
+static void AddUint32ToHash(mozilla::SHA1Sum& sha1, uint32_t value) {
+  sha1.update(&value, sizeof(value));
+}
+
+/* static */
+ScriptBytecodeCache::Key ScriptBytecodeCache::ComputeKey(
+    const void* units, size_t unitSize, size_t length,
+    const JS::ReadOnlyCompileOptions& options) {
+  mozilla::SHA1Sum sha1;
+
+  // The same source hashes differently depending on the unit type it is
+  // presented in; that only costs a redundant entry if a script is compiled
+  // both from UTF-8 and from UTF-16.
+  sha1.update(units, unitSize * length);
+  AddUint32ToHash(sha1, uint32_t(unitSize));
+  AddUint32ToHash(sha1, uint32_t(length));
+
+  // The filename and position are baked into the generated script.
+  if (const char* filename = options.filename()) {
+    sha1.update(filename, strlen(filename));
+  }
+  AddUint32ToHash(sha1, options.lineno);
+  AddUint32ToHash(sha1, options.column);
+  AddUint32ToHash(sha1, options.scriptSourceOffset);
+
+  // Options that change the generated script.
+  uint32_t flags = uint32_t(options.mutedErrors()) << 0 |
+                   uint32_t(options.forceFullParse()) << 1 |
+                   uint32_t(options.forceStrictMode()) << 2 |
+                   uint32_t(options.selfHostingMode) << 3 |
+                   uint32_t(options.discardSource) << 4 |
+                   uint32_t(options.sourceIsLazy) << 5 |
+                   uint32_t(options.nonSyntacticScope) << 6 |
+                   uint32_t(options.noScriptRval) << 7 |
+                   uint32_t(options.isRunOnce) << 8;
+  AddUint32ToHash(sha1, flags);
+  AddUint32ToHash(sha1, options.instrumentationKinds);
+
+  Key key;
+  static_assert(sizeof(key.hash) == sizeof(mozilla::SHA1Sum::Hash),
+                "Key must hold a full SHA1 hash");
+  sha1.finish(key.hash);
+  return key;
+}
+
+bool ScriptBytecodeCache::lookup(const Key& key,
+                                 JS::TranscodeRange* range) const {
+  Map::Ptr p = map_.lookup(key);
+  if (!p) {
+    return false;
+  }
+
+  // The decoder only reads the data; imported blobs may be mapped read-only.
+  const Entry& entry = p->value();
+  *range = JS::TranscodeRange(const_cast<uint8_t*>(entry.data), entry.length);
+  return true;
+}
+
+bool ScriptBytecodeCache::put(const Key& key, JS::TranscodeBuffer&& buffer) {
+  Map::AddPtr p = map_.lookupForAdd(key);
+  if (p) {
+    return true;
+  }
+
+  Entry entry;
+  entry.owned = std::move(buffer);
+  if (!map_.add(p, key, std::move(entry))) {
+    return false;
+  }
+
+  Entry& added = p->value();
+  added.data = added.owned.begin();
+  added.length = added.owned.length();
+  return true;
+}
+
+static bool AppendUint32(JS::TranscodeBuffer& buffer, uint32_t value) {
+  return buffer.append(reinterpret_cast<const uint8_t*>(&value),
+                       sizeof(value));
+}
+
+bool ScriptBytecodeCache::exportData(JS::TranscodeBuffer& buffer) const {
+  if (!AppendUint32(buffer, Magic) || !AppendUint32(buffer, Version) ||
+      !AppendUint32(buffer, uint32_t(map_.count())) ||
+      !AppendUint32(buffer, 0)) {
+    return false;
+  }
+
+  for (Map::Range r = map_.all(); !r.empty(); r.popFront()) {
+    const Key& key = r.front().key();
+    const Entry& entry = r.front().value();
+    if (!buffer.append(key.hash, sizeof(key.hash)) ||
+        !AppendUint32(buffer, uint32_t(entry.length)) ||
+        !buffer.append(entry.data, entry.length)) {
+      return false;
+    }
+
+    // Pad so that the next entry's XDR data stays 8-byte aligned.
+    while (buffer.length() % 8) {
+      if (!buffer.append(uint8_t(0))) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool ScriptBytecodeCache::importData(const uint8_t* data, size_t length) {
+  MOZ_ASSERT(uintptr_t(data) % 8 == 0);
+
+  size_t cursor = 0;
+  auto readUint32 = [&](uint32_t* out) {
+    if (length - cursor < sizeof(uint32_t)) {
+      return false;
+    }
+    memcpy(out, data + cursor, sizeof(uint32_t));
+    cursor += sizeof(uint32_t);
+    return true;
+  };
+
+  uint32_t magic, version, count, padding;
+  if (!readUint32(&magic) || !readUint32(&version) || !readUint32(&count) ||
+      !readUint32(&padding)) {
+    return false;
+  }
+  if (magic != Magic || version != Version) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (length - cursor < mozilla::SHA1Sum::kHashSize) {
+      return false;
+    }
+    Key key;
+    memcpy(key.hash, data + cursor, sizeof(key.hash));
+    cursor += sizeof(key.hash);
+
+    uint32_t entryLength;
+    if (!readUint32(&entryLength) || length - cursor < entryLength) {
+      return false;
+    }
+
+    Entry entry;
+    entry.data = data + cursor;
+    entry.length = entryLength;
+    cursor = std::min(length, (cursor + entryLength + 7) & ~size_t(7));
+
+    Map::AddPtr p = map_.lookupForAdd(key);
+    if (p) {
+      continue;
+    }
+    if (!map_.add(p, key, std::move(entry))) {
+      return false;
+    }
+  }
+
+  return true;
+}
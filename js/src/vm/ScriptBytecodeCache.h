@@ -0,0 +1,91 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef vm_ScriptBytecodeCache_h
+#define vm_ScriptBytecodeCache_h
+
+#include "mozilla/SHA1.h"
+
+#include <string.h>
+
+#include "js/AllocPolicy.h"
+#include "js/CompileOptions.h"
+#include "js/HashTable.h"
+#include "js/Transcoding.h"
+
+namespace js {
+
+/*
+ * A content-addressed cache of XDR bytecode for whole compilation units,
+ * keyed by a hash of the source text together with the compile options that
+ * affect the generated script. CompileGlobalScript consults the cache before
+ * parsing and fills it after a successful compilation, so repeated
+ * compilations of identical source (for example large vendor bundles loaded
+ * on each process start) decode bytecode instead of parsing.
+ *
+ * The cache is opt-in (see EnableScriptBytecodeCache in jsfriendapi.h) and
+ * is only used by main thread compilations. Persistence is the embedder's
+ * responsibility: the cache contents can be exported as a flat blob at
+ * shutdown and imported again at startup. Imported entries are decoded in
+ * place, so the blob may be a read-only memory mapping, but it must then
+ * stay valid for the lifetime of the runtime.
+ */
+class ScriptBytecodeCache {
+ public:
+  struct Key {
+    uint8_t hash[mozilla::SHA1Sum::kHashSize];
+  };
+
+  static Key ComputeKey(const void* units, size_t unitSize, size_t length,
+                        const JS::ReadOnlyCompileOptions& options);
+
+  // Find an entry, returning the XDR data to decode from.
+  bool lookup(const Key& key, JS::TranscodeRange* range) const;
+
+  // Add the XDR encoding of a script compiled from |key|'s source and
+  // options. Failure leaves the cache unchanged.
+  bool put(const Key& key, JS::TranscodeBuffer&& buffer);
+
+  // Append the entire cache contents, both imported and newly added entries,
+  // to |buffer| in the format understood by importData().
+  bool exportData(JS::TranscodeBuffer& buffer) const;
+
+  // Populate the cache from a blob previously produced by exportData().
+  // |data| is borrowed: it must be 8-byte aligned and outlive the cache.
+  bool importData(const uint8_t* data, size_t length);
+
+ private:
+  struct KeyHasher {
+    using Lookup = Key;
+    static HashNumber hash(const Lookup& lookup) {
+      HashNumber h;
+      memcpy(&h, lookup.hash, sizeof(h));
+      return h;
+    }
+    static bool match(const Key& key, const Lookup& lookup) {
+      return memcmp(key.hash, lookup.hash, sizeof(key.hash)) == 0;
+    }
+  };
+
+  struct Entry {
+    // Owned storage for entries added this session. Imported entries point
+    // into the imported blob and leave this empty.
+    JS::TranscodeBuffer owned;
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+  };
+
+  using Map = HashMap<Key, Entry, KeyHasher, SystemAllocPolicy>;
+
+  static const uint32_t Magic = 0x4a534243;  // 'JSBC'
+  static const uint32_t Version = 1;
+
+  Map map_;
+};
+
+}  // namespace js
+
+#endif  // vm_ScriptBytecodeCache_h
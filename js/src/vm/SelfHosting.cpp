@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <iterator>
 
+#include "jsapi.h"
 #include "jsdate.h"
 #include "jsfriendapi.h"
 #include "selfhosted.out.h"
@@ -2694,7 +2695,8 @@ static bool VerifyGlobalNames(JSContext* cx, Handle<GlobalObject*> shg) {
   return true;
 }
 
-bool JSRuntime::initSelfHosting(JSContext* cx) {
+bool JSRuntime::initSelfHosting(JSContext* cx, JS::TranscodeRange xdrCache,
+                                JS::TranscodeBuffer* xdrWriter) {
   MOZ_ASSERT(!selfHostingGlobal_);
 
   if (cx->runtime()->parentRuntime) {
@@ -2725,27 +2727,58 @@ bool JSRuntime::initSelfHosting(JSContext* cx) {
    */
   AutoSelfHostingErrorReporter errorReporter(cx);
 
-  uint32_t srcLen = GetRawScriptsSize();
-
-  const unsigned char* compressed = compressedSources;
-  uint32_t compressedLen = GetCompressedSize();
-  auto src = cx->make_pod_array<char>(srcLen);
-  if (!src ||
-      !DecompressString(compressed, compressedLen,
-                        reinterpret_cast<unsigned char*>(src.get()), srcLen)) {
-    return false;
+  RootedScript script(cx);
+  if (xdrCache.length() > 0) {
+    // Decode the snapshot produced by a previous initialization. A snapshot
+    // from a different build, or otherwise undecodable bytes, fails softly
+    // here and we compile the sources below.
+    JS::TranscodeResult result = JS::DecodeScript(cx, xdrCache, &script);
+    if (result == JS::TranscodeResult_Throw) {
+      return false;
+    }
+    MOZ_ASSERT_IF(result != JS::TranscodeResult_Ok, !script);
   }
 
-  CompileOptions options(cx);
-  FillSelfHostingCompileOptions(options);
+  if (!script) {
+    uint32_t srcLen = GetRawScriptsSize();
 
-  JS::SourceText<mozilla::Utf8Unit> srcBuf;
-  if (!srcBuf.init(cx, std::move(src), srcLen)) {
-    return false;
+    const unsigned char* compressed = compressedSources;
+    uint32_t compressedLen = GetCompressedSize();
+    auto src = cx->make_pod_array<char>(srcLen);
+    if (!src ||
+        !DecompressString(compressed, compressedLen,
+                          reinterpret_cast<unsigned char*>(src.get()),
+                          srcLen)) {
+      return false;
+    }
+
+    CompileOptions options(cx);
+    FillSelfHostingCompileOptions(options);
+
+    JS::SourceText<mozilla::Utf8Unit> srcBuf;
+    if (!srcBuf.init(cx, std::move(src), srcLen)) {
+      return false;
+    }
+
+    script = CompileDontInflate(cx, options, srcBuf);
+    if (!script) {
+      return false;
+    }
+
+    // Write a snapshot for the embedder to share with later runtime
+    // initializations, before execution can mutate the script. Failing to
+    // encode is not an error; EncodeScript leaves the buffer empty in that
+    // case so we never hand out a partial snapshot.
+    if (xdrWriter) {
+      if (JS::EncodeScript(cx, *xdrWriter, script) ==
+          JS::TranscodeResult_Throw) {
+        return false;
+      }
+    }
   }
 
   RootedValue rv(cx);
-  if (!EvaluateDontInflate(cx, options, srcBuf, &rv)) {
+  if (!JS_ExecuteScript(cx, script, &rv)) {
     return false;
   }
 
@@ -1940,9 +1940,30 @@ bool JSStructuredCloneWriter::transferOwnership() {
         point = out.iter();
         point += pointOffset;
 
-        if (!JS::DetachArrayBuffer(cx, arrayBuffer)) {
+        // The contents have already been copied into the clone buffer, so
+        // honoring a copy-on-transfer request just means leaving the source
+        // buffer attached.
+        if (!cloneDataPolicy.areTransferredArrayBuffersCopied() &&
+            !JS::DetachArrayBuffer(cx, arrayBuffer)) {
           return false;
         }
+      } else if (cloneDataPolicy.areTransferredArrayBuffersCopied()) {
+        // Copy-on-transfer: hand the receiver a private copy of the
+        // contents but leave the source buffer attached. The receiver
+        // adopts the copy without copying again, so the contents cross
+        // with a single copy rather than the two a plain clone makes.
+        size_t nbytes = arrayBuffer->byteLength();
+
+        uint8_t* copy = js_pod_malloc<uint8_t>(nbytes);
+        if (!copy) {
+          ReportOutOfMemory(cx);
+          return false;
+        }
+        memcpy(copy, arrayBuffer->dataPointer(), nbytes);
+
+        content = copy;
+        ownership = JS::SCTAG_TMO_ALLOC_DATA;
+        extraData = nbytes;
       } else {
         size_t nbytes = arrayBuffer->byteLength();
 
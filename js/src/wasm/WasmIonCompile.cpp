@@ -3372,11 +3372,9 @@ static bool EmitMemFillInline(FunctionCompiler& f, MDefinition* start,
                               MDefinition* val, MDefinition* len) {
   MOZ_ASSERT(MaxInlineMemoryFillLength != 0);
 
-  MOZ_ASSERT(len->isConstant() && len->type() == MIRType::Int32 &&
-             val->isConstant() && val->type() == MIRType::Int32);
+  MOZ_ASSERT(len->isConstant() && len->type() == MIRType::Int32);
 
   uint32_t length = len->toConstant()->toInt32();
-  uint32_t value = val->toConstant()->toInt32();
   MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryFillLength);
 
   // Compute the number of copies of each width we will need to do
@@ -3393,18 +3391,59 @@ static bool EmitMemFillInline(FunctionCompiler& f, MDefinition* start,
 
   // Generate splatted definitions for wider fills as needed
 #ifdef JS_64BIT
-  MDefinition* val8 =
-      numCopies8 ? f.constant(int64_t(SplatByteToUInt<uint64_t>(value, 8)))
-                 : nullptr;
+  MDefinition* val8 = nullptr;
+#endif
+  MDefinition* val4 = nullptr;
+  MDefinition* val2 = nullptr;
+  if (val->isConstant()) {
+    uint32_t value = val->toConstant()->toInt32();
+#ifdef JS_64BIT
+    if (numCopies8) {
+      val8 = f.constant(int64_t(SplatByteToUInt<uint64_t>(value, 8)));
+    }
+#endif
+    if (numCopies4) {
+      val4 = f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 4)),
+                        MIRType::Int32);
+    }
+    if (numCopies2) {
+      val2 = f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 2)),
+                        MIRType::Int32);
+    }
+  } else if (numCopies2 || numCopies4
+#ifdef JS_64BIT
+             || numCopies8
 #endif
-  MDefinition* val4 =
-      numCopies4 ? f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 4)),
-                              MIRType::Int32)
-                 : nullptr;
-  MDefinition* val2 =
-      numCopies2 ? f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 2)),
-                              MIRType::Int32)
-                 : nullptr;
+  ) {
+    // Splat the dynamic fill value into the wider widths. Only the low
+    // eight bits of the value are significant.
+    MDefinition* byte = f.binary<MBitAnd>(
+        val, f.constant(Int32Value(0xff), MIRType::Int32), MIRType::Int32);
+    val2 = f.binary<MBitOr>(
+        byte,
+        f.binary<MLsh>(byte, f.constant(Int32Value(8), MIRType::Int32),
+                       MIRType::Int32),
+        MIRType::Int32);
+    if (numCopies4
+#ifdef JS_64BIT
+        || numCopies8
+#endif
+    ) {
+      val4 = f.binary<MBitOr>(
+          val2,
+          f.binary<MLsh>(val2, f.constant(Int32Value(16), MIRType::Int32),
+                         MIRType::Int32),
+          MIRType::Int32);
+    }
+#ifdef JS_64BIT
+    if (numCopies8) {
+      MDefinition* low = f.extendI32(val4, /* isUnsigned = */ true);
+      val8 = f.binary<MBitOr>(
+          low, f.binary<MLsh>(low, f.constant(int64_t(32)), MIRType::Int64),
+          MIRType::Int64);
+    }
+#endif
+  }
 
   // Store the fill value to the destination from high to low. We will trap
   // without writing anything on the first store if any dest byte is
@@ -3463,8 +3502,7 @@ static bool EmitMemFill(FunctionCompiler& f) {
 
   if (MacroAssembler::SupportsFastUnalignedAccesses() && len->isConstant() &&
       len->type() == MIRType::Int32 && len->toConstant()->toInt32() != 0 &&
-      uint32_t(len->toConstant()->toInt32()) <= MaxInlineMemoryFillLength &&
-      val->isConstant() && val->type() == MIRType::Int32) {
+      uint32_t(len->toConstant()->toInt32()) <= MaxInlineMemoryFillLength) {
     return EmitMemFillInline(f, start, val, len);
   }
   return EmitMemFillCall(f, start, val, len);
@@ -251,7 +251,12 @@ MutableModule Module::deserialize(const uint8_t* begin, size_t size,
     return nullptr;
   }
 
-  MOZ_RELEASE_ASSERT(EqualContainers(currentBuildId, deserializedBuildId));
+  // A serialized module can outlive the build (or machine) that produced it
+  // when the embedding stores it in a persistent cache. Reject stale images
+  // as a cache miss rather than crashing; the embedding will recompile.
+  if (!EqualContainers(currentBuildId, deserializedBuildId)) {
+    return nullptr;
+  }
 
   LinkData linkData(Tier::Serialized);
   cursor = linkData.deserialize(cursor);
@@ -2687,10 +2687,16 @@ static void AccumulateTelemetryCallback(int id, uint32_t sample,
     case JS_TELEMETRY_GC_EFFECTIVENESS:
       Telemetry::Accumulate(Telemetry::GC_EFFECTIVENESS, sample);
       break;
+    case JS_TELEMETRY_GC_STRINGS_DEDUPLICATED:
+      Telemetry::Accumulate(Telemetry::GC_STRINGS_DEDUPLICATED, sample);
+      break;
     case JS_TELEMETRY_PRIVILEGED_PARSER_COMPILE_LAZY_AFTER_MS:
       Telemetry::Accumulate(
           Telemetry::JS_PRIVILEGED_PARSER_COMPILE_LAZY_AFTER_MS, sample);
       break;
+    case JS_TELEMETRY_MEGAMORPHIC_CACHE_HIT_RATE:
+      Telemetry::Accumulate(Telemetry::JS_MEGAMORPHIC_CACHE_HIT_RATE, sample);
+      break;
     case JS_TELEMETRY_WEB_PARSER_COMPILE_LAZY_AFTER_MS:
       Telemetry::Accumulate(Telemetry::JS_WEB_PARSER_COMPILE_LAZY_AFTER_MS,
                             sample);
@@ -111,6 +111,14 @@ nsresult AccessibleCaretManager::OnSelectionChanged(Document* aDoc,
     return NS_OK;
   }
 
+  // While the user is dragging a caret, DragCaret() repositions the selection
+  // and updates the carets once per move event, so the selection change
+  // notifications generated by the drag itself are redundant and would just
+  // force an extra caret update and layout flush per move.
+  if (mActiveCaret) {
+    return NS_OK;
+  }
+
   // Move the cursor by JavaScript or unknown internal call.
   if (aReason == nsISelectionListener::NO_REASON) {
     auto mode = static_cast<ScriptUpdateMode>(
@@ -488,6 +496,14 @@ nsresult AccessibleCaretManager::DragCaret(const nsPoint& aPoint) {
 
   // We want to scroll the page even if we failed to drag the caret.
   StartSelectionAutoScrollTimer(aPoint);
+
+  // Dragging the caret only moves the selection; it does not change frame
+  // geometry, so the caret metrics we are about to read are already valid.
+  // Skip the synchronous layout flush that UpdateCarets() would otherwise
+  // perform for every move event, as OnScrollPositionChanged() does.
+  AutoRestore<bool> saveAllowFlushingLayout(mAllowFlushingLayout);
+  mAllowFlushingLayout = false;
+
   UpdateCarets();
   return NS_OK;
 }
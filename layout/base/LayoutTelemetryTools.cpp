@@ -7,6 +7,7 @@
 #include "mozilla/layout/LayoutTelemetryTools.h"
 
 #include "MainThreadUtils.h"
+#include "mozilla/ArrayUtils.h"
 #include "mozilla/Atomics.h"
 #include "mozilla/Telemetry.h"
 
@@ -36,6 +37,19 @@ static nsLiteralCString SubsystemTelemetryKey(LayoutSubsystem aSubsystem) {
 
 static AutoRecord* sCurrentRecord;
 
+// Display list build cost accounting. One slot per LayoutFrameType value;
+// the telemetry key names are generated from the same list that generates
+// the enum.
+static const char* const kFrameTypeKeys[] = {
+#define FRAME_TYPE(name_, first_class_, last_class_) #name_,
+#include "mozilla/FrameTypeList.h"
+#undef FRAME_TYPE
+};
+
+static uint32_t sFrameBuildCounts[ArrayLength(kFrameTypeKeys)];
+static double sFrameBuildDurationMs[ArrayLength(kFrameTypeKeys)];
+static AutoFrameBuildRecord* sCurrentFrameBuildRecord;
+
 static FlushKind ToKind(FlushType aFlushType) {
   switch (aFlushType) {
     default:
@@ -122,6 +136,13 @@ void Data::PingTotalMsPerTickTelemetry(FlushType aFlushType) {
 void Data::PingPerTickTelemetry(FlushType aFlushType) {
   PingFlushPerTickTelemetry(aFlushType);
   PingTotalMsPerTickTelemetry(aFlushType);
+  if (ToKind(aFlushType) == FlushKind::Layout) {
+    // Also flush the display list build cost table. It is global rather than
+    // per-pres-shell, so with several pres shells per tick only the first call
+    // finds anything to report; it is empty unless build cost accounting is
+    // enabled.
+    PingFrameBuildCostTelemetry();
+  }
 }
 
 AutoRecord::AutoRecord(LayoutSubsystem aSubsystem)
@@ -172,5 +193,61 @@ AutoRecord::~AutoRecord() {
   sCurrentRecord = mParentRecord;
 }
 
+AutoFrameBuildRecord::AutoFrameBuildRecord(LayoutFrameType aFrameType)
+    : mParentRecord(sCurrentFrameBuildRecord),
+      mFrameType(aFrameType),
+      mStartTime(TimeStamp::Now()),
+      mDurationMs(0.0) {
+  MOZ_ASSERT(NS_IsMainThread());
+  sFrameBuildCounts[uint8_t(aFrameType)]++;
+
+  // Charge the parent record for the time spent before descending into this
+  // frame, so that every frame class only accumulates its own time.
+  if (mParentRecord) {
+    mParentRecord->mDurationMs +=
+        (mStartTime - mParentRecord->mStartTime).ToMilliseconds();
+  }
+
+  sCurrentFrameBuildRecord = this;
+}
+
+AutoFrameBuildRecord::~AutoFrameBuildRecord() {
+  MOZ_ASSERT(sCurrentFrameBuildRecord == this,
+             "Frame build records should be destroyed in LIFO order");
+
+  TimeStamp now = TimeStamp::Now();
+  mDurationMs += (now - mStartTime).ToMilliseconds();
+  sFrameBuildDurationMs[uint8_t(mFrameType)] += mDurationMs;
+
+  if (mParentRecord) {
+    // Restart the parent recording from this point
+    mParentRecord->mStartTime = now;
+  }
+
+  sCurrentFrameBuildRecord = mParentRecord;
+}
+
+void PingFrameBuildCostTelemetry() {
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(!sCurrentFrameBuildRecord,
+             "Should not ping in the middle of a display list build");
+
+  for (size_t i = 0; i < ArrayLength(kFrameTypeKeys); ++i) {
+    if (!sFrameBuildCounts[i]) {
+      continue;
+    }
+    nsDependentCString key(kFrameTypeKeys[i]);
+    Telemetry::Accumulate(Telemetry::DISPLAY_LIST_BUILD_COUNT_PER_FRAME_CLASS,
+                          key, sFrameBuildCounts[i]);
+    // Report in microseconds; the per-class durations within a tick are
+    // usually well below a millisecond.
+    Telemetry::Accumulate(
+        Telemetry::DISPLAY_LIST_BUILD_US_PER_FRAME_CLASS, key,
+        static_cast<uint32_t>(sFrameBuildDurationMs[i] * 1000.0));
+    sFrameBuildCounts[i] = 0;
+    sFrameBuildDurationMs[i] = 0.0;
+  }
+}
+
 }  // namespace layout_telemetry
 }  // namespace mozilla
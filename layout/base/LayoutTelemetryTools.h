@@ -23,6 +23,9 @@
                                  layout_telemetry::LayoutSubsystem::subsystem)
 
 namespace mozilla {
+
+enum class LayoutFrameType : uint8_t;
+
 namespace layout_telemetry {
 
 enum class FlushKind : uint8_t { Style, Layout, Count };
@@ -84,6 +87,27 @@ class AutoRecord {
   double mDurationMs;
 };
 
+// Opt-in accounting of the time spent building display items for each frame
+// class, enabled with the layout.display-list.build-cost-accounting.enabled
+// pref. Records nest like AutoRecord above, so a frame class is only charged
+// for its own time, not for its descendants'. Display lists are only built on
+// the main thread, so a single static table suffices.
+class AutoFrameBuildRecord {
+ public:
+  explicit AutoFrameBuildRecord(LayoutFrameType aFrameType);
+  ~AutoFrameBuildRecord();
+
+ private:
+  AutoFrameBuildRecord* mParentRecord;
+  LayoutFrameType mFrameType;
+  TimeStamp mStartTime;
+  double mDurationMs;
+};
+
+// Send the non-zero per-frame-class build counts and durations recorded since
+// the last call to telemetry, keyed by frame class name, and reset the table.
+void PingFrameBuildCostTelemetry();
+
 }  // namespace layout_telemetry
 }  // namespace mozilla
 
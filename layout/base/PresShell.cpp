@@ -106,6 +106,7 @@
 #include "MobileViewportManager.h"
 #include "OverflowChangedTracker.h"
 #include "PositionedEventTargeting.h"
+#include "RetainedDisplayListBuilder.h"
 
 #include "nsIReflowCallback.h"
 
@@ -162,6 +163,7 @@
 #include "Layers.h"
 #include "LayerTreeInvalidation.h"
 #include "mozilla/css/ImageLoader.h"
+#include "mozilla/css/Loader.h"
 #include "mozilla/dom/DocumentTimeline.h"
 #include "mozilla/dom/ScriptSettings.h"
 #include "mozilla/ErrorResult.h"
@@ -1259,6 +1261,11 @@ void PresShell::Destroy() {
     mPaintSuppressionTimer = nullptr;
   }
 
+  if (mDiscardTextRunsTimer) {
+    mDiscardTextRunsTimer->Cancel();
+    mDiscardTextRunsTimer = nullptr;
+  }
+
   // Same for our reflow continuation timer
   if (mReflowContinueTimer) {
     mReflowContinueTimer->Cancel();
@@ -1811,6 +1818,21 @@ void PresShell::sPaintSuppressionCallback(nsITimer* aTimer, void* aPresShell) {
   if (self) self->UnsuppressPainting();
 }
 
+void PresShell::sDiscardTextRunsCallback(nsITimer* aTimer, void* aPresShell) {
+  RefPtr<PresShell> self = static_cast<PresShell*>(aPresShell);
+  if (self) self->DiscardTextRunsForBackgroundShell();
+}
+
+void PresShell::DiscardTextRunsForBackgroundShell() {
+  mDiscardTextRunsTimer = nullptr;
+  if (mIsActive || mIsDestroying || mIsDocumentGone) {
+    return;
+  }
+  if (nsIFrame* rootFrame = mFrameConstructor->GetRootFrame()) {
+    nsLayoutUtils::DiscardTextRunsForFrames(rootFrame);
+  }
+}
+
 nsresult PresShell::ResizeReflow(nscoord aWidth, nscoord aHeight,
                                  ResizeReflowOptions aOptions) {
   if (mZoomConstraintsClient) {
@@ -3778,6 +3800,27 @@ void PresShell::UnsuppressPainting() {
     UnsuppressAndInvalidate();
 }
 
+void PresShell::TryUnsuppressPainting() {
+  // Only short-circuit the initial paint suppression; a null timer means
+  // painting is suppressed for some other reason (e.g. the document viewer
+  // hid us) and should stay that way.
+  if (mIsDocumentGone || !mPaintingSuppressed || !mPaintSuppressionTimer) {
+    return;
+  }
+
+  // The paint suppression timer is just a backstop against pathological
+  // loads. If the parser has finished and every render-blocking stylesheet
+  // has arrived, waiting out the rest of the timer cannot change what the
+  // first paint looks like, so paint now rather than quantizing first paint
+  // to the timer.
+  if (mDocument->GetReadyStateEnum() < Document::READYSTATE_INTERACTIVE ||
+      mDocument->CSSLoader()->HasPendingLoads()) {
+    return;
+  }
+
+  UnsuppressPainting();
+}
+
 // Post a request to handle an arbitrary callback after reflow has finished.
 nsresult PresShell::PostReflowCallback(nsIReflowCallback* aCallback) {
   void* result = AllocateByObjectID(eArenaObjectID_nsCallbackEventRequest,
@@ -4353,6 +4396,38 @@ bool PresShell::FrameIsAncestorOfDirtyRoot(nsIFrame* aFrame) const {
   return mDirtyRoots.FrameIsAncestorOfDirtyRoot(aFrame);
 }
 
+bool PresShell::PendingReflowCouldAffectFrame(const nsIFrame* aFrame) const {
+  MOZ_ASSERT(aFrame);
+  MOZ_ASSERT(aFrame->PresShell() == this);
+
+  // Pending restyles (including lazy frame construction) can dirty arbitrary
+  // frames, and an interrupted reflow will dirty more frames when it resumes.
+  if (mNeedStyleFlush || mNeedThrottledAnimationFlush ||
+      mFramesToDirty.Count() != 0 ||
+      mPresContext->HasPendingMediaQueryUpdates()) {
+    return true;
+  }
+
+  // A delayed resize reflows the whole viewport.
+  if (!mViewManager || mViewManager->HasDelayedResize()) {
+    return true;
+  }
+
+  // A reflow starting at a dirty root can only change geometry within that
+  // root's subtree, and FrameNeedsReflow marks every ancestor of a dirty
+  // frame up to its dirty root, so aFrame is unaffected unless a frame on
+  // its ancestor chain is dirty or has dirty children. The exception is an
+  // out-of-flow frame, whose position can also depend on its placeholder's
+  // subtree; be conservative about those.
+  for (const nsIFrame* f = aFrame; f; f = f->GetParent()) {
+    if (f->GetStateBits() & (NS_FRAME_IS_DIRTY | NS_FRAME_HAS_DIRTY_CHILDREN |
+                             NS_FRAME_OUT_OF_FLOW)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void PresShell::ReconstructFrames() {
   MOZ_ASSERT(!mFrameConstructor->GetRootFrame() || mDidInitialize,
              "Must not have root frame before initial reflow");
@@ -9532,6 +9607,21 @@ PresShell::Observe(nsISupports* aSubject, const char* aTopic,
     if (!AssumeAllFramesVisible() && mPresContext->IsRootContentDocument()) {
       DoUpdateApproximateFrameVisibility(/* aRemoveOnly = */ true);
     }
+    // An inactive presentation isn't painted until it becomes active again,
+    // so its retained display list only holds memory. Discard it; the next
+    // paint after reactivation performs a full display list build.
+    if (!mIsActive) {
+      if (nsIFrame* rootFrame = mFrameConstructor->GetRootFrame()) {
+        if (RetainedDisplayListBuilder* retainedBuilder =
+                rootFrame->GetProperty(RetainedDisplayListBuilder::Cached())) {
+          // Clear the modified frames lists and frame properties.
+          retainedBuilder->ClearFramesWithProps();
+
+          // Clear the retained display list.
+          retainedBuilder->List()->DeleteAll(retainedBuilder->Builder());
+        }
+      }
+    }
     return NS_OK;
   }
 
@@ -10514,12 +10604,34 @@ static void SetPluginIsActive(nsISupports* aSupports, void* aClosure) {
 nsresult PresShell::SetIsActive(bool aIsActive) {
   MOZ_ASSERT(mDocument, "should only be called with a document");
 
-#if defined(MOZ_WIDGET_ANDROID)
   const bool changed = mIsActive != aIsActive;
-#endif
 
   mIsActive = aIsActive;
 
+  // Background documents hold fully shaped textruns for every text frame,
+  // which adds up to a substantial amount of memory across a session. Once
+  // we have been inactive for a while, discard them; they are rebuilt
+  // lazily if the document is shown or flushed again.
+  if (changed && !mIsActive && !mDiscardTextRunsTimer) {
+    // A non-positive delay disables discarding.
+    int32_t delay =
+        Preferences::GetInt("layout.textruns.background-discard-delay-ms",
+                            DISCARD_TEXT_RUNS_DELAY);
+    if (delay > 0) {
+      mDiscardTextRunsTimer = NS_NewTimer();
+      if (mDiscardTextRunsTimer) {
+        mDiscardTextRunsTimer->SetTarget(
+            mDocument->EventTargetFor(TaskCategory::Other));
+        mDiscardTextRunsTimer->InitWithNamedFuncCallback(
+            sDiscardTextRunsCallback, this, delay, nsITimer::TYPE_ONE_SHOT,
+            "PresShell::sDiscardTextRunsCallback");
+      }
+    }
+  } else if (changed && mIsActive && mDiscardTextRunsTimer) {
+    mDiscardTextRunsTimer->Cancel();
+    mDiscardTextRunsTimer = nullptr;
+  }
+
   nsPresContext* presContext = GetPresContext();
   if (presContext &&
       presContext->RefreshDriver()->GetPresContext() == presContext) {
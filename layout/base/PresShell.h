@@ -487,6 +487,17 @@ class PresShell final : public nsStubDocumentObserver,
 
   bool FrameIsAncestorOfDirtyRoot(nsIFrame* aFrame) const;
 
+  /**
+   * Returns whether flushing pending layout could change the geometry of
+   * aFrame, so that a caller which only needs up-to-date geometry for that
+   * one frame can skip a synchronous reflow when the pending dirty frames
+   * are disjoint from it. Pending restyles, interrupted reflows and delayed
+   * viewport resizes conservatively return true; otherwise a reflow starting
+   * at a dirty root can only move frames inside that root's subtree, so this
+   * boils down to whether a dirty frame is on aFrame's ancestor chain.
+   */
+  bool PendingReflowCouldAffectFrame(const nsIFrame* aFrame) const;
+
   /**
    * Destroy the frames for aElement, and reconstruct them asynchronously if
    * needed.
@@ -725,6 +736,15 @@ class PresShell final : public nsStubDocumentObserver,
    */
   void UnsuppressPainting();
 
+  /**
+   * Unsuppress painting before the paint suppression timer fires if the
+   * document has become ready enough that waiting any longer cannot change
+   * what the first paint looks like: parsing has finished and no
+   * render-blocking stylesheets are still loading. Does nothing if painting
+   * is not currently suppressed for the initial paint.
+   */
+  void TryUnsuppressPainting();
+
   /**
    * Add an override style sheet for this presentation
    */
@@ -2766,6 +2786,13 @@ class PresShell final : public nsStubDocumentObserver,
   // The callback for the mPaintSuppressionTimer timer.
   static void sPaintSuppressionCallback(nsITimer* aTimer, void* aPresShell);
 
+  // The callback for the mDiscardTextRunsTimer timer.
+  static void sDiscardTextRunsCallback(nsITimer* aTimer, void* aPresShell);
+
+  // Discard the shaped textruns held by our frame tree if we are still
+  // inactive. They are rebuilt lazily the next time they are needed.
+  void DiscardTextRunsForBackgroundShell();
+
   //////////////////////////////////////////////////////////////////////////////
   // Approximate frame visibility tracking implementation.
   //////////////////////////////////////////////////////////////////////////////
@@ -2932,6 +2959,10 @@ class PresShell final : public nsStubDocumentObserver,
 
   nsCOMPtr<nsITimer> mDelayedPaintTimer;
 
+  // Fires once we have been inactive for a while, to discard the shaped
+  // textruns held by background documents.
+  nsCOMPtr<nsITimer> mDiscardTextRunsTimer;
+
   // Information about live content (which still stay in DOM tree).
   // Used in case we need re-dispatch event after sending pointer event,
   // when target of pointer event was deleted during executing user handlers.
@@ -50,6 +50,10 @@ MOZ_MAKE_ENUM_CLASS_BITWISE_OPERATORS(ResizeReflowOptions)
 // the pref for any reason.
 #define PAINTLOCK_EVENT_DELAY 5
 
+// How long (in ms) a pres shell stays inactive before we discard its shaped
+// textruns. Also pref-controlled; this is the fallback value.
+#define DISCARD_TEXT_RUNS_DELAY 30000
+
 enum class IntrinsicDirty {
   // XXXldb eResize should be renamed
   Resize,       // don't mark any intrinsic widths dirty
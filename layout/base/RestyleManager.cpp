@@ -15,11 +15,13 @@
 #include "mozilla/LayerAnimationInfo.h"
 #include "mozilla/layers/AnimationInfo.h"
 #include "mozilla/layout/ScrollAnchorContainer.h"
+#include "mozilla/Logging.h"
 #include "mozilla/PresShell.h"
 #include "mozilla/PresShellInlines.h"
 #include "mozilla/ServoBindings.h"
 #include "mozilla/ServoStyleSetInlines.h"
 #include "mozilla/StaticPrefs_layout.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/Unused.h"
 #include "mozilla/ViewportFrame.h"
 #include "mozilla/dom/ChildIterator.h"
@@ -34,6 +36,7 @@
 #include "nsContentUtils.h"
 #include "nsCSSFrameConstructor.h"
 #include "nsCSSRendering.h"
+#include "nsDataHashtable.h"
 #include "nsIFrame.h"
 #include "nsIFrameInlines.h"
 #include "nsImageFrame.h"
@@ -63,6 +66,12 @@ using namespace mozilla::layers;
 
 namespace mozilla {
 
+// Logs one line per restyle pass at Debug, and one line per posted restyle
+// and per element snapshot at Verbose. Enable with MOZ_LOG=Restyle:5; the
+// Verbose stream is compact and stable enough to be post-processed into a
+// restyle trace for offline analysis.
+static LazyLogModule sRestyleLog("Restyle");
+
 RestyleManager::RestyleManager(nsPresContext* aPresContext)
     : mPresContext(aPresContext),
       mRestyleGeneration(1),
@@ -1390,6 +1399,41 @@ void RestyleManager::ProcessRestyledFrames(nsStyleChangeList& aChangeList) {
     }
   }
 
+  // AppendChange only merges hints posted back-to-back for the same frame,
+  // so a frame that picks up hints at several points during the restyle
+  // traversal (e.g. for itself and again for display:contents descendants)
+  // ends up with multiple entries, and the rendering, reflow and overflow
+  // handling below runs in full for each of them. Script-driven pages that
+  // mutate thousands of elements per flush make this add up, so for long
+  // lists merge every entry into the first one posted for its frame. Frame
+  // pointers can't be reused within the list since frames are only destroyed
+  // and created once processing starts, so equal pointers really do mean the
+  // same frame. Entries without a frame are lazy frame construction markers
+  // whose adjacency the coalescing loop below depends on; leave them alone.
+  static const size_t kDuplicateMergeThreshold = 100;
+  if (aChangeList.Length() > kDuplicateMergeThreshold) {
+    nsDataHashtable<nsPtrHashKey<const nsIFrame>, size_t> firstEntryForFrame;
+    bool haveDuplicates = false;
+    for (size_t i = 0; i < aChangeList.Length(); ++i) {
+      nsStyleChangeData& data = aChangeList[i];
+      if (!data.mFrame) {
+        continue;
+      }
+      auto entry = firstEntryForFrame.LookupForAdd(data.mFrame);
+      if (entry) {
+        aChangeList[entry.Data()].mHint |= data.mHint;
+        data.mHint = nsChangeHint(0);
+        haveDuplicates = true;
+      } else {
+        entry.OrInsert([i]() { return i; });
+      }
+    }
+    if (haveDuplicates) {
+      aChangeList.RemoveElementsBy(
+          [](const nsStyleChangeData& aData) { return !aData.mHint; });
+    }
+  }
+
   bool didUpdateCursor = false;
 
   for (size_t i = 0; i < aChangeList.Length(); ++i) {
@@ -2223,6 +2267,11 @@ void RestyleManager::PostRestyleEvent(Element* aElement,
     return;  // Nothing to do.
   }
 
+  MOZ_LOG(sRestyleLog, LogLevel::Verbose,
+          ("Post: %p %s restyle=%d change=0x%08x", aElement,
+           nsAtomCString(aElement->NodeInfo()->NameAtom()).get(),
+           !!aRestyleHint, static_cast<uint32_t>(aMinChangeHint)));
+
   // Assuming the restyle hints will invalidate cached style for
   // getComputedStyle, since we don't know if any of the restyling that we do
   // would affect undisplayed elements.
@@ -2952,6 +3001,10 @@ ServoElementSnapshot& RestyleManager::SnapshotFor(Element& aElement) {
   MOZ_ASSERT(aElement.HasServoData());
   MOZ_ASSERT(!aElement.HasFlag(ELEMENT_HANDLED_SNAPSHOT));
 
+  MOZ_LOG(sRestyleLog, LogLevel::Verbose,
+          ("Snapshot: %p %s", &aElement,
+           nsAtomCString(aElement.NodeInfo()->NameAtom()).get()));
+
   ServoElementSnapshot* snapshot = mSnapshots.LookupOrAdd(&aElement, aElement);
   aElement.SetFlags(ELEMENT_HAS_SNAPSHOT);
 
@@ -3013,6 +3066,13 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
   }
 
   while (styleSet->StyleDocument(aFlags)) {
+    const bool logRestyles = MOZ_LOG_TEST(sRestyleLog, LogLevel::Debug);
+    const uint32_t snapshotCount = mSnapshots.Count();
+    TimeStamp passStart;
+    if (logRestyles) {
+      passStart = TimeStamp::Now();
+    }
+
     ClearSnapshots();
 
     // Select scroll anchors for frames that have been scrolled. Do this
@@ -3052,6 +3112,12 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
 
     doc->ClearServoRestyleRoot();
 
+    const size_t changeCount = currentChanges.Length();
+    TimeStamp changesStart;
+    if (logRestyles) {
+      changesStart = TimeStamp::Now();
+    }
+
     // Process the change hints.
     //
     // Unfortunately, the frame constructor can generate new change hints while
@@ -3082,6 +3148,15 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
       mReentrantChanges = nullptr;
     }
 
+    if (logRestyles) {
+      MOZ_LOG(sRestyleLog, LogLevel::Debug,
+              ("Pass: snapshots=%u changes=%zu styleChanged=%d "
+               "postTraversal=%.2fms applyChanges=%.2fms",
+               snapshotCount, changeCount, anyStyleChanged,
+               (changesStart - passStart).ToMilliseconds(),
+               (TimeStamp::Now() - changesStart).ToMilliseconds()));
+    }
+
     // Suppress adjustments in the after-change scroll anchors if needed, now
     // that we're done reframing everything.
     for (Element* element : anchorsToSuppress) {
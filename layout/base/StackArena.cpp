@@ -5,6 +5,9 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "StackArena.h"
+#include "mozilla/ArenaChunkPool.h"
+#include "mozilla/OperatorNewExtensions.h"
+#include "mozilla/mozalloc.h"
 #include "nsAlgorithm.h"
 #include "nsDebug.h"
 
@@ -28,6 +31,24 @@ struct StackBlock {
 
 static_assert(sizeof(StackBlock) == 4096, "StackBlock must be 4096 bytes");
 
+// Blocks are drawn from (and returned to) the process-wide chunk pool, so
+// that the block freed when one arena is torn down can service the next
+// arena instead of cycling pages through the OS.
+static StackBlock* AllocateStackBlock() {
+  void* p = ArenaChunkPool::Acquire(sizeof(StackBlock));
+  if (!p) {
+    p = moz_xmalloc(sizeof(StackBlock));
+  }
+  return new (KnownNotNull, p) StackBlock();
+}
+
+static void FreeStackBlock(StackBlock* aBlock) {
+  aBlock->~StackBlock();
+  if (!ArenaChunkPool::Recycle(aBlock, sizeof(StackBlock))) {
+    free(aBlock);
+  }
+}
+
 // We hold an array of marks. A push pushes a mark on the stack.
 // A pop pops it off.
 struct StackMark {
@@ -45,7 +66,7 @@ StackArena::StackArena() {
   mMarks = nullptr;
 
   // Allocate our stack memory.
-  mBlocks = new StackBlock();
+  mBlocks = AllocateStackBlock();
   mCurBlock = mBlocks;
 
   mStackTop = 0;
@@ -58,7 +79,7 @@ StackArena::~StackArena() {
   while (mBlocks) {
     StackBlock* toDelete = mBlocks;
     mBlocks = mBlocks->mNext;
-    delete toDelete;
+    FreeStackBlock(toDelete);
   }
 }
 
@@ -121,7 +142,7 @@ void* StackArena::Allocate(size_t aSize) {
     NS_ASSERTION(aSize <= StackBlock::MAX_USABLE_SIZE,
                  "Requested memory is greater that our block size!!");
     if (mCurBlock->mNext == nullptr) {
-      mCurBlock->mNext = new StackBlock();
+      mCurBlock->mNext = AllocateStackBlock();
     }
 
     mCurBlock = mCurBlock->mNext;
@@ -10,6 +10,7 @@
 #include "unicode/ubidi.h"
 #include "ICUUtils.h"
 #include "nsIFrame.h"  // for nsBidiLevel/nsBidiDirection declarations
+#include "nsString.h"
 
 // nsBidi implemented as a simple wrapper around the bidi reordering engine
 // from ICU.
@@ -53,9 +54,26 @@ class nsBidi {
    */
   nsresult SetPara(const char16_t* aText, int32_t aLength,
                    nsBidiLevel aParaLevel) {
+    if (aLength < 0) {
+      aLength = NS_strlen(aText);
+    }
+    // Frame reconstruction and reflow resolve the same paragraph over and
+    // over; if the text and paragraph level match the previous call, the
+    // resolved state held by the engine is still valid and the bidi
+    // algorithm doesn't need to be re-run.
+    const nsDependentSubstring text(aText, aLength);
+    if (mHavePara && aParaLevel == mParaLevel && text.Equals(mText)) {
+      return NS_OK;
+    }
+    // Keep our own copy of the text: ubidi_setPara retains a pointer into it
+    // rather than copying, and our callers' buffers are transient. The copy
+    // is also what makes it safe to reuse the resolved state above.
+    mText.Assign(text);
+    mParaLevel = aParaLevel;
     UErrorCode error = U_ZERO_ERROR;
-    ubidi_setPara(mBiDi, reinterpret_cast<const UChar*>(aText), aLength,
+    ubidi_setPara(mBiDi, reinterpret_cast<const UChar*>(mText.get()), aLength,
                   aParaLevel, nullptr, &error);
+    mHavePara = U_SUCCESS(error);
     return ICUUtils::UErrorToNsResult(error);
   }
 
@@ -200,6 +218,11 @@ class nsBidi {
   void operator=(const nsBidi&) = delete;
 
   UBiDi* mBiDi;
+  // The paragraph most recently passed to SetPara, and whether the engine
+  // currently holds a successfully resolved state for it.
+  nsString mText;
+  nsBidiLevel mParaLevel = 0;
+  bool mHavePara = false;
   // The two fields below are updated when CountRuns is called.
   const nsBidiLevel* mLevels = nullptr;
   int32_t mLength = 0;
@@ -163,6 +163,10 @@ struct MOZ_STACK_CLASS BidiParagraphData {
   nsPresContext* mPresContext;
   bool mIsVisual;
   bool mRequiresBidi;
+  // True if SetPara() proved that the current buffer resolves to a single
+  // left-to-right run without running the bidi engine; the engine state is
+  // not valid for the buffer in that case.
+  bool mIsUnidirectionalLTR;
   nsBidiLevel mParaLevel;
   nsIContent* mPrevContent;
 
@@ -297,6 +301,7 @@ struct MOZ_STACK_CLASS BidiParagraphData {
       : mPresContext(aBlockFrame->PresContext()),
         mIsVisual(mPresContext->IsVisualMode()),
         mRequiresBidi(false),
+        mIsUnidirectionalLTR(false),
         mParaLevel(nsBidiPresUtils::BidiLevelFromStyle(aBlockFrame->Style())),
         mPrevContent(nullptr)
 #ifdef DEBUG
@@ -335,6 +340,25 @@ struct MOZ_STACK_CLASS BidiParagraphData {
   }
 
   nsresult SetPara() {
+    // If the paragraph has a left-to-right base level and contains no code
+    // unit that could resolve to any other level -- no right-to-left
+    // characters, no directional controls, no surrogates, i.e. nothing at or
+    // above U+0590 -- the bidi algorithm is guaranteed to produce a single
+    // left-to-right run covering the whole buffer, and running the engine
+    // can be skipped. This is common on mostly-LTR pages where only a few
+    // paragraphs of a bidi-requiring block actually contain RTL text.
+    mIsUnidirectionalLTR = false;
+    if (mParaLevel == NSBIDI_LTR || mParaLevel == NSBIDI_DEFAULT_LTR) {
+      const char16_t* text = mBuffer.get();
+      const char16_t* end = text + BufferLength();
+      while (text < end && *text < 0x0590) {
+        ++text;
+      }
+      if (text == end) {
+        mIsUnidirectionalLTR = true;
+        return NS_OK;
+      }
+    }
     return mPresContext->GetBidiEngine().SetPara(mBuffer.get(), BufferLength(),
                                                  mParaLevel);
   }
@@ -347,21 +371,37 @@ struct MOZ_STACK_CLASS BidiParagraphData {
   nsBidiLevel GetParaLevel() {
     nsBidiLevel paraLevel = mParaLevel;
     if (paraLevel == NSBIDI_DEFAULT_LTR || paraLevel == NSBIDI_DEFAULT_RTL) {
+      if (mIsUnidirectionalLTR) {
+        // The engine was not run for this paragraph.
+        return NSBIDI_LTR;
+      }
       paraLevel = mPresContext->GetBidiEngine().GetParaLevel();
     }
     return paraLevel;
   }
 
   nsBidiDirection GetDirection() {
+    if (mIsUnidirectionalLTR) {
+      return NSBIDI_LTR;
+    }
     return mPresContext->GetBidiEngine().GetDirection();
   }
 
   nsresult CountRuns(int32_t* runCount) {
+    if (mIsUnidirectionalLTR) {
+      *runCount = 1;
+      return NS_OK;
+    }
     return mPresContext->GetBidiEngine().CountRuns(runCount);
   }
 
   void GetLogicalRun(int32_t aLogicalStart, int32_t* aLogicalLimit,
                      nsBidiLevel* aLevel) {
+    if (mIsUnidirectionalLTR) {
+      *aLogicalLimit = BufferLength();
+      *aLevel = GetParaLevel();
+      return;
+    }
     mPresContext->GetBidiEngine().GetLogicalRun(aLogicalStart, aLogicalLimit,
                                                 aLevel);
     if (mIsVisual) {
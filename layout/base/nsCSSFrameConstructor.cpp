@@ -6284,6 +6284,23 @@ static bool IsSpecialFramesetChild(nsIContent* aContent) {
 
 static void InvalidateCanvasIfNeeded(PresShell* aPresShell, nsIContent* aNode);
 
+// Applies InvalidateCanvasIfNeeded to a range of siblings. Only children of
+// the document root can propagate their background to the canvas, and all the
+// nodes in the range share a parent, so bulk insertions anywhere deeper in the
+// tree skip the per-node walk entirely.
+static void InvalidateCanvasIfNeeded(PresShell* aPresShell,
+                                     nsIContent* aStartChild,
+                                     nsIContent* aEndChild) {
+  nsIContent* parent = aStartChild->GetParent();
+  if (parent && parent->GetParent()) {
+    return;
+  }
+  for (nsIContent* child = aStartChild; child != aEndChild;
+       child = child->GetNextSibling()) {
+    InvalidateCanvasIfNeeded(aPresShell, child);
+  }
+}
+
 void nsCSSFrameConstructor::AddTextItemIfNeeded(
     nsFrameConstructorState& aState, const InsertionPoint& aInsertion,
     nsIContent* aPossibleTextContent, FrameConstructionItemList& aItems) {
@@ -6779,15 +6796,12 @@ void nsCSSFrameConstructor::ContentAppended(nsIContent* aFirstNewContent,
   ConstructFramesFromItemList(state, items, parentFrame,
                               ParentIsWrapperAnonBox(parentFrame), frameList);
 
-  for (nsIContent* child = aFirstNewContent; child;
-       child = child->GetNextSibling()) {
-    // Invalidate now instead of before the WipeContainingBlock call, just in
-    // case we do wipe; in that case we don't need to do this walk at all.
-    // XXXbz does that matter?  Would it make more sense to save some virtual
-    // GetChildAt_Deprecated calls instead and do this during construction of
-    // our FrameConstructionItemList?
-    InvalidateCanvasIfNeeded(mPresShell, child);
-  }
+  // Invalidate now instead of before the WipeContainingBlock call, just in
+  // case we do wipe; in that case we don't need to do this walk at all.
+  // XXXbz does that matter?  Would it make more sense to save some virtual
+  // GetChildAt_Deprecated calls instead and do this during construction of
+  // our FrameConstructionItemList?
+  InvalidateCanvasIfNeeded(mPresShell, aFirstNewContent, nullptr);
 
   // If the container is a table and a caption was appended, it needs to be put
   // in the table wrapper frame's additional child list.
@@ -6866,7 +6880,8 @@ void nsCSSFrameConstructor::ContentInserted(nsIContent* aChild,
 // aren't at the end of their childlist. ContentRangeInserted isn't a real
 // content notification, but rather it handles regular ContentInserted calls
 // for a single node as well as the lazy construction of frames for a range of
-// nodes when called from CreateNeededFrames. For a range of nodes to be
+// nodes when called from RestyleManager::ProcessRestyledFrames. For a range of
+// nodes to be
 // suitable to have its frames constructed all at once they must meet the same
 // conditions that ContentAppended imposes (GetRangeInsertionPoint checks
 // these), plus more. Namely when finding the insertion prevsibling we must not
@@ -7187,10 +7202,7 @@ void nsCSSFrameConstructor::ContentRangeInserted(nsIContent* aStartChild,
                               frameList);
 
   if (frameList.NotEmpty()) {
-    for (nsIContent* child = aStartChild; child != aEndChild;
-         child = child->GetNextSibling()) {
-      InvalidateCanvasIfNeeded(mPresShell, child);
-    }
+    InvalidateCanvasIfNeeded(mPresShell, aStartChild, aEndChild);
 
     if (LayoutFrameType::Table == frameType ||
         LayoutFrameType::TableWrapper == frameType) {
@@ -219,19 +219,22 @@ class nsCSSFrameConstructor final : public nsFrameManager {
    * node with that bit set. Then it posts a restyle event to ensure that a
    * flush happens to construct those frames.
    *
-   * When the flush happens the presshell calls
-   * nsCSSFrameConstructor::CreateNeededFrames. CreateNeededFrames follows any
-   * nodes with NODE_DESCENDANTS_NEED_FRAMES set down the content tree looking
-   * for nodes with NODE_NEEDS_FRAME set. It calls ContentAppended for any runs
-   * of nodes with NODE_NEEDS_FRAME set that are at the end of their childlist,
-   * and ContentRangeInserted for any other runs that aren't.
+   * When the flush happens, the style traversal reports the nodes with
+   * NODE_NEEDS_FRAME set as nsChangeHint_ReconstructFrame changes, and
+   * RestyleManager::ProcessRestyledFrames coalesces runs of adjacent siblings
+   * into a single call: ContentAppended for runs at the end of their child
+   * list, and ContentRangeInserted for runs that aren't. Each such call does
+   * one insertion point lookup and one WipeContainingBlock evaluation for the
+   * whole run, so bulk insertions that accumulate between flushes get their
+   * frames constructed in batches rather than one sibling range at a time.
    *
    * If a node is removed from the document then we don't bother unsetting any
    * of the lazy bits that might be set on it, its descendants, or any of its
    * ancestor nodes because that is a slow operation, the work might be wasted
    * if another node gets inserted in its place, and we can clear the bits
-   * quicker by processing the content tree from top down the next time we call
-   * CreateNeededFrames. (We do clear the bits when BindToTree is called on any
+   * quicker by processing the content tree from top down the next time we
+   * construct frames there. (We do clear the bits when BindToTree is called on
+   * any
    * nsIContent; so any nodes added to the document will not have any lazy bits
    * set.)
    */
@@ -8063,6 +8063,27 @@ size_t nsLayoutUtils::SizeOfTextRunsForFrames(nsIFrame* aFrame,
   return total;
 }
 
+/* static */
+void nsLayoutUtils::DiscardTextRunsForFrames(nsIFrame* aFrame) {
+  MOZ_ASSERT(aFrame, "NULL frame pointer");
+
+  if (aFrame->IsTextFrame()) {
+    static_cast<nsTextFrame*>(aFrame)->ClearTextRuns();
+    return;
+  }
+
+  AutoTArray<nsIFrame::ChildList, 4> childListArray;
+  aFrame->GetChildLists(&childListArray);
+
+  for (nsIFrame::ChildListArrayIterator childLists(childListArray);
+       !childLists.IsDone(); childLists.Next()) {
+    for (nsFrameList::Enumerator e(childLists.CurrentList()); !e.AtEnd();
+         e.Next()) {
+      DiscardTextRunsForFrames(e.get());
+    }
+  }
+}
+
 /* static */
 void nsLayoutUtils::Initialize() {
   nsComputedDOMStyle::RegisterPrefChangeCallbacks();
@@ -2327,6 +2327,14 @@ class nsLayoutUtils {
                                         mozilla::MallocSizeOf aMallocSizeOf,
                                         bool clear);
 
+  /**
+   * Walks the frame tree starting at aFrame and clears the textruns from
+   * all text frames found. The textruns are rebuilt lazily the next time
+   * they are needed, so this can be used on documents that are not being
+   * displayed to trade shaping work for memory.
+   */
+  static void DiscardTextRunsForFrames(nsIFrame* aFrame);
+
   /**
    * Returns true if |aFrame| has an animation of a property in |aPropertySet|
    * regardless of whether any property in the set is overridden by an
@@ -1174,6 +1174,8 @@ nsRefreshDriver::nsRefreshDriver(nsPresContext* aPresContext)
       mResizeSuppressed(false),
       mNotifyDOMContentFlushed(false),
       mNeedToUpdateIntersectionObservations(false),
+      mDeferredIntersectionUpdate(false),
+      mOverBudgetTickCount(0),
       mWarningThreshold(REFRESH_WAIT_WARNING) {
   MOZ_ASSERT(NS_IsMainThread());
   MOZ_ASSERT(mPresContext,
@@ -2099,7 +2101,19 @@ void nsRefreshDriver::Tick(VsyncId aId, TimeStamp aNowTime) {
   }
 #endif
 
-  UpdateIntersectionObservations();
+  // Intersection observations are asynchronous by contract and are not
+  // needed to paint this frame, so once ticks are chronically over the frame
+  // budget, deliver them every other tick to claw some of the budget back.
+  // mNeedToUpdateIntersectionObservations stays set while we defer, which
+  // guarantees another tick is scheduled to do the deferred update.
+  static const uint32_t kOverBudgetTicksBeforeDemotion = 2;
+  if (mOverBudgetTickCount >= kOverBudgetTicksBeforeDemotion &&
+      !mDeferredIntersectionUpdate) {
+    mDeferredIntersectionUpdate = true;
+  } else {
+    mDeferredIntersectionUpdate = false;
+    UpdateIntersectionObservations();
+  }
 
   /*
    * Perform notification to imgIRequests subscribed to listen
@@ -2211,6 +2225,40 @@ void nsRefreshDriver::Tick(VsyncId aId, TimeStamp aNowTime) {
 
   double totalMs = (TimeStamp::Now() - mTickStart).ToMilliseconds();
 
+  // Track how long we have been chronically over the frame budget; this
+  // feeds the demotion of non-visual per-tick work above.
+  if (totalMs > DefaultInterval()) {
+    ++mOverBudgetTickCount;
+  } else {
+    mOverBudgetTickCount = 0;
+  }
+
+#ifdef MOZ_GECKO_PROFILER
+  // Attribute the tick cost to its phases in the profile, so over-budget
+  // ticks show who consumed the frame budget.
+  if (profiler_thread_is_being_profiled() && totalMs > DefaultInterval()) {
+    nsAutoCString text;
+    text.AppendPrintf(
+        "Event: %.2fms Style: %.2fms Reflow: %.2fms Display: %.2fms "
+        "Paint: %.2fms",
+        phaseMetrics[0], phaseMetrics[1], phaseMetrics[2], phaseMetrics[3],
+        phasePaint);
+    profiler_add_text_marker(
+        "RefreshDriverTickPhases", text,
+        JS::ProfilingCategoryPair::GRAPHICS, mTickStart, TimeStamp::Now(),
+        profiler_get_inner_window_id_from_docshell(GetDocShell(mPresContext)));
+  }
+#endif
+
+  if (!mThrottled) {
+    // Tell the GC slice scheduler how much of the frame budget this tick
+    // left unused, so interslice slices can be sized to fit what is
+    // actually available between frames.
+    nsJSContext::NotifyRefreshDriverTick(
+        TimeDuration::FromMilliseconds(totalMs),
+        TimeDuration::FromMilliseconds(DefaultInterval()));
+  }
+
 #ifndef ANDROID /* bug 1142079 */
   mozilla::Telemetry::Accumulate(mozilla::Telemetry::REFRESH_DRIVER_TICK,
                                  static_cast<uint32_t>(totalMs));
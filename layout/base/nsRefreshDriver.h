@@ -563,6 +563,15 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   // all our documents.
   bool mNeedToUpdateIntersectionObservations : 1;
 
+  // True if the last tick deferred the intersection observation update
+  // because recent ticks were over the frame budget. Used to make sure we
+  // never defer two ticks in a row.
+  bool mDeferredIntersectionUpdate : 1;
+
+  // Number of consecutive ticks that have exceeded the frame budget, used to
+  // demote non-visual per-tick work once ticks are chronically over budget.
+  uint32_t mOverBudgetTickCount;
+
   // Number of seconds that the refresh driver is blocked waiting for a
   // compositor transaction to be completed before we append a note to the gfx
   // critical log. The number is doubled every time the threshold is hit.
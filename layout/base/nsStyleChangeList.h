@@ -36,6 +36,7 @@ class nsStyleChangeList : private AutoTArray<nsStyleChangeData, 10> {
   using base_type::end;
   using base_type::IsEmpty;
   using base_type::Length;
+  using base_type::RemoveElementsBy;
   using base_type::operator[];
 
   MOZ_COUNTED_DEFAULT_CTOR(nsStyleChangeList)
@@ -49,6 +49,7 @@
 #include "nsHtml5Module.h"
 #include "nsHTMLTags.h"
 #include "mozilla/dom/FallbackEncoding.h"
+#include "mozilla/dom/FetchUtil.h"
 #include "nsFocusManager.h"
 #include "nsListControlFrame.h"
 #include "mozilla/dom/HTMLInputElement.h"
@@ -267,6 +268,8 @@ nsresult nsLayoutStatics::Initialize() {
 
   PromiseDebugging::Init();
 
+  mozilla::dom::FetchUtil::InitWasmAltDataType();
+
   if (XRE_IsParentProcess() || XRE_IsContentProcess()) {
     InitializeServo();
   }
@@ -783,6 +783,15 @@ void ReflowInput::InitDynamicReflowRoot() {
 
   bool canBeDynamicReflowRoot = AreDynamicReflowRootsEnabled();
 
+  // A frame with both size and layout containment is laid out as if it were
+  // empty: its used size cannot be influenced by its descendants, and its
+  // internal layout (floats, baselines, overflow that affects layout) cannot
+  // escape to the rest of the frame tree. Such frames can serve as reflow
+  // roots no matter how they are sized, so they skip the used-size checks
+  // below, which exist only to rule out content-influenced sizing.
+  const bool isSizeAndLayoutContained =
+      mStyleDisplay->IsContainSize() && mStyleDisplay->IsContainLayout();
+
   // We can't do this if our used 'width' and 'height' might be influenced by
   // content.
   // FIXME: For display:block, we should probably optimize inline-size
@@ -790,7 +799,7 @@ void ReflowInput::InitDynamicReflowRoot() {
   // FIXME: Other flex and grid cases?
   const auto& width = mStylePosition->mWidth;
   const auto& height = mStylePosition->mHeight;
-  if (canBeDynamicReflowRoot &&
+  if (canBeDynamicReflowRoot && !isSizeAndLayoutContained &&
       (!width.IsLengthPercentage() || width.HasPercent() ||
        !height.IsLengthPercentage() || height.HasPercent() ||
        IsIntrinsicKeyword(mStylePosition->mMinWidth) ||
@@ -803,7 +812,8 @@ void ReflowInput::InitDynamicReflowRoot() {
     canBeDynamicReflowRoot = false;
   }
 
-  if (canBeDynamicReflowRoot && mFrame->IsFlexItem()) {
+  if (canBeDynamicReflowRoot && !isSizeAndLayoutContained &&
+      mFrame->IsFlexItem()) {
     // If our flex-basis is 'auto', it'll defer to 'width' (or 'height') which
     // we've already checked. Otherwise, it preempts them, so we need to
     // perform the same "could-this-value-be-influenced-by-content" checks that
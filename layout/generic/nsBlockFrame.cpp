@@ -2509,6 +2509,17 @@ void nsBlockFrame::ReflowDirtyLines(BlockReflowInput& aState) {
 
   LineIterator line = LinesBegin(), line_end = LinesEnd();
 
+  // Determine once, rather than for each line, whether a line that is flush
+  // with the line-start edge keeps its position when the container size
+  // changes. The answer only differs between the last line and the others.
+  const StyleDirection direction =
+      aState.mReflowInput.mStyleVisibility->mDirection;
+  const uint8_t unicodeBidi = StyleTextReset()->mUnicodeBidi;
+  const bool alignedLeft =
+      IsAlignedLeft(StyleText()->mTextAlign, direction, unicodeBidi, this);
+  const bool lastLineAlignedLeft = IsAlignedLeft(
+      StyleText()->TextAlignForLastLine(), direction, unicodeBidi, this);
+
   // Reflow the lines that are already ours
   for (; line != line_end; ++line, aState.AdvanceToNextLine()) {
     DumpLine(aState, line, deltaBCoord, 0);
@@ -2623,12 +2634,8 @@ void nsBlockFrame::ReflowDirtyLines(BlockReflowInput& aState) {
       line->mContainerSize = aState.ContainerSize();
 
       const bool isLastLine = line == mLines.back() && !GetNextInFlow();
-      const auto align = isLastLine ? StyleText()->TextAlignForLastLine()
-                                    : StyleText()->mTextAlign;
       if (line->mWritingMode.IsVertical() || line->mWritingMode.IsBidiRTL() ||
-          !IsAlignedLeft(align,
-                         aState.mReflowInput.mStyleVisibility->mDirection,
-                         StyleTextReset()->mUnicodeBidi, this)) {
+          !(isLastLine ? lastLineAlignedLeft : alignedLeft)) {
         line->MarkDirty();
       }
     }
@@ -869,9 +869,12 @@ void nsImageFrame::MaybeDecodeForPredictedSize() {
     return;
   }
 
-  // Determine the optimal image size to use.
+  // Determine the optimal image size to use. We checked above that we're at
+  // least approximately visible, so ask for the decode to be prioritized over
+  // decodes for images which aren't.
   uint32_t flags = imgIContainer::FLAG_HIGH_QUALITY_SCALING |
-                   imgIContainer::FLAG_ASYNC_NOTIFY;
+                   imgIContainer::FLAG_ASYNC_NOTIFY |
+                   imgIContainer::FLAG_PRIORITIZE_DECODE;
   SamplingFilter samplingFilter =
       nsLayoutUtils::GetSamplingFilterForFrame(this);
   gfxSize gfxPredictedScreenSize =
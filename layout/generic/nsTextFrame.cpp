@@ -4727,6 +4727,35 @@ void nsTextFrame::NotifyNativeAnonymousTextnodeChange(uint32_t aOldLength) {
   CharacterDataChanged(info);
 }
 
+/**
+ * Adjust the DOM offset mapping of aContent's flow in aTextRun by aSizeChange,
+ * so that a textrun that only maps unchanged text after an earlier edit in the
+ * node stays valid when the frames' content offsets move. Returns false if the
+ * textrun cannot be adjusted and must be cleared instead.
+ */
+static bool AdjustTextRunForContentShift(gfxTextRun* aTextRun,
+                                         nsIContent* aContent,
+                                         int32_t aSizeChange) {
+  if (aTextRun->GetFlags2() & nsTextFrameUtils::Flags::IsSimpleFlow) {
+    // A simple-flow textrun maps this node from its start, so it cannot lie
+    // entirely in the unchanged trailing text.
+    return false;
+  }
+  TextRunUserData* userData =
+      static_cast<TextRunUserData*>(aTextRun->GetUserData());
+  TextRunMappedFlow* flows = GetMappedFlows(aTextRun);
+  for (uint32_t i = 0; i < userData->mMappedFlowCount; ++i) {
+    TextRunMappedFlow& flow = flows[i];
+    if (flow.mStartFrame->GetContent() == aContent) {
+      // The frames' content offsets move by aSizeChange; compensate so that
+      // they still map to the same positions in the textrun.
+      flow.mDOMOffsetToBeforeTransformOffset -= aSizeChange;
+      return true;
+    }
+  }
+  return false;
+}
+
 nsresult nsTextFrame::CharacterDataChanged(
     const CharacterDataChangeInfo& aInfo) {
   if (mContent->HasFlag(NS_HAS_NEWLINE_PROPERTY)) {
@@ -4821,11 +4850,33 @@ nsresult nsTextFrame::CharacterDataChanged(
   if (sizeChange) {
     // Fix the offsets of the text frames that start in the trailing
     // unchanged text.
+    // A textrun that is still attached to one of these frames cannot map any
+    // of the changed text: the ClearTextRuns() calls above unhooked every run
+    // that did. Such runs cover identical text at shifted DOM offsets, so we
+    // can rescue them by adjusting their user data instead of rebuilding and
+    // reshaping them.
+    gfxTextRun* lastRescuedInflated = nullptr;
+    gfxTextRun* lastRescuedUninflated = nullptr;
     while (textFrame) {
       textFrame->mContentOffset += sizeChange;
-      // XXX we could rescue some text runs by adjusting their user data
-      // to reflect the change in DOM offsets
-      textFrame->ClearTextRuns();
+      gfxTextRun* inflated = textFrame->GetTextRun(nsTextFrame::eInflated);
+      gfxTextRun* uninflated =
+          textFrame->GetTextRun(nsTextFrame::eNotInflated);
+      if (inflated && inflated != lastRescuedInflated) {
+        if (AdjustTextRunForContentShift(inflated, mContent, sizeChange)) {
+          lastRescuedInflated = inflated;
+        } else {
+          textFrame->ClearTextRun(nullptr, nsTextFrame::eInflated);
+        }
+      }
+      if (uninflated && uninflated != inflated &&
+          uninflated != lastRescuedUninflated) {
+        if (AdjustTextRunForContentShift(uninflated, mContent, sizeChange)) {
+          lastRescuedUninflated = uninflated;
+        } else {
+          textFrame->ClearTextRun(nullptr, nsTextFrame::eNotInflated);
+        }
+      }
       textFrame = textFrame->GetNextContinuation();
     }
   }
@@ -3783,6 +3783,15 @@ UniquePtr<InactiveLayerData> PaintedLayerData::CreateInactiveLayerData(
   if (aData) {
     tempManager = aData->InactiveManager();
   }
+
+  // If the item was reused from the retained display list, then nothing in
+  // its subtree changed since the inactive layer tree was last built into
+  // the retained manager, and the invalidation diff against that tree is
+  // guaranteed to be empty. Skip cloning the old tree's properties so that
+  // AddPaintedDisplayItem can skip the comparison, the same way
+  // ComputeGeometryChangeForItem skips reused items.
+  const bool subtreeUnchanged = aItem->IsReused() && tempManager;
+
   if (!tempManager) {
     tempManager = new BasicLayerManager(BasicLayerManager::BLM_INACTIVE);
   }
@@ -3799,7 +3808,9 @@ UniquePtr<InactiveLayerData> PaintedLayerData::CreateInactiveLayerData(
     layerBuilder->DidBeginRetainedLayerTransaction(tempManager);
   }
 
-  data->mProps = LayerProperties::CloneFrom(tempManager->GetRoot());
+  if (!subtreeUnchanged) {
+    data->mProps = LayerProperties::CloneFrom(tempManager->GetRoot());
+  }
   data->mLayer = aItem->BuildLayer(aState->Builder(), tempManager,
                                    ContainerLayerParameters());
   return data;
@@ -5473,6 +5484,12 @@ void FrameLayerBuilder::AddPaintedDisplayItem(PaintedLayerData* aLayerData,
           stream);  // not a typo, fprint_stderr declared in LayersLogging.h
     }
 
+    // If mProps is null, the item's subtree is unchanged since the last
+    // paint (see CreateInactiveLayerData) and no invalidation is needed.
+    if (!aItem.mInactiveLayerData->mProps) {
+      return;
+    }
+
     nsIntPoint offset =
         GetLastPaintOffset(layer) - GetTranslationForPaintedLayer(layer);
     aItem.mInactiveLayerData->mProps->MoveBy(-offset);
@@ -429,7 +429,8 @@ bool OldItemInfo::IsChanged() {
 class MergeState {
  public:
   MergeState(RetainedDisplayListBuilder* aBuilder,
-             RetainedDisplayList& aOldList, nsDisplayItem* aOuterItem)
+             RetainedDisplayList& aOldList, nsDisplayItem* aOuterItem,
+             size_t aNewListLength)
       : mBuilder(aBuilder),
         mOldList(&aOldList),
         mOldItems(std::move(aOldList.mOldItems)),
@@ -438,7 +439,11 @@ class MergeState {
                 &aOldList.mDAG))),
         mOuterItem(aOuterItem),
         mResultIsModified(false) {
-    mMergedDAG.EnsureCapacityFor(mOldDAG);
+    // The merged list holds the reused old items plus the items from the new
+    // list, so reserve room for both up front. With thousands of retained
+    // items the incremental growth during the merge otherwise shows up in
+    // profiles.
+    mMergedDAG.EnsureCapacityFor(mOldDAG, aNewListLength);
     MOZ_RELEASE_ASSERT(mOldItems.Length() == mOldDAG.Length());
   }
 
@@ -831,7 +836,7 @@ bool RetainedDisplayListBuilder::MergeDisplayLists(
     return false;
   }
 
-  MergeState merge(this, *aOldList, aOuterItem);
+  MergeState merge(this, *aOldList, aOuterItem, aNewList->Count());
 
   Maybe<MergedListIndex> previousItemIndex;
   while (nsDisplayItem* item = aNewList->RemoveBottom()) {
@@ -1294,7 +1299,7 @@ bool RetainedDisplayListBuilder::ComputeRebuildRegion(
     nsTArray<nsIFrame*>& aOutFramesWithProps) {
   CRR_LOG("Computing rebuild regions for %zu frames:\n",
           aModifiedFrames.Length());
-  nsTArray<nsIFrame*> extraFrames;
+  AutoTArray<nsIFrame*, 16> extraFrames;
   for (nsIFrame* f : aModifiedFrames) {
     MOZ_ASSERT(f);
 
@@ -1435,7 +1440,7 @@ PartialUpdateResult RetainedDisplayListBuilder::AttemptPartialUpdate(
   // nsLayoutUtils::InvalidateForDisplayPortChange. The display port change also
   // marks the frame modified, so those regions are cleared here as well.
   AutoClearFramePropsArray modifiedFrames(64);
-  AutoClearFramePropsArray framesWithProps;
+  AutoClearFramePropsArray framesWithProps(16);
   GetModifiedAndFramesWithProps(&mBuilder, &modifiedFrames.Frames(),
                                 &framesWithProps.Frames());
 
@@ -117,9 +117,11 @@ class DirectedAcyclicGraph {
   }
 
   template <typename OtherUnits>
-  void EnsureCapacityFor(const DirectedAcyclicGraph<OtherUnits>& aOther) {
-    mNodesInfo.SetCapacity(aOther.mNodesInfo.Length());
-    mDirectPredecessorList.SetCapacity(aOther.mDirectPredecessorList.Length());
+  void EnsureCapacityFor(const DirectedAcyclicGraph<OtherUnits>& aOther,
+                         size_t aExtraNodes = 0) {
+    mNodesInfo.SetCapacity(aOther.mNodesInfo.Length() + aExtraNodes);
+    mDirectPredecessorList.SetCapacity(
+        aOther.mDirectPredecessorList.Length() + aExtraNodes);
   }
 
   void Clear() {
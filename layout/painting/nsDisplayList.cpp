@@ -1234,6 +1234,10 @@ nsDisplayListBuilder::nsDisplayListBuilder(nsIFrame* aReferenceFrame,
 
   mBuildCompositorHitTestInfo = mAsyncPanZoomEnabled && IsForPainting();
 
+  mBuildCostAccounting =
+      StaticPrefs::layout_display_list_build_cost_accounting_enabled() &&
+      IsForPainting();
+
   ShouldRebuildDisplayListDueToPrefChange();
 
   static_assert(
@@ -10858,4 +10862,8 @@ nsDisplayListBuilder::AutoBuildingDisplayList::AutoBuildingDisplayList(
   aBuilder->mVisibleRect = aVisibleRect;
   aBuilder->mDirtyRect =
       aBuilder->mInInvalidSubtree ? aVisibleRect : aDirtyRect;
+
+  if (aBuilder->mBuildCostAccounting) {
+    mBuildCostRecord.emplace(aForChild->Type());
+  }
 }
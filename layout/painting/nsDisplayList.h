@@ -38,6 +38,7 @@
 #include "mozilla/dom/RemoteBrowser.h"
 #include "mozilla/EffectCompositor.h"
 #include "mozilla/EnumeratedArray.h"
+#include "mozilla/layout/LayoutTelemetryTools.h"
 #include "mozilla/MotionPathUtils.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/TimeStamp.h"
@@ -1207,6 +1208,9 @@ class nsDisplayListBuilder {
     bool mPrevAncestorHasApzAwareEventHandler;
     bool mPrevBuildingInvisibleItems;
     bool mPrevInInvalidSubtree;
+    // Only used when the builder has display list build cost accounting
+    // enabled; see the constructor.
+    Maybe<layout_telemetry::AutoFrameBuildRecord> mBuildCostRecord;
   };
 
   /**
@@ -2037,6 +2041,7 @@ class nsDisplayListBuilder {
   bool mBuildAsyncZoomContainer;
   bool mBuildBackdropRootContainer;
   bool mContainsBackdropFilter;
+  bool mBuildCostAccounting;
 
   nsRect mHitTestArea;
   CompositorHitTestInfo mHitTestInfo;
@@ -26,7 +26,10 @@ namespace mozilla {
 namespace layout {
 
 RemotePrintJobParent::RemotePrintJobParent(nsIPrintSettings* aPrintSettings)
-    : mPrintSettings(aPrintSettings), mIsDoingPrinting(false) {
+    : mPrintSettings(aPrintSettings),
+      mIsDoingPrinting(false),
+      mPrintingPage(false),
+      mFinalizePending(false) {
   MOZ_COUNT_CTOR(RemotePrintJobParent);
 }
 
@@ -101,26 +104,63 @@ nsresult RemotePrintJobParent::PrepareNextPageFD(FileDescriptor* aFd) {
   }
   *aFd = FileDescriptor(
       FileDescriptor::PlatformHandleType(PR_FileDesc2NativeHandle(prFd)));
-  mCurrentPageStream.OpenFD(prFd);
+  mCurrentPageStream = MakeUnique<PRFileDescStream>();
+  mCurrentPageStream->OpenFD(prFd);
   return NS_OK;
 }
 
 mozilla::ipc::IPCResult RemotePrintJobParent::RecvProcessPage() {
-  if (!mCurrentPageStream.IsOpen()) {
+  if (!mCurrentPageStream || !mCurrentPageStream->IsOpen()) {
     Unused << SendAbortPrint(NS_ERROR_FAILURE);
     return IPC_OK();
   }
-  mCurrentPageStream.Seek(0, PR_SEEK_SET);
-  nsresult rv = PrintPage(mCurrentPageStream);
-  mCurrentPageStream.Close();
+  mPendingPages.AppendElement(std::move(mCurrentPageStream));
 
-  if (mPrintDeviceContext->IsSyncPagePrinting()) {
-    PageDone(rv);
+  // Hand the child a fresh file descriptor straight away, so that it can lay
+  // out and record the next page while we print this one. The recordings are
+  // queued and printed in page order, so the child painting ahead of the
+  // print device is fine.
+  FileDescriptor fd;
+  nsresult rv = PrepareNextPageFD(&fd);
+  if (NS_FAILED(rv)) {
+    Unused << SendAbortPrint(rv);
+    return IPC_OK();
   }
+  Unused << SendPageProcessed(fd);
+
+  MaybeProcessNextPage();
 
   return IPC_OK();
 }
 
+void RemotePrintJobParent::MaybeProcessNextPage() {
+  while (!mPrintingPage && !mPendingPages.IsEmpty()) {
+    UniquePtr<PRFileDescStream> page = std::move(mPendingPages[0]);
+    mPendingPages.RemoveElementAt(0);
+
+    mPrintingPage = true;
+    page->Seek(0, PR_SEEK_SET);
+    nsresult rv = PrintPage(*page);
+    page->Close();
+
+    if (NS_FAILED(rv)) {
+      mPrintingPage = false;
+      Unused << SendAbortPrint(rv);
+      return;
+    }
+
+    if (mPrintDeviceContext->IsSyncPagePrinting()) {
+      mPrintingPage = false;
+    }
+    // Otherwise PageDone() will clear mPrintingPage and continue with the
+    // queue once the device has finished with this page.
+  }
+
+  if (!mPrintingPage && mPendingPages.IsEmpty() && mFinalizePending) {
+    FinalizePrint();
+  }
+}
+
 nsresult RemotePrintJobParent::PrintPage(PRFileDescStream& aRecording) {
   MOZ_ASSERT(mPrintDeviceContext);
 
@@ -143,20 +183,31 @@ nsresult RemotePrintJobParent::PrintPage(PRFileDescStream& aRecording) {
 void RemotePrintJobParent::PageDone(nsresult aResult) {
   MOZ_ASSERT(mIsDoingPrinting);
 
+  mPrintingPage = false;
+
   if (NS_FAILED(aResult)) {
     Unused << SendAbortPrint(aResult);
-  } else {
-    FileDescriptor fd;
-    aResult = PrepareNextPageFD(&fd);
-    if (NS_FAILED(aResult)) {
-      Unused << SendAbortPrint(aResult);
-    }
-
-    Unused << SendPageProcessed(fd);
+    return;
   }
+
+  MaybeProcessNextPage();
 }
 
 mozilla::ipc::IPCResult RemotePrintJobParent::RecvFinalizePrint() {
+  if (mPrintingPage || !mPendingPages.IsEmpty()) {
+    // The child has finished the document, but pages it recorded earlier are
+    // still being printed. End the document once the queue has drained.
+    mFinalizePending = true;
+    return IPC_OK();
+  }
+
+  FinalizePrint();
+  return IPC_OK();
+}
+
+void RemotePrintJobParent::FinalizePrint() {
+  mFinalizePending = false;
+
   // EndDocument is sometimes called in the child even when BeginDocument has
   // not been called. See bug 1223332.
   if (mPrintDeviceContext) {
@@ -165,16 +216,16 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvFinalizePrint() {
     // Too late to abort the child just log.
     NS_WARNING_ASSERTION(NS_SUCCEEDED(rv), "EndDocument failed");
 
-    // Since RecvFinalizePrint is called after all page printed, there should
-    // be no more page-done callbacks after that, in theory. Unregistering
-    // page-done callback is not must have, but we still do this for safety.
+    // Since FinalizePrint is called after all pages have been printed, there
+    // should be no more page-done callbacks after that, in theory.
+    // Unregistering page-done callback is not must have, but we still do this
+    // for safety.
     mPrintDeviceContext->UnregisterPageDoneCallback();
   }
 
   mIsDoingPrinting = false;
 
   Unused << Send__delete__(this);
-  return IPC_OK();
 }
 
 mozilla::ipc::IPCResult RemotePrintJobParent::RecvAbortPrint(
@@ -184,6 +235,9 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvAbortPrint(
     mPrintDeviceContext->UnregisterPageDoneCallback();
   }
 
+  // Drop any pages that were recorded but not yet printed.
+  mPendingPages.Clear();
+  mFinalizePending = false;
   mIsDoingPrinting = false;
 
   Unused << Send__delete__(this);
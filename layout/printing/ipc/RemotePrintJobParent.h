@@ -12,6 +12,7 @@
 
 #include "nsCOMArray.h"
 #include "nsCOMPtr.h"
+#include "nsTArray.h"
 #include "mozilla/RefPtr.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/gfx/RecordedEvent.h"
@@ -76,17 +77,42 @@ class RemotePrintJobParent final : public PRemotePrintJobParent {
   nsresult PrintPage(PRFileDescStream& aRecording);
 
   /**
-   * Called to notify our corresponding RemotePrintJobChild once we've
-   * finished printing a page.
+   * Called by the print device once it has finished with the page that is
+   * currently being printed.
    */
   void PageDone(nsresult aResult);
 
+  /**
+   * Print queued page recordings, in order, until the queue is empty or the
+   * print device is busy with a page. Ends the document if a finalize is
+   * pending and everything has been printed.
+   */
+  void MaybeProcessNextPage();
+
+  /**
+   * End the document and tear down the actor. Must only be called once all
+   * queued pages have been printed.
+   */
+  void FinalizePrint();
+
   nsCOMPtr<nsIPrintSettings> mPrintSettings;
   RefPtr<nsDeviceContext> mPrintDeviceContext;
   UniquePtr<PrintTranslator> mPrintTranslator;
   nsCOMArray<nsIWebProgressListener> mPrintProgressListeners;
-  PRFileDescStream mCurrentPageStream;
+  // The recording that the child is currently writing to.
+  UniquePtr<PRFileDescStream> mCurrentPageStream;
+  // Completed page recordings that have not been printed yet, in page order.
+  // The child is handed a new file descriptor as soon as it has finished
+  // recording a page, so it can record the next page while we print, and the
+  // recordings can queue up here if it gets ahead of the print device.
+  nsTArray<UniquePtr<PRFileDescStream>> mPendingPages;
   bool mIsDoingPrinting;
+  // True while the print device is working on a page, i.e. between BeginPage
+  // and the page-done notification.
+  bool mPrintingPage;
+  // True if the child has finished the document but queued pages were still
+  // being printed when it told us so.
+  bool mFinalizePending;
 };
 
 }  // namespace layout
@@ -13,9 +13,11 @@
 #include "mozilla/dom/SRILogHelper.h"
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/AutoRestore.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/LoadInfo.h"
 #include "mozilla/Logging.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/SystemGroup.h"
 #include "mozilla/ResultExtensions.h"
 #include "mozilla/URLPreloader.h"
@@ -139,18 +141,21 @@ class SheetLoadDataHashKey : public nsURIHashKey {
         mPrincipal(aKey->mPrincipal),
         mReferrerInfo(aKey->mReferrerInfo),
         mCORSMode(aKey->mCORSMode),
-        mParsingMode(aKey->mParsingMode) {
+        mParsingMode(aKey->mParsingMode),
+        mCompatMode(aKey->mCompatMode) {
     MOZ_COUNT_CTOR(SheetLoadDataHashKey);
   }
 
   SheetLoadDataHashKey(nsIURI* aURI, nsIPrincipal* aPrincipal,
                        nsIReferrerInfo* aReferrerInfo, CORSMode aCORSMode,
-                       css::SheetParsingMode aParsingMode)
+                       css::SheetParsingMode aParsingMode,
+                       nsCompatibility aCompatMode)
       : nsURIHashKey(aURI),
         mPrincipal(aPrincipal),
         mReferrerInfo(aReferrerInfo),
         mCORSMode(aCORSMode),
-        mParsingMode(aParsingMode) {
+        mParsingMode(aParsingMode),
+        mCompatMode(aCompatMode) {
     MOZ_COUNT_CTOR(SheetLoadDataHashKey);
   }
 
@@ -159,7 +164,8 @@ class SheetLoadDataHashKey : public nsURIHashKey {
         mPrincipal(std::move(toMove.mPrincipal)),
         mReferrerInfo(std::move(toMove.mReferrerInfo)),
         mCORSMode(std::move(toMove.mCORSMode)),
-        mParsingMode(std::move(toMove.mParsingMode)) {
+        mParsingMode(std::move(toMove.mParsingMode)),
+        mCompatMode(std::move(toMove.mCompatMode)) {
     MOZ_COUNT_CTOR(SheetLoadDataHashKey);
   }
 
@@ -191,6 +197,12 @@ class SheetLoadDataHashKey : public nsURIHashKey {
       return false;
     }
 
+    if (mCompatMode != aKey->mCompatMode) {
+      // Quirks-mode-dependent parsing means the same bytes can produce a
+      // different sheet; we don't match.
+      return false;
+    }
+
     bool eq;
     if (NS_FAILED(mReferrerInfo->Equals(aKey->mReferrerInfo, &eq)) || !eq) {
       return false;
@@ -220,6 +232,7 @@ class SheetLoadDataHashKey : public nsURIHashKey {
   nsCOMPtr<nsIReferrerInfo> mReferrerInfo;
   CORSMode mCORSMode;
   css::SheetParsingMode mParsingMode;
+  nsCompatibility mCompatMode;
 };
 
 SheetLoadDataHashKey::SheetLoadDataHashKey(css::SheetLoadData& aLoadData)
@@ -227,7 +240,8 @@ SheetLoadDataHashKey::SheetLoadDataHashKey(css::SheetLoadData& aLoadData)
       mPrincipal(aLoadData.mLoaderPrincipal),
       mReferrerInfo(aLoadData.ReferrerInfo()),
       mCORSMode(aLoadData.mSheet->GetCORSMode()),
-      mParsingMode(aLoadData.mSheet->ParsingMode()) {
+      mParsingMode(aLoadData.mSheet->ParsingMode()),
+      mCompatMode(aLoadData.mLoader->GetCompatibilityMode()) {
   MOZ_COUNT_CTOR(SheetLoadDataHashKey);
 }
 }  // namespace mozilla
@@ -467,12 +481,31 @@ struct Loader::Sheets {
   RefPtr<StyleSheet> LookupInline(const nsAString&);
 
   // A cache hit or miss. It is a miss if the `StyleSheet` is null.
+  // aHasIntegrity is whether the load specifies an integrity attribute; such
+  // loads must not be served from the process-wide shared cache, see Lookup.
   using CacheResult = Tuple<RefPtr<StyleSheet>, SheetState>;
-  CacheResult Lookup(SheetLoadDataHashKey&, bool aSyncLoad);
+  CacheResult Lookup(SheetLoadDataHashKey&, bool aSyncLoad,
+                     bool aHasIntegrity);
 
   size_t SizeOfIncludingThis(MallocSizeOf) const;
 };
 
+// Complete sheets, shared across all the documents of this process. Parsing
+// a sheet is expensive enough that re-parsing the same sheet once per
+// document that references it (say, one same-site iframe per widget in a
+// page) shows up in profiles, and the per-document cache above can't help
+// with that. We only cache unowned clones here, so the shared cache keeps
+// alive the shared inner but no document. Hits get cloned just like hits on
+// the per-document cache do, and a clone that is later touched by CSSOM
+// copies its inner on write without affecting the cached sheet.
+static StaticAutoPtr<nsRefPtrHashtable<SheetLoadDataHashKey, StyleSheet>>
+    gSharedCompleteSheets;
+
+// Rough cap so that a long-running session doesn't accumulate inners for
+// sheets that no document references anymore. Dropping an entry only costs a
+// re-parse on the next miss.
+static const uint32_t kMaxSharedCompleteSheets = 500;
+
 RefPtr<StyleSheet> Loader::Sheets::LookupInline(const nsAString& aBuffer) {
   auto result = mInlineSheets.Lookup(aBuffer);
   if (!result) {
@@ -509,8 +542,8 @@ static void AssertIncompleteSheetMatches(const SheetLoadData& aData,
              "CSSOM shouldn't allow access to incomplete sheets");
 }
 
-auto Loader::Sheets::Lookup(SheetLoadDataHashKey& aKey, bool aSyncLoad)
-    -> CacheResult {
+auto Loader::Sheets::Lookup(SheetLoadDataHashKey& aKey, bool aSyncLoad,
+                            bool aHasIntegrity) -> CacheResult {
   auto CloneSheet = [](StyleSheet& aSheet) -> RefPtr<StyleSheet> {
     return aSheet.Clone(nullptr, nullptr, nullptr, nullptr);
   };
@@ -580,6 +613,22 @@ auto Loader::Sheets::Lookup(SheetLoadDataHashKey& aKey, bool aSyncLoad)
     lookup.Remove();
   }
 
+  // Then complete sheets cached by other documents. Loads that specify an
+  // integrity attribute never use the shared cache: its entries carry no SRI
+  // metadata, so a hit cached by a document without (or with a different)
+  // integrity attribute would skip the verification this load asked for.
+  if (gSharedCompleteSheets && !aHasIntegrity) {
+    if (StyleSheet* sheet = gSharedCompleteSheets->GetWeak(&aKey)) {
+      LOG(("  From shared cache: %p", sheet));
+      AssertComplete(*sheet);
+      MOZ_ASSERT(sheet->ParsingMode() == aKey.ParsingMode());
+      // The cached sheet is unowned and never handed out directly, so CSSOM
+      // can't have modified it.
+      MOZ_ASSERT(!sheet->HasModifiedRules());
+      return MakeTuple(CloneSheet(*sheet), SheetState::Complete);
+    }
+  }
+
   if (aSyncLoad) {
     return {};
   }
@@ -1123,8 +1172,8 @@ Tuple<RefPtr<StyleSheet>, Loader::SheetState> Loader::CreateSheet(
   }
 
   SheetLoadDataHashKey key(aURI, aLoaderPrincipal, aLoadingReferrerInfo,
-                           aCORSMode, aParsingMode);
-  auto cacheResult = mSheets->Lookup(key, aSyncLoad);
+                           aCORSMode, aParsingMode, mCompatMode);
+  auto cacheResult = mSheets->Lookup(key, aSyncLoad, !aIntegrity.IsEmpty());
   if (Get<0>(cacheResult)) {
     LOG(("  Hit cache with state: %s",
          gStateStrings[size_t(Get<1>(cacheResult))]));
@@ -1856,6 +1905,26 @@ void Loader::DoSheetComplete(SheetLoadData& aLoadData,
       NS_ASSERTION(sheet->IsComplete(),
                    "Should only be caching complete sheets");
       mSheets->mCompleteSheets.Put(&key, RefPtr{sheet});
+      if (!gSharedCompleteSheets) {
+        gSharedCompleteSheets =
+            new nsRefPtrHashtable<SheetLoadDataHashKey, StyleSheet>();
+        ClearOnShutdown(&gSharedCompleteSheets);
+      }
+      // Keep loads that carried an integrity attribute out of the shared
+      // cache, so that every entry in it is integrity-free (the lookup side
+      // relies on that to bypass it for loads that specify one).
+      SRIMetadata sriMetadata;
+      sheet->GetIntegrity(sriMetadata);
+      if (sriMetadata.IsEmpty() && !gSharedCompleteSheets->GetWeak(&key)) {
+        if (gSharedCompleteSheets->Count() >= kMaxSharedCompleteSheets) {
+          gSharedCompleteSheets->Clear();
+        }
+        // Cache an unowned clone so that the shared cache doesn't keep this
+        // document alive.
+        RefPtr<StyleSheet> unowned =
+            sheet->Clone(nullptr, nullptr, nullptr, nullptr);
+        gSharedCompleteSheets->Put(&key, std::move(unowned));
+      }
 #ifdef MOZ_XUL
     }
 #endif
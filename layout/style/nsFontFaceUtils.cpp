@@ -12,6 +12,7 @@
 #include "nsFontMetrics.h"
 #include "nsIFrame.h"
 #include "nsLayoutUtils.h"
+#include "nsDataHashtable.h"
 #include "nsPlaceholderFrame.h"
 #include "nsTArray.h"
 #include "SVGTextFrame.h"
@@ -30,43 +31,57 @@ enum class FontUsageKind {
   FrameAndFontMetrics,
 };
 
+// Whether a given ComputedStyle uses the font, cached for the duration of a
+// single MarkDirtyForFontChange walk. Thanks to the style sharing cache,
+// many frames share a ComputedStyle, and answering the question requires
+// resolving font metrics, which is comparatively expensive.
+typedef nsDataHashtable<nsPtrHashKey<const ComputedStyle>, FontUsageKind>
+    FontUsageCache;
+
 static FontUsageKind StyleFontUsage(ComputedStyle* aComputedStyle,
                                     nsPresContext* aPresContext,
                                     const gfxUserFontSet* aUserFontSet,
                                     const gfxUserFontEntry* aFont,
-                                    const nsAString& aFamilyName) {
+                                    const nsAString& aFamilyName,
+                                    FontUsageCache& aCache) {
   MOZ_ASSERT(NS_ConvertUTF8toUTF16(aFont->FamilyName()) == aFamilyName);
 
-  // first, check if the family name is in the fontlist
-  if (!aComputedStyle->StyleFont()->mFont.fontlist.Contains(aFamilyName)) {
-    return FontUsageKind::None;
-  }
-
-  // family name is in the fontlist, check to see if the font group
-  // associated with the frame includes the specific userfont
-  RefPtr<nsFontMetrics> fm = nsLayoutUtils::GetFontMetricsForComputedStyle(
-      aComputedStyle, aPresContext, 1.0f);
-
-  if (!fm->GetThebesFontGroup()->ContainsUserFont(aFont)) {
-    return FontUsageKind::None;
+  if (FontUsageKind* cached = aCache.GetValue(aComputedStyle)) {
+    return *cached;
   }
 
-  if (aComputedStyle->DependsOnFontMetrics()) {
-    MOZ_ASSERT(aPresContext->UsesExChUnits());
-    return FontUsageKind::FrameAndFontMetrics;
+  FontUsageKind kind = FontUsageKind::None;
+
+  // first, check if the family name is in the fontlist; if so, check to see
+  // if the font group associated with the frame includes the specific
+  // userfont
+  if (aComputedStyle->StyleFont()->mFont.fontlist.Contains(aFamilyName)) {
+    RefPtr<nsFontMetrics> fm = nsLayoutUtils::GetFontMetricsForComputedStyle(
+        aComputedStyle, aPresContext, 1.0f);
+
+    if (fm->GetThebesFontGroup()->ContainsUserFont(aFont)) {
+      if (aComputedStyle->DependsOnFontMetrics()) {
+        MOZ_ASSERT(aPresContext->UsesExChUnits());
+        kind = FontUsageKind::FrameAndFontMetrics;
+      } else {
+        kind = FontUsageKind::Frame;
+      }
+    }
   }
 
-  return FontUsageKind::Frame;
+  aCache.Put(aComputedStyle, kind);
+  return kind;
 }
 
 static FontUsageKind FrameFontUsage(nsIFrame* aFrame,
                                     nsPresContext* aPresContext,
                                     const gfxUserFontEntry* aFont,
-                                    const nsAString& aFamilyName) {
+                                    const nsAString& aFamilyName,
+                                    FontUsageCache& aCache) {
   // check the style of the frame
   gfxUserFontSet* ufs = aPresContext->GetUserFontSet();
-  FontUsageKind kind =
-      StyleFontUsage(aFrame->Style(), aPresContext, ufs, aFont, aFamilyName);
+  FontUsageKind kind = StyleFontUsage(aFrame->Style(), aPresContext, ufs,
+                                      aFont, aFamilyName, aCache);
   if (kind == FontUsageKind::FrameAndFontMetrics) {
     return kind;
   }
@@ -77,7 +92,7 @@ static FontUsageKind FrameFontUsage(nsIFrame* aFrame,
        (extraContext = aFrame->GetAdditionalComputedStyle(contextIndex));
        ++contextIndex) {
     kind = std::max(kind, StyleFontUsage(extraContext, aPresContext, ufs, aFont,
-                                         aFamilyName));
+                                         aFamilyName, aCache));
     if (kind == FontUsageKind::FrameAndFontMetrics) {
       break;
     }
@@ -140,6 +155,10 @@ void nsFontFaceUtils::MarkDirtyForFontChange(nsIFrame* aSubtreeRoot,
   // here rather than on each call.
   NS_ConvertUTF8toUTF16 familyName(aFont->FamilyName());
 
+  // Each ComputedStyle only needs to be checked against the font once,
+  // however many frames share it.
+  FontUsageCache usageCache;
+
   // check descendants, iterating over subtrees that may include
   // additional subtrees associated with placeholders
   do {
@@ -156,7 +175,7 @@ void nsFontFaceUtils::MarkDirtyForFontChange(nsIFrame* aSubtreeRoot,
 
       // if this frame uses the font, mark its descendants dirty
       // and skip checking its children
-      FontUsageKind kind = FrameFontUsage(f, pc, aFont, familyName);
+      FontUsageKind kind = FrameFontUsage(f, pc, aFont, familyName, usageCache);
       if (kind != FontUsageKind::None) {
         if (alreadyScheduled == ReflowAlreadyScheduled::No) {
           ScheduleReflow(presShell, f);
@@ -52,7 +52,10 @@ BCCellData::~BCCellData() { MOZ_COUNT_DTOR(BCCellData); }
 // nsTableCellMap
 
 nsTableCellMap::nsTableCellMap(nsTableFrame& aTableFrame, bool aBorderCollapse)
-    : mTableFrame(aTableFrame), mFirstMap(nullptr), mBCInfo(nullptr) {
+    : mTableFrame(aTableFrame),
+      mFirstMap(nullptr),
+      mBCInfo(nullptr),
+      mMayHaveRowSpans(false) {
   MOZ_COUNT_CTOR(nsTableCellMap);
 
   nsTableFrame::RowGroupArray orderedRowGroups;
@@ -1276,6 +1279,9 @@ CellData* nsCellMap::AppendCell(nsTableCellMap& aMap,
   int32_t rowSpan =
       (aCellFrame) ? GetRowSpanForNewCell(aCellFrame, aRowIndex, zeroRowSpan)
                    : 1;
+  if (rowSpan > 1 || zeroRowSpan) {
+    aMap.mMayHaveRowSpans = true;
+  }
   // add new rows if necessary
   int32_t endRowIndex = aRowIndex + rowSpan - 1;
   if (endRowIndex >= origNumMapRows) {
@@ -1612,6 +1618,9 @@ void nsCellMap::ExpandWithCells(nsTableCellMap& aMap,
                                 bool aRowSpanIsZero, int32_t aRgFirstRowIndex,
                                 TableArea& aDamageArea) {
   NS_ASSERTION(!!aMap.mBCInfo == mIsBC, "BC state mismatch");
+  if (aRowSpan > 1 || aRowSpanIsZero) {
+    aMap.mMayHaveRowSpans = true;
+  }
   int32_t endRowIndex = aRowIndex + aRowSpan - 1;
   int32_t startColIndex = aColIndex;
   int32_t endColIndex = aColIndex;
@@ -149,6 +149,14 @@ class nsTableCellMap {
 
   bool RowIsSpannedInto(int32_t aRowIndex, int32_t aNumEffCols) const;
   bool RowHasSpanningCells(int32_t aRowIndex, int32_t aNumEffCols) const;
+
+  /**
+   * Whether a cell with a row span has ever been added to this cell map.
+   * Conservative: the bit stays set if such cells are later removed, so a
+   * false return can be used to skip per-row span checks, but a true return
+   * proves nothing.
+   */
+  bool MayHaveRowSpans() const { return mMayHaveRowSpans; }
   void RebuildConsideringCells(nsCellMap* aCellMap,
                                nsTArray<nsTableCellFrame*>* aCellFrames,
                                int32_t aRowIndex, int32_t aColIndex,
@@ -208,6 +216,8 @@ class nsTableCellMap {
   nsCellMap* mFirstMap;
   // border collapsing info
   BCInfo* mBCInfo;
+  // see MayHaveRowSpans()
+  bool mMayHaveRowSpans;
 };
 
 /** nsCellMap is a support class for nsTablePart.
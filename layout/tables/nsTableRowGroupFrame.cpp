@@ -573,6 +573,12 @@ void nsTableRowGroupFrame::CalculateRowBSizes(nsPresContext* aPresContext,
   }
 
   bool hasRowSpanningCell = false;
+  // If no cell with a row span was ever added to the cell map we can skip the
+  // per-row spanned-into checks below entirely; they scan a row of the cell
+  // map each and add up for the very tall, span-free tables that data-heavy
+  // pages tend to produce.
+  nsTableCellMap* cellMap = tableFrame->GetCellMap();
+  const bool mayHaveRowSpans = cellMap && cellMap->MayHaveRowSpans();
   nscoord bSizeOfRows = 0;
   nscoord bSizeOfUnStyledRows = 0;
   // Get the bsize of each row without considering rowspans. This will be the
@@ -617,7 +623,7 @@ void nsTableRowGroupFrame::CalculateRowBSizes(nsPresContext* aPresContext,
       }
     }
     // See if a cell spans into the row. If so we'll have to do the next step
-    if (!hasRowSpanningCell) {
+    if (!hasRowSpanningCell && mayHaveRowSpans) {
       if (tableFrame->RowIsSpannedInto(rowIndex + startRowIndex, numEffCols)) {
         hasRowSpanningCell = true;
       }
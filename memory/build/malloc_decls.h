@@ -95,6 +95,26 @@ MALLOC_DECL(jemalloc_purge_freed_pages, void)
 // provides functionality similar to mallctl("arenas.purge") in jemalloc 3.
 MALLOC_DECL(jemalloc_free_dirty_pages, void)
 
+// Purge unused dirty pages from arenas holding more than half of their dirty
+// page high-water mark, stopping once the given number of pages has been
+// purged (the budget may be overshot by up to one contiguous run of pages).
+// Returns the number of pages purged. This is meant to be called on a
+// background cadence when deferred purging is enabled; see
+// jemalloc_set_deferred_purge.
+MALLOC_DECL(jemalloc_purge_dirty_pages, size_t, size_t)
+
+// Controls whether exceeding an arena's dirty page high-water mark purges
+// immediately on the allocating thread (the default) or is left for a
+// caller-driven jemalloc_purge_dirty_pages() cadence. With deferred purging
+// enabled, an arena still purges inline if its dirty pages exceed twice the
+// high-water mark, as a backstop against a stalled cadence.
+MALLOC_DECL(jemalloc_set_deferred_purge, void, bool)
+
+// Sets the dirty page high-water mark used for the main and thread-local
+// arenas, and the default from which future arenas derive theirs. Arenas
+// created with an explicit mMaxDirty keep their configured value.
+MALLOC_DECL(jemalloc_set_max_dirty_pages, void, size_t)
+
 // Opt in or out of a thread local arena (bool argument is whether to opt-in
 // (true) or out (false)).
 MALLOC_DECL(jemalloc_thread_local_arena, void, bool)
@@ -114,6 +134,12 @@ MALLOC_DECL(moz_create_arena_with_params, arena_id_t, arena_params_t*)
 // Passing an invalid id (inexistent or already disposed) to this function
 // will crash. The arena must be empty prior to calling this function.
 MALLOC_DECL(moz_dispose_arena, void, arena_id_t)
+
+// Fill the given jemalloc_arena_stats_t with statistics about the given
+// arena, so that consumers that segregate their allocations in a separate
+// arena can report its footprint and fragmentation. Passing an invalid id
+// to this function will crash.
+MALLOC_DECL(moz_arena_stats, void, arena_id_t, jemalloc_arena_stats_t*)
 #  endif
 
 #  if MALLOC_FUNCS & MALLOC_FUNCS_ARENA_ALLOC
@@ -114,6 +114,7 @@
 #  include <io.h>
 #  include <windows.h>
 #else
+#  include <pthread.h>
 #  include <sys/mman.h>
 #  include <unistd.h>
 #endif
@@ -166,17 +167,36 @@ using namespace mozilla;
 // jemalloc_purge_freed_pages(), which will force the OS to release those
 // MADV_FREE'd pages, making the process's RSS reflect its true memory usage.
 //
-// The jemalloc_purge_freed_pages definition in memory/build/mozmemory.h needs
-// to be adjusted if MALLOC_DOUBLE_PURGE is ever enabled on Linux.
+// Linux kernels since 4.5 support MADV_FREE with the same lazy semantics as
+// Mac, which avoids the TLB shootdowns MADV_DONTNEED triggers on every purge.
+// Whether the running kernel accepts MADV_FREE is detected on first use;
+// older kernels reject it with EINVAL and we permanently fall back to
+// MADV_DONTNEED.  Because of the lazy semantics, MALLOC_DOUBLE_PURGE tracking
+// is enabled on Linux too, and the slow "resident" memory reporter purges
+// MADV_FREE'd pages before measuring, like it does on Mac.
 
 #ifdef XP_DARWIN
 #  define MALLOC_DOUBLE_PURGE
 #endif
+#if defined(XP_LINUX) && defined(MADV_FREE)
+#  define MALLOC_MADV_FREE_RUNTIME_CHECK
+#  define MALLOC_DOUBLE_PURGE
+#endif
 
 #ifdef XP_WIN
 #  define MALLOC_DECOMMIT
 #endif
 
+// When MALLOC_SMALL_CACHE is defined, each thread keeps a small bounded
+// cache of regions for the tiny and quantum size classes, filled from and
+// flushed to its arena in batches so that the common allocation path doesn't
+// take the arena lock at all.  The cache is flushed and recycled from a
+// pthread key destructor when its thread exits, so the feature is only
+// available on platforms that have those.
+#ifndef XP_WIN
+#  define MALLOC_SMALL_CACHE
+#endif
+
 // When MALLOC_STATIC_PAGESIZE is defined, the page size is fixed at
 // compile-time for better performance, as opposed to determined at
 // runtime. Some platforms can have different page sizes at runtime
@@ -207,11 +227,9 @@ static char* getenv(const char* name) {
 #endif
 
 #ifndef XP_WIN
-// Newer Linux systems support MADV_FREE, but we're not supporting
-// that properly. bug #1406304.
-#  if defined(XP_LINUX) && defined(MADV_FREE)
-#    undef MADV_FREE
-#  endif
+// On platforms where the build headers don't provide MADV_FREE at all,
+// fall back to MADV_DONTNEED.  On Linux, MADV_FREE support is additionally
+// probed at runtime; see MALLOC_MADV_FREE_RUNTIME_CHECK above.
 #  ifndef MADV_FREE
 #    define MADV_FREE MADV_DONTNEED
 #  endif
@@ -1018,7 +1036,11 @@ struct arena_t {
 
   void* Ralloc(void* aPtr, size_t aSize, size_t aOldSize);
 
-  void Purge(bool aAll);
+  // Purge dirty pages down to the target (half the applicable dirty page
+  // maximum), stopping early once aMaxPages pages have been purged.  A
+  // coalesced range of dirty pages is always purged whole, so the budget
+  // can be slightly overshot.  Returns the number of pages purged.
+  size_t Purge(bool aAll, size_t aMaxPages = SIZE_MAX);
 
   void HardPurge();
 
@@ -1102,6 +1124,18 @@ class ArenaCollection {
 
   Iterator iter() { return Iterator(&mArenas, &mPrivateArenas); }
 
+  // Set the dirty page high-water mark of the default and thread-local
+  // arenas.  Private arenas are left alone; their limit was chosen through
+  // arena_params_t.
+  void SetMaxDirty(size_t aMaxDirty) {
+    MutexAutoLock lock(mLock);
+    Iterator publicArenas(&mArenas, nullptr);
+    for (auto arena : publicArenas) {
+      MutexAutoLock arena_lock(arena->mLock);
+      arena->mMaxDirty = aMaxDirty;
+    }
+  }
+
   inline arena_t* GetDefault() { return mDefaultArena; }
 
   Mutex mLock;
@@ -1171,6 +1205,88 @@ static detail::ThreadLocal<arena_t*, detail::ThreadLocalKeyStorage>
     thread_arena;
 #endif
 
+#ifdef MALLOC_SMALL_CACHE
+// ***************************************************************************
+// Small-allocation thread cache.
+//
+// Only the tiny and quantum size classes are cached; they are the classes
+// that the main thread, Stylo workers and media threads hammer concurrently.
+// Regions in a cache always belong to the arena the owning thread is pinned
+// to, so a whole bin can be flushed back under a single acquisition of that
+// arena's lock.
+
+// Number of cached size classes.
+static const size_t kNumSmallCacheBins = kNumTinyClasses + kNumQuantumClasses;
+
+// Maximum number of regions cached per size class.
+static const uint32_t kSmallCacheBinCapacity = 16;
+
+// Number of regions a miss pre-fills a bin with, and the number of regions a
+// full bin keeps when it's flushed, so that neither direction of traffic
+// empties the bin right away.
+static const uint32_t kSmallCacheFillCount = kSmallCacheBinCapacity / 2;
+static const uint32_t kSmallCacheKeepOnFlush = kSmallCacheBinCapacity / 2;
+
+struct small_cache_bin_t {
+  uint32_t mCount;
+  void* mItems[kSmallCacheBinCapacity];
+};
+
+struct small_cache_t {
+  // The arena every cached region belongs to.
+  arena_t* mArena;
+
+  // Counters folded into the globals below whenever a bin is flushed.
+  uint64_t mHits;
+  uint64_t mMisses;
+  uint64_t mFlushes;
+
+  // Link in gSmallCacheFreeList once the owning thread has exited.
+  small_cache_t* mNext;
+
+  small_cache_bin_t mBins[kNumSmallCacheBins];
+};
+
+// The cache of the current thread, created lazily on its first cacheable
+// allocation.  Set to &gSmallCacheTornDown once the thread-exit destructor
+// has run so that a late free() can't revive the cache.
+#  if !defined(XP_DARWIN)
+static MOZ_THREAD_LOCAL(small_cache_t*) thread_small_cache;
+#  else
+static detail::ThreadLocal<small_cache_t*, detail::ThreadLocalKeyStorage>
+    thread_small_cache;
+#  endif
+
+// mArena is null, so this sentinel never matches any arena and is never
+// filled.
+static small_cache_t gSmallCacheTornDown;
+
+// Key whose destructor flushes and recycles a thread's cache on exit.
+static pthread_key_t gSmallCacheKey;
+
+// Protects the free list and the aggregated counters.
+static Mutex gSmallCacheLock;
+
+// Caches of exited threads, kept for reuse: they are carved out of base
+// allocations, which are never returned to the OS.
+static small_cache_t* gSmallCacheFreeList;
+
+// Aggregates of the per-cache counters, surfaced by jemalloc_stats().
+static uint64_t gSmallCacheHits;
+static uint64_t gSmallCacheMisses;
+static uint64_t gSmallCacheFlushes;
+
+// Index into small_cache_t::mBins for a size that is already rounded to a
+// tiny or quantum size class.  Mirrors the bin selection in
+// arena_t::MallocSmall().
+static inline size_t SmallCacheBinIndex(size_t aSize) {
+  if (aSize < kMinQuantumClass) {
+    return FloorLog2(aSize / kMinTinyClass);
+  }
+  return kNumTinyClasses + (aSize / kQuantum) - 1;
+}
+#endif  // MALLOC_SMALL_CACHE
+
 // *****************************
 // Runtime configuration options.
 
@@ -1185,6 +1301,23 @@ static const bool opt_junk = false;
 static const bool opt_zero = false;
 #endif
 
+#ifdef MALLOC_SMALL_CACHE
+static bool opt_small_cache = true;
+#endif
+
+// When enabled (through jemalloc_set_deferred_purge() or the 'D' malloc
+// option), arenas crossing their dirty page high-water mark don't purge on
+// the spot; they rely on jemalloc_purge_dirty_pages() being called on a
+// background cadence, and only purge inline once twice the high-water mark
+// accumulates, as a backstop for a cadence that falls behind.
+static bool opt_deferred_purge = false;
+
+#ifdef MALLOC_MADV_FREE_RUNTIME_CHECK
+// Set once madvise(MADV_FREE) has been rejected by the running kernel, after
+// which MADV_DONTNEED is used instead.
+static bool gMadvFreeUnsupported = false;
+#endif
+
 // ***************************************************************************
 // Begin forward declarations.
 
@@ -1194,6 +1327,12 @@ static void chunk_dealloc(void* aChunk, size_t aSize, ChunkType aType);
 static void chunk_ensure_zero(void* aPtr, size_t aSize, bool aZeroed);
 static void huge_dalloc(void* aPtr, arena_t* aArena);
 static bool malloc_init_hard();
+#ifdef MALLOC_SMALL_CACHE
+static small_cache_t* small_cache_create(arena_t* aArena);
+static void small_cache_flush_bin(small_cache_t* aCache,
+                                  small_cache_bin_t* aBin, uint32_t aKeep);
+static void small_cache_thread_exit(void* aCache);
+#endif
 
 #ifdef XP_DARWIN
 #  define FORK_HOOK extern "C"
@@ -2440,9 +2579,10 @@ arena_run_t* arena_t::AllocRun(size_t aSize, bool aLarge, bool aZero) {
   return SplitRun(run, aSize, aLarge, aZero) ? run : nullptr;
 }
 
-void arena_t::Purge(bool aAll) {
+size_t arena_t::Purge(bool aAll, size_t aMaxPages) {
   arena_chunk_t* chunk;
   size_t i, npages;
+  size_t purged = 0;
   // If all is set purge all dirty pages.
   size_t dirty_max = aAll ? 1 : mMaxDirty;
 #ifdef MOZ_DEBUG
@@ -2452,13 +2592,13 @@ void arena_t::Purge(bool aAll) {
   }
   MOZ_ASSERT(ndirty == mNumDirty);
 #endif
-  MOZ_DIAGNOSTIC_ASSERT(aAll || (mNumDirty > mMaxDirty));
+  MOZ_DIAGNOSTIC_ASSERT(aAll || (mNumDirty > (mMaxDirty >> 1)));
 
   // Iterate downward through chunks until enough dirty memory has been
   // purged.  Terminate as soon as possible in order to minimize the
   // number of system calls, even if a chunk has only been partially
   // purged.
-  while (mNumDirty > (dirty_max >> 1)) {
+  while (mNumDirty > (dirty_max >> 1) && purged < aMaxPages) {
 #ifdef MALLOC_DOUBLE_PURGE
     bool madvised = false;
 #endif
@@ -2490,6 +2630,7 @@ void arena_t::Purge(bool aAll) {
         }
         chunk->ndirty -= npages;
         mNumDirty -= npages;
+        purged += npages;
 
 #ifdef MALLOC_DECOMMIT
         pages_decommit((void*)(uintptr_t(chunk) + (i << gPageSize2Pow)),
@@ -2501,15 +2642,36 @@ void arena_t::Purge(bool aAll) {
 #  ifdef XP_SOLARIS
         posix_madvise((void*)(uintptr_t(chunk) + (i << gPageSize2Pow)),
                       (npages << gPageSize2Pow), MADV_FREE);
+#  elif defined(MALLOC_MADV_FREE_RUNTIME_CHECK)
+        bool lazy_freed = false;
+        if (!gMadvFreeUnsupported) {
+          if (madvise((void*)(uintptr_t(chunk) + (i << gPageSize2Pow)),
+                      (npages << gPageSize2Pow), MADV_FREE) == 0) {
+            lazy_freed = true;
+          } else if (errno == EINVAL) {
+            // The running kernel predates MADV_FREE.
+            gMadvFreeUnsupported = true;
+          }
+        }
+        if (!lazy_freed) {
+          madvise((void*)(uintptr_t(chunk) + (i << gPageSize2Pow)),
+                  (npages << gPageSize2Pow), MADV_DONTNEED);
+        }
 #  else
         madvise((void*)(uintptr_t(chunk) + (i << gPageSize2Pow)),
                 (npages << gPageSize2Pow), MADV_FREE);
 #  endif
 #  ifdef MALLOC_DOUBLE_PURGE
+#    ifdef MALLOC_MADV_FREE_RUNTIME_CHECK
+        // MADV_DONTNEED releases the pages right away; only lazily freed
+        // pages need to be tracked for jemalloc_purge_freed_pages().
+        madvised = madvised || lazy_freed;
+#    else
         madvised = true;
+#    endif
 #  endif
 #endif
-        if (mNumDirty <= (dirty_max >> 1)) {
+        if (mNumDirty <= (dirty_max >> 1) || purged >= aMaxPages) {
           break;
         }
       }
@@ -2529,6 +2691,8 @@ void arena_t::Purge(bool aAll) {
     }
 #endif
   }
+
+  return purged;
 }
 
 void arena_t::DallocRun(arena_run_t* aRun, bool aDirty) {
@@ -2625,7 +2789,13 @@ void arena_t::DallocRun(arena_run_t* aRun, bool aDirty) {
 
   // Enforce mMaxDirty.
   if (mNumDirty > mMaxDirty) {
-    Purge(false);
+    if (!opt_deferred_purge || mNumDirty > (mMaxDirty << 1)) {
+      // With deferred purging, jemalloc_purge_dirty_pages() normally does
+      // this on its own cadence; purging inline past twice the high-water
+      // mark keeps a cadence that falls behind from accumulating dirty
+      // pages without bound.
+      Purge(false);
+    }
   }
 }
 
@@ -2819,6 +2989,32 @@ void* arena_t::MallocSmall(size_t aSize, bool aZero) {
   }
   MOZ_DIAGNOSTIC_ASSERT(aSize == bin->mSizeClass);
 
+#ifdef MALLOC_SMALL_CACHE
+  small_cache_bin_t* cacheBin = nullptr;
+  if (opt_small_cache && aSize <= kMaxQuantumClass &&
+      MOZ_LIKELY(!mRandomizeSmallAllocations)) {
+    small_cache_t* cache = thread_small_cache.get();
+    if (MOZ_UNLIKELY(!cache) && this == thread_arena.get()) {
+      cache = small_cache_create(this);
+    }
+    if (cache && cache->mArena == this) {
+      cacheBin = &cache->mBins[SmallCacheBinIndex(aSize)];
+      if (cacheBin->mCount > 0) {
+        // Fast path: pop a region without taking mLock.
+        ret = cacheBin->mItems[--cacheBin->mCount];
+        cache->mHits++;
+        if (!aZero) {
+          ApplyZeroOrJunk(ret, aSize);
+        } else {
+          memset(ret, 0, aSize);
+        }
+        return ret;
+      }
+      cache->mMisses++;
+    }
+  }
+#endif
+
   {
     // Before we lock, we determine if we need to randomize the allocation
     // because if we do, we need to create the PRNG which might require
@@ -2859,6 +3055,33 @@ void* arena_t::MallocSmall(size_t aSize, bool aZero) {
     }
 
     mStats.allocated_small += aSize;
+
+#ifdef MALLOC_SMALL_CACHE
+    // Batch-fill the thread cache while we hold the lock so that the next
+    // few allocations of this class don't need to take it at all.
+    if (cacheBin) {
+      while (cacheBin->mCount < kSmallCacheFillCount) {
+        run = bin->mCurrentRun;
+        if (MOZ_UNLIKELY(!run || run->mNumFree == 0)) {
+          run = bin->mCurrentRun = GetNonFullBinRun(bin);
+        }
+        if (MOZ_UNLIKELY(!run)) {
+          break;
+        }
+        void* reg = ArenaRunRegAlloc(run, bin);
+        if (!reg) {
+          break;
+        }
+        run->mNumFree--;
+        // Cached regions hold the same poison pattern as freed ones.
+        memset(reg, kAllocPoison, aSize);
+        cacheBin->mItems[cacheBin->mCount++] = reg;
+        // Cached regions count as allocated until they are flushed back
+        // through DallocSmall().
+        mStats.allocated_small += aSize;
+      }
+    }
+#endif
   }
 
   if (!aZero) {
@@ -3352,6 +3575,88 @@ void arena_t::DallocLarge(arena_chunk_t* aChunk, void* aPtr) {
   DallocRun((arena_run_t*)aPtr, true);
 }
 
+#ifdef MALLOC_SMALL_CACHE
+// Lazily create the small-allocation cache of the current thread, pinned to
+// aArena.  Returns null if the cache can't be created; allocation then just
+// proceeds through the locked path.
+static small_cache_t* small_cache_create(arena_t* aArena) {
+  small_cache_t* cache;
+
+  {
+    MutexAutoLock lock(gSmallCacheLock);
+    cache = gSmallCacheFreeList;
+    if (cache) {
+      gSmallCacheFreeList = cache->mNext;
+    }
+  }
+  if (!cache) {
+    cache = (small_cache_t*)base_alloc(sizeof(small_cache_t));
+    if (!cache) {
+      return nullptr;
+    }
+  }
+  memset(cache, 0, sizeof(*cache));
+  cache->mArena = aArena;
+  thread_small_cache.set(cache);
+  // The destructor is what flushes the cache when this thread exits.
+  pthread_setspecific(gSmallCacheKey, cache);
+  return cache;
+}
+
+// Return all but aKeep regions of aBin to the arena they belong to, taking
+// its lock once for the whole batch.  The oldest regions are flushed; the
+// most recently freed ones stay cached.
+static void small_cache_flush_bin(small_cache_t* aCache,
+                                  small_cache_bin_t* aBin, uint32_t aKeep) {
+  arena_t* arena = aCache->mArena;
+  uint32_t flush = aBin->mCount - aKeep;
+
+  {
+    MutexAutoLock lock(arena->mLock);
+    for (uint32_t i = 0; i < flush; i++) {
+      void* ptr = aBin->mItems[i];
+      auto chunk = GetChunkForPtr(ptr);
+      MOZ_ASSERT(chunk->arena == arena);
+      size_t pageind = GetChunkOffsetForPtr(ptr) >> gPageSize2Pow;
+      arena->DallocSmall(chunk, ptr, &chunk->map[pageind]);
+    }
+  }
+  memmove(aBin->mItems, aBin->mItems + flush, aKeep * sizeof(void*));
+  aBin->mCount = aKeep;
+  aCache->mFlushes++;
+
+  // Fold the per-thread counters into the globals while we're on a slow path
+  // anyway, so that jemalloc_stats() sees reasonably fresh numbers.
+  MutexAutoLock lock(gSmallCacheLock);
+  gSmallCacheHits += aCache->mHits;
+  gSmallCacheMisses += aCache->mMisses;
+  gSmallCacheFlushes += aCache->mFlushes;
+  aCache->mHits = 0;
+  aCache->mMisses = 0;
+  aCache->mFlushes = 0;
+}
+
+// pthread key destructor; flushes the whole cache and recycles it.
+static void small_cache_thread_exit(void* aCache) {
+  auto cache = (small_cache_t*)aCache;
+
+  for (size_t i = 0; i < kNumSmallCacheBins; i++) {
+    if (cache->mBins[i].mCount > 0) {
+      small_cache_flush_bin(cache, &cache->mBins[i], 0);
+    }
+  }
+
+  MutexAutoLock lock(gSmallCacheLock);
+  gSmallCacheHits += cache->mHits;
+  gSmallCacheMisses += cache->mMisses;
+  gSmallCacheFlushes += cache->mFlushes;
+  cache->mNext = gSmallCacheFreeList;
+  gSmallCacheFreeList = cache;
+  // A free() running after this destructor must not revive the cache.
+  thread_small_cache.set(&gSmallCacheTornDown);
+}
+#endif  // MALLOC_SMALL_CACHE
+
 static inline void arena_dalloc(void* aPtr, size_t aOffset, arena_t* aArena) {
   MOZ_ASSERT(aPtr);
   MOZ_ASSERT(aOffset != 0);
@@ -3363,6 +3668,39 @@ static inline void arena_dalloc(void* aPtr, size_t aOffset, arena_t* aArena) {
   MOZ_DIAGNOSTIC_ASSERT(arena->mMagic == ARENA_MAGIC);
   MOZ_RELEASE_ASSERT(!aArena || arena == aArena);
 
+#ifdef MALLOC_SMALL_CACHE
+  if (opt_small_cache) {
+    // Note that caches only ever bind the non-private arena the thread is
+    // pinned to, so a randomizing (private) arena can never match here.
+    small_cache_t* cache = thread_small_cache.get();
+    if (cache && cache->mArena == arena) {
+      size_t pageind = aOffset >> gPageSize2Pow;
+      arena_chunk_map_t* mapelm = &chunk->map[pageind];
+      // The map bits of a live small allocation only change under the arena
+      // lock when its whole run is deallocated, which can't happen while
+      // this region is still allocated, so they are safe to read unlocked.
+      size_t bits = mapelm->bits;
+      MOZ_RELEASE_ASSERT((bits & CHUNK_MAP_DECOMMITTED) == 0,
+                         "Freeing in decommitted page.");
+      MOZ_RELEASE_ASSERT((bits & CHUNK_MAP_ALLOCATED) != 0, "Double-free?");
+      if ((bits & CHUNK_MAP_LARGE) == 0) {
+        auto run = (arena_run_t*)(bits & ~gPageSizeMask);
+        MOZ_DIAGNOSTIC_ASSERT(run->mMagic == ARENA_RUN_MAGIC);
+        size_t size = run->mBin->mSizeClass;
+        if (size <= kMaxQuantumClass) {
+          small_cache_bin_t* bin = &cache->mBins[SmallCacheBinIndex(size)];
+          if (bin->mCount == kSmallCacheBinCapacity) {
+            small_cache_flush_bin(cache, bin, kSmallCacheKeepOnFlush);
+          }
+          memset(aPtr, kAllocPoison, size);
+          bin->mItems[bin->mCount++] = aPtr;
+          return;
+        }
+      }
+    }
+  }
+#endif
+
   MutexAutoLock lock(arena->mLock);
   size_t pageind = aOffset >> gPageSize2Pow;
   arena_chunk_map_t* mapelm = &chunk->map[pageind];
@@ -3855,6 +4193,12 @@ static bool malloc_init_hard() {
     return true;
   }
 
+#ifdef MALLOC_SMALL_CACHE
+  if (!thread_small_cache.init()) {
+    return true;
+  }
+#endif
+
   // Get page size and number of CPUs
   result = GetKernelPageSize();
   // We assume that the page size is a power of 2.
@@ -3930,6 +4274,20 @@ static bool malloc_init_hard() {
             opt_zero = true;
             break;
 #endif
+#ifdef MALLOC_SMALL_CACHE
+          case 'c':
+            opt_small_cache = false;
+            break;
+          case 'C':
+            opt_small_cache = true;
+            break;
+#endif
+          case 'd':
+            opt_deferred_purge = false;
+            break;
+          case 'D':
+            opt_deferred_purge = true;
+            break;
           default: {
             char cbuf[2];
 
@@ -3947,6 +4305,17 @@ static bool malloc_init_hard() {
 
   gRecycledSize = 0;
 
+#ifdef MALLOC_SMALL_CACHE
+  // Initialize the small-allocation thread cache data.
+  gSmallCacheLock.Init();
+  gSmallCacheFreeList = nullptr;
+  if (pthread_key_create(&gSmallCacheKey, small_cache_thread_exit) != 0) {
+    // Without a thread-exit destructor we'd leak every cache, so don't use
+    // them at all.
+    opt_small_cache = false;
+  }
+#endif
+
   // Initialize chunks data.
   chunks_mtx.Init();
   gChunksBySize.Init();
@@ -4237,6 +4606,18 @@ inline void MozJemalloc::jemalloc_stats(jemalloc_stats_t* aStats) {
   aStats->page_cache = 0;
   aStats->bookkeeping = 0;
   aStats->bin_unused = 0;
+  aStats->small_cache_hits = 0;
+  aStats->small_cache_misses = 0;
+  aStats->small_cache_flushes = 0;
+
+#ifdef MALLOC_SMALL_CACHE
+  {
+    MutexAutoLock lock(gSmallCacheLock);
+    aStats->small_cache_hits = gSmallCacheHits;
+    aStats->small_cache_misses = gSmallCacheMisses;
+    aStats->small_cache_flushes = gSmallCacheFlushes;
+  }
+#endif
 
   non_arena_mapped = 0;
 
@@ -4397,6 +4778,41 @@ inline void MozJemalloc::jemalloc_free_dirty_pages(void) {
   }
 }
 
+template <>
+inline void MozJemalloc::jemalloc_set_deferred_purge(bool aEnable) {
+  opt_deferred_purge = aEnable;
+}
+
+template <>
+inline size_t MozJemalloc::jemalloc_purge_dirty_pages(size_t aMaxPages) {
+  size_t purged = 0;
+  if (malloc_initialized) {
+    MutexAutoLock lock(gArenas.mLock);
+    for (auto arena : gArenas.iter()) {
+      if (purged >= aMaxPages) {
+        break;
+      }
+      MutexAutoLock arena_lock(arena->mLock);
+      // Purge() always aims at half the maximum, so use the same target
+      // here; purging arenas below it would only produce syscalls for
+      // little memory.
+      if (arena->mNumDirty > (arena->mMaxDirty >> 1)) {
+        purged += arena->Purge(false, aMaxPages - purged);
+      }
+    }
+  }
+  return purged;
+}
+
+template <>
+inline void MozJemalloc::jemalloc_set_max_dirty_pages(size_t aMaxDirty) {
+  if (malloc_init()) {
+    // Arenas created later pick the new value up through opt_dirty_max.
+    opt_dirty_max = aMaxDirty;
+    gArenas.SetMaxDirty(aMaxDirty);
+  }
+}
+
 inline arena_t* ArenaCollection::GetByIdInternal(arena_id_t aArenaId,
                                                  bool aIsPrivate) {
   // Use AlignedStorage2 to avoid running the arena_t constructor, while
@@ -4434,6 +4850,18 @@ inline void MozJemalloc::moz_dispose_arena(arena_id_t aArenaId) {
   gArenas.DisposeArena(arena);
 }
 
+template <>
+inline void MozJemalloc::moz_arena_stats(arena_id_t aArenaId,
+                                         jemalloc_arena_stats_t* aStats) {
+  arena_t* arena = gArenas.GetById(aArenaId, /* IsPrivate = */ true);
+  MOZ_RELEASE_ASSERT(arena);
+  MutexAutoLock lock(arena->mLock);
+  aStats->allocated =
+      arena->mStats.allocated_small + arena->mStats.allocated_large;
+  aStats->committed = arena->mStats.committed << gPageSize2Pow;
+  aStats->page_cache = arena->mNumDirty << gPageSize2Pow;
+}
+
 #define MALLOC_DECL(name, return_type, ...)                          \
   template <>                                                        \
   inline return_type MozJemalloc::moz_arena_##name(                  \
@@ -4467,6 +4895,10 @@ static
   base_mtx.Lock();
 
   huge_mtx.Lock();
+
+#  ifdef MALLOC_SMALL_CACHE
+  gSmallCacheLock.Lock();
+#  endif
 }
 
 #  ifndef XP_DARWIN
@@ -4475,6 +4907,10 @@ static
     void
     _malloc_postfork_parent(void) {
   // Release all mutexes, now that fork() has completed.
+#  ifdef MALLOC_SMALL_CACHE
+  gSmallCacheLock.Unlock();
+#  endif
+
   huge_mtx.Unlock();
 
   base_mtx.Unlock();
@@ -4492,6 +4928,10 @@ static
     void
     _malloc_postfork_child(void) {
   // Reinitialize all mutexes, now that fork() has completed.
+#  ifdef MALLOC_SMALL_CACHE
+  gSmallCacheLock.Init();
+#  endif
+
   huge_mtx.Init();
 
   base_mtx.Init();
@@ -43,6 +43,7 @@
 #  include <stddef.h>
 #endif
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,8 +94,27 @@ typedef struct {
   size_t bookkeeping;  // Committed bytes used internally by the
                        // allocator.
   size_t bin_unused;   // Bytes committed to a bin but currently unused.
+
+  // Small-allocation thread cache counters.  They are aggregated when a
+  // cache flushes, so numbers from threads that haven't flushed yet lag.
+  uint64_t small_cache_hits;     // Allocations served from a thread cache.
+  uint64_t small_cache_misses;   // Cacheable allocations that had to take
+                                 // an arena lock.
+  uint64_t small_cache_flushes;  // Batches of regions flushed to an arena.
 } jemalloc_stats_t;
 
+// Statistics for a single arena, as created with moz_create_arena(). Like
+// jemalloc_stats_t, this is not a stable interface. Huge (multi-chunk)
+// allocations are not attributed to any particular arena and are not
+// counted here.
+typedef struct {
+  size_t allocated;   // Bytes allocated from the arena and in use by the
+                      // application.
+  size_t committed;   // Committed bytes the arena holds, whether in use,
+                      // kept as a page cache, or used for bookkeeping.
+  size_t page_cache;  // Committed, unused pages kept around as a cache.
+} jemalloc_arena_stats_t;
+
 enum PtrInfoTag {
   // The pointer is not currently known to the allocator.
   // 'addr', 'size', and 'arenaId' are always 0.
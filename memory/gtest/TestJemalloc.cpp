@@ -337,6 +337,33 @@ TEST(Jemalloc, Arenas)
 #endif
 }
 
+TEST(Jemalloc, ArenaStats)
+{
+  arena_id_t arena = moz_create_arena();
+  ASSERT_TRUE(arena != 0);
+
+  // A fresh arena doesn't hold any memory.
+  jemalloc_arena_stats_t stats;
+  moz_arena_stats(arena, &stats);
+  ASSERT_EQ(stats.allocated, size_t(0));
+  ASSERT_EQ(stats.committed, size_t(0));
+
+  void* ptr = moz_arena_malloc(arena, 256);
+  ASSERT_TRUE(ptr != nullptr);
+  moz_arena_stats(arena, &stats);
+  ASSERT_GE(stats.allocated, size_t(256));
+  ASSERT_GE(stats.committed, stats.allocated);
+
+  moz_arena_free(arena, ptr);
+  moz_arena_stats(arena, &stats);
+  ASSERT_EQ(stats.allocated, size_t(0));
+  // Whatever the arena still holds committed at this point is either page
+  // cache or bookkeeping, not allocations.
+  ASSERT_GE(stats.committed, stats.page_cache);
+
+  moz_dispose_arena(arena);
+}
+
 // Check that a buffer aPtr is entirely filled with a given character from
 // aOffset to aSize. For faster comparison, the caller is required to fill a
 // reference buffer with the wanted character, and give the size of that
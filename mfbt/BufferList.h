@@ -316,6 +316,12 @@ class BufferList : private AllocPolicy {
   // and leaves |aSize| undefined.
   inline char* AllocateBytes(size_t aMaxSize, size_t* aSize);
 
+  // Gives back the last aBytes bytes previously obtained from AllocateBytes,
+  // shrinking Size() accordingly and freeing any segments that become empty.
+  // May only be called if there are no outstanding iterators into the region
+  // being given back.
+  inline void TrimBytes(size_t aBytes);
+
   // Copies possibly non-contiguous byte range starting at aIter into
   // aData. aIter is advanced by aSize bytes. Returns false if it runs out of
   // data before aSize.
@@ -449,6 +455,28 @@ char* BufferList<AllocPolicy>::AllocateBytes(size_t aMaxSize, size_t* aSize) {
   return data;
 }
 
+template <typename AllocPolicy>
+void BufferList<AllocPolicy>::TrimBytes(size_t aBytes) {
+  MOZ_RELEASE_ASSERT(mOwning);
+  MOZ_RELEASE_ASSERT(aBytes <= mSize);
+
+  mSize -= aBytes;
+  while (aBytes) {
+    Segment& last = mSegments.back();
+    size_t toTrim = std::min(aBytes, last.mSize);
+    last.mSize -= toTrim;
+    aBytes -= toTrim;
+
+    if (aBytes) {
+      // This segment is now empty and there is more to give back, so the
+      // segment can go away entirely.
+      MOZ_ASSERT(!last.mSize);
+      this->free_(last.mData, last.mCapacity);
+      mSegments.popBack();
+    }
+  }
+}
+
 template <typename AllocPolicy>
 bool BufferList<AllocPolicy>::ReadBytes(IterImpl& aIter, char* aData,
                                         size_t aSize) const {
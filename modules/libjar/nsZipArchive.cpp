@@ -478,9 +478,10 @@ nsZipItem* nsZipArchive::GetItem(const char* aEntryName) {
       }
     }
     MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
-    nsZipItem* item = mFiles[HashName(aEntryName, len)];
+    uint32_t hash = HashName(aEntryName, len);
+    nsZipItem* item = mFiles[hash % ZIP_TABSIZE];
     while (item) {
-      if ((len == item->nameLength) &&
+      if ((hash == item->hash) && (len == item->nameLength) &&
           (!memcmp(aEntryName, item->Name(), len))) {
         // Successful GetItem() is a good indicator that the file is about to be
         // read
@@ -722,9 +723,10 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd) {
     item->isSynthetic = false;
 
     // Add item to file table
-    uint32_t hash = HashName(item->Name(), namelen);
-    item->next = mFiles[hash];
-    mFiles[hash] = item;
+    item->hash = HashName(item->Name(), namelen);
+    uint32_t bucket = item->hash % ZIP_TABSIZE;
+    item->next = mFiles[bucket];
+    mFiles[bucket] = item;
 
     sig = 0;
   } /* while reading central directory records */
@@ -782,9 +784,10 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Is the directory already in the file table?
         uint32_t hash = HashName(item->Name(), dirlen);
+        uint32_t bucket = hash % ZIP_TABSIZE;
         bool found = false;
-        for (nsZipItem* zi = mFiles[hash]; zi != nullptr; zi = zi->next) {
-          if ((dirlen == zi->nameLength) &&
+        for (nsZipItem* zi = mFiles[bucket]; zi != nullptr; zi = zi->next) {
+          if ((hash == zi->hash) && (dirlen == zi->nameLength) &&
               (0 == memcmp(item->Name(), zi->Name(), dirlen))) {
             // we've already added this dir and all its parents
             found = true;
@@ -801,12 +804,13 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Point to the central record of the original item for the name part.
         diritem->central = item->central;
+        diritem->hash = hash;
         diritem->nameLength = dirlen;
         diritem->isSynthetic = true;
 
         // add diritem to the file table
-        diritem->next = mFiles[hash];
-        mFiles[hash] = diritem;
+        diritem->next = mFiles[bucket];
+        mFiles[bucket] = diritem;
       } /* end processing of dirs in item's name */
     }
   }
@@ -945,7 +949,9 @@ static uint32_t HashName(const char* aName, uint16_t len) {
     val = val * 37 + *p++;
   }
 
-  return (val % ZIP_TABSIZE);
+  // Callers reduce this modulo ZIP_TABSIZE to pick a bucket; the full
+  // value is kept in nsZipItem::hash to cheapen chain walks.
+  return val;
 }
 
 /*
@@ -1001,7 +1007,11 @@ static PRTime GetModTime(uint16_t aDate, uint16_t aTime) {
 }
 
 nsZipItem::nsZipItem()
-    : next(nullptr), central(nullptr), nameLength(0), isSynthetic(false) {}
+    : next(nullptr),
+      central(nullptr),
+      hash(0),
+      nameLength(0),
+      isSynthetic(false) {}
 
 uint32_t nsZipItem::LocalOffset() { return xtolong(central->localhdr_offset); }
 
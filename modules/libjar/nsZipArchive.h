@@ -68,6 +68,10 @@ class nsZipItem final {
 
   nsZipItem* next;
   const ZipCentral* central;
+  // Full (pre-modulo) hash of the entry name, so that chain walks can
+  // reject collisions without touching the name bytes in the mapped
+  // central directory.
+  uint32_t hash;
   uint16_t nameLength;
   bool isSynthetic;
 };
@@ -1089,6 +1089,7 @@ pref("privacy.purge_trackers.max_purge_count", 100);
 
 pref("dom.event.contextmenu.enabled",       true);
 pref("dom.event.coalesce_mouse_move",       true);
+pref("dom.event.coalesce_touch_move",       true);
 
 pref("javascript.enabled",                  true);
 pref("javascript.options.strict",           false);
@@ -1528,6 +1529,11 @@ pref("network.http.rcwn.small_resource_size_kb", 256);
 pref("network.http.rcwn.min_wait_before_racing_ms", 0);
 pref("network.http.rcwn.max_wait_before_racing_ms", 500);
 
+// If the 80th percentile of the recent cache entry open times exceeds this
+// value (in ms), racing channels skip the cache headstart and trigger the
+// network immediately. 0 disables the check.
+pref("network.http.rcwn.slow_open_threshold_ms", 250);
+
 // The ratio of the transaction count for the focused window and the count of
 // all available active connections.
 pref("network.http.focused_window_transaction_ratio", "0.9");
@@ -1616,6 +1622,11 @@ pref("network.websocket.extensions.permessage-deflate", true);
 // one time.
 pref("network.websocket.max-connections", 200);
 
+// the maximum number of received messages delivered to the listener thread
+// in a single batch. Messages decoded while the socket stays readable are
+// coalesced into one dispatch up to this limit.
+pref("network.websocket.delivery-batch-max", 64);
+
 // by default scripts loaded from a https:// origin can only open secure
 // (i.e. wss://) websockets.
 pref("network.websocket.allowInsecureFromHTTPS", false);
@@ -1806,6 +1817,10 @@ pref("network.dnsCacheExpirationGracePeriod", 60);
 // This preference can be used to turn off DNS prefetch.
 pref("network.dns.disablePrefetch", false);
 
+// The maximum number of speculative DNS prefetch lookups a single document
+// may trigger from its links.
+pref("network.dns.max-prefetches-per-document", 512);
+
 // This preference controls whether .onion hostnames are
 // rejected before being given to DNS. RFC 7686
 pref("network.dns.blockDotOnion", true);
@@ -1944,10 +1959,22 @@ pref("network.http.throttle.hold-time-ms", 800);
 // http requests to engage long-standing throttling.
 pref("network.http.throttle.max-time-ms", 500);
 
+// Dispatch-time rate shaping of background tab groups: each background tab
+// group may start at most -rate new transactions per second, with a burst
+// allowance of -burst, so e.g. an analytics burst from a background tab can
+// not crowd out foreground requests.  A rate of 0 disables the shaping.
+pref("network.http.throttle.background-dispatch-rate", 10);
+pref("network.http.throttle.background-dispatch-burst", 30);
+
 // Give higher priority to requests resulting from a user interaction event
 // like click-to-play, image fancy-box zoom, navigation.
 pref("network.http.on_click_priority", true);
 
+// Open speculative connections to the cross-origin hosts named by Link
+// headers of a 103 (Early Hints) informational response, ahead of the
+// final response.
+pref("network.http.early-hint-preconnect", true);
+
 // When the page load has not yet reached DOMContentLoaded point, tail requestes are delayed
 // by (non-tailed requests count + 1) * delay-quantum milliseconds.
 pref("network.http.tailing.delay-quantum", 600);
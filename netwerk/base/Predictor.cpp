@@ -338,6 +338,15 @@ Predictor::GetAllow1918(bool* allow1918) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+Predictor::GetKeepWarm(bool* keepWarm) {
+  // Preconnects are only issued for origins above the preconnect confidence
+  // cutoff, so everything reaching the connection manager through this
+  // overrider already qualifies for warm-keeping.
+  *keepWarm = StaticPrefs::network_predictor_keep_warm();
+  return NS_OK;
+}
+
 // Predictor::nsIInterfaceRequestor
 
 NS_IMETHODIMP
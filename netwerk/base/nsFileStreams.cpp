@@ -43,8 +43,19 @@ using mozilla::Some;
 ////////////////////////////////////////////////////////////////////////////////
 // nsFileStreamBase
 
+// Size of the read-only window ReadSegments() keeps mapped over the file.
+// Large enough to amortize the map/unmap calls over many segment writer
+// callbacks, small enough not to strain 32-bit address space.
+static const uint32_t kMmapWindowSize = 4 * 1024 * 1024;
+
 nsFileStreamBase::nsFileStreamBase()
     : mFD(nullptr),
+      mFileMap(nullptr),
+      mMapAddr(nullptr),
+      mMapLen(0),
+      mMapWindowStart(-1),
+      mMapFileSize(0),
+      mMapFailed(false),
       mBehaviorFlags(0),
       mState(eUnitialized),
       mErrorValue(NS_ERROR_FAILURE) {}
@@ -94,6 +105,9 @@ nsFileStreamBase::SetEOF() {
   nsresult rv = DoPendingOpen();
   NS_ENSURE_SUCCESS(rv, rv);
 
+  // Truncation invalidates mapped pages as well as the cached size.
+  DropMemoryMap();
+
 #if defined(XP_UNIX) || defined(XP_BEOS)
   // Some system calls require an EOF offset.
   int64_t offset;
@@ -164,6 +178,7 @@ nsFileStreamBase::GetFileDescriptor(PRFileDesc** _retval) {
 
 nsresult nsFileStreamBase::Close() {
   CleanUpOpen();
+  DropMemoryMap();
 
   nsresult rv = NS_OK;
   if (mFD) {
@@ -214,12 +229,150 @@ nsresult nsFileStreamBase::Read(char* aBuf, uint32_t aCount,
 nsresult nsFileStreamBase::ReadSegments(nsWriteSegmentFun aWriter,
                                         void* aClosure, uint32_t aCount,
                                         uint32_t* aResult) {
-  // ReadSegments is not implemented because it would be inefficient when
-  // the writer does not consume all data.  If you want to call ReadSegments,
-  // wrap a BufferedInputStream around the file stream.  That will call
-  // Read().
+  // Segments are handed to the writer directly over a read-only
+  // memory-mapped window of the file, so consumers (e.g. a transaction
+  // uploading the file) copy straight from the page cache with no
+  // intermediate buffer.  A writer that does not consume all offered data
+  // is cheap to handle here: the file offset only advances for consumed
+  // bytes and the unconsumed tail stays mapped for the next call.
+  // Non-regular files (and mapping failures) are reported as
+  // NS_ERROR_NOT_IMPLEMENTED, so existing callers keep falling back to
+  // Read() through a buffering wrapper.
+  nsresult rv = DoPendingOpen();
+  if (rv == NS_BASE_STREAM_CLOSED) {
+    *aResult = 0;
+    return NS_OK;
+  }
 
-  return NS_ERROR_NOT_IMPLEMENTED;
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+
+  nsCOMPtr<nsIInputStream> stream =
+      do_QueryInterface(static_cast<nsISeekableStream*>(this));
+
+  *aResult = 0;
+  while (aCount) {
+    const char* data;
+    uint32_t avail;
+    rv = EnsureMmapWindow(&data, &avail);
+    if (NS_FAILED(rv)) {
+      // Bytes already delivered are not lost; the file offset has only
+      // advanced over consumed data.
+      return *aResult ? NS_OK : rv;
+    }
+
+    if (!avail) {
+      // end of file
+      break;
+    }
+
+    uint32_t count = std::min(avail, aCount);
+    uint32_t written = 0;
+    rv = aWriter(stream, aClosure, data, *aResult, count, &written);
+    if (NS_FAILED(rv) || !written) {
+      // Writer errors are not propagated, per nsIInputStream.
+      break;
+    }
+    MOZ_ASSERT(written <= count);
+
+    // Keep the file descriptor in sync so that Read(), Tell() and Seek()
+    // interoperate with the mapped window.
+    if (PR_Seek64(mFD, written, PR_SEEK_CUR) == -1) {
+      return *aResult ? NS_OK : NS_ErrorAccordingToNSPR();
+    }
+
+    *aResult += written;
+    aCount -= written;
+
+    if (written < count) {
+      break;
+    }
+  }
+
+  return NS_OK;
+}
+
+nsresult nsFileStreamBase::EnsureMmapWindow(const char** aData,
+                                            uint32_t* aAvail) {
+  if (mMapFailed) {
+    return NS_ERROR_NOT_IMPLEMENTED;
+  }
+
+  int64_t pos = PR_Seek64(mFD, 0, PR_SEEK_CUR);
+  if (pos == -1) {
+    return NS_ErrorAccordingToNSPR();
+  }
+
+  if (mMapAddr && pos >= mMapWindowStart &&
+      pos < mMapWindowStart + int64_t(mMapLen)) {
+    *aData = mMapAddr + (pos - mMapWindowStart);
+    *aAvail = mMapLen - uint32_t(pos - mMapWindowStart);
+    return NS_OK;
+  }
+
+  if (!mFileMap) {
+    PRFileInfo64 info;
+    if (PR_GetOpenFileInfo64(mFD, &info) == PR_FAILURE ||
+        info.type != PR_FILE_FILE) {
+      // Pipes, devices and the like cannot be mapped.
+      mMapFailed = true;
+      return NS_ERROR_NOT_IMPLEMENTED;
+    }
+    mMapFileSize = info.size;
+    if (mMapFileSize) {
+      mFileMap = PR_CreateFileMap(mFD, mMapFileSize, PR_PROT_READONLY);
+      if (!mFileMap) {
+        mMapFailed = true;
+        return NS_ERROR_NOT_IMPLEMENTED;
+      }
+    }
+  }
+
+  if (pos >= mMapFileSize) {
+    *aData = nullptr;
+    *aAvail = 0;
+    return NS_OK;
+  }
+
+  // Window offsets must respect the platform mapping alignment.
+  int64_t alignment = PR_GetMemMapAlignment();
+  int64_t windowStart = pos - (pos % alignment);
+  uint32_t windowLen = uint32_t(
+      std::min<int64_t>(kMmapWindowSize, mMapFileSize - windowStart));
+
+  void* addr = PR_MemMap(mFileMap, windowStart, windowLen);
+  if (!addr) {
+    mMapFailed = true;
+    return NS_ERROR_NOT_IMPLEMENTED;
+  }
+
+  if (mMapAddr) {
+    PR_MemUnmap(mMapAddr, mMapLen);
+  }
+  mMapAddr = static_cast<char*>(addr);
+  mMapLen = windowLen;
+  mMapWindowStart = windowStart;
+
+  *aData = mMapAddr + (pos - windowStart);
+  *aAvail = windowLen - uint32_t(pos - windowStart);
+  return NS_OK;
+}
+
+void nsFileStreamBase::DropMemoryMap() {
+  if (mMapAddr) {
+    PR_MemUnmap(mMapAddr, mMapLen);
+    mMapAddr = nullptr;
+    mMapLen = 0;
+  }
+  if (mFileMap) {
+    PR_CloseFileMap(mFileMap);
+    mFileMap = nullptr;
+  }
+  mMapWindowStart = -1;
+  mMapFileSize = 0;
+  // The next ReadSegments() on a (re)opened descriptor may try again.
+  mMapFailed = false;
 }
 
 nsresult nsFileStreamBase::IsNonBlocking(bool* aNonBlocking) {
@@ -243,6 +396,9 @@ nsresult nsFileStreamBase::Write(const char* buf, uint32_t count,
   nsresult rv = DoPendingOpen();
   NS_ENSURE_SUCCESS(rv, rv);
 
+  // Writing may move the EOF past the size cached by the mapping.
+  DropMemoryMap();
+
   int32_t cnt = PR_Write(mFD, buf, count);
   if (cnt == -1) {
     return NS_ErrorAccordingToNSPR();
@@ -486,6 +642,26 @@ nsFileInputStream::Read(char* aBuf, uint32_t aCount, uint32_t* _retval) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+nsFileInputStream::ReadSegments(nsWriteSegmentFun aWriter, void* aClosure,
+                                uint32_t aCount, uint32_t* _retval) {
+  nsresult rv =
+      nsFileStreamBase::ReadSegments(aWriter, aClosure, aCount, _retval);
+  NS_ENSURE_SUCCESS(rv, rv);
+
+  // Match Read(): close when the end of the file has been hit.  A zero
+  // result may also mean the writer refused the first segment, so only
+  // close when there really is nothing left to read.
+  if (mBehaviorFlags & CLOSE_ON_EOF && *_retval == 0) {
+    uint64_t avail = 0;
+    if (NS_SUCCEEDED(nsFileStreamBase::Available(&avail)) && avail == 0) {
+      Close();
+    }
+  }
+
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsFileInputStream::ReadLine(nsACString& aLine, bool* aResult) {
   if (!mLineBuffer) {
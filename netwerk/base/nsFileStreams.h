@@ -49,6 +49,34 @@ class nsFileStreamBase : public nsISeekableStream, public nsIFileMetadata {
 
   PRFileDesc* mFD;
 
+  /**
+   * A read-only memory-mapped window over the file, lazily established by
+   * ReadSegments() so that segments are handed to the writer directly over
+   * mapped file pages instead of an intermediate buffer.  Only regular
+   * files can be mapped; for anything else ReadSegments() keeps reporting
+   * NS_ERROR_NOT_IMPLEMENTED and callers fall back to Read().
+   */
+  PRFileMap* mFileMap;
+  char* mMapAddr;
+  uint32_t mMapLen;
+  int64_t mMapWindowStart;
+  int64_t mMapFileSize;
+  bool mMapFailed;
+
+  /**
+   * Positions the mapped window over the current file offset, mapping the
+   * next window when the present one is exhausted.  Returns where the
+   * unconsumed data starts and how much of it the window holds; zero
+   * remaining means end of file.
+   */
+  nsresult EnsureMmapWindow(const char** aData, uint32_t* aAvail);
+
+  /**
+   * Unmaps the window and releases the file map.  Called whenever the
+   * mapping could go stale (Close, SetEOF, Write).
+   */
+  void DropMemoryMap();
+
   /**
    * Flags describing our behavior.  See the IDL file for possible values.
    */
@@ -132,9 +160,7 @@ class nsFileInputStream : public nsFileStreamBase,
   NS_IMETHOD Available(uint64_t* _retval) override;
   NS_IMETHOD Read(char* aBuf, uint32_t aCount, uint32_t* _retval) override;
   NS_IMETHOD ReadSegments(nsWriteSegmentFun aWriter, void* aClosure,
-                          uint32_t aCount, uint32_t* _retval) override {
-    return nsFileStreamBase::ReadSegments(aWriter, aClosure, aCount, _retval);
-  }
+                          uint32_t aCount, uint32_t* _retval) override;
   NS_IMETHOD IsNonBlocking(bool* _retval) override {
     return nsFileStreamBase::IsNonBlocking(_retval);
   }
@@ -10,7 +10,10 @@
 #include "nsNetUtil.h"
 
 #include "mozilla/Atomics.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/Encoding.h"
+#include "mozilla/MruCache.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/LoadContext.h"
 #include "mozilla/LoadInfo.h"
 #include "mozilla/BasePrincipal.h"
@@ -1664,6 +1667,64 @@ static nsresult NewStandardURI(const nsACString& aSpec, const char* aCharset,
       .Finalize(aURI);
 }
 
+namespace {
+
+// Memoization of recently parsed absolute http(s) specs: pages request the
+// same handful of specs (analytics endpoints, API routes) over and over, and
+// each NS_NewURI otherwise pays the full nsStandardURL parse. The cache
+// keeps a canonical already-parsed URI per spec and hands out clones, which
+// only copy the segment table and share the spec buffer; the canonical
+// instance itself is never given to a caller since URI refcounting isn't
+// threadsafe. Main thread only, so no locking is needed.
+struct CachedUriSpec {
+  nsCString mSpec;
+  nsCOMPtr<nsIURI> mURI;
+};
+
+struct UriSpecCache
+    : public MruCache<nsACString, CachedUriSpec, UriSpecCache, 127, 2> {
+  static HashNumber Hash(const KeyType& aKey) { return HashString(aKey); }
+  static bool Match(const KeyType& aKey, const ValueType& aVal) {
+    return aVal.mURI && aVal.mSpec == aKey;
+  }
+};
+
+StaticAutoPtr<UriSpecCache> gUriSpecCache;
+
+}  // namespace
+
+static nsresult NewCacheableStandardURI(const nsACString& aSpec,
+                                        int32_t aDefaultPort, nsIURI** aURI) {
+  if (!NS_IsMainThread()) {
+    return NewStandardURI(aSpec, nullptr, nullptr, aDefaultPort, aURI);
+  }
+
+  if (!gUriSpecCache) {
+    gUriSpecCache = new UriSpecCache();
+    ClearOnShutdown(&gUriSpecCache);
+  }
+
+  auto cached = gUriSpecCache->Lookup(aSpec);
+  if (cached) {
+    return NS_MutateURI(cached.Data().mURI).Finalize(aURI);
+  }
+
+  nsCOMPtr<nsIURI> uri;
+  nsresult rv =
+      NewStandardURI(aSpec, nullptr, nullptr, aDefaultPort, getter_AddRefs(uri));
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+
+  nsCOMPtr<nsIURI> canonical;
+  if (NS_SUCCEEDED(NS_MutateURI(uri).Finalize(getter_AddRefs(canonical)))) {
+    cached.Set(CachedUriSpec{nsCString(aSpec), std::move(canonical)});
+  }
+
+  uri.forget(aURI);
+  return NS_OK;
+}
+
 extern MOZ_THREAD_LOCAL(uint32_t) gTlsURLRecursionCount;
 
 template <typename T>
@@ -1713,10 +1774,16 @@ nsresult NS_NewURI(nsIURI** aURI, const nsACString& aSpec,
   }
 
   if (scheme.EqualsLiteral("http") || scheme.EqualsLiteral("ws")) {
+    if (!aCharset && !aBaseURI) {
+      return NewCacheableStandardURI(aSpec, NS_HTTP_DEFAULT_PORT, aURI);
+    }
     return NewStandardURI(aSpec, aCharset, aBaseURI, NS_HTTP_DEFAULT_PORT,
                           aURI);
   }
   if (scheme.EqualsLiteral("https") || scheme.EqualsLiteral("wss")) {
+    if (!aCharset && !aBaseURI) {
+      return NewCacheableStandardURI(aSpec, NS_HTTPS_DEFAULT_PORT, aURI);
+    }
     return NewStandardURI(aSpec, aCharset, aBaseURI, NS_HTTPS_DEFAULT_PORT,
                           aURI);
   }
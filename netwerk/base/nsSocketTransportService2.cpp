@@ -130,6 +130,7 @@ nsSocketTransportService::nsSocketTransportService()
       mIdleListSize(SOCKET_LIMIT_MIN),
       mActiveCount(0),
       mIdleCount(0),
+      mActiveTimeoutCount(0),
       mSentBytesCount(0),
       mReceivedBytesCount(0),
       mSendBufferSize(0),
@@ -599,6 +600,13 @@ PRIntervalTime nsSocketTransportService::PollTimeout(PRIntervalTime now) {
     return NS_SOCKET_POLL_TIMEOUT;
   }
 
+  if (mActiveTimeoutCount == 0) {
+    // No active socket has a timeout engaged, so there is nothing to cut
+    // the poll short for and no reason to walk the list.
+    SOCKET_LOG(("poll timeout: none\n"));
+    return NS_SOCKET_POLL_TIMEOUT;
+  }
+
   // compute minimum time before any socket timeout expires.
   PRIntervalTime minR = NS_SOCKET_POLL_TIMEOUT;
   for (uint32_t i = 0; i < mActiveCount; ++i) {
@@ -1236,6 +1244,7 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
   // were idle to begin with ;-)
   //
   count = mIdleCount;
+  mActiveTimeoutCount = 0;
   for (i = mActiveCount - 1; i >= 0; --i) {
     //---
     SOCKET_LOG(("  active [%u] { handler=%p condition=%" PRIx32
@@ -1254,7 +1263,15 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
         // update poll flags
         mPollList[i + 1].in_flags = in_flags;
         mPollList[i + 1].out_flags = 0;
+        // We touch every active socket here anyway, so the stale-epoch
+        // reset that used to live in the post-poll walk happens here and
+        // the post-poll walk can stop early once all signalled sockets
+        // have been serviced.
+        mActiveList[i].MaybeResetEpoch();
         mActiveList[i].EnsureTimeout(now);
+        if (mActiveList[i].mHandler->mPollTimeout != UINT16_MAX) {
+          ++mActiveTimeoutCount;
+        }
       }
     }
   }
@@ -1321,7 +1338,21 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
     // service "active" sockets...
     //
     uint32_t numberOfOnSocketReadyCalls = 0;
+    // Number of signalled sockets poll() reported, not counting the
+    // pollable event.
+    uint32_t readySockets = 0;
+    if (n > 0) {
+      readySockets = n;
+      if (mPollList[0].fd && mPollList[0].out_flags != 0) {
+        --readySockets;
+      }
+    }
     for (i = 0; i < int32_t(mActiveCount); ++i) {
+      if (readySockets == 0 && mActiveTimeoutCount == 0) {
+        // Every signalled socket has been serviced and no socket has a
+        // timeout engaged, so the rest of the list has nothing for us.
+        break;
+      }
       PRPollDesc& desc = mPollList[i + 1];
       SocketContext& s = mActiveList[i];
       if (n > 0 && desc.out_flags != 0) {
@@ -1329,6 +1360,7 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
         tasktracer::AutoSourceEvent taskTracerEvent(
             tasktracer::SourceEventType::SocketIO);
 #endif
+        --readySockets;
         s.DisengageTimeout();
         s.mHandler->OnSocketReady(desc.fd, desc.out_flags);
         numberOfOnSocketReadyCalls++;
@@ -1341,8 +1373,6 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
         s.DisengageTimeout();
         s.mHandler->OnSocketReady(desc.fd, -1);
         numberOfOnSocketReadyCalls++;
-      } else {
-        s.MaybeResetEpoch();
       }
     }
     if (Telemetry::CanRecordPrereleaseData()) {
@@ -210,6 +210,10 @@ class nsSocketTransportService final : public nsPISocketTransportService,
   uint32_t mIdleListSize;
   uint32_t mActiveCount;
   uint32_t mIdleCount;
+  // Number of entries in mActiveList with a timeout engaged, recounted on
+  // every poll iteration while the poll flags are synced.  When it is zero
+  // the timeout scans over the active list can be skipped entirely.
+  uint32_t mActiveTimeoutCount;
 
   nsresult DetachSocket(SocketContext*, SocketContext*);
   nsresult AddToIdleList(SocketContext*);
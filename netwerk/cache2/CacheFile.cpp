@@ -2078,7 +2078,12 @@ void CacheFile::RemoveInput(CacheFileInputStream* aInput, nsresult aStatus) {
   ReleaseOutsideLock(
       already_AddRefed<nsIInputStream>(static_cast<nsIInputStream*>(aInput)));
 
-  if (!mMemoryOnly) WriteMetadataIfNeededLocked();
+  // Don't write the metadata immediately. A page load typically closes and
+  // reopens readers of the same entries several times and only the access
+  // information changed here. Post the write timer instead, so that the
+  // updates of all entries touched by the load are coalesced into one batch
+  // issued when the scheduler fires.
+  if (!mMemoryOnly && mMetadata && mMetadata->IsDirty()) PostWriteTimer();
 
   // If the input didn't read all data, there might be left some preloaded
   // chunks that won't be used anymore.
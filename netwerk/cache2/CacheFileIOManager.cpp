@@ -48,6 +48,7 @@ namespace net {
 #define kMetadataWriteDelay 5000
 #define kRemoveTrashStartDelay 60000    // in milliseconds
 #define kSmartSizeUpdateInterval 60000  // in milliseconds
+#define kFreeSpaceCheckValidityPeriod 1000  // in milliseconds
 
 #ifdef ANDROID
 const uint32_t kMaxCacheSizeKB = 512 * 1024;  // 512 MB
@@ -1108,7 +1109,8 @@ CacheFileIOManager::CacheFileIOManager()
       mTreeCreationFailed(false),
       mOverLimitEvicting(false),
       mCacheSizeOnHardLimit(false),
-      mRemovingTrashDirs(false) {
+      mRemovingTrashDirs(false),
+      mEstimatedFreeSpace(-1) {
   LOG(("CacheFileIOManager::CacheFileIOManager [this=%p]", this));
   MOZ_ASSERT(!gInstance, "multiple CacheFileIOManager instances!");
 }
@@ -1988,23 +1990,45 @@ nsresult CacheFileIOManager::WriteInternal(CacheFileHandle* aHandle,
       return NS_ERROR_FILE_DISK_FULL;
     }
 
-    int64_t freeSpace;
-    rv = mCacheDirectory->GetDiskSpaceAvailable(&freeSpace);
-    if (NS_WARN_IF(NS_FAILED(rv))) {
-      freeSpace = -1;
-      LOG(
-          ("CacheFileIOManager::WriteInternal() - GetDiskSpaceAvailable() "
-           "failed! [rv=0x%08" PRIx32 "]",
-           static_cast<uint32_t>(rv)));
-    } else {
-      freeSpace >>= 10;  // bytes to kilobytes
+    // Querying the free space is too expensive to do for every single write
+    // when a batch of scheduled metadata writes is being flushed, so the last
+    // result is reused for a short period and decremented by the growth of
+    // every file written in the meantime.
+    TimeStamp now = TimeStamp::NowLoRes();
+    if (mEstimatedFreeSpace == -1 || mFreeSpaceCheckTime.IsNull() ||
+        (now - mFreeSpaceCheckTime).ToMilliseconds() >
+            kFreeSpaceCheckValidityPeriod) {
+      rv = mCacheDirectory->GetDiskSpaceAvailable(&mEstimatedFreeSpace);
+      if (NS_WARN_IF(NS_FAILED(rv))) {
+        mEstimatedFreeSpace = -1;
+        LOG(
+            ("CacheFileIOManager::WriteInternal() - GetDiskSpaceAvailable() "
+             "failed! [rv=0x%08" PRIx32 "]",
+             static_cast<uint32_t>(rv)));
+      }
+      mFreeSpaceCheckTime = now;
+    }
+
+    if (mEstimatedFreeSpace != -1) {
+      int64_t freeSpace = mEstimatedFreeSpace >> 10;  // bytes to kilobytes
       uint32_t limit = CacheObserver::DiskFreeSpaceHardLimit();
       if (freeSpace - aOffset - aCount + aHandle->mFileSize < limit) {
-        LOG(
-            ("CacheFileIOManager::WriteInternal() - Low free space, refusing "
-             "to write! [freeSpace=%" PRId64 "kB, limit=%ukB]",
-             freeSpace, limit));
-        return NS_ERROR_FILE_DISK_FULL;
+        // The estimate may be stale; re-query before refusing the write so
+        // that a stale value never fails a write a fresh one would allow.
+        rv = mCacheDirectory->GetDiskSpaceAvailable(&mEstimatedFreeSpace);
+        if (NS_WARN_IF(NS_FAILED(rv))) {
+          mEstimatedFreeSpace = -1;
+        } else {
+          mFreeSpaceCheckTime = now;
+          freeSpace = mEstimatedFreeSpace >> 10;
+          if (freeSpace - aOffset - aCount + aHandle->mFileSize < limit) {
+            LOG(
+                ("CacheFileIOManager::WriteInternal() - Low free space, "
+                 "refusing to write! [freeSpace=%" PRId64 "kB, limit=%ukB]",
+                 freeSpace, limit));
+            return NS_ERROR_FILE_DISK_FULL;
+          }
+        }
       }
     }
   }
@@ -2021,6 +2045,7 @@ nsresult CacheFileIOManager::WriteInternal(CacheFileHandle* aHandle,
 
   if (bytesWritten != -1) {
     uint32_t oldSizeInK = aHandle->FileSizeInK();
+    int64_t oldFileSize = aHandle->mFileSize;
     int64_t writeEnd = aOffset + bytesWritten;
 
     if (aTruncate) {
@@ -2034,6 +2059,10 @@ nsresult CacheFileIOManager::WriteInternal(CacheFileHandle* aHandle,
       }
     }
 
+    if (mEstimatedFreeSpace != -1 && aHandle->mFileSize > oldFileSize) {
+      mEstimatedFreeSpace -= aHandle->mFileSize - oldFileSize;
+    }
+
     uint32_t newSizeInK = aHandle->FileSizeInK();
 
     if (oldSizeInK != newSizeInK && !aHandle->IsDoomed() &&
@@ -471,6 +471,12 @@ class CacheFileIOManager final : public nsITimerCallback, public nsINamed {
   nsTArray<nsCString> mFailedTrashDirs;
   RefPtr<CacheFileContextEvictor> mContextEvictor;
   TimeStamp mLastSmartSizeTime;
+  // Free space in the cache directory in bytes as of mFreeSpaceCheckTime,
+  // decremented by the growth of every file written since then; -1 when
+  // unknown.  Used by WriteInternal() to avoid querying the disk for every
+  // single write when a batch of scheduled metadata writes is flushed.
+  int64_t mEstimatedFreeSpace;
+  TimeStamp mFreeSpaceCheckTime;
 };
 
 }  // namespace net
@@ -522,13 +522,19 @@ uint32_t CachePerfStats::MMA::GetStdDev() {
 }
 
 CachePerfStats::PerfData::PerfData()
-    : mFilteredAvg(50, true), mShortAvg(3, false) {}
+    : mFilteredAvg(50, true), mShortAvg(3, false), mRecentIdx(0), mRecentCnt(0) {}
 
 void CachePerfStats::PerfData::AddValue(uint32_t aValue, bool aShortOnly) {
   if (!aShortOnly) {
     mFilteredAvg.AddValue(aValue);
   }
   mShortAvg.AddValue(aValue);
+
+  mRecentSamples[mRecentIdx] = aValue;
+  mRecentIdx = (mRecentIdx + 1) % kRecentSamplesCount;
+  if (mRecentCnt < kRecentSamplesCount) {
+    ++mRecentCnt;
+  }
 }
 
 uint32_t CachePerfStats::PerfData::GetAverage(bool aFiltered) {
@@ -539,6 +545,20 @@ uint32_t CachePerfStats::PerfData::GetStdDev(bool aFiltered) {
   return aFiltered ? mFilteredAvg.GetStdDev() : mShortAvg.GetStdDev();
 }
 
+uint32_t CachePerfStats::PerfData::GetPercentile(uint32_t aPercentile) {
+  MOZ_ASSERT(aPercentile <= 100);
+
+  if (mRecentCnt < kRecentSamplesCount) {
+    // Don't estimate the tail from a handful of samples.
+    return 0;
+  }
+
+  uint32_t sorted[kRecentSamplesCount];
+  memcpy(sorted, mRecentSamples, sizeof(sorted));
+  std::sort(sorted, sorted + mRecentCnt);
+  return sorted[(mRecentCnt - 1) * aPercentile / 100];
+}
+
 // static
 void CachePerfStats::AddValue(EDataType aType, uint32_t aValue,
                               bool aShortOnly) {
@@ -558,6 +578,12 @@ uint32_t CachePerfStats::GetStdDev(EDataType aType, bool aFiltered) {
   return sData[aType].GetStdDev(aFiltered);
 }
 
+// static
+uint32_t CachePerfStats::GetPercentile(EDataType aType, uint32_t aPercentile) {
+  StaticMutexAutoLock lock(sLock);
+  return sData[aType].GetPercentile(aPercentile);
+}
+
 // static
 bool CachePerfStats::IsCacheSlow() {
   StaticMutexAutoLock lock(sLock);
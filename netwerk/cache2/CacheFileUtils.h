@@ -154,6 +154,12 @@ class CachePerfStats {
   static void AddValue(EDataType aType, uint32_t aValue, bool aShortOnly);
   static uint32_t GetAverage(EDataType aType, bool aFiltered);
   static uint32_t GetStdDev(EDataType aType, bool aFiltered);
+  // Returns the given percentile of the most recent samples in microseconds.
+  // Unlike the averages above this is computed over an unfiltered rolling
+  // window, so it follows the tail latency under I/O pressure instead of
+  // being dominated by the fast common case. Returns 0 until a full window
+  // of samples has been collected.
+  static uint32_t GetPercentile(EDataType aType, uint32_t aPercentile);
   static bool IsCacheSlow();
   static void GetSlowStats(uint32_t* aSlow, uint32_t* aNotSlow);
 
@@ -192,6 +198,7 @@ class CachePerfStats {
     void AddValue(uint32_t aValue, bool aShortOnly);
     uint32_t GetAverage(bool aFiltered);
     uint32_t GetStdDev(bool aFiltered);
+    uint32_t GetPercentile(uint32_t aPercentile);
 
    private:
     // Contains filtered data (i.e. times when we think the cache and disk was
@@ -200,6 +207,14 @@ class CachePerfStats {
 
     // Contains unfiltered average of few recent values.
     MMA mShortAvg;
+
+    // Rolling window of the most recent values, including the spikes that
+    // mFilteredAvg filters out, used for percentile estimates of the tail
+    // latency.
+    static const uint32_t kRecentSamplesCount = 32;
+    uint32_t mRecentSamples[kRecentSamplesCount];
+    uint32_t mRecentIdx;
+    uint32_t mRecentCnt;
   };
 
   static StaticMutex sLock;
@@ -18,11 +18,26 @@
 #include "nsITimer.h"
 #include "mozilla/AutoRestore.h"
 #include <algorithm>
+#include "mozilla/ProfilerCounts.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/Unused.h"
 
+// Sampled by the profiler and shown as a track, so that cache index lookup
+// rates can be correlated with page loads without a marker per lookup.
+PROFILER_DEFINE_COUNT_TOTAL(cacheIndexLookups, "Cache",
+                            "Number of lookups in the HTTP cache index.")
+
 #define kMinUnwrittenChanges 300
 #define kMinDumpInterval 20000  // in milliseconds
+// A dump rewrites the whole index file, so for large indexes a fixed change
+// count causes massive write amplification: 300 dirty entries out of half a
+// million would rewrite tens of megabytes every 20 seconds.  Require the
+// dirty entries to also be at least this fraction (in percent) of the index
+// before rewriting it...
+#define kMinUnwrittenChangesPercent 2
+// ...unless the last dump is older than this, so a mostly-idle index still
+// hits the disk with a bounded staleness.  (In milliseconds.)
+#define kMaxDumpInterval 600000
 #define kMaxBufSize 16384
 #define kIndexVersion 0x00000009
 #define kUpdateIndexStartDelay 50000  // in milliseconds
@@ -1181,6 +1196,8 @@ nsresult CacheIndex::HasEntry(
 nsresult CacheIndex::HasEntry(
     const SHA1Sum::Hash& hash, EntryStatus* _retval,
     const std::function<void(const CacheIndexEntry*)>& aCB) {
+  AUTO_PROFILER_COUNT_TOTAL(cacheIndexLookups, 1);
+
   StaticMutexAutoLock lock(sLock);
 
   RefPtr<CacheIndex> index = gInstance;
@@ -1659,16 +1676,33 @@ bool CacheIndex::WriteIndexToDiskIfNeeded() {
     return false;
   }
 
-  if (!mLastDumpTime.IsNull() &&
-      (TimeStamp::NowLoRes() - mLastDumpTime).ToMilliseconds() <
-          kMinDumpInterval) {
+  if (mLastDumpTime.IsNull()) {
+    // Defer the first dump by the regular interval and measure the
+    // staleness cap below from this point.
+    mLastDumpTime = TimeStamp::NowLoRes();
+    return false;
+  }
+
+  TimeDuration sinceLastDump = TimeStamp::NowLoRes() - mLastDumpTime;
+  if (sinceLastDump.ToMilliseconds() < kMinDumpInterval) {
     return false;
   }
 
-  if (mIndexStats.Dirty() < kMinUnwrittenChanges) {
+  uint32_t dirty = mIndexStats.Dirty();
+  if (dirty < kMinUnwrittenChanges) {
     return false;
   }
 
+  // Scale the threshold with the index size so that a big index isn't
+  // rewritten over and over for a handful of changes, but never defer a
+  // dump longer than kMaxDumpInterval.
+  if (sinceLastDump.ToMilliseconds() < kMaxDumpInterval) {
+    uint64_t activeEntries = mIndexStats.ActiveEntriesCount();
+    if (uint64_t(dirty) * 100 < activeEntries * kMinUnwrittenChangesPercent) {
+      return false;
+    }
+  }
+
   WriteIndexToDisk();
   return true;
 }
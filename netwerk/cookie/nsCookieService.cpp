@@ -2224,13 +2224,13 @@ void nsCookieService::SetCookieStringInternal(
   nsCOMPtr<nsICookieJarSettings> cookieJarSettings =
       GetCookieJarSettings(aChannel);
 
-  // check default prefs
-  uint32_t priorCookieCount = 0;
+  // check default prefs. the count is keyed on the base domain we already
+  // computed above; only the private browsing id takes part in the key.
   uint32_t rejectedReason = aRejectedReason;
-  nsAutoCString hostFromURI;
-  aHostURI->GetHost(hostFromURI);
-  CountCookiesFromHostInternal(hostFromURI, aOriginAttrs.mPrivateBrowsingId,
-                               &priorCookieCount);
+  OriginAttributes countAttrs;
+  countAttrs.mPrivateBrowsingId = aOriginAttrs.mPrivateBrowsingId;
+  uint32_t priorCookieCount =
+      CountCookiesFromBaseDomain(nsCookieKey(baseDomain, countAttrs));
   CookieStatus cookieStatus = CheckPrefs(
       cookieJarSettings, aHostURI, aIsForeign, aIsThirdPartyTrackingResource,
       aIsThirdPartySocialTrackingResource, aFirstPartyStorageAccessGranted,
@@ -3026,11 +3026,13 @@ void nsCookieService::GetCookiesForURI(
   nsCOMPtr<nsICookieJarSettings> cookieJarSettings =
       GetCookieJarSettings(aChannel);
 
-  // check default prefs
+  // check default prefs. the count is keyed on the base domain we already
+  // computed above; only the private browsing id takes part in the key.
   uint32_t rejectedReason = aRejectedReason;
-  uint32_t priorCookieCount = 0;
-  CountCookiesFromHostInternal(hostFromURI, aOriginAttrs.mPrivateBrowsingId,
-                               &priorCookieCount);
+  OriginAttributes countAttrs;
+  countAttrs.mPrivateBrowsingId = aOriginAttrs.mPrivateBrowsingId;
+  uint32_t priorCookieCount =
+      CountCookiesFromBaseDomain(nsCookieKey(baseDomain, countAttrs));
   CookieStatus cookieStatus = CheckPrefs(
       cookieJarSettings, aHostURI, aIsForeign, aIsThirdPartyTrackingResource,
       aIsThirdPartySocialTrackingResource, aFirstPartyStorageAccessGranted,
@@ -4702,11 +4704,20 @@ nsresult nsCookieService::CountCookiesFromHostInternal(
   nsCookieKey key(baseDomain, attrs);
 
   // Return a count of all cookies, including expired.
-  nsCookieEntry* entry = mDBState->hostTable.GetEntry(key);
-  *aCountFromHost = entry ? entry->GetCookies().Length() : 0;
+  *aCountFromHost = CountCookiesFromBaseDomain(key);
   return NS_OK;
 }
 
+// Count all cookies (including expired) stored under the given hash key.
+// This is the request-path variant of CountCookiesFromHostInternal: the
+// caller must have selected mDBState and ensured the read is complete, and
+// supplies an already-computed base domain, saving a second eTLD lookup on
+// every request.
+uint32_t nsCookieService::CountCookiesFromBaseDomain(const nsCookieKey& aKey) {
+  nsCookieEntry* entry = mDBState->hostTable.GetEntry(aKey);
+  return entry ? entry->GetCookies().Length() : 0;
+}
+
 // get an enumerator of cookies stored by a particular host. this is provided by
 // the nsICookieManager interface.
 NS_IMETHODIMP
@@ -343,6 +343,7 @@ class nsCookieService final : public nsICookieService,
   nsresult CountCookiesFromHostInternal(const nsACString& aHost,
                                         uint32_t aPrivateBrowsingId,
                                         uint32_t* aCountFromHost);
+  uint32_t CountCookiesFromBaseDomain(const nsCookieKey& aKey);
 
  protected:
   nsresult RemoveCookiesFromExactHost(
@@ -257,6 +257,16 @@ nsresult TRR::SendHTTPRequest() {
     }
   }
 
+  if (((mType == TRRTYPE_A) || (mType == TRRTYPE_AAAA)) && UseDefaultServer() &&
+      gTRRService->AttachToInFlightQuery(this)) {
+    // An identical question is already on the wire against the same server.
+    // We are now registered as a follower on that request and get a copy of
+    // its response when it completes, instead of setting up a channel and
+    // asking the server a second time.
+    LOG(("TRR::SendHTTPRequest coalesced %s type %u\n", mHost.get(), mType));
+    return NS_OK;
+  }
+
   bool useGet = gTRRService->UseGET();
   nsAutoCString body;
   nsCOMPtr<nsIURI> dnsURI;
@@ -411,6 +421,12 @@ nsresult TRR::SendHTTPRequest() {
   timedChan->SetTimingEnabled(true);
 
   if (NS_SUCCEEDED(httpChannel->AsyncOpen(this))) {
+    if (((mType == TRRTYPE_A) || (mType == TRRTYPE_AAAA)) &&
+        UseDefaultServer()) {
+      // Make this request visible to later identical questions so they can
+      // coalesce onto it.
+      gTRRService->AddInFlightQuery(this);
+    }
     NS_NewTimerWithCallback(getter_AddRefs(mTimeout), this,
                             gTRRService->GetRequestTimeout(),
                             nsITimer::TYPE_ONE_SHOT);
@@ -1099,6 +1115,30 @@ nsresult TRR::On200Response(nsIChannel* aChannel) {
   return NS_ERROR_FAILURE;
 }
 
+void TRR::NotifyFollowers(nsTArray<RefPtr<TRR>>& aFollowers,
+                          nsIChannel* aChannel, nsresult aStatus) {
+  for (uint32_t i = 0; i < aFollowers.Length(); i++) {
+    if (NS_SUCCEEDED(aStatus)) {
+      aFollowers[i]->ReceiveResponse(this, aChannel);
+    } else {
+      aFollowers[i]->FailData(aStatus);
+    }
+  }
+  aFollowers.Clear();
+}
+
+void TRR::ReceiveResponse(TRR* aLeader, nsIChannel* aChannel) {
+  LOG(("TRR::ReceiveResponse %p %s %d from leader %p\n", this, mHost.get(),
+       mType, aLeader));
+  MOZ_ASSERT(aLeader->mBodySize <= kMaxSize);
+  memcpy(mResponse, aLeader->mResponse, aLeader->mBodySize);
+  mBodySize = aLeader->mBodySize;
+  mAllowRFC1918 = aLeader->mAllowRFC1918;
+  if (NS_FAILED(On200Response(aChannel))) {
+    FailData(NS_ERROR_UNKNOWN_HOST);
+  }
+}
+
 static void RecordProcessingTime(nsIChannel* aChannel) {
   // This method records the time it took from the last received byte of the
   // DoH response until we've notified the consumer with a host record.
@@ -1129,6 +1169,13 @@ TRR::OnStopRequest(nsIRequest* aRequest, nsresult aStatusCode) {
   nsCOMPtr<nsIChannel> channel;
   channel.swap(mChannel);
 
+  // If duplicate queries were coalesced onto this request, collect them now
+  // so they can be handed the outcome below.
+  nsTArray<RefPtr<TRR>> followers;
+  if (gTRRService) {
+    gTRRService->RemoveInFlightQuery(this, followers);
+  }
+
   if (UseDefaultServer()) {
     // Bad content is still considered "okay" if the HTTP response is okay
     gTRRService->TRRIsOkay(NS_SUCCEEDED(aStatusCode) ? TRRService::OKAY_NORMAL
@@ -1148,6 +1195,7 @@ TRR::OnStopRequest(nsIRequest* aRequest, nsresult aStatusCode) {
         !contentType.LowerCaseEqualsLiteral("application/dns-message")) {
       LOG(("TRR:OnStopRequest %p %s %d wrong content type %s\n", this,
            mHost.get(), mType, contentType.get()));
+      NotifyFollowers(followers, channel, NS_ERROR_UNEXPECTED);
       FailData(NS_ERROR_UNEXPECTED);
       return NS_OK;
     }
@@ -1158,6 +1206,7 @@ TRR::OnStopRequest(nsIRequest* aRequest, nsresult aStatusCode) {
       rv = On200Response(channel);
       if (NS_SUCCEEDED(rv) && UseDefaultServer()) {
         RecordProcessingTime(channel);
+        NotifyFollowers(followers, channel, NS_OK);
         return rv;
       }
     } else {
@@ -1168,6 +1217,7 @@ TRR::OnStopRequest(nsIRequest* aRequest, nsresult aStatusCode) {
 
   LOG(("TRR:OnStopRequest %p status %x mFailed %d\n", this, (int)aStatusCode,
        mFailed));
+  NotifyFollowers(followers, channel, NS_ERROR_UNKNOWN_HOST);
   FailData(NS_ERROR_UNKNOWN_HOST);
   return NS_OK;
 }
@@ -1275,6 +1325,12 @@ void TRR::Cancel() {
     if (UseDefaultServer()) {
       gTRRService->TRRIsOkay(TRRService::OKAY_TIMEOUT);
     }
+  } else if (gTRRService && gTRRService->DetachFromInFlightQuery(this)) {
+    // We were coalesced onto another in-flight request and have no channel
+    // of our own to cancel.
+    LOG(("TRR: %p canceling coalesced request %s %d\n", this, mHost.get(),
+         mType));
+    FailData(NS_ERROR_UNKNOWN_HOST);
   }
 }
 
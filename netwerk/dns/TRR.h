@@ -142,6 +142,11 @@ class TRR : public Runnable,
   RefPtr<nsHostRecord> mRec;
   RefPtr<AHostResolver> mHostResolver;
 
+  // Called on a follower that was coalesced onto another in-flight request
+  // for the identical DNS question. Copies the leader's raw response and
+  // completes the follower's own host record from it.
+  void ReceiveResponse(TRR* aLeader, nsIChannel* aChannel);
+
  private:
   ~TRR() = default;
   nsresult SendHTTPRequest();
@@ -167,6 +172,12 @@ class TRR : public Runnable,
 
   nsresult CreateChannelHelper(nsIURI* aUri, nsIChannel** aResult);
 
+  // Hand the outcome of this request to every coalesced follower; on success
+  // each follower gets a copy of the raw response, otherwise it is failed
+  // with aStatus.
+  void NotifyFollowers(nsTArray<RefPtr<TRR>>& aFollowers, nsIChannel* aChannel,
+                       nsresult aStatus);
+
   nsCOMPtr<nsIChannel> mChannel;
   enum TrrType mType;
   TimeStamp mStartTime;
@@ -184,6 +195,13 @@ class TRR : public Runnable,
 
   // keep a copy of the originSuffix for the cases where mRec == nullptr */
   const nsCString mOriginSuffix;
+
+  // Requests for the identical DNS question that arrived while this one was
+  // in flight. TRRService attaches them here (under its lock) and we hand
+  // them the response when the channel completes.
+  nsTArray<RefPtr<TRR>> mFollowers;
+
+  friend class TRRService;
 };
 
 }  // namespace net
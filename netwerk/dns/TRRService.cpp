@@ -451,6 +451,63 @@ bool TRRService::IsOnTRRThread() {
   return thread->IsOnCurrentThread();
 }
 
+// static
+void TRRService::InFlightQueryKey(TRR* aRequest, nsACString& aKey) {
+  aKey.Assign(aRequest->mHost);
+  aKey.Append('/');
+  aKey.AppendInt(static_cast<uint32_t>(aRequest->mType));
+  if (aRequest->mPB) {
+    aKey.AppendLiteral("/pb");
+  }
+}
+
+bool TRRService::AttachToInFlightQuery(TRR* aRequest) {
+  nsAutoCString key;
+  InFlightQueryKey(aRequest, key);
+  MutexAutoLock lock(mLock);
+  RefPtr<TRR> leader;
+  if (!mInFlightQueries.Get(key, getter_AddRefs(leader)) ||
+      leader == aRequest) {
+    return false;
+  }
+  leader->mFollowers.AppendElement(aRequest);
+  LOG(("TRRService::AttachToInFlightQuery %s: %p follows %p\n", key.get(),
+       aRequest, leader.get()));
+  return true;
+}
+
+void TRRService::AddInFlightQuery(TRR* aRequest) {
+  nsAutoCString key;
+  InFlightQueryKey(aRequest, key);
+  MutexAutoLock lock(mLock);
+  mInFlightQueries.Put(key, aRequest);
+}
+
+void TRRService::RemoveInFlightQuery(TRR* aRequest,
+                                     nsTArray<RefPtr<TRR>>& aFollowers) {
+  nsAutoCString key;
+  InFlightQueryKey(aRequest, key);
+  MutexAutoLock lock(mLock);
+  RefPtr<TRR> leader;
+  if (mInFlightQueries.Get(key, getter_AddRefs(leader)) &&
+      leader == aRequest) {
+    mInFlightQueries.Remove(key);
+  }
+  aFollowers.SwapElements(aRequest->mFollowers);
+}
+
+bool TRRService::DetachFromInFlightQuery(TRR* aRequest) {
+  nsAutoCString key;
+  InFlightQueryKey(aRequest, key);
+  MutexAutoLock lock(mLock);
+  RefPtr<TRR> leader;
+  if (!mInFlightQueries.Get(key, getter_AddRefs(leader)) ||
+      leader == aRequest) {
+    return false;
+  }
+  return leader->mFollowers.RemoveElement(aRequest);
+}
+
 NS_IMETHODIMP
 TRRService::Observe(nsISupports* aSubject, const char* aTopic,
                     const char16_t* aData) {
@@ -10,6 +10,7 @@
 #include "mozilla/DataStorage.h"
 #include "nsHostResolver.h"
 #include "nsIObserver.h"
+#include "nsRefPtrHashtable.h"
 #include "nsWeakReference.h"
 
 class nsDNSService;
@@ -71,6 +72,16 @@ class TRRService : public nsIObserver,
   already_AddRefed<nsIThread> TRRThread();
   bool IsOnTRRThread();
 
+  // Coalescing of duplicate in-flight DoH queries (A/AAAA against the
+  // default server). A query whose question is already on the wire attaches
+  // to the existing request as a follower instead of opening another
+  // channel; the leader hands every follower a copy of the raw response
+  // when its channel completes.
+  bool AttachToInFlightQuery(TRR* aRequest);
+  void AddInFlightQuery(TRR* aRequest);
+  void RemoveInFlightQuery(TRR* aRequest, nsTArray<RefPtr<TRR>>& aFollowers);
+  bool DetachFromInFlightQuery(TRR* aRequest);
+
  private:
   virtual ~TRRService();
   nsresult ReadPrefs(const char* name);
@@ -91,6 +102,8 @@ class TRRService : public nsIObserver,
   nsresult DispatchTRRRequestInternal(TRR* aTrrRequest, bool aWithLock);
   already_AddRefed<nsIThread> TRRThread_locked();
 
+  static void InFlightQueryKey(TRR* aRequest, nsACString& aKey);
+
   bool mInitialized;
   Atomic<uint32_t, Relaxed> mMode;
   Atomic<uint32_t, Relaxed> mTRRBlacklistExpireTime;
@@ -136,6 +149,10 @@ class TRRService : public nsIObserver,
     CONFIRM_OK = 2,
     CONFIRM_FAILED = 3
   };
+  // Leaders of in-flight DoH queries, keyed by name, type and private
+  // browsing status. Guarded by mLock.
+  nsRefPtrHashtable<nsCStringHashKey, TRR> mInFlightQueries;
+
   Atomic<ConfirmationState, Relaxed> mConfirmationState;
   RefPtr<TRR> mConfirmer;
   nsCOMPtr<nsITimer> mRetryConfirmTimer;
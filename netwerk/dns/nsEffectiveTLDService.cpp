@@ -14,7 +14,6 @@
 #include "mozilla/ResultExtensions.h"
 #include "mozilla/TextUtils.h"
 
-#include "MainThreadUtils.h"
 #include "nsCRT.h"
 #include "nsEffectiveTLDService.h"
 #include "nsIFile.h"
@@ -42,8 +41,13 @@ NS_IMPL_ISUPPORTS(nsEffectiveTLDService, nsIEffectiveTLDService,
 
 static nsEffectiveTLDService* gService = nullptr;
 
+thread_local nsEffectiveTLDService::ThreadLocalCache
+    nsEffectiveTLDService::sTldCache;
+
 nsEffectiveTLDService::nsEffectiveTLDService()
-    : mIDNService(), mGraphLock("nsEffectiveTLDService::mGraph") {
+    : mIDNService(),
+      mGraphLock("nsEffectiveTLDService::mGraph"),
+      mGeneration(0) {
   mGraph.emplace(etld_dafsa::kDafsa);
 }
 
@@ -83,7 +87,9 @@ NS_IMETHODIMP nsEffectiveTLDService::Observe(nsISupports* aSubject,
     mGraph.emplace(etld_dafsa::kDafsa);
 
     mDafsaMap.reset();
-    mMruTable.Clear();
+    // Invalidate the per-thread memoization caches; each thread drops its
+    // own cache the next time it consults it.
+    mGeneration++;
 
     MOZ_TRY(mDafsaMap.init(mDafsaBinFile));
 
@@ -251,11 +257,19 @@ nsresult nsEffectiveTLDService::GetBaseDomainInternal(nsCString& aHostname,
   if (aHostname.IsEmpty() || aHostname.Last() == '.')
     return NS_ERROR_INVALID_ARG;
 
-  // Lookup in the cache if this is a normal query. This is restricted to
-  // main thread-only as the cache is not thread-safe.
+  // Lookup in this thread's cache if this is a normal query.
   Maybe<TldCache::Entry> entry;
-  if (aAdditionalParts == 1 && NS_IsMainThread()) {
-    auto p = mMruTable.Lookup(aHostname);
+  if (aAdditionalParts == 1) {
+    ThreadLocalCache& cache = sTldCache;
+    uint32_t generation = mGeneration;
+    if (cache.mGeneration != generation) {
+      // The public suffix list was updated; drop results memoized against
+      // the old graph.
+      cache.mTable.Clear();
+      cache.mGeneration = generation;
+    }
+
+    auto p = cache.mTable.Lookup(aHostname);
     if (p) {
       if (NS_FAILED(p.Data().mResult)) {
         return p.Data().mResult;
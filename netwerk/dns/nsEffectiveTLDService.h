@@ -8,6 +8,7 @@
 
 #include "nsIEffectiveTLDService.h"
 
+#include "mozilla/Atomics.h"
 #include "mozilla/AutoMemMap.h"
 #include "mozilla/Attributes.h"
 #include "mozilla/Dafsa.h"
@@ -85,7 +86,21 @@ class nsEffectiveTLDService final : public nsIEffectiveTLDService,
     }
   };
 
-  TldCache mMruTable;
+  // The cache is kept per thread so that off-main-thread consumers (cookie
+  // and URL classification paths) get memoization without any locking. A
+  // thread's cache whose generation no longer matches mGeneration holds
+  // results computed against an outdated public suffix list and clears
+  // itself before its next use.
+  struct ThreadLocalCache {
+    TldCache mTable;
+    uint32_t mGeneration = 0;
+  };
+
+  static thread_local ThreadLocalCache sTldCache;
+
+  // Bumped whenever the public suffix list is updated, to invalidate the
+  // per-thread caches lazily.
+  mozilla::Atomic<uint32_t, mozilla::Relaxed> mGeneration;
 };
 
 #endif  // EffectiveTLDService_h
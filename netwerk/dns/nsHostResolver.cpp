@@ -52,6 +52,12 @@ using namespace mozilla::net;
 // constant always.
 static const unsigned int NEGATIVE_RECORD_LIFETIME = 60;
 
+// Sampled by the profiler and shown as a track, so that bursts of host
+// lookups can be spotted without a marker per resolution.
+PROFILER_DEFINE_COUNT_TOTAL(dnsResolutions, "DNS",
+                            "Number of host resolutions requested of "
+                            "nsHostResolver.")
+
 //----------------------------------------------------------------------------
 
 // Use a persistent thread pool in order to avoid spinning up new threads all
@@ -680,6 +686,10 @@ void nsHostResolver::FlushCache(bool aTrrToo) {
   MutexAutoLock lock(mLock);
   mEvictionQSize = 0;
 
+  // The network has changed; nothing previously resolved can be served
+  // from the fast path anymore.
+  PurgeHitCache();
+
   // Clear the evictionQ and remove all its corresponding entries from
   // the cache first
   if (!mEvictionQ.isEmpty()) {
@@ -743,6 +753,7 @@ void nsHostResolver::Shutdown() {
     }
     // empty host database
     mRecordDB.Clear();
+    PurgeHitCache();
 
     mNCS = nullptr;
   }
@@ -816,6 +827,8 @@ nsresult nsHostResolver::ResolveHost(const nsACString& aHost,
   nsAutoCString host(aHost);
   NS_ENSURE_TRUE(!host.IsEmpty(), NS_ERROR_UNEXPECTED);
 
+  AUTO_PROFILER_COUNT_TOTAL(dnsResolutions, 1);
+
   LOG(("Resolving host [%s]%s%s type %d. [this=%p]\n", host.get(),
        flags & RES_BYPASS_CACHE ? " - bypassing cache" : "",
        flags & RES_REFRESH_CACHE ? " - refresh cache" : "", type, this));
@@ -843,7 +856,40 @@ nsresult nsHostResolver::ResolveHost(const nsACString& aHost,
   }
   memset(&tempAddr, 0, sizeof(PRNetAddr));
 
+  nsAutoCString originSuffix;
+  aOriginAttributes.CreateSuffix(originSuffix);
+
+  if (gTRRService && gTRRService->IsExcludedFromTRR(host)) {
+    flags |= RES_DISABLE_TRR;
+
+    if (!aTrrServer.IsEmpty()) {
+      return NS_ERROR_UNKNOWN_HOST;
+    }
+  }
+
+  nsHostKey key(host, aTrrServer, type, flags, af,
+                (aOriginAttributes.mPrivateBrowsingId > 0), originSuffix);
+
   RefPtr<nsResolveHostCallback> callback(aCallback);
+
+  if (flags & (RES_BYPASS_CACHE | RES_REFRESH_CACHE)) {
+    // The record is about to be re-resolved or ignored; don't let the hit
+    // cache serve its current result to anybody in the meantime.
+    RemoveFromHitCache(key);
+  } else {
+    // Fast path: a fully valid positive result can be served from the hit
+    // cache without contending on mLock at all.
+    RefPtr<nsHostRecord> cached = LookupHitCache(key, TimeStamp::NowLoRes());
+    if (cached) {
+      LOG(("  Using hit cache for host [%s].\n", host.get()));
+      if (IS_ADDR_TYPE(type)) {
+        Telemetry::Accumulate(Telemetry::DNS_LOOKUP_METHOD2, METHOD_HIT);
+      }
+      callback->OnResolveHostComplete(this, cached, NS_OK);
+      return NS_OK;
+    }
+  }
+
   // if result is set inside the lock, then we need to issue the
   // callback before returning.
   RefPtr<nsHostRecord> result;
@@ -860,19 +906,6 @@ nsresult nsHostResolver::ResolveHost(const nsACString& aHost,
       // any pending callbacks, then add to pending callbacks queue,
       // and return.  otherwise, add ourselves as first pending
       // callback, and proceed to do the lookup.
-      nsAutoCString originSuffix;
-      aOriginAttributes.CreateSuffix(originSuffix);
-
-      if (gTRRService && gTRRService->IsExcludedFromTRR(host)) {
-        flags |= RES_DISABLE_TRR;
-
-        if (!aTrrServer.IsEmpty()) {
-          return NS_ERROR_UNKNOWN_HOST;
-        }
-      }
-
-      nsHostKey key(host, aTrrServer, type, flags, af,
-                    (aOriginAttributes.mPrivateBrowsingId > 0), originSuffix);
       RefPtr<nsHostRecord>& entry = mRecordDB.GetOrInsert(key);
       if (!entry) {
         if (IS_ADDR_TYPE(type)) {
@@ -903,6 +936,9 @@ nsresult nsHostResolver::ResolveHost(const nsACString& aHost,
         // lookup in the background
         ConditionallyRefreshRecord(rec, host);
 
+        // Let later lookups of this key take the lock-free fast path.
+        UpdateHitCache(rec);
+
         if (rec->negative) {
           LOG(("  Negative cache entry for host [%s].\n", host.get()));
           if (IS_ADDR_TYPE(type)) {
@@ -1695,6 +1731,7 @@ void nsHostResolver::AddToEvictionQ(nsHostRecord* rec) {
     // remove first element on mEvictionQ
     RefPtr<nsHostRecord> head = mEvictionQ.popFirst();
     mRecordDB.Remove(*static_cast<nsHostKey*>(head.get()));
+    RemoveFromHitCache(*static_cast<nsHostKey*>(head.get()));
 
     if (!head->negative) {
       // record the age of the entry upon eviction.
@@ -1720,6 +1757,60 @@ void nsHostResolver::AddToEvictionQ(nsHostRecord* rec) {
   }
 }
 
+already_AddRefed<nsHostRecord> nsHostResolver::LookupHitCache(
+    const nsHostKey& key, const TimeStamp& now) {
+  HitCacheShard& shard = HitCacheShardFor(key);
+  MutexAutoLock lock(shard.mLock);
+
+  HitCacheEntry entry;
+  if (!shard.mTable.Get(key, &entry)) {
+    return nullptr;
+  }
+
+  if (now >= entry.mGraceStart) {
+    // The record needs a refreshing lookup; let the slow path handle it.
+    shard.mTable.Remove(key);
+    return nullptr;
+  }
+
+  return entry.mRec.forget();
+}
+
+void nsHostResolver::UpdateHitCache(nsHostRecord* rec) {
+  mLock.AssertCurrentThreadOwns();
+
+  const nsHostKey& key = *static_cast<nsHostKey*>(rec);
+
+  TimeStamp now = TimeStamp::NowLoRes();
+  if (rec->negative || rec->mDoomed || rec->mGraceStart.IsNull() ||
+      !rec->HasUsableResult(now) ||
+      rec->CheckExpiration(now) != nsHostRecord::EXP_VALID) {
+    RemoveFromHitCache(key);
+    return;
+  }
+
+  HitCacheEntry entry;
+  entry.mRec = rec;
+  entry.mGraceStart = rec->mGraceStart;
+
+  HitCacheShard& shard = HitCacheShardFor(key);
+  MutexAutoLock lock(shard.mLock);
+  shard.mTable.Put(key, entry);
+}
+
+void nsHostResolver::RemoveFromHitCache(const nsHostKey& key) {
+  HitCacheShard& shard = HitCacheShardFor(key);
+  MutexAutoLock lock(shard.mLock);
+  shard.mTable.Remove(key);
+}
+
+void nsHostResolver::PurgeHitCache() {
+  for (auto& shard : mHitCache) {
+    MutexAutoLock lock(shard.mLock);
+    shard.mTable.Clear();
+  }
+}
+
 //
 // CompleteLookup() checks if the resolving should be redone and if so it
 // returns LOOKUP_RESOLVEAGAIN, but only if 'status' is not NS_ERROR_ABORT.
@@ -1894,6 +1985,10 @@ nsHostResolver::LookupStatus nsHostResolver::CompleteLookup(
     PrepareRecordExpirationAddrRecord(addrRec);
   }
 
+  // Reflect the record's new state in the hit cache so subsequent lookups
+  // of this key can be answered without taking mLock.
+  UpdateHitCache(rec);
+
   bool doCallbacks = true;
 
   if (trrResult && addrRec->mDidCallbacks) {
@@ -2004,6 +2099,8 @@ nsHostResolver::LookupStatus nsHostResolver::CompleteLookupByType(
                           duration);
   }
 
+  UpdateHitCache(rec);
+
   mozilla::LinkedList<RefPtr<nsResolveHostCallback>> cbs =
       std::move(typeRec->mCallbacks);
 
@@ -2052,6 +2149,7 @@ void nsHostResolver::CancelAsyncRequest(
     // If there are no more callbacks, remove the hash table entry
     if (recPtr && recPtr->mCallbacks.isEmpty()) {
       mRecordDB.Remove(*static_cast<nsHostKey*>(recPtr));
+      RemoveFromHitCache(*static_cast<nsHostKey*>(recPtr));
       // If record is on a Queue, remove it and then deref it
       if (recPtr->isInList()) {
         recPtr->remove();
@@ -2071,10 +2169,15 @@ size_t nsHostResolver::SizeOfIncludingThis(MallocSizeOf mallocSizeOf) const {
     n += entry->SizeOfIncludingThis(mallocSizeOf);
   }
 
+  for (const auto& shard : mHitCache) {
+    MutexAutoLock shardLock(shard.mLock);
+    n += shard.mTable.ShallowSizeOfExcludingThis(mallocSizeOf);
+  }
+
   // The following fields aren't measured.
-  // - mHighQ, mMediumQ, mLowQ, mEvictionQ, because they just point to
-  //   nsHostRecords that also pointed to by entries |mRecordDB|, and
-  //   measured when |mRecordDB| is measured.
+  // - mHighQ, mMediumQ, mLowQ, mEvictionQ and the records referenced from
+  //   mHitCache, because they just point to nsHostRecords that also pointed
+  //   to by entries |mRecordDB|, and measured when |mRecordDB| is measured.
 
   return n;
 }
@@ -22,6 +22,7 @@
 #include "mozilla/LinkedList.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtr.h"
+#include "nsDataHashtable.h"
 #include "nsRefPtrHashtable.h"
 #include "nsIThreadPool.h"
 #include "mozilla/net/NetworkConnectivityService.h"
@@ -541,6 +542,28 @@ class nsHostResolver : public nsISupports, public AHostResolver {
 
   void AddToEvictionQ(nsHostRecord* rec);
 
+  // The hit cache is a small sharded index in front of mRecordDB holding
+  // records with a currently valid positive result. ResolveHost() answers
+  // plain cache hits from it under a per-shard lock, without contending on
+  // mLock which serializes every lookup against every lookup completion.
+  // Each shard entry carries a snapshot of the record's grace-period start
+  // taken under mLock when the result was stored, so the fast path never
+  // reads record fields that are written under mLock. Records in their
+  // grace period and negative entries always take the slow path because
+  // they need a background refresh, and every operation that removes
+  // records from mRecordDB also removes them from (or purges) the hit
+  // cache.
+
+  // Returns the record for |key| if it holds a positive result that is
+  // still fully valid (not yet in its grace period), otherwise null.
+  already_AddRefed<nsHostRecord> LookupHitCache(
+      const nsHostKey& key, const mozilla::TimeStamp& now);
+  // Inserts, updates or removes |rec| according to its current state.
+  // The caller must hold mLock so the snapshot is consistent.
+  void UpdateHitCache(nsHostRecord* rec);
+  void RemoveFromHitCache(const nsHostKey& key);
+  void PurgeHitCache();
+
   void ThreadFunc();
 
   enum {
@@ -559,6 +582,24 @@ class nsHostResolver : public nsISupports, public AHostResolver {
   mutable Mutex mLock;  // mutable so SizeOfIncludingThis can be const
   CondVar mIdleTaskCV;
   nsRefPtrHashtable<nsGenericHashKey<nsHostKey>, nsHostRecord> mRecordDB;
+
+  static const size_t kHitCacheShardCount = 8;  // must be a power of two
+  struct HitCacheEntry {
+    RefPtr<nsHostRecord> mRec;
+    // When the record enters its grace period; the entry is only served
+    // before this point.
+    mozilla::TimeStamp mGraceStart;
+  };
+  struct HitCacheShard {
+    HitCacheShard() : mLock("nsHostResolver.mHitCache") {}
+    mutable Mutex mLock;
+    nsDataHashtable<nsGenericHashKey<nsHostKey>, HitCacheEntry> mTable;
+  };
+  mutable HitCacheShard mHitCache[kHitCacheShardCount];
+
+  HitCacheShard& HitCacheShardFor(const nsHostKey& key) const {
+    return mHitCache[key.Hash() & (kHitCacheShardCount - 1)];
+  }
   mozilla::LinkedList<RefPtr<nsHostRecord>> mHighQ;
   mozilla::LinkedList<RefPtr<nsHostRecord>> mMediumQ;
   mozilla::LinkedList<RefPtr<nsHostRecord>> mLowQ;
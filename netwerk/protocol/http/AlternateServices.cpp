@@ -1238,6 +1238,14 @@ AltSvcOverride::GetAllow1918(bool* allow) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+AltSvcOverride::GetKeepWarm(bool* keepWarm) {
+  // alt-svc validation connects are one-shot, there is no reason
+  // to keep connections to the mapped origin warm.
+  *keepWarm = false;
+  return NS_OK;
+}
+
 NS_IMPL_ISUPPORTS(AltSvcOverride, nsIInterfaceRequestor,
                   nsISpeculativeConnectionOverrider)
 
@@ -1043,6 +1043,31 @@ nsresult Http2Decompressor::DoContextUpdate() {
 
 /////////////////////////////////////////////////////////////////
 
+// The cache key has to cover everything that feeds the encoder. The
+// pseudo-header values cannot contain a newline, so it works as a separator;
+// nvInput goes last and wholesale.
+static void BuildHeaderBlockCacheKey(const nsCString& nvInput,
+                                     const nsACString& method,
+                                     const nsACString& path,
+                                     const nsACString& host,
+                                     const nsACString& scheme,
+                                     const nsACString& protocol,
+                                     bool simpleConnectForm, nsACString& key) {
+  key.Truncate();
+  key.Append(simpleConnectForm ? 'c' : 'h');
+  key.Append(method);
+  key.Append('\n');
+  key.Append(path);
+  key.Append('\n');
+  key.Append(host);
+  key.Append('\n');
+  key.Append(scheme);
+  key.Append('\n');
+  key.Append(protocol);
+  key.Append('\n');
+  key.Append(nvInput);
+}
+
 nsresult Http2Compressor::EncodeHeaderBlock(
     const nsCString& nvInput, const nsACString& method, const nsACString& path,
     const nsACString& host, const nsACString& scheme,
@@ -1052,6 +1077,24 @@ nsresult Http2Compressor::EncodeHeaderBlock(
   output.Truncate();
   mParsedContentLength = -1;
 
+  nsAutoCString cacheKey;
+  BuildHeaderBlockCacheKey(nvInput, method, path, host, scheme, protocol,
+                           simpleConnectForm, cacheKey);
+  if (!mBufferSizeChangeWaiting) {
+    CachedHeaderBlock cached;
+    if (mEncodedBlockCache.Get(cacheKey, &cached)) {
+      // Only blocks whose encoding did not touch the dynamic table are
+      // cached, so replaying the bytes keeps the decompressor in sync.
+      LOG(("Http2Compressor::EncodeHeaderBlock %p replaying %u cached bytes",
+           this, cached.mBlock.Length()));
+      output.Append(cached.mBlock);
+      mParsedContentLength = cached.mParsedContentLength;
+      mOutput = nullptr;
+      return NS_OK;
+    }
+  }
+  mTableStateChanged = false;
+
   bool isWebsocket = (!simpleConnectForm && !protocol.IsEmpty());
 
   // first thing's first - context size updates (if necessary)
@@ -1180,6 +1223,19 @@ nsresult Http2Compressor::EncodeHeaderBlock(
     ProcessHeader(nvPair(te, trailers), false, false);
   }
 
+  if (mTableStateChanged) {
+    // Everything cached was encoded against the previous table state.
+    mEncodedBlockCache.Clear();
+  } else {
+    if (mEncodedBlockCache.Count() >= kMaxCachedHeaderBlocks) {
+      mEncodedBlockCache.Clear();
+    }
+    CachedHeaderBlock cached;
+    cached.mBlock = output;
+    cached.mParsedContentLength = mParsedContentLength;
+    mEncodedBlockCache.Put(cacheKey, cached);
+  }
+
   mOutput = nullptr;
   DumpState("Compressor state after EncodeHeaderBlock");
   return NS_OK;
@@ -1410,6 +1466,7 @@ void Http2Compressor::ProcessHeader(const nvPair inputPair, bool noLocalIndex,
 
     // make sure to makeroom() first so that any implied items
     // get preserved.
+    mTableStateChanged = true;
     MakeRoom(newSize, "compressor");
     DoOutput(kIndexedLiteral, &inputPair, nameReference);
 
@@ -1426,6 +1483,7 @@ void Http2Compressor::ProcessHeader(const nvPair inputPair, bool noLocalIndex,
 }
 
 void Http2Compressor::EncodeTableSizeChange(uint32_t newMaxSize) {
+  mTableStateChanged = true;
   uint32_t offset = mOutput->Length();
   EncodeInteger(5, newMaxSize);
   uint8_t* startByte =
@@ -1433,6 +1491,13 @@ void Http2Compressor::EncodeTableSizeChange(uint32_t newMaxSize) {
   *startByte = *startByte | 0x20;
 }
 
+void Http2Compressor::SetMaxBufferSizeInternal(uint32_t maxBufferSize) {
+  // Changing the table size both evicts entries and changes future indexing
+  // decisions, so every cached block is stale.
+  mEncodedBlockCache.Clear();
+  Http2BaseCompressor::SetMaxBufferSizeInternal(maxBufferSize);
+}
+
 void Http2Compressor::SetMaxBufferSize(uint32_t maxBufferSize) {
   mMaxBufferSetting = maxBufferSize;
   SetMaxBufferSizeInternal(maxBufferSize);
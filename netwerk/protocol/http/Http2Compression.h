@@ -10,6 +10,7 @@
 // https://www.rfc-editor.org/rfc/rfc7541.txt
 
 #include "mozilla/Attributes.h"
+#include "nsDataHashtable.h"
 #include "nsDeque.h"
 #include "nsString.h"
 #include "mozilla/Telemetry.h"
@@ -159,7 +160,8 @@ class Http2Compressor final : public Http2BaseCompressor {
   Http2Compressor()
       : mParsedContentLength(-1),
         mBufferSizeChangeWaiting(false),
-        mLowestBufferSizeWaiting(0) {
+        mLowestBufferSizeWaiting(0),
+        mTableStateChanged(false) {
     mPeakSizeID = Telemetry::HPACK_PEAK_SIZE_COMPRESSOR;
     mPeakCountID = Telemetry::HPACK_PEAK_COUNT_COMPRESSOR;
   };
@@ -193,10 +195,30 @@ class Http2Compressor final : public Http2BaseCompressor {
                      bool neverIndex);
   void HuffmanAppend(const nsCString& value);
   void EncodeTableSizeChange(uint32_t newMaxSize);
+  void SetMaxBufferSizeInternal(uint32_t maxBufferSize) override;
+
+  // Multiplexed sessions see the same header set over and over, and in the
+  // steady state encoding one is pure output: every header either hits the
+  // header table or is a literal that doesn't get indexed. Blocks whose
+  // encoding left the table untouched are cached keyed on the full input so
+  // an identical set replays the bytes instead of re-encoding them. Any
+  // change to the table state (insertion, eviction or size update)
+  // invalidates the whole cache.
+  struct CachedHeaderBlock {
+    nsCString mBlock;
+    int64_t mParsedContentLength = -1;
+  };
+
+  const static uint32_t kMaxCachedHeaderBlocks = 32;
 
   int64_t mParsedContentLength;
   bool mBufferSizeChangeWaiting;
   uint32_t mLowestBufferSizeWaiting;
+
+  // true when the current EncodeHeaderBlock() call has modified the dynamic
+  // table state.
+  bool mTableStateChanged;
+  nsDataHashtable<nsCStringHashKey, CachedHeaderBlock> mEncodedBlockCache;
 };
 
 }  // namespace net
@@ -51,7 +51,9 @@ class HttpConnectionMgrShell : public nsISupports {
     THROTTLING_READ_INTERVAL,
     THROTTLING_HOLD_TIME,
     THROTTLING_MAX_TIME,
-    PROXY_BE_CONSERVATIVE
+    PROXY_BE_CONSERVATIVE,
+    THROTTLING_BG_DISPATCH_RATE,
+    THROTTLING_BG_DISPATCH_BURST
   };
 
   MOZ_MUST_USE virtual nsresult Init(
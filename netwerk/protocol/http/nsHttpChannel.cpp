@@ -151,6 +151,7 @@ static uint32_t sRCWNQueueSizePriority = 10;
 static uint32_t sRCWNSmallResourceSizeKB = 256;
 static uint32_t sRCWNMinWaitMs = 0;
 static uint32_t sRCWNMaxWaitMs = 500;
+static uint32_t sRCWNSlowOpenThresholdMs = 250;
 
 // True if the local cache should be bypassed when processing a request.
 #define BYPASS_LOCAL_CACHE(loadFlags, isPreferCacheLoadOverBypass) \
@@ -388,6 +389,8 @@ nsHttpChannel::nsHttpChannel()
       mUsedNetwork(0),
       mAuthConnectionRestartable(0),
       mChannelClassifierCancellationPending(0),
+      mProxyResolvePendingForConnect(0),
+      mClassificationPendingForConnect(0),
       mAsyncResumePending(0),
       mHasBeenIsolatedChecked(0),
       mIsIsolated(0),
@@ -6531,6 +6534,8 @@ nsHttpChannel::AsyncOpen(nsIStreamListener* aListener) {
                                  "network.http.rcwn.min_wait_before_racing_ms");
     Preferences::AddUintVarCache(&sRCWNMaxWaitMs,
                                  "network.http.rcwn.max_wait_before_racing_ms");
+    Preferences::AddUintVarCache(&sRCWNSlowOpenThresholdMs,
+                                 "network.http.rcwn.slow_open_threshold_ms");
   }
 
   rv = NS_CheckPortSafety(mURI);
@@ -6625,14 +6630,27 @@ nsresult nsHttpChannel::AsyncOpenFinal(TimeStamp aTimeStamp) {
     return MaybeResolveProxyAndBeginConnect();
   }
 
-  // We are about to do an async lookup to check if the URI is a tracker. If
-  // yes, this channel will be canceled by channel classifier.  Chances are the
-  // lookup is not needed so CheckIsTrackerWithLocalTable() will return an
-  // error and then we can MaybeResolveProxyAndBeginConnect() right away.
+  // We are about to do an async lookup to check if the URI is a tracker.
+  // Kick off proxy resolution right away so the PAC/pref lookup runs
+  // concurrently with the classifier lookup instead of queuing behind it;
+  // BeginConnect() runs once both legs have finished (see
+  // ContinueBeginConnectAfterOpenJoin).
+  if (!mProxyInfo &&
+      !(mLoadFlags & (LOAD_ONLY_FROM_CACHE | LOAD_NO_NETWORK_IO)) &&
+      NS_SUCCEEDED(ResolveProxy())) {
+    mProxyResolvePendingForConnect = 1;
+  }
+  mClassificationPendingForConnect = 1;
+
+  // If the URI is a tracker, this channel will be canceled by channel
+  // classifier.  Chances are the lookup is not needed so
+  // CheckIsTrackerWithLocalTable() will return an error and then we can join
+  // right away.
   RefPtr<nsHttpChannel> self = this;
   bool willCallback = NS_SUCCEEDED(
       AsyncUrlChannelClassifier::CheckChannel(this, [self]() -> void {
-        nsresult rv = self->MaybeResolveProxyAndBeginConnect();
+        self->mClassificationPendingForConnect = 0;
+        nsresult rv = self->ContinueBeginConnectAfterOpenJoin();
         if (NS_FAILED(rv)) {
           // Since this error is thrown asynchronously so that the caller
           // of BeginConnect() will not do clean up for us. We have to do
@@ -6643,16 +6661,32 @@ nsresult nsHttpChannel::AsyncOpenFinal(TimeStamp aTimeStamp) {
       }));
 
   if (!willCallback) {
-    // We can do MaybeResolveProxyAndBeginConnect immediately if
-    // CheckIsTrackerWithLocalTable is failed. Note that we don't need to
-    // handle the failure because BeginConnect() will return synchronously and
-    // the caller will be responsible for handling it.
-    return MaybeResolveProxyAndBeginConnect();
+    // CheckIsTrackerWithLocalTable failed, so only the proxy leg remains.
+    mClassificationPendingForConnect = 0;
+    nsresult rv = ContinueBeginConnectAfterOpenJoin();
+    if (NS_FAILED(rv)) {
+      CloseCacheEntry(false);
+      Unused << AsyncAbort(rv);
+    }
   }
 
   return NS_OK;
 }
 
+nsresult nsHttpChannel::ContinueBeginConnectAfterOpenJoin() {
+  if (mProxyResolvePendingForConnect || mClassificationPendingForConnect) {
+    LOG(
+        ("nsHttpChannel::ContinueBeginConnectAfterOpenJoin [this=%p] "
+         "waiting for %s",
+         this,
+         mProxyResolvePendingForConnect ? "proxy resolution"
+                                        : "classification"));
+    return NS_OK;
+  }
+
+  return BeginConnect();
+}
+
 nsresult nsHttpChannel::MaybeResolveProxyAndBeginConnect() {
   nsresult rv;
 
@@ -6712,9 +6746,9 @@ uint16_t nsHttpChannel::GetProxyDNSStrategy() {
 }
 
 // BeginConnect() SHOULD NOT call AsyncAbort(). AsyncAbort will be called by
-// functions that called BeginConnect if needed. Only AsyncOpenFinal,
-// MaybeResolveProxyAndBeginConnect and OnProxyAvailable ever call
-// BeginConnect.
+// functions that called BeginConnect if needed. Only
+// MaybeResolveProxyAndBeginConnect and ContinueBeginConnectAfterOpenJoin
+// (reached from AsyncOpenFinal and OnProxyAvailable) ever call BeginConnect.
 nsresult nsHttpChannel::BeginConnect() {
   LOG(("nsHttpChannel::BeginConnect [this=%p]\n", this));
   nsresult rv;
@@ -7225,6 +7259,8 @@ nsHttpChannel::OnProxyAvailable(nsICancelable* request, nsIChannel* channel,
 
   if (NS_SUCCEEDED(status)) mProxyInfo = pi;
 
+  mProxyResolvePendingForConnect = 0;
+
   if (!gHttpHandler->Active()) {
     LOG(
         ("nsHttpChannel::OnProxyAvailable [this=%p] "
@@ -7232,7 +7268,7 @@ nsHttpChannel::OnProxyAvailable(nsICancelable* request, nsIChannel* channel,
          this));
     rv = NS_ERROR_NOT_AVAILABLE;
   } else {
-    rv = BeginConnect();
+    rv = ContinueBeginConnectAfterOpenJoin();
   }
 
   if (NS_FAILED(rv)) {
@@ -10255,6 +10291,15 @@ nsresult nsHttpChannel::MaybeRaceCacheWithNetwork() {
   if (CacheFileUtils::CachePerfStats::IsCacheSlow()) {
     // If the cache is slow, trigger the network request immediately.
     mRaceDelay = 0;
+  } else if (sRCWNSlowOpenThresholdMs &&
+             CacheFileUtils::CachePerfStats::GetPercentile(
+                 CacheFileUtils::CachePerfStats::ENTRY_OPEN, 80) >
+                 sRCWNSlowOpenThresholdMs * 1000) {
+    // The tail of the recent entry open times is worse than what we expect
+    // from the network, e.g. because a spinning disk is under I/O pressure.
+    // The average based headstart below reacts too slowly to this, because
+    // most opens are still fast, so skip the headstart entirely.
+    mRaceDelay = 0;
   } else {
     // Give cache a headstart of 3 times the average cache entry open time.
     mRaceDelay = CacheFileUtils::CachePerfStats::GetAverage(
@@ -311,6 +311,11 @@ class nsHttpChannel final : public HttpBaseChannel,
   nsresult MaybeResolveProxyAndBeginConnect();
   nsresult MaybeStartDNSPrefetch();
 
+  // Joins the two legs AsyncOpenFinal runs concurrently - proxy resolution
+  // and the URL classifier lookup. Calls BeginConnect() once neither leg is
+  // outstanding anymore; until then it's a no-op.
+  nsresult ContinueBeginConnectAfterOpenJoin();
+
   // Tells the channel to resolve the origin of the end server we are connecting
   // to.
   static uint16_t const DNS_PREFETCH_ORIGIN = 1 << 0;
@@ -730,6 +735,13 @@ class nsHttpChannel final : public HttpBaseChannel,
   // process hasn't finished yet.
   uint32_t mChannelClassifierCancellationPending : 1;
 
+  // True while the respective leg of the pipelined AsyncOpenFinal - proxy
+  // resolution resp. the URL classifier lookup - is still outstanding and
+  // BeginConnect() has to wait for it, see
+  // ContinueBeginConnectAfterOpenJoin().
+  uint32_t mProxyResolvePendingForConnect : 1;
+  uint32_t mClassificationPendingForConnect : 1;
+
   // True only when we are between Resume and async fire of mCallOnResume.
   // Used to suspend any newly created pumps in mCallOnResume handler.
   uint32_t mAsyncResumePending : 1;
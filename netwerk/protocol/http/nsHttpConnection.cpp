@@ -48,6 +48,12 @@
 namespace mozilla {
 namespace net {
 
+// Maximum number of bytes requested from the transaction per read segment.
+// Sized to a full TLS plaintext record (2^14) so that the buffered plaintext
+// of one record is drained with a single PR_Read() through the socket and
+// NSS layers instead of several gDefaultSegmentSize sized traversals.
+static const uint32_t kTLSRecordReadSize = 1 << 14;
+
 //-----------------------------------------------------------------------------
 // nsHttpConnection <public>
 //-----------------------------------------------------------------------------
@@ -2149,7 +2155,8 @@ nsresult nsHttpConnection::OnSocketReadable() {
 
     mSocketInCondition = NS_OK;
     rv = mTransaction->WriteSegmentsAgain(
-        this, nsIOService::gDefaultSegmentSize, &n, &again);
+        this, std::max(nsIOService::gDefaultSegmentSize, kTLSRecordReadSize),
+        &n, &again);
     LOG(("nsHttpConnection::OnSocketReadable %p trans->ws rv=%" PRIx32
          " n=%d socketin=%" PRIx32 "\n",
          this, static_cast<uint32_t>(rv), n,
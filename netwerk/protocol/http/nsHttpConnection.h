@@ -124,6 +124,15 @@ class nsHttpConnection final : public HttpConnectionBase,
   void BeginIdleMonitoring();
   void EndIdleMonitoring();
 
+  // Called by the connection manager for idle connections it wants to keep
+  // warm past the regular idle timeout. A server that closes the connection
+  // earlier is still detected by CanReuse()'s liveness check before reuse.
+  void ExtendIdleTimeout(PRIntervalTime timeout) {
+    if (mIdleTimeout < timeout) {
+      mIdleTimeout = timeout;
+    }
+  }
+
   bool UsingSpdy() override { return (mUsingSpdyVersion != SpdyVersion::NONE); }
   SpdyVersion GetSpdyVersion() { return mUsingSpdyVersion; }
   bool EverUsedSpdy() { return mEverUsedSpdy; }
@@ -15,9 +15,12 @@
 #include <algorithm>
 #include <utility>
 
+#include "GeckoProfiler.h"
 #include "NullHttpTransaction.h"
 #include "mozilla/ChaosMode.h"
+#include "mozilla/DataStorage.h"
 #include "mozilla/Services.h"
+#include "mozilla/SyncRunnable.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/Unused.h"
 #include "mozilla/net/DNS.h"
@@ -34,6 +37,7 @@
 #include "nsITransport.h"
 #include "nsIXPConnect.h"
 #include "nsInterfaceRequestorAgg.h"
+#include "nsAlgorithm.h"
 #include "nsNetCID.h"
 #include "nsNetUtil.h"
 #include "nsQueryObject.h"
@@ -47,6 +51,23 @@ namespace net {
 
 NS_IMPL_ISUPPORTS(nsHttpConnectionMgr, nsIObserver)
 
+// Entries flagged by the predictor's keepWarm override keep up to this many
+// idle connections warm by extending their idle timeout to the given number
+// of seconds.
+static const uint32_t kKeepWarmIdleConnLimit = 2;
+static const uint32_t kKeepWarmIdleTimeout = 60;  // in seconds
+
+// Connection racing ("happy eyeballs") outcome counters. These show up as
+// counter tracks in profiles, making it easy to see how often the backup
+// timer fires on a given network and which socket ends up carrying the
+// transaction. They compile away without MOZ_GECKO_PROFILER.
+PROFILER_DEFINE_COUNT_TOTAL(backupConnStarted, "Connections",
+                            "Backup (happy eyeballs) sockets started");
+PROFILER_DEFINE_COUNT_TOTAL(primaryConnWon, "Connections",
+                            "Races won by the primary socket");
+PROFILER_DEFINE_COUNT_TOTAL(backupConnWon, "Connections",
+                            "Races won by the backup socket");
+
 // This function decides the transaction's order in the pending queue.
 // Given two transactions t1 and t2, returning true means that t2 is
 // more important than t1 and thus should be dispatched first.
@@ -136,10 +157,13 @@ nsHttpConnectionMgr::nsHttpConnectionMgr()
       mPruningNoTraffic(false),
       mTimeoutTickArmed(false),
       mTimeoutTickNext(1),
+      mRttStorageInitTried(false),
       mCurrentTopLevelOuterContentWindowId(0),
       mThrottlingInhibitsReading(false),
       mActiveTabTransactionsExist(false),
-      mActiveTabUnthrottledTransactionsExist(false) {
+      mActiveTabUnthrottledTransactionsExist(false),
+      mBackgroundDispatchRate(0),
+      mBackgroundDispatchBurst(0) {
   LOG(("Creating nsHttpConnectionMgr @%p\n", this));
 }
 
@@ -356,6 +380,10 @@ nsHttpConnectionMgr::Observe(nsISupports* subject, const char* topic,
       ThrottlerTick();
     } else if (timer == mDelayedResumeReadTimer) {
       ResumeBackgroundThrottledTransactions();
+    } else if (timer == mBackgroundDispatchTimer) {
+      mBackgroundDispatchTimer = nullptr;
+      // Buckets have replenished in the meantime; retry everything queued.
+      OnMsgProcessPendingQ(0, nullptr);
     } else {
       MOZ_ASSERT(false, "unexpected timer-callback");
       LOG(("Unexpected timer object\n"));
@@ -468,7 +496,8 @@ class SpeculativeConnectArgs : public ARefBase {
       : mParallelSpeculativeConnectLimit(0),
         mIgnoreIdle(false),
         mIsFromPredictor(false),
-        mAllow1918(false) {
+        mAllow1918(false),
+        mKeepWarm(false) {
     mOverridesOK = false;
   }
   NS_INLINE_DECL_THREADSAFE_REFCOUNTING(SpeculativeConnectArgs, override)
@@ -481,6 +510,7 @@ class SpeculativeConnectArgs : public ARefBase {
   bool mIgnoreIdle;
   bool mIsFromPredictor;
   bool mAllow1918;
+  bool mKeepWarm;
 
  private:
   virtual ~SpeculativeConnectArgs() = default;
@@ -534,6 +564,7 @@ nsresult nsHttpConnectionMgr::SpeculativeConnect(
     args->mIgnoreIdle = overrider->GetIgnoreIdle();
     args->mIsFromPredictor = overrider->GetIsFromPredictor();
     args->mAllow1918 = overrider->GetAllow1918();
+    args->mKeepWarm = overrider->GetKeepWarm();
   }
 
   return PostEvent(&nsHttpConnectionMgr::OnMsgSpeculativeConnect, 0, args);
@@ -1564,6 +1595,15 @@ nsresult nsHttpConnectionMgr::TryDispatchTransaction(
   //     global limits
   // 6 - no connection is available - queue it
 
+  // Rate shaping of background tab groups happens before any dispatch path
+  // (including reuse of an existing h2/h3 session): a background tab bursting
+  // beacons or analytics must not crowd out the foreground no matter how the
+  // requests would be carried.  Refused transactions simply stay queued.
+  if (!AllowBackgroundTabDispatch(trans)) {
+    LOG(("   blocked by background tab group shaping trans=%p\n", trans));
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+
   RefPtr<HttpConnectionBase> unusedSpdyPersistentConnection;
 
   // step 0
@@ -2377,6 +2417,10 @@ void nsHttpConnectionMgr::OnMsgShutdown(int32_t, ARefBase* param) {
     mTrafficTimer->Cancel();
     mTrafficTimer = nullptr;
   }
+  if (mBackgroundDispatchTimer) {
+    mBackgroundDispatchTimer->Cancel();
+    mBackgroundDispatchTimer = nullptr;
+  }
   DestroyThrottleTicker();
 
   mCoalescingHash.Clear();
@@ -2939,6 +2983,13 @@ void nsHttpConnectionMgr::OnMsgReclaimConnection(HttpConnectionBase* conn) {
     mNumIdleConns++;
     connTCP->BeginIdleMonitoring();
 
+    // The predictor is confident this origin is used again soon, so let a
+    // few idle connections outlive the regular idle timeout. Idle
+    // monitoring still drops them if the server closes earlier.
+    if (ent->mKeepWarm && idx < kKeepWarmIdleConnLimit) {
+      connTCP->ExtendIdleTimeout(PR_SecondsToInterval(kKeepWarmIdleTimeout));
+    }
+
     // If the added connection was first idle connection or has shortest
     // time to live among the watched connections, pruning dead
     // connections needs to be done when it can't be reused anymore.
@@ -3068,6 +3119,12 @@ void nsHttpConnectionMgr::OnMsgUpdateParam(int32_t inParam, ARefBase*) {
     case PROXY_BE_CONSERVATIVE:
       mBeConservativeForProxy = !!value;
       break;
+    case THROTTLING_BG_DISPATCH_RATE:
+      mBackgroundDispatchRate = value;
+      break;
+    case THROTTLING_BG_DISPATCH_BURST:
+      mBackgroundDispatchBurst = value;
+      break;
     default:
       MOZ_ASSERT_UNREACHABLE("unexpected parameter name");
   }
@@ -3666,6 +3723,77 @@ void nsHttpConnectionMgr::ResumeBackgroundThrottledTransactions() {
   }
 }
 
+bool nsHttpConnectionMgr::AllowBackgroundTabDispatch(nsHttpTransaction* aTrans) {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  if (!mBackgroundDispatchRate) {
+    return true;
+  }
+
+  uint64_t tabId = aTrans->TopLevelOuterContentWindowId();
+  if (!tabId || tabId == mCurrentTopLevelOuterContentWindowId) {
+    // Chrome initiated and active tab transactions are never shaped.
+    return true;
+  }
+
+  uint32_t caps = aTrans->Caps();
+  if (caps & (NS_HTTP_URGENT_START | NS_HTTP_LOAD_AS_BLOCKING |
+              NS_HTTP_LOAD_UNBLOCKED)) {
+    // White list the same classes as for request pacing so that a background
+    // tab the user is about to switch to doesn't have its critical resources
+    // held back.
+    return true;
+  }
+
+  // The table is only a shaping hint; reset it when it grows rather than
+  // tracking the tab group lifetime.  A recreated bucket starts full, which
+  // errs on the permissive side.
+  if (mBackgroundDispatchBuckets.Count() > 100) {
+    mBackgroundDispatchBuckets.Clear();
+  }
+
+  TimeStamp now = TimeStamp::Now();
+  BackgroundDispatchBucket& bucket =
+      mBackgroundDispatchBuckets.GetOrInsert(tabId);
+  if (bucket.mLastRefill.IsNull()) {
+    // A fresh bucket starts full so a newly loading background tab group is
+    // not penalized for its first requests.
+    bucket.mTokens = mBackgroundDispatchBurst;
+  } else {
+    bucket.mTokens = std::min<double>(
+        bucket.mTokens +
+            (now - bucket.mLastRefill).ToSeconds() * mBackgroundDispatchRate,
+        mBackgroundDispatchBurst);
+  }
+  bucket.mLastRefill = now;
+
+  if (bucket.mTokens < 1.0) {
+    LOG(("nsHttpConnectionMgr::AllowBackgroundTabDispatch hold trans=%p "
+         "tabid=%" PRIx64,
+         aTrans, tabId));
+    EnsureBackgroundDispatchTimer();
+    return false;
+  }
+
+  bucket.mTokens -= 1.0;
+  return true;
+}
+
+void nsHttpConnectionMgr::EnsureBackgroundDispatchTimer() {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  if (mBackgroundDispatchTimer) {
+    return;
+  }
+
+  // Wake up when roughly one token has accumulated in the depleted buckets
+  // and reprocess the pending queues.
+  uint32_t delay = std::max(1000 / mBackgroundDispatchRate, 1u);
+  LOG(("nsHttpConnectionMgr::EnsureBackgroundDispatchTimer delay=%u", delay));
+  NS_NewTimerWithObserver(getter_AddRefs(mBackgroundDispatchTimer), this, delay,
+                          nsITimer::TYPE_ONE_SHOT);
+}
+
 void nsHttpConnectionMgr::ResumeReadOf(
     nsClassHashtable<nsUint64HashKey, nsTArray<RefPtr<nsHttpTransaction>>>&
         hashtable,
@@ -3976,6 +4104,12 @@ void nsHttpConnectionMgr::OnMsgSpeculativeConnect(int32_t, ARefBase* param) {
     ignoreIdle = args->mIgnoreIdle;
     isFromPredictor = args->mIsFromPredictor;
     allow1918 = args->mAllow1918;
+
+    if (args->mKeepWarm && !ent->mKeepWarm) {
+      LOG(("OnMsgSpeculativeConnect keeping entry warm [ci=%s]\n",
+           ent->mConnInfo->HashKey().get()));
+      ent->mKeepWarm = true;
+    }
   }
 
   bool keepAlive = args->mTrans->Caps() & NS_HTTP_ALLOW_KEEPALIVE;
@@ -4015,6 +4149,96 @@ nsresult ConnectionHandle::PushBack(const char* buf, uint32_t bufLen) {
   return mConn->PushBack(buf, bufLen);
 }
 
+void nsHttpConnectionMgr::EnsureRttStorageInited() {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+  if (mRttStorage || mRttStorageInitTried) {
+    return;
+  }
+  mRttStorageInitTried = true;
+
+  // DataStorage gives synchronous access to a memory based hash table
+  // that is backed by disk where those writes are done asynchronously
+  // on another thread, but it has to be set up on the main thread.
+  RefPtr<DataStorage> storage;
+  auto initTask = [&]() {
+    MOZ_ASSERT(NS_IsMainThread());
+    storage = DataStorage::Get(DataStorageClass::NetworkRttEstimates);
+    if (storage && NS_FAILED(storage->Init(nullptr))) {
+      storage = nullptr;
+    }
+  };
+
+  nsCOMPtr<nsIEventTarget> main = GetMainThreadEventTarget();
+  if (!main) {
+    return;
+  }
+  SyncRunnable::DispatchToThread(
+      main, new SyncRunnable(NS_NewRunnableFunction(
+                "nsHttpConnectionMgr::EnsureRttStorageInited", initTask)));
+  mRttStorage = storage;
+}
+
+// static
+void nsHttpConnectionMgr::RttEstimateKey(nsHttpConnectionInfo* ci,
+                                         nsACString& key) {
+  // Estimates are about network distance to the peer we dial, so key on the
+  // routed host when there is one and the origin otherwise. The full
+  // HashKey() would needlessly fragment the data across anonymous/isolated
+  // variants of the same endpoint.
+  if (!ci->GetRoutedHost().IsEmpty()) {
+    key.Assign(ci->GetRoutedHost());
+    key.Append(':');
+    key.AppendInt(ci->RoutedPort());
+  } else {
+    key.Assign(ci->GetOrigin());
+    key.Append(':');
+    key.AppendInt(ci->OriginPort());
+  }
+}
+
+uint32_t nsHttpConnectionMgr::ReadRttEstimate(nsHttpConnectionInfo* ci) {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+  EnsureRttStorageInited();
+  if (!mRttStorage) {
+    return 0;
+  }
+
+  nsAutoCString key;
+  RttEstimateKey(ci, key);
+  nsCString val(mRttStorage->Get(
+      key, ci->GetPrivate() ? DataStorage_Private : DataStorage_Persistent));
+  if (val.IsEmpty()) {
+    return 0;
+  }
+  nsresult rv;
+  uint32_t rttMs = val.ToInteger(&rv);
+  return NS_SUCCEEDED(rv) ? rttMs : 0;
+}
+
+void nsHttpConnectionMgr::StoreRttEstimate(nsHttpConnectionInfo* ci,
+                                           uint32_t rttMs) {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+  EnsureRttStorageInited();
+  if (!mRttStorage) {
+    return;
+  }
+
+  // Exponential smoothing keeps one spurious sample (e.g. a retransmitted
+  // SYN) from poisoning the stored estimate.
+  uint32_t prev = ReadRttEstimate(ci);
+  if (prev) {
+    rttMs = (7 * prev + rttMs) >> 3;
+  }
+
+  nsAutoCString key;
+  RttEstimateKey(ci, key);
+  nsAutoCString val;
+  val.AppendInt(rttMs);
+  mRttStorage->Put(
+      key, val,
+      ci->GetPrivate() ? DataStorage_Private : DataStorage_Persistent);
+}
+
 //////////////////////// nsHalfOpenSocket
 NS_IMPL_ADDREF(nsHttpConnectionMgr::nsHalfOpenSocket)
 NS_IMPL_RELEASE(nsHttpConnectionMgr::nsHalfOpenSocket)
@@ -4214,6 +4438,17 @@ nsresult nsHttpConnectionMgr::nsHalfOpenSocket::SetupStreams(
     // with dual-stack hosts, though they still pay the 250ms delay for each new
     // connection. This strategy is also known as "happy eyeballs".
     tmpFlags |= nsISocketTransport::DISABLE_IPV6;
+
+    // Interleave the families RFC 8305 style rather than writing IPv6 off
+    // entirely: if the IPv4 attempt fails quickly too (dual-stack networks
+    // can be flaky in both directions), flip back to IPv6 instead of
+    // waiting out a full connect timeout.
+    tmpFlags |= nsISocketTransport::RETRY_WITH_DIFFERENT_IP_FAMILY;
+    uint16_t fallbackTimeout = gHttpHandler->GetFallbackSynTimeout();
+    if (fallbackTimeout) {
+      socketTransport->SetTimeout(nsISocketTransport::TIMEOUT_CONNECT,
+                                  fallbackTimeout);
+    }
   }
 
   if (!Allow1918()) {
@@ -4305,6 +4540,9 @@ nsresult nsHttpConnectionMgr::nsHalfOpenSocket::SetupBackupStreams() {
 
   LOG(("nsHalfOpenSocket::SetupBackupStream [this=%p ent=%s rv=%" PRIx32 "]",
        this, mEnt->mConnInfo->Origin(), static_cast<uint32_t>(rv)));
+  if (NS_SUCCEEDED(rv)) {
+    AUTO_PROFILER_COUNT_TOTAL(backupConnStarted, 1);
+  }
   if (NS_FAILED(rv)) {
     if (mBackupStreamOut) mBackupStreamOut->AsyncWait(nullptr, 0, 0, nullptr);
     mBackupStreamOut = nullptr;
@@ -4320,6 +4558,15 @@ void nsHttpConnectionMgr::nsHalfOpenSocket::SetupBackupTimer() {
   MOZ_ASSERT(!mSynTimer, "timer already initd");
   if (!timeout && mFastOpenInProgress) {
     timeout = 250;
+  } else if (timeout) {
+    // If earlier sessions measured how long this origin takes to connect,
+    // base the timer on that instead of the one-size-fits-all pref: fast
+    // origins get a prompt backup after a lost SYN and slow ones are
+    // spared a pointless second socket.
+    uint32_t rttMs = gHttpHandler->ConnMgr()->ReadRttEstimate(mEnt->mConnInfo);
+    if (rttMs) {
+      timeout = (uint16_t)clamped<uint32_t>(4 * rttMs, 50, 3000);
+    }
   }
   // When using Fast Open the correct transport will be setup for sure (it is
   // guaranteed), but it can be that it will happened a bit later.
@@ -4903,7 +5150,17 @@ nsresult nsHttpConnectionMgr::nsHalfOpenSocket::SetupConn(
   mTransaction->GetSecurityCallbacks(getter_AddRefs(callbacks));
   nsresult rv;
   if (out == mStreamOut) {
+    if (mBackupTransport) {
+      // A backup socket was racing this one and lost.
+      AUTO_PROFILER_COUNT_TOTAL(primaryConnWon, 1);
+    }
     TimeDuration rtt = TimeStamp::Now() - mPrimarySynStarted;
+    if (!aFastOpen) {
+      // With TFO the stream is writable before the handshake completes, so
+      // that sample would not measure the network; skip it.
+      gHttpHandler->ConnMgr()->StoreRttEstimate(
+          mEnt->mConnInfo, static_cast<uint32_t>(rtt.ToMilliseconds()));
+    }
     rv = conn->Init(
         mEnt->mConnInfo, gHttpHandler->ConnMgr()->mMaxRequestDelay,
         mSocketTransport, mStreamIn, mStreamOut,
@@ -4933,7 +5190,10 @@ nsresult nsHttpConnectionMgr::nsHalfOpenSocket::SetupConn(
       }
     }
   } else if (out == mBackupStreamOut) {
+    AUTO_PROFILER_COUNT_TOTAL(backupConnWon, 1);
     TimeDuration rtt = TimeStamp::Now() - mBackupSynStarted;
+    gHttpHandler->ConnMgr()->StoreRttEstimate(
+        mEnt->mConnInfo, static_cast<uint32_t>(rtt.ToMilliseconds()));
     rv = conn->Init(
         mEnt->mConnInfo, gHttpHandler->ConnMgr()->mMaxRequestDelay,
         mBackupTransport, mBackupStreamIn, mBackupStreamOut, mBackupConnectedOK,
@@ -5356,7 +5616,8 @@ nsHttpConnectionMgr::nsConnectionEntry::nsConnectionEntry(
       mPreferIPv4(false),
       mPreferIPv6(false),
       mUsedForConnection(false),
-      mDoNotDestroy(false) {
+      mDoNotDestroy(false),
+      mKeepWarm(false) {
   MOZ_COUNT_CTOR(nsConnectionEntry);
 
   if (mConnInfo->FirstHopSSL() && !mConnInfo->IsHttp3()) {
@@ -28,6 +28,9 @@
 class nsIHttpUpgradeListener;
 
 namespace mozilla {
+
+class DataStorage;
+
 namespace net {
 class EventTokenBucket;
 class NullHttpTransaction;
@@ -227,6 +230,12 @@ class nsHttpConnectionMgr final : public HttpConnectionMgrShell,
 
     bool mDoNotDestroy : 1;
 
+    // Set when the predictor speculatively connected to this entry with the
+    // keepWarm override. A limited number of idle connections then get an
+    // extended idle timeout so a predicted navigation can reuse them
+    // without paying the handshake again.
+    bool mKeepWarm : 1;
+
     bool AllowSpdy() const { return mCanUseSpdy; }
     void DisallowSpdy();
 
@@ -620,6 +629,17 @@ class nsHttpConnectionMgr final : public HttpConnectionMgrShell,
   //
   nsRefPtrHashtable<nsCStringHashKey, nsConnectionEntry> mCT;
 
+  // Smoothed connect-time estimates keyed by origin, persisted through
+  // DataStorage so that a fresh session can arm the backup connection
+  // (happy eyeballs) timer with timings measured in earlier sessions
+  // instead of the one-size-fits-all pref. Only used on the socket thread.
+  void EnsureRttStorageInited();
+  uint32_t ReadRttEstimate(nsHttpConnectionInfo* ci);
+  void StoreRttEstimate(nsHttpConnectionInfo* ci, uint32_t rttMs);
+  static void RttEstimateKey(nsHttpConnectionInfo* ci, nsACString& key);
+  RefPtr<DataStorage> mRttStorage;
+  bool mRttStorageInitTried;
+
   // Read Timeout Tick handlers
   void TimeoutTick();
 
@@ -700,6 +720,31 @@ class nsHttpConnectionMgr final : public HttpConnectionMgrShell,
   bool mActiveTabTransactionsExist;
   bool mActiveTabUnthrottledTransactionsExist;
 
+  // Dispatch-time rate shaping of background tab groups.  Each background
+  // tab group (keyed by top level outer content window id) draws one token
+  // from its bucket when a transaction is about to dispatch; an empty bucket
+  // leaves the transaction in the pending queue until tokens accumulate
+  // again, so a burst from a background tab (analytics, beacons) cannot
+  // monopolize new connections over foreground traffic.  Only used on the
+  // socket thread.
+  struct BackgroundDispatchBucket {
+    double mTokens = 0.0;
+    TimeStamp mLastRefill;
+  };
+  nsDataHashtable<nsUint64HashKey, BackgroundDispatchBucket>
+      mBackgroundDispatchBuckets;
+  // One-shot timer reprocessing the pending queues when roughly one token
+  // has accumulated after a refused dispatch.
+  nsCOMPtr<nsITimer> mBackgroundDispatchTimer;
+  // Tokens replenished per second per tab group; 0 disables the shaping.
+  uint32_t mBackgroundDispatchRate;
+  // Bucket depth, i.e. the burst a background tab group may dispatch at once.
+  uint32_t mBackgroundDispatchBurst;
+  // Checks (and refills) the bucket of the transaction's tab group.  Active
+  // tab, tab-less and urgent/blocking transactions are never shaped.
+  bool AllowBackgroundTabDispatch(nsHttpTransaction* aTrans);
+  void EnsureBackgroundDispatchTimer();
+
   void LogActiveTransactions(char);
 
   nsTArray<RefPtr<PendingTransactionInfo>>* GetTransactionPendingQHelper(
@@ -213,8 +213,11 @@ nsHttpHandler::nsHttpHandler()
       mThrottleReadInterval(500),
       mThrottleHoldTime(600),
       mThrottleMaxTime(3000),
+      mThrottleBgDispatchRate(10),
+      mThrottleBgDispatchBurst(30),
       mSendWindowSize(1024),
       mUrgentStartEnabled(true),
+      mEarlyHintPreconnectEnabled(true),
       mTailBlockingEnabled(true),
       mTailDelayQuantum(600),
       mTailDelayQuantumAfterDCL(100),
@@ -612,12 +615,22 @@ nsresult nsHttpHandler::InitConnectionMgr() {
     mConnMgr = new nsHttpConnectionMgr();
   }
 
-  return mConnMgr->Init(
+  nsresult rv = mConnMgr->Init(
       mMaxUrgentExcessiveConns, mMaxConnections,
       mMaxPersistentConnectionsPerServer, mMaxPersistentConnectionsPerProxy,
       mMaxRequestDelay, mThrottleEnabled, mThrottleVersion, mThrottleSuspendFor,
       mThrottleResumeFor, mThrottleReadLimit, mThrottleReadInterval,
       mThrottleHoldTime, mThrottleMaxTime, mBeConservativeForProxy);
+  NS_ENSURE_SUCCESS(rv, rv);
+
+  // These parameters postdate Init(); deliver them as updates rather than
+  // growing its signature.
+  Unused << mConnMgr->UpdateParam(
+      nsHttpConnectionMgr::THROTTLING_BG_DISPATCH_RATE, mThrottleBgDispatchRate);
+  Unused << mConnMgr->UpdateParam(
+      nsHttpConnectionMgr::THROTTLING_BG_DISPATCH_BURST,
+      mThrottleBgDispatchBurst);
+  return NS_OK;
 }
 
 nsresult nsHttpHandler::AddStandardRequestHeaders(
@@ -1668,6 +1681,28 @@ void nsHttpHandler::PrefsChanged(const char* pref) {
     }
   }
 
+  if (PREF_CHANGED(HTTP_PREF("throttle.background-dispatch-rate"))) {
+    rv = Preferences::GetInt(HTTP_PREF("throttle.background-dispatch-rate"),
+                             &val);
+    mThrottleBgDispatchRate = (uint32_t)clamped(val, 0, 10000);
+    if (NS_SUCCEEDED(rv) && mConnMgr) {
+      Unused << mConnMgr->UpdateParam(
+          nsHttpConnectionMgr::THROTTLING_BG_DISPATCH_RATE,
+          mThrottleBgDispatchRate);
+    }
+  }
+
+  if (PREF_CHANGED(HTTP_PREF("throttle.background-dispatch-burst"))) {
+    rv = Preferences::GetInt(HTTP_PREF("throttle.background-dispatch-burst"),
+                             &val);
+    mThrottleBgDispatchBurst = (uint32_t)clamped(val, 1, 10000);
+    if (NS_SUCCEEDED(rv) && mConnMgr) {
+      Unused << mConnMgr->UpdateParam(
+          nsHttpConnectionMgr::THROTTLING_BG_DISPATCH_BURST,
+          mThrottleBgDispatchBurst);
+    }
+  }
+
   if (PREF_CHANGED(HTTP_PREF("send_window_size"))) {
     Unused << Preferences::GetInt(HTTP_PREF("send_window_size"), &val);
     mSendWindowSize = val >= 0 ? val : 0;
@@ -1678,6 +1713,11 @@ void nsHttpHandler::PrefsChanged(const char* pref) {
                                    &mUrgentStartEnabled);
   }
 
+  if (PREF_CHANGED(HTTP_PREF("early-hint-preconnect"))) {
+    Unused << Preferences::GetBool(HTTP_PREF("early-hint-preconnect"),
+                                   &mEarlyHintPreconnectEnabled);
+  }
+
   if (PREF_CHANGED(HTTP_PREF("tailing.enabled"))) {
     Unused << Preferences::GetBool(HTTP_PREF("tailing.enabled"),
                                    &mTailBlockingEnabled);
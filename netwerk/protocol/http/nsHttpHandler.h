@@ -183,6 +183,7 @@ class nsHttpHandler final : public nsIHttpProtocolHandler,
 
   bool PromptTempRedirect() { return mPromptTempRedirect; }
   bool IsUrgentStartEnabled() { return mUrgentStartEnabled; }
+  bool EarlyHintPreconnectEnabled() { return mEarlyHintPreconnectEnabled; }
   bool IsTailBlockingEnabled() { return mTailBlockingEnabled; }
   uint32_t TailBlockingDelayQuantum(bool aAfterDOMContentLoaded) {
     return aAfterDOMContentLoaded ? mTailDelayQuantumAfterDCL
@@ -563,10 +564,13 @@ class nsHttpHandler final : public nsIHttpProtocolHandler,
   uint32_t mThrottleReadInterval;
   uint32_t mThrottleHoldTime;
   uint32_t mThrottleMaxTime;
+  uint32_t mThrottleBgDispatchRate;
+  uint32_t mThrottleBgDispatchBurst;
 
   int32_t mSendWindowSize;
 
   bool mUrgentStartEnabled;
+  bool mEarlyHintPreconnectEnabled;
   bool mTailBlockingEnabled;
   uint32_t mTailDelayQuantum;
   uint32_t mTailDelayQuantumAfterDCL;
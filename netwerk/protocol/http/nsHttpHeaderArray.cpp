@@ -322,6 +322,24 @@ nsresult nsHttpHeaderArray::ParseHeaderLine(const nsACString& line,
                                             nsHttpAtom* hdr,
                                             nsACString* headerName,
                                             nsACString* val) {
+  nsDependentCSubstring name;
+  nsDependentCSubstring value;
+
+  nsresult rv = ParseHeaderLineInPlace(line, hdr, &name, &value);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+
+  if (val) val->Assign(value);
+  if (headerName) headerName->Assign(name);
+
+  return NS_OK;
+}
+
+/*static*/
+nsresult nsHttpHeaderArray::ParseHeaderLineInPlace(
+    const nsACString& line, nsHttpAtom* hdr, nsDependentCSubstring* headerName,
+    nsDependentCSubstring* val) {
   //
   // BNF from section 4.2 of RFC 2616:
   //
@@ -368,8 +386,8 @@ nsresult nsHttpHeaderArray::ParseHeaderLine(const nsACString& line,
 
   // assign return values
   if (hdr) *hdr = atom;
-  if (val) val->Assign(p, p2 - p + 1);
-  if (headerName) headerName->Assign(sub);
+  if (val) val->Rebind(p, p2 - p + 1);
+  if (headerName) headerName->Rebind(sub.BeginReading(), sub.Length());
 
   return NS_OK;
 }
@@ -108,6 +108,15 @@ class nsHttpHeaderArray {
       const nsACString& line, nsHttpAtom* header = nullptr,
       nsACString* headerNameOriginal = nullptr, nsACString* value = nullptr);
 
+  // Variant of ParseHeaderLine that rebinds |headerNameOriginal| and |value|
+  // as views into |line| instead of copying them out of it. The views are
+  // only valid as long as |line|'s buffer is; the setters above copy into
+  // the header entry themselves, so parsing straight off a network buffer
+  // costs a single copy per header.
+  static MOZ_MUST_USE nsresult ParseHeaderLineInPlace(
+      const nsACString& line, nsHttpAtom* header,
+      nsDependentCSubstring* headerNameOriginal, nsDependentCSubstring* value);
+
   void Flatten(nsACString&, bool pruneProxyHeaders, bool pruneTransients);
   void FlattenOriginalHeader(nsACString&);
 
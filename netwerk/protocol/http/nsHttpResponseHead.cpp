@@ -528,10 +528,13 @@ nsresult nsHttpResponseHead::ParseHeaderLine(const nsACString& line) {
 nsresult nsHttpResponseHead::ParseHeaderLine_locked(
     const nsACString& line, bool originalFromNetHeaders) {
   nsHttpAtom hdr;
-  nsAutoCString headerNameOriginal;
-  nsAutoCString val;
+  nsDependentCSubstring headerNameOriginal;
+  nsDependentCSubstring val;
 
-  if (NS_FAILED(nsHttpHeaderArray::ParseHeaderLine(
+  // Bind the name and value as views into |line| instead of copying them out;
+  // the setters below copy into the header entry themselves, so the text is
+  // copied off the network buffer exactly once.
+  if (NS_FAILED(nsHttpHeaderArray::ParseHeaderLineInPlace(
           line, &hdr, &headerNameOriginal, &val))) {
     return NS_OK;
   }
@@ -552,21 +555,22 @@ nsresult nsHttpResponseHead::ParseHeaderLine_locked(
   if (hdr == nsHttp::Content_Length) {
     int64_t len;
     const char* ignored;
+    nsAutoCString flatVal(val);
     // permit only a single value here.
-    if (nsHttp::ParseInt64(val.get(), &ignored, &len)) {
+    if (nsHttp::ParseInt64(flatVal.get(), &ignored, &len)) {
       mContentLength = len;
     } else {
       // If this is a negative content length then just ignore it
-      LOG(("invalid content-length! %s\n", val.get()));
+      LOG(("invalid content-length! %s\n", flatVal.get()));
     }
   } else if (hdr == nsHttp::Content_Type) {
-    LOG(("ParseContentType [type=%s]\n", val.get()));
+    LOG(("ParseContentType [type=%s]\n", PromiseFlatCString(val).get()));
     bool dummy;
     net_ParseContentType(val, mContentType, mContentCharset, &dummy);
   } else if (hdr == nsHttp::Cache_Control)
-    ParseCacheControl(val.get());
+    ParseCacheControl(PromiseFlatCString(val).get());
   else if (hdr == nsHttp::Pragma)
-    ParsePragma(val.get());
+    ParsePragma(PromiseFlatCString(val).get());
   return NS_OK;
 }
 
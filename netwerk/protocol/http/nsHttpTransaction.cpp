@@ -17,6 +17,7 @@
 #include "base/basictypes.h"
 #include "mozilla/Tokenizer.h"
 #include "nsCRT.h"
+#include "nsCharSeparatedTokenizer.h"
 #include "nsComponentManagerUtils.h"  // do_CreateInstance
 #include "nsHttpBasicAuth.h"
 #include "nsHttpChunkedDecoder.h"
@@ -48,6 +49,7 @@
 #include "nsSocketTransportService2.h"
 #include "nsStringStream.h"
 #include "nsTransportUtils.h"
+#include "nsUnicharUtils.h"
 #include "sslerr.h"
 
 //-----------------------------------------------------------------------------
@@ -433,9 +435,17 @@ nsresult nsHttpTransaction::Init(
                      : -1;
 
   // create pipe for response stream
+  // The segments are sized to a full TLS plaintext record (2^14) so that the
+  // connection can pull the decrypted payload of a whole record out of the
+  // socket with one read per record; the pipe's total capacity is kept at
+  // the gDefaultSegmentSize * gDefaultSegmentCount it has always had.
+  uint32_t segmentSize =
+      std::max(nsIOService::gDefaultSegmentSize, uint32_t(1 << 14));
+  uint32_t segmentCount =
+      std::max(1u, nsIOService::gDefaultSegmentSize *
+                       nsIOService::gDefaultSegmentCount / segmentSize);
   rv = NS_NewPipe2(getter_AddRefs(mPipeIn), getter_AddRefs(mPipeOut), true,
-                   true, nsIOService::gDefaultSegmentSize,
-                   nsIOService::gDefaultSegmentCount);
+                   true, segmentSize, segmentCount);
   if (NS_FAILED(rv)) return rv;
 
   if (transWithPushedStream && aPushedStreamId) {
@@ -1483,7 +1493,7 @@ char* nsHttpTransaction::LocateHttpStart(char* buf, uint32_t len,
   return nullptr;
 }
 
-nsresult nsHttpTransaction::ParseLine(nsACString& line) {
+nsresult nsHttpTransaction::ParseLine(const nsACString& line) {
   LOG1(("nsHttpTransaction::ParseLine [%s]\n", PromiseFlatCString(line).get()));
   nsresult rv = NS_OK;
 
@@ -1526,17 +1536,157 @@ nsresult nsHttpTransaction::ParseLineSegment(char* segment, uint32_t len) {
     uint16_t status = mResponseHead->Status();
     if ((status != 101) && (status / 100 == 1)) {
       LOG(("ignoring 1xx response\n"));
+      if (status == 103) {
+        // Act on the hints before the headers are thrown away.
+        ProcessEarlyHints();
+      }
       mHaveStatusLine = false;
       mHttpResponseMatched = false;
       mConnection->SetLastTransactionExpectedNoContent(true);
       mResponseHead->Reset();
       return NS_OK;
     }
+    if (!mEarlyHintTime.IsNull()) {
+      Telemetry::Accumulate(
+          Telemetry::HTTP_EARLY_HINT_TO_RESPONSE_MS,
+          static_cast<uint32_t>(
+              (TimeStamp::Now() - mEarlyHintTime).ToMilliseconds()));
+    }
     mHaveAllHeaders = true;
   }
   return NS_OK;
 }
 
+// Called on the socket thread while a 103 (Early Hints) informational
+// response is being discarded, before its headers are reset. The final
+// response is still on the wire, so this is the earliest point the hints
+// can be acted on: warm up connections to the cross-origin hosts the server
+// says the document is about to need. Resource-level preloads remain the
+// content sink's job; it sees the same links again on the final response.
+void nsHttpTransaction::ProcessEarlyHints() {
+  MOZ_ASSERT(mResponseHead);
+
+  if (mEarlyHintTime.IsNull()) {
+    mEarlyHintTime = TimeStamp::Now();
+  }
+
+  if (!gHttpHandler->EarlyHintPreconnectEnabled()) {
+    return;
+  }
+
+  nsAutoCString linkHeader;
+  if (NS_FAILED(mResponseHead->GetHeader(nsHttp::Link, linkHeader)) ||
+      linkHeader.IsEmpty()) {
+    return;
+  }
+
+  LOG(("nsHttpTransaction::ProcessEarlyHints %p [%s]\n", this,
+       linkHeader.get()));
+
+  // Conservative parse of the comma separated link-values. Only absolute
+  // http(s) and scheme-relative URLs are interesting here: a relative URL
+  // points back at the origin this transaction is already connected to.
+  const uint32_t kMaxPreconnects = 8;
+  uint32_t preconnects = 0;
+  nsCCharSeparatedTokenizer links(linkHeader, ',');
+  while (links.hasMoreTokens() && preconnects < kMaxPreconnects) {
+    nsAutoCString link(links.nextToken());
+
+    int32_t urlStart = link.FindChar('<');
+    int32_t urlEnd = link.FindChar('>');
+    if (urlStart == kNotFound || urlEnd <= urlStart) {
+      continue;
+    }
+
+    nsAutoCString params(Substring(link, urlEnd + 1));
+    ToLowerCase(params);
+    if (params.Find("preconnect") == kNotFound &&
+        params.Find("preload") == kNotFound) {
+      continue;
+    }
+
+    nsAutoCString url(Substring(link, urlStart + 1, urlEnd - urlStart - 1));
+    bool ssl;
+    uint32_t authStart;
+    if (StringBeginsWith(url, NS_LITERAL_CSTRING("https://"))) {
+      ssl = true;
+      authStart = 8;
+    } else if (StringBeginsWith(url, NS_LITERAL_CSTRING("http://"))) {
+      ssl = false;
+      authStart = 7;
+    } else if (StringBeginsWith(url, NS_LITERAL_CSTRING("//"))) {
+      ssl = mConnInfo->EndToEndSSL();
+      authStart = 2;
+    } else {
+      continue;
+    }
+
+    // The authority ends at the first path, query or fragment delimiter.
+    nsAutoCString authority(Substring(url, authStart));
+    int32_t authEnd = authority.FindCharInSet("/?#");
+    if (authEnd != kNotFound) {
+      authority.Truncate(authEnd);
+    }
+    int32_t userinfo = authority.RFindChar('@');
+    if (userinfo != kNotFound) {
+      authority = Substring(authority, userinfo + 1);
+    }
+    if (authority.IsEmpty()) {
+      continue;
+    }
+
+    nsAutoCString host;
+    int32_t port = ssl ? NS_HTTPS_DEFAULT_PORT : NS_HTTP_DEFAULT_PORT;
+    nsresult err = NS_OK;
+    if (authority.First() == '[') {  // IPv6 literal
+      int32_t bracket = authority.FindChar(']');
+      if (bracket == kNotFound) {
+        continue;
+      }
+      host = Substring(authority, 1, bracket - 1);
+      if (static_cast<int32_t>(authority.Length()) > bracket + 1) {
+        if (authority.CharAt(bracket + 1) != ':') {
+          continue;
+        }
+        nsAutoCString portStr(Substring(authority, bracket + 2));
+        port = portStr.ToInteger(&err);
+      }
+    } else {
+      int32_t colon = authority.RFindChar(':');
+      if (colon == kNotFound) {
+        host = authority;
+      } else {
+        host = Substring(authority, 0, colon);
+        nsAutoCString portStr(Substring(authority, colon + 1));
+        port = portStr.ToInteger(&err);
+      }
+    }
+    if (NS_FAILED(err) || host.IsEmpty() || port <= 0 || port > 0xffff) {
+      continue;
+    }
+    ToLowerCase(host);
+
+    if (ssl == mConnInfo->EndToEndSSL() && port == mConnInfo->OriginPort() &&
+        host == mConnInfo->GetOrigin()) {
+      // Already talking to this host.
+      continue;
+    }
+
+    LOG(("nsHttpTransaction::ProcessEarlyHints %p preconnect %s://%s:%d\n",
+         this, ssl ? "https" : "http", host.get(), port));
+
+    RefPtr<nsHttpConnectionInfo> ci = new nsHttpConnectionInfo(
+        host, port, EmptyCString(), mConnInfo->GetUsername(),
+        mConnInfo->GetTopWindowOrigin(), mConnInfo->ProxyInfo(),
+        mConnInfo->GetOriginAttributes(), ssl);
+    ci->SetAnonymous(!!(mCaps & NS_HTTP_LOAD_ANONYMOUS));
+    ci->SetPrivate(mConnInfo->GetPrivate());
+
+    Unused << gHttpHandler->SpeculativeConnect(ci, nullptr);
+    preconnects++;
+  }
+}
+
 nsresult nsHttpTransaction::ParseHead(char* buf, uint32_t count,
                                       uint32_t* countRead) {
   nsresult rv;
@@ -1627,8 +1777,22 @@ nsresult nsHttpTransaction::ParseHead(char* buf, uint32_t count,
     if ((eol > buf) && (*(eol - 1) == '\r')) len--;
 
     buf[len - 1] = '\n';
-    rv = ParseLineSegment(buf, len);
-    if (NS_FAILED(rv)) return rv;
+
+    // Zero-copy fast path: a complete, non-blank line can be parsed in
+    // place, without staging it in mLineBuf, provided we can already tell
+    // that the next line doesn't fold into it. The status line can never be
+    // folded; for header lines we need to see the byte after the newline.
+    // Blank lines (end of headers) and anything ambiguous take the
+    // mLineBuf path below, which also handles lines split across reads.
+    const char* next = (*countRead < count) ? eol + 1 : nullptr;
+    if (mLineBuf.IsEmpty() && len > 1 &&
+        (!mHaveStatusLine || (next && *next != ' ' && *next != '\t'))) {
+      rv = ParseLine(nsDependentCSubstring(buf, len - 1));
+      if (NS_FAILED(rv)) return rv;
+    } else {
+      rv = ParseLineSegment(buf, len);
+      if (NS_FAILED(rv)) return rv;
+    }
 
     if (mHaveAllHeaders) return NS_OK;
 
@@ -2498,10 +2662,11 @@ void nsHttpTransaction::SetHttpTrailers(nsCString& aTrailers) {
         (newline && aTrailers[newline - 1] == '\r') ? newline - 1 : newline;
     nsDependentCSubstring line(aTrailers, cur, end);
     nsHttpAtom hdr;
-    nsAutoCString hdrNameOriginal;
-    nsAutoCString val;
-    if (NS_SUCCEEDED(httpTrailers->ParseHeaderLine(line, &hdr, &hdrNameOriginal,
-                                                   &val))) {
+    nsDependentCSubstring hdrNameOriginal;
+    nsDependentCSubstring val;
+    if (NS_SUCCEEDED(httpTrailers->ParseHeaderLineInPlace(line, &hdr,
+                                                          &hdrNameOriginal,
+                                                          &val))) {
       if (hdr == nsHttp::Server_Timing) {
         Unused << httpTrailers->SetHeaderFromNet(hdr, hdrNameOriginal, val,
                                                  true);
@@ -149,9 +149,10 @@ class nsHttpTransaction final : public nsAHttpTransaction,
 
   MOZ_MUST_USE nsresult Restart();
   char* LocateHttpStart(char* buf, uint32_t len, bool aAllowPartialMatch);
-  MOZ_MUST_USE nsresult ParseLine(nsACString& line);
+  MOZ_MUST_USE nsresult ParseLine(const nsACString& line);
   MOZ_MUST_USE nsresult ParseLineSegment(char* seg, uint32_t len);
   MOZ_MUST_USE nsresult ParseHead(char*, uint32_t count, uint32_t* countRead);
+  void ProcessEarlyHints();
   MOZ_MUST_USE nsresult HandleContentStart();
   MOZ_MUST_USE nsresult HandleContent(char*, uint32_t count,
                                       uint32_t* contentRead,
@@ -342,6 +343,11 @@ class nsHttpTransaction final : public nsAHttpTransaction,
   // The time when the transaction was submitted to the Connection Manager
   TimeStamp mPendingTime;
 
+  // The time the first 103 (Early Hints) informational response finished
+  // parsing, so we can measure how far ahead of the final response the
+  // server's hints arrived. Null if no 103 was received. Socket thread only.
+  TimeStamp mEarlyHintTime;
+
   uint64_t mTopLevelOuterContentWindowId;
 
   // For Rate Pacing via an EventTokenBucket
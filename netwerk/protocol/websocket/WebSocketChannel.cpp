@@ -527,36 +527,38 @@ nsWSAdmissionManager* nsWSAdmissionManager::sManager;
 StaticMutex nsWSAdmissionManager::sLock;
 
 //-----------------------------------------------------------------------------
-// CallOnMessageAvailable
+// CallOnMessagesAvailable
 //-----------------------------------------------------------------------------
 
-class CallOnMessageAvailable final : public Runnable {
+class CallOnMessagesAvailable final : public Runnable {
  public:
-  CallOnMessageAvailable(WebSocketChannel* aChannel, nsACString& aData,
-                         int32_t aLen)
-      : Runnable("net::CallOnMessageAvailable"),
+  CallOnMessagesAvailable(
+      WebSocketChannel* aChannel,
+      nsTArray<WebSocketChannel::ReceivedMessage>&& aMessages)
+      : Runnable("net::CallOnMessagesAvailable"),
         mChannel(aChannel),
         mListenerMT(aChannel->mListenerMT),
-        mData(aData),
-        mLen(aLen) {}
+        mMessages(std::move(aMessages)) {}
 
   NS_IMETHOD Run() override {
     MOZ_ASSERT(mChannel->IsOnTargetThread());
 
     if (mListenerMT) {
-      nsresult rv;
-      if (mLen < 0) {
-        rv = mListenerMT->mListener->OnMessageAvailable(mListenerMT->mContext,
-                                                        mData);
-      } else {
-        rv = mListenerMT->mListener->OnBinaryMessageAvailable(
-            mListenerMT->mContext, mData);
-      }
-      if (NS_FAILED(rv)) {
-        LOG(
-            ("OnMessageAvailable or OnBinaryMessageAvailable "
-             "failed with 0x%08" PRIx32,
-             static_cast<uint32_t>(rv)));
+      for (const WebSocketChannel::ReceivedMessage& msg : mMessages) {
+        nsresult rv;
+        if (msg.mLen < 0) {
+          rv = mListenerMT->mListener->OnMessageAvailable(mListenerMT->mContext,
+                                                          msg.mData);
+        } else {
+          rv = mListenerMT->mListener->OnBinaryMessageAvailable(
+              mListenerMT->mContext, msg.mData);
+        }
+        if (NS_FAILED(rv)) {
+          LOG(
+              ("OnMessageAvailable or OnBinaryMessageAvailable "
+               "failed with 0x%08" PRIx32,
+               static_cast<uint32_t>(rv)));
+        }
       }
     }
 
@@ -564,12 +566,11 @@ class CallOnMessageAvailable final : public Runnable {
   }
 
  private:
-  ~CallOnMessageAvailable() = default;
+  ~CallOnMessagesAvailable() = default;
 
   RefPtr<WebSocketChannel> mChannel;
   RefPtr<BaseWebSocketChannel::ListenerAndContextContainer> mListenerMT;
-  nsCString mData;
-  int32_t mLen;
+  nsTArray<WebSocketChannel::ReceivedMessage> mMessages;
 };
 
 //-----------------------------------------------------------------------------
@@ -1123,6 +1124,7 @@ WebSocketChannel::WebSocketChannel()
       mFragmentAccumulator(0),
       mBuffered(0),
       mBufferSize(kIncomingBufferInitialSize),
+      mMaxDeliveryBatch(64),
       mCurrentOut(nullptr),
       mCurrentOutSent(0),
       mHdrOutToSend(0),
@@ -1404,6 +1406,32 @@ bool WebSocketChannel::UpdateReadBuffer(uint8_t* buffer, uint32_t count,
   return true;
 }
 
+void WebSocketChannel::QueueDecodedMessage(nsCString&& aData, int32_t aLen) {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  ReceivedMessage* msg = mPendingMessages.AppendElement();
+  msg->mData = std::move(aData);
+  msg->mLen = aLen;
+
+  // Cap the batch so a fast sender cannot delay delivery (or hold decoded
+  // data on the socket thread) indefinitely while the socket stays readable.
+  if (mPendingMessages.Length() >= mMaxDeliveryBatch) {
+    FlushPendingMessages();
+  }
+}
+
+void WebSocketChannel::FlushPendingMessages() {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  if (mPendingMessages.IsEmpty()) {
+    return;
+  }
+
+  mTargetThread->Dispatch(
+      new CallOnMessagesAvailable(this, std::move(mPendingMessages)),
+      NS_DISPATCH_NORMAL);
+}
+
 nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
   LOG(("WebSocketChannel::ProcessInput %p [%d %d]\n", this, count, mBuffered));
   MOZ_ASSERT(OnSocketThread(), "not on socket thread");
@@ -1650,8 +1678,7 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
           mService->FrameReceived(mSerial, mInnerWindowID, frame.forget());
         }
 
-        mTargetThread->Dispatch(new CallOnMessageAvailable(this, utf8Data, -1),
-                                NS_DISPATCH_NORMAL);
+        QueueDecodedMessage(std::move(utf8Data), -1);
         if (mConnectionLogService && !mPrivateBrowsing) {
           mConnectionLogService->NewMsgReceived(mHost, mSerial, count);
           LOG(("Added new msg received for %s", mHost.get()));
@@ -1710,6 +1737,9 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
         }
 
         if (mListenerMT) {
+          // Messages decoded earlier in this read must reach the listener
+          // before the close notification.
+          FlushPendingMessages();
           mTargetThread->Dispatch(
               new CallOnServerClose(this, mServerCloseCode, mServerCloseReason),
               NS_DISPATCH_NORMAL);
@@ -1776,9 +1806,8 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
           mService->FrameReceived(mSerial, mInnerWindowID, frame.forget());
         }
 
-        mTargetThread->Dispatch(
-            new CallOnMessageAvailable(this, binaryData, binaryData.Length()),
-            NS_DISPATCH_NORMAL);
+        int32_t len = binaryData.Length();
+        QueueDecodedMessage(std::move(binaryData), len);
         // To add the header to 'Networking Dashboard' log
         if (mConnectionLogService && !mPrivateBrowsing) {
           mConnectionLogService->NewMsgReceived(mHost, mSerial, count);
@@ -3311,6 +3340,11 @@ WebSocketChannel::AsyncOpen(nsIURI* aURI, const nsACString& aOrigin,
     if (NS_SUCCEEDED(rv)) {
       mMaxConcurrentConnections = clamped(intpref, 1, 0xffff);
     }
+    rv = prefService->GetIntPref("network.websocket.delivery-batch-max",
+                                 &intpref);
+    if (NS_SUCCEEDED(rv)) {
+      mMaxDeliveryBatch = clamped(intpref, 1, 4096);
+    }
   }
 
   int32_t sessionCount = -1;
@@ -3902,16 +3936,19 @@ WebSocketChannel::OnInputStreamReady(nsIAsyncInputStream* aStream) {
          count, static_cast<uint32_t>(rv)));
 
     if (rv == NS_BASE_STREAM_WOULD_BLOCK) {
+      FlushPendingMessages();
       mSocketIn->AsyncWait(this, 0, 0, mSocketThread);
       return NS_OK;
     }
 
     if (NS_FAILED(rv)) {
+      FlushPendingMessages();
       AbortSession(rv);
       return rv;
     }
 
     if (count == 0) {
+      FlushPendingMessages();
       AbortSession(NS_BASE_STREAM_CLOSED);
       return NS_OK;
     }
@@ -3922,11 +3959,15 @@ WebSocketChannel::OnInputStreamReady(nsIAsyncInputStream* aStream) {
 
     rv = ProcessInput((uint8_t*)buffer, count);
     if (NS_FAILED(rv)) {
+      // Messages decoded before the error must still reach the listener
+      // ahead of the stop notification.
+      FlushPendingMessages();
       AbortSession(rv);
       return rv;
     }
   } while (NS_SUCCEEDED(rv) && mSocketIn);
 
+  FlushPendingMessages();
   return NS_OK;
 }
 
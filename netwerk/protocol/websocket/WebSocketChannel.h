@@ -24,6 +24,7 @@
 #include "nsCOMPtr.h"
 #include "nsString.h"
 #include "nsDeque.h"
+#include "nsTArray.h"
 #include "mozilla/Atomics.h"
 
 class nsIAsyncVerifyRedirectCallback;
@@ -41,7 +42,7 @@ class OutboundMessage;
 class OutboundEnqueuer;
 class nsWSAdmissionManager;
 class PMCECompression;
-class CallOnMessageAvailable;
+class CallOnMessagesAvailable;
 class CallOnStop;
 class CallOnServerClose;
 class CallAcknowledge;
@@ -130,7 +131,7 @@ class WebSocketChannel : public BaseWebSocketChannel,
   friend class OutboundEnqueuer;
   friend class nsWSAdmissionManager;
   friend class FailDelayManager;
-  friend class CallOnMessageAvailable;
+  friend class CallOnMessagesAvailable;
   friend class CallOnStop;
   friend class CallOnServerClose;
   friend class CallAcknowledge;
@@ -175,6 +176,8 @@ class WebSocketChannel : public BaseWebSocketChannel,
 
   bool IsPersistentFramePtr();
   MOZ_MUST_USE nsresult ProcessInput(uint8_t* buffer, uint32_t count);
+  void QueueDecodedMessage(nsCString&& aData, int32_t aLen);
+  void FlushPendingMessages();
   MOZ_MUST_USE bool UpdateReadBuffer(uint8_t* buffer, uint32_t count,
                                      uint32_t accumulatedFragments,
                                      uint32_t* available);
@@ -279,6 +282,18 @@ class WebSocketChannel : public BaseWebSocketChannel,
   uint32_t mBuffered;
   uint32_t mBufferSize;
 
+  // Messages decoded on the socket thread during the current read but not
+  // yet handed to the listener. High message rates make per-message
+  // dispatch the bottleneck, so completed messages are accumulated here and
+  // delivered to the target thread as one batch of up to mMaxDeliveryBatch
+  // once the socket has no more data to give us. Socket thread only.
+  struct ReceivedMessage {
+    nsCString mData;
+    int32_t mLen;  // < 0 for a text message, else the binary length
+  };
+  nsTArray<ReceivedMessage> mPendingMessages;
+  uint32_t mMaxDeliveryBatch;
+
   // These are for the send buffers
   const static int32_t kCopyBreak = 1000;
 
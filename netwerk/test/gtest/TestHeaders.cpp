@@ -28,3 +28,30 @@ TEST(TestHeaders, DuplicateHSTS)
   ASSERT_EQ(rv, NS_OK);
   ASSERT_EQ(h.get(), "max-age=360");
 }
+
+TEST(TestHeaders, ParseHeaderLineInPlace)
+{
+  // The in-place variant must bind the name and value as views into the
+  // input line rather than copying them.
+  NS_NAMED_LITERAL_CSTRING(line, "Content-Type:  text/html; charset=utf-8  ");
+
+  mozilla::net::nsHttpAtom hdr;
+  nsDependentCSubstring name;
+  nsDependentCSubstring val;
+  nsresult rv = mozilla::net::nsHttpHeaderArray::ParseHeaderLineInPlace(
+      line, &hdr, &name, &val);
+  ASSERT_EQ(rv, NS_OK);
+
+  ASSERT_TRUE(hdr == mozilla::net::nsHttp::Content_Type);
+  ASSERT_TRUE(name.Equals("Content-Type"));
+  // Leading and trailing LWS is trimmed from the value.
+  ASSERT_TRUE(val.Equals("text/html; charset=utf-8"));
+  // No copies: both views point into |line|'s buffer.
+  ASSERT_EQ(name.BeginReading(), line.BeginReading());
+  ASSERT_EQ(val.BeginReading(), line.BeginReading() + 15);
+
+  // Malformed lines are rejected just as in ParseHeaderLine.
+  rv = mozilla::net::nsHttpHeaderArray::ParseHeaderLineInPlace(
+      NS_LITERAL_CSTRING("no colon here"), &hdr, &name, &val);
+  ASSERT_TRUE(NS_FAILED(rv));
+}
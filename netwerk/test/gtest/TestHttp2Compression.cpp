@@ -0,0 +1,79 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+
+#include "Http2Compression.h"
+
+using namespace mozilla;
+using namespace mozilla::net;
+
+namespace {
+
+const char kFlatRequestHeaders[] =
+    "GET /api/resource HTTP/1.1\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "User-Agent: test/1.0\r\n"
+    "\r\n";
+
+nsresult Encode(Http2Compressor& aCompressor, nsACString& aOutput) {
+  // The compressor lowercases header names in its input buffer, so hand it a
+  // fresh copy each time just as Http2Stream does.
+  nsCString flat(kFlatRequestHeaders);
+  return aCompressor.EncodeHeaderBlock(
+      flat, NS_LITERAL_CSTRING("GET"), NS_LITERAL_CSTRING("/api/resource"),
+      NS_LITERAL_CSTRING("example.com"), NS_LITERAL_CSTRING("https"),
+      EmptyCString(), false, aOutput);
+}
+
+nsresult Decode(Http2Decompressor& aDecompressor, const nsACString& aBlock,
+                nsACString& aOutput) {
+  return aDecompressor.DecodeHeaderBlock(
+      reinterpret_cast<const uint8_t*>(aBlock.BeginReading()), aBlock.Length(),
+      aOutput, false);
+}
+
+}  // namespace
+
+TEST(TestHttp2Compression, RepeatedHeaderBlock)
+{
+  Http2Compressor compressor;
+  Http2Decompressor decompressor;
+
+  // The first encoding populates the dynamic table; the ones after that
+  // leave it untouched and are served from the encoded-block cache. All of
+  // them must decompress to the same header set.
+  nsCString block1, block2, block3;
+  ASSERT_EQ(Encode(compressor, block1), NS_OK);
+  ASSERT_EQ(Encode(compressor, block2), NS_OK);
+  ASSERT_EQ(Encode(compressor, block3), NS_OK);
+
+  // Once the table is stable, identical inputs encode to identical bytes.
+  ASSERT_EQ(block2, block3);
+
+  nsCString decoded1, decoded2, decoded3;
+  ASSERT_EQ(Decode(decompressor, block1, decoded1), NS_OK);
+  ASSERT_EQ(Decode(decompressor, block2, decoded2), NS_OK);
+  ASSERT_EQ(Decode(decompressor, block3, decoded3), NS_OK);
+
+  ASSERT_EQ(decoded1, decoded2);
+  ASSERT_EQ(decoded2, decoded3);
+  ASSERT_TRUE(decoded1.Find("user-agent") != kNotFound);
+
+  nsAutoCString method;
+  decompressor.GetMethod(method);
+  ASSERT_TRUE(method.EqualsLiteral("GET"));
+
+  // A table size change must invalidate the cache; the next block carries
+  // the size-update prefix and still round-trips.
+  compressor.SetMaxBufferSize(2048);
+  nsCString block4;
+  ASSERT_EQ(Encode(compressor, block4), NS_OK);
+  ASSERT_NE(block3, block4);
+
+  nsCString decoded4;
+  ASSERT_EQ(Decode(decompressor, block4, decoded4), NS_OK);
+  ASSERT_EQ(decoded3, decoded4);
+}
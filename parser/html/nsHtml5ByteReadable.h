@@ -5,6 +5,8 @@
 #ifndef nsHtml5ByteReadable_h
 #define nsHtml5ByteReadable_h
 
+#include <string.h>
+
 /**
  * A weak reference wrapper around a byte array.
  */
@@ -21,6 +23,24 @@ class nsHtml5ByteReadable {
     }
   }
 
+  /**
+   * Skips to the next occurrence of aByte and reads it. Returns aByte, or -1
+   * with the readable exhausted if aByte doesn't occur. Equivalent to calling
+   * read() until it returns aByte or -1, but scans with memchr.
+   */
+  inline int32_t readUntil(uint8_t aByte) {
+    if (current >= end) {
+      return -1;
+    }
+    const void* found = memchr(current, aByte, end - current);
+    if (!found) {
+      current = end;
+      return -1;
+    }
+    current = static_cast<const uint8_t*>(found) + 1;
+    return aByte;
+  }
+
  private:
   const uint8_t* current;
   const uint8_t* end;
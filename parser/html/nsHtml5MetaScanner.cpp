@@ -105,7 +105,7 @@ stateloop:
           if (reconsume) {
             reconsume = false;
           } else {
-            c = read();
+            c = readUntilLt();
           }
           switch (c) {
             case -1: {
@@ -6,6 +6,9 @@ using Encoding = mozilla::Encoding;
 private:
 const Encoding* mEncoding;
 inline int32_t read() { return readable->read(); }
+// The data state only distinguishes '<' and the end of the readable, so it
+// can skip the bytes in between in a single scan.
+inline int32_t readUntilLt() { return readable->readUntil('<'); }
 
 public:
 const Encoding* sniff(nsHtml5ByteReadable* bytes);
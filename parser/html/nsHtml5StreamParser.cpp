@@ -1732,6 +1732,17 @@ void nsHtml5StreamParser::ParseAvailableData() {
         MarkAsBroken(rv);
         return;
       }
+      // Start speculative loads discovered in this buffer right away instead
+      // of waiting for the buffer chain to be exhausted. When the network is
+      // ahead of the tokenizer, subresource fetches would otherwise be
+      // delayed until the whole backlog has been tokenized.
+      if (mTreeBuilder->HasSpeculativeLoads()) {
+        mTreeBuilder->FlushLoads();
+        nsCOMPtr<nsIRunnable> runnable(mLoadFlusher);
+        if (NS_FAILED(DispatchToMain(runnable.forget()))) {
+          NS_WARNING("failed to dispatch load flush event");
+        }
+      }
       // At this point, internalEncodingDeclaration() may have called
       // Terminate, but that never happens together with script.
       // Can't assert that here, though, because it's possible that the main
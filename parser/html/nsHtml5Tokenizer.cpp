@@ -45,6 +45,7 @@
 #include "nsHtml5Macros.h"
 #include "nsHtml5Highlighter.h"
 #include "nsHtml5TokenizerLoopPolicies.h"
+#include "nsStringSIMD.h"
 
 #include "nsHtml5AttributeName.h"
 #include "nsHtml5ElementName.h"
@@ -466,6 +467,11 @@ stateloop:
             if (++pos == endPos) {
               NS_HTML5_BREAK(stateloop);
             }
+            pos += static_cast<int32_t>(
+                mozilla::HtmlTextRunPrefixLength(buf + pos, endPos - pos));
+            if (pos == endPos) {
+              NS_HTML5_BREAK(stateloop);
+            }
             c = checkChar(buf, pos);
           }
           switch (c) {
@@ -713,6 +713,23 @@ void nsHtml5TreeBuilder::appendCharacters(nsIContentHandle* aParent,
     return;
   }
 
+  if (mImportScanner.ShouldScan()) {
+    nsTArray<nsString> imports =
+        mImportScanner.Scan(MakeSpan(aBuffer, aLength));
+    for (nsString& url : imports) {
+      mSpeculativeLoadQueue.AppendElement()->InitImportStyle(std::move(url));
+    }
+  }
+
+  // The tokenizer often delivers a text run in several pieces, e.g. around
+  // character references. If the previous op is a text append to the same
+  // parent, extend it instead of queueing another op, so the main thread
+  // performs one DOM mutation for the whole run.
+  if (!mOpQueue.IsEmpty() &&
+      mOpQueue.LastElement().TryCoalesceAppendText(aParent, aBuffer, aLength)) {
+    return;
+  }
+
   auto bufferCopy = mozilla::MakeUniqueFallible<char16_t[]>(aLength);
   if (!bufferCopy) {
     // Just assigning mBroken instead of generating tree op. The caller
@@ -724,14 +741,6 @@ void nsHtml5TreeBuilder::appendCharacters(nsIContentHandle* aParent,
 
   memcpy(bufferCopy.get(), aBuffer, aLength * sizeof(char16_t));
 
-  if (mImportScanner.ShouldScan()) {
-    nsTArray<nsString> imports =
-        mImportScanner.Scan(MakeSpan(aBuffer, aLength));
-    for (nsString& url : imports) {
-      mSpeculativeLoadQueue.AppendElement()->InitImportStyle(std::move(url));
-    }
-  }
-
   nsHtml5TreeOperation* treeOp = mOpQueue.AppendElement(mozilla::fallible);
   if (MOZ_UNLIKELY(!treeOp)) {
     MarkAsBrokenAndRequestSuspensionWithoutBuilder(NS_ERROR_OUT_OF_MEMORY);
@@ -104,6 +104,8 @@ bool Flush(bool aDiscretionary = false);
 
 void FlushLoads();
 
+bool HasSpeculativeLoads() const { return !mSpeculativeLoadQueue.IsEmpty(); }
+
 void SetDocumentCharset(NotNull<const Encoding*> aEncoding,
                         int32_t aCharsetSource);
 
@@ -7,6 +7,7 @@
 #include "nsHtml5TreeOperation.h"
 #include "mozAutoDocUpdate.h"
 #include "mozilla/Likely.h"
+#include "mozilla/UniquePtrExtensions.h"
 #include "mozilla/dom/Comment.h"
 #include "mozilla/dom/DocumentType.h"
 #include "mozilla/dom/Element.h"
@@ -204,6 +205,34 @@ nsHtml5TreeOperation::~nsHtml5TreeOperation() {
   mOperation.match(TreeOperationMatcher());
 }
 
+bool nsHtml5TreeOperation::TryCoalesceAppendText(nsIContentHandle* aParent,
+                                                 const char16_t* aBuffer,
+                                                 int32_t aLength) {
+  if (!mOperation.is<opAppendText>()) {
+    return false;
+  }
+  opAppendText& operation = mOperation.as<opAppendText>();
+  if (operation.mParent != static_cast<nsIContent**>(aParent)) {
+    return false;
+  }
+  if (operation.mLength > INT32_MAX - aLength) {
+    return false;
+  }
+  int32_t newLength = operation.mLength + aLength;
+  auto newBuffer = mozilla::MakeUniqueFallible<char16_t[]>(newLength);
+  if (!newBuffer) {
+    return false;
+  }
+  memcpy(newBuffer.get(), operation.mBuffer,
+         operation.mLength * sizeof(char16_t));
+  memcpy(newBuffer.get() + operation.mLength, aBuffer,
+         aLength * sizeof(char16_t));
+  delete[] operation.mBuffer;
+  operation.mBuffer = newBuffer.release();
+  operation.mLength = newLength;
+  return true;
+}
+
 nsresult nsHtml5TreeOperation::AppendTextToTextNode(
     const char16_t* aBuffer, uint32_t aLength, dom::Text* aTextNode,
     nsHtml5DocumentBuilder* aBuilder) {
@@ -611,6 +611,17 @@ class nsHtml5TreeOperation final {
 
   inline bool IsRunScript() { return mOperation.is<opRunScript>(); }
 
+  /**
+   * If this operation is an opAppendText targeting @aParent, grow its buffer
+   * with the new text and return true. This lets the tree builder coalesce
+   * consecutive text appends to the same node into a single tree op, and
+   * thereby a single DOM mutation with a single round of notifications on
+   * the main thread. Returns false, leaving this operation untouched, if
+   * this isn't such an op or the combined buffer can't be allocated.
+   */
+  bool TryCoalesceAppendText(nsIContentHandle* aParent, const char16_t* aBuffer,
+                             int32_t aLength);
+
   inline bool IsMarkAsBroken() { return mOperation.is<opMarkAsBroken>(); }
 
   inline void SetSnapshot(nsAHtml5TreeBuilderState* aSnapshot, int32_t aLine) {
@@ -104,7 +104,8 @@ CertVerifier::CertVerifier(OcspDownloadConfig odc, OcspStrictConfig osc,
       mNetscapeStepUpPolicy(netscapeStepUpPolicy),
       mCTMode(ctMode),
       mDistrustedCAPolicy(distrustedCAPolicy),
-      mCRLiteMode(crliteMode) {
+      mCRLiteMode(crliteMode),
+      mSSLVerificationCacheMutex("CertVerifier-ssl-verification-cache") {
   LoadKnownCTLogs();
   for (const auto& root : thirdPartyCerts) {
     EnterpriseCert rootCopy;
@@ -128,7 +129,7 @@ CertVerifier::CertVerifier(OcspDownloadConfig odc, OcspStrictConfig osc,
   }
 }
 
-CertVerifier::~CertVerifier() {}
+CertVerifier::~CertVerifier() { ClearSSLServerCertVerificationCache(); }
 
 Result IsCertChainRootBuiltInRoot(const UniqueCERTCertList& chain,
                                   bool& result) {
@@ -895,6 +896,240 @@ static bool CertIsSelfSigned(const UniqueCERTCertificate& cert, void* pinarg) {
   return true;
 }
 
+// How long a cached SSL server certificate verification may be reused. This
+// is deliberately short: a cache hit skips revocation checking, so the
+// lifetime bounds how long a newly-published OCSP response, CRLite filter or
+// trust database change can take to affect an already-verified server.
+static const uint64_t kSSLVerificationCacheLifetimeInSeconds = 5 * 60;
+// Each entry stores the DER encodings of an entire verified chain, so keep
+// the cache comparatively small (compare OCSPCache's 1024 entries).
+static const size_t kMaxSSLVerificationCacheEntries = 256;
+
+static SECStatus DigestUint32(UniquePK11Context& context, uint32_t value) {
+  uint8_t array[4];
+  array[0] = value & 255;
+  array[1] = (value >> 8) & 255;
+  array[2] = (value >> 16) & 255;
+  array[3] = (value >> 24) & 255;
+  return PK11_DigestOp(context.get(), array, MOZ_ARRAY_LENGTH(array));
+}
+
+static SECStatus DigestLengthAndBytes(UniquePK11Context& context,
+                                      const uint8_t* data, uint32_t length) {
+  // Unlike in OCSPCache, lengths here can legitimately exceed 65535 bytes
+  // (e.g. stapled OCSP responses), so encode them in 4 bytes.
+  SECStatus rv = DigestUint32(context, length);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  return PK11_DigestOp(context.get(), data, length);
+}
+
+static SECStatus DigestMaybeBytes(UniquePK11Context& context,
+                                  const Maybe<nsTArray<uint8_t>>& bytes) {
+  // Digest a presence flag so that Nothing() and Some(empty) remain distinct.
+  SECStatus rv = DigestUint32(context, bytes.isSome() ? 1 : 0);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  if (bytes.isNothing()) {
+    return SECSuccess;
+  }
+  return DigestLengthAndBytes(context, bytes->Elements(), bytes->Length());
+}
+
+// Computes the key under which a successful verification may be cached: the
+// SHA-384 hash of every input to VerifySSLServerCert that can affect its
+// result. Because every variable-length field is length-prefixed, distinct
+// input tuples cannot produce the same byte stream, so (as with CertIDHash in
+// OCSPCache.cpp) finding two sets of inputs that share a cache entry would
+// require a collision in a cryptographically-secure hash function. The
+// verification time is deliberately not part of the key; staleness is instead
+// bounded by kSSLVerificationCacheLifetimeInSeconds.
+static SECStatus SSLServerCertVerificationHash(
+    SHA384Buffer& buf, const UniqueCERTCertificate& peerCert,
+    const nsACString& hostname, CertVerifier::Flags flags,
+    const Maybe<nsTArray<nsTArray<uint8_t>>>& extraCertificates,
+    const Maybe<nsTArray<uint8_t>>& stapledOCSPResponse,
+    const Maybe<nsTArray<uint8_t>>& sctsFromTLS,
+    const Maybe<DelegatedCredentialInfo>& dcInfo,
+    const OriginAttributes& originAttributes) {
+  UniquePK11Context context(PK11_CreateDigestContext(SEC_OID_SHA384));
+  if (!context) {
+    return SECFailure;
+  }
+  SECStatus rv = PK11_DigestBegin(context.get());
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  rv = DigestLengthAndBytes(context, peerCert->derCert.data,
+                            peerCert->derCert.len);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  rv = DigestLengthAndBytes(
+      context,
+      BitwiseCast<const uint8_t*, const char*>(hostname.BeginReading()),
+      hostname.Length());
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  rv = DigestUint32(context, flags);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  rv = DigestUint32(context,
+                    extraCertificates ? extraCertificates->Length() : 0);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  if (extraCertificates) {
+    for (const auto& der : *extraCertificates) {
+      rv = DigestLengthAndBytes(context, der.Elements(), der.Length());
+      if (rv != SECSuccess) {
+        return rv;
+      }
+    }
+  }
+  rv = DigestMaybeBytes(context, stapledOCSPResponse);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  rv = DigestMaybeBytes(context, sctsFromTLS);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  rv = DigestUint32(context, dcInfo.isSome() ? 1 : 0);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  if (dcInfo) {
+    rv = DigestUint32(context, dcInfo->scheme);
+    if (rv != SECSuccess) {
+      return rv;
+    }
+    rv = DigestUint32(context, dcInfo->authKeyBits);
+    if (rv != SECSuccess) {
+      return rv;
+    }
+  }
+  // As in OCSPCache, only the first party domain portion of the origin
+  // attributes can affect verification (it isolates OCSP fetching and
+  // caching, and is non-empty only when "privacy.firstparty.isolate" is
+  // enabled).
+  NS_ConvertUTF16toUTF8 firstPartyDomain(originAttributes.mFirstPartyDomain);
+  rv = DigestLengthAndBytes(
+      context, BitwiseCast<const uint8_t*, const char*>(firstPartyDomain.get()),
+      firstPartyDomain.Length());
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  uint32_t outLen = 0;
+  rv = PK11_DigestFinal(context.get(), buf, &outLen, SHA384_LENGTH);
+  if (rv != SECSuccess) {
+    return rv;
+  }
+  if (outLen != SHA384_LENGTH) {
+    return SECFailure;
+  }
+  return SECSuccess;
+}
+
+bool CertVerifier::FindCachedSSLServerCertVerification(
+    const SHA384Buffer& keyHash, Time time,
+    /*out*/ UniqueCERTCertList& builtChain, /*out*/ SECOidTag& evOidPolicy) {
+  MutexAutoLock lock(mSSLVerificationCacheMutex);
+  // mSSLVerificationCache is sorted with the most-recently-used entry at the
+  // end, so searching from the end will often be fastest.
+  size_t index = mSSLVerificationCache.length();
+  while (index > 0) {
+    --index;
+    SSLServerCertVerificationCacheEntry* entry = mSSLVerificationCache[index];
+    if (memcmp(entry->mKeyHash, keyHash, SHA384_LENGTH) != 0) {
+      continue;
+    }
+    if (time > entry->mValidThrough) {
+      // The entry has expired; drop it rather than letting stale entries
+      // linger until they are evicted.
+      delete entry;
+      mSSLVerificationCache.erase(mSSLVerificationCache.begin() + index);
+      return false;
+    }
+    // Rebuild the verified chain from the stored DER encodings. The
+    // certificates will typically already be in NSS' temporary certificate
+    // cache, making this considerably cheaper than path building.
+    UniqueCERTCertList chain(CERT_NewCertList());
+    if (!chain) {
+      return false;
+    }
+    for (const auto& der : entry->mBuiltChainDER) {
+      SECItem derItem = {siBuffer, const_cast<uint8_t*>(der.Elements()),
+                         static_cast<unsigned int>(der.Length())};
+      UniqueCERTCertificate cert(CERT_NewTempCertificate(
+          CERT_GetDefaultCertDB(), &derItem, nullptr, false, true));
+      if (!cert) {
+        return false;
+      }
+      if (CERT_AddCertToListTail(chain.get(), cert.get()) != SECSuccess) {
+        return false;
+      }
+      cert.release();  // The list now owns the reference.
+    }
+    builtChain = std::move(chain);
+    evOidPolicy = entry->mEvOidPolicy;
+    // Move the entry to the end to keep most-recently-used ordering.
+    mSSLVerificationCache.erase(mSSLVerificationCache.begin() + index);
+    // erase() does not shrink or realloc memory, so the append below should
+    // always succeed.
+    MOZ_RELEASE_ASSERT(mSSLVerificationCache.append(entry));
+    return true;
+  }
+  return false;
+}
+
+void CertVerifier::RememberSSLServerCertVerification(
+    const SHA384Buffer& keyHash, Time validThrough,
+    const UniqueCERTCertList& builtChain, SECOidTag evOidPolicy) {
+  UniquePtr<SSLServerCertVerificationCacheEntry> entry(
+      new (std::nothrow)
+          SSLServerCertVerificationCacheEntry(validThrough, evOidPolicy));
+  if (!entry) {
+    return;
+  }
+  memcpy(entry->mKeyHash, keyHash, SHA384_LENGTH);
+  for (CERTCertListNode* node = CERT_LIST_HEAD(builtChain);
+       !CERT_LIST_END(node, builtChain); node = CERT_LIST_NEXT(node)) {
+    nsTArray<uint8_t> der;
+    der.AppendElements(node->cert->derCert.data, node->cert->derCert.len);
+    entry->mBuiltChainDER.AppendElement(std::move(der));
+  }
+  MutexAutoLock lock(mSSLVerificationCacheMutex);
+  // Several verification threads may race to verify the same inputs; keep the
+  // entry that got here first (it expires no later than ours would).
+  for (SSLServerCertVerificationCacheEntry* existing : mSSLVerificationCache) {
+    if (memcmp(existing->mKeyHash, keyHash, SHA384_LENGTH) == 0) {
+      return;
+    }
+  }
+  if (mSSLVerificationCache.length() == kMaxSSLVerificationCacheEntries) {
+    // Every entry represents a success, so unlike in OCSPCache it is always
+    // safe to evict the least-recently-used entry, at the front.
+    delete mSSLVerificationCache[0];
+    mSSLVerificationCache.erase(mSSLVerificationCache.begin());
+  }
+  if (mSSLVerificationCache.append(entry.get())) {
+    Unused << entry.release();
+  }
+}
+
+void CertVerifier::ClearSSLServerCertVerificationCache() {
+  MutexAutoLock lock(mSSLVerificationCacheMutex);
+  for (SSLServerCertVerificationCacheEntry* entry : mSSLVerificationCache) {
+    delete entry;
+  }
+  mSSLVerificationCache.clearAndFree();
+}
+
 Result CertVerifier::VerifySSLServerCert(
     const UniqueCERTCertificate& peerCert, Time time,
     /*optional*/ void* pinarg, const nsACString& hostname,
@@ -927,6 +1162,29 @@ Result CertVerifier::VerifySSLServerCert(
     return Result::ERROR_BAD_CERT_DOMAIN;
   }
 
+  // If these exact inputs were successfully verified recently, the cached
+  // result can be reused without repeating path building, signature checking
+  // and revocation fetching. Note that the optional telemetry out-parameters
+  // (stapling status, key size, pinning, CT, CRLite) are only filled in when
+  // a full verification runs; cache hits leave them at their initial values.
+  SHA384Buffer cacheKeyHash;
+  bool canUseCache =
+      SSLServerCertVerificationHash(cacheKeyHash, peerCert, hostname, flags,
+                                    extraCertificates, stapledOCSPResponse,
+                                    sctsFromTLS, dcInfo,
+                                    originAttributes) == SECSuccess;
+  if (canUseCache &&
+      FindCachedSSLServerCertVerification(cacheKeyHash, time, builtChain,
+                                          evPolicyOidTag)) {
+    if (saveIntermediatesInPermanentDatabase) {
+      SaveIntermediateCerts(builtChain);
+    }
+    if (evOidPolicy) {
+      *evOidPolicy = evPolicyOidTag;
+    }
+    return Success;
+  }
+
   // CreateCertErrorRunnable assumes that CheckCertHostname is only called
   // if VerifyCert succeeded.
   Result rv = VerifyCert(peerCert.get(), certificateUsageSSLServer, time,
@@ -1028,6 +1286,28 @@ Result CertVerifier::VerifySSLServerCert(
     *evOidPolicy = evPolicyOidTag;
   }
 
+  if (canUseCache) {
+    // Cache through the earlier of the fixed cache lifetime and the
+    // certificate's own notAfter, so that a cache hit can never validate an
+    // expired certificate.
+    Time validThrough(time);
+    if (validThrough.AddSeconds(kSSLVerificationCacheLifetimeInSeconds) ==
+        Success) {
+      PRTime notBefore;
+      PRTime notAfter;
+      if (CERT_GetCertTimes(peerCert.get(), &notBefore, &notAfter) ==
+          SECSuccess) {
+        Time notAfterTime(
+            TimeFromEpochInSeconds(notAfter / PR_USEC_PER_SEC));
+        if (notAfterTime < validThrough) {
+          validThrough = notAfterTime;
+        }
+        RememberSSLServerCertVerification(cacheKeyHash, validThrough,
+                                          builtChain, evPolicyOidTag);
+      }
+    }
+  }
+
   return Success;
 }
 
@@ -266,7 +266,14 @@ class CertVerifier {
                const Vector<EnterpriseCert>& thirdPartyCerts);
   ~CertVerifier();
 
-  void ClearOCSPCache() { mOCSPCache.Clear(); }
+  void ClearOCSPCache() {
+    mOCSPCache.Clear();
+    // Cached verification results incorporate conclusions drawn from
+    // revocation state, so they must not outlive it.
+    ClearSSLServerCertVerificationCache();
+  }
+
+  void ClearSSLServerCertVerificationCache();
 
   const OcspDownloadConfig mOCSPDownloadConfig;
   const bool mOCSPStrict;
@@ -283,6 +290,38 @@ class CertVerifier {
 
  private:
   OCSPCache mOCSPCache;
+
+  // An entry in the cache of recent successful SSL server certificate
+  // verifications. Only full successes are remembered, and only for a short,
+  // fixed period of time, so that revocation state (OCSP, CRLite) and trust
+  // database changes are picked up again promptly. Entries are keyed on a
+  // SHA-384 hash of every input that can affect the verification result; see
+  // SSLServerCertVerificationHash in CertVerifier.cpp.
+  class SSLServerCertVerificationCacheEntry {
+   public:
+    SSLServerCertVerificationCacheEntry(mozilla::pkix::Time validThrough,
+                                        SECOidTag evOidPolicy)
+        : mValidThrough(validThrough), mEvOidPolicy(evOidPolicy) {}
+
+    SHA384Buffer mKeyHash;
+    // The DER encodings of the verified chain, end-entity first, from which
+    // the CERTCertList handed back on a cache hit is rebuilt.
+    nsTArray<nsTArray<uint8_t>> mBuiltChainDER;
+    mozilla::pkix::Time mValidThrough;
+    SECOidTag mEvOidPolicy;
+  };
+
+  bool FindCachedSSLServerCertVerification(
+      const SHA384Buffer& keyHash, mozilla::pkix::Time time,
+      /*out*/ UniqueCERTCertList& builtChain, /*out*/ SECOidTag& evOidPolicy);
+  void RememberSSLServerCertVerification(
+      const SHA384Buffer& keyHash, mozilla::pkix::Time validThrough,
+      const UniqueCERTCertList& builtChain, SECOidTag evOidPolicy);
+
+  Mutex mSSLVerificationCacheMutex;
+  // Sorted with the most-recently-used entry at the end, as in OCSPCache.
+  Vector<SSLServerCertVerificationCacheEntry*> mSSLVerificationCache;
+
   // We keep a copy of the bytes of each third party root to own.
   Vector<EnterpriseCert> mThirdPartyCerts;
   // This is a reusable, precomputed list of Inputs corresponding to each root
@@ -14,6 +14,7 @@
 // to something faster.
 
 DATA_STORAGE(AlternateServices)
+DATA_STORAGE(NetworkRttEstimates)
 DATA_STORAGE(SecurityPreloadState)
 DATA_STORAGE(SiteSecurityServiceState)
 DATA_STORAGE(TRRBlacklist)
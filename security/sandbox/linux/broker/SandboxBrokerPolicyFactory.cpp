@@ -13,6 +13,7 @@
 #include "mozilla/ClearOnShutdown.h"
 #include "mozilla/Preferences.h"
 #include "mozilla/SandboxSettings.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/UniquePtrExtensions.h"
 #include "mozilla/SandboxLaunch.h"
@@ -259,9 +260,21 @@ static void AddSharedMemoryPaths(SandboxBroker::Policy* aPolicy, pid_t aPid) {
   }
 }
 
+// The process-type-invariant parts of the policies are expensive to
+// compute (they involve reading ldconfig and probing sysfs), so they are
+// built once per session and shared by every factory instance and every
+// process launch, rather than being rebuilt each time.
+static StaticAutoPtr<const SandboxBroker::Policy> sCommonContentPolicy;
+static StaticAutoPtr<const SandboxBroker::Policy> sCommonSocketProcessPolicy;
+
 SandboxBrokerPolicyFactory::SandboxBrokerPolicyFactory() {
-  // Policy entries that are the same in every process go here, and
-  // are cached over the lifetime of the factory.
+  // Policy entries that are the same in every content process go here, and
+  // are cached over the lifetime of the session, shared by all factory
+  // instances.
+  MOZ_ASSERT(NS_IsMainThread());
+  if (sCommonContentPolicy) {
+    return;
+  }
   SandboxBroker::Policy* policy = new SandboxBroker::Policy;
   // Write permssions
   //
@@ -473,7 +486,8 @@ SandboxBrokerPolicyFactory::SandboxBrokerPolicyFactory() {
   }
 #endif
 
-  mCommonContentPolicy.reset(policy);
+  sCommonContentPolicy = policy;
+  ClearOnShutdown(&sCommonContentPolicy);
 }
 
 UniquePtr<SandboxBroker::Policy> SandboxBrokerPolicyFactory::GetContentPolicy(
@@ -489,9 +503,9 @@ UniquePtr<SandboxBroker::Policy> SandboxBrokerPolicyFactory::GetContentPolicy(
     return nullptr;
   }
 
-  MOZ_ASSERT(mCommonContentPolicy);
+  MOZ_ASSERT(sCommonContentPolicy);
   UniquePtr<SandboxBroker::Policy> policy(
-      new SandboxBroker::Policy(*mCommonContentPolicy));
+      new SandboxBroker::Policy(*sCommonContentPolicy));
 
   const int level = GetEffectiveContentSandboxLevel();
 
@@ -658,38 +672,49 @@ SandboxBrokerPolicyFactory::GetUtilityPolicy(int aPid) {
 
 /* static */ UniquePtr<SandboxBroker::Policy>
 SandboxBrokerPolicyFactory::GetSocketProcessPolicy(int aPid) {
-  auto policy = MakeUnique<SandboxBroker::Policy>();
-
-  policy->AddPath(rdonly, "/dev/urandom");
-  policy->AddPath(rdonly, "/proc/cpuinfo");
-  policy->AddPath(rdonly, "/proc/meminfo");
-  policy->AddDir(rdonly, "/sys/devices/cpu");
-  policy->AddDir(rdonly, "/sys/devices/system/cpu");
-  policy->AddDir(rdonly, "/lib");
-  policy->AddDir(rdonly, "/lib64");
-  policy->AddDir(rdonly, "/usr/lib");
-  policy->AddDir(rdonly, "/usr/lib32");
-  policy->AddDir(rdonly, "/usr/lib64");
-  policy->AddDir(rdonly, "/usr/share");
-  policy->AddDir(rdonly, "/usr/local/share");
-
-  AddLdconfigPaths(policy.get());
-
-  // Firefox binary dir.
-  // Note that unlike the previous cases, we use NS_GetSpecialDirectory
-  // instead of GetSpecialSystemDirectory. The former requires a working XPCOM
-  // system, which may not be the case for some tests. For querying for the
-  // location of XPCOM things, we can use it anyway.
-  nsCOMPtr<nsIFile> ffDir;
-  nsresult rv = NS_GetSpecialDirectory(NS_GRE_DIR, getter_AddRefs(ffDir));
-  if (NS_SUCCEEDED(rv)) {
-    nsAutoCString tmpPath;
-    rv = ffDir->GetNativePath(tmpPath);
+  // None of the socket process's policy currently depends on the pid, so
+  // the whole policy can be built once per session and reused for every
+  // launch (the socket process can be relaunched after a crash).
+  MOZ_ASSERT(NS_IsMainThread());
+  if (!sCommonSocketProcessPolicy) {
+    auto policy = MakeUnique<SandboxBroker::Policy>();
+
+    policy->AddPath(rdonly, "/dev/urandom");
+    policy->AddPath(rdonly, "/proc/cpuinfo");
+    policy->AddPath(rdonly, "/proc/meminfo");
+    policy->AddDir(rdonly, "/sys/devices/cpu");
+    policy->AddDir(rdonly, "/sys/devices/system/cpu");
+    policy->AddDir(rdonly, "/lib");
+    policy->AddDir(rdonly, "/lib64");
+    policy->AddDir(rdonly, "/usr/lib");
+    policy->AddDir(rdonly, "/usr/lib32");
+    policy->AddDir(rdonly, "/usr/lib64");
+    policy->AddDir(rdonly, "/usr/share");
+    policy->AddDir(rdonly, "/usr/local/share");
+
+    AddLdconfigPaths(policy.get());
+
+    // Firefox binary dir.
+    // Note that unlike the previous cases, we use NS_GetSpecialDirectory
+    // instead of GetSpecialSystemDirectory. The former requires a working
+    // XPCOM system, which may not be the case for some tests. For querying
+    // for the location of XPCOM things, we can use it anyway.
+    nsCOMPtr<nsIFile> ffDir;
+    nsresult rv = NS_GetSpecialDirectory(NS_GRE_DIR, getter_AddRefs(ffDir));
     if (NS_SUCCEEDED(rv)) {
-      policy->AddDir(rdonly, tmpPath.get());
+      nsAutoCString tmpPath;
+      rv = ffDir->GetNativePath(tmpPath);
+      if (NS_SUCCEEDED(rv)) {
+        policy->AddDir(rdonly, tmpPath.get());
+      }
     }
+
+    sCommonSocketProcessPolicy = policy.release();
+    ClearOnShutdown(&sCommonSocketProcessPolicy);
   }
 
+  auto policy =
+      MakeUnique<SandboxBroker::Policy>(*sCommonSocketProcessPolicy);
   if (policy->IsEmpty()) {
     policy = nullptr;
   }
@@ -22,7 +22,6 @@ class SandboxBrokerPolicyFactory {
   static UniquePtr<SandboxBroker::Policy> GetSocketProcessPolicy(int aPid);
 
  private:
-  UniquePtr<const SandboxBroker::Policy> mCommonContentPolicy;
   static void AddDynamicPathList(SandboxBroker::Policy* policy,
                                  const char* aPathListPref, int perms);
 };
@@ -80,6 +80,11 @@ static const size_t STARTUP_CACHE_RESERVE_CAPACITY = 450;
 // This is a hard limit which we will assert on, to ensure that we don't
 // have some bug causing runaway cache growth.
 static const size_t STARTUP_CACHE_MAX_CAPACITY = 5000;
+// How much decompressed data the prefetch thread may materialize ahead of
+// requests. Entries at the front of the file are the ones the previous
+// session requested first, so this budget covers the startup critical path
+// without pinning the whole cache's uncompressed contents in memory.
+static const size_t STARTUP_CACHE_PREFETCH_DECOMPRESS_BYTES = 16 * 1024 * 1024;
 
 #define STARTUP_CACHE_NAME "startupCache." SC_WORDSIZE "." SC_ENDIAN
 
@@ -141,7 +146,8 @@ bool StartupCache::gIgnoreDiskCache;
 NS_IMPL_ISUPPORTS(StartupCache, nsIMemoryReporter)
 
 StartupCache::StartupCache()
-    : mDirty(false),
+    : mTableLock("StartupCache::mTableLock"),
+      mDirty(false),
       mWrittenOnce(false),
       mStartupWriteInitiated(false),
       mCurTableReferenced(false),
@@ -151,6 +157,7 @@ StartupCache::StartupCache()
       mPrefetchThread(nullptr) {}
 
 StartupCache::~StartupCache() {
+  WaitOnPrefetchThread();
   WaitOnWriteThread();
   UnregisterWeakMemoryReporter(this);
 }
@@ -242,9 +249,6 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
 
   MOZ_TRY(mCacheData.init(mFile));
   auto size = mCacheData.size();
-  if (CanPrefetchMemory()) {
-    StartPrefetchMemoryThread();
-  }
 
   uint32_t headerSize;
   if (size < sizeof(MAGIC) + sizeof(headerSize)) {
@@ -275,7 +279,9 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
     if (!mTable.reserve(STARTUP_CACHE_RESERVE_CAPACITY)) {
       return Err(NS_ERROR_UNEXPECTED);
     }
+    mPrefetchKeys.Clear();
     auto cleanup = MakeScopeExit([&]() {
+      mPrefetchKeys.Clear();
       mTable.clear();
       mCacheData.reset();
     });
@@ -317,6 +323,8 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
               StartupCacheEntry(offset, compressedSize, uncompressedSize))) {
         return Err(NS_ERROR_UNEXPECTED);
       }
+
+      mPrefetchKeys.AppendElement(key);
     }
 
     if (buf.error()) {
@@ -326,6 +334,13 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
     cleanup.release();
   }
 
+  // Start this only once the table is loaded: besides warming the mapping's
+  // pages, the thread also decompresses the leading entries, for which it
+  // needs mPrefetchKeys.
+  if (CanPrefetchMemory()) {
+    StartPrefetchMemoryThread();
+  }
+
   return Ok();
 }
 
@@ -351,58 +366,81 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
   auto telemetry =
       MakeScopeExit([&label] { Telemetry::AccumulateCategorical(label); });
 
-  decltype(mTable)::Ptr p = mTable.lookup(nsDependentCString(id));
-  if (!p) {
-    return NS_ERROR_NOT_AVAILABLE;
-  }
+  {
+    MutexAutoLock lock(mTableLock);
 
-  auto& value = p->value();
-  if (value.mData) {
-    label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitMemory;
-  } else {
-    if (!mCacheData.initialized()) {
+    decltype(mTable)::Ptr p = mTable.lookup(nsDependentCString(id));
+    if (!p) {
       return NS_ERROR_NOT_AVAILABLE;
     }
 
-    size_t totalRead = 0;
-    size_t totalWritten = 0;
-    Span<const char> compressed = MakeSpan(
-        mCacheData.get<char>().get() + mCacheEntriesBaseOffset + value.mOffset,
-        value.mCompressedSize);
-    value.mData = MakeUnique<char[]>(value.mUncompressedSize);
-    Span<char> uncompressed =
-        MakeSpan(value.mData.get(), value.mUncompressedSize);
-    bool finished = false;
-    while (!finished) {
-      auto result = mDecompressionContext->Decompress(
-          uncompressed.From(totalWritten), compressed.From(totalRead));
-      if (NS_WARN_IF(result.isErr())) {
-        value.mData = nullptr;
-        InvalidateCache();
-        return NS_ERROR_FAILURE;
+    auto& value = p->value();
+    if (value.mData) {
+      // Either requested before, or already materialized by the prefetch
+      // thread.
+      label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitMemory;
+    } else {
+      if (!mCacheData.initialized()) {
+        return NS_ERROR_NOT_AVAILABLE;
       }
-      auto decompressionResult = result.unwrap();
-      totalRead += decompressionResult.mSizeRead;
-      totalWritten += decompressionResult.mSizeWritten;
-      finished = decompressionResult.mFinished;
+
+      if (NS_FAILED(DecompressEntry(*mDecompressionContext, value))) {
+        // The entry is corrupt. Invalidate outside the lock below: doing it
+        // here would deadlock, as invalidation joins the prefetch thread,
+        // which takes mTableLock.
+        goto invalidate;
+      }
+
+      label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitDisk;
     }
 
-    label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitDisk;
+    if (!value.mRequested) {
+      value.mRequested = true;
+      value.mRequestedOrder = ++mRequestedCount;
+      MOZ_ASSERT(mRequestedCount <= mTable.count(),
+                 "Somehow we requested more StartupCache items than exist.");
+      ResetStartupWriteTimerCheckingReadCount();
+    }
+
+    // Track that something holds a reference into mTable, so we know to hold
+    // onto it in case the cache is invalidated.
+    mCurTableReferenced = true;
+    *outbuf = value.mData.get();
+    *length = value.mUncompressedSize;
+    return NS_OK;
   }
 
-  if (!value.mRequested) {
-    value.mRequested = true;
-    value.mRequestedOrder = ++mRequestedCount;
-    MOZ_ASSERT(mRequestedCount <= mTable.count(),
-               "Somehow we requested more StartupCache items than exist.");
-    ResetStartupWriteTimerCheckingReadCount();
+invalidate:
+  InvalidateCache();
+  return NS_ERROR_FAILURE;
+}
+
+nsresult StartupCache::DecompressEntry(LZ4FrameDecompressionContext& aContext,
+                                       StartupCacheEntry& aEntry) {
+  mTableLock.AssertCurrentThreadOwns();
+
+  size_t totalRead = 0;
+  size_t totalWritten = 0;
+  Span<const char> compressed = MakeSpan(
+      mCacheData.get<char>().get() + mCacheEntriesBaseOffset + aEntry.mOffset,
+      aEntry.mCompressedSize);
+  aEntry.mData = MakeUnique<char[]>(aEntry.mUncompressedSize);
+  Span<char> uncompressed =
+      MakeSpan(aEntry.mData.get(), aEntry.mUncompressedSize);
+  bool finished = false;
+  while (!finished) {
+    auto result = aContext.Decompress(uncompressed.From(totalWritten),
+                                      compressed.From(totalRead));
+    if (NS_WARN_IF(result.isErr())) {
+      aEntry.mData = nullptr;
+      return NS_ERROR_FAILURE;
+    }
+    auto decompressionResult = result.unwrap();
+    totalRead += decompressionResult.mSizeRead;
+    totalWritten += decompressionResult.mSizeWritten;
+    finished = decompressionResult.mFinished;
   }
 
-  // Track that something holds a reference into mTable, so we know to hold
-  // onto it in case the cache is invalidated.
-  mCurTableReferenced = true;
-  *outbuf = value.mData.get();
-  *length = value.mUncompressedSize;
   return NS_OK;
 }
 
@@ -416,6 +454,10 @@ nsresult StartupCache::PutBuffer(const char* id, UniquePtr<char[]>&& inbuf,
     return NS_ERROR_NOT_AVAILABLE;
   }
 
+  // The prefetch thread holds this while it walks mTable; adding entries
+  // must not race with it.
+  MutexAutoLock lock(mTableLock);
+
   bool exists = mTable.has(nsDependentCString(id));
 
   if (exists) {
@@ -563,6 +605,9 @@ Result<Ok, nsresult> StartupCache::WriteToDisk() {
 
 void StartupCache::InvalidateCache(bool memoryOnly) {
   WaitOnWriteThread();
+  // The prefetch thread reads mCacheData and writes into mTable's entries;
+  // neither may be torn down under it.
+  WaitOnPrefetchThread();
   mWrittenOnce = false;
   if (memoryOnly) {
     auto writeResult = WriteToDisk();
@@ -641,9 +686,49 @@ void StartupCache::ThreadedPrefetch(void* aClosure) {
   StartupCache* startupCacheObj = static_cast<StartupCache*>(aClosure);
   PrefetchMemory(startupCacheObj->mCacheData.get<uint8_t>().get(),
                  startupCacheObj->mCacheData.size());
+  startupCacheObj->DecompressPrefetchedEntries();
   mozilla::IOInterposer::UnregisterCurrentThread();
 }
 
+/**
+ * Entries are laid out in the cache file in the order the previous session
+ * first requested them (see WriteToDisk), so the front of the file doubles
+ * as a manifest of what the next startup will ask for first. Materialize
+ * those entries here, ahead of the requests, so that GetBuffer() on the
+ * main thread finds them already decompressed instead of inflating them
+ * one by one in the startup critical path.
+ */
+void StartupCache::DecompressPrefetchedEntries() {
+  LZ4FrameDecompressionContext context(true);
+
+  size_t budget = STARTUP_CACHE_PREFETCH_DECOMPRESS_BYTES;
+  for (const auto& key : mPrefetchKeys) {
+    MutexAutoLock lock(mTableLock);
+
+    if (!mCacheData.initialized()) {
+      // The cache went away under us; nothing left to warm up.
+      return;
+    }
+
+    decltype(mTable)::Ptr p = mTable.lookup(key);
+    if (!p || p->value().mData) {
+      continue;
+    }
+
+    auto& value = p->value();
+    if (value.mUncompressedSize > budget) {
+      return;
+    }
+    budget -= value.mUncompressedSize;
+
+    if (NS_FAILED(DecompressEntry(context, value))) {
+      // Corrupt data. Leave invalidation to the main thread, which will
+      // trip over the same entry; it cannot be done from here.
+      return;
+    }
+  }
+}
+
 void StartupCache::ThreadedWrite(void* aClosure) {
   AUTO_PROFILER_REGISTER_THREAD("StartupCache");
   NS_SetCurrentThreadName("StartupCache");
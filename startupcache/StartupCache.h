@@ -20,6 +20,7 @@
 #include "mozilla/AutoMemMap.h"
 #include "mozilla/Compression.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/Mutex.h"
 #include "mozilla/Pair.h"
 #include "mozilla/Result.h"
 #include "mozilla/UniquePtr.h"
@@ -210,12 +211,29 @@ class StartupCache : public nsIMemoryReporter {
   void StartPrefetchMemoryThread();
   void MaybeSpawnWriteThread();
 
+  // Decompresses a single entry out of the mapped cache file into
+  // aEntry.mData. Called with mTableLock held.
+  nsresult DecompressEntry(Compression::LZ4FrameDecompressionContext& aContext,
+                           StartupCacheEntry& aEntry);
+  // Materializes the entries at the front of the cache file - the ones the
+  // previous session requested first - ahead of this session's requests.
+  // Runs on the prefetch thread.
+  void DecompressPrefetchedEntries();
+
   static nsresult InitSingleton();
   static void WriteTimeout(nsITimer* aTimer, void* aClosure);
   static void ThreadedWrite(void* aClosure);
   static void ThreadedPrefetch(void* aClosure);
 
+  // Protects mTable's structure against the main thread mutating it while
+  // the prefetch thread reads it, and entry mData against being filled in
+  // by both threads at once. Uncontended once the prefetch thread is done.
+  Mutex mTableLock;
   HashMap<nsCString, StartupCacheEntry, nsCStringHasher> mTable;
+  // Entry keys in cache file order, i.e. in the order the previous session
+  // first requested them. Filled by LoadArchive, consumed by the prefetch
+  // thread.
+  nsTArray<nsCString> mPrefetchKeys;
   // owns references to the contents of tables which have been invalidated.
   // In theory grows forever if the cache is continually filled and then
   // invalidated, but this should not happen in practice.
@@ -4,6 +4,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+
 #include "nsAutoPtr.h"
 
 #include "sqlite3.h"
@@ -35,9 +37,18 @@ namespace storage {
  * consumers are trying to avoid blocking their execution thread for long
  * periods of time, and dispatching many small events to the calling thread will
  * end up blocking it.
+ *
+ * MAX_ROWS_PER_RESULT is only the initial batch size; it doubles after each
+ * delivered result set, up to MAX_ROWS_PER_RESULT_LIMIT.  Queries returning
+ * a handful of rows still see them after at most 15, but a multi-thousand-row
+ * analytical query converges to a few large dispatches instead of hundreds of
+ * small ones, each of which costs a cross-thread runnable and a callback
+ * invocation.  MAX_MILLISECONDS_BETWEEN_RESULTS still bounds the latency of
+ * every batch regardless of its size.
  */
 #define MAX_MILLISECONDS_BETWEEN_RESULTS 75
 #define MAX_ROWS_PER_RESULT 15
+#define MAX_ROWS_PER_RESULT_LIMIT 1920
 
 ////////////////////////////////////////////////////////////////////////////////
 //// AsyncExecuteStatements
@@ -84,6 +95,7 @@ AsyncExecuteStatements::AsyncExecuteStatements(
       mMaxWait(
           TimeDuration::FromMilliseconds(MAX_MILLISECONDS_BETWEEN_RESULTS)),
       mIntervalStart(TimeStamp::Now()),
+      mMaxRowsPerResult(MAX_ROWS_PER_RESULT),
       mState(PENDING),
       mCancelRequested(false),
       mMutex(aConnection->sharedAsyncExecutionMutex),
@@ -289,11 +301,17 @@ nsresult AsyncExecuteStatements::buildAndNotifyResults(
   // calling thread about it.
   TimeStamp now = TimeStamp::Now();
   TimeDuration delta = now - mIntervalStart;
-  if (mResultSet->rows() >= MAX_ROWS_PER_RESULT || delta > mMaxWait) {
+  if (mResultSet->rows() >= mMaxRowsPerResult || delta > mMaxWait) {
     // Notify the caller
     rv = notifyResults();
     if (NS_FAILED(rv)) return NS_OK;  // we'll try again with the next result
 
+    // Each delivered set doubles the size of the next one, so that
+    // long-running queries settle into a few large dispatches rather than
+    // many small ones.  mMaxWait above keeps the latency bounded.
+    mMaxRowsPerResult = std::min(mMaxRowsPerResult * 2,
+                                 uint32_t(MAX_ROWS_PER_RESULT_LIMIT));
+
     // Reset our start time
     mIntervalStart = now;
   }
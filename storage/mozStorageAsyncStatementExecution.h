@@ -209,6 +209,15 @@ class AsyncExecuteStatements final : public nsIRunnable,
    */
   TimeStamp mIntervalStart;
 
+  /**
+   * How many rows to accumulate before notifying the calling thread.
+   * Starts at MAX_ROWS_PER_RESULT and doubles after every delivered set,
+   * up to MAX_ROWS_PER_RESULT_LIMIT, so long-running analytical queries
+   * don't drown the calling thread in small dispatches while short
+   * queries keep their low first-result latency.
+   */
+  uint32_t mMaxRowsPerResult;
+
   /**
    * Indicates our state of execution.
    */
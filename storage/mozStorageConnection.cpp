@@ -765,6 +765,19 @@ nsresult Connection::initializeInternal() {
     return convertResultCode(srv);
   }
 
+  // Optionally let SQLite read the database through memory-mapped I/O,
+  // avoiding the copy into the page cache for pages that are only read.
+  // This is safe with WAL: SQLite only maps for reading and keeps writes
+  // on the normal xWrite path. Failure is non-fatal; some VFS stacks just
+  // refuse the pragma.
+  int64_t mmapSizeKiB = Service::getDefaultMmapSizeKiB();
+  if (mmapSizeKiB > 0) {
+    nsAutoCString mmapSizeQuery(MOZ_STORAGE_UNIQUIFY_QUERY_STR
+                                "PRAGMA mmap_size = ");
+    mmapSizeQuery.AppendInt(mmapSizeKiB * 1024);
+    (void)executeSql(mDBConn, mmapSizeQuery.get());
+  }
+
   // Register our built-in SQL functions.
   srv = registerFunctions(mDBConn);
   if (srv != SQLITE_OK) {
@@ -1027,6 +1040,24 @@ nsresult Connection::internalClose(sqlite3* aNativeConnection) {
   // Nothing else needs to be done if we don't have a connection here.
   if (!aNativeConnection) return NS_OK;
 
+  // Report how effective this connection's page cache was over its
+  // lifetime, keyed by database, so cache_size can be tuned from field
+  // data rather than guesses.
+  {
+    int hitCount = 0, missCount = 0, unused = 0;
+    if (::sqlite3_db_status(aNativeConnection, SQLITE_DBSTATUS_CACHE_HIT,
+                            &hitCount, &unused, 0) == SQLITE_OK &&
+        ::sqlite3_db_status(aNativeConnection, SQLITE_DBSTATUS_CACHE_MISS,
+                            &missCount, &unused, 0) == SQLITE_OK) {
+      int64_t totalCount = int64_t(hitCount) + missCount;
+      if (totalCount > 0) {
+        Telemetry::Accumulate(Telemetry::MOZ_SQLITE_CACHE_HIT_RATIO,
+                              mTelemetryFilename,
+                              uint32_t(int64_t(hitCount) * 100 / totalCount));
+      }
+    }
+  }
+
   int srv = ::sqlite3_close(aNativeConnection);
 
   if (srv == SQLITE_BUSY) {
@@ -44,6 +44,12 @@
 // third_party/sqlite3/src/Makefile.in.
 #define PREF_TS_PAGESIZE_DEFAULT 32768
 
+// How many kibibytes of each database file SQLite may access through
+// memory-mapped I/O, applied to every connection through PRAGMA mmap_size.
+// 0 keeps mmap disabled, which remains the default.
+#define PREF_TS_MMAPSIZE "toolkit.storage.mmapSize"
+#define PREF_TS_MMAPSIZE_DEFAULT 0
+
 namespace mozilla {
 namespace storage {
 
@@ -202,6 +208,8 @@ int32_t Service::getSynchronousPref() { return sSynchronousPref; }
 
 int32_t Service::sDefaultPageSize = PREF_TS_PAGESIZE_DEFAULT;
 
+int32_t Service::sDefaultMmapSizeKiB = PREF_TS_MMAPSIZE_DEFAULT;
+
 Service::Service()
     : mMutex("Service::mMutex"),
       mSqliteVFS(nullptr),
@@ -358,6 +366,10 @@ nsresult Service::initialize() {
   sDefaultPageSize =
       Preferences::GetInt(PREF_TS_PAGESIZE, PREF_TS_PAGESIZE_DEFAULT);
 
+  // Like the above, cached on the main thread for all future connections.
+  sDefaultMmapSizeKiB =
+      Preferences::GetInt(PREF_TS_MMAPSIZE, PREF_TS_MMAPSIZE_DEFAULT);
+
   mozilla::RegisterWeakMemoryReporter(this);
   mozilla::RegisterStorageSQLiteDistinguishedAmount(
       StorageSQLiteDistinguishedAmount);
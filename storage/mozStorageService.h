@@ -68,6 +68,13 @@ class Service : public mozIStorageService,
    */
   static int32_t getDefaultPageSize() { return sDefaultPageSize; }
 
+  /**
+   * Obtains how many kibibytes of a database file connections may access
+   * through memory-mapped I/O. 0 (the default) means mmap is disabled.
+   * Controlled by the PREF_TS_MMAPSIZE hidden preference.
+   */
+  static int32_t getDefaultMmapSizeKiB() { return sDefaultMmapSizeKiB; }
+
   /**
    * Returns a boolean value indicating whether or not the given page size is
    * valid (currently understood as a power of 2 between 512 and 65536).
@@ -169,6 +176,7 @@ class Service : public mozIStorageService,
 
   static int32_t sSynchronousPref;
   static int32_t sDefaultPageSize;
+  static int32_t sDefaultMmapSizeKiB;
 };
 
 }  // namespace storage
@@ -58,4 +58,17 @@ struct InputFormData {
   int32_t numXPath;
 };
 
+/*
+ * The form data collected from one frame on the last pass. A frame whose
+ * form data hasn't changed since then can be emitted again from this cache
+ * without walking its form controls.
+ * "descendants" of the cached InputFormData is always 0; the frame tree
+ * shape is recomputed on every pass.
+ */
+struct CollectedFrameFormData {
+  InputFormData input;
+  nsTArray<CollectedInputDataValue> idVals;
+  nsTArray<CollectedInputDataValue> xPathVals;
+};
+
 #endif /* mozilla_dom_SessionStoreData_h */
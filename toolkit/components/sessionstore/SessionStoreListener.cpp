@@ -113,9 +113,20 @@ void ContentSessionStore::ResetStorageChanges() {
   mValues.Clear();
 }
 
+void ContentSessionStore::ResetFrameCaches() {
+  // The next update needs to collect every frame afresh, both because the
+  // set of frames is changing and because the cached data of the old
+  // document must not be reused for the new one.
+  mDirtyScrollWindows.Clear();
+  mDirtyFormWindows.Clear();
+  mCachedPositions.Clear();
+  mCachedFormData.Clear();
+}
+
 void ContentSessionStore::OnDocumentStart() {
   mScrollChanged = PAGELOADEDSTART;
   mFormDataChanged = PAGELOADEDSTART;
+  ResetFrameCaches();
   nsCString caps = CollectDocShellCapabilities();
   if (!mDocCaps.Equals(caps)) {
     mDocCaps = caps;
@@ -127,6 +138,7 @@ void ContentSessionStore::OnDocumentStart() {
 
 void ContentSessionStore::OnDocumentEnd() {
   mScrollChanged = WITH_CHANGE;
+  ResetFrameCaches();
   SetFullStorageNeeded();
 }
 
@@ -322,13 +334,20 @@ TabListener::HandleEvent(Event* aEvent) {
     return NS_OK;
   }
 
+  // The change only dirties the frame the event came from, so only that
+  // frame is re-collected on the next update.
+  uint64_t windowID = 0;
+  if (nsPIDOMWindowInner* innerWindow = outer->GetCurrentInnerWindow()) {
+    windowID = innerWindow->WindowID();
+  }
+
   nsAutoString eventType;
   aEvent->GetType(eventType);
   if (eventType.EqualsLiteral("mozvisualscroll")) {
-    mSessionStore->SetScrollPositionChanged();
+    mSessionStore->SetScrollPositionChanged(windowID);
     AddTimerForUpdate();
   } else if (eventType.EqualsLiteral("input")) {
-    mSessionStore->SetFormDataChanged();
+    mSessionStore->SetFormDataChanged(windowID);
     AddTimerForUpdate();
   } else if (eventType.EqualsLiteral("MozSessionStorageChanged")) {
     auto event = static_cast<StorageEvent*>(aEvent);
@@ -441,6 +460,8 @@ nsCString CollectPosition(Document& aDocument) {
 }
 
 int CollectPositions(BrowsingContext* aBrowsingContext,
+                     nsTHashtable<nsUint64HashKey>& aDirtyWindows,
+                     nsDataHashtable<nsUint64HashKey, nsCString>& aCache,
                      nsTArray<nsCString>& aPositions,
                      nsTArray<int32_t>& aPositionDescendants) {
   nsPIDOMWindowOuter* window = aBrowsingContext->GetDOMWindow();
@@ -458,16 +479,27 @@ int CollectPositions(BrowsingContext* aBrowsingContext,
     return 0;
   }
 
-  /* Collect data from current frame */
-  aPositions.AppendElement(CollectPosition(*document));
+  /* Collect data from current frame, reusing the cached position if the
+     frame didn't change since the last pass */
+  nsPIDOMWindowInner* innerWindow = document->GetInnerWindow();
+  uint64_t windowID = innerWindow ? innerWindow->WindowID() : 0;
+  nsCString position;
+  if (!windowID || aDirtyWindows.Contains(windowID) ||
+      !aCache.Get(windowID, &position)) {
+    position = CollectPosition(*document);
+    if (windowID) {
+      aCache.Put(windowID, position);
+    }
+  }
+  aPositions.AppendElement(position);
   aPositionDescendants.AppendElement(0);
   unsigned long currentIdx = aPositions.Length() - 1;
 
   /* Collect data from all child frame */
   // This is not going to work for fission. Bug 1572084 for tracking it.
   for (auto& child : aBrowsingContext->GetChildren()) {
-    aPositionDescendants[currentIdx] +=
-        CollectPositions(child, aPositions, aPositionDescendants);
+    aPositionDescendants[currentIdx] += CollectPositions(
+        child, aDirtyWindows, aCache, aPositions, aPositionDescendants);
   }
 
   return aPositionDescendants[currentIdx] + 1;
@@ -479,9 +511,10 @@ void ContentSessionStore::GetScrollPositions(
     aPositionDescendants.AppendElement(0);
     aPositions.AppendElement(EmptyCString());
   } else {
-    CollectPositions(mDocShell->GetBrowsingContext(), aPositions,
-                     aPositionDescendants);
+    CollectPositions(mDocShell->GetBrowsingContext(), mDirtyScrollWindows,
+                     mCachedPositions, aPositions, aPositionDescendants);
   }
+  mDirtyScrollWindows.Clear();
   mScrollChanged = NO_CHANGE;
 }
 
@@ -524,10 +557,13 @@ void CollectInput(Document& aDocument, InputFormData& aInput,
   aInput.numXPath = numXPath;
 }
 
-int CollectInputs(BrowsingContext* aBrowsingContext,
-                  nsTArray<InputFormData>& aInputs,
-                  nsTArray<CollectedInputDataValue>& aIdVals,
-                  nsTArray<CollectedInputDataValue>& aXPathVals) {
+int CollectInputs(
+    BrowsingContext* aBrowsingContext,
+    nsTHashtable<nsUint64HashKey>& aDirtyWindows,
+    nsClassHashtable<nsUint64HashKey, CollectedFrameFormData>& aCache,
+    nsTArray<InputFormData>& aInputs,
+    nsTArray<CollectedInputDataValue>& aIdVals,
+    nsTArray<CollectedInputDataValue>& aXPathVals) {
   nsPIDOMWindowOuter* window = aBrowsingContext->GetDOMWindow();
   if (!window) {
     return 0;
@@ -543,20 +579,43 @@ int CollectInputs(BrowsingContext* aBrowsingContext,
     return 0;
   }
 
-  /* Collect data from current frame */
+  /* Collect data from current frame, reusing the cached form data if the
+     frame didn't change since the last pass */
+  nsPIDOMWindowInner* innerWindow = document->GetInnerWindow();
+  uint64_t windowID = innerWindow ? innerWindow->WindowID() : 0;
+  CollectedFrameFormData* cached = windowID && !aDirtyWindows.Contains(windowID)
+                                       ? aCache.Get(windowID)
+                                       : nullptr;
   InputFormData input;
   input.descendants = 0;
-  input.numId = 0;
-  input.numXPath = 0;
-  CollectInput(*document, input, aIdVals, aXPathVals);
+  if (cached) {
+    input = cached->input;
+    aIdVals.AppendElements(cached->idVals);
+    aXPathVals.AppendElements(cached->xPathVals);
+  } else {
+    input.numId = 0;
+    input.numXPath = 0;
+    unsigned long firstId = aIdVals.Length();
+    unsigned long firstXPath = aXPathVals.Length();
+    CollectInput(*document, input, aIdVals, aXPathVals);
+    if (windowID) {
+      auto entry = MakeUnique<CollectedFrameFormData>();
+      entry->input = input;
+      entry->idVals.AppendElements(aIdVals.Elements() + firstId,
+                                   aIdVals.Length() - firstId);
+      entry->xPathVals.AppendElements(aXPathVals.Elements() + firstXPath,
+                                      aXPathVals.Length() - firstXPath);
+      aCache.Put(windowID, std::move(entry));
+    }
+  }
   aInputs.AppendElement(input);
   unsigned long currentIdx = aInputs.Length() - 1;
 
   /* Collect data from all child frame */
   // This is not going to work for fission. Bug 1572084 for tracking it.
   for (auto& child : aBrowsingContext->GetChildren()) {
-    aInputs[currentIdx].descendants +=
-        CollectInputs(child, aInputs, aIdVals, aXPathVals);
+    aInputs[currentIdx].descendants += CollectInputs(
+        child, aDirtyWindows, aCache, aInputs, aIdVals, aXPathVals);
   }
 
   return aInputs[currentIdx].descendants + 1;
@@ -577,9 +636,11 @@ nsTArray<InputFormData> ContentSessionStore::GetInputs(
     inputs.AppendElement(input);
   } else {
     mFormDataChanged = NO_CHANGE;
-    CollectInputs(nsDocShell::Cast(mDocShell)->GetBrowsingContext(), inputs,
-                  aIdVals, aXPathVals);
+    CollectInputs(nsDocShell::Cast(mDocShell)->GetBrowsingContext(),
+                  mDirtyFormWindows, mCachedFormData, inputs, aIdVals,
+                  aXPathVals);
   }
+  mDirtyFormWindows.Clear();
   return inputs;
 }
 
@@ -7,9 +7,13 @@
 #ifndef mozilla_dom_SessionStoreListener_h
 #define mozilla_dom_SessionStoreListener_h
 
+#include "nsClassHashtable.h"
+#include "nsDataHashtable.h"
+#include "nsHashKeys.h"
 #include "nsIDOMEventListener.h"
 #include "nsIPrivacyTransitionObserver.h"
 #include "nsIWebProgressListener.h"
+#include "nsTHashtable.h"
 #include "SessionStoreData.h"
 
 class nsITimer;
@@ -30,11 +34,24 @@ class ContentSessionStore {
   nsCString GetDocShellCaps();
   bool IsPrivateChanged() { return mPrivateChanged; }
   bool GetPrivateModeEnabled();
-  void SetScrollPositionChanged() { mScrollChanged = WITH_CHANGE; }
+  /*
+    Scroll position and form data changes are tracked per frame, keyed by
+    the inner window ID of the frame where the change was observed, so that
+    an update only re-collects the frames which actually changed and reuses
+    the cached data of the other frames. A window ID of 0 stands for an
+    unknown frame and such frames are always re-collected.
+   */
+  void SetScrollPositionChanged(uint64_t aWindowID) {
+    mScrollChanged = WITH_CHANGE;
+    mDirtyScrollWindows.PutEntry(aWindowID);
+  }
   bool IsScrollPositionChanged() { return mScrollChanged != NO_CHANGE; }
   void GetScrollPositions(nsTArray<nsCString>& aPositions,
                           nsTArray<int32_t>& aPositionDescendants);
-  void SetFormDataChanged() { mFormDataChanged = WITH_CHANGE; }
+  void SetFormDataChanged(uint64_t aWindowID) {
+    mFormDataChanged = WITH_CHANGE;
+    mDirtyFormWindows.PutEntry(aWindowID);
+  }
   bool IsFormDataChanged() { return mFormDataChanged != NO_CHANGE; }
   nsTArray<InputFormData> GetInputs(
       nsTArray<CollectedInputDataValue>& aIdVals,
@@ -75,8 +92,18 @@ class ContentSessionStore {
  private:
   virtual ~ContentSessionStore() = default;
   nsCString CollectDocShellCapabilities();
+  void ResetFrameCaches();
 
   nsCOMPtr<nsIDocShell> mDocShell;
+  // Inner window IDs of the frames whose scroll position or form data
+  // changed since the last update, and the data collected from each frame
+  // on the last pass. Both are reset when the top-level document starts or
+  // stops loading, so stale entries of navigated-away frames don't outlive
+  // the page.
+  nsTHashtable<nsUint64HashKey> mDirtyScrollWindows;
+  nsTHashtable<nsUint64HashKey> mDirtyFormWindows;
+  nsDataHashtable<nsUint64HashKey, nsCString> mCachedPositions;
+  nsClassHashtable<nsUint64HashKey, CollectedFrameFormData> mCachedFormData;
   bool mPrivateChanged;
   bool mIsPrivate;
   enum {
@@ -89,8 +89,24 @@ static void EnsureBernoulliIsInstalled() {
   if (!gBernoulli) {
     // This is only installed once. See the gBernoulli definition for more
     // information.
-    gBernoulli =
-        new FastBernoulliTrial(0.0003, 0x8e26eeee166bc8ca, 0x56820f304a9c9ae0);
+    double probability = 0.0003;
+
+    // The sampling rate can be tuned at runtime, so that allocation churn can
+    // be diagnosed in the field at whatever overhead is acceptable there. The
+    // value is the mean number of allocated bytes between sampled stacks, so
+    // larger values mean fewer samples and less overhead.
+    const char* sampleBytes =
+        getenv("MOZ_PROFILER_NATIVE_ALLOCATION_SAMPLE_BYTES");
+    if (sampleBytes && sampleBytes[0] != '\0') {
+      errno = 0;
+      long bytes = strtol(sampleBytes, nullptr, 10);
+      if (errno == 0 && bytes > 0) {
+        probability = 1.0 / static_cast<double>(bytes);
+      }
+    }
+
+    gBernoulli = new FastBernoulliTrial(probability, 0x8e26eeee166bc8ca,
+                                        0x56820f304a9c9ae0);
   }
 }
 
@@ -2597,6 +2597,12 @@ static void PrintUsageThenExit(int aExitCode) {
       "  measured in milliseconds, when the profiler is first started.\n"
       "  If unset, the platform default is used.\n"
       "\n"
+      "  MOZ_PROFILER_NATIVE_ALLOCATION_SAMPLE_BYTES=<1..>\n"
+      "  When the native allocations feature is enabled, specifies the mean\n"
+      "  number of allocated bytes between sampled allocation stacks.\n"
+      "  Smaller values sample more allocations, at a higher overhead.\n"
+      "  If unset, a probability of 0.0003 per allocated byte is used.\n"
+      "\n"
       "  MOZ_PROFILER_STARTUP_FEATURES_BITFIELD=<Number>\n"
       "  If MOZ_PROFILER_STARTUP is set, specifies the profiling features, as\n"
       "  the integer value of the features bitfield.\n"
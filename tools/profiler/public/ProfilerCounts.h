@@ -12,7 +12,7 @@
 #  define PROFILER_DEFINE_COUNT_TOTAL(label, category, description)
 #  define PROFILER_DEFINE_COUNT(label, category, description)
 #  define PROFILER_DEFINE_STATIC_COUNT_TOTAL(label, category, description)
-#  define AUTO_PROFILER_TOTAL(label, count)
+#  define AUTO_PROFILER_COUNT_TOTAL(label, count)
 #  define AUTO_PROFILER_COUNT(label)
 #  define AUTO_PROFILER_STATIC_COUNT(label, count)
 
@@ -13,9 +13,11 @@
 #include "mozilla/dom/HTMLLinkElement.h"
 #include "mozilla/dom/ServiceWorkerDescriptor.h"
 #include "mozilla/Preferences.h"
+#include "mozilla/StaticPrefs_network.h"
 #include "ReferrerInfo.h"
 
 #include "nsIObserverService.h"
+#include "nsIClassOfService.h"
 #include "nsIWebProgress.h"
 #include "nsICacheInfoChannel.h"
 #include "nsIHttpChannel.h"
@@ -142,6 +144,24 @@ nsresult nsPrefetchNode::OpenChannel() {
     priorityChannel->AdjustPriority(nsISupportsPriority::PRIORITY_LOWEST);
   }
 
+  // Prefetches compete with the page the user is actually looking at, so
+  // hand them to the connection manager as speculative bulk traffic: they
+  // are throttled while active loads are consuming bandwidth and, with
+  // tailing enabled, don't get a connection until the page load's own
+  // requests have had theirs.  Preloads are needed by the current page and
+  // keep their normal scheduling.
+  if (!mPreload) {
+    nsCOMPtr<nsIClassOfService> cos = do_QueryInterface(mChannel);
+    if (cos) {
+      uint32_t classFlags =
+          nsIClassOfService::Speculative | nsIClassOfService::Throttleable;
+      if (StaticPrefs::network_http_tailing_enabled()) {
+        classFlags |= nsIClassOfService::Tail;
+      }
+      cos->AddClassFlags(classFlags);
+    }
+  }
+
   rv = mChannel->AsyncOpen(this);
   if (NS_WARN_IF(NS_FAILED(rv))) {
     // Drop the ref to the channel, because we don't want to end up with
@@ -158,6 +178,19 @@ nsresult nsPrefetchNode::CancelChannel(nsresult error) {
   return NS_OK;
 }
 
+void nsPrefetchNode::BoostPriority() {
+  nsCOMPtr<nsISupportsPriority> priorityChannel = do_QueryInterface(mChannel);
+  if (priorityChannel) {
+    priorityChannel->SetPriority(nsISupportsPriority::PRIORITY_LOW);
+  }
+
+  nsCOMPtr<nsIClassOfService> cos = do_QueryInterface(mChannel);
+  if (cos) {
+    cos->ClearClassFlags(nsIClassOfService::Throttleable |
+                         nsIClassOfService::Tail);
+  }
+}
+
 //-----------------------------------------------------------------------------
 // nsPrefetchNode::nsISupports
 //-----------------------------------------------------------------------------
@@ -716,6 +749,10 @@ nsresult nsPrefetchService::Prefetch(nsIURI* aURI,
             ("URL is already being prefetched, add a new reference "
              "document\n"));
         mCurrentNodes[i]->mSources.AppendElement(source);
+        // A repeated request (e.g. the front end re-requesting the link the
+        // user is hovering) is a strong hint the resource will actually be
+        // needed; stop treating the in-flight load as bulk traffic.
+        mCurrentNodes[i]->BoostPriority();
         return NS_OK;
       } else {
         LOG(("URL is already being prefetched by this document"));
@@ -739,6 +776,10 @@ nsresult nsPrefetchService::Prefetch(nsIURI* aURI,
             ("URL is already being prefetched, add a new reference "
              "document\n"));
         node->mSources.AppendElement(do_GetWeakReference(aSource));
+        // Requested again while still queued; serve it ahead of the rest of
+        // the queue.
+        mPrefetchQueue.erase(nodeIt);
+        mPrefetchQueue.push_front(node);
         return NS_OK;
       } else {
         LOG(("URL is already being prefetched by this document"));
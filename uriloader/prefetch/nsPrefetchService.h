@@ -107,6 +107,11 @@ class nsPrefetchNode final : public nsIStreamListener,
   nsresult OpenChannel();
   nsresult CancelChannel(nsresult error);
 
+  // Raises the network priority of an in-flight prefetch and stops treating
+  // it as bulk background traffic.  Called when the resource is requested
+  // again, which is a strong hint that it will be needed soon.
+  void BoostPriority();
+
   nsCOMPtr<nsIURI> mURI;
   nsCOMPtr<nsIReferrerInfo> mReferrerInfo;
   nsTArray<nsWeakPtr> mSources;
@@ -100,6 +100,13 @@ class nsViewManager final {
    */
   void FlushDelayedResize(bool aDoReflow);
 
+  /**
+   * Whether there's a resize pending that FlushDelayedResize would process.
+   */
+  bool HasDelayedResize() const {
+    return mDelayedResize != nsSize(NSCOORD_NONE, NSCOORD_NONE);
+  }
+
   /**
    * Called to inform the view manager that the entire area of a view
    * is dirty and needs to be redrawn.
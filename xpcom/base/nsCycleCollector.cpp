@@ -162,6 +162,7 @@
 /* This must occur *after* base/process_util.h to avoid typedefs conflicts. */
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <utility>
 
@@ -193,6 +194,7 @@
 #include "nsThreadUtils.h"
 #include "nsXULAppAPI.h"
 #include "prenv.h"
+#include "prthread.h"
 #include "xpcpublic.h"
 
 using namespace mozilla;
@@ -729,6 +731,22 @@ class NodePool {
     PtrInfo*& mLast;
   };
 
+  struct BlockRange {
+    PtrInfo* mBegin;
+    PtrInfo* mEnd;
+  };
+
+  // Collect the contiguous entry range of every block, so the pool can be
+  // partitioned across scanning threads.  Must not be called while a Builder
+  // is attached.
+  void GetBlockRanges(nsTArray<BlockRange>& aRanges) const {
+    for (NodeBlock* b = mBlocks; b; b = b->mNext) {
+      PtrInfo* begin = b->mEntries;
+      PtrInfo* end = b->mNext ? begin + NodeBlockSize : mLast;
+      aRanges.AppendElement(BlockRange{begin, end});
+    }
+  }
+
   size_t SizeOfExcludingThis(MallocSizeOf aMallocSizeOf) const {
     // We don't measure the things pointed to by mEntries[] because those
     // pointers are non-owning.
@@ -1196,6 +1214,7 @@ class nsCycleCollector : public nsIMemoryReporter {
   void ScanRoots(bool aFullySynchGraphBuild);
   void ScanIncrementalRoots();
   void ScanWhiteNodes(bool aFullySynchGraphBuild);
+  bool ScanWhiteNodesParallel(bool aFullySynchGraphBuild);
   void ScanBlackNodes();
   void ScanWeakMaps();
 
@@ -2882,43 +2901,155 @@ void nsCycleCollector::ScanIncrementalRoots() {
   }
 }
 
+// The per-node logic of ScanWhiteNodes, shared between the serial pass and
+// the parallel workers.  Returns true if the node was marked white.
+static bool ScanWhiteNode(PtrInfo* aPi, bool aFullySynchGraphBuild) {
+  if (aPi->mColor == black) {
+    // Incremental roots can be in a nonsensical state, so don't
+    // check them. This will miss checking nodes that are merely
+    // reachable from incremental roots.
+    MOZ_ASSERT(!aFullySynchGraphBuild,
+               "In a synch CC, no nodes should be marked black early on.");
+    return false;
+  }
+  MOZ_ASSERT(aPi->mColor == grey);
+
+  if (!aPi->WasTraversed()) {
+    // This node was deleted before it was traversed, so there's no reason
+    // to look at it.
+    MOZ_ASSERT(!aPi->mParticipant, "Live nodes should all have been traversed");
+    return false;
+  }
+
+  if (aPi->mInternalRefs == aPi->mRefCount || aPi->IsGrayJS()) {
+    aPi->mColor = white;
+    return true;
+  }
+
+  aPi->AnnotatedReleaseAssert(
+      aPi->mInternalRefs <= aPi->mRefCount,
+      "More references to an object than its refcount");
+
+  // This node will get marked black in the next pass.
+  return false;
+}
+
+// A worker's share of the white-node scan: a slice of the node pool's block
+// ranges, and the number of nodes this worker marked white.
+struct ScanWhiteNodesTask {
+  const NodePool::BlockRange* mRanges;
+  size_t mRangeCount;
+  bool mFullySynchGraphBuild;
+  uint32_t mWhiteCount;
+};
+
+static void ScanWhiteNodesTaskRun(ScanWhiteNodesTask* aTask) {
+  uint32_t whiteCount = 0;
+  for (size_t i = 0; i < aTask->mRangeCount; ++i) {
+    for (PtrInfo* pi = aTask->mRanges[i].mBegin; pi != aTask->mRanges[i].mEnd;
+         ++pi) {
+      if (ScanWhiteNode(pi, aTask->mFullySynchGraphBuild)) {
+        ++whiteCount;
+      }
+    }
+  }
+  aTask->mWhiteCount = whiteCount;
+}
+
+static void ScanWhiteNodesThreadFunc(void* aArg) {
+  NS_SetCurrentThreadName("CC Scan");
+  ScanWhiteNodesTaskRun(static_cast<ScanWhiteNodesTask*>(aArg));
+}
+
+// The number of threads (including the main thread) the white-node scan may
+// use, from MOZ_CC_PARALLEL_SCAN.  0 or unset leaves the scan serial.
+static uint32_t CCParallelScanThreadCount() {
+  static int32_t sThreadCount = -1;
+  if (sThreadCount < 0) {
+    sThreadCount = 0;
+    if (const char* env = PR_GetEnv("MOZ_CC_PARALLEL_SCAN")) {
+      int32_t count = atoi(env);
+      // More threads than this just contend on memory bandwidth.
+      sThreadCount = count < 0 ? 0 : (count > 8 ? 8 : count);
+    }
+  }
+  return sThreadCount;
+}
+
 // Mark nodes white and make sure their refcounts are ok.
 // No nodes are marked black during this pass to ensure that refcount
 // checking is run on all nodes not marked black by ScanIncrementalRoots.
 void nsCycleCollector::ScanWhiteNodes(bool aFullySynchGraphBuild) {
+  if (ScanWhiteNodesParallel(aFullySynchGraphBuild)) {
+    return;
+  }
+
   NodePool::Enumerator nodeEnum(mGraph.mNodes);
   while (!nodeEnum.IsDone()) {
     PtrInfo* pi = nodeEnum.GetNext();
-    if (pi->mColor == black) {
-      // Incremental roots can be in a nonsensical state, so don't
-      // check them. This will miss checking nodes that are merely
-      // reachable from incremental roots.
-      MOZ_ASSERT(!aFullySynchGraphBuild,
-                 "In a synch CC, no nodes should be marked black early on.");
-      continue;
+    if (ScanWhiteNode(pi, aFullySynchGraphBuild)) {
+      ++mWhiteNodeCount;
     }
-    MOZ_ASSERT(pi->mColor == grey);
+  }
+}
 
-    if (!pi->WasTraversed()) {
-      // This node was deleted before it was traversed, so there's no reason
-      // to look at it.
-      MOZ_ASSERT(!pi->mParticipant,
-                 "Live nodes should all have been traversed");
-      continue;
-    }
+// Unlike graph building, where participants' Traverse methods must run on
+// the thread owning the objects, the white-node scan is pure graph
+// computation: it only reads and writes PtrInfo fields in the CC's own
+// NodePool, and each node's verdict is independent of every other node's.
+// So for large graphs it can be partitioned by NodeBlock across a few helper
+// threads.  Returns false when the parallel scan is disabled or not
+// worthwhile, in which case the caller runs the serial pass.
+bool nsCycleCollector::ScanWhiteNodesParallel(bool aFullySynchGraphBuild) {
+  uint32_t threadCount = CCParallelScanThreadCount();
+  if (threadCount < 2) {
+    return false;
+  }
 
-    if (pi->mInternalRefs == pi->mRefCount || pi->IsGrayJS()) {
-      pi->mColor = white;
-      ++mWhiteNodeCount;
+  AutoTArray<NodePool::BlockRange, 32> ranges;
+  mGraph.mNodes.GetBlockRanges(ranges);
+
+  // Each block holds thousands of nodes; a graph smaller than a couple of
+  // blocks per thread is not worth the thread churn.
+  if (ranges.Length() < size_t(threadCount) * 2) {
+    return false;
+  }
+
+  const size_t perThread = (ranges.Length() + threadCount - 1) / threadCount;
+  AutoTArray<ScanWhiteNodesTask, 8> tasks;
+  for (size_t begin = 0; begin < ranges.Length(); begin += perThread) {
+    size_t end = begin + perThread < ranges.Length() ? begin + perThread
+                                                     : ranges.Length();
+    tasks.AppendElement(ScanWhiteNodesTask{ranges.Elements() + begin,
+                                           end - begin, aFullySynchGraphBuild,
+                                           0});
+  }
+
+  AutoTArray<PRThread*, 8> threads;
+  for (size_t i = 1; i < tasks.Length(); ++i) {
+    PRThread* thread =
+        PR_CreateThread(PR_USER_THREAD, ScanWhiteNodesThreadFunc, &tasks[i],
+                        PR_PRIORITY_NORMAL, PR_GLOBAL_THREAD,
+                        PR_JOINABLE_THREAD, 0);
+    if (!thread) {
+      // Out of threads; run this share inline instead.
+      ScanWhiteNodesTaskRun(&tasks[i]);
       continue;
     }
+    threads.AppendElement(thread);
+  }
 
-    pi->AnnotatedReleaseAssert(
-        pi->mInternalRefs <= pi->mRefCount,
-        "More references to an object than its refcount");
+  // The main thread scans the first share while the helpers work.
+  ScanWhiteNodesTaskRun(&tasks[0]);
 
-    // This node will get marked black in the next pass.
+  for (PRThread* thread : threads) {
+    PR_JoinThread(thread);
   }
+
+  for (const ScanWhiteNodesTask& task : tasks) {
+    mWhiteNodeCount += task.mWhiteCount;
+  }
+  return true;
 }
 
 // Any remaining grey nodes that haven't already been deleted must be alive,
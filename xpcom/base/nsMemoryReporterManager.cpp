@@ -11,6 +11,7 @@
 #include "nsProxyRelease.h"
 #include "nsServiceManagerUtils.h"
 #include "nsMemoryReporterManager.h"
+#include "nsStringBuffer.h"
 #include "nsITimer.h"
 #include "nsThreadUtils.h"
 #include "nsPIDOMWindow.h"
@@ -110,12 +111,21 @@ static MOZ_MUST_USE nsresult VsizeDistinguishedAmount(int64_t* aN) {
   return GetProcSelfStatmField(0, aN);
 }
 
-static MOZ_MUST_USE nsresult ResidentDistinguishedAmount(int64_t* aN) {
+static MOZ_MUST_USE nsresult ResidentFastDistinguishedAmount(int64_t* aN) {
   return GetProcSelfStatmField(1, aN);
 }
 
-static MOZ_MUST_USE nsresult ResidentFastDistinguishedAmount(int64_t* aN) {
-  return ResidentDistinguishedAmount(aN);
+static MOZ_MUST_USE nsresult ResidentDistinguishedAmount(int64_t* aN) {
+#  ifdef HAVE_JEMALLOC_STATS
+  // When jemalloc purges with madvise(MADV_FREE), the kernel only takes the
+  // pages away under memory pressure, so they keep counting against our RSS
+  // until then.  Purge them for real before measuring, as the Mac code does.
+  {
+    Telemetry::AutoTimer<Telemetry::MEMORY_FREE_PURGED_PAGES_MS> timer;
+    jemalloc_purge_freed_pages();
+  }
+#  endif
+  return ResidentFastDistinguishedAmount(aN);
 }
 
 #  define HAVE_RESIDENT_UNIQUE_REPORTER 1
@@ -1326,6 +1336,49 @@ class AtomTablesReporter final : public nsIMemoryReporter {
 };
 NS_IMPL_ISUPPORTS(AtomTablesReporter, nsIMemoryReporter)
 
+// Like AtomTablesReporter, this cannot live in the string code because it is
+// used well before XPCOM components are initialized, so we define and
+// register the reporter here.
+class StringBuffersReporter final : public nsIMemoryReporter {
+  ~StringBuffersReporter() = default;
+
+ public:
+  NS_DECL_ISUPPORTS
+
+  NS_IMETHOD CollectReports(nsIHandleReportCallback* aHandleReport,
+                            nsISupports* aData, bool aAnonymize) override {
+    jemalloc_arena_stats_t stats;
+    nsStringBuffer::ArenaStats(&stats);
+
+    // These are KIND_OTHER rather than KIND_HEAP because the buffers are
+    // already covered by the explicit/ reports of the objects that own
+    // them; this view exists to make the overall footprint of shared
+    // string buffers and the fragmentation of their arena visible.
+    MOZ_COLLECT_REPORT(
+        "string-buffers-arena/allocated", KIND_OTHER, UNITS_BYTES,
+        stats.allocated,
+        "Bytes in use by shared string buffers. String buffers are "
+        "allocated from their own arena; this amount overlaps with the "
+        "explicit/ reports of the objects owning the strings.");
+
+    MOZ_COLLECT_REPORT(
+        "string-buffers-arena/committed", KIND_OTHER, UNITS_BYTES,
+        stats.committed,
+        "Committed bytes held by the arena shared string buffers are "
+        "allocated from. The difference with 'allocated' that isn't "
+        "'page-cache' is fragmentation.");
+
+    MOZ_COLLECT_REPORT(
+        "string-buffers-arena/page-cache", KIND_OTHER, UNITS_BYTES,
+        stats.page_cache,
+        "Committed, unused pages the string buffer arena keeps around as a "
+        "cache for future allocations.");
+
+    return NS_OK;
+  }
+};
+NS_IMPL_ISUPPORTS(StringBuffersReporter, nsIMemoryReporter)
+
 class ThreadsReporter final : public nsIMemoryReporter {
   MOZ_DEFINE_MALLOC_SIZE_OF(MallocSizeOf)
   ~ThreadsReporter() = default;
@@ -1636,6 +1689,8 @@ nsMemoryReporterManager::Init() {
 
   RegisterStrongReporter(new AtomTablesReporter());
 
+  RegisterStrongReporter(new StringBuffersReporter());
+
   RegisterStrongReporter(new ThreadsReporter());
 
 #ifdef DEBUG
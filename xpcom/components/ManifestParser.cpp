@@ -380,58 +380,52 @@ struct CachedDirective {
   char* argv[4];
 };
 
-}  // namespace
-
-void ParseManifest(NSLocationType aType, FileLocation& aFile, char* aBuf,
-                   bool aChromeOnly) {
-  nsComponentManagerImpl::ManifestProcessingContext mgrcx(aType, aFile,
-                                                          aChromeOnly);
-  nsChromeRegistry::ManifestProcessingContext chromecx(aType, aFile);
-  nsresult rv;
-
-  NS_NAMED_LITERAL_STRING(kContentAccessible, "contentaccessible");
-  NS_NAMED_LITERAL_STRING(kRemoteEnabled, "remoteenabled");
-  NS_NAMED_LITERAL_STRING(kRemoteRequired, "remoterequired");
-  NS_NAMED_LITERAL_STRING(kApplication, "application");
-  NS_NAMED_LITERAL_STRING(kAppVersion, "appversion");
-  NS_NAMED_LITERAL_STRING(kGeckoVersion, "platformversion");
-  NS_NAMED_LITERAL_STRING(kOs, "os");
-  NS_NAMED_LITERAL_STRING(kOsVersion, "osversion");
-  NS_NAMED_LITERAL_STRING(kABI, "abi");
-  NS_NAMED_LITERAL_STRING(kProcess, "process");
+/**
+ * The application and platform facts that manifest directive flags are
+ * matched against (application, appversion, os, abi, ...). They are
+ * invariant for the lifetime of the process, but used to be recomputed --
+ * including an appinfo service lookup and several string conversions --
+ * for every manifest file parsed at startup, in every process.
+ */
+struct ManifestEnvironment {
+  nsString appID;
+  nsString appVersion;
+  nsString geckoVersion;
+  nsString osTarget;
+  nsString abi;
+  nsString osVersion;
+  nsString process;
 #if defined(MOZ_WIDGET_ANDROID)
-  NS_NAMED_LITERAL_STRING(kTablet, "tablet");
+  bool isTablet = false;
 #endif
+};
 
-  NS_NAMED_LITERAL_STRING(kMain, "main");
-  NS_NAMED_LITERAL_STRING(kContent, "content");
-
-  // Obsolete
-  NS_NAMED_LITERAL_STRING(kXPCNativeWrappers, "xpcnativewrappers");
+ManifestEnvironment* sManifestEnvironment;
 
-  nsAutoString appID;
-  nsAutoString appVersion;
-  nsAutoString geckoVersion;
-  nsAutoString osTarget;
-  nsAutoString abi;
-  nsAutoString process;
+/**
+ * Fills aEnv from the appinfo service and the platform. Returns true if the
+ * appinfo service was available, i.e. the result is complete and safe to
+ * cache for subsequent manifests.
+ */
+bool InitManifestEnvironment(ManifestEnvironment& aEnv) {
+  nsresult rv;
 
   nsCOMPtr<nsIXULAppInfo> xapp(do_GetService(XULAPPINFO_SERVICE_CONTRACTID));
   if (xapp) {
     nsAutoCString s;
     rv = xapp->GetID(s);
     if (NS_SUCCEEDED(rv)) {
-      CopyUTF8toUTF16(s, appID);
+      CopyUTF8toUTF16(s, aEnv.appID);
     }
 
     rv = xapp->GetVersion(s);
     if (NS_SUCCEEDED(rv)) {
-      CopyUTF8toUTF16(s, appVersion);
+      CopyUTF8toUTF16(s, aEnv.appVersion);
     }
 
     rv = xapp->GetPlatformVersion(s);
     if (NS_SUCCEEDED(rv)) {
-      CopyUTF8toUTF16(s, geckoVersion);
+      CopyUTF8toUTF16(s, aEnv.geckoVersion);
     }
 
     nsCOMPtr<nsIXULRuntime> xruntime(do_QueryInterface(xapp));
@@ -439,49 +433,91 @@ void ParseManifest(NSLocationType aType, FileLocation& aFile, char* aBuf,
       rv = xruntime->GetOS(s);
       if (NS_SUCCEEDED(rv)) {
         ToLowerCase(s);
-        CopyUTF8toUTF16(s, osTarget);
+        CopyUTF8toUTF16(s, aEnv.osTarget);
       }
 
       rv = xruntime->GetXPCOMABI(s);
-      if (NS_SUCCEEDED(rv) && osTarget.Length()) {
+      if (NS_SUCCEEDED(rv) && aEnv.osTarget.Length()) {
         ToLowerCase(s);
-        CopyUTF8toUTF16(s, abi);
-        abi.Insert(char16_t('_'), 0);
-        abi.Insert(osTarget, 0);
+        CopyUTF8toUTF16(s, aEnv.abi);
+        aEnv.abi.Insert(char16_t('_'), 0);
+        aEnv.abi.Insert(aEnv.osTarget, 0);
       }
     }
   }
 
-  nsAutoString osVersion;
 #if defined(XP_WIN)
 #  pragma warning(push)
 #  pragma warning(disable : 4996)  // VC12+ deprecates GetVersionEx
   OSVERSIONINFO info = {sizeof(OSVERSIONINFO)};
   if (GetVersionEx(&info)) {
-    nsTextFormatter::ssprintf(osVersion, u"%ld.%ld", info.dwMajorVersion,
+    nsTextFormatter::ssprintf(aEnv.osVersion, u"%ld.%ld", info.dwMajorVersion,
                               info.dwMinorVersion);
   }
 #  pragma warning(pop)
 #elif defined(MOZ_WIDGET_COCOA)
   SInt32 majorVersion = nsCocoaFeatures::OSXVersionMajor();
   SInt32 minorVersion = nsCocoaFeatures::OSXVersionMinor();
-  nsTextFormatter::ssprintf(osVersion, u"%ld.%ld", majorVersion, minorVersion);
+  nsTextFormatter::ssprintf(aEnv.osVersion, u"%ld.%ld", majorVersion,
+                            minorVersion);
 #elif defined(MOZ_WIDGET_GTK)
-  nsTextFormatter::ssprintf(osVersion, u"%ld.%ld", gtk_major_version,
+  nsTextFormatter::ssprintf(aEnv.osVersion, u"%ld.%ld", gtk_major_version,
                             gtk_minor_version);
 #elif defined(MOZ_WIDGET_ANDROID)
-  bool isTablet = false;
   if (mozilla::AndroidBridge::Bridge()) {
     mozilla::AndroidBridge::Bridge()->GetStaticStringField(
-        "android/os/Build$VERSION", "RELEASE", osVersion);
-    isTablet = java::GeckoAppShell::IsTablet();
+        "android/os/Build$VERSION", "RELEASE", aEnv.osVersion);
+    aEnv.isTablet = java::GeckoAppShell::IsTablet();
   }
 #endif
 
   if (XRE_IsContentProcess()) {
-    process = kContent;
+    aEnv.process.AssignLiteral("content");
   } else {
-    process = kMain;
+    aEnv.process.AssignLiteral("main");
+  }
+
+  return !!xapp;
+}
+
+}  // namespace
+
+void ParseManifest(NSLocationType aType, FileLocation& aFile, char* aBuf,
+                   bool aChromeOnly) {
+  nsComponentManagerImpl::ManifestProcessingContext mgrcx(aType, aFile,
+                                                          aChromeOnly);
+  nsChromeRegistry::ManifestProcessingContext chromecx(aType, aFile);
+
+  NS_NAMED_LITERAL_STRING(kContentAccessible, "contentaccessible");
+  NS_NAMED_LITERAL_STRING(kRemoteEnabled, "remoteenabled");
+  NS_NAMED_LITERAL_STRING(kRemoteRequired, "remoterequired");
+  NS_NAMED_LITERAL_STRING(kApplication, "application");
+  NS_NAMED_LITERAL_STRING(kAppVersion, "appversion");
+  NS_NAMED_LITERAL_STRING(kGeckoVersion, "platformversion");
+  NS_NAMED_LITERAL_STRING(kOs, "os");
+  NS_NAMED_LITERAL_STRING(kOsVersion, "osversion");
+  NS_NAMED_LITERAL_STRING(kABI, "abi");
+  NS_NAMED_LITERAL_STRING(kProcess, "process");
+#if defined(MOZ_WIDGET_ANDROID)
+  NS_NAMED_LITERAL_STRING(kTablet, "tablet");
+#endif
+
+  // Obsolete
+  NS_NAMED_LITERAL_STRING(kXPCNativeWrappers, "xpcnativewrappers");
+
+  // Resolve the environment the directive flags are matched against once per
+  // process. Early manifests can be parsed before the appinfo service is
+  // registered; those fall back to a partial, uncached environment so that
+  // later manifests aren't stuck with the incomplete answers.
+  const ManifestEnvironment* env = sManifestEnvironment;
+  ManifestEnvironment localEnv;
+  if (!env) {
+    if (InitManifestEnvironment(localEnv)) {
+      sManifestEnvironment = new ManifestEnvironment(localEnv);
+      env = sManifestEnvironment;
+    } else {
+      env = &localEnv;
+    }
   }
 
   // Because contracts must be registered after CIDs, we save and process them
@@ -578,13 +614,14 @@ void ParseManifest(NSLocationType aType, FileLocation& aFile, char* aBuf,
       ToLowerCase(token);
       NS_ConvertASCIItoUTF16 wtoken(token);
 
-      if (CheckStringFlag(kApplication, wtoken, appID, stApp) ||
-          CheckOsFlag(kOs, wtoken, osTarget, stOs) ||
-          CheckStringFlag(kABI, wtoken, abi, stABI) ||
-          CheckStringFlag(kProcess, wtoken, process, stProcess) ||
-          CheckVersionFlag(kOsVersion, wtoken, osVersion, stOsVersion) ||
-          CheckVersionFlag(kAppVersion, wtoken, appVersion, stAppVersion) ||
-          CheckVersionFlag(kGeckoVersion, wtoken, geckoVersion,
+      if (CheckStringFlag(kApplication, wtoken, env->appID, stApp) ||
+          CheckOsFlag(kOs, wtoken, env->osTarget, stOs) ||
+          CheckStringFlag(kABI, wtoken, env->abi, stABI) ||
+          CheckStringFlag(kProcess, wtoken, env->process, stProcess) ||
+          CheckVersionFlag(kOsVersion, wtoken, env->osVersion, stOsVersion) ||
+          CheckVersionFlag(kAppVersion, wtoken, env->appVersion,
+                           stAppVersion) ||
+          CheckVersionFlag(kGeckoVersion, wtoken, env->geckoVersion,
                            stGeckoVersion)) {
         continue;
       }
@@ -592,7 +629,7 @@ void ParseManifest(NSLocationType aType, FileLocation& aFile, char* aBuf,
 #if defined(MOZ_WIDGET_ANDROID)
       bool tablet = false;
       if (CheckFlag(kTablet, wtoken, tablet)) {
-        stTablet = (tablet == isTablet) ? eOK : eBad;
+        stTablet = (tablet == env->isTablet) ? eOK : eBad;
         continue;
       }
 #endif
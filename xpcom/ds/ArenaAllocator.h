@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <sstream>
 
+#include "mozilla/ArenaChunkPool.h"
 #include "mozilla/Assertions.h"
 #include "mozilla/fallible.h"
 #include "mozilla/Likely.h"
@@ -83,12 +84,17 @@ class ArenaAllocator {
    * the arena.
    */
   void Clear() {
-    // Free all chunks.
+    // Free all chunks, routing standard-sized ones through the process-wide
+    // chunk pool so a subsequent arena (often a reconstruction of this one)
+    // can reuse them without going back to the OS.
     auto a = mHead.next;
     while (a) {
       auto tmp = a;
       a = a->next;
-      free(tmp);
+      const size_t chunkSize = tmp->header.tail - uintptr_t(tmp);
+      if (!ArenaChunkPool::Recycle(tmp, chunkSize)) {
+        free(tmp);
+      }
     }
 
     // Reset the list head.
@@ -168,9 +174,12 @@ class ArenaAllocator {
     MOZ_ASSERT(kOffset < aSize);
 
     const size_t chunkSize = aSize + kOffset;
-    void* p = malloc(chunkSize);
+    void* p = ArenaChunkPool::Acquire(chunkSize);
     if (!p) {
-      return nullptr;
+      p = malloc(chunkSize);
+      if (!p) {
+        return nullptr;
+      }
     }
 
     ArenaChunk* arena = new (KnownNotNull, p) ArenaChunk(chunkSize);
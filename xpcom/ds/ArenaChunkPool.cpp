@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "ArenaChunkPool.h"
+
+#include <stdlib.h>
+
+#include "mozilla/Atomics.h"
+#include "mozilla/MathAlgorithms.h"
+#include "mozilla/MemoryChecking.h"
+
+namespace mozilla {
+
+// Chunks of 4 KiB and 8 KiB cover StackArena blocks and the common
+// ArenaAllocator/nsPresArena arena sizes; 16 KiB and 32 KiB catch the larger
+// arenas. Sixteen slots per class bounds the cache at 960 KiB per process if
+// every class is completely full, which in practice it never is: the pool
+// only holds what one teardown produced and the next construction hasn't
+// reclaimed yet.
+static const size_t kMinSizeLog2 = 12;  // 4 KiB
+static const size_t kNumClasses = 4;
+static const size_t kSlotsPerClass = 16;
+
+static Atomic<void*> sPool[kNumClasses][kSlotsPerClass];
+
+static bool SizeClassFor(size_t aSize, size_t* aClass) {
+  if (aSize < (size_t(1) << kMinSizeLog2) || !IsPowerOfTwo(aSize)) {
+    return false;
+  }
+  size_t sizeClass = FloorLog2(aSize) - kMinSizeLog2;
+  if (sizeClass >= kNumClasses) {
+    return false;
+  }
+  *aClass = sizeClass;
+  return true;
+}
+
+/* static */
+void* ArenaChunkPool::Acquire(size_t aSize) {
+  size_t sizeClass;
+  if (!SizeClassFor(aSize, &sizeClass)) {
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < kSlotsPerClass; i++) {
+    void* p = sPool[sizeClass][i];
+    if (p && sPool[sizeClass][i].compareExchange(p, nullptr)) {
+      MOZ_MAKE_MEM_UNDEFINED(p, aSize);
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+/* static */
+bool ArenaChunkPool::Recycle(void* aPtr, size_t aSize) {
+  size_t sizeClass;
+  if (!SizeClassFor(aSize, &sizeClass)) {
+    return false;
+  }
+
+  // Poison before publishing; the chunk becomes reachable by other threads
+  // the moment the compareExchange succeeds.
+  MOZ_MAKE_MEM_NOACCESS(aPtr, aSize);
+  for (size_t i = 0; i < kSlotsPerClass; i++) {
+    if (!sPool[sizeClass][i] &&
+        sPool[sizeClass][i].compareExchange(nullptr, aPtr)) {
+      return true;
+    }
+  }
+  MOZ_MAKE_MEM_UNDEFINED(aPtr, aSize);
+  return false;
+}
+
+/* static */
+void ArenaChunkPool::Trim() {
+  for (size_t sizeClass = 0; sizeClass < kNumClasses; sizeClass++) {
+    const size_t size = size_t(1) << (kMinSizeLog2 + sizeClass);
+    for (size_t i = 0; i < kSlotsPerClass; i++) {
+      void* p = sPool[sizeClass][i].exchange(nullptr);
+      if (p) {
+        MOZ_MAKE_MEM_UNDEFINED(p, size);
+        free(p);
+      }
+    }
+  }
+}
+
+}  // namespace mozilla
@@ -0,0 +1,52 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_ArenaChunkPool_h
+#define mozilla_ArenaChunkPool_h
+
+#include <stddef.h>
+
+namespace mozilla {
+
+/**
+ * A process-wide recycler for the page-sized chunks that arena-style
+ * allocators (ArenaAllocator, layout's StackArena) cycle through. Arena
+ * teardown followed by reconstruction — e.g. frame-tree destruction on every
+ * navigation — otherwise frees pages back to the allocator only to fault
+ * them in again moments later.
+ *
+ * The pool is lock-free and bounded: each power-of-two size class is a small
+ * fixed array of atomic slots. Acquiring a chunk swaps a populated slot to
+ * null and recycling swaps a null slot to the chunk, so there is no list
+ * traversal and no ABA hazard. When the pool is full, Recycle() declines and
+ * the caller frees the chunk as before.
+ *
+ * The cached chunks are released on memory pressure via Trim().
+ */
+class ArenaChunkPool {
+ public:
+  /**
+   * Returns a cached allocation of exactly |aSize| bytes, or null if none is
+   * cached (or |aSize| isn't a pooled size).
+   */
+  static void* Acquire(size_t aSize);
+
+  /**
+   * Offers |aPtr|, an allocation of exactly |aSize| bytes, to the pool.
+   * Returns false if the pool declined it, in which case the caller still
+   * owns the chunk and must free it.
+   */
+  static bool Recycle(void* aPtr, size_t aSize);
+
+  /**
+   * Frees every cached chunk. Called on memory pressure.
+   */
+  static void Trim();
+};
+
+}  // namespace mozilla
+
+#endif  // mozilla_ArenaChunkPool_h
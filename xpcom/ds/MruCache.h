@@ -61,7 +61,18 @@ struct EmptyChecker<Value, true> {
 //        return aVal->mPtr == aKey;
 //      }
 //    };
-template <class Key, class Value, class Cache, size_t Size = 31>
+//
+// The cache is direct-mapped by default, so two hot keys that hash to the
+// same slot evict each other on every alternating lookup. Callers that have
+// traced such thrash can pass `Ways = 2` to get a 2-way set-associative
+// cache: each slot holds two entries plus an LRU bit, and an insert into a
+// full slot evicts the less recently used entry.
+//
+// On Nightly builds the cache additionally counts hits and misses, exposed
+// via Hits() and Misses(), so associativity upgrades can be justified with
+// numbers.
+template <class Key, class Value, class Cache, size_t Size = 31,
+          size_t Ways = 1>
 class MruCache {
   // Best distribution is achieved with a prime number. Ideally the closest
   // to a power of two will be the most efficient use of memory. This
@@ -69,6 +80,10 @@ class MruCache {
   // use a power-of-two.
   static_assert(Size % 2 != 0, "Use a prime number");
 
+  // LRU state is a single bit per slot, which covers two ways. Wider caches
+  // would need an ordering per slot; add one if a call site ever wants it.
+  static_assert(Ways == 1 || Ways == 2, "Use 1 (direct-mapped) or 2 ways");
+
   // This is a stronger assertion but significantly limits the values to just
   // those close to a power-of-two value.
   // static_assert(Size == 7 || Size == 13 || Size == 31 || Size == 61 ||
@@ -87,17 +102,26 @@ class MruCache {
   // existing entry.
   template <typename U>
   void Put(const KeyType& aKey, U&& aVal) {
-    *RawEntry(aKey) = std::forward<U>(aVal);
+    if constexpr (Ways == 1) {
+      *RawEntry(aKey) = std::forward<U>(aVal);
+    } else {
+      // Go through a lookup so an already-cached key is overwritten in place
+      // rather than duplicated into a second way.
+      LookupEntry(aKey).Set(std::forward<U>(aVal));
+    }
   }
 
   // Removes the given entry if it is in the cache.
-  void Remove(const KeyType& aKey) { Lookup(aKey).Remove(); }
+  void Remove(const KeyType& aKey) { LookupEntry(aKey).Remove(); }
 
   // Clears all cached entries and resets them to a default value.
   void Clear() {
     for (ValueType& val : mCache) {
       val = ValueType{};
     }
+    for (uint8_t& mru : mMruWay) {
+      mru = 0;
+    }
   }
 
   // Helper that holds an entry that matched a lookup key. Usage:
@@ -117,6 +141,11 @@ class MruCache {
       MOZ_ASSERT(mEntry);
     }
 
+    Entry(ValueType* aEntry, bool aMatch, uint8_t* aMruWay, uint8_t aWay)
+        : mEntry(aEntry), mMatch(aMatch), mMruWay(aMruWay), mWay(aWay) {
+      MOZ_ASSERT(mEntry);
+    }
+
     explicit operator bool() const { return mMatch; }
 
     ValueType& Data() const {
@@ -128,37 +157,100 @@ class MruCache {
     void Set(U&& aValue) {
       mMatch = true;
       Data() = std::forward<U>(aValue);
+      if (mMruWay) {
+        *mMruWay = mWay;
+      }
     }
 
     void Remove() {
       if (mMatch) {
         Data() = ValueType{};
         mMatch = false;
+        if (mMruWay) {
+          // Mark the other way most recently used so the emptied way is the
+          // next victim.
+          *mMruWay = uint8_t(1 - mWay);
+        }
       }
     }
 
    private:
     ValueType* mEntry;  // Location of the entry in the cache.
     bool mMatch;        // Whether the value matched.
+    // The slot's LRU bit and which way this entry occupies; null when the
+    // cache is direct-mapped.
+    uint8_t* mMruWay = nullptr;
+    uint8_t mWay = 0;
   };
 
   // Retrieves an entry from the cache. Can be used to test if an entry is
   // present, update the entry to a new value, or remove the entry if one was
   // matched.
   Entry Lookup(const KeyType& aKey) {
+    Entry entry = LookupEntry(aKey);
+#ifdef NIGHTLY_BUILD
+    if (entry) {
+      mHits++;
+    } else {
+      mMisses++;
+    }
+#endif
+    return entry;
+  }
+
+#ifdef NIGHTLY_BUILD
+  // Lookup() hit/miss counters, only maintained on Nightly-style builds.
+  // Put() and Remove() don't count.
+  uint64_t Hits() const { return mHits; }
+  uint64_t Misses() const { return mMisses; }
+#endif
+
+ private:
+  Entry LookupEntry(const KeyType& aKey) {
     using EmptyChecker = detail::EmptyChecker<ValueType>;
 
-    auto entry = RawEntry(aKey);
-    bool match = EmptyChecker::IsNotEmpty(*entry) && Cache::Match(aKey, *entry);
-    return Entry(entry, match);
+    if constexpr (Ways == 1) {
+      auto entry = RawEntry(aKey);
+      bool match =
+          EmptyChecker::IsNotEmpty(*entry) && Cache::Match(aKey, *entry);
+      return Entry(entry, match);
+    } else {
+      const size_t slot = Cache::Hash(aKey) % Size;
+      ValueType* ways = &mCache[slot * Ways];
+      for (size_t way = 0; way < Ways; ++way) {
+        if (EmptyChecker::IsNotEmpty(ways[way]) &&
+            Cache::Match(aKey, ways[way])) {
+          mMruWay[slot] = uint8_t(way);
+          return Entry(&ways[way], true, &mMruWay[slot], uint8_t(way));
+        }
+      }
+      // Missed: hand out the way an insert should fill. Prefer an empty way
+      // (detectable for pointer values), otherwise take the least recently
+      // used one. The LRU bit only flips if the caller Set()s the entry.
+      size_t victim = 1 - mMruWay[slot];
+      for (size_t way = 0; way < Ways; ++way) {
+        if (!EmptyChecker::IsNotEmpty(ways[way])) {
+          victim = way;
+          break;
+        }
+      }
+      return Entry(&ways[victim], false, &mMruWay[slot], uint8_t(victim));
+    }
   }
 
- private:
   MOZ_ALWAYS_INLINE ValueType* RawEntry(const KeyType& aKey) {
+    static_assert(Ways == 1, "RawEntry is only used when direct-mapped");
     return &mCache[Cache::Hash(aKey) % Size];
   }
 
-  ValueType mCache[Size] = {};
+  ValueType mCache[Size * Ways] = {};
+  // For each slot, the index of its most recently used way; a single unused
+  // element when direct-mapped.
+  uint8_t mMruWay[Ways == 2 ? Size : 1] = {};
+#ifdef NIGHTLY_BUILD
+  uint64_t mHits = 0;
+  uint64_t mMisses = 0;
+#endif
 };
 
 }  // namespace mozilla
@@ -119,6 +119,23 @@ static bool SizeOfEntryStore(uint32_t aCapacity, uint32_t aEntrySize,
   return uint64_t(*aNbytes) == nbytes64;  // returns false on overflow
 }
 
+// Like SizeOfEntryStore(), but also reserves room for the trailing
+// MigrationState when the table has opted into incremental resizes.
+bool PLDHashTable::SizeOfEntryStoreWithState(uint32_t aCapacity,
+                                             uint32_t* aNbytes) const {
+  if (!SizeOfEntryStore(aCapacity, mEntrySize, aNbytes)) {
+    return false;
+  }
+  if (IsIncrementalResizeEnabled()) {
+    uint32_t withState = *aNbytes + sizeof(MigrationState);
+    if (withState < *aNbytes) {
+      return false;  // overflowed
+    }
+    *aNbytes = withState;
+  }
+  return true;
+}
+
 // Compute max and min load numbers (entry counts). We have a secondary max
 // that allows us to overload a table reasonably if it cannot be grown further
 // (i.e. if ChangeTable() fails). The table slows down drastically if the
@@ -179,14 +196,14 @@ PLDHashTable::HashShift(uint32_t aEntrySize, uint32_t aLength) {
 }
 
 PLDHashTable::PLDHashTable(const PLDHashTableOps* aOps, uint32_t aEntrySize,
-                           uint32_t aLength)
+                           uint32_t aLength, bool aIncrementalResize)
     : mOps(aOps),
       mEntryStore(),
       mGeneration(0),
       mHashShift(HashShift(aEntrySize, aLength)),
       mEntrySize(aEntrySize),
       mEntryCount(0),
-      mRemovedCount(0) {
+      mRemovedCount(aIncrementalResize ? kIncrementalResizeFlag : 0) {
   // An entry size greater than 0xff is unlikely, but let's check anyway. If
   // you hit this, your hashtable would waste lots of space for unused entries
   // and you should change your hash table's entries to pointers.
@@ -286,6 +303,19 @@ PLDHashTable::~PLDHashTable() {
     return;
   }
 
+  // Clear and free any entries still awaiting migration.
+  if (IsIncrementalResizeActive()) {
+    MigrationState* state = GetMigrationState();
+    EntryStore::ForEachSlot(state->mOldStore, 1u << state->mOldLog2,
+                            mEntrySize, [&](const Slot& aSlot) {
+                              if (aSlot.IsLive()) {
+                                mOps->clearEntry(this, aSlot.ToEntry());
+                              }
+                            });
+    free(state->mOldStore);
+    state->mOldStore = nullptr;
+  }
+
   // Clear any remaining live entries.
   mEntryStore.ForEachSlot(Capacity(), mEntrySize, [&](const Slot& aSlot) {
     if (aSlot.IsLive()) {
@@ -300,9 +330,11 @@ void PLDHashTable::ClearAndPrepareForLength(uint32_t aLength) {
   // Get these values before the destructor clobbers them.
   const PLDHashTableOps* ops = mOps;
   uint32_t entrySize = mEntrySize;
+  bool incrementalResize = IsIncrementalResizeEnabled();
 
   this->~PLDHashTable();
-  new (KnownNotNull, this) PLDHashTable(ops, entrySize, aLength);
+  new (KnownNotNull, this)
+      PLDHashTable(ops, entrySize, aLength, incrementalResize);
 }
 
 void PLDHashTable::Clear() { ClearAndPrepareForLength(kDefaultInitialLength); }
@@ -425,6 +457,14 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::FindFreeSlot(PLDHashNumber aKeyHash) const
 bool PLDHashTable::ChangeTable(int32_t aDeltaLog2) {
   MOZ_ASSERT(mEntryStore.Get());
 
+  // A previous incremental resize must be complete before the table
+  // structure can change again. This is rare: it only happens if the table
+  // grows so fast that the amortized migration can't keep up, or if it is
+  // shrunk mid-migration.
+  if (IsIncrementalResizeActive()) {
+    FinishIncrementalResize();
+  }
+
   // Look, but don't touch, until we succeed in getting new entry store.
   int32_t oldLog2 = kPLDHashNumberBits - mHashShift;
   int32_t newLog2 = oldLog2 + aDeltaLog2;
@@ -434,7 +474,7 @@ bool PLDHashTable::ChangeTable(int32_t aDeltaLog2) {
   }
 
   uint32_t nbytes;
-  if (!SizeOfEntryStore(newCapacity, mEntrySize, &nbytes)) {
+  if (!SizeOfEntryStoreWithState(newCapacity, &nbytes)) {
     return false;  // overflowed
   }
 
@@ -445,15 +485,29 @@ bool PLDHashTable::ChangeTable(int32_t aDeltaLog2) {
 
   // We can't fail from here on, so update table parameters.
   mHashShift = kPLDHashNumberBits - newLog2;
-  mRemovedCount = 0;
+  mRemovedCount &= kIncrementalResizeFlag;
 
   // Assign the new entry store to table.
   char* oldEntryStore = mEntryStore.Get();
   mEntryStore.Set(newEntryStore, &mGeneration);
+
+  uint32_t oldCapacity = 1u << oldLog2;
+
+  // For large opted-in tables that are growing, don't move anything yet:
+  // leave the old store in place and let entries migrate over in bounded
+  // steps (see MigrateSlots).
+  if (IsIncrementalResizeEnabled() && aDeltaLog2 > 0 &&
+      oldCapacity >= kMinIncrementalCapacity) {
+    MigrationState* state = GetMigrationState();
+    state->mOldStore = oldEntryStore;
+    state->mOldLog2 = oldLog2;
+    state->mCursor = 0;
+    return true;
+  }
+
   PLDHashMoveEntry moveEntry = mOps->moveEntry;
 
   // Copy only live entries, leaving removed ones behind.
-  uint32_t oldCapacity = 1u << oldLog2;
   EntryStore::ForEachSlot(
       oldEntryStore, oldCapacity, mEntrySize, [&](const Slot& slot) {
         if (slot.IsLive()) {
@@ -469,6 +523,164 @@ bool PLDHashTable::ChangeTable(int32_t aDeltaLog2) {
   return true;
 }
 
+// Search the old entry store for a live entry while a migration is in
+// progress. This mirrors SearchTable<ForSearchOrRemove>, but runs against
+// the old store's capacity and hash shift, and never mutates anything.
+auto PLDHashTable::SearchOldStore(const void* aKey, PLDHashNumber aKeyHash)
+    const -> Maybe<Slot> {
+  MOZ_ASSERT(IsIncrementalResizeActive());
+
+  MigrationState* state = GetMigrationState();
+  const uint32_t sizeLog2 = state->mOldLog2;
+  const uint32_t sizeMask = (PLDHashNumber(1) << sizeLog2) - 1;
+  auto hashes = reinterpret_cast<PLDHashNumber*>(state->mOldStore);
+  char* entries = EntryStore::Entries(state->mOldStore, 1u << sizeLog2);
+
+  auto slotForIndex = [&](uint32_t aIndex) {
+    auto entry =
+        reinterpret_cast<PLDHashEntryHdr*>(entries + aIndex * mEntrySize);
+    return Slot(entry, &hashes[aIndex]);
+  };
+
+  PLDHashMatchEntry matchEntry = mOps->matchEntry;
+  PLDHashNumber hash1 = aKeyHash >> (kPLDHashNumberBits - sizeLog2);
+  Slot slot = slotForIndex(hash1);
+
+  if (slot.IsFree()) {
+    return Nothing();
+  }
+
+  if (MatchSlotKeyhash(slot, aKeyHash) && matchEntry(slot.ToEntry(), aKey)) {
+    return Some(slot);
+  }
+
+  PLDHashNumber hash2 = (aKeyHash & sizeMask) | 1;
+  for (;;) {
+    hash1 -= hash2;
+    hash1 &= sizeMask;
+
+    slot = slotForIndex(hash1);
+    if (slot.IsFree()) {
+      return Nothing();
+    }
+
+    if (MatchSlotKeyhash(slot, aKeyHash) && matchEntry(slot.ToEntry(), aKey)) {
+      return Some(slot);
+    }
+  }
+}
+
+// Find a slot in the (new) entry store for an entry being migrated over from
+// the old store. This is FindFreeSlot() extended to cope with and recycle
+// removed-entry sentinels, which the new store accumulates while a migration
+// is in progress. No key is needed: an entry lives in exactly one store, so
+// it cannot already be present here.
+auto PLDHashTable::FindSlotForMigration(PLDHashNumber aKeyHash) const -> Slot {
+  MOZ_ASSERT(mEntryStore.Get());
+  NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
+
+  PLDHashNumber hash1 = Hash1(aKeyHash);
+  Slot slot = SlotForIndex(hash1);
+
+  if (slot.IsFree()) {
+    return slot;
+  }
+
+  PLDHashNumber hash2;
+  uint32_t sizeMask;
+  Hash2(aKeyHash, hash2, sizeMask);
+
+  Maybe<Slot> firstRemoved;
+
+  for (;;) {
+    if (!firstRemoved) {
+      if (MOZ_UNLIKELY(slot.IsRemoved())) {
+        firstRemoved.emplace(slot);
+      } else {
+        slot.MarkColliding();
+      }
+    }
+
+    hash1 -= hash2;
+    hash1 &= sizeMask;
+
+    slot = SlotForIndex(hash1);
+    if (slot.IsFree()) {
+      return firstRemoved.refOr(slot);
+    }
+  }
+}
+
+// Move one live entry from the old store into the new one, and return its
+// new slot. The old slot is marked the same way RawRemove() would mark it,
+// so probe chains through the old store stay intact.
+auto PLDHashTable::MigrateSlot(Slot& aOldSlot) -> Slot {
+  MOZ_ASSERT(aOldSlot.IsLive());
+
+  const PLDHashNumber oldKeyHash = aOldSlot.KeyHash();
+  PLDHashNumber keyHash = oldKeyHash & ~kCollisionFlag;
+
+  Slot newSlot = FindSlotForMigration(keyHash);
+  if (newSlot.IsRemoved()) {
+    mRemovedCount--;
+    keyHash |= kCollisionFlag;
+  }
+  mOps->moveEntry(this, aOldSlot.ToEntry(), newSlot.ToEntry());
+  newSlot.SetKeyHash(keyHash);
+
+  if (oldKeyHash & kCollisionFlag) {
+    aOldSlot.MarkRemoved();
+  } else {
+    aOldSlot.MarkFree();
+  }
+
+  return newSlot;
+}
+
+// Advance an in-progress incremental resize by scanning up to aLimit
+// old-store slots, migrating the live ones. Frees the old store once every
+// slot has been visited.
+void PLDHashTable::MigrateSlots(uint32_t aLimit) {
+  MOZ_ASSERT(IsIncrementalResizeActive());
+
+  MigrationState* state = GetMigrationState();
+  const uint32_t oldCapacity = 1u << state->mOldLog2;
+  auto hashes = reinterpret_cast<PLDHashNumber*>(state->mOldStore);
+  char* entries = EntryStore::Entries(state->mOldStore, oldCapacity);
+
+  while (aLimit && state->mCursor < oldCapacity) {
+    uint32_t i = state->mCursor++;
+    if (Slot::IsLiveHash(hashes[i])) {
+      Slot oldSlot(reinterpret_cast<PLDHashEntryHdr*>(entries + i * mEntrySize),
+                   &hashes[i]);
+      MigrateSlot(oldSlot);
+    }
+    aLimit--;
+  }
+
+  if (state->mCursor == oldCapacity) {
+    free(state->mOldStore);
+    state->mOldStore = nullptr;
+  }
+}
+
+// Remove a live entry found in the old store. Unlike RawRemove(), this
+// doesn't count the removed sentinel: mRemovedCount tracks the load of the
+// new store, and the old store only ever drains.
+void PLDHashTable::RemoveFromOldStore(Slot& aSlot) {
+  MOZ_ASSERT(aSlot.IsLive());
+
+  PLDHashEntryHdr* entry = aSlot.ToEntry();
+  PLDHashNumber keyHash = aSlot.KeyHash();
+  mOps->clearEntry(this, entry);
+  if (keyHash & kCollisionFlag) {
+    aSlot.MarkRemoved();
+  } else {
+    aSlot.MarkFree();
+  }
+  mEntryCount--;
+}
+
 MOZ_ALWAYS_INLINE PLDHashNumber
 PLDHashTable::ComputeKeyHash(const void* aKey) const {
   MOZ_ASSERT(mEntryStore.Get());
@@ -493,10 +705,19 @@ PLDHashEntryHdr* PLDHashTable::Search(const void* aKey) const {
     return nullptr;
   }
 
+  PLDHashNumber keyHash = ComputeKeyHash(aKey);
   return SearchTable<ForSearchOrRemove>(
-      aKey, ComputeKeyHash(aKey),
+      aKey, keyHash,
       [&](Slot& slot) -> PLDHashEntryHdr* { return slot.ToEntry(); },
-      [&]() -> PLDHashEntryHdr* { return nullptr; });
+      [&]() -> PLDHashEntryHdr* {
+        // The entry may not have been migrated yet.
+        if (MOZ_UNLIKELY(IsIncrementalResizeActive())) {
+          if (Maybe<Slot> oldSlot = SearchOldStore(aKey, keyHash)) {
+            return oldSlot->ToEntry();
+          }
+        }
+        return nullptr;
+      });
 }
 
 PLDHashEntryHdr* PLDHashTable::Add(const void* aKey,
@@ -509,8 +730,7 @@ PLDHashEntryHdr* PLDHashTable::Add(const void* aKey,
   if (!mEntryStore.Get()) {
     uint32_t nbytes;
     // We already checked this in the constructor, so it must still be true.
-    MOZ_RELEASE_ASSERT(
-        SizeOfEntryStore(CapacityFromHashShift(), mEntrySize, &nbytes));
+    MOZ_RELEASE_ASSERT(SizeOfEntryStoreWithState(CapacityFromHashShift(), &nbytes));
     mEntryStore.Set((char*)calloc(1, nbytes), &mGeneration);
     if (!mEntryStore.Get()) {
       return nullptr;
@@ -521,10 +741,10 @@ PLDHashEntryHdr* PLDHashTable::Add(const void* aKey,
   // table, we may grow once more than necessary, but only if we are on the
   // edge of being overloaded.
   uint32_t capacity = Capacity();
-  if (mEntryCount + mRemovedCount >= MaxLoad(capacity)) {
+  if (mEntryCount + RemovedCount() >= MaxLoad(capacity)) {
     // Compress if a quarter or more of all entries are removed.
     int deltaLog2;
-    if (mRemovedCount >= capacity >> 2) {
+    if (RemovedCount() >= capacity >> 2) {
       deltaLog2 = 0;
     } else {
       deltaLog2 = 1;
@@ -533,7 +753,7 @@ PLDHashEntryHdr* PLDHashTable::Add(const void* aKey,
     // Grow or compress the table. If ChangeTable() fails, allow overloading up
     // to the secondary max. Once we hit the secondary max, return null.
     if (!ChangeTable(deltaLog2) &&
-        mEntryCount + mRemovedCount >= MaxLoadOnGrowthFailure(capacity)) {
+        mEntryCount + RemovedCount() >= MaxLoadOnGrowthFailure(capacity)) {
       return nullptr;
     }
   }
@@ -541,6 +761,22 @@ PLDHashEntryHdr* PLDHashTable::Add(const void* aKey,
   // Look for entry after possibly growing, so we don't have to add it,
   // then skip it while growing the table and re-add it after.
   PLDHashNumber keyHash = ComputeKeyHash(aKey);
+
+  if (MOZ_UNLIKELY(IsIncrementalResizeActive())) {
+    // Each Add() pays for a bounded amount of migration work, so the resize
+    // completes within O(capacity / kMigrationStride) insertions.
+    MigrateSlots(kMigrationStride);
+    if (IsIncrementalResizeActive()) {
+      // If the key is still in the old store, we must find it there rather
+      // than add a duplicate to the new one. Migrate it eagerly so the slot
+      // we return stays valid for the usual entry lifetime rules.
+      if (Maybe<Slot> oldSlot = SearchOldStore(aKey, keyHash)) {
+        Slot newSlot = MigrateSlot(*oldSlot);
+        return newSlot.ToEntry();
+      }
+    }
+  }
+
   Slot slot = SearchTable<ForAdd>(
       aKey, keyHash, [&](Slot& found) -> Slot { return found; },
       [&]() -> Slot {
@@ -599,7 +835,12 @@ void PLDHashTable::Remove(const void* aKey) {
         ShrinkIfAppropriate();
       },
       [&]() {
-        // Do nothing.
+        // The entry may not have been migrated yet.
+        if (MOZ_UNLIKELY(IsIncrementalResizeActive())) {
+          if (Maybe<Slot> oldSlot = SearchOldStore(aKey, keyHash)) {
+            RemoveFromOldStore(*oldSlot);
+          }
+        }
       });
 }
 
@@ -613,6 +854,23 @@ void PLDHashTable::RemoveEntry(PLDHashEntryHdr* aEntry) {
 }
 
 void PLDHashTable::RawRemove(PLDHashEntryHdr* aEntry) {
+  if (MOZ_UNLIKELY(IsIncrementalResizeActive())) {
+    // The entry may still live in the old store.
+    MigrationState* state = GetMigrationState();
+    const uint32_t oldCapacity = 1u << state->mOldLog2;
+    char* oldEntries = EntryStore::Entries(state->mOldStore, oldCapacity);
+    char* entryPtr = reinterpret_cast<char*>(aEntry);
+    if (entryPtr >= oldEntries &&
+        entryPtr < oldEntries + oldCapacity * mEntrySize) {
+      auto hashes = reinterpret_cast<PLDHashNumber*>(state->mOldStore);
+      uint32_t index = (entryPtr - oldEntries) / mEntrySize;
+      Slot oldSlot(aEntry, &hashes[index]);
+      MOZ_ASSERT(mChecker.IsWritable());
+      RemoveFromOldStore(oldSlot);
+      return;
+    }
+  }
+
   Slot slot(mEntryStore.SlotForPLDHashEntry(aEntry, Capacity(), mEntrySize));
   RawRemove(slot);
 }
@@ -644,8 +902,14 @@ void PLDHashTable::RawRemove(Slot& aSlot) {
 // table is underloaded according to the minimum alpha, and is not minimal-size
 // already.
 void PLDHashTable::ShrinkIfAppropriate() {
+  // Don't fight an in-progress growth; shrinking would force it to finish
+  // synchronously, which is exactly the pause incremental mode avoids.
+  if (MOZ_UNLIKELY(IsIncrementalResizeActive())) {
+    return;
+  }
+
   uint32_t capacity = Capacity();
-  if (mRemovedCount >= capacity >> 2 ||
+  if (RemovedCount() >= capacity >> 2 ||
       (capacity > kMinCapacity && mEntryCount <= MinLoad(capacity))) {
     uint32_t log2;
     BestCapacity(mEntryCount, &capacity, &log2);
@@ -663,7 +927,11 @@ size_t PLDHashTable::ShallowSizeOfExcludingThis(
   AutoReadOp op(mChecker);
 #endif
 
-  return aMallocSizeOf(mEntryStore.Get());
+  size_t n = aMallocSizeOf(mEntryStore.Get());
+  if (MOZ_UNLIKELY(IsIncrementalResizeActive())) {
+    n += aMallocSizeOf(GetMigrationState()->mOldStore);
+  }
+  return n;
 }
 
 size_t PLDHashTable::ShallowSizeOfIncludingThis(
@@ -695,6 +963,13 @@ PLDHashTable::Iterator::Iterator(PLDHashTable* aTable)
       mNextsLimit(mTable->EntryCount()),
       mHaveRemoved(false),
       mEntrySize(aTable->mEntrySize) {
+  // Iteration walks the entry store directly, so a partially-migrated table
+  // must be consolidated first. (The entry store isn't reallocated by this,
+  // so mCurrent stays valid.)
+  if (MOZ_UNLIKELY(mTable->IsIncrementalResizeActive())) {
+    mTable->FinishIncrementalResize();
+  }
+
 #ifdef MOZ_HASH_TABLE_CHECKS_ENABLED
   mTable->mChecker.StartReadOp();
 #endif
@@ -16,6 +16,7 @@
 #include "mozilla/Attributes.h"  // for MOZ_ALWAYS_INLINE
 #include "mozilla/FunctionTypeTraits.h"
 #include "mozilla/HashFunctions.h"
+#include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Types.h"
 #include "mozilla/fallible.h"
@@ -406,8 +407,18 @@ class PLDHashTable {
   // to that the capacity will be zero.
   //
   // This will crash if |aEntrySize| and/or |aLength| are too large.
+  //
+  // If |aIncrementalResize| is true, growth of a large table does not rehash
+  // every entry in one shot. Instead the old and new entry stores coexist
+  // for a while: entries migrate to the new store in small bounded steps on
+  // each Add() and when they are individually touched, so no single
+  // operation pays a monolithic rehash. The trade-offs are that Search() may
+  // probe both stores while a migration is in progress, and that creating an
+  // Iterator first finishes any in-progress migration (so iteration of an
+  // opted-in table is potentially a writing operation).
   PLDHashTable(const PLDHashTableOps* aOps, uint32_t aEntrySize,
-               uint32_t aLength = kDefaultInitialLength);
+               uint32_t aLength = kDefaultInitialLength,
+               bool aIncrementalResize = false);
 
   PLDHashTable(PLDHashTable&& aOther)
       // Initialize fields which are checked by the move assignment operator
@@ -621,6 +632,62 @@ class PLDHashTable {
 
   static const PLDHashNumber kCollisionFlag = 1;
 
+  // The removed-entry count never needs more than 26 bits (kMaxCapacity), so
+  // the top bit of mRemovedCount records the incremental-resize opt-in
+  // without growing the carefully packed field block above.
+  static const uint32_t kIncrementalResizeFlag = 1u << 31;
+
+  // Incremental resizes only pay off when the one-shot rehash would be
+  // expensive; smaller tables are still grown in one shot.
+  static const uint32_t kMinIncrementalCapacity = 1u << 14;
+
+  // How many old-store slots each Add() migrates while a resize is in
+  // progress. The old store is guaranteed to drain long before the new store
+  // reaches its own growth threshold.
+  static const uint32_t kMigrationStride = 64;
+
+  // Bookkeeping for an in-progress incremental resize. For opted-in tables
+  // this struct trails the entry store allocation (the offset is a multiple
+  // of eight, since capacity is at least kMinCapacity), so tables that never
+  // opt in pay nothing and sizeof(PLDHashTable) is unchanged. mOldStore is
+  // null whenever no migration is in progress.
+  struct MigrationState {
+    char* mOldStore;
+    uint32_t mOldLog2;
+    uint32_t mCursor;  // Next old-store slot index to migrate.
+  };
+
+  uint32_t RemovedCount() const {
+    return mRemovedCount & ~kIncrementalResizeFlag;
+  }
+
+  bool IsIncrementalResizeEnabled() const {
+    return !!(mRemovedCount & kIncrementalResizeFlag);
+  }
+
+  bool IsIncrementalResizeActive() const {
+    return MOZ_UNLIKELY(IsIncrementalResizeEnabled()) && mEntryStore.Get() &&
+           GetMigrationState()->mOldStore;
+  }
+
+  MigrationState* GetMigrationState() const {
+    MOZ_ASSERT(IsIncrementalResizeEnabled());
+    MOZ_ASSERT(mEntryStore.Get());
+    return reinterpret_cast<MigrationState*>(
+        mEntryStore.Get() +
+        CapacityFromHashShift() * (sizeof(PLDHashNumber) + mEntrySize));
+  }
+
+  bool SizeOfEntryStoreWithState(uint32_t aCapacity, uint32_t* aNbytes) const;
+
+  mozilla::Maybe<Slot> SearchOldStore(const void* aKey,
+                                      PLDHashNumber aKeyHash) const;
+  Slot FindSlotForMigration(PLDHashNumber aKeyHash) const;
+  Slot MigrateSlot(Slot& aOldSlot);
+  void MigrateSlots(uint32_t aLimit);
+  void FinishIncrementalResize() { MigrateSlots(UINT32_MAX); }
+  void RemoveFromOldStore(Slot& aSlot);
+
   PLDHashNumber Hash1(PLDHashNumber aHash0) const;
   void Hash2(PLDHashNumber aHash, uint32_t& aHash2Out,
              uint32_t& aSizeMaskOut) const;
@@ -107,6 +107,28 @@ bool TTokenizer<TChar>::Check(const typename base::Token& aToken) {
 
 template <typename TChar>
 void TTokenizer<TChar>::SkipWhites(WhiteSkipping aIncludeNewLines) {
+  // Fast path: with no custom tokens registered and the input complete, the
+  // whole run of whitespaces can be skipped as a bulk directly on the input
+  // instead of paying the full tokenization cost per character.
+  if (base::mCustomTokens.IsEmpty() && base::mInputFinished &&
+      base::HasInput()) {
+    typename base::TAString::const_char_iterator skip = base::mCursor;
+    while (skip < base::mEnd &&
+           (contains(base::mWhitespaces, *skip) ||
+            (aIncludeNewLines == INCLUDE_NEW_LINE &&
+             (*skip == '\r' || *skip == '\n')))) {
+      ++skip;
+    }
+    if (skip == base::mCursor) {
+      base::mHasFailed = true;
+      return;
+    }
+    mRollback = base::mCursor;
+    base::mCursor = skip;
+    base::mHasFailed = false;
+    return;
+  }
+
   if (!CheckWhite() &&
       (aIncludeNewLines == DONT_INCLUDE_NEW_LINE || !CheckEOL())) {
     return;
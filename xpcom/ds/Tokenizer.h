@@ -367,6 +367,29 @@ class TTokenizer : public TokenizerBase<TChar> {
   MOZ_MUST_USE bool ReadInteger(T* aValue) {
     MOZ_RELEASE_ASSERT(aValue);
 
+    // Fast path: with no custom tokens registered and the input complete,
+    // consume the digits directly off the input without building a Token.
+    if (base::mCustomTokens.IsEmpty() && base::mInputFinished &&
+        base::HasInput() && base::mCursor != base::mEnd &&
+        !base::IsWordFirst(*base::mCursor)) {
+      typename base::TAString::const_char_iterator digits = base::mCursor;
+      mozilla::CheckedInt<T> checked = 0;
+      while (digits != base::mEnd && base::IsNumber(*digits)) {
+        checked *= 10;
+        checked += static_cast<T>(*digits - TChar('0'));
+        ++digits;
+      }
+      if (digits == base::mCursor || !checked.isValid()) {
+        base::mHasFailed = true;
+        return false;
+      }
+      mRollback = base::mCursor;
+      base::mCursor = digits;
+      base::mHasFailed = false;
+      *aValue = checked.value();
+      return true;
+    }
+
     typename base::TAString::const_char_iterator rollback = mRollback;
     typename base::TAString::const_char_iterator cursor = base::mCursor;
     typename base::Token t;
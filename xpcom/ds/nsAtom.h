@@ -9,7 +9,9 @@
 
 #include "nsISupportsImpl.h"
 #include "nsString.h"
+#include "nsTArrayForwardDeclare.h"
 #include "mozilla/Atomics.h"
+#include "mozilla/RefPtr.h"
 #include "mozilla/UniquePtr.h"
 
 namespace mozilla {
@@ -255,6 +257,14 @@ already_AddRefed<nsAtom> NS_Atomize(const nsAString& aUTF16String);
 // An optimized version of the method above for the main thread.
 already_AddRefed<nsAtom> NS_AtomizeMainThread(const nsAString& aUTF16String);
 
+// Find the atoms for an array of UTF-16 strings. Equivalent to calling
+// NS_Atomize on each string, except that each subtable lock is taken once
+// per batch rather than once per string, which is noticeably cheaper when
+// atomizing in bursts (e.g. from the parser or the style system).
+// |aAtoms| is reset to hold one atom per input string, in order.
+void NS_AtomizeMany(const nsTArray<nsString>& aStrings,
+                    nsTArray<RefPtr<nsAtom>>& aAtoms);
+
 // Return a count of the total number of atoms currently alive in the system.
 //
 // Note that the result is imprecise and racy if other threads are currently
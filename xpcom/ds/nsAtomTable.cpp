@@ -23,6 +23,7 @@
 #include "nsHashKeys.h"
 #include "nsPrintfCString.h"
 #include "nsString.h"
+#include "nsTArray.h"
 #include "nsThreadUtils.h"
 #include "nsUnicharUtils.h"
 #include "PLDHashTable.h"
@@ -178,6 +179,25 @@ struct AtomCache : public MruCache<AtomTableKey, nsAtom*, AtomCache> {
 
 static AtomCache sRecentlyUsedMainThreadAtoms;
 
+// A thread-local cache of recently atomized atoms for helper threads,
+// layered on MruCache like sRecentlyUsedMainThreadAtoms above. Unlike that
+// cache, entries hold strong references: the atom GC only runs on the main
+// thread and cannot reach into other threads' caches, so a weak entry here
+// could dangle. The strong references pin at most 31 atoms per thread, and
+// are dropped when the thread exits. The main thread must not use this
+// cache, both because it has its own and because anything pinned here would
+// be reported as a leak by the shutdown GC.
+struct OffMainThreadAtomCache
+    : public MruCache<AtomTableKey, RefPtr<nsAtom>, OffMainThreadAtomCache> {
+  static HashNumber Hash(const AtomTableKey& aKey) { return aKey.mHash; }
+  static bool Match(const AtomTableKey& aKey, const RefPtr<nsAtom>& aVal) {
+    MOZ_ASSERT(aKey.mUTF16String);
+    return aVal && aVal->Equals(aKey.mUTF16String, aKey.mLength);
+  }
+};
+
+static thread_local OffMainThreadAtomCache sRecentlyUsedOffMainThreadAtoms;
+
 // In order to reduce locking contention for concurrent atomization, we segment
 // the atom table into N subtables, each with a separate lock. If the hash
 // values we use to select the subtable are evenly distributed, this reduces the
@@ -215,6 +235,8 @@ class nsAtomTable {
   already_AddRefed<nsAtom> Atomize(const nsAString& aUTF16String);
   already_AddRefed<nsAtom> Atomize(const nsACString& aUTF8String);
   already_AddRefed<nsAtom> AtomizeMainThread(const nsAString& aUTF16String);
+  void AtomizeMany(const nsTArray<nsString>& aStrings,
+                   nsTArray<RefPtr<nsAtom>>& aAtoms);
   nsStaticAtom* GetStaticAtom(const nsAString& aUTF16String);
   void RegisterStaticAtoms(const nsStaticAtom* aAtoms, size_t aAtomsLen);
 
@@ -583,6 +605,32 @@ already_AddRefed<nsAtom> NS_Atomize(const char16_t* aUTF16String) {
 
 already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsAString& aUTF16String) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
+
+  if (!NS_IsMainThread()) {
+    auto p = sRecentlyUsedOffMainThreadAtoms.Lookup(key);
+    if (p) {
+      RefPtr<nsAtom> atom = p.Data();
+      return atom.forget();
+    }
+
+    RefPtr<nsAtom> atom;
+    {
+      nsAtomSubTable& table = SelectSubTable(key);
+      MutexAutoLock lock(table.mLock);
+      AtomTableEntry* he = table.Add(key);
+
+      if (he->mAtom) {
+        atom = he->mAtom;
+      } else {
+        atom = dont_AddRef(nsDynamicAtom::Create(aUTF16String, key.mHash));
+        he->mAtom = atom;
+      }
+    }
+
+    p.Set(atom);
+    return atom.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -637,6 +685,74 @@ already_AddRefed<nsAtom> NS_AtomizeMainThread(const nsAString& aUTF16String) {
   return gAtomTable->AtomizeMainThread(aUTF16String);
 }
 
+void nsAtomTable::AtomizeMany(const nsTArray<nsString>& aStrings,
+                              nsTArray<RefPtr<nsAtom>>& aAtoms) {
+  const size_t n = aStrings.Length();
+  aAtoms.ClearAndRetainStorage();
+  aAtoms.SetLength(n);
+
+  AutoTArray<AtomTableKey, 64> keys;
+  keys.SetCapacity(n);
+  for (const nsString& string : aStrings) {
+    keys.AppendElement(AtomTableKey(string.Data(), string.Length()));
+  }
+
+  // Resolve what we can from the MRU cache without touching any locks.
+  const bool onMainThread = NS_IsMainThread();
+  for (size_t i = 0; i < n; i++) {
+    if (onMainThread) {
+      auto p = sRecentlyUsedMainThreadAtoms.Lookup(keys[i]);
+      if (p) {
+        aAtoms[i] = p.Data();
+      }
+    } else {
+      auto p = sRecentlyUsedOffMainThreadAtoms.Lookup(keys[i]);
+      if (p) {
+        aAtoms[i] = p.Data();
+      }
+    }
+  }
+
+  // Resolve the rest, acquiring each subtable lock once per batch: for each
+  // unresolved string, every later string that maps to the same subtable is
+  // resolved under the same lock acquisition.
+  for (size_t i = 0; i < n; i++) {
+    if (aAtoms[i]) {
+      continue;
+    }
+    nsAtomSubTable& table = SelectSubTable(keys[i]);
+    MutexAutoLock lock(table.mLock);
+    for (size_t j = i; j < n; j++) {
+      if (aAtoms[j] || &SelectSubTable(keys[j]) != &table) {
+        continue;
+      }
+      AtomTableEntry* he = table.Add(keys[j]);
+      if (he->mAtom) {
+        aAtoms[j] = he->mAtom;
+      } else {
+        RefPtr<nsAtom> atom =
+            dont_AddRef(nsDynamicAtom::Create(aStrings[j], keys[j].mHash));
+        he->mAtom = atom;
+        aAtoms[j] = std::move(atom);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (onMainThread) {
+      sRecentlyUsedMainThreadAtoms.Put(keys[i], aAtoms[i].get());
+    } else {
+      sRecentlyUsedOffMainThreadAtoms.Put(keys[i], aAtoms[i]);
+    }
+  }
+}
+
+void NS_AtomizeMany(const nsTArray<nsString>& aStrings,
+                    nsTArray<RefPtr<nsAtom>>& aAtoms) {
+  MOZ_ASSERT(gAtomTable);
+  gAtomTable->AtomizeMany(aStrings, aAtoms);
+}
+
 nsrefcnt NS_GetNumberOfAtoms(void) {
   MOZ_ASSERT(gAtomTable);
   return gAtomTable->RacySlowCount();
@@ -9,8 +9,67 @@
 #include <string.h>
 
 #include "mozilla/CheckedInt.h"
+#include "mozilla/StaticMutex.h"
 
-#define modulus(x, y) ((x) % (y))
+/**
+ * Deque storage is segmented into fixed-size blocks of item slots. A block
+ * is a power-of-two number of bytes, which the allocator serves naturally
+ * aligned, so a block spans no more cache lines than necessary. Growth only
+ * ever moves block *pointers* around in the map; the items themselves are
+ * never copied, and a push or pop touches exactly one block.
+ *
+ * Retired blocks are recycled through a process-wide freelist, since the
+ * parser and event machinery create and drain deques at a high rate.
+ */
+namespace {
+
+const size_t kDequeBlockBytes = 1024;
+const size_t kItemsPerBlock = kDequeBlockBytes / sizeof(void*);
+
+union DequeBlock {
+  void* mItems[kItemsPerBlock];
+  DequeBlock* mNext;  // freelist link, only used while the block is free
+};
+
+static_assert(sizeof(DequeBlock) == kDequeBlockBytes,
+              "deque blocks must stay a power-of-two number of bytes");
+
+// Cap the freelist so that a burst of large deques can't pin memory forever.
+const size_t kMaxFreeBlocks = 64;
+
+mozilla::StaticMutex sFreeBlocksMutex;
+DequeBlock* sFreeBlocks;  // guarded by sFreeBlocksMutex
+size_t sNumFreeBlocks;    // guarded by sFreeBlocksMutex
+
+DequeBlock* AllocBlock() {
+  {
+    mozilla::StaticMutexAutoLock lock(sFreeBlocksMutex);
+    if (sFreeBlocks) {
+      DequeBlock* block = sFreeBlocks;
+      sFreeBlocks = block->mNext;
+      sNumFreeBlocks--;
+      return block;
+    }
+  }
+  return static_cast<DequeBlock*>(malloc(sizeof(DequeBlock)));
+}
+
+void FreeBlock(DequeBlock* aBlock) {
+  {
+    mozilla::StaticMutexAutoLock lock(sFreeBlocksMutex);
+    if (sNumFreeBlocks < kMaxFreeBlocks) {
+      aBlock->mNext = sFreeBlocks;
+      sFreeBlocks = aBlock;
+      sNumFreeBlocks++;
+      return;
+    }
+  }
+  free(aBlock);
+}
+
+DequeBlock* AsBlock(void* aPtr) { return static_cast<DequeBlock*>(aPtr); }
+
+}  // namespace
 
 /**
  * Standard constructor
@@ -19,10 +78,12 @@
 nsDeque::nsDeque(nsDequeFunctor* aDeallocator) {
   MOZ_COUNT_CTOR(nsDeque);
   mDeallocator = aDeallocator;
-  mOrigin = mSize = 0;
-  mData = mBuffer;  // don't allocate space until you must
-  mCapacity = sizeof(mBuffer) / sizeof(mBuffer[0]);
-  memset(mData, 0, mCapacity * sizeof(mBuffer[0]));
+  mSize = 0;
+  mBlockMap = nullptr;  // don't allocate space until you must
+  mMapCapacity = 0;
+  mFirstBlock = 0;
+  mNumBlocks = 0;
+  mOriginSlot = 0;
 }
 
 /**
@@ -32,17 +93,21 @@ nsDeque::~nsDeque() {
   MOZ_COUNT_DTOR(nsDeque);
 
   Erase();
-  if (mData && mData != mBuffer) {
-    free(mData);
-  }
-  mData = 0;
+  free(mBlockMap);
+  mBlockMap = 0;
   SetDeallocator(0);
 }
 
 size_t nsDeque::SizeOfExcludingThis(mozilla::MallocSizeOf aMallocSizeOf) const {
   size_t size = 0;
-  if (mData != mBuffer) {
-    size += aMallocSizeOf(mData);
+  if (mBlockMap) {
+    size += aMallocSizeOf(mBlockMap);
+  }
+
+  // The freelist is process-wide, so blocks are only measured while a deque
+  // is using them.
+  for (size_t i = 0; i < mNumBlocks; ++i) {
+    size += aMallocSizeOf(mBlockMap[mFirstBlock + i]);
   }
 
   if (mDeallocator) {
@@ -69,13 +134,16 @@ void nsDeque::SetDeallocator(nsDequeFunctor* aDeallocator) {
 
 /**
  * Remove all items from container without destroying them.
+ * Blocks go back to the freelist; the block map is kept.
  */
 void nsDeque::Empty() {
-  if (mSize && mData) {
-    memset(mData, 0, mCapacity * sizeof(*mData));
+  for (size_t i = 0; i < mNumBlocks; ++i) {
+    FreeBlock(AsBlock(mBlockMap[mFirstBlock + i]));
   }
   mSize = 0;
-  mOrigin = 0;
+  mFirstBlock = mMapCapacity / 2;
+  mNumBlocks = 0;
+  mOriginSlot = 0;
 }
 
 /**
@@ -89,19 +157,32 @@ void nsDeque::Erase() {
 }
 
 /**
- * This method quadruples the size of the deque
- * Elements in the deque are resequenced so that elements
- * in the deque are stored sequentially
+ * Make sure the block map has a free entry on the requested side, either by
+ * recentering the blocks in use (a memmove of block pointers) or by
+ * reallocating the map. Items are never copied here; only the small map of
+ * block pointers moves.
  *
- * @return  whether growing succeeded
+ * @return  whether a map entry is available
  */
-bool nsDeque::GrowCapacity() {
-  mozilla::CheckedInt<size_t> newCapacity = mCapacity;
-  newCapacity *= 4;
+bool nsDeque::EnsureMapSpace(bool aAtFront) {
+  if (aAtFront ? mFirstBlock > 0 : mFirstBlock + mNumBlocks < mMapCapacity) {
+    return true;
+  }
 
-  NS_ASSERTION(newCapacity.isValid(), "Overflow");
-  if (!newCapacity.isValid()) {
-    return false;
+  // If at least half of the map is free, recentering leaves slack on both
+  // sides; otherwise grow the map.
+  if (mMapCapacity >= 2 * (mNumBlocks + 1)) {
+    size_t newFirst = (mMapCapacity - mNumBlocks) / 2;
+    memmove(mBlockMap + newFirst, mBlockMap + mFirstBlock,
+            mNumBlocks * sizeof(void*));
+    mFirstBlock = newFirst;
+    return true;
+  }
+
+  mozilla::CheckedInt<size_t> newCapacity = mMapCapacity;
+  newCapacity *= 4;
+  if (!mMapCapacity) {
+    newCapacity = 8;
   }
 
   // Sanity check the new byte size.
@@ -113,93 +194,97 @@ bool nsDeque::GrowCapacity() {
     return false;
   }
 
-  void** temp = (void**)malloc(newByteSize.value());
-  if (!temp) {
+  void** newMap = (void**)malloc(newByteSize.value());
+  if (!newMap) {
     return false;
   }
 
-  // Here's the interesting part: You can't just move the elements
-  // directly (in situ) from the old buffer to the new one.
-  // Since capacity has changed, the old origin doesn't make
-  // sense anymore. It's better to resequence the elements now.
+  size_t newFirst = (newCapacity.value() - mNumBlocks) / 2;
+  memcpy(newMap + newFirst, mBlockMap + mFirstBlock,
+         mNumBlocks * sizeof(void*));
+  free(mBlockMap);
 
-  memcpy(temp, mData + mOrigin, sizeof(void*) * (mCapacity - mOrigin));
-  memcpy(temp + (mCapacity - mOrigin), mData, sizeof(void*) * mOrigin);
+  mBlockMap = newMap;
+  mMapCapacity = newCapacity.value();
+  mFirstBlock = newFirst;
 
-  if (mData != mBuffer) {
-    free(mData);
-  }
+  return true;
+}
 
-  mCapacity = newCapacity.value();
-  mOrigin = 0;  // now realign the origin...
-  mData = temp;
+/**
+ * Append a fresh block after the last block in use.
+ *
+ * @return  whether the block could be added
+ */
+bool nsDeque::AddBlockAtBack() {
+  if (!EnsureMapSpace(false)) {
+    return false;
+  }
+  DequeBlock* block = AllocBlock();
+  if (!block) {
+    return false;
+  }
+  mBlockMap[mFirstBlock + mNumBlocks] = block;
+  mNumBlocks++;
+  return true;
+}
 
+/**
+ * Prepend a fresh block before the first block in use.
+ *
+ * @return  whether the block could be added
+ */
+bool nsDeque::AddBlockAtFront() {
+  if (!EnsureMapSpace(true)) {
+    return false;
+  }
+  DequeBlock* block = AllocBlock();
+  if (!block) {
+    return false;
+  }
+  mFirstBlock--;
+  mBlockMap[mFirstBlock] = block;
+  mNumBlocks++;
   return true;
 }
 
 /**
  * This method adds an item to the end of the deque.
- * This operation has the potential to cause the
- * underlying buffer to resize.
+ * This operation may add a block to the underlying
+ * storage, but never moves existing items.
  *
  * @param   aItem: new item to be added to deque
  */
 bool nsDeque::Push(void* aItem, const fallible_t&) {
-  if (mSize == mCapacity && !GrowCapacity()) {
+  size_t offset = mOriginSlot + mSize;
+  size_t blockIndex = offset / kItemsPerBlock;
+  if (blockIndex == mNumBlocks && !AddBlockAtBack()) {
     return false;
   }
-  mData[modulus(mOrigin + mSize, mCapacity)] = aItem;
+  AsBlock(mBlockMap[mFirstBlock + blockIndex])
+      ->mItems[offset % kItemsPerBlock] = aItem;
   mSize++;
   return true;
 }
 
 /**
  * This method adds an item to the front of the deque.
- * This operation has the potential to cause the
- * underlying buffer to resize.
- *
- * --Commments for GrowCapacity() case
- * We've grown and shifted which means that the old
- * final element in the deque is now the first element
- * in the deque.  This is temporary.
- * We haven't inserted the new element at the front.
+ * This operation may add a block to the underlying
+ * storage, but never moves existing items.
  *
- * To continue with the idea of having the front at zero
- * after a grow, we move the old final item (which through
- * the voodoo of mOrigin-- is now the first) to its final
- * position which is conveniently the old length.
- *
- * Note that this case only happens when the deque is full.
- * [And that pieces of this magic only work if the deque is full.]
- * picture:
- *   [ABCDEFGH] @[mOrigin:3]:D.
- * Task: PushFront("Z")
- * shift mOrigin so, @[mOrigin:2]:C
- * stretch and rearrange: (mOrigin:0)
- *   [CDEFGHAB ________ ________ ________]
- * copy: (The second C is currently out of bounds)
- *   [CDEFGHAB C_______ ________ ________]
- * later we will insert Z:
- *   [ZDEFGHAB C_______ ________ ________]
- * and increment size: 9. (C is no longer out of bounds)
- * --
  * @param   aItem: new item to be added to deque
  */
 bool nsDeque::PushFront(void* aItem, const fallible_t&) {
-  if (mOrigin == 0) {
-    mOrigin = mCapacity - 1;
-  } else {
-    mOrigin--;
-  }
-
-  if (mSize == mCapacity) {
-    if (!GrowCapacity()) {
+  if (mOriginSlot == 0) {
+    // The front block (if any) is full; the new front item goes into the
+    // last slot of a freshly prepended block.
+    if (!AddBlockAtFront()) {
       return false;
     }
-    /* Comments explaining this are above*/
-    mData[mSize] = mData[mOrigin];
+    mOriginSlot = kItemsPerBlock;
   }
-  mData[mOrigin] = aItem;
+  mOriginSlot--;
+  AsBlock(mBlockMap[mFirstBlock])->mItems[mOriginSlot] = aItem;
   mSize++;
   return true;
 }
@@ -213,11 +298,23 @@ void* nsDeque::Pop() {
   void* result = 0;
   if (mSize > 0) {
     --mSize;
-    size_t offset = modulus(mSize + mOrigin, mCapacity);
-    result = mData[offset];
-    mData[offset] = 0;
+    size_t offset = mOriginSlot + mSize;
+    DequeBlock* block =
+        AsBlock(mBlockMap[mFirstBlock + offset / kItemsPerBlock]);
+    size_t slot = offset % kItemsPerBlock;
+    result = block->mItems[slot];
+    block->mItems[slot] = 0;
+    // Retire blocks past the last remaining item. A lone block is kept as a
+    // spare so that emptying and refilling a deque doesn't thrash the
+    // freelist.
+    size_t usedBlocks =
+        (mOriginSlot + mSize + kItemsPerBlock - 1) / kItemsPerBlock;
+    while (mNumBlocks > usedBlocks && mNumBlocks > 1) {
+      mNumBlocks--;
+      FreeBlock(AsBlock(mBlockMap[mFirstBlock + mNumBlocks]));
+    }
     if (!mSize) {
-      mOrigin = 0;
+      mOriginSlot = 0;
     }
   }
   return result;
@@ -232,14 +329,21 @@ void* nsDeque::Pop() {
 void* nsDeque::PopFront() {
   void* result = 0;
   if (mSize > 0) {
-    NS_ASSERTION(mOrigin < mCapacity, "Error: Bad origin");
-    result = mData[mOrigin];
-    mData[mOrigin++] = 0;  // zero it out for debugging purposes.
+    NS_ASSERTION(mOriginSlot < kItemsPerBlock, "Error: Bad origin");
+    DequeBlock* block = AsBlock(mBlockMap[mFirstBlock]);
+    result = block->mItems[mOriginSlot];
+    block->mItems[mOriginSlot++] = 0;  // zero it out for debugging purposes.
     mSize--;
-    // Cycle around if we pop off the end
-    // and reset origin if when we pop the last element
-    if (mCapacity == mOrigin || !mSize) {
-      mOrigin = 0;
+    // Retire the front block if we pop off its end,
+    // and reset origin when we pop the last element
+    if (mOriginSlot == kItemsPerBlock) {
+      FreeBlock(block);
+      mFirstBlock++;
+      mNumBlocks--;
+      mOriginSlot = 0;
+    }
+    if (!mSize) {
+      mOriginSlot = 0;
     }
   }
   return result;
@@ -254,7 +358,7 @@ void* nsDeque::PopFront() {
 void* nsDeque::Peek() const {
   void* result = 0;
   if (mSize > 0) {
-    result = mData[modulus(mSize - 1 + mOrigin, mCapacity)];
+    result = ObjectAt(mSize - 1);
   }
   return result;
 }
@@ -268,7 +372,7 @@ void* nsDeque::Peek() const {
 void* nsDeque::PeekFront() const {
   void* result = 0;
   if (mSize > 0) {
-    result = mData[mOrigin];
+    result = AsBlock(mBlockMap[mFirstBlock])->mItems[mOriginSlot];
   }
   return result;
 }
@@ -277,7 +381,8 @@ void* nsDeque::PeekFront() const {
  * Call this to retrieve the ith element from this container.
  * Keep in mind that accessing the underlying elements is
  * done in a relative fashion. Object 0 is not necessarily
- * the first element (the first element is at mOrigin).
+ * the first slot of the first block (the first element is at
+ * mOriginSlot).
  *
  * @param   aIndex : 0 relative offset of item you want
  * @return  void* or null
@@ -285,7 +390,9 @@ void* nsDeque::PeekFront() const {
 void* nsDeque::ObjectAt(size_t aIndex) const {
   void* result = 0;
   if (aIndex < mSize) {
-    result = mData[modulus(mOrigin + aIndex, mCapacity)];
+    size_t offset = mOriginSlot + aIndex;
+    result = AsBlock(mBlockMap[mFirstBlock + offset / kItemsPerBlock])
+                 ->mItems[offset % kItemsPerBlock];
   }
   return result;
 }
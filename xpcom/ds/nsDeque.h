@@ -16,10 +16,11 @@
  * - When full, it can efficiently resize dynamically.
  *
  * NOTE: The only bit of trickery here is that this deque is
- * built upon a ring-buffer. Like all ring buffers, the first
- * item may not be at index[0]. The mOrigin member determines
- * where the first child is. This point is quietly hidden from
- * customers of this class.
+ * built upon segmented storage: a small map of pointers to
+ * fixed-size item blocks. The first item may not be at the
+ * first slot of the first block; the mOriginSlot member
+ * determines where the first child is. This point is quietly
+ * hidden from customers of this class.
  */
 
 #ifndef _NSDEQUE
@@ -261,11 +262,18 @@ class nsDeque {
 
  protected:
   size_t mSize;
-  size_t mCapacity;
-  size_t mOrigin;
   nsDequeFunctor* mDeallocator;
-  void* mBuffer[8];
-  void** mData;
+
+  /**
+   * Map of pointers to fixed-size item blocks. The blocks in use occupy the
+   * map entries [mFirstBlock, mFirstBlock + mNumBlocks); mOriginSlot is the
+   * offset of the first item within the first block in use.
+   */
+  void** mBlockMap;
+  size_t mMapCapacity;
+  size_t mFirstBlock;
+  size_t mNumBlocks;
+  size_t mOriginSlot;
 
  private:
   /**
@@ -283,7 +291,9 @@ class nsDeque {
    */
   nsDeque& operator=(const nsDeque& aOther) = delete;
 
-  bool GrowCapacity();
+  bool EnsureMapSpace(bool aAtFront);
+  bool AddBlockAtBack();
+  bool AddBlockAtFront();
   void SetDeallocator(nsDequeFunctor* aDeallocator);
 
   /**
@@ -130,6 +130,10 @@ class ExpirationTrackerImpl {
     if (mTimer) {
       mTimer->Cancel();
     }
+    if (mPendingSweepEvent) {
+      mPendingSweepEvent->Cancel();
+      mPendingSweepEvent = nullptr;
+    }
     mObserver->Destroy();
   }
 
@@ -383,6 +387,7 @@ class ExpirationTrackerImpl {
   RefPtr<ExpirationTrackerObserver> mObserver;
   nsTArray<T*> mGenerations[K];
   nsCOMPtr<nsITimer> mTimer;
+  RefPtr<mozilla::CancelableRunnable> mPendingSweepEvent;
   uint32_t mTimerPeriod;
   uint32_t mNewestGeneration;
   bool mInAgeOneGeneration;
@@ -440,9 +445,36 @@ class ExpirationTrackerImpl {
     NotifyHandlerEnd();
   }
 
+  /**
+   * The timer fires on the main thread. Rather than sweeping a generation
+   * right away, defer the sweep to an idle slice so that it doesn't compete
+   * with user-visible work. Using the timer period as the idle timeout bounds
+   * the deferral on a busy thread to one extra period, which keeps the expiry
+   * guarantee documented on NotifyExpiredLocked.
+   */
+  void ScheduleSweep() {
+    if (mPendingSweepEvent) {
+      // A sweep is already waiting for an idle slice; piling up more would
+      // just age multiple generations at once when the thread finally idles.
+      return;
+    }
+    RefPtr<mozilla::CancelableRunnable> event =
+        NS_NewCancelableRunnableFunction(mName, [this] {
+          mPendingSweepEvent = nullptr;
+          HandleTimeout();
+        });
+    mPendingSweepEvent = event;
+    if (NS_FAILED(NS_DispatchToCurrentThreadQueue(
+            event.forget(), mTimerPeriod, mozilla::EventQueuePriority::Idle))) {
+      // Dispatch can fail during shutdown; sweep right away instead.
+      mPendingSweepEvent = nullptr;
+      HandleTimeout();
+    }
+  }
+
   static void TimerCallback(nsITimer* aTimer, void* aThis) {
     ExpirationTrackerImpl* tracker = static_cast<ExpirationTrackerImpl*>(aThis);
-    tracker->HandleTimeout();
+    tracker->ScheduleSweep();
   }
 
   nsresult CheckStartTimerLocked(const AutoLock& aAutoLock) {
@@ -13,14 +13,14 @@
 nsresult nsObserverList::AddObserver(nsIObserver* anObserver, bool ownsWeak) {
   NS_ASSERTION(anObserver, "Null input");
 
-  MOZ_TRY(mObservers.AppendWeakElement(anObserver, ownsWeak));
+  MOZ_TRY(MutableObservers().AppendWeakElement(anObserver, ownsWeak));
   return NS_OK;
 }
 
 nsresult nsObserverList::RemoveObserver(nsIObserver* anObserver) {
   NS_ASSERTION(anObserver, "Null input");
 
-  MOZ_TRY(mObservers.RemoveWeakElement(anObserver));
+  MOZ_TRY(MutableObservers().RemoveWeakElement(anObserver));
   return NS_OK;
 }
 
@@ -30,27 +30,30 @@ void nsObserverList::GetObserverList(nsISimpleEnumerator** anEnumerator) {
 }
 
 void nsObserverList::FillObserverArray(nsCOMArray<nsIObserver>& aArray) {
-  aArray.SetCapacity(mObservers.Length());
+  RefPtr<ObserverArray> observers = Snapshot();
 
-  nsMaybeWeakPtrArray<nsIObserver> observers(mObservers);
+  aArray.SetCapacity(observers->Length());
 
-  for (int32_t i = observers.Length() - 1; i >= 0; --i) {
-    nsCOMPtr<nsIObserver> observer = observers[i].GetValue();
+  for (int32_t i = observers->Length() - 1; i >= 0; --i) {
+    nsCOMPtr<nsIObserver> observer = (*observers)[i].GetValue();
     if (observer) {
       aArray.AppendObject(observer);
     } else {
-      // the object has gone away, remove the weakref
-      mObservers.RemoveElementAt(i);
+      // The object has gone away; drop the weakref from the current array
+      // (which may by now be a copy of our snapshot).
+      MutableObservers().RemoveElement((*observers)[i]);
     }
   }
 }
 
 void nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray) {
-  aArray.SetCapacity(aArray.Length() + mObservers.Length());
+  const ObserverArray& observers = *mObservers;
+
+  aArray.SetCapacity(aArray.Length() + observers.Length());
 
-  for (int32_t i = mObservers.Length() - 1; i >= 0; --i) {
-    if (!mObservers[i].IsWeak()) {
-      nsCOMPtr<nsIObserver> observer = mObservers[i].GetValue();
+  for (int32_t i = observers.Length() - 1; i >= 0; --i) {
+    if (!observers[i].IsWeak()) {
+      nsCOMPtr<nsIObserver> observer = observers[i].GetValue();
       aArray.AppendObject(observer);
     }
   }
@@ -58,11 +61,21 @@ void nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray) {
 
 void nsObserverList::NotifyObservers(nsISupports* aSubject, const char* aTopic,
                                      const char16_t* someData) {
-  nsCOMArray<nsIObserver> observers;
-  FillObserverArray(observers);
-
-  for (int32_t i = 0; i < observers.Count(); ++i) {
-    observers[i]->Observe(aSubject, aTopic, someData);
+  // Iterate over an immutable snapshot: observers added or removed by an
+  // Observe() callback mutate a fresh copy of the array, so no defensive
+  // copy is needed here. The snapshot is walked last-added-first, matching
+  // the order FillObserverArray produces.
+  RefPtr<ObserverArray> observers = Snapshot();
+
+  for (int32_t i = observers->Length() - 1; i >= 0; --i) {
+    nsCOMPtr<nsIObserver> observer = (*observers)[i].GetValue();
+    if (observer) {
+      observer->Observe(aSubject, aTopic, someData);
+    } else {
+      // The object has gone away; drop the weakref from the current array
+      // (which may by now be a copy of our snapshot).
+      MutableObservers().RemoveElement((*observers)[i]);
+    }
   }
 }
 
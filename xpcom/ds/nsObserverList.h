@@ -15,12 +15,14 @@
 #include "nsMaybeWeakPtr.h"
 #include "nsSimpleEnumerator.h"
 #include "mozilla/Attributes.h"
+#include "mozilla/RefPtr.h"
 
 class nsObserverList : public nsCharPtrHashKey {
   friend class nsObserverService;
 
  public:
-  explicit nsObserverList(const char* aKey) : nsCharPtrHashKey(aKey) {
+  explicit nsObserverList(const char* aKey)
+      : nsCharPtrHashKey(aKey), mObservers(new ObserverArray()) {
     MOZ_COUNT_CTOR(nsObserverList);
   }
 
@@ -45,7 +47,45 @@ class nsObserverList : public nsCharPtrHashKey {
   void AppendStrongObservers(nsCOMArray<nsIObserver>& aArray);
 
  private:
-  nsMaybeWeakPtrArray<nsIObserver> mObservers;
+  /**
+   * The observers for this topic. The array object becomes immutable the
+   * moment a snapshot of it is handed to a notification or enumeration in
+   * progress: mutations copy the array and swap in the copy, so in-flight
+   * notifications keep iterating their snapshot without each notification
+   * having to copy the array defensively up front.
+   */
+  class ObserverArray final : public nsMaybeWeakPtrArray<nsIObserver> {
+   public:
+    NS_INLINE_DECL_REFCOUNTING(ObserverArray)
+
+    ObserverArray() = default;
+    explicit ObserverArray(const ObserverArray& aOther)
+        : nsMaybeWeakPtrArray<nsIObserver>(aOther) {}
+
+    // Set once the array has been handed out as a snapshot; from then on
+    // the contents must not change.
+    bool mShared = false;
+
+   private:
+    ~ObserverArray() = default;
+  };
+
+  // Grab an immutable snapshot of the current observers.
+  already_AddRefed<ObserverArray> Snapshot() {
+    mObservers->mShared = true;
+    RefPtr<ObserverArray> snapshot = mObservers;
+    return snapshot.forget();
+  }
+
+  // The current array, copied first if an outstanding snapshot shares it.
+  ObserverArray& MutableObservers() {
+    if (mObservers->mShared) {
+      mObservers = new ObserverArray(*mObservers);
+    }
+    return *mObservers;
+  }
+
+  RefPtr<ObserverArray> mObservers;
 };
 
 class nsObserverEnumerator final : public nsSimpleEnumerator {
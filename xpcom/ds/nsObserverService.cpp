@@ -65,7 +65,7 @@ nsObserverService::CollectReports(nsIHandleReportCallback* aHandleReport,
     size_t topicNumWeakAlive = 0;
     size_t topicNumWeakDead = 0;
 
-    nsMaybeWeakPtrArray<nsIObserver>& observers = observerList->mObservers;
+    auto& observers = *observerList->mObservers;
     for (uint32_t i = 0; i < observers.Length(); i++) {
       if (observers[i].IsWeak()) {
         nsCOMPtr<nsIObserver> ref = observers[i].GetValue();
@@ -301,6 +301,34 @@ NS_IMETHODIMP nsObserverService::NotifyObservers(nsISupports* aSubject,
   return NS_OK;
 }
 
+nsObserverList* nsObserverService::GetTopicHandle(const char* aTopic) {
+  if (NS_FAILED(EnsureValidCall()) || NS_WARN_IF(!aTopic)) {
+    return nullptr;
+  }
+
+  // Entries are only ever removed from the table at shutdown, so the entry
+  // itself can serve as a long-lived handle for the topic.
+  return mObserverTopicTable.PutEntry(aTopic);
+}
+
+nsresult nsObserverService::NotifyObservers(nsObserverList* aTopicHandle,
+                                            nsISupports* aSubject,
+                                            const char16_t* aSomeData) {
+  MOZ_TRY(EnsureValidCall());
+  if (NS_WARN_IF(!aTopicHandle)) {
+    return NS_ERROR_INVALID_ARG;
+  }
+
+  LOG(("nsObserverService::NotifyObservers(%s) [cached handle]",
+       aTopicHandle->GetKey()));
+
+  AUTO_PROFILER_LABEL_DYNAMIC_CSTR_NONSENSITIVE(
+      "nsObserverService::NotifyObservers", OTHER, aTopicHandle->GetKey());
+
+  aTopicHandle->NotifyObservers(aSubject, aTopicHandle->GetKey(), aSomeData);
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsObserverService::UnmarkGrayStrongObservers() {
   MOZ_TRY(EnsureValidCall());
@@ -43,6 +43,22 @@ class nsObserverService final : public nsIObserverService,
   // collector will not traverse them.
   NS_IMETHOD UnmarkGrayStrongObservers();
 
+  /**
+   * Returns an opaque handle for a topic, which fire-often callers can cache
+   * to skip the per-notification hash lookup of the topic string. Topic
+   * entries are never removed from the table once created, so a handle stays
+   * valid until XPCOM shutdown. Main thread only, like the rest of the
+   * service; returns null during shutdown.
+   */
+  nsObserverList* GetTopicHandle(const char* aTopic);
+
+  /**
+   * Like the topic-string NotifyObservers, but dispatches straight to the
+   * observer list behind a cached topic handle.
+   */
+  nsresult NotifyObservers(nsObserverList* aTopicHandle, nsISupports* aSubject,
+                           const char16_t* aSomeData);
+
  private:
   ~nsObserverService(void);
   void RegisterReporter();
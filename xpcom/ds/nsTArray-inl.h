@@ -102,6 +102,25 @@ bool nsTArray_base<Alloc, Copy>::UsesAutoArrayBuffer() const {
 bool IsTwiceTheRequiredBytesRepresentableAsUint32(size_t aCapacity,
                                                   size_t aElemSize);
 
+#ifdef MOZ_TARRAY_GROWTH_INSTRUMENTATION
+// How an nsTArray buffer grew. The growth path lives in the type-erased
+// nsTArray_base, so growth statistics are aggregated by element size; see
+// nsTArray.cpp.
+enum class nsTArrayGrowthKind {
+  // First heap allocation for a previously empty array.
+  InitialAlloc,
+  // In-place (realloc) growth of an existing heap buffer.
+  GrowRealloc,
+  // Growth that had to allocate and copy, either because the elements are
+  // not memmovable or because they lived in an AutoTArray inline buffer.
+  GrowCopy,
+};
+
+// defined in nsTArray.cpp
+void nsTArray_RecordGrowth(size_t aElemSize, size_t aBytesAllocated,
+                           nsTArrayGrowthKind aKind);
+#endif
+
 template <class Alloc, class Copy>
 template <typename ActualAlloc>
 typename ActualAlloc::ResultTypeProxy
@@ -150,6 +169,11 @@ nsTArray_base<Alloc, Copy>::EnsureCapacity(size_type aCapacity,
     header->mIsAutoArray = 0;
     mHdr = header;
 
+#ifdef MOZ_TARRAY_GROWTH_INSTRUMENTATION
+    nsTArray_RecordGrowth(aElemSize, reqSize,
+                          nsTArrayGrowthKind::InitialAlloc);
+#endif
+
     return ActualAlloc::SuccessResult();
   }
 
@@ -186,12 +210,21 @@ nsTArray_base<Alloc, Copy>::EnsureCapacity(size_type aCapacity,
     if (!UsesAutoArrayBuffer()) {
       ActualAlloc::Free(mHdr);
     }
+
+#ifdef MOZ_TARRAY_GROWTH_INSTRUMENTATION
+    nsTArray_RecordGrowth(aElemSize, bytesToAlloc, nsTArrayGrowthKind::GrowCopy);
+#endif
   } else {
     // Realloc() existing data
     header = static_cast<Header*>(ActualAlloc::Realloc(mHdr, bytesToAlloc));
     if (!header) {
       return ActualAlloc::FailureResult();
     }
+
+#ifdef MOZ_TARRAY_GROWTH_INSTRUMENTATION
+    nsTArray_RecordGrowth(aElemSize, bytesToAlloc,
+                          nsTArrayGrowthKind::GrowRealloc);
+#endif
   }
 
   // How many elements can we fit in bytesToAlloc?
@@ -11,6 +11,12 @@
 #include "mozilla/CheckedInt.h"
 #include "mozilla/IntegerPrintfMacros.h"
 
+#ifdef MOZ_TARRAY_GROWTH_INSTRUMENTATION
+#  include <stdio.h>
+#  include <stdlib.h>
+#  include "mozilla/Atomics.h"
+#endif
+
 // Ensure this is sufficiently aligned so that Elements() and co don't create
 // unaligned pointers, or slices with unaligned pointers for empty arrays, see
 // https://github.com/servo/servo/issues/22613.
@@ -28,3 +34,97 @@ MOZ_NORETURN MOZ_COLD void InvalidArrayIndex_CRASH(size_t aIndex,
       "ElementAt(aIndex = %" PRIu64 ", aLength = %" PRIu64 ")",
       static_cast<uint64_t>(aIndex), static_cast<uint64_t>(aLength));
 }
+
+#ifdef MOZ_TARRAY_GROWTH_INSTRUMENTATION
+
+// Statistics about nsTArray buffer growth, aggregated by element size. The
+// growth path lives in the type-erased nsTArray_base and RTTI is disabled, so
+// the element size is the finest grain available without bloating every
+// instantiation. In practice an element size narrows the instantiations down
+// far enough to find the offending call sites with a conditional breakpoint
+// in nsTArray_RecordGrowth.
+namespace {
+
+struct ArrayGrowthStats {
+  // Claimed with a compare-exchange on first use; zero means unclaimed.
+  mozilla::Atomic<size_t> mElemSize;
+  mozilla::Atomic<uint64_t> mInitialAllocs;
+  mozilla::Atomic<uint64_t> mGrowReallocs;
+  mozilla::Atomic<uint64_t> mGrowCopies;
+  mozilla::Atomic<uint64_t> mBytesAllocated;
+};
+
+// Arrays grow on many threads, so slots are claimed atomically and never
+// released. Distinct element sizes are few; if the table ever fills up the
+// remainder is lumped into an overflow count rather than dropped silently.
+const size_t kArrayGrowthStatsSlots = 128;
+ArrayGrowthStats sArrayGrowthStats[kArrayGrowthStatsSlots];
+mozilla::Atomic<uint64_t> sArrayGrowthStatsOverflow;
+mozilla::Atomic<bool> sArrayGrowthDumpRegistered;
+
+void DumpArrayGrowthStats() {
+  fprintf(stderr, "== nsTArray growth statistics ==\n");
+  fprintf(stderr, "%10s %12s %12s %12s %16s\n", "elem size", "initial",
+          "realloc", "copy", "bytes");
+  for (const ArrayGrowthStats& stats : sArrayGrowthStats) {
+    size_t elemSize = stats.mElemSize;
+    if (!elemSize) {
+      continue;
+    }
+    fprintf(stderr,
+            "%10zu %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %16" PRIu64 "\n",
+            elemSize, uint64_t(stats.mInitialAllocs),
+            uint64_t(stats.mGrowReallocs), uint64_t(stats.mGrowCopies),
+            uint64_t(stats.mBytesAllocated));
+  }
+  if (uint64_t overflow = sArrayGrowthStatsOverflow) {
+    fprintf(stderr, "(%" PRIu64 " growths not attributed; stats table full)\n",
+            overflow);
+  }
+}
+
+ArrayGrowthStats* GetArrayGrowthStats(size_t aElemSize) {
+  // Fibonacci hash of the element size, then linear probing.
+  size_t index =
+      (aElemSize * size_t(0x9E3779B97F4A7C15ull)) % kArrayGrowthStatsSlots;
+  for (size_t probes = 0; probes < kArrayGrowthStatsSlots; ++probes) {
+    ArrayGrowthStats& stats =
+        sArrayGrowthStats[(index + probes) % kArrayGrowthStatsSlots];
+    if (stats.mElemSize == aElemSize ||
+        stats.mElemSize.compareExchange(0, aElemSize) ||
+        stats.mElemSize == aElemSize) {
+      return &stats;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+void nsTArray_RecordGrowth(size_t aElemSize, size_t aBytesAllocated,
+                           nsTArrayGrowthKind aKind) {
+  if (!sArrayGrowthDumpRegistered.exchange(true)) {
+    atexit(DumpArrayGrowthStats);
+  }
+
+  ArrayGrowthStats* stats = GetArrayGrowthStats(aElemSize);
+  if (!stats) {
+    sArrayGrowthStatsOverflow++;
+    return;
+  }
+
+  switch (aKind) {
+    case nsTArrayGrowthKind::InitialAlloc:
+      stats->mInitialAllocs++;
+      break;
+    case nsTArrayGrowthKind::GrowRealloc:
+      stats->mGrowReallocs++;
+      break;
+    case nsTArrayGrowthKind::GrowCopy:
+      stats->mGrowCopies++;
+      break;
+  }
+  stats->mBytesAllocated += aBytesAllocated;
+}
+
+#endif  // MOZ_TARRAY_GROWTH_INSTRUMENTATION
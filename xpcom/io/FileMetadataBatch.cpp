@@ -0,0 +1,151 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/FileMetadataBatch.h"
+
+#include <errno.h>
+
+#include "nsLocalFile.h"
+#include "nsString.h"
+#include "nsThreadUtils.h"
+
+#ifdef XP_WIN
+#  include <windows.h>
+#else
+#  include <sys/stat.h>
+#endif
+
+namespace mozilla {
+
+#ifdef XP_WIN
+typedef nsString PathString;
+#else
+typedef nsCString PathString;
+#endif
+
+namespace {
+
+// A path captured on the calling thread, remembering which slot of the
+// caller's array it came from so results can be returned in input order
+// even though we stat in path order.
+struct BatchEntry {
+  PathString mPath;
+  uint32_t mIndex;
+};
+
+class BatchEntryPathComparator {
+ public:
+  bool Equals(const BatchEntry& aA, const BatchEntry& aB) const {
+    return aA.mPath == aB.mPath;
+  }
+  bool LessThan(const BatchEntry& aA, const BatchEntry& aB) const {
+    return aA.mPath < aB.mPath;
+  }
+};
+
+#ifdef XP_WIN
+
+void StatOne(const PathString& aPath, FileMetadata& aMeta) {
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if (!::GetFileAttributesExW(char16ptr_t(aPath.get()), GetFileExInfoStandard,
+                              &data)) {
+    DWORD error = ::GetLastError();
+    if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND) {
+      // We successfully determined that the file is absent.
+      aMeta.mRv = NS_OK;
+    } else {
+      aMeta.mRv = NS_ERROR_FAILURE;
+    }
+    return;
+  }
+
+  aMeta.mRv = NS_OK;
+  aMeta.mExists = true;
+  aMeta.mIsDirectory = !!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+  aMeta.mSize =
+      (int64_t(data.nFileSizeHigh) << 32) | int64_t(data.nFileSizeLow);
+
+  // FILETIME is 100ns units since Jan 1, 1601 (cf. FileTimeToPRTime in
+  // nsLocalFileWin.cpp); nsIFile reports milliseconds since the epoch.
+  const PRTime kFiletimeOffset = 116444736000000000LL;
+  PRTime filetime;
+  MOZ_ASSERT(sizeof(FILETIME) == sizeof(PRTime));
+  ::CopyMemory(&filetime, &data.ftLastWriteTime, sizeof(PRTime));
+  aMeta.mLastModifiedTime =
+      (filetime - kFiletimeOffset) / 10LL / PR_USEC_PER_MSEC;
+}
+
+#else
+
+void StatOne(const PathString& aPath, FileMetadata& aMeta) {
+  struct STAT buf;
+  if (STAT(aPath.get(), &buf) == -1) {
+    if (errno == ENOENT || errno == ENOTDIR) {
+      // We successfully determined that the file is absent.
+      aMeta.mRv = NS_OK;
+    } else {
+      aMeta.mRv = NSRESULT_FOR_ERRNO();
+    }
+    return;
+  }
+
+  aMeta.mRv = NS_OK;
+  aMeta.mExists = true;
+  aMeta.mIsDirectory = S_ISDIR(buf.st_mode);
+  aMeta.mSize = int64_t(buf.st_size);
+  aMeta.mLastModifiedTime = PRTime(buf.st_mtime) * PR_MSEC_PER_SEC;
+}
+
+#endif  // XP_WIN
+
+}  // namespace
+
+RefPtr<FileMetadataPromise> GetFileMetadataBatch(
+    const nsTArray<nsCOMPtr<nsIFile>>& aFiles) {
+  nsTArray<BatchEntry> entries(aFiles.Length());
+  nsTArray<FileMetadata> results;
+  results.SetLength(aFiles.Length());
+
+  // Capture the paths now so the background task never touches the (not
+  // threadsafe) nsIFile objects. A file whose path can't be produced keeps
+  // that failure as its per-file result.
+  for (uint32_t i = 0; i < aFiles.Length(); ++i) {
+    PathString path;
+#ifdef XP_WIN
+    nsresult rv = aFiles[i]->GetPath(path);
+#else
+    nsresult rv = aFiles[i]->GetNativePath(path);
+#endif
+    if (NS_FAILED(rv)) {
+      results[i].mRv = rv;
+      continue;
+    }
+    entries.AppendElement(BatchEntry{std::move(path), i});
+  }
+
+  entries.Sort(BatchEntryPathComparator());
+
+  RefPtr<FileMetadataPromise::Private> promise =
+      new FileMetadataPromise::Private(__func__);
+
+  nsresult rv = NS_DispatchBackgroundTask(
+      NS_NewRunnableFunction("GetFileMetadataBatch",
+                             [entries = std::move(entries),
+                              results = std::move(results), promise]() mutable {
+                               for (const BatchEntry& entry : entries) {
+                                 StatOne(entry.mPath, results[entry.mIndex]);
+                               }
+                               promise->Resolve(std::move(results), __func__);
+                             }),
+      NS_DISPATCH_EVENT_MAY_BLOCK);
+  if (NS_FAILED(rv)) {
+    promise->Reject(rv, __func__);
+  }
+
+  return promise;
+}
+
+}  // namespace mozilla
@@ -0,0 +1,54 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_FileMetadataBatch_h
+#define mozilla_FileMetadataBatch_h
+
+#include "mozilla/MozPromise.h"
+#include "nsCOMPtr.h"
+#include "nsIFile.h"
+#include "nsTArray.h"
+#include "prtime.h"
+
+namespace mozilla {
+
+/**
+ * The result of statting a single file. mRv reports whether the stat itself
+ * could be performed; a file that simply doesn't exist is a successful
+ * result with mExists = false. The remaining members are only meaningful
+ * when mRv succeeded and mExists is true.
+ */
+struct FileMetadata {
+  nsresult mRv = NS_ERROR_NOT_INITIALIZED;
+  bool mExists = false;
+  bool mIsDirectory = false;
+  int64_t mSize = 0;
+  // Milliseconds since the epoch, like nsIFile.lastModifiedTime.
+  PRTime mLastModifiedTime = 0;
+};
+
+typedef MozPromise<nsTArray<FileMetadata>, nsresult, /* IsExclusive = */ true>
+    FileMetadataPromise;
+
+/**
+ * Stats every file in aFiles with a single dispatch to the background event
+ * target, instead of one synchronous main-thread syscall per Exists /
+ * GetFileSize / IsDirectory query. The native paths are captured on the
+ * calling thread, so the files themselves are never touched off-thread; the
+ * background task stats them in path order, which keeps the kernel's dentry
+ * and inode caches hot across siblings of the same directory.
+ *
+ * The returned promise resolves with one FileMetadata per input file, in
+ * input order, and rejects only if the background task couldn't be
+ * dispatched (i.e. during shutdown). As usual, pass an explicit event
+ * target to Then() to pick the thread the result is delivered on.
+ */
+RefPtr<FileMetadataPromise> GetFileMetadataBatch(
+    const nsTArray<nsCOMPtr<nsIFile>>& aFiles);
+
+}  // namespace mozilla
+
+#endif  // mozilla_FileMetadataBatch_h
@@ -52,9 +52,15 @@ char* nsSegmentedBuffer::AppendNewSegment() {
     mSegmentArrayCount = newArraySize;
   }
 
-  char* seg = (char*)malloc(mSegmentSize);
-  if (!seg) {
-    return nullptr;
+  char* seg;
+  if (mRecycledSegment) {
+    seg = mRecycledSegment;
+    mRecycledSegment = nullptr;
+  } else {
+    seg = (char*)malloc(mSegmentSize);
+    if (!seg) {
+      return nullptr;
+    }
   }
   mSegmentArray[mLastSegmentIndex] = seg;
   mLastSegmentIndex = ModSegArraySize(mLastSegmentIndex + 1);
@@ -64,7 +70,7 @@ char* nsSegmentedBuffer::AppendNewSegment() {
 bool nsSegmentedBuffer::DeleteFirstSegment() {
   NS_ASSERTION(mSegmentArray[mFirstSegmentIndex] != nullptr,
                "deleting bad segment");
-  FreeOMT(mSegmentArray[mFirstSegmentIndex]);
+  RecycleOrFree(mSegmentArray[mFirstSegmentIndex]);
   mSegmentArray[mFirstSegmentIndex] = nullptr;
   int32_t last = ModSegArraySize(mLastSegmentIndex - 1);
   if (mFirstSegmentIndex == last) {
@@ -79,7 +85,7 @@ bool nsSegmentedBuffer::DeleteFirstSegment() {
 bool nsSegmentedBuffer::DeleteLastSegment() {
   int32_t last = ModSegArraySize(mLastSegmentIndex - 1);
   NS_ASSERTION(mSegmentArray[last] != nullptr, "deleting bad segment");
-  FreeOMT(mSegmentArray[last]);
+  RecycleOrFree(mSegmentArray[last]);
   mSegmentArray[last] = nullptr;
   mLastSegmentIndex = last;
   return (bool)(mLastSegmentIndex == mFirstSegmentIndex);
@@ -91,6 +97,7 @@ bool nsSegmentedBuffer::ReallocLastSegment(size_t aNewSize) {
   char* newSegment = (char*)realloc(mSegmentArray[last], aNewSize);
   if (newSegment) {
     mSegmentArray[last] = newSegment;
+    mShrunkSegment = newSegment;
     return true;
   }
   return false;
@@ -106,6 +113,11 @@ void nsSegmentedBuffer::Empty() {
     FreeOMT(mSegmentArray);
     mSegmentArray = nullptr;
   }
+  if (mRecycledSegment) {
+    FreeOMT(mRecycledSegment);
+    mRecycledSegment = nullptr;
+  }
+  mShrunkSegment = nullptr;
   mSegmentArrayCount = NS_SEGMENTARRAY_INITIAL_COUNT;
   mFirstSegmentIndex = mLastSegmentIndex = 0;
 }
@@ -147,6 +159,20 @@ TestSegmentedBuffer()
 }
 #endif
 
+void nsSegmentedBuffer::RecycleOrFree(char* aSegment) {
+  // Hold on to one deleted segment for the next AppendNewSegment. A segment
+  // shrunk by ReallocLastSegment is smaller than mSegmentSize, so it has to
+  // go back to the allocator.
+  if (!mRecycledSegment && aSegment != mShrunkSegment) {
+    mRecycledSegment = aSegment;
+    return;
+  }
+  if (aSegment == mShrunkSegment) {
+    mShrunkSegment = nullptr;
+  }
+  FreeOMT(aSegment);
+}
+
 void nsSegmentedBuffer::FreeOMT(void* aPtr) {
   if (!NS_IsMainThread()) {
     free(aPtr);
@@ -17,7 +17,9 @@ class nsSegmentedBuffer {
         mSegmentArray(nullptr),
         mSegmentArrayCount(0),
         mFirstSegmentIndex(0),
-        mLastSegmentIndex(0) {}
+        mLastSegmentIndex(0),
+        mRecycledSegment(nullptr),
+        mShrunkSegment(nullptr) {}
 
   ~nsSegmentedBuffer() { Empty(); }
 
@@ -76,8 +78,17 @@ class nsSegmentedBuffer {
   int32_t mLastSegmentIndex;
 
  private:
+  void RecycleOrFree(char* aSegment);
   void FreeOMT(void* aPtr);
 
+  // One full-size segment kept for reuse by AppendNewSegment. In a pipe's
+  // steady state the reader deletes a segment at about the rate the writer
+  // appends one, so this turns a free/malloc pair per segment into a no-op.
+  char* mRecycledSegment;
+  // The segment last shrunk by ReallocLastSegment, if any; it is smaller
+  // than mSegmentSize and must not be recycled.
+  char* mShrunkSegment;
+
   nsCOMPtr<nsIEventTarget> mIOThread;
 };
 
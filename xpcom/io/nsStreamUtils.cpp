@@ -7,6 +7,7 @@
 #include "mozilla/Mutex.h"
 #include "mozilla/Attributes.h"
 #include "nsStreamUtils.h"
+#include "nsAlgorithm.h"
 #include "nsCOMPtr.h"
 #include "nsICloneableInputStream.h"
 #include "nsIEventTarget.h"
@@ -223,6 +224,13 @@ already_AddRefed<nsIOutputStreamCallback> NS_NewOutputStreamReadyEvent(
 //-----------------------------------------------------------------------------
 // NS_AsyncCopy implementation
 
+// A stream copier doubles its per-iteration byte budget each time the source
+// fills the current budget completely, up to this bound. Transfers that
+// trickle stay at the caller-provided chunk size, while bulk transfers (e.g.
+// downloads) amortize the per-segment virtual dispatch and event-loop round
+// trips over larger batches.
+static const uint32_t kMaxAsyncCopyChunkSize = 256 * 1024;
+
 // abstract stream copier...
 class nsAStreamCopier : public nsIInputStreamCallback,
                         public nsIOutputStreamCallback,
@@ -302,6 +310,11 @@ class nsAStreamCopier : public nsIInputStreamCallback,
         if (n > 0 && mProgressCallback) {
           mProgressCallback(mClosure, n);
         }
+        if (n == mChunkSize && mChunkSize < kMaxAsyncCopyChunkSize) {
+          // The source saturated our budget, so we're throughput-bound;
+          // grow the budget for the next iteration.
+          mChunkSize = XPCOM_MIN(mChunkSize * 2, kMaxAsyncCopyChunkSize);
+        }
         copyFailed =
             NS_FAILED(sourceCondition) || NS_FAILED(sinkCondition) || n == 0;
 
@@ -83,6 +83,10 @@ typedef void (*nsAsyncCopyCallbackFun)(void* closure, nsresult status);
  * or aCloseSink to false.
  *
  * Caller can obtain aCopierCtx to be able to cancel copying.
+ *
+ * aChunkSize is the initial per-iteration byte budget. Whenever the source
+ * keeps the budget fully saturated the copier doubles it, up to 256 KiB, so
+ * bulk transfers aren't bound by the default.
  */
 extern nsresult NS_AsyncCopy(
     nsIInputStream* aSource, nsIOutputStream* aSink, nsIEventTarget* aTarget,
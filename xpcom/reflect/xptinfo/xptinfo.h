@@ -14,6 +14,7 @@
 #define xptinfo_h
 
 #include <stdint.h>
+#include <type_traits>
 #include "nsID.h"
 #include "mozilla/Assertions.h"
 #include "jsapi.h"
@@ -129,6 +130,17 @@ struct nsXPTInterfaceInfo {
 // The fields in nsXPTInterfaceInfo were carefully ordered to minimize size.
 static_assert(sizeof(nsXPTInterfaceInfo) == 28, "wrong size?");
 
+// All cross-references are stored as indices rather than pointers, so the
+// generated typelib arrays contain no relocations, stay in .rodata, and
+// their pages are shared between every process by the OS. A member with a
+// constructor, destructor or vtable would silently turn the whole table
+// into per-process initialized memory, so guard against that here; keeping
+// members pointer-free is xptcodegen.py's side of the contract.
+// (nsXPTDOMObjectInfo is the documented exception; it holds function
+// pointers and lives in its own array.)
+static_assert(std::is_trivial_v<nsXPTInterfaceInfo>,
+              "nsXPTInterfaceInfo must stay shareable constant data");
+
 /*
  * The following enum represents contains the different tag types which
  * can be found in nsXPTTypeInfo::mTag.
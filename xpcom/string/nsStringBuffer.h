@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include "mozilla/MemoryReporting.h"
+#include "mozjemalloc_types.h"
 
 template <class T>
 struct already_AddRefed;
@@ -178,6 +179,14 @@ class nsStringBuffer {
    */
   size_t SizeOfIncludingThisEvenIfShared(
       mozilla::MallocSizeOf aMallocSizeOf) const;
+
+  /**
+   * Fills the given stats structure with statistics about the arena all
+   * string buffers are allocated from.  Note that the allocated amount
+   * overlaps with the string buffers measured via the SizeOf methods
+   * above, so it must not be reported as KIND_HEAP memory.
+   */
+  static void ArenaStats(jemalloc_arena_stats_t* aStats);
 };
 
 #endif /* !defined(nsStringBuffer_h__ */
@@ -0,0 +1,173 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "nsStringSIMD.h"
+
+#include "mozilla/SSE.h"
+#include "mozilla/arm.h"
+
+namespace mozilla {
+
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+namespace SSE2 {
+size_t ASCIIWhitespacePrefixLength(const char* aStr, size_t aLength);
+size_t ASCIIWhitespacePrefixLength(const char16_t* aStr, size_t aLength);
+size_t CRLFPrefixLength(const char* aStr, size_t aLength);
+size_t CRLFPrefixLength(const char16_t* aStr, size_t aLength);
+size_t HtmlTextRunPrefixLength(const char16_t* aStr, size_t aLength);
+}  // namespace SSE2
+#endif
+
+#if defined(MOZILLA_MAY_SUPPORT_NEON) || defined(MOZILLA_PRESUME_NEON)
+namespace NEON {
+size_t ASCIIWhitespacePrefixLength(const char* aStr, size_t aLength);
+size_t ASCIIWhitespacePrefixLength(const char16_t* aStr, size_t aLength);
+size_t CRLFPrefixLength(const char* aStr, size_t aLength);
+size_t CRLFPrefixLength(const char16_t* aStr, size_t aLength);
+size_t HtmlTextRunPrefixLength(const char16_t* aStr, size_t aLength);
+}  // namespace NEON
+#endif
+
+namespace {
+
+template <typename Char>
+bool IsASCIIWhitespace(Char aChar) {
+  return aChar == Char(' ') || (aChar >= Char('\t') && aChar <= Char('\r'));
+}
+
+template <typename Char>
+size_t ASCIIWhitespacePrefixLengthScalar(const Char* aStr, size_t aLength) {
+  size_t i = 0;
+  while (i < aLength && !IsASCIIWhitespace(aStr[i])) {
+    i++;
+  }
+  return i;
+}
+
+template <typename Char>
+size_t CRLFPrefixLengthScalar(const Char* aStr, size_t aLength) {
+  size_t i = 0;
+  while (i < aLength && aStr[i] != Char('\r') && aStr[i] != Char('\n')) {
+    i++;
+  }
+  return i;
+}
+
+bool IsHtmlTextRunEnd(char16_t aChar) {
+  return aChar == u'<' || aChar == u'&' || aChar == u'\r' || aChar == u'\n' ||
+         !aChar;
+}
+
+size_t HtmlTextRunPrefixLengthScalar(const char16_t* aStr, size_t aLength) {
+  size_t i = 0;
+  while (i < aLength && !IsHtmlTextRunEnd(aStr[i])) {
+    i++;
+  }
+  return i;
+}
+
+template <typename Char>
+size_t NonMaskedPrefixLengthImpl(const ASCIIMaskArray& aMask, const Char* aStr,
+                                 size_t aLength) {
+  // The preset masks have static storage, so identity comparison is enough
+  // to recognize them and route to a vectorized kernel.
+  if (&aMask == &ASCIIMask::MaskWhitespace()) {
+    return ASCIIWhitespacePrefixLength(aStr, aLength);
+  }
+  if (&aMask == &ASCIIMask::MaskCRLF()) {
+    return CRLFPrefixLength(aStr, aLength);
+  }
+
+  size_t i = 0;
+  while (i < aLength && !ASCIIMask::IsMasked(aMask, uint32_t(aStr[i]))) {
+    i++;
+  }
+  return i;
+}
+
+}  // namespace
+
+size_t ASCIIWhitespacePrefixLength(const char* aStr, size_t aLength) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+  if (mozilla::supports_sse2()) {
+    return SSE2::ASCIIWhitespacePrefixLength(aStr, aLength);
+  }
+#endif
+#if defined(MOZILLA_MAY_SUPPORT_NEON) || defined(MOZILLA_PRESUME_NEON)
+  if (mozilla::supports_neon()) {
+    return NEON::ASCIIWhitespacePrefixLength(aStr, aLength);
+  }
+#endif
+  return ASCIIWhitespacePrefixLengthScalar(aStr, aLength);
+}
+
+size_t ASCIIWhitespacePrefixLength(const char16_t* aStr, size_t aLength) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+  if (mozilla::supports_sse2()) {
+    return SSE2::ASCIIWhitespacePrefixLength(aStr, aLength);
+  }
+#endif
+#if defined(MOZILLA_MAY_SUPPORT_NEON) || defined(MOZILLA_PRESUME_NEON)
+  if (mozilla::supports_neon()) {
+    return NEON::ASCIIWhitespacePrefixLength(aStr, aLength);
+  }
+#endif
+  return ASCIIWhitespacePrefixLengthScalar(aStr, aLength);
+}
+
+size_t CRLFPrefixLength(const char* aStr, size_t aLength) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+  if (mozilla::supports_sse2()) {
+    return SSE2::CRLFPrefixLength(aStr, aLength);
+  }
+#endif
+#if defined(MOZILLA_MAY_SUPPORT_NEON) || defined(MOZILLA_PRESUME_NEON)
+  if (mozilla::supports_neon()) {
+    return NEON::CRLFPrefixLength(aStr, aLength);
+  }
+#endif
+  return CRLFPrefixLengthScalar(aStr, aLength);
+}
+
+size_t CRLFPrefixLength(const char16_t* aStr, size_t aLength) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+  if (mozilla::supports_sse2()) {
+    return SSE2::CRLFPrefixLength(aStr, aLength);
+  }
+#endif
+#if defined(MOZILLA_MAY_SUPPORT_NEON) || defined(MOZILLA_PRESUME_NEON)
+  if (mozilla::supports_neon()) {
+    return NEON::CRLFPrefixLength(aStr, aLength);
+  }
+#endif
+  return CRLFPrefixLengthScalar(aStr, aLength);
+}
+
+size_t HtmlTextRunPrefixLength(const char16_t* aStr, size_t aLength) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+  if (mozilla::supports_sse2()) {
+    return SSE2::HtmlTextRunPrefixLength(aStr, aLength);
+  }
+#endif
+#if defined(MOZILLA_MAY_SUPPORT_NEON) || defined(MOZILLA_PRESUME_NEON)
+  if (mozilla::supports_neon()) {
+    return NEON::HtmlTextRunPrefixLength(aStr, aLength);
+  }
+#endif
+  return HtmlTextRunPrefixLengthScalar(aStr, aLength);
+}
+
+size_t NonMaskedPrefixLength(const ASCIIMaskArray& aMask, const char* aStr,
+                             size_t aLength) {
+  return NonMaskedPrefixLengthImpl(aMask, aStr, aLength);
+}
+
+size_t NonMaskedPrefixLength(const ASCIIMaskArray& aMask, const char16_t* aStr,
+                             size_t aLength) {
+  return NonMaskedPrefixLengthImpl(aMask, aStr, aLength);
+}
+
+}  // namespace mozilla
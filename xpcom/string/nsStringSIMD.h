@@ -0,0 +1,50 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef nsStringSIMD_h_
+#define nsStringSIMD_h_
+
+#include <stddef.h>
+
+#include "nsASCIIMask.h"
+
+// Vectorized scanning kernels shared by the string classes and other
+// character-at-a-time consumers (e.g. parsers). Each function returns the
+// length of the leading run of |aStr| containing no character of interest,
+// so callers can skip that prefix wholesale and only run their
+// per-character loop on the remainder. On most inputs the prefix is the
+// whole string, which also lets callers avoid forcing a copy-on-write
+// fork of a shared buffer.
+//
+// SSE2 and NEON kernels are selected at runtime where the instruction set
+// isn't guaranteed by the target; otherwise a scalar loop is used.
+
+namespace mozilla {
+
+// Length of the leading run containing no ASCII whitespace
+// ('\t', '\n', '\v', '\f', '\r', ' ').
+size_t ASCIIWhitespacePrefixLength(const char* aStr, size_t aLength);
+size_t ASCIIWhitespacePrefixLength(const char16_t* aStr, size_t aLength);
+
+// Length of the leading run containing neither '\r' nor '\n'.
+size_t CRLFPrefixLength(const char* aStr, size_t aLength);
+size_t CRLFPrefixLength(const char16_t* aStr, size_t aLength);
+
+// Length of the leading run containing none of the code units the HTML
+// tokenizer's data state treats specially: '<', '&', '\r', '\n' and NUL.
+size_t HtmlTextRunPrefixLength(const char16_t* aStr, size_t aLength);
+
+// Length of the leading run containing no character masked by |aMask|.
+// This uses the vectorized kernels above when |aMask| is a preset mask
+// they cover, and a scalar loop for arbitrary masks.
+size_t NonMaskedPrefixLength(const ASCIIMaskArray& aMask, const char* aStr,
+                             size_t aLength);
+size_t NonMaskedPrefixLength(const ASCIIMaskArray& aMask, const char16_t* aStr,
+                             size_t aLength);
+
+}  // namespace mozilla
+
+#endif  // nsStringSIMD_h_
@@ -0,0 +1,163 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// NEON kernels for nsStringSIMD.h. This file is compiled with NEON flags
+// enabled; callers must check mozilla::supports_neon() before calling in.
+
+#include <arm_neon.h>
+
+#include "nsStringSIMD.h"
+
+namespace mozilla {
+namespace NEON {
+
+namespace {
+
+template <typename Char>
+bool IsASCIIWhitespace(Char aChar) {
+  return aChar == Char(' ') || (aChar >= Char('\t') && aChar <= Char('\r'));
+}
+
+// NEON has no cheap movemask, so the vector loop only detects whether a
+// block contains a match; the scalar tail then pinpoints the exact index.
+bool AnyLaneSet(uint8x16_t aVector) {
+  uint8x8_t folded = vorr_u8(vget_low_u8(aVector), vget_high_u8(aVector));
+  return vget_lane_u64(vreinterpret_u64_u8(folded), 0) != 0;
+}
+
+bool AnyLaneSet(uint16x8_t aVector) {
+  uint16x4_t folded = vorr_u16(vget_low_u16(aVector), vget_high_u16(aVector));
+  return vget_lane_u64(vreinterpret_u64_u16(folded), 0) != 0;
+}
+
+}  // namespace
+
+size_t ASCIIWhitespacePrefixLength(const char* aStr, size_t aLength) {
+  const char* p = aStr;
+  const char* end = aStr + aLength;
+
+  // A byte is ASCII whitespace iff (uint8_t)(c - 9) <= 4 or c == ' '. The
+  // subtraction wraps, so bytes above 127 can't produce false positives.
+  const uint8x16_t kNine = vdupq_n_u8(9);
+  const uint8x16_t kFour = vdupq_n_u8(4);
+  const uint8x16_t kSpace = vdupq_n_u8(' ');
+
+  while (end - p >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t inRange = vcleq_u8(vsubq_u8(chunk, kNine), kFour);
+    uint8x16_t hit = vorrq_u8(inRange, vceqq_u8(chunk, kSpace));
+    if (AnyLaneSet(hit)) {
+      break;
+    }
+    p += 16;
+  }
+
+  while (p < end && !IsASCIIWhitespace(*p)) {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t ASCIIWhitespacePrefixLength(const char16_t* aStr, size_t aLength) {
+  const char16_t* p = aStr;
+  const char16_t* end = aStr + aLength;
+
+  const uint16x8_t kNine = vdupq_n_u16(9);
+  const uint16x8_t kFour = vdupq_n_u16(4);
+  const uint16x8_t kSpace = vdupq_n_u16(' ');
+
+  while (end - p >= 8) {
+    uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+    uint16x8_t inRange = vcleq_u16(vsubq_u16(chunk, kNine), kFour);
+    uint16x8_t hit = vorrq_u16(inRange, vceqq_u16(chunk, kSpace));
+    if (AnyLaneSet(hit)) {
+      break;
+    }
+    p += 8;
+  }
+
+  while (p < end && !IsASCIIWhitespace(*p)) {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t CRLFPrefixLength(const char* aStr, size_t aLength) {
+  const char* p = aStr;
+  const char* end = aStr + aLength;
+
+  const uint8x16_t kCR = vdupq_n_u8('\r');
+  const uint8x16_t kLF = vdupq_n_u8('\n');
+
+  while (end - p >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t hit = vorrq_u8(vceqq_u8(chunk, kCR), vceqq_u8(chunk, kLF));
+    if (AnyLaneSet(hit)) {
+      break;
+    }
+    p += 16;
+  }
+
+  while (p < end && *p != '\r' && *p != '\n') {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t CRLFPrefixLength(const char16_t* aStr, size_t aLength) {
+  const char16_t* p = aStr;
+  const char16_t* end = aStr + aLength;
+
+  const uint16x8_t kCR = vdupq_n_u16('\r');
+  const uint16x8_t kLF = vdupq_n_u16('\n');
+
+  while (end - p >= 8) {
+    uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+    uint16x8_t hit = vorrq_u16(vceqq_u16(chunk, kCR), vceqq_u16(chunk, kLF));
+    if (AnyLaneSet(hit)) {
+      break;
+    }
+    p += 8;
+  }
+
+  while (p < end && *p != u'\r' && *p != u'\n') {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t HtmlTextRunPrefixLength(const char16_t* aStr, size_t aLength) {
+  const char16_t* p = aStr;
+  const char16_t* end = aStr + aLength;
+
+  const uint16x8_t kLt = vdupq_n_u16('<');
+  const uint16x8_t kAmp = vdupq_n_u16('&');
+  const uint16x8_t kCR = vdupq_n_u16('\r');
+  const uint16x8_t kLF = vdupq_n_u16('\n');
+  const uint16x8_t kZero = vdupq_n_u16(0);
+
+  while (end - p >= 8) {
+    uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+    uint16x8_t hit =
+        vorrq_u16(vorrq_u16(vceqq_u16(chunk, kLt), vceqq_u16(chunk, kAmp)),
+                  vorrq_u16(vceqq_u16(chunk, kCR),
+                            vorrq_u16(vceqq_u16(chunk, kLF),
+                                      vceqq_u16(chunk, kZero))));
+    if (AnyLaneSet(hit)) {
+      break;
+    }
+    p += 8;
+  }
+
+  while (p < end && *p != u'<' && *p != u'&' && *p != u'\r' && *p != u'\n' &&
+         *p) {
+    p++;
+  }
+  return p - aStr;
+}
+
+}  // namespace NEON
+}  // namespace mozilla
@@ -0,0 +1,167 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// SSE2 kernels for nsStringSIMD.h. This file is compiled with SSE2 flags
+// enabled; callers must check mozilla::supports_sse2() before calling in.
+
+#include <emmintrin.h>
+
+#include "nsStringSIMD.h"
+
+#include "mozilla/MathAlgorithms.h"
+
+namespace mozilla {
+namespace SSE2 {
+
+namespace {
+
+template <typename Char>
+bool IsASCIIWhitespace(Char aChar) {
+  return aChar == Char(' ') || (aChar >= Char('\t') && aChar <= Char('\r'));
+}
+
+}  // namespace
+
+size_t ASCIIWhitespacePrefixLength(const char* aStr, size_t aLength) {
+  const char* p = aStr;
+  const char* end = aStr + aLength;
+
+  // A byte is ASCII whitespace iff (uint8_t)(c - 9) <= 4 or c == ' '. The
+  // subtraction wraps, so bytes above 127 can't produce false positives.
+  const __m128i kNine = _mm_set1_epi8(9);
+  const __m128i kFour = _mm_set1_epi8(4);
+  const __m128i kSpace = _mm_set1_epi8(' ');
+  const __m128i kZero = _mm_setzero_si128();
+
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i inRange = _mm_cmpeq_epi8(
+        _mm_subs_epu8(_mm_sub_epi8(chunk, kNine), kFour), kZero);
+    __m128i isSpace = _mm_cmpeq_epi8(chunk, kSpace);
+    uint32_t bits = _mm_movemask_epi8(_mm_or_si128(inRange, isSpace));
+    if (bits) {
+      return (p - aStr) + CountTrailingZeroes32(bits);
+    }
+    p += 16;
+  }
+
+  while (p < end && !IsASCIIWhitespace(*p)) {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t ASCIIWhitespacePrefixLength(const char16_t* aStr, size_t aLength) {
+  const char16_t* p = aStr;
+  const char16_t* end = aStr + aLength;
+
+  const __m128i kNine = _mm_set1_epi16(9);
+  const __m128i kFour = _mm_set1_epi16(4);
+  const __m128i kSpace = _mm_set1_epi16(' ');
+  const __m128i kZero = _mm_setzero_si128();
+
+  while (end - p >= 8) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i inRange = _mm_cmpeq_epi16(
+        _mm_subs_epu16(_mm_sub_epi16(chunk, kNine), kFour), kZero);
+    __m128i isSpace = _mm_cmpeq_epi16(chunk, kSpace);
+    uint32_t bits = _mm_movemask_epi8(_mm_or_si128(inRange, isSpace));
+    if (bits) {
+      // Two movemask bits per code unit.
+      return (p - aStr) + (CountTrailingZeroes32(bits) >> 1);
+    }
+    p += 8;
+  }
+
+  while (p < end && !IsASCIIWhitespace(*p)) {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t CRLFPrefixLength(const char* aStr, size_t aLength) {
+  const char* p = aStr;
+  const char* end = aStr + aLength;
+
+  const __m128i kCR = _mm_set1_epi8('\r');
+  const __m128i kLF = _mm_set1_epi8('\n');
+
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(chunk, kCR),
+                               _mm_cmpeq_epi8(chunk, kLF));
+    uint32_t bits = _mm_movemask_epi8(hit);
+    if (bits) {
+      return (p - aStr) + CountTrailingZeroes32(bits);
+    }
+    p += 16;
+  }
+
+  while (p < end && *p != '\r' && *p != '\n') {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t CRLFPrefixLength(const char16_t* aStr, size_t aLength) {
+  const char16_t* p = aStr;
+  const char16_t* end = aStr + aLength;
+
+  const __m128i kCR = _mm_set1_epi16('\r');
+  const __m128i kLF = _mm_set1_epi16('\n');
+
+  while (end - p >= 8) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hit = _mm_or_si128(_mm_cmpeq_epi16(chunk, kCR),
+                               _mm_cmpeq_epi16(chunk, kLF));
+    uint32_t bits = _mm_movemask_epi8(hit);
+    if (bits) {
+      return (p - aStr) + (CountTrailingZeroes32(bits) >> 1);
+    }
+    p += 8;
+  }
+
+  while (p < end && *p != u'\r' && *p != u'\n') {
+    p++;
+  }
+  return p - aStr;
+}
+
+size_t HtmlTextRunPrefixLength(const char16_t* aStr, size_t aLength) {
+  const char16_t* p = aStr;
+  const char16_t* end = aStr + aLength;
+
+  const __m128i kLt = _mm_set1_epi16('<');
+  const __m128i kAmp = _mm_set1_epi16('&');
+  const __m128i kCR = _mm_set1_epi16('\r');
+  const __m128i kLF = _mm_set1_epi16('\n');
+  const __m128i kZero = _mm_setzero_si128();
+
+  while (end - p >= 8) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hit = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi16(chunk, kLt),
+                     _mm_cmpeq_epi16(chunk, kAmp)),
+        _mm_or_si128(_mm_cmpeq_epi16(chunk, kCR),
+                     _mm_or_si128(_mm_cmpeq_epi16(chunk, kLF),
+                                  _mm_cmpeq_epi16(chunk, kZero))));
+    uint32_t bits = _mm_movemask_epi8(hit);
+    if (bits) {
+      // Two movemask bits per code unit.
+      return (p - aStr) + (CountTrailingZeroes32(bits) >> 1);
+    }
+    p += 8;
+  }
+
+  while (p < end && *p != u'<' && *p != u'&' && *p != u'\r' && *p != u'\n' &&
+         *p) {
+    p++;
+  }
+  return p - aStr;
+}
+
+}  // namespace SSE2
+}  // namespace mozilla
@@ -9,7 +9,9 @@
 #endif
 
 #include "mozilla/Atomics.h"
+#include "mozilla/Likely.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozmemory.h"
 
 #ifdef ENABLE_STRING_STATS
 #  include <stdio.h>
@@ -115,6 +117,31 @@ void ReleaseData(void* aData, nsAString::DataFlags aFlags) {
 
 // ---------------------------------------------------------------------------
 
+// String buffers are allocated out of their own arena, so that the churn of
+// many small, short-lived buffers doesn't fragment the arenas other
+// subsystems allocate from, and so that about:memory can report the heap
+// the buffers occupy separately (see nsStringBuffer::ArenaStats).
+static mozilla::Atomic<arena_id_t> gStringBufferArenaId(0);
+
+static arena_id_t StringBufferArena() {
+  arena_id_t id = gStringBufferArenaId;
+  if (MOZ_UNLIKELY(!id)) {
+    // In builds without jemalloc, moz_create_arena() returns 0 and the
+    // moz_arena_* functions fall back to the plain malloc family, so it's
+    // fine for the exchange below to keep 0.
+    id = moz_create_arena();
+    if (!gStringBufferArenaId.compareExchange(0, id)) {
+      // Another thread beat us to it.  The arena we just created is still
+      // empty, so it can be disposed of right away.
+      moz_dispose_arena(id);
+      id = gStringBufferArenaId;
+    }
+  }
+  return id;
+}
+
+// ---------------------------------------------------------------------------
+
 // XXX or we could make nsStringBuffer be a friend of nsTAString
 
 class nsAStringAccessor : public nsAString {
@@ -185,7 +212,7 @@ void nsStringBuffer::Release() {
     count = mRefCount.load(std::memory_order_acquire);
 
     STRING_STAT_INCREMENT(Free);
-    free(this);  // we were allocated with |malloc|
+    moz_arena_free(StringBufferArena(), this);
   }
 }
 
@@ -198,7 +225,8 @@ already_AddRefed<nsStringBuffer> nsStringBuffer::Alloc(size_t aSize) {
                    sizeof(nsStringBuffer) + aSize > aSize,
                "mStorageSize will truncate");
 
-  nsStringBuffer* hdr = (nsStringBuffer*)malloc(sizeof(nsStringBuffer) + aSize);
+  nsStringBuffer* hdr = (nsStringBuffer*)moz_arena_malloc(
+      StringBufferArena(), sizeof(nsStringBuffer) + aSize);
   if (hdr) {
     STRING_STAT_INCREMENT(Alloc);
 
@@ -225,7 +253,8 @@ nsStringBuffer* nsStringBuffer::Realloc(nsStringBuffer* aHdr, size_t aSize) {
   // logging will claim we've leaked all sorts of stuff.
   NS_LOG_RELEASE(aHdr, 0, "nsStringBuffer");
 
-  aHdr = (nsStringBuffer*)realloc(aHdr, sizeof(nsStringBuffer) + aSize);
+  aHdr = (nsStringBuffer*)moz_arena_realloc(StringBufferArena(), aHdr,
+                                            sizeof(nsStringBuffer) + aSize);
   if (aHdr) {
     NS_LOG_ADDREF(aHdr, 1, "nsStringBuffer", sizeof(*aHdr));
     aHdr->mStorageSize = aSize;
@@ -300,6 +329,11 @@ size_t nsStringBuffer::SizeOfIncludingThisEvenIfShared(
   return aMallocSizeOf(this);
 }
 
+/* static */
+void nsStringBuffer::ArenaStats(jemalloc_arena_stats_t* aStats) {
+  moz_arena_stats(StringBufferArena(), aStats);
+}
+
 // ---------------------------------------------------------------------------
 
 // define nsAString
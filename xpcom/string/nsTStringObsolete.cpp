@@ -6,6 +6,7 @@
 
 #include "nsTArray.h"
 #include "nsASCIIMask.h"
+#include "nsStringSIMD.h"
 #include "mozilla/CheckedInt.h"
 
 /**
@@ -400,18 +401,28 @@ void nsTString<T>::CompressWhitespace(bool aTrimLeading, bool aTrimTrailing) {
     return;
   }
 
+  // A string with no whitespace at all is left as-is; detecting that with a
+  // vectorized scan also avoids forcing a copy-on-write fork of a shared
+  // buffer. Otherwise the leading whitespace-free run needs no rewriting
+  // and can be skipped wholesale.
+  size_t prefixLen =
+      mozilla::ASCIIWhitespacePrefixLength(this->mData, this->mLength);
+  if (prefixLen == this->mLength) {
+    return;
+  }
+
   if (!this->EnsureMutable()) this->AllocFailed(this->mLength);
 
   const ASCIIMaskArray& mask = mozilla::ASCIIMask::MaskWhitespace();
 
-  char_type* to = this->mData;
-  char_type* from = this->mData;
+  char_type* to = this->mData + prefixLen;
+  char_type* from = to;
   char_type* end = this->mData + this->mLength;
 
   // Compresses runs of whitespace down to a normal space ' ' and convert
   // any whitespace to a normal space.  This assumes that whitespace is
   // all standard 7-bit ASCII.
-  bool skipWS = aTrimLeading;
+  bool skipWS = prefixLen > 0 ? false : aTrimLeading;
   while (from < end) {
     uint32_t theChar = *from++;
     if (mozilla::ASCIIMask::IsMasked(mask, theChar)) {
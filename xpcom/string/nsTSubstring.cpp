@@ -11,6 +11,7 @@
 #include "mozilla/Printf.h"
 
 #include "nsASCIIMask.h"
+#include "nsStringSIMD.h"
 
 // It's not worthwhile to reallocate the buffer and memcpy the
 // contents over when the size difference isn't large. With
@@ -1123,12 +1124,21 @@ void nsTSubstring<T>::StripTaggedASCII(const ASCIIMaskArray& aToStrip) {
     return;
   }
 
+  // Most strings contain nothing to strip. Find the leading run that is
+  // left untouched with a vectorized scan, so such strings are recognized
+  // without forcing a copy-on-write fork of a shared buffer.
+  size_t prefixLen =
+      mozilla::NonMaskedPrefixLength(aToStrip, this->mData, this->mLength);
+  if (prefixLen == this->mLength) {
+    return;
+  }
+
   if (!EnsureMutable()) {
     AllocFailed(this->mLength);
   }
 
-  char_type* to = this->mData;
-  char_type* from = this->mData;
+  char_type* to = this->mData + prefixLen;
+  char_type* from = to;
   char_type* end = this->mData + this->mLength;
 
   while (from < end) {
@@ -310,3 +310,28 @@ TEST(ArenaAllocator, Extensions)
   nsAutoCString::char_type* y_copy = mozilla::ArenaStrdup(y, a);
   EXPECT_TRUE(y.Equals(y_copy));
 }
+
+TEST(ArenaAllocator, ChunkPool)
+{
+  // The pool is process-wide, so we can't assert anything about its exact
+  // contents: other tests (and threads) may acquire or recycle chunks
+  // concurrently. We can check the basic contract, though.
+  static const size_t kSize = 4096;
+
+  // Unpooled sizes are always declined.
+  EXPECT_EQ(mozilla::ArenaChunkPool::Acquire(kSize - 1), nullptr);
+  void* unpooled = malloc(kSize - 1);
+  EXPECT_FALSE(mozilla::ArenaChunkPool::Recycle(unpooled, kSize - 1));
+  free(unpooled);
+
+  // A recycled chunk satisfies a subsequent acquire of the same size.
+  void* chunk = malloc(kSize);
+  if (mozilla::ArenaChunkPool::Recycle(chunk, kSize)) {
+    chunk = mozilla::ArenaChunkPool::Acquire(kSize);
+    EXPECT_TRUE(chunk);
+  }
+  free(chunk);
+
+  // Trimming empties the pool; it must be safe to call at any time.
+  mozilla::ArenaChunkPool::Trim();
+}
@@ -8,6 +8,7 @@
 
 #include "nsAtom.h"
 #include "nsString.h"
+#include "nsTArray.h"
 #include "UTFStrings.h"
 #include "nsThreadUtils.h"
 
@@ -140,6 +141,34 @@ TEST(Atoms, Table)
   EXPECT_EQ(NS_GetNumberOfAtoms(), count + 1);
 }
 
+TEST(Atoms, AtomizeMany)
+{
+  nsTArray<nsString> strings;
+  strings.AppendElement(NS_LITERAL_STRING("this is a bulk atom"));
+  strings.AppendElement(NS_LITERAL_STRING("this is another bulk atom"));
+  strings.AppendElement(NS_LITERAL_STRING("this is a bulk atom"));
+  for (int i = 0; i < 100; i++) {
+    nsString s(NS_LITERAL_STRING("bulk atom "));
+    s.AppendInt(i);
+    strings.AppendElement(s);
+  }
+
+  nsTArray<RefPtr<nsAtom>> atoms;
+  NS_AtomizeMany(strings, atoms);
+
+  ASSERT_EQ(atoms.Length(), strings.Length());
+  for (size_t i = 0; i < strings.Length(); i++) {
+    EXPECT_TRUE(atoms[i]);
+    EXPECT_TRUE(atoms[i]->Equals(strings[i]));
+    // Must agree with one-at-a-time atomization.
+    RefPtr<nsAtom> single = NS_Atomize(strings[i]);
+    EXPECT_EQ(atoms[i], single);
+  }
+
+  // Duplicate inputs yield the same atom.
+  EXPECT_EQ(atoms[0], atoms[2]);
+}
+
 class nsAtomRunner final : public nsIRunnable {
  public:
   NS_DECL_THREADSAFE_ISUPPORTS
@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Microbenchmarks for the xpcom primitives that most of the codebase rides
+// on: PLDHashTable, nsTArray, nsDeque, string appending, thread event
+// dispatch and MozPromise chains. Each benchmark exercises one primitive
+// with a fixed deterministic workload; MOZ_GTEST_BENCH reports the results
+// to PerfHerder so regressions show up here rather than in product-level
+// metrics first.
+//
+// Run the whole suite with:
+//
+//   MOZ_RUN_GTEST=1 GTEST_FILTER='BenchXPCOM.*' $OBJDIR/dist/bin/firefox
+//       -unittest
+//
+// The workload sizes are chosen so each benchmark runs for roughly a few
+// milliseconds on current hardware: long enough to dominate timer noise,
+// short enough to keep the suite cheap in CI. MOZ_RELEASE_ASSERT is used on
+// computed results so the compiler can't optimize the work away.
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
+#include "mozilla/MozPromise.h"
+#include "mozilla/RefPtr.h"
+#include "nsDeque.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "nsThreadUtils.h"
+#include "PLDHashTable.h"
+
+using namespace mozilla;
+
+namespace {
+
+// Deterministic and platform-independent pseudo-random sequence, with no
+// duplicates for far longer than any workload here needs. Using pointers
+// derived from it as hash keys keeps the PLDHashTable benchmark independent
+// of the allocator's address patterns.
+static uintptr_t MyRand() {
+  static uintptr_t s = 0;
+  s = s * 1103515245 + 12345;
+  return s;
+}
+
+static const size_t kHashOps = 32768;
+static const size_t kArrayOps = 262144;
+static const size_t kDequeOps = 262144;
+static const size_t kStringOps = 16384;
+static const size_t kDispatchOps = 8192;
+static const size_t kPromiseChainLength = 4096;
+
+static void BenchPLDHash() {
+  nsTArray<const void*> keys(kHashOps);
+  for (size_t i = 0; i < kHashOps; i++) {
+    keys.AppendElement(reinterpret_cast<const void*>(MyRand() | 1));
+  }
+
+  PLDHashTable table(PLDHashTable::StubOps(), sizeof(PLDHashEntryStub));
+  for (size_t i = 0; i < kHashOps; i++) {
+    auto* entry = static_cast<PLDHashEntryStub*>(table.Add(keys[i]));
+    entry->key = keys[i];
+  }
+  MOZ_RELEASE_ASSERT(table.EntryCount() == kHashOps);
+
+  for (size_t i = 0; i < kHashOps; i++) {
+    MOZ_RELEASE_ASSERT(table.Search(keys[i]));
+  }
+
+  size_t n = 0;
+  for (auto iter = table.Iter(); !iter.Done(); iter.Next()) {
+    n++;
+  }
+  MOZ_RELEASE_ASSERT(n == kHashOps);
+
+  for (size_t i = 0; i < kHashOps; i++) {
+    table.Remove(keys[i]);
+  }
+  MOZ_RELEASE_ASSERT(table.EntryCount() == 0);
+}
+
+static void BenchTArray() {
+  nsTArray<uint64_t> array;
+  for (size_t i = 0; i < kArrayOps; i++) {
+    array.AppendElement(i);
+  }
+
+  uint64_t sum = 0;
+  for (uint64_t value : array) {
+    sum += value;
+  }
+  MOZ_RELEASE_ASSERT(sum == uint64_t(kArrayOps) * (kArrayOps - 1) / 2);
+
+  while (!array.IsEmpty()) {
+    array.RemoveLastElement();
+  }
+  MOZ_RELEASE_ASSERT(array.IsEmpty());
+}
+
+static void BenchDeque() {
+  nsDeque deque;
+  uint64_t values[2] = {0, 1};
+
+  // Interleave pushes and pops so the deque wraps its ring buffer instead of
+  // just growing, which is the pattern event queues produce.
+  for (size_t i = 0; i < kDequeOps; i++) {
+    deque.Push(&values[i & 1]);
+    deque.Push(&values[(i + 1) & 1]);
+    MOZ_RELEASE_ASSERT(deque.PopFront());
+  }
+  MOZ_RELEASE_ASSERT(deque.GetSize() == kDequeOps);
+
+  while (deque.GetSize()) {
+    MOZ_RELEASE_ASSERT(deque.PopFront());
+  }
+}
+
+static void BenchStringAppend() {
+  nsAutoCString str;
+  for (size_t i = 0; i < kStringOps; i++) {
+    str.AppendLiteral("0123456789abcdef");
+    str.AppendInt(int32_t(i));
+  }
+  MOZ_RELEASE_ASSERT(str.Length() > kStringOps * 16);
+
+  nsAutoString wide;
+  for (size_t i = 0; i < kStringOps; i++) {
+    wide.AppendLiteral(u"0123456789abcdef");
+    wide.AppendInt(int32_t(i));
+  }
+  MOZ_RELEASE_ASSERT(wide.Length() > kStringOps * 16);
+}
+
+static void BenchEventDispatch() {
+  size_t counter = 0;
+  for (size_t i = 0; i < kDispatchOps; i++) {
+    NS_DispatchToCurrentThread(NS_NewRunnableFunction(
+        "BenchEventDispatch", [&counter] { counter++; }));
+  }
+  NS_ProcessPendingEvents(nullptr);
+  MOZ_RELEASE_ASSERT(counter == kDispatchOps);
+}
+
+static void BenchMozPromiseChain() {
+  using BenchPromise = MozPromise<size_t, bool, false>;
+
+  nsISerialEventTarget* target = GetCurrentThreadSerialEventTarget();
+  RefPtr<BenchPromise> promise = BenchPromise::CreateAndResolve(0, __func__);
+  for (size_t i = 0; i < kPromiseChainLength; i++) {
+    promise = promise->Then(
+        target, __func__,
+        [](size_t aValue) {
+          return BenchPromise::CreateAndResolve(aValue + 1, __func__);
+        },
+        [](bool) { return BenchPromise::CreateAndReject(false, __func__); });
+  }
+
+  bool done = false;
+  promise->Then(
+      target, __func__,
+      [&done](size_t aValue) {
+        MOZ_RELEASE_ASSERT(aValue == kPromiseChainLength);
+        done = true;
+      },
+      [&done](bool) {
+        MOZ_RELEASE_ASSERT(false, "Unexpected rejection");
+        done = true;
+      });
+  SpinEventLoopUntil([&done] { return done; });
+}
+
+}  // namespace
+
+MOZ_GTEST_BENCH(BenchXPCOM, PLDHashTable, BenchPLDHash);
+MOZ_GTEST_BENCH(BenchXPCOM, TArray, BenchTArray);
+MOZ_GTEST_BENCH(BenchXPCOM, Deque, BenchDeque);
+MOZ_GTEST_BENCH(BenchXPCOM, StringAppend, BenchStringAppend);
+MOZ_GTEST_BENCH(BenchXPCOM, EventDispatch, BenchEventDispatch);
+MOZ_GTEST_BENCH(BenchXPCOM, MozPromiseChain, BenchMozPromiseChain);
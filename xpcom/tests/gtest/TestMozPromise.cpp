@@ -280,6 +280,38 @@ TEST(MozPromise, PromiseAllReject)
   });
 }
 
+TEST(MozPromise, PromiseAllSettled)
+{
+  AutoTaskQueue atq;
+  RefPtr<TaskQueue> queue = atq.Queue();
+  RunOnTaskQueue(queue, [queue]() -> void {
+    nsTArray<RefPtr<TestPromise>> promises;
+    // A mix of already-settled promises (which take the synchronous path on
+    // the processing thread) and one that settles later.
+    promises.AppendElement(TestPromise::CreateAndResolve(22, __func__));
+    promises.AppendElement(TestPromise::CreateAndReject(32.0, __func__));
+    RefPtr<TestPromise::Private> pending = new TestPromise::Private(__func__);
+    promises.AppendElement(pending);
+
+    TestPromise::AllSettled(queue, promises)
+        ->Then(
+            queue, __func__,
+            [queue](const nsTArray<RRValue>& aValues) -> void {
+              EXPECT_EQ(aValues.Length(), 3UL);
+              EXPECT_TRUE(aValues[0].IsResolve());
+              EXPECT_EQ(aValues[0].ResolveValue(), 22);
+              EXPECT_TRUE(aValues[1].IsReject());
+              EXPECT_EQ(aValues[1].RejectValue(), 32.0);
+              EXPECT_TRUE(aValues[2].IsResolve());
+              EXPECT_EQ(aValues[2].ResolveValue(), 42);
+              queue->BeginShutdown();
+            },
+            []() { EXPECT_TRUE(false); });
+
+    pending->Resolve(42, __func__);
+  });
+}
+
 // Test we don't hit the assertions in MozPromise when exercising promise
 // chaining upon task queue shutdown.
 TEST(MozPromise, Chaining)
@@ -393,3 +393,37 @@ TEST(MruCache, TestLookupAndSetWithMove)
   EXPECT_TRUE(p.Data().mKey == key);
   EXPECT_TRUE(p.Data().mOther == NS_LITERAL_CSTRING("foo"));
 }
+
+struct TwoWayIntPtrMap
+    : public MruCache<uintptr_t, int*, TwoWayIntPtrMap, 31, 2> {
+  // Every key hashes to the same slot to force conflicts.
+  static HashNumber Hash(const KeyType& aKey) { return 0; }
+  static bool Match(const KeyType& aKey, const ValueType& aVal) {
+    return aKey == (KeyType)aVal;
+  }
+};
+
+TEST(MruCache, TestTwoWayConflictingKeys)
+{
+  TwoWayIntPtrMap mruCache;
+
+  // With two ways a pair of conflicting keys can be cached together.
+  mruCache.Put(1, (int*)1);
+  mruCache.Put(2, (int*)2);
+
+  EXPECT_TRUE(mruCache.Lookup(1));
+  EXPECT_TRUE(mruCache.Lookup(2));
+
+  // Touch key 1, then insert a third key: key 2 is now LRU and is evicted.
+  EXPECT_TRUE(mruCache.Lookup(1));
+  mruCache.Put(3, (int*)3);
+
+  EXPECT_TRUE(mruCache.Lookup(1));
+  EXPECT_TRUE(mruCache.Lookup(3));
+  EXPECT_FALSE(mruCache.Lookup(2));
+
+  // Overwriting an existing key must not duplicate it into the other way.
+  mruCache.Put(1, (int*)1);
+  EXPECT_TRUE(mruCache.Lookup(1));
+  EXPECT_TRUE(mruCache.Lookup(3));
+}
@@ -333,6 +333,63 @@ TEST(PLDHashTableTest, Iterator)
   ASSERT_EQ(t.Capacity(), unsigned(PLDHashTable::kMinCapacity));
 }
 
+TEST(PLDHashTableTest, IncrementalResize)
+{
+  PLDHashTable t(&trivialOps, sizeof(PLDHashEntryStub), 8,
+                 /* aIncrementalResize */ true);
+
+  // Small opted-in tables still grow in one shot, and behave as usual.
+  for (intptr_t i = 1; i <= 64; i++) {
+    t.Add((const void*)i);
+  }
+  ASSERT_EQ(t.EntryCount(), 64u);
+  ASSERT_EQ(t.Capacity(), 128u);
+
+  // Start again with a capacity large enough that growing past it migrates
+  // incrementally (16384 slots; growth triggers at 75% load, i.e. on the
+  // 12289th add).
+  t.ClearAndPrepareForLength(12000);
+
+  const intptr_t kGrowthPoint = 12289;
+  for (intptr_t i = 1; i <= kGrowthPoint; i++) {
+    t.Add((const void*)i);
+  }
+  ASSERT_EQ(t.Capacity(), 32768u);
+  ASSERT_EQ(t.EntryCount(), (uint32_t)kGrowthPoint);
+
+  // Most entries still live in the old store at this point. All of them must
+  // be reachable, and removing them must work in either store.
+  for (intptr_t i = 1; i <= kGrowthPoint; i++) {
+    ASSERT_TRUE(t.Search((const void*)i));
+  }
+  for (intptr_t i = 1; i <= 1000; i++) {
+    t.Remove((const void*)i);
+  }
+  ASSERT_EQ(t.EntryCount(), (uint32_t)(kGrowthPoint - 1000));
+  for (intptr_t i = 1; i <= 1000; i++) {
+    ASSERT_TRUE(!t.Search((const void*)i));
+  }
+
+  // Keep adding until the migration is guaranteed to have drained.
+  const intptr_t kCount = 20000;
+  for (intptr_t i = kGrowthPoint + 1; i <= kCount; i++) {
+    t.Add((const void*)i);
+    ASSERT_TRUE(t.Search((const void*)i));
+    ASSERT_TRUE(t.Search((const void*)(1000 + i / 2)));
+  }
+  ASSERT_EQ(t.EntryCount(), (uint32_t)(kCount - 1000));
+
+  // Iteration consolidates any in-progress migration and sees every entry
+  // exactly once.
+  uint32_t n = 0;
+  for (auto iter = t.Iter(); !iter.Done(); iter.Next()) {
+    ASSERT_TRUE((intptr_t)static_cast<PLDHashEntryStub*>(iter.Get())->key >
+                (intptr_t)1000);
+    n++;
+  }
+  ASSERT_EQ(n, (uint32_t)(kCount - 1000));
+}
+
 // This test involves resizing a table repeatedly up to 512 MiB in size. On
 // 32-bit platforms (Win32, Android) it sometimes OOMs, causing the test to
 // fail. (See bug 931062 and bug 1267227.) Therefore, we only run it on 64-bit
@@ -9,6 +9,7 @@
 #include "nsASCIIMask.h"
 #include "nsString.h"
 #include "nsStringBuffer.h"
+#include "nsStringSIMD.h"
 #include "nsReadableUtils.h"
 #include "nsCRTGlue.h"
 #include "mozilla/RefPtr.h"
@@ -955,6 +956,57 @@ TEST_F(Strings, strip_ws) {
   }
 }
 
+// Long inputs exercise the vectorized prefix scan in nsStringSIMD.cpp,
+// including the block boundaries and the scalar tail.
+TEST_F(Strings, strip_ws_long) {
+  nsCString clean("abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLM");
+  nsCString s(clean);
+  s.StripWhitespace();
+  EXPECT_STREQ(s.get(), clean.get());
+  s.StripCRLF();
+  EXPECT_STREQ(s.get(), clean.get());
+
+  // A single whitespace character at each position of a long string.
+  for (size_t i = 0; i <= clean.Length(); i++) {
+    nsCString t(clean);
+    t.Insert("\r", i);
+    t.StripWhitespace();
+    EXPECT_STREQ(t.get(), clean.get());
+    t = clean;
+    t.Insert("\t", i);
+    t.CompressWhitespace(true, true);
+    nsCString expected(clean);
+    if (i != 0 && i != clean.Length()) {
+      expected.Insert(" ", i);
+    }
+    EXPECT_STREQ(t.get(), expected.get());
+  }
+
+  nsString u(NS_LITERAL_STRING(
+      "abcdefghijklmnopqrstuvwxyz0123456789\nABCDEFGHIJKLM\r"));
+  u.StripCRLF();
+  EXPECT_TRUE(u.EqualsLiteral("abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLM"));
+}
+
+// Exercises the vectorized HTML text run scan with each stop character at
+// each position of a long string, covering block boundaries and the scalar
+// tail.
+TEST_F(Strings, html_text_run_prefix_length) {
+  nsString clean(NS_LITERAL_STRING(
+      "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLM"));
+  EXPECT_EQ(mozilla::HtmlTextRunPrefixLength(clean.get(), clean.Length()),
+            size_t(clean.Length()));
+
+  const char16_t stops[] = {u'<', u'&', u'\r', u'\n', u'\0'};
+  for (char16_t stop : stops) {
+    for (size_t i = 0; i <= clean.Length(); i++) {
+      nsString t(clean);
+      t.Insert(stop, i);
+      EXPECT_EQ(mozilla::HtmlTextRunPrefixLength(t.get(), t.Length()), i);
+    }
+  }
+}
+
 TEST_F(Strings, equals_ic) {
   nsCString s;
   EXPECT_FALSE(s.LowerCaseEqualsLiteral("view-source"));
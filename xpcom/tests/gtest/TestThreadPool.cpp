@@ -61,6 +61,27 @@ TEST(ThreadPool, Main)
   EXPECT_EQ(count, 100);
 }
 
+TEST(ThreadPool, WorkStealing)
+{
+  nsCOMPtr<nsIThreadPool> pool = new nsThreadPool();
+  EXPECT_TRUE(NS_SUCCEEDED(pool->SetThreadLimit(4)));
+  EXPECT_TRUE(NS_SUCCEEDED(pool->SetUseWorkStealing(true)));
+
+  Atomic<int> count(0);
+
+  for (int i = 0; i < 200; ++i) {
+    nsCOMPtr<nsIRunnable> task = NS_NewRunnableFunction(
+        "TestThreadPool::WorkStealing", [&count]() { ++count; });
+    pool->Dispatch(task, NS_DISPATCH_NORMAL);
+  }
+
+  // The mode cannot be changed once worker threads exist.
+  EXPECT_EQ(pool->SetUseWorkStealing(false), NS_ERROR_NOT_AVAILABLE);
+
+  pool->Shutdown();
+  EXPECT_EQ(count, 200);
+}
+
 TEST(ThreadPool, Parallelism)
 {
   nsCOMPtr<nsIThreadPool> pool = new nsThreadPool();
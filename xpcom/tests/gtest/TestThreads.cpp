@@ -9,7 +9,9 @@
 #include <stdlib.h>
 #include "nspr.h"
 #include "nsCOMPtr.h"
+#include "nsThread.h"
 #include "nsXPCOM.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/Monitor.h"
 #include "gtest/gtest.h"
 
@@ -62,6 +64,35 @@ TEST(Threads, Main)
       PR_MillisecondsToInterval(100));  // hopefully the runner will quit here
 }
 
+TEST(Threads, DispatchBatch)
+{
+  nsCOMPtr<nsIThread> thread;
+  nsresult rv = NS_NewNamedThread("DispatchBatch", getter_AddRefs(thread));
+  EXPECT_TRUE(NS_SUCCEEDED(rv));
+
+  mozilla::Atomic<int> count(0);
+  nsTArray<nsCOMPtr<nsIRunnable>> events;
+  for (int i = 0; i < 100; ++i) {
+    events.AppendElement(NS_NewRunnableFunction("TestThreads::DispatchBatch",
+                                                [&count]() { ++count; }));
+  }
+
+  rv = static_cast<nsThread*>(thread.get())->DispatchBatch(std::move(events));
+  EXPECT_TRUE(NS_SUCCEEDED(rv));
+  EXPECT_TRUE(events.IsEmpty());
+
+  // A sync dispatch is queued behind the batch, so by the time it runs all
+  // batched events have run.
+  rv = thread->Dispatch(
+      new mozilla::Runnable("TestThreads::DispatchBatchBarrier"),
+      NS_DISPATCH_SYNC);
+  EXPECT_TRUE(NS_SUCCEEDED(rv));
+  EXPECT_EQ(count, 100);
+
+  rv = thread->Shutdown();
+  EXPECT_TRUE(NS_SUCCEEDED(rv));
+}
+
 class nsStressRunner final : public nsIRunnable {
  public:
   NS_DECL_THREADSAFE_ISUPPORTS
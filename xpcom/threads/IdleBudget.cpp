@@ -0,0 +1,51 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/IdleBudget.h"
+
+#include "nsThreadUtils.h"
+
+namespace mozilla {
+
+Atomic<uint64_t, Relaxed> IdleBudget::sIdleDeadlineUs(0);
+
+/* static */
+void IdleBudget::SetIdle(TimeStamp aDeadline) {
+  MOZ_ASSERT(NS_IsMainThread(),
+             "Only the main thread's idle machinery publishes the estimate");
+  if (aDeadline.IsNull()) {
+    sIdleDeadlineUs = 0;
+    return;
+  }
+  TimeDuration sinceCreation = aDeadline - TimeStamp::ProcessCreation();
+  // A deadline in the first microsecond of the process would encode as
+  // "busy"; that can't happen in practice, since the idle machinery only
+  // starts up well after process creation.
+  sIdleDeadlineUs = uint64_t(sinceCreation.ToMicroseconds());
+}
+
+/* static */
+void IdleBudget::SetBusy() {
+  MOZ_ASSERT(NS_IsMainThread(),
+             "Only the main thread's idle machinery publishes the estimate");
+  sIdleDeadlineUs = 0;
+}
+
+/* static */
+TimeDuration IdleBudget::GetRemaining() {
+  uint64_t deadlineUs = sIdleDeadlineUs;
+  if (!deadlineUs) {
+    return TimeDuration();
+  }
+  double elapsedUs =
+      (TimeStamp::Now() - TimeStamp::ProcessCreation()).ToMicroseconds();
+  if (elapsedUs >= double(deadlineUs)) {
+    return TimeDuration();
+  }
+  return TimeDuration::FromMicroseconds(double(deadlineUs) - elapsedUs);
+}
+
+}  // namespace mozilla
@@ -0,0 +1,59 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_IdleBudget_h
+#define mozilla_IdleBudget_h
+
+/**
+ * A process-wide, lock-free snapshot of the main thread's idle estimate,
+ * readable from any thread.
+ *
+ * The main thread's idle period machinery (IdlePeriodState together with
+ * MainThreadIdlePeriod) already aggregates the signals that matter for "is
+ * now a good time for background work": the vsync-driven refresh deadline,
+ * pending timers, recent page loads, and whether the event queue holds
+ * non-idle (e.g. input) tasks. That estimate is only consultable on the main
+ * thread though, so helper threads doing discretionary maintenance (cache
+ * eviction, pool trimming, speculative decoding) have had no idle signal at
+ * all and tend to dog-pile right when the main thread becomes busy.
+ *
+ * IdleBudget publishes the main thread's latest estimate through a relaxed
+ * atomic. It is intentionally a hint: by the time a consumer acts on it the
+ * main thread may have become busy, so it must only be used to schedule work
+ * that is safe to run at any time, merely better run during idle.
+ */
+
+#include "mozilla/Atomics.h"
+#include "mozilla/TimeStamp.h"
+
+namespace mozilla {
+
+class IdleBudget {
+ public:
+  // Main thread only. Publish a new idle estimate; a null deadline means the
+  // main thread is busy or expects to be busy immediately.
+  static void SetIdle(TimeStamp aDeadline);
+  static void SetBusy();
+
+  // Any thread. Returns the portion of the main thread's most recently
+  // published idle period that has not yet elapsed, or a zero duration if the
+  // main thread was busy when it last updated the estimate.
+  static TimeDuration GetRemaining();
+
+  // Any thread. True if the main thread's published idle period has time
+  // left. Cheap enough to consult before each slice of background work.
+  static bool IsIdle() { return GetRemaining() > TimeDuration(); }
+
+ private:
+  // The idle deadline as microseconds since process creation, or 0 while
+  // busy. Relaxed ordering suffices: consumers only use this as a scheduling
+  // hint and never synchronize other memory against it.
+  static Atomic<uint64_t, Relaxed> sIdleDeadlineUs;
+};
+
+}  // namespace mozilla
+
+#endif  // mozilla_IdleBudget_h
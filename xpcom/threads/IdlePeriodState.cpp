@@ -5,6 +5,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "mozilla/IdlePeriodState.h"
+#include "mozilla/IdleBudget.h"
 #include "mozilla/StaticPrefs_idle_period.h"
 #include "mozilla/ipc/IdleSchedulerChild.h"
 #include "nsIIdlePeriod.h"
@@ -48,6 +49,10 @@ void IdlePeriodState::FlagNotIdle() {
   if (mIdleToken && mIdleToken < TimeStamp::Now()) {
     ClearIdleToken();
   }
+
+  // The queue holds a non-idle task, so background work elsewhere in the
+  // process should back off too.
+  IdleBudget::SetBusy();
 }
 
 void IdlePeriodState::RanOutOfTasks(const MutexAutoUnlock& aProofOfUnlock) {
@@ -70,6 +75,7 @@ TimeStamp IdlePeriodState::GetIdleDeadlineInternal(
     if (!aIsPeek) {
       EnsureIsPaused(aProofOfUnlock);
       ClearIdleToken();
+      IdleBudget::SetBusy();
     }
     return TimeStamp();
   }
@@ -89,12 +95,16 @@ TimeStamp IdlePeriodState::GetIdleDeadlineInternal(
       // take mutexes.  This is one reason why we need the
       // MutexAutoUnlock reference!
       RequestIdleToken(localIdleDeadline);
+      IdleBudget::SetBusy();
     }
     return TimeStamp();
   }
 
   if (!aIsPeek) {
     EnsureIsActive();
+    // Publish the estimate so helper threads can schedule their own
+    // discretionary work inside the same window.
+    IdleBudget::SetIdle(idleDeadline);
   }
   return idleDeadline;
 }
@@ -31,6 +31,10 @@ inline already_AddRefed<nsThread> CreateMainThread(
 
   prioritized->SetMutexRef(synchronizedQueue->MutexRef());
 
+  // Cross-thread dispatches to the main thread are frequent enough that its
+  // queue gets the lock-free fast path.
+  synchronizedQueue->EnableLockFreeDispatch();
+
   // Setup "main" thread
   RefPtr<nsThread> mainThread =
       new nsThread(WrapNotNull(synchronizedQueue), nsThread::MAIN_THREAD, 0);
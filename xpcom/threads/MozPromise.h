@@ -501,6 +501,108 @@ class MozPromise : public MozPromiseBase {
 #  endif
   };
 
+ public:
+  typedef MozPromise<nsTArray<ResolveOrRejectValue>, bool, IsExclusive>
+      AllSettledPromiseType;
+
+ private:
+  class AllSettledPromiseHolder : public MozPromiseRefcountable {
+   public:
+    explicit AllSettledPromiseHolder(size_t aDependentPromises)
+        : mPromise(new typename AllSettledPromiseType::Private(__func__)),
+          mOutstandingPromises(aDependentPromises) {
+      MOZ_ASSERT(aDependentPromises > 0);
+      // All bookkeeping is reserved up front: each input promise settles
+      // into its preallocated slot, and the array is handed to the resolve
+      // value without further copying.
+      mValues.SetLength(aDependentPromises);
+    }
+
+    void Settle(size_t aIndex, ResolveOrRejectValue&& aValue) {
+      mValues[aIndex] = std::move(aValue);
+      if (--mOutstandingPromises == 0) {
+        mPromise->Resolve(std::move(mValues), __func__);
+        mPromise = nullptr;
+      }
+    }
+
+    AllSettledPromiseType* Promise() { return mPromise; }
+
+   private:
+    nsTArray<ResolveOrRejectValue> mValues;
+    RefPtr<typename AllSettledPromiseType::Private> mPromise;
+    size_t mOutstandingPromises;
+  };
+
+  // Records one input promise's result for AllSettled.  Unlike the pair of
+  // lambdas All() hands to Then(), this carries exactly a holder reference
+  // and a slot index, and is attached with ThenInternal() directly so no
+  // intermediate ThenValue is created.
+  class AllSettledElement final : public ThenValueBase {
+   public:
+    AllSettledElement(nsISerialEventTarget* aResponseTarget,
+                      AllSettledPromiseHolder* aHolder, size_t aIndex)
+        : ThenValueBase(aResponseTarget, "MozPromise::AllSettled"),
+          mHolder(aHolder),
+          mIndex(aIndex) {}
+
+   protected:
+    MozPromiseBase* CompletionPromise() const override { return nullptr; }
+
+    void DoResolveOrRejectInternal(ResolveOrRejectValue& aValue) override {
+      mHolder->Settle(mIndex, ResolveOrRejectValue(MaybeMove(aValue)));
+      // Null out mHolder after settling so that the holder (and the values
+      // accumulated so far) are released predictably on the dispatch thread.
+      mHolder = nullptr;
+    }
+
+   private:
+    RefPtr<AllSettledPromiseHolder>
+        mHolder;  // Only accessed and refcounted on dispatch thread.
+    const size_t mIndex;
+  };
+
+ public:
+  // Like All(), but never rejects: the returned promise resolves, once every
+  // input promise has settled, with an array recording each input's resolve
+  // or reject value in input order.
+  static MOZ_MUST_USE RefPtr<AllSettledPromiseType> AllSettled(
+      nsISerialEventTarget* aProcessingTarget,
+      nsTArray<RefPtr<MozPromise>>& aPromises) {
+    if (aPromises.Length() == 0) {
+      return AllSettledPromiseType::CreateAndResolve(
+          nsTArray<ResolveOrRejectValue>(), __func__);
+    }
+
+    RefPtr<AllSettledPromiseHolder> holder =
+        new AllSettledPromiseHolder(aPromises.Length());
+    RefPtr<AllSettledPromiseType> promise = holder->Promise();
+    const bool onProcessingTarget = aProcessingTarget->IsOnCurrentThread();
+    for (size_t i = 0; i < aPromises.Length(); ++i) {
+      MozPromise* p = aPromises[i];
+      if (onProcessingTarget) {
+        // When the results would be processed on this very thread anyway, an
+        // already-settled input can be recorded right away, eliding both the
+        // AllSettledElement allocation and its dispatch.  The aggregate
+        // promise still resolves asynchronously, so this is not observable.
+        MutexAutoLock lock(p->mMutex);
+        if (!p->IsPending()) {
+          MOZ_DIAGNOSTIC_ASSERT(
+              !IsExclusive || !p->mHaveRequest,
+              "Using an exclusive promise in a non-exclusive fashion");
+          p->mHaveRequest = true;
+          holder->Settle(i, ResolveOrRejectValue(MaybeMove(p->mValue)));
+          continue;
+        }
+      }
+      RefPtr<ThenValueBase> element =
+          new AllSettledElement(aProcessingTarget, holder, i);
+      p->ThenInternal(element.forget(), __func__);
+    }
+    return promise;
+  }
+
+ protected:
   /*
    * We create two overloads for invoking Resolve/Reject Methods so as to
    * make the resolve/reject value argument "optional".
@@ -5,10 +5,25 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "SynchronizedEventQueue.h"
+#include "nsIRunnable.h"
 #include "nsIThreadInternal.h"
 
 using namespace mozilla;
 
+bool ThreadTargetSink::PutEventBatch(nsTArray<nsCOMPtr<nsIRunnable>>& aEvents,
+                                     EventQueuePriority aPriority) {
+  // Generic fallback: one PutEvent per runnable.  ThreadEventQueue overrides
+  // this with a single-lock implementation.  A failed PutEvent leaks its
+  // reference (so the event is not released on the wrong thread); keep going
+  // so every event gets the same treatment.
+  bool ok = true;
+  for (size_t i = 0; i < aEvents.Length(); ++i) {
+    ok = PutEvent(aEvents[i].forget(), aPriority) && ok;
+  }
+  aEvents.Clear();
+  return ok;
+}
+
 void SynchronizedEventQueue::AddObserver(nsIThreadObserver* aObserver) {
   MOZ_ASSERT(aObserver);
   MOZ_ASSERT(!mEventObservers.Contains(aObserver));
@@ -11,9 +11,12 @@
 #include "mozilla/AbstractEventQueue.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Mutex.h"
+#include "nsCOMPtr.h"
+#include "nsTArray.h"
 #include "nsTObserverArray.h"
 
 class nsIEventTarget;
+class nsIRunnable;
 class nsISerialEventTarget;
 class nsIThreadObserver;
 
@@ -40,6 +43,17 @@ class ThreadTargetSink {
   virtual bool PutEvent(already_AddRefed<nsIRunnable>&& aEvent,
                         EventQueuePriority aPriority) = 0;
 
+  // Put a batch of events at once.  Implementations that synchronize with a
+  // lock should override this to enqueue the whole array under a single lock
+  // acquisition and issue a single wakeup, which matters for producers that
+  // dispatch thousands of small runnables.  The events are consumed from
+  // aEvents in order and the array is emptied; references to events that
+  // could not be enqueued (e.g. after shutdown) are intentionally leaked,
+  // like PutEvent does, so they are not released on the wrong thread.
+  // Returns true if all events were enqueued.
+  virtual bool PutEventBatch(nsTArray<nsCOMPtr<nsIRunnable>>& aEvents,
+                             EventQueuePriority aPriority);
+
   // After this method is called, no more events can be posted.
   virtual void Disconnect(const MutexAutoLock& aProofOfLock) = 0;
 
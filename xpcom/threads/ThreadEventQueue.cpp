@@ -6,6 +6,7 @@
 
 #include "mozilla/ThreadEventQueue.h"
 #include "mozilla/EventQueue.h"
+#include "mozilla/Unused.h"
 
 #include "LeakRefPtr.h"
 #include "nsComponentManagerUtils.h"
@@ -45,6 +46,92 @@ class ThreadEventQueue<InnerQueueT>::NestedSink : public ThreadTargetSink {
   RefPtr<ThreadEventQueue> mOwner;
 };
 
+// A bounded lock-free ring (a Vyukov-style sequenced ring buffer) placed in
+// front of the synchronized queue by EnableLockFreeDispatch.  Multiple
+// producers push concurrently without blocking each other; the single
+// consumer pops while holding mLock in DrainRing.  Cell sequence numbers
+// both publish completed writes and detect a full ring, in which case the
+// producer falls back to the ordinary locked path.
+template <class InnerQueueT>
+class ThreadEventQueue<InnerQueueT>::LockFreeRing {
+ public:
+  LockFreeRing() : mHead(0), mTail(0) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      mCells[i].mSequence = i;
+      mCells[i].mEvent = nullptr;
+    }
+  }
+
+  ~LockFreeRing() {
+    // Anything still in the ring raced with shutdown.  Leak the references,
+    // like a failed PutEvent does, so the events are not released on the
+    // wrong thread.
+    EventQueuePriority priority;
+    bool leaked = false;
+    while (nsCOMPtr<nsIRunnable> event = TryPop(&priority)) {
+      Unused << event.forget().take();
+      leaked = true;
+    }
+    if (leaked) {
+      NS_WARNING("Leaking runnables dispatched lock-free during shutdown");
+    }
+  }
+
+  // On success the ring owns the reference the caller held on aEvent.
+  bool TryPush(nsIRunnable* aEvent, EventQueuePriority aPriority) {
+    size_t pos = mHead;
+    for (;;) {
+      Cell& cell = mCells[pos & kMask];
+      size_t seq = cell.mSequence;
+      intptr_t diff = intptr_t(seq) - intptr_t(pos);
+      if (diff == 0) {
+        if (mHead.compareExchange(pos, pos + 1)) {
+          cell.mEvent = aEvent;
+          cell.mPriority = aPriority;
+          cell.mSequence = pos + 1;  // publish the cell
+          return true;
+        }
+        pos = mHead;
+      } else if (diff < 0) {
+        // Full; fall back to the locked path.
+        return false;
+      } else {
+        pos = mHead;
+      }
+    }
+  }
+
+  already_AddRefed<nsIRunnable> TryPop(EventQueuePriority* aPriority) {
+    size_t pos = mTail;
+    Cell& cell = mCells[pos & kMask];
+    size_t seq = cell.mSequence;
+    if (intptr_t(seq) - intptr_t(pos + 1) != 0) {
+      // Empty, or the producer has not published the cell yet.
+      return nullptr;
+    }
+    nsCOMPtr<nsIRunnable> event = dont_AddRef(cell.mEvent);
+    *aPriority = cell.mPriority;
+    cell.mEvent = nullptr;
+    cell.mSequence = pos + kCapacity;  // recycle the cell
+    mTail = pos + 1;
+    return event.forget();
+  }
+
+ private:
+  static const size_t kCapacity = 512;  // must be a power of two
+  static const size_t kMask = kCapacity - 1;
+
+  struct Cell {
+    Atomic<size_t> mSequence;
+    nsIRunnable* mEvent;
+    EventQueuePriority mPriority;
+  };
+
+  Cell mCells[kCapacity];
+  Atomic<size_t> mHead;  // next cell to fill (producers)
+  Atomic<size_t> mTail;  // next cell to empty (consumer)
+};
+
 template <class InnerQueueT>
 ThreadEventQueue<InnerQueueT>::ThreadEventQueue(UniquePtr<InnerQueueT> aQueue)
     : mBaseQueue(std::move(aQueue)),
@@ -59,12 +146,111 @@ ThreadEventQueue<InnerQueueT>::~ThreadEventQueue() {
   MOZ_ASSERT(mNestedQueues.IsEmpty());
 }
 
+template <class InnerQueueT>
+void ThreadEventQueue<InnerQueueT>::EnableLockFreeDispatch() {
+  MOZ_ASSERT(!mRing);
+  mRing = MakeUnique<LockFreeRing>();
+}
+
+template <class InnerQueueT>
+bool ThreadEventQueue<InnerQueueT>::DrainRing(
+    const MutexAutoLock& aProofOfLock) {
+  if (!mRing) {
+    return false;
+  }
+  bool drained = false;
+  EventQueuePriority priority;
+  while (nsCOMPtr<nsIRunnable> event = mRing->TryPop(&priority)) {
+    mBaseQueue->PutEvent(event.forget(), priority, aProofOfLock);
+    drained = true;
+  }
+  return drained;
+}
+
+// Check if the runnable wants to override the passed-in priority.  This QIs
+// the runnable, so it must be called outside the queue lock: runnables
+// implemented in JS can QI (and possibly GC) there.
+static EventQueuePriority PriorityForEvent(nsIRunnable* aEvent,
+                                           EventQueuePriority aPriority) {
+  if (nsCOMPtr<nsIRunnablePriority> runnablePrio = do_QueryInterface(aEvent)) {
+    uint32_t prio = nsIRunnablePriority::PRIORITY_NORMAL;
+    runnablePrio->GetPriority(&prio);
+    if (prio == nsIRunnablePriority::PRIORITY_HIGH) {
+      aPriority = EventQueuePriority::High;
+    } else if (prio == nsIRunnablePriority::PRIORITY_INPUT_HIGH) {
+      aPriority = EventQueuePriority::Input;
+    } else if (prio == nsIRunnablePriority::PRIORITY_MEDIUMHIGH) {
+      aPriority = EventQueuePriority::MediumHigh;
+    } else if (prio == nsIRunnablePriority::PRIORITY_DEFERRED_TIMERS) {
+      aPriority = EventQueuePriority::DeferredTimers;
+    } else if (prio == nsIRunnablePriority::PRIORITY_IDLE) {
+      aPriority = EventQueuePriority::Idle;
+    }
+  }
+  return aPriority;
+}
+
 template <class InnerQueueT>
 bool ThreadEventQueue<InnerQueueT>::PutEvent(
     already_AddRefed<nsIRunnable>&& aEvent, EventQueuePriority aPriority) {
   return PutEventInternal(std::move(aEvent), aPriority, nullptr);
 }
 
+template <class InnerQueueT>
+bool ThreadEventQueue<InnerQueueT>::PutEventBatch(
+    nsTArray<nsCOMPtr<nsIRunnable>>& aEvents, EventQueuePriority aPriority) {
+  nsCOMPtr<nsIThreadObserver> obs;
+
+  // Resolve per-runnable priority overrides before taking the lock.
+  AutoTArray<EventQueuePriority, 64> priorities;
+  if (InnerQueueT::SupportsPrioritization) {
+    priorities.SetCapacity(aEvents.Length());
+    for (const nsCOMPtr<nsIRunnable>& event : aEvents) {
+      priorities.AppendElement(PriorityForEvent(event, aPriority));
+    }
+  }
+
+  {
+    MutexAutoLock lock(mLock);
+
+    if (mEventsAreDoomed) {
+      // Leak the references as PutEvent would, so the events are not
+      // released on the wrong thread.
+      for (nsCOMPtr<nsIRunnable>& event : aEvents) {
+        Unused << event.forget().take();
+      }
+      aEvents.Clear();
+      return false;
+    }
+
+    // Flush any ring backlog into the base queue first, so the batch cannot
+    // run ahead of events the same producer already pushed through the ring
+    // (see PutEventInternal).
+    DrainRing(lock);
+
+    for (size_t i = 0; i < aEvents.Length(); ++i) {
+      EventQueuePriority priority =
+          InnerQueueT::SupportsPrioritization ? priorities[i] : aPriority;
+      mBaseQueue->PutEvent(aEvents[i].forget(), priority, lock);
+    }
+    aEvents.Clear();
+
+    // A single wakeup for the whole batch; the consumer drains the queue
+    // until it is empty anyway.
+    mEventsAvailable.Notify();
+
+    // Make sure to grab the observer before dropping the lock (see
+    // PutEventInternal).
+    obs = mObserver;
+  }
+
+  if (obs) {
+    obs->OnDispatchedEvent();
+  }
+
+  return true;
+}
+
 template <class InnerQueueT>
 bool ThreadEventQueue<InnerQueueT>::PutEventInternal(
     already_AddRefed<nsIRunnable>&& aEvent, EventQueuePriority aPriority,
@@ -79,22 +265,38 @@ bool ThreadEventQueue<InnerQueueT>::PutEventInternal(
     // Do this outside the lock, so runnables implemented in JS can QI
     // (and possibly GC) outside of the lock.
     if (InnerQueueT::SupportsPrioritization) {
-      auto* e = event.get();  // can't do_QueryInterface on LeakRefPtr.
-      if (nsCOMPtr<nsIRunnablePriority> runnablePrio = do_QueryInterface(e)) {
-        uint32_t prio = nsIRunnablePriority::PRIORITY_NORMAL;
-        runnablePrio->GetPriority(&prio);
-        if (prio == nsIRunnablePriority::PRIORITY_HIGH) {
-          aPriority = EventQueuePriority::High;
-        } else if (prio == nsIRunnablePriority::PRIORITY_INPUT_HIGH) {
-          aPriority = EventQueuePriority::Input;
-        } else if (prio == nsIRunnablePriority::PRIORITY_MEDIUMHIGH) {
-          aPriority = EventQueuePriority::MediumHigh;
-        } else if (prio == nsIRunnablePriority::PRIORITY_DEFERRED_TIMERS) {
-          aPriority = EventQueuePriority::DeferredTimers;
-        } else if (prio == nsIRunnablePriority::PRIORITY_IDLE) {
-          aPriority = EventQueuePriority::Idle;
+      // can't do_QueryInterface on LeakRefPtr.
+      aPriority = PriorityForEvent(event.get(), aPriority);
+    }
+
+    // Lock-free fast path (see EnableLockFreeDispatch).  Nested-queue
+    // dispatches always take the locked path, since the ring only feeds
+    // mBaseQueue.
+    if (mRing && !aSink) {
+      ++mRingProducers;
+      if (!mRingDoomed && mRing->TryPush(event.get(), aPriority)) {
+        Unused << event.take();  // the ring owns the reference now
+        --mRingProducers;
+        // If the consumer is busy running an event, it is guaranteed to
+        // drain the ring in DidRunEvent before it can go back to sleep, so
+        // we can skip the wakeup.  Otherwise it may already be waiting (or
+        // idle in a native event loop), and we notify as usual.
+        if (!mConsumerActive) {
+          nsCOMPtr<nsIThreadObserver> ringObs;
+          {
+            MutexAutoLock lock(mLock);
+            mEventsAvailable.Notify();
+            ringObs = mObserver;
+          }
+          if (ringObs) {
+            ringObs->OnDispatchedEvent();
+          }
         }
+        return true;
       }
+      // Doomed, or the ring is full: fall through to the locked path, which
+      // also handles mEventsAreDoomed.
+      --mRingProducers;
     }
 
     MutexAutoLock lock(mLock);
@@ -103,6 +305,12 @@ bool ThreadEventQueue<InnerQueueT>::PutEventInternal(
       return false;
     }
 
+    // Flush any ring backlog into the base queue first, so this event cannot
+    // run ahead of events the same producer already pushed through the ring.
+    // Without this the full-ring fallback would invert same-producer dispatch
+    // order exactly when the ring is full.
+    DrainRing(lock);
+
     if (aSink) {
       if (!aSink->mQueue) {
         return false;
@@ -146,6 +354,8 @@ already_AddRefed<nsIRunnable> ThreadEventQueue<InnerQueueT>::GetEvent(
     MutexAutoLock lock(mLock);
 
     for (;;) {
+      DrainRing(lock);
+
       const bool noNestedQueue = mNestedQueues.IsEmpty();
       if (noNestedQueue) {
         idleState = mBaseQueue->GetIdlePeriodState();
@@ -203,10 +413,25 @@ already_AddRefed<nsIRunnable> ThreadEventQueue<InnerQueueT>::GetEvent(
         break;
       }
 
+      // Let producers know we are about to sleep, then check the ring one
+      // last time: a producer that pushed before observing mConsumerActive
+      // as false has its event picked up here, and one that pushed after
+      // will notify us.
+      mConsumerActive = false;
+      if (DrainRing(lock)) {
+        continue;
+      }
+
       AUTO_PROFILER_LABEL("ThreadEventQueue::GetEvent::Wait", IDLE);
       AUTO_PROFILER_THREAD_SLEEP;
       mEventsAvailable.Wait();
     }
+
+    if (event) {
+      // While we run this event, producers may elide the wakeup; DidRunEvent
+      // will drain the ring when we are done.
+      mConsumerActive = true;
+    }
   }
 
   if (idleState) {
@@ -228,6 +453,11 @@ already_AddRefed<nsIRunnable> ThreadEventQueue<InnerQueueT>::GetEvent(
 template <class InnerQueueT>
 void ThreadEventQueue<InnerQueueT>::DidRunEvent() {
   MutexAutoLock lock(mLock);
+  // We are no longer guaranteed to drain the ring soon, so producers must go
+  // back to notifying.  The drain below picks up anything pushed while the
+  // wakeup was elided.
+  mConsumerActive = false;
+  DrainRing(lock);
   if (mNestedQueues.IsEmpty()) {
     mBaseQueue->DidRunEvent(lock);
     // Don't do anything else here, because that call might have
@@ -240,6 +470,7 @@ void ThreadEventQueue<InnerQueueT>::DidRunEvent() {
 template <class InnerQueueT>
 bool ThreadEventQueue<InnerQueueT>::HasPendingEvent() {
   MutexAutoLock lock(mLock);
+  DrainRing(lock);
 
   // We always get events from the topmost queue when there are nested queues.
   if (mNestedQueues.IsEmpty()) {
@@ -252,6 +483,7 @@ bool ThreadEventQueue<InnerQueueT>::HasPendingEvent() {
 template <class InnerQueueT>
 bool ThreadEventQueue<InnerQueueT>::HasPendingHighPriorityEvents() {
   MutexAutoLock lock(mLock);
+  DrainRing(lock);
 
   // We always get events from the topmost queue when there are nested queues.
   if (mNestedQueues.IsEmpty()) {
@@ -265,10 +497,22 @@ bool ThreadEventQueue<InnerQueueT>::HasPendingHighPriorityEvents() {
 template <class InnerQueueT>
 bool ThreadEventQueue<InnerQueueT>::ShutdownIfNoPendingEvents() {
   MutexAutoLock lock(mLock);
+  if (mRing) {
+    // Close the fast path, wait out any producer that already started a
+    // push (pushes are a handful of instructions), and collect whatever
+    // made it into the ring so the emptiness check below is authoritative.
+    mRingDoomed = true;
+    while (mRingProducers) {
+    }
+    DrainRing(lock);
+  }
   if (mNestedQueues.IsEmpty() && mBaseQueue->IsEmpty(lock)) {
     mEventsAreDoomed = true;
     return true;
   }
+  if (mRing) {
+    mRingDoomed = false;
+  }
   return false;
 }
 
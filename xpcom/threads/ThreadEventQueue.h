@@ -8,6 +8,7 @@
 #define mozilla_ThreadEventQueue_h
 
 #include "mozilla/AbstractEventQueue.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/CondVar.h"
 #include "mozilla/SynchronizedEventQueue.h"
 #include "nsCOMPtr.h"
@@ -36,6 +37,9 @@ class ThreadEventQueue final : public SynchronizedEventQueue {
   bool PutEvent(already_AddRefed<nsIRunnable>&& aEvent,
                 EventQueuePriority aPriority) final;
 
+  bool PutEventBatch(nsTArray<nsCOMPtr<nsIRunnable>>& aEvents,
+                     EventQueuePriority aPriority) final;
+
   already_AddRefed<nsIRunnable> GetEvent(
       bool aMayWait, EventQueuePriority* aPriority,
       mozilla::TimeDuration* aLastEventDelay = nullptr) final;
@@ -59,6 +63,13 @@ class ThreadEventQueue final : public SynchronizedEventQueue {
   already_AddRefed<nsIThreadObserver> GetObserverOnThread() final;
   void SetObserver(nsIThreadObserver* aObserver) final;
 
+  // Install a bounded lock-free MPSC ring in front of the queue.  Producers
+  // then enqueue without taking mLock (and, while the consumer is running an
+  // event, without waking anybody); the consumer drains the ring into the
+  // inner queue under mLock before every event-queue operation.  Must be
+  // called before the queue is used concurrently.
+  void EnableLockFreeDispatch();
+
   Mutex& MutexRef() { return mLock; }
 
   size_t SizeOfExcludingThis(
@@ -66,14 +77,29 @@ class ThreadEventQueue final : public SynchronizedEventQueue {
 
  private:
   class NestedSink;
+  class LockFreeRing;
 
   virtual ~ThreadEventQueue();
 
   bool PutEventInternal(already_AddRefed<nsIRunnable>&& aEvent,
                         EventQueuePriority aPriority, NestedSink* aQueue);
 
+  // Move everything in the lock-free ring into mBaseQueue.  Returns true if
+  // anything was drained.
+  bool DrainRing(const MutexAutoLock& aProofOfLock);
+
   UniquePtr<InnerQueueT> mBaseQueue;
 
+  // See EnableLockFreeDispatch.  mConsumerActive is true while the consumer
+  // thread is running an event and therefore guaranteed to drain the ring
+  // (in DidRunEvent) before it can go back to sleep; producers may then skip
+  // the wakeup entirely.  mRingProducers counts producers inside TryPush so
+  // shutdown can wait them out.
+  UniquePtr<LockFreeRing> mRing;
+  Atomic<bool> mConsumerActive{false};
+  Atomic<bool> mRingDoomed{false};
+  Atomic<uint32_t> mRingProducers{0};
+
   struct NestedQueueItem {
     UniquePtr<EventQueue> mQueue;
     RefPtr<ThreadEventTarget> mEventTarget;
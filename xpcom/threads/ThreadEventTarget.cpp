@@ -164,6 +164,23 @@ ThreadEventTarget::Dispatch(already_AddRefed<nsIRunnable> aEvent,
   return NS_OK;
 }
 
+nsresult ThreadEventTarget::DispatchBatch(
+    nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+  nsTArray<nsCOMPtr<nsIRunnable>> events = std::move(aEvents);
+
+  if (gXPCOMThreadsShutDown && !mIsMainThread) {
+    NS_ASSERTION(false, "Failed DispatchBatch after xpcom-shutdown-threads");
+    return NS_ERROR_ILLEGAL_DURING_SHUTDOWN;
+  }
+
+  if (!mSink->PutEventBatch(events, EventQueuePriority::Normal)) {
+    return NS_ERROR_UNEXPECTED;
+  }
+  // Delay to encourage the receiving task to run before we do work.
+  DelayForChaosMode(ChaosFeature::TaskDispatching, 1000);
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 ThreadEventTarget::DelayedDispatch(already_AddRefed<nsIRunnable> aEvent,
                                    uint32_t aDelayMs) {
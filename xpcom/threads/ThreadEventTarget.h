@@ -23,6 +23,11 @@ class ThreadEventTarget final : public nsISerialEventTarget {
   NS_DECL_THREADSAFE_ISUPPORTS
   NS_DECL_NSIEVENTTARGET_FULL
 
+  // C++-only: dispatch a batch of events with a single lock acquisition and
+  // a single wakeup of the target thread.  See
+  // ThreadTargetSink::PutEventBatch for the ownership rules.
+  nsresult DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents);
+
   // Disconnects the target so that it can no longer post events.
   void Disconnect(const MutexAutoLock& aProofOfLock) {
     mSink->Disconnect(aProofOfLock);
@@ -40,7 +40,157 @@ TimerThread::TimerThread()
 TimerThread::~TimerThread() {
   mThread = nullptr;
 
-  NS_ASSERTION(mTimers.IsEmpty(), "Timers remain in TimerThread::~TimerThread");
+  NS_ASSERTION(mWheel.IsEmpty(), "Timers remain in TimerThread::~TimerThread");
+}
+
+//-----------------------------------------------------------------------------
+// TimerThread::Wheel
+
+int64_t TimerThread::Wheel::TickFor(const TimeStamp& aTime) const {
+  MOZ_ASSERT(!mBase.IsNull());
+  TimeDuration elapsed = aTime - mBase;
+  return elapsed <= TimeDuration() ? 0 : int64_t(elapsed.ToMilliseconds());
+}
+
+bool TimerThread::Wheel::FileEntry(mozilla::UniquePtr<Entry> aEntry,
+                                   bool aFallible) {
+  int64_t ticks = TickFor(aEntry->Timeout());
+  if (ticks < mCurrentTick) {
+    ticks = mCurrentTick;  // overdue; file into the current slot
+  }
+  int64_t delta = ticks - mCurrentTick;
+
+  nsTArray<mozilla::UniquePtr<Entry>>* list = &mOverflow;
+  for (size_t level = 0; level < kLevels; ++level) {
+    if (delta < (int64_t(1) << (kSlotBits * (level + 1)))) {
+      list = &mSlots[level][(ticks >> (kSlotBits * level)) & kSlotMask];
+      break;
+    }
+  }
+
+  if (aFallible) {
+    return list->AppendElement(std::move(aEntry), mozilla::fallible) !=
+           nullptr;
+  }
+  list->AppendElement(std::move(aEntry));
+  return true;
+}
+
+bool TimerThread::Wheel::Insert(mozilla::UniquePtr<Entry> aEntry,
+                                const TimeStamp& aNow) {
+  if (mBase.IsNull()) {
+    mBase = aNow;
+  }
+
+  TimeStamp timeout = aEntry->Timeout();
+  if (!FileEntry(std::move(aEntry), /* aFallible = */ true)) {
+    return false;
+  }
+  ++mCount;
+  if (mNextDueValid && (mNextDue.IsNull() || timeout < mNextDue)) {
+    mNextDue = timeout;
+  }
+  return true;
+}
+
+void TimerThread::Wheel::CascadeLevels() {
+  nsTArray<mozilla::UniquePtr<Entry>> refile;
+  for (size_t level = 1; level < kLevels; ++level) {
+    if (mCurrentTick & ((int64_t(1) << (kSlotBits * level)) - 1)) {
+      break;
+    }
+    refile.AppendElements(std::move(
+        mSlots[level][(mCurrentTick >> (kSlotBits * level)) & kSlotMask]));
+  }
+  if ((mCurrentTick & ((int64_t(1) << (kSlotBits * kLevels)) - 1)) == 0) {
+    refile.AppendElements(std::move(mOverflow));
+  }
+
+  for (mozilla::UniquePtr<Entry>& entry : refile) {
+    if (!entry->Value()) {
+      --mCount;  // canceled; drop the husk
+      continue;
+    }
+    FileEntry(std::move(entry), /* aFallible = */ false);
+  }
+}
+
+void TimerThread::Wheel::PopExpired(
+    const TimeStamp& aDeadline, nsTArray<mozilla::UniquePtr<Entry>>& aExpired) {
+  if (mCount == 0 || mBase.IsNull()) {
+    return;
+  }
+
+  int64_t target = TickFor(aDeadline);
+  for (;;) {
+    nsTArray<mozilla::UniquePtr<Entry>>& slot =
+        mSlots[0][mCurrentTick & kSlotMask];
+    for (size_t i = 0; i < slot.Length();) {
+      if (!slot[i]->Value()) {
+        --mCount;
+        slot.RemoveElementAt(i);
+        continue;
+      }
+      // A slot may hold entries for a later revolution, or (in the slot we
+      // stop at) entries due a fraction of a tick after the deadline, so
+      // check the precise timeout.
+      if (slot[i]->Timeout() <= aDeadline) {
+        aExpired.AppendElement(std::move(slot[i]));
+        --mCount;
+        slot.RemoveElementAt(i);
+        continue;
+      }
+      ++i;
+    }
+    if (mCurrentTick >= target) {
+      break;
+    }
+    ++mCurrentTick;
+    if ((mCurrentTick & kSlotMask) == 0) {
+      CascadeLevels();
+    }
+  }
+
+  mNextDueValid = false;
+}
+
+TimerThread::TimeStamp TimerThread::Wheel::NextTimeout() {
+  if (!mNextDueValid) {
+    mNextDue = TimeStamp();
+    auto scan = [&](nsTArray<mozilla::UniquePtr<Entry>>& aList) {
+      for (size_t i = 0; i < aList.Length();) {
+        if (!aList[i]->Value()) {
+          --mCount;
+          aList.RemoveElementAt(i);
+          continue;
+        }
+        if (mNextDue.IsNull() || aList[i]->Timeout() < mNextDue) {
+          mNextDue = aList[i]->Timeout();
+        }
+        ++i;
+      }
+    };
+    for (size_t level = 0; level < kLevels; ++level) {
+      for (size_t slot = 0; slot < kSlots; ++slot) {
+        scan(mSlots[level][slot]);
+      }
+    }
+    scan(mOverflow);
+    mNextDueValid = true;
+  }
+  return mNextDue;
+}
+
+void TimerThread::Wheel::Clear(nsTArray<mozilla::UniquePtr<Entry>>& aOut) {
+  for (size_t level = 0; level < kLevels; ++level) {
+    for (size_t slot = 0; slot < kSlots; ++slot) {
+      aOut.AppendElements(std::move(mSlots[level][slot]));
+    }
+  }
+  aOut.AppendElements(std::move(mOverflow));
+  mCount = 0;
+  mNextDue = TimeStamp();
+  mNextDueValid = true;
 }
 
 nsresult TimerThread::InitLocks() { return NS_OK; }
@@ -304,17 +454,16 @@ nsresult TimerThread::Shutdown() {
       mMonitor.Notify();
     }
 
-    // Need to copy content of mTimers array to a local array
-    // because call to timers' Cancel() (and release its self)
-    // must not be done under the lock. Destructor of a callback
-    // might potentially call some code reentering the same lock
-    // that leads to unexpected behavior or deadlock.
-    // See bug 422472.
-    for (const UniquePtr<Entry>& entry : mTimers) {
+    // Need to copy the timers to a local array because the calls to the
+    // timers' Cancel() (and release of self) must not be done under the
+    // lock. Destructor of a callback might potentially call some code
+    // reentering the same lock that leads to unexpected behavior or
+    // deadlock. See bug 422472.
+    nsTArray<UniquePtr<Entry>> entries;
+    mWheel.Clear(entries);
+    for (const UniquePtr<Entry>& entry : entries) {
       timers.AppendElement(entry->Take());
     }
-
-    mTimers.Clear();
   }
 
   for (const RefPtr<nsTimerImpl>& timer : timers) {
@@ -390,65 +539,80 @@ TimerThread::Run() {
       waitFor = TimeDuration::Forever();
       TimeStamp now = TimeStamp::Now();
 
-      RemoveLeadingCanceledTimersInternal();
+      // Collect everything that is due, allowing for the firing resolution:
+      // timers closer to their deadline than the wait resolution are rounded
+      // down and fired now.
+      TimeStamp deadline = now + TimeDuration::FromMicroseconds(
+                                     double(mAllowedEarlyFiringMicroseconds));
+      if (forceRunThisTimer) {
+        // Chaos mode decided to run the next timer early, wherever it is.
+        TimeStamp next = mWheel.NextTimeout();
+        if (!next.IsNull() && next > deadline) {
+          deadline = next;
+        }
+      }
 
-      if (!mTimers.IsEmpty()) {
-        if (now >= mTimers[0]->Value()->mTimeout || forceRunThisTimer) {
-        next:
-          // NB: AddRef before the Release under RemoveTimerInternal to avoid
-          // mRefCnt passing through zero, in case all other refs than the one
-          // from mTimers have gone away (the last non-mTimers[i]-ref's Release
-          // must be racing with us, blocked in gThread->RemoveTimer waiting
-          // for TimerThread::mMonitor, under nsTimerImpl::Release.
+      AutoTArray<UniquePtr<Entry>, 8> expired;
+      mWheel.PopExpired(deadline, expired);
 
-          RefPtr<nsTimerImpl> timerRef(mTimers[0]->Take());
-          RemoveFirstTimerInternal();
+      for (UniquePtr<Entry>& entry : expired) {
+        // NB: AddRef before the Release under RemoveTimerInternal to avoid
+        // mRefCnt passing through zero, in case all other refs than the one
+        // from the wheel have gone away (the last non-wheel-ref's Release
+        // must be racing with us, blocked in gThread->RemoveTimer waiting
+        // for TimerThread::mMonitor, under nsTimerImpl::Release.
 
-          MOZ_LOG(GetTimerLog(), LogLevel::Debug,
-                  ("Timer thread woke up %fms from when it was supposed to\n",
-                   fabs((now - timerRef->mTimeout).ToMilliseconds())));
-
-          // We are going to let the call to PostTimerEvent here handle the
-          // release of the timer so that we don't end up releasing the timer
-          // on the TimerThread instead of on the thread it targets.
-          timerRef = PostTimerEvent(timerRef.forget());
-
-          if (timerRef) {
-            // We got our reference back due to an error.
-            // Unhook the nsRefPtr, and release manually so we can get the
-            // refcount.
-            nsrefcnt rc = timerRef.forget().take()->Release();
-            (void)rc;
-
-            // The nsITimer interface requires that its users keep a reference
-            // to the timers they use while those timers are initialized but
-            // have not yet fired.  If this ever happens, it is a bug in the
-            // code that created and used the timer.
-            //
-            // Further, note that this should never happen even with a
-            // misbehaving user, because nsTimerImpl::Release checks for a
-            // refcount of 1 with an armed timer (a timer whose only reference
-            // is from the timer thread) and when it hits this will remove the
-            // timer from the timer thread and thus destroy the last reference,
-            // preventing this situation from occurring.
-            MOZ_ASSERT(rc != 0, "destroyed timer off its target thread!");
-          }
-
-          if (mShutdown) {
-            break;
-          }
-
-          // Update now, as PostTimerEvent plus the locking may have taken a
-          // tick or two, and we may goto next below.
-          now = TimeStamp::Now();
+        RefPtr<nsTimerImpl> timerRef(entry->Take());
+        if (!timerRef) {
+          // Canceled after we collected it.
+          continue;
+        }
+
+        MOZ_LOG(GetTimerLog(), LogLevel::Debug,
+                ("Timer thread woke up %fms from when it was supposed to\n",
+                 fabs((now - timerRef->mTimeout).ToMilliseconds())));
+
+        // We are going to let the call to PostTimerEvent here handle the
+        // release of the timer so that we don't end up releasing the timer
+        // on the TimerThread instead of on the thread it targets.
+        timerRef = PostTimerEvent(timerRef.forget());
+
+        if (timerRef) {
+          // We got our reference back due to an error.
+          // Unhook the nsRefPtr, and release manually so we can get the
+          // refcount.
+          nsrefcnt rc = timerRef.forget().take()->Release();
+          (void)rc;
+
+          // The nsITimer interface requires that its users keep a reference
+          // to the timers they use while those timers are initialized but
+          // have not yet fired.  If this ever happens, it is a bug in the
+          // code that created and used the timer.
+          //
+          // Further, note that this should never happen even with a
+          // misbehaving user, because nsTimerImpl::Release checks for a
+          // refcount of 1 with an armed timer (a timer whose only reference
+          // is from the timer thread) and when it hits this will remove the
+          // timer from the timer thread and thus destroy the last reference,
+          // preventing this situation from occurring.
+          MOZ_ASSERT(rc != 0, "destroyed timer off its target thread!");
+        }
+
+        if (mShutdown) {
+          break;
         }
       }
 
-      RemoveLeadingCanceledTimersInternal();
+      if (mShutdown) {
+        break;
+      }
 
-      if (!mTimers.IsEmpty()) {
-        TimeStamp timeout = mTimers[0]->Value()->mTimeout;
+      // Update now, as the PostTimerEvent calls plus the locking may have
+      // taken a tick or two.
+      now = TimeStamp::Now();
 
+      TimeStamp timeout = mWheel.NextTimeout();
+      if (!timeout.IsNull()) {
         // Don't wait at all (even for PR_INTERVAL_NO_WAIT) if the next timer
         // is due now or overdue.
         //
@@ -470,8 +634,9 @@ TimerThread::Run() {
         }
 
         if (microseconds < mAllowedEarlyFiringMicroseconds) {
-          forceRunNextTimer = false;
-          goto next;  // round down; execute event now
+          // Round down; go collect and execute the event on the next pass
+          // without sleeping.
+          continue;
         }
         waitFor = TimeDuration::FromMicroseconds(microseconds);
         if (waitFor.IsZero()) {
@@ -513,13 +678,17 @@ nsresult TimerThread::AddTimer(nsTimerImpl* aTimer) {
     return rv;
   }
 
-  // Add the timer to our list.
+  // Grab the hint before the insertion updates it.
+  TimeStamp nextDue = mWheel.NextDueHint();
+
+  // Add the timer to the wheel.
   if (!AddTimerInternal(aTimer)) {
     return NS_ERROR_OUT_OF_MEMORY;
   }
 
-  // Awaken the timer thread.
-  if (mWaiting && mTimers[0]->Value() == aTimer) {
+  // Awaken the timer thread if the new timer may fire before anything the
+  // thread is already waiting for.
+  if (mWaiting && (nextDue.IsNull() || aTimer->mTimeout < nextDue)) {
     mNotified = true;
     mMonitor.Notify();
   }
@@ -552,69 +721,37 @@ TimeStamp TimerThread::FindNextFireTimeForCurrentThread(TimeStamp aDefault,
   TimeStamp timeStamp = aDefault;
   uint32_t index = 0;
 
-#ifdef DEBUG
-  TimeStamp firstTimeStamp;
-  Entry* initialFirstEntry = nullptr;
-  if (!mTimers.IsEmpty()) {
-    initialFirstEntry = mTimers[0].get();
-    firstTimeStamp = mTimers[0]->Timeout();
-  }
-#endif
-
-  auto end = mTimers.end();
-  while (end != mTimers.begin()) {
-    nsTimerImpl* timer = mTimers[0]->Value();
-    if (timer) {
-      if (timer->mTimeout > aDefault) {
-        timeStamp = aDefault;
-        break;
-      }
-
-      // Don't yield to timers created with the *_LOW_PRIORITY type.
-      if (!timer->IsLowPriority()) {
-        bool isOnCurrentThread = false;
-        nsresult rv =
-            timer->mEventTarget->IsOnCurrentThread(&isOnCurrentThread);
-        if (NS_SUCCEEDED(rv) && isOnCurrentThread) {
-          timeStamp = timer->mTimeout;
-          break;
-        }
+  // Walk the wheel in approximately soonest-first order (see
+  // Wheel::ForEachEntry). The order is only approximate - entries within a
+  // slot are unordered and coarse-level entries can sit well past their due
+  // position until they cascade - so an entry past aDefault proves nothing
+  // about the entries after it. Skip such entries (still counting them
+  // toward the search bound) and track the minimum qualifying timeout
+  // instead of concluding at the first candidate.
+  mWheel.ForEachEntry([&](Entry* aEntry) {
+    nsTimerImpl* timer = aEntry->Value();
+
+    // Don't yield to timers created with the *_LOW_PRIORITY type.
+    if (timer->mTimeout <= timeStamp && !timer->IsLowPriority()) {
+      bool isOnCurrentThread = false;
+      nsresult rv = timer->mEventTarget->IsOnCurrentThread(&isOnCurrentThread);
+      if (NS_SUCCEEDED(rv) && isOnCurrentThread) {
+        timeStamp = timer->mTimeout;
       }
+    }
 
-      if (++index > aSearchBound) {
-        // Track the currently highest timeout so that we can bail out when we
-        // reach the bound or when we find a timer for the current thread.
-        // This won't give accurate information if we stop before finding
-        // any timer for the current thread, but at least won't report too
-        // long idle period.
+    if (++index > aSearchBound) {
+      // We didn't examine the remaining timers, which may fire sooner than
+      // anything found so far. Clamp to this entry's timeout so that we at
+      // least won't report too long an idle period.
+      if (timer->mTimeout < timeStamp) {
         timeStamp = timer->mTimeout;
-        break;
       }
+      return false;
     }
 
-    std::pop_heap(mTimers.begin(), end, Entry::UniquePtrLessThan);
-    --end;
-  }
-
-  while (end != mTimers.end()) {
-    ++end;
-    std::push_heap(mTimers.begin(), end, Entry::UniquePtrLessThan);
-  }
-
-#ifdef DEBUG
-  if (!mTimers.IsEmpty()) {
-    if (firstTimeStamp != mTimers[0]->Timeout()) {
-      TimeStamp now = TimeStamp::Now();
-      printf_stderr(
-          "firstTimeStamp %f, mTimers[0]->Timeout() %f, "
-          "initialFirstTimer %p, current first %p\n",
-          (firstTimeStamp - now).ToMilliseconds(),
-          (mTimers[0]->Timeout() - now).ToMilliseconds(), initialFirstEntry,
-          mTimers[0].get());
-    }
-  }
-  MOZ_ASSERT_IF(!mTimers.IsEmpty(), firstTimeStamp == mTimers[0]->Timeout());
-#endif
+    return true;
+  });
 
   return timeStamp;
 }
@@ -628,14 +765,10 @@ bool TimerThread::AddTimerInternal(nsTimerImpl* aTimer) {
 
   TimeStamp now = TimeStamp::Now();
 
-  UniquePtr<Entry>* entry = mTimers.AppendElement(
-      MakeUnique<Entry>(now, aTimer->mTimeout, aTimer), mozilla::fallible);
-  if (!entry) {
+  if (!mWheel.Insert(MakeUnique<Entry>(now, aTimer->mTimeout, aTimer), now)) {
     return false;
   }
 
-  std::push_heap(mTimers.begin(), mTimers.end(), Entry::UniquePtrLessThan);
-
 #ifdef MOZ_TASK_TRACER
   // Caller of AddTimer is the parent task of its timer event, so we store the
   // TraceInfo here for later used.
@@ -654,39 +787,6 @@ bool TimerThread::RemoveTimerInternal(nsTimerImpl* aTimer) {
   return true;
 }
 
-void TimerThread::RemoveLeadingCanceledTimersInternal() {
-  mMonitor.AssertCurrentThreadOwns();
-
-  // Move all canceled timers from the front of the list to
-  // the back of the list using std::pop_heap().  We do this
-  // without actually removing them from the list so we can
-  // modify the nsTArray in a single bulk operation.
-  auto sortedEnd = mTimers.end();
-  while (sortedEnd != mTimers.begin() && !mTimers[0]->Value()) {
-    std::pop_heap(mTimers.begin(), sortedEnd, Entry::UniquePtrLessThan);
-    --sortedEnd;
-  }
-
-  // If there were no canceled timers then we are done.
-  if (sortedEnd == mTimers.end()) {
-    return;
-  }
-
-  // Finally, remove the canceled timers from the back of the
-  // nsTArray.  Note, since std::pop_heap() uses iterators
-  // we must convert to nsTArray indices and number of
-  // elements here.
-  mTimers.RemoveElementsAt(sortedEnd - mTimers.begin(),
-                           mTimers.end() - sortedEnd);
-}
-
-void TimerThread::RemoveFirstTimerInternal() {
-  mMonitor.AssertCurrentThreadOwns();
-  MOZ_ASSERT(!mTimers.IsEmpty());
-  std::pop_heap(mTimers.begin(), mTimers.end(), Entry::UniquePtrLessThan);
-  mTimers.RemoveLastElement();
-}
-
 already_AddRefed<nsTimerImpl> TimerThread::PostTimerEvent(
     already_AddRefed<nsTimerImpl> aTimerRef) {
   mMonitor.AssertCurrentThreadOwns();
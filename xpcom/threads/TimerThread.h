@@ -65,8 +65,6 @@ class TimerThread final : public nsIRunnable, public nsIObserver {
   // AddTimerInternal returns false if the insertion failed.
   bool AddTimerInternal(nsTimerImpl* aTimer);
   bool RemoveTimerInternal(nsTimerImpl* aTimer);
-  void RemoveLeadingCanceledTimersInternal();
-  void RemoveFirstTimerInternal();
   nsresult Init();
 
   already_AddRefed<nsTimerImpl> PostTimerEvent(
@@ -98,17 +96,96 @@ class TimerThread final : public nsIRunnable, public nsIObserver {
       return mTimerImpl.forget();
     }
 
-    static bool UniquePtrLessThan(mozilla::UniquePtr<Entry>& aLeft,
-                                  mozilla::UniquePtr<Entry>& aRight) {
-      // This is reversed because std::push_heap() sorts the "largest" to
-      // the front of the heap.  We want that to be the earliest timer.
-      return aRight->mTimeout < aLeft->mTimeout;
+    TimeStamp Timeout() const { return mTimeout; }
+  };
+
+  // A hierarchical timer wheel.  Arming is O(1): entries are filed into one
+  // of kLevels wheels of kSlots slots each by time-to-fire (one tick is one
+  // millisecond), and slots of the coarser levels are cascaded down as the
+  // wheel advances.  Disarming is O(1) too: a canceled entry just loses its
+  // nsTimerImpl (see nsTimerImplHolder) and the husk is pruned lazily the
+  // next time its slot is visited.  Timers beyond the ~17 minute horizon of
+  // the coarsest level live in an overflow list that is refiled once per
+  // full revolution.
+  class Wheel {
+   public:
+    Wheel() : mCurrentTick(0), mCount(0), mNextDueValid(true) {}
+
+    bool IsEmpty() const { return mCount == 0; }
+
+    // File aEntry by its timeout.  Returns false if the insertion failed.
+    bool Insert(mozilla::UniquePtr<Entry> aEntry, const TimeStamp& aNow);
+
+    // Advance the wheel to aDeadline, moving every live entry due at or
+    // before it into aExpired.
+    void PopExpired(const TimeStamp& aDeadline,
+                    nsTArray<mozilla::UniquePtr<Entry>>& aExpired);
+
+    // The timeout of the earliest live entry, or a null TimeStamp if there
+    // is none.  Recomputes the cached minimum (and prunes canceled entries)
+    // if it was invalidated by PopExpired.
+    TimeStamp NextTimeout();
+
+    // Cheap variant of NextTimeout: returns the cached minimum without
+    // recomputing it, or a null TimeStamp when the cache is stale.  The
+    // cached value may belong to an already-canceled timer, so treat this
+    // only as a hint.
+    TimeStamp NextDueHint() const {
+      return mNextDueValid ? mNextDue : TimeStamp();
     }
 
-    TimeStamp Timeout() const { return mTimeout; }
+    // Remove all entries from the wheel into aOut.
+    void Clear(nsTArray<mozilla::UniquePtr<Entry>>& aOut);
+
+    // Visit live entries in approximately soonest-first order (slots are
+    // visited in firing order, but entries within a slot are unordered and
+    // the coarser levels have coarser slots).  The visitor returns false to
+    // stop the walk.
+    template <typename Visitor>
+    void ForEachEntry(Visitor&& aVisitor) {
+      for (size_t level = 0; level < kLevels; ++level) {
+        size_t start = (mCurrentTick >> (kSlotBits * level)) & kSlotMask;
+        for (size_t i = 0; i < kSlots; ++i) {
+          for (mozilla::UniquePtr<Entry>& entry :
+               mSlots[level][(start + i) & kSlotMask]) {
+            if (entry->Value() && !aVisitor(entry.get())) {
+              return;
+            }
+          }
+        }
+      }
+      for (mozilla::UniquePtr<Entry>& entry : mOverflow) {
+        if (entry->Value() && !aVisitor(entry.get())) {
+          return;
+        }
+      }
+    }
+
+   private:
+    static const size_t kSlotBits = 5;
+    static const size_t kSlots = size_t(1) << kSlotBits;
+    static const size_t kSlotMask = kSlots - 1;
+    static const size_t kLevels = 4;
+
+    // The tick a timestamp belongs to, clamped to the start of the wheel.
+    int64_t TickFor(const TimeStamp& aTime) const;
+    // File an entry into the slot covering its timeout, or the overflow
+    // list.  Ticks in the past are clamped to the current tick.
+    bool FileEntry(mozilla::UniquePtr<Entry> aEntry, bool aFallible);
+    // Refile the slots uncovered when mCurrentTick crosses a coarse-level
+    // boundary, and the overflow list on a full revolution.
+    void CascadeLevels();
+
+    TimeStamp mBase;  // the time tick 0 corresponds to; set on first insert
+    int64_t mCurrentTick;
+    size_t mCount;
+    TimeStamp mNextDue;
+    bool mNextDueValid;
+    nsTArray<mozilla::UniquePtr<Entry>> mSlots[kLevels][kSlots];
+    nsTArray<mozilla::UniquePtr<Entry>> mOverflow;
   };
 
-  nsTArray<mozilla::UniquePtr<Entry>> mTimers;
+  Wheel mWheel;
   uint32_t mAllowedEarlyFiringMicroseconds;
 };
 
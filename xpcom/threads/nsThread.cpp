@@ -21,9 +21,11 @@
 #include "nsCOMPtr.h"
 #include "nsQueryObject.h"
 #include "pratom.h"
+#include "mozilla/ArenaChunkPool.h"
 #include "mozilla/BackgroundHangMonitor.h"
 #include "mozilla/CycleCollectedJSContext.h"
 #include "mozilla/Logging.h"
+#include "mozilla/MathAlgorithms.h"
 #include "nsIObserverService.h"
 #include "mozilla/IOInterposer.h"
 #include "mozilla/ipc/MessageChannel.h"
@@ -614,6 +616,11 @@ nsThread::nsThread(NotNull<SynchronizedEventQueue*> aQueue,
       mLastWakeupCheckTime(TimeStamp::Now()),
 #endif
       mPerformanceCounterState(mNestedEventLoopDepth, mIsMainThread) {
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+  if (aMainThread == MAIN_THREAD) {
+    mRecentEventHistory = MakeUnique<RecentEventHistory>();
+  }
+#endif
 }
 
 nsThread::nsThread()
@@ -719,6 +726,15 @@ nsThread::Dispatch(already_AddRefed<nsIRunnable> aEvent, uint32_t aFlags) {
   return mEventTarget->Dispatch(std::move(aEvent), aFlags);
 }
 
+nsresult nsThread::DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+  MOZ_ASSERT(mEventTarget);
+  NS_ENSURE_TRUE(mEventTarget, NS_ERROR_NOT_IMPLEMENTED);
+
+  LOG(("THRD(%p) DispatchBatch [%zu]\n", this, aEvents.Length()));
+
+  return mEventTarget->DispatchBatch(std::move(aEvents));
+}
+
 NS_IMETHODIMP
 nsThread::DelayedDispatch(already_AddRefed<nsIRunnable> aEvent,
                           uint32_t aDelayMs) {
@@ -1190,9 +1206,9 @@ nsThread::ProcessNextEvent(bool aMayWait, bool* aResult) {
           sMainThreadRunnableName = restoreRunnableName;
         }
       });
+      nsAutoCString labeledName;
       if (mIsMainThread) {
-        nsAutoCString name;
-        GetLabeledRunnableName(event, name, priority);
+        GetLabeledRunnableName(event, labeledName, priority);
 
         MOZ_ASSERT(NS_IsMainThread());
         restoreRunnableName = sMainThreadRunnableName;
@@ -1200,8 +1216,9 @@ nsThread::ProcessNextEvent(bool aMayWait, bool* aResult) {
         // Copy the name into sMainThreadRunnableName's buffer, and append a
         // terminating null.
         uint32_t length = std::min((uint32_t)kRunnableNameBufSize - 1,
-                                   (uint32_t)name.Length());
-        memcpy(sMainThreadRunnableName.begin(), name.BeginReading(), length);
+                                   (uint32_t)labeledName.Length());
+        memcpy(sMainThreadRunnableName.begin(), labeledName.BeginReading(),
+               length);
         sMainThreadRunnableName[length] = '\0';
       }
 #endif
@@ -1222,6 +1239,13 @@ nsThread::ProcessNextEvent(bool aMayWait, bool* aResult) {
       mEvents->DidRunEvent();
 
       mPerformanceCounterState.RunnableDidRun(std::move(snapshot));
+
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+      if (mRecentEventHistory) {
+        mRecentEventHistory->Record(labeledName, priority,
+                                    TimeStamp::Now() - now);
+      }
+#endif
     } else {
       mLastEventDelay = TimeDuration();
       mLastEventStart = TimeStamp();
@@ -1387,6 +1411,11 @@ void nsThread::DoMainThreadSpecificProcessing(bool aReallyWait) {
     if (mpPending != MemPressure_None) {
       nsCOMPtr<nsIObserverService> os = services::GetObserverService();
 
+      // Release any cached arena chunks; the observers below will flush the
+      // arenas themselves, so the pool would otherwise refill and pin the
+      // chunks they release.
+      ArenaChunkPool::Trim();
+
       if (os) {
         if (mpPending == MemPressure_Stopping) {
           os->NotifyObservers(nullptr, "memory-pressure-stop", nullptr);
@@ -1518,4 +1547,27 @@ void PerformanceCounterState::MaybeReportAccumulatedTime(TimeStamp aNow) {
   }
 }
 
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+void RecentEventHistory::Record(const nsACString& aName,
+                                EventQueuePriority aPriority,
+                                TimeDuration aDuration) {
+  Entry& entry = mEntries[mNext];
+
+  uint32_t length =
+      std::min((uint32_t)kNameBufSize - 1, (uint32_t)aName.Length());
+  memcpy(entry.mName, aName.BeginReading(), length);
+  entry.mName[length] = '\0';
+
+  entry.mPriority = aPriority;
+
+  // Durations of a microsecond or less all land in bucket zero.
+  uint32_t micros = static_cast<uint32_t>(
+      std::min(aDuration.ToMicroseconds(), double(UINT32_MAX)));
+  entry.mDurationBucket = micros ? uint8_t(FloorLog2(micros)) : 0;
+
+  mNext = (mNext + 1) % kEntryCount;
+  mCount = std::min(mCount + 1, kEntryCount);
+}
+#endif
+
 }  // namespace mozilla
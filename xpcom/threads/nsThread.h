@@ -141,6 +141,47 @@ class PerformanceCounterState {
   // counters.
   RefPtr<PerformanceCounter> mCurrentPerformanceCounter;
 };
+
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+// A fixed-size ring of the most recently executed events, recorded as the
+// event loop runs them.  This is meant to stay cheap enough to be always on:
+// recording an entry is a bounded copy of the runnable name plus a couple of
+// stores, with no allocation and no locking.  The ring is only written and
+// read on its owning thread, so consumers (for example a jank reporter
+// wanting to rank recent event names without a full profile) must read it
+// from that thread.
+class RecentEventHistory {
+ public:
+  static const uint32_t kEntryCount = 128;
+  static const uint32_t kNameBufSize = 64;
+
+  struct Entry {
+    // Leading fragment of the runnable name, null-terminated.
+    char mName[kNameBufSize];
+    EventQueuePriority mPriority;
+    // floor(log2()) of the event's wall-clock duration in microseconds, so
+    // one byte covers everything from instant to over an hour.  The duration
+    // includes any nested event loops the event spun.
+    uint8_t mDurationBucket;
+  };
+
+  void Record(const nsACString& aName, EventQueuePriority aPriority,
+              TimeDuration aDuration);
+
+  // Calls aCallback(const Entry&) for each recorded entry, oldest first.
+  template <typename Callback>
+  void ForEach(Callback&& aCallback) const {
+    for (uint32_t i = 0; i < mCount; ++i) {
+      aCallback(mEntries[(mNext + kEntryCount - mCount + i) % kEntryCount]);
+    }
+  }
+
+ private:
+  Entry mEntries[kEntryCount];
+  uint32_t mNext = 0;
+  uint32_t mCount = 0;
+};
+#endif
 }  // namespace mozilla
 
 // A native thread
@@ -225,11 +266,24 @@ class nsThread : public nsIThreadInternal,
 
   mozilla::SynchronizedEventQueue* EventQueue() { return mEvents.get(); }
 
+  // C++-only: dispatch a batch of events to this thread, enqueuing them all
+  // under a single lock acquisition with a single wakeup.  See
+  // mozilla::ThreadTargetSink::PutEventBatch.
+  nsresult DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents);
+
   bool ShuttingDown() { return mShutdownContext != nullptr; }
 
   virtual mozilla::PerformanceCounter* GetPerformanceCounter(
       nsIRunnable* aEvent);
 
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+  // The history of recently executed events.  Only the main thread keeps one;
+  // this returns null on other threads.  May only be used on this thread.
+  mozilla::RecentEventHistory* RecentEvents() const {
+    return mRecentEventHistory.get();
+  }
+#endif
+
   size_t SizeOfIncludingThis(mozilla::MallocSizeOf aMallocSizeOf) const;
 
   // Returns the size of this object, its PRThread, and its shutdown contexts,
@@ -350,6 +404,11 @@ class nsThread : public nsIThreadInternal,
 
   mozilla::PerformanceCounterState mPerformanceCounterState;
 
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+  // Only allocated for the main thread; see RecentEvents().
+  mozilla::UniquePtr<mozilla::RecentEventHistory> mRecentEventHistory;
+#endif
+
   bool mIsInLocalExecutionMode = false;
 };
 
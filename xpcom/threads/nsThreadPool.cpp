@@ -26,6 +26,54 @@ static LazyLogModule sThreadPoolLog("nsThreadPool");
 #define LOG(args) MOZ_LOG(sThreadPoolLog, mozilla::LogLevel::Debug, args)
 
 static MOZ_THREAD_LOCAL(nsThreadPool*) gCurrentThreadPool;
+static MOZ_THREAD_LOCAL(nsThreadPool::LocalQueue*) gCurrentLocalQueue;
+
+// See the comment in nsThreadPool.h.  The deque is an array plus a head
+// index; StealFront advances the head and the dead prefix is compacted
+// lazily so steals don't memmove the whole array.
+class nsThreadPool::LocalQueue {
+ public:
+  LocalQueue() : mLock("nsThreadPool::LocalQueue"), mHead(0) {}
+
+  void PushBack(already_AddRefed<nsIRunnable> aEvent) {
+    MutexAutoLock lock(mLock);
+    mItems.AppendElement(std::move(aEvent));
+  }
+
+  // Called only by the owning thread.
+  already_AddRefed<nsIRunnable> PopBack() {
+    MutexAutoLock lock(mLock);
+    if (mHead == mItems.Length()) {
+      return nullptr;
+    }
+    nsCOMPtr<nsIRunnable> event = std::move(mItems.LastElement());
+    mItems.RemoveLastElement();
+    return event.forget();
+  }
+
+  // Called by sibling threads (and the owner, when stealing round-robin).
+  already_AddRefed<nsIRunnable> StealFront() {
+    MutexAutoLock lock(mLock);
+    if (mHead == mItems.Length()) {
+      return nullptr;
+    }
+    nsCOMPtr<nsIRunnable> event = std::move(mItems[mHead]);
+    ++mHead;
+    if (mHead == mItems.Length()) {
+      mItems.ClearAndRetainStorage();
+      mHead = 0;
+    } else if (mHead > 32 && mHead > mItems.Length() / 2) {
+      mItems.RemoveElementsAt(0, mHead);
+      mHead = 0;
+    }
+    return event.forget();
+  }
+
+ private:
+  mozilla::Mutex mLock;
+  nsTArray<nsCOMPtr<nsIRunnable>> mItems;
+  size_t mHead;
+};
 
 // DESIGN:
 //  o  Allocate anonymous threads.
@@ -45,6 +93,8 @@ NS_IMPL_QUERY_INTERFACE(nsThreadPool, nsIThreadPool, nsIEventTarget,
 nsThreadPool::nsThreadPool()
     : mMutex("[nsThreadPool.mMutex]"),
       mEventsAvailable(mMutex, "[nsThreadPool.mEventsAvailable]"),
+      mNextLocalQueue(0),
+      mLocalEventCount(0),
       mThreadLimit(DEFAULT_THREAD_LIMIT),
       mIdleThreadLimit(DEFAULT_IDLE_THREAD_LIMIT),
       mIdleThreadTimeout(DEFAULT_IDLE_THREAD_TIMEOUT),
@@ -52,9 +102,13 @@ nsThreadPool::nsThreadPool()
       mStackSize(nsIThreadManager::DEFAULT_STACK_SIZE),
       mShutdown(false),
       mRegressiveMaxIdleTime(false),
+      mUseWorkStealing(false),
       mIsAPoolThreadFree(true) {
   static std::once_flag flag;
-  std::call_once(flag, [] { gCurrentThreadPool.infallibleInit(); });
+  std::call_once(flag, [] {
+    gCurrentThreadPool.infallibleInit();
+    gCurrentLocalQueue.infallibleInit();
+  });
 
   LOG(("THRD-P(%p) constructor!!!\n", this));
 }
@@ -91,11 +145,26 @@ nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
         !(aFlags & NS_DISPATCH_AT_END) &&
         // Spawn a new thread if we don't have enough idle threads to serve
         // pending events immediately.
-        mEvents.Count(lock) >= mIdleCount) {
+        mEvents.Count(lock) + mLocalEventCount >= mIdleCount) {
       spawnThread = true;
     }
 
-    mEvents.PutEvent(std::move(aEvent), EventQueuePriority::Normal, lock);
+    LocalQueue* target = nullptr;
+    if (mUseWorkStealing && !mLocalQueues.IsEmpty()) {
+      if (gCurrentThreadPool.get() == this && gCurrentLocalQueue.get()) {
+        // A pool thread dispatching to its own pool keeps the event local.
+        target = gCurrentLocalQueue.get();
+      } else {
+        target = mLocalQueues[mNextLocalQueue % mLocalQueues.Length()].get();
+        mNextLocalQueue = (mNextLocalQueue + 1) % mLocalQueues.Length();
+      }
+    }
+    if (target) {
+      target->PushBack(std::move(aEvent));
+      ++mLocalEventCount;
+    } else {
+      mEvents.PutEvent(std::move(aEvent), EventQueuePriority::Normal, lock);
+    }
     mEventsAvailable.Notify();
     stackSize = mStackSize;
   }
@@ -162,6 +231,32 @@ void nsThreadPool::ShutdownThread(nsIThread* aThread) {
                                           &nsIThread::AsyncShutdown));
 }
 
+already_AddRefed<nsIRunnable> nsThreadPool::StealEvent(
+    const MutexAutoLock& aProofOfLock) {
+  // Start at the round-robin cursor so concurrent thieves spread out over
+  // their victims instead of all hammering queue 0.
+  uint32_t n = mLocalQueues.Length();
+  for (uint32_t i = 0; i < n; ++i) {
+    LocalQueue* victim = mLocalQueues[(mNextLocalQueue + i) % n].get();
+    nsCOMPtr<nsIRunnable> event = victim->StealFront();
+    if (event) {
+      --mLocalEventCount;
+      return event.forget();
+    }
+  }
+  return nullptr;
+}
+
+void nsThreadPool::DrainLocalQueue(LocalQueue* aQueue,
+                                   const MutexAutoLock& aProofOfLock) {
+  nsCOMPtr<nsIRunnable> event;
+  while ((event = aQueue->StealFront())) {
+    --mLocalEventCount;
+    mEvents.PutEvent(event.forget(), EventQueuePriority::Normal, aProofOfLock);
+    mEventsAvailable.Notify();
+  }
+}
+
 // This event 'runs' for the lifetime of the worker thread.  The actual
 // eventqueue is mEvents, and is shared by all the worker threads.  This
 // means that the set of threads together define the delay seen by a new
@@ -220,13 +315,37 @@ nsThreadPool::Run() {
   MOZ_ASSERT(!gCurrentThreadPool.get());
   gCurrentThreadPool.set(this);
 
+  LocalQueue* localQueue = nullptr;
+  {
+    MutexAutoLock lock(mMutex);
+    if (mUseWorkStealing) {
+      localQueue = mLocalQueues.AppendElement(MakeUnique<LocalQueue>())->get();
+      gCurrentLocalQueue.set(localQueue);
+    }
+  }
+
   do {
     nsCOMPtr<nsIRunnable> event;
     TimeDuration delay;
-    {
+    if (localQueue) {
+      // Fast path: service our own deque without touching the pool lock.
+      event = localQueue->PopBack();
+      if (event) {
+        --mLocalEventCount;
+        if (wasIdle) {
+          MutexAutoLock lock(mMutex);
+          wasIdle = false;
+          --mIdleCount;
+        }
+      }
+    }
+    if (!event) {
       MutexAutoLock lock(mMutex);
 
       event = mEvents.GetEvent(nullptr, lock, &delay);
+      if (!event && localQueue) {
+        event = StealEvent(lock);
+      }
       if (!event) {
         TimeStamp now = TimeStamp::Now();
         uint32_t idleTimeoutDivider =
@@ -265,6 +384,20 @@ nsThreadPool::Run() {
 
           // keep track if there are threads available to start
           mIsAPoolThreadFree = (mThreads.Count() < (int32_t)mThreadLimit);
+
+          if (localQueue) {
+            // Unregister our deque and hand any events that raced in back to
+            // the shared queue so they are not stranded.
+            DrainLocalQueue(localQueue, lock);
+            for (uint32_t i = 0; i < mLocalQueues.Length(); ++i) {
+              if (mLocalQueues[i].get() == localQueue) {
+                mLocalQueues.RemoveElementAt(i);
+                break;
+              }
+            }
+            gCurrentLocalQueue.set(nullptr);
+            localQueue = nullptr;
+          }
         } else {
           current->SetRunningEventDelay(TimeDuration(), TimeStamp());
 
@@ -592,6 +725,26 @@ nsThreadPool::SetThreadStackSize(uint32_t aValue) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+nsThreadPool::GetUseWorkStealing(bool* aValue) {
+  MutexAutoLock lock(mMutex);
+  *aValue = mUseWorkStealing;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::SetUseWorkStealing(bool aValue) {
+  MutexAutoLock lock(mMutex);
+  // Flipping modes with live threads would strand events in local deques, so
+  // like SetName this must happen before the pool spins up.
+  if (mThreads.Count()) {
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+  LOG(("THRD-P(%p) work stealing [%d]\n", this, aValue));
+  mUseWorkStealing = aValue;
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsThreadPool::GetListener(nsIThreadPoolListener** aListener) {
   MutexAutoLock lock(mMutex);
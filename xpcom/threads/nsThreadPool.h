@@ -19,6 +19,8 @@
 #include "mozilla/EventQueue.h"
 #include "mozilla/Mutex.h"
 #include "mozilla/Monitor.h"
+#include "mozilla/UniquePtr.h"
+#include "nsTArray.h"
 
 class nsThreadPool final : public nsIThreadPool, public nsIRunnable {
  public:
@@ -29,17 +31,41 @@ class nsThreadPool final : public nsIThreadPool, public nsIRunnable {
 
   nsThreadPool();
 
+  // A per-thread deque used when work stealing is enabled.  The owning
+  // thread pushes and pops at the back (LIFO, for cache locality); other
+  // threads steal the oldest event from the front.  Each deque has its own
+  // lock so producers and thieves don't serialize on mMutex.  Public only so
+  // the implementation can keep a thread-local pointer to it.
+  class LocalQueue;
+
  private:
   ~nsThreadPool();
 
   void ShutdownThread(nsIThread* aThread);
   nsresult PutEvent(nsIRunnable* aEvent);
   nsresult PutEvent(already_AddRefed<nsIRunnable> aEvent, uint32_t aFlags);
+  // Steal an event from any registered local queue.  Requires mMutex to keep
+  // mLocalQueues stable while iterating.
+  already_AddRefed<nsIRunnable> StealEvent(
+      const mozilla::MutexAutoLock& aProofOfLock);
+  // Move any events left in aQueue back to the shared queue before the
+  // owning thread exits.  Requires mMutex.
+  void DrainLocalQueue(LocalQueue* aQueue,
+                       const mozilla::MutexAutoLock& aProofOfLock);
 
   nsCOMArray<nsIThread> mThreads;
   mozilla::Mutex mMutex;
   mozilla::CondVar mEventsAvailable;
   mozilla::EventQueue mEvents;
+  // Per-thread deques, registered by pool threads as they start up.  The
+  // array itself is guarded by mMutex; the queues have their own locks.
+  nsTArray<mozilla::UniquePtr<LocalQueue>> mLocalQueues;
+  // Round-robin cursor for distributing external dispatches over
+  // mLocalQueues.  Guarded by mMutex.
+  uint32_t mNextLocalQueue;
+  // Approximate number of events sitting in local queues, used by the
+  // thread-spawning heuristic in PutEvent.
+  mozilla::Atomic<uint32_t, mozilla::Relaxed> mLocalEventCount;
   uint32_t mThreadLimit;
   uint32_t mIdleThreadLimit;
   uint32_t mIdleThreadTimeout;
@@ -48,6 +74,7 @@ class nsThreadPool final : public nsIThreadPool, public nsIRunnable {
   nsCOMPtr<nsIThreadPoolListener> mListener;
   bool mShutdown;
   bool mRegressiveMaxIdleTime;
+  bool mUseWorkStealing;
   mozilla::Atomic<bool, mozilla::Relaxed> mIsAPoolThreadFree;
   nsCString mName;
   nsThreadPoolNaming mThreadNaming;